@@ -6,7 +6,10 @@
  *  @copyright  Copyright (c) 2024
  */
 #if defined(_WIN32) || defined(__CYGWIN__)
-#include <windows.h> // `DllMain`
+#include <windows.h> // `DllMain`, `InterlockedExchangeAdd64`
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h> // `__rdtsc`
 #endif
 
 // Overwrite `SZ_DYNAMIC_DISPATCH` before including StringZilla.
@@ -28,83 +31,15 @@ void *malloc(size_t length) {
     sz_unused(length);
     return SZ_NULL;
 }
-#endif
-
-SZ_DYNAMIC sz_capability_t sz_capabilities(void) {
-
-#if SZ_USE_X86_AVX512 || SZ_USE_X86_AVX2
-
-    /// The states of 4 registers populated for a specific "cpuid" assembly call
-    union four_registers_t {
-        int array[4];
-        struct separate_t {
-            unsigned eax, ebx, ecx, edx;
-        } named;
-    } info1, info7;
-
-#ifdef _MSC_VER
-    __cpuidex(info1.array, 1, 0);
-    __cpuidex(info7.array, 7, 0);
 #else
-    __asm__ __volatile__("cpuid"
-                         : "=a"(info1.named.eax), "=b"(info1.named.ebx), "=c"(info1.named.ecx), "=d"(info1.named.edx)
-                         : "a"(1), "c"(0));
-    __asm__ __volatile__("cpuid"
-                         : "=a"(info7.named.eax), "=b"(info7.named.ebx), "=c"(info7.named.ecx), "=d"(info7.named.edx)
-                         : "a"(7), "c"(0));
+#include <stdlib.h> // `getenv`
 #endif
 
-    // Check for AVX2 (Function ID 7, EBX register)
-    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L148
-    unsigned supports_avx2 = (info7.named.ebx & 0x00000020) != 0;
-    // Check for AVX512F (Function ID 7, EBX register)
-    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L155
-    unsigned supports_avx512f = (info7.named.ebx & 0x00010000) != 0;
-    // Check for AVX512BW (Function ID 7, EBX register)
-    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L166
-    unsigned supports_avx512bw = (info7.named.ebx & 0x40000000) != 0;
-    // Check for AVX512VL (Function ID 7, EBX register)
-    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L167C25-L167C35
-    unsigned supports_avx512vl = (info7.named.ebx & 0x80000000) != 0;
-    // Check for GFNI (Function ID 1, ECX register)
-    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L171C30-L171C40
-    unsigned supports_avx512vbmi = (info1.named.ecx & 0x00000002) != 0;
-    // Check for GFNI (Function ID 1, ECX register)
-    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L177C30-L177C40
-    unsigned supports_gfni = (info1.named.ecx & 0x00000100) != 0;
-
-    return (sz_capability_t)(                             //
-        (sz_cap_x86_avx2_k * supports_avx2) |             //
-        (sz_cap_x86_avx512f_k * supports_avx512f) |       //
-        (sz_cap_x86_avx512vl_k * supports_avx512vl) |     //
-        (sz_cap_x86_avx512bw_k * supports_avx512bw) |     //
-        (sz_cap_x86_avx512vbmi_k * supports_avx512vbmi) | //
-        (sz_cap_x86_gfni_k * (supports_gfni)) |           //
-        (sz_cap_serial_k));
-
-#endif // SIMSIMD_TARGET_X86
-
-#if SZ_USE_ARM_NEON || SZ_USE_ARM_SVE
-
-    // Every 64-bit Arm CPU supports NEON
-    unsigned supports_neon = 1;
-    unsigned supports_sve = 0;
-    unsigned supports_sve2 = 0;
-    sz_unused(supports_sve);
-    sz_unused(supports_sve2);
-
-    return (sz_capability_t)(                 //
-        (sz_cap_arm_neon_k * supports_neon) | //
-        (sz_cap_serial_k));
-
-#endif // SIMSIMD_TARGET_ARM
-
-    return sz_cap_serial_k;
-}
-
 typedef struct sz_implementations_t {
     sz_equal_t equal;
     sz_order_t order;
+    sz_hash_t hash;
+    sz_hash_batch_t hash_batch;
 
     sz_move_t copy;
     sz_move_t move;
@@ -116,26 +51,113 @@ typedef struct sz_implementations_t {
     sz_find_t rfind;
     sz_find_set_t find_from_set;
     sz_find_set_t rfind_from_set;
+    sz_find_any_t find_any;
+    sz_find_t find_case_insensitive;
+    sz_find_prepared_t find_prepared;
+
+    sz_to_converter_t to_lower;
+    sz_to_converter_t to_upper;
+    sz_to_converter_t to_ascii;
+    sz_isascii_t is_ascii;
+    sz_translate_t translate;
+
+    sz_isascii_t utf8_valid;
+    sz_utf8_count_t utf8_count;
+    sz_utf8_find_nth_t utf8_find_nth;
+    sz_utf8_to_utf32_t utf8_to_utf32;
 
     // TODO: Upcoming vectorization
     sz_edit_distance_t edit_distance;
+    sz_edit_distances_batch_t edit_distances_batch;
+    sz_find_fuzzy_t find_fuzzy;
     sz_alignment_score_t alignment_score;
     sz_hashes_t hashes;
+    sz_hashes_sketch_t hashes_sketch;
+    sz_fingerprints_top_k_t fingerprints_top_k;
+    sz_split_offsets_t split_offsets;
 
 } sz_implementations_t;
 static sz_implementations_t sz_dispatch_table;
 
+/// Generic function pointer type, used to compare the entries of the dispatch table one by one.
+typedef void (*_sz_kernel_ptr_t)(void);
+
+/// Every entry of the dispatch table must be mirrored by an `sz_kernel_t` enumeration entry in the same order.
+typedef char _sz_kernels_count_check_t[sizeof(sz_implementations_t) == sizeof(_sz_kernel_ptr_t) * sz_kernels_count_k
+                                           ? 1
+                                           : -1];
+
+typedef struct sz_kernel_counters_t {
+    sz_u64_t calls;
+    sz_u64_t bytes;
+    sz_u64_t cycles;
+} sz_kernel_counters_t;
+
+static char const *sz_kernel_names[sz_kernels_count_k] = {
+    "sz_equal",                 //
+    "sz_order",                 //
+    "sz_hash",                  //
+    "sz_hash_batch",            //
+    "sz_copy",                  //
+    "sz_move",                  //
+    "sz_fill",                  //
+    "sz_find_byte",             //
+    "sz_rfind_byte",            //
+    "sz_find",                  //
+    "sz_rfind",                 //
+    "sz_find_charset",          //
+    "sz_rfind_charset",         //
+    "sz_find_any",              //
+    "sz_find_case_insensitive", //
+    "sz_find_prepared",         //
+    "sz_tolower",               //
+    "sz_toupper",               //
+    "sz_toascii",               //
+    "sz_isascii",               //
+    "sz_translate",             //
+    "sz_utf8_valid",            //
+    "sz_utf8_count",            //
+    "sz_utf8_find_nth",         //
+    "sz_utf8_to_utf32",         //
+    "sz_edit_distance",         //
+    "sz_edit_distances_batch",  //
+    "sz_find_fuzzy",            //
+    "sz_alignment_score",       //
+    "sz_hashes",                //
+    "sz_hashes_sketch",         //
+    "sz_fingerprints_top_k",    //
+    "sz_split_offsets",         //
+};
+
+static char const *sz_kernel_backends[sz_kernels_count_k];
+static sz_kernel_counters_t sz_kernel_counters[sz_kernels_count_k];
+static sz_stats_mode_t sz_stats_mode = sz_stats_disabled_k;
+static sz_capability_t sz_capabilities_active = (sz_capability_t)0;
+
+/**
+ *  @brief  Labels the entries of the dispatch table, that were replaced since the @p previous snapshot.
+ */
+static void _sz_dispatch_table_label(sz_implementations_t const *previous, char const *backend) {
+    _sz_kernel_ptr_t const *before = (_sz_kernel_ptr_t const *)previous;
+    _sz_kernel_ptr_t const *after = (_sz_kernel_ptr_t const *)&sz_dispatch_table;
+    for (sz_size_t i = 0; i != sz_kernels_count_k; ++i)
+        if (before[i] != after[i]) sz_kernel_backends[i] = backend;
+}
+
 /**
  *  @brief  Initializes a global static "virtual table" of supported backends
- *          Run it just once to avoiding unnecessary `if`-s.
+ *          Run it just once to avoiding unnecessary `if`-s, or again to override the capabilities.
  */
-static void sz_dispatch_table_init(void) {
+static void sz_dispatch_table_update(sz_capability_t caps) {
     sz_implementations_t *impl = &sz_dispatch_table;
-    sz_capability_t caps = sz_capabilities();
+    sz_implementations_t previous;
     sz_unused(caps); //< Unused when compiling on pre-SIMD machines.
+    sz_unused(previous);
 
     impl->equal = sz_equal_serial;
     impl->order = sz_order_serial;
+    impl->hash = sz_hash_serial;
+    impl->hash_batch = sz_hash_batch_serial;
     impl->copy = sz_copy_serial;
     impl->move = sz_move_serial;
     impl->fill = sz_fill_serial;
@@ -146,12 +168,32 @@ static void sz_dispatch_table_init(void) {
     impl->rfind_byte = sz_rfind_byte_serial;
     impl->find_from_set = sz_find_charset_serial;
     impl->rfind_from_set = sz_rfind_charset_serial;
+    impl->find_any = sz_find_any_serial;
+    impl->find_case_insensitive = sz_find_case_insensitive_serial;
+    impl->find_prepared = sz_find_prepared_serial;
+
+    impl->to_lower = sz_tolower_serial;
+    impl->to_upper = sz_toupper_serial;
+    impl->to_ascii = sz_toascii_serial;
+    impl->is_ascii = sz_isascii_serial;
+    impl->translate = sz_translate_serial;
+    impl->utf8_valid = sz_utf8_valid_serial;
+    impl->utf8_count = sz_utf8_count_serial;
+    impl->utf8_find_nth = sz_utf8_find_nth_serial;
+    impl->utf8_to_utf32 = sz_utf8_to_utf32_serial;
 
     impl->edit_distance = sz_edit_distance_serial;
+    impl->edit_distances_batch = sz_edit_distances_batch_serial;
+    impl->find_fuzzy = sz_find_fuzzy_serial;
     impl->alignment_score = sz_alignment_score_serial;
     impl->hashes = sz_hashes_serial;
+    impl->hashes_sketch = sz_hashes_sketch_serial;
+    impl->fingerprints_top_k = sz_fingerprints_top_k_serial;
+    impl->split_offsets = sz_split_offsets_serial;
+    for (sz_size_t i = 0; i != sz_kernels_count_k; ++i) sz_kernel_backends[i] = "serial";
 
 #if SZ_USE_X86_AVX2
+    previous = *impl;
     if (caps & sz_cap_x86_avx2_k) {
         impl->copy = sz_copy_avx2;
         impl->move = sz_move_avx2;
@@ -160,10 +202,22 @@ static void sz_dispatch_table_init(void) {
         impl->rfind_byte = sz_rfind_byte_avx2;
         impl->find = sz_find_avx2;
         impl->rfind = sz_rfind_avx2;
+        impl->find_prepared = sz_find_prepared_avx2;
+        impl->find_any = sz_find_any_avx2;
+        impl->hash_batch = sz_hash_batch_avx2;
+        impl->alignment_score = sz_alignment_score_avx2;
+        impl->find_case_insensitive = sz_find_case_insensitive_avx2;
+        impl->to_lower = sz_tolower_avx2;
+        impl->to_upper = sz_toupper_avx2;
+        impl->to_ascii = sz_toascii_avx2;
+        impl->is_ascii = sz_isascii_avx2;
+        impl->translate = sz_translate_avx2;
     }
+    _sz_dispatch_table_label(&previous, "avx2");
 #endif
 
 #if SZ_USE_X86_AVX512
+    previous = *impl;
     if (caps & sz_cap_x86_avx512f_k) {
         impl->equal = sz_equal_avx512;
         impl->order = sz_order_avx512;
@@ -173,30 +227,203 @@ static void sz_dispatch_table_init(void) {
 
         impl->find = sz_find_avx512;
         impl->rfind = sz_rfind_avx512;
+        impl->find_prepared = sz_find_prepared_avx512;
         impl->find_byte = sz_find_byte_avx512;
         impl->rfind_byte = sz_rfind_byte_avx512;
+        impl->find_any = sz_find_any_avx512;
+        impl->hash_batch = sz_hash_batch_avx512;
+        impl->find_case_insensitive = sz_find_case_insensitive_avx512;
+        impl->to_lower = sz_tolower_avx512;
+        impl->to_upper = sz_toupper_avx512;
+        impl->to_ascii = sz_toascii_avx512;
+        impl->is_ascii = sz_isascii_avx512;
+        impl->utf8_valid = sz_utf8_valid_avx512;
+        impl->utf8_count = sz_utf8_count_avx512;
+        impl->utf8_find_nth = sz_utf8_find_nth_avx512;
 
         impl->edit_distance = sz_edit_distance_avx512;
+        impl->edit_distances_batch = sz_edit_distances_batch_avx512;
+        impl->find_fuzzy = sz_find_fuzzy_avx512;
+    }
+
+    // Every CPU with AVX-512BW also supports the AVX-512DQ 64-bit multiplications used for the permutations.
+    if ((caps & sz_cap_x86_avx512f_k) && (caps & sz_cap_x86_avx512vl_k) && (caps & sz_cap_x86_avx512bw_k)) {
+        impl->hashes_sketch = sz_hashes_sketch_avx512;
+    }
+
+    // The population counts of whole ZMM registers come with the separate VPOPCNTDQ extension, from Ice Lake on.
+    if ((caps & sz_cap_x86_avx512f_k) && (caps & sz_cap_x86_avx512bw_k) && (caps & sz_cap_x86_avx512vpopcntdq_k)) {
+        impl->fingerprints_top_k = sz_fingerprints_top_k_avx512;
+    }
+
+    // The byte permutations only need VBMI, that some CPUs, like Cannon Lake, have without GFNI.
+    // Skylake-X and Cascade Lake have neither, so they keep the AVX2 or serial kernels.
+    if ((caps & sz_cap_x86_avx512f_k) && (caps & sz_cap_x86_avx512vl_k) && (caps & sz_cap_x86_avx512bw_k) &&
+        (caps & sz_cap_x86_avx512vbmi_k)) {
+        impl->translate = sz_translate_avx512;
+        impl->split_offsets = sz_split_offsets_avx512;
     }
 
     if ((caps & sz_cap_x86_avx512f_k) && (caps & sz_cap_x86_avx512vl_k) && (caps & sz_cap_x86_gfni_k) &&
         (caps & sz_cap_x86_avx512bw_k) && (caps & sz_cap_x86_avx512vbmi_k)) {
         impl->find_from_set = sz_find_charset_avx512;
         impl->rfind_from_set = sz_rfind_charset_avx512;
-        impl->alignment_score = sz_alignment_score_avx512;
+        impl->utf8_to_utf32 = sz_utf8_to_utf32_avx512;
+        // The anti-diagonal AVX2 kernel for `alignment_score` is faster than the horizontal AVX-512 one,
+        // which is bottlenecked by the running maximum of insertion costs, so we keep it.
     }
+    _sz_dispatch_table_label(&previous, "avx512");
 #endif
 
 #if SZ_USE_ARM_NEON
+    previous = *impl;
     if (caps & sz_cap_arm_neon_k) {
         impl->find = sz_find_neon;
         impl->rfind = sz_rfind_neon;
+        impl->find_prepared = sz_find_prepared_neon;
         impl->find_byte = sz_find_byte_neon;
         impl->rfind_byte = sz_rfind_byte_neon;
         impl->find_from_set = sz_find_charset_neon;
         impl->rfind_from_set = sz_rfind_charset_neon;
+        impl->find_any = sz_find_any_neon;
+        impl->hash_batch = sz_hash_batch_neon;
+        impl->alignment_score = sz_alignment_score_neon;
+        impl->find_case_insensitive = sz_find_case_insensitive_neon;
+        impl->to_lower = sz_tolower_neon;
+        impl->to_upper = sz_toupper_neon;
+        impl->to_ascii = sz_toascii_neon;
+        impl->is_ascii = sz_isascii_neon;
+        impl->translate = sz_translate_neon;
+        impl->utf8_valid = sz_utf8_valid_neon;
+        impl->utf8_count = sz_utf8_count_neon;
+        impl->utf8_find_nth = sz_utf8_find_nth_neon;
+        impl->utf8_to_utf32 = sz_utf8_to_utf32_neon;
+        impl->fingerprints_top_k = sz_fingerprints_top_k_neon;
+        impl->split_offsets = sz_split_offsets_neon;
+    }
+    _sz_dispatch_table_label(&previous, "neon");
+#endif
+
+#if SZ_USE_ARM_SVE
+    previous = *impl;
+    if (caps & sz_cap_arm_sve_k) {
+        impl->equal = sz_equal_sve;
+        impl->order = sz_order_sve;
+        impl->copy = sz_copy_sve;
+        impl->fill = sz_fill_sve;
+        impl->find = sz_find_sve;
+        impl->rfind = sz_rfind_sve;
+        impl->find_byte = sz_find_byte_sve;
+        impl->rfind_byte = sz_rfind_byte_sve;
+        impl->hashes = sz_hashes_sve;
     }
+    _sz_dispatch_table_label(&previous, "sve");
 #endif
+
+#if SZ_USE_ARM_SVE2
+    previous = *impl;
+    if (caps & sz_cap_arm_sve2_k) {
+        impl->find_from_set = sz_find_charset_sve2;
+        impl->rfind_from_set = sz_rfind_charset_sve2;
+    }
+    _sz_dispatch_table_label(&previous, "sve2");
+#endif
+
+    sz_capabilities_active = caps;
+}
+
+SZ_DYNAMIC sz_capability_t sz_capabilities(void) {
+    return sz_capabilities_active ? sz_capabilities_active : _sz_capabilities_detect();
+}
+
+SZ_DYNAMIC sz_capability_t sz_capabilities_override(sz_capability_t mask) {
+    sz_dispatch_table_update((sz_capability_t)((_sz_capabilities_detect() & mask) | sz_cap_serial_k));
+    return sz_capabilities_active;
+}
+
+SZ_DYNAMIC sz_capability_t sz_capabilities_parse(sz_cptr_t names, sz_size_t length) {
+    typedef struct {
+        char const *name;
+        sz_size_t length;
+        unsigned caps;
+    } capability_name_t;
+    static capability_name_t const known[] = {
+        {"serial", 6, sz_cap_serial_k},
+        {"neon", 4, sz_cap_arm_neon_k},
+        {"sve", 3, sz_cap_arm_sve_k},
+        {"sve2", 4, sz_cap_arm_sve2_k},
+        {"avx2", 4, sz_cap_x86_avx2_k},
+        {"avx512", 6,
+         sz_cap_x86_avx512f_k | sz_cap_x86_avx512vl_k | sz_cap_x86_avx512bw_k | sz_cap_x86_avx512vbmi_k |
+             sz_cap_x86_gfni_k | sz_cap_x86_avx512vpopcntdq_k},
+        {"avx512f", 7, sz_cap_x86_avx512f_k},
+        {"avx512vl", 8, sz_cap_x86_avx512vl_k},
+        {"avx512bw", 8, sz_cap_x86_avx512bw_k},
+        {"avx512vbmi", 10, sz_cap_x86_avx512vbmi_k},
+        {"gfni", 4, sz_cap_x86_gfni_k},
+        {"avx512vpopcntdq", 15, sz_cap_x86_avx512vpopcntdq_k},
+    };
+    sz_cptr_t const end = names + length;
+    unsigned caps = 0;
+
+    // Hexadecimal bitmasks, like "0x100001"
+    if (length > 2 && names[0] == '0' && (names[1] == 'x' || names[1] == 'X')) {
+        for (names += 2; names != end; ++names) {
+            char c = *names;
+            if (c >= '0' && c <= '9') caps = (caps << 4) | (unsigned)(c - '0');
+            else if (c >= 'a' && c <= 'f') caps = (caps << 4) | (unsigned)(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') caps = (caps << 4) | (unsigned)(c - 'A' + 10);
+            else break;
+        }
+        return (sz_capability_t)((caps & sz_cap_any_k) | sz_cap_serial_k);
+    }
+
+    // Comma-separated names, like "serial,avx2", ignoring the whitespaces around them
+    caps = sz_cap_serial_k;
+    while (names != end) {
+        while (names != end && (*names == ',' || *names == ' ')) ++names;
+        sz_cptr_t token = names;
+        while (names != end && *names != ',' && *names != ' ') ++names;
+        sz_size_t token_length = (sz_size_t)(names - token);
+        for (sz_size_t i = 0; i != sizeof(known) / sizeof(known[0]); ++i)
+            if (known[i].length == token_length && sz_equal_serial(known[i].name, token, token_length))
+                caps |= known[i].caps;
+    }
+    return (sz_capability_t)caps;
+}
+
+SZ_DYNAMIC void sz_stats_enable(sz_stats_mode_t mode) { sz_stats_mode = mode; }
+
+SZ_DYNAMIC sz_size_t sz_stats_get(sz_kernel_stats_t *stats, sz_size_t capacity) {
+    for (sz_size_t i = 0; i != capacity && i != sz_kernels_count_k; ++i) {
+        stats[i].name = sz_kernel_names[i];
+        stats[i].backend = sz_kernel_backends[i];
+        stats[i].calls = sz_kernel_counters[i].calls;
+        stats[i].bytes = sz_kernel_counters[i].bytes;
+        stats[i].cycles = sz_kernel_counters[i].cycles;
+    }
+    return sz_kernels_count_k;
+}
+
+SZ_DYNAMIC void sz_stats_reset(void) {
+    for (sz_size_t i = 0; i != sz_kernels_count_k; ++i)
+        sz_kernel_counters[i].calls = sz_kernel_counters[i].bytes = sz_kernel_counters[i].cycles = 0;
+}
+
+/**
+ *  @brief  Picks the backends at load time, respecting the `SZ_FORCE_CAPS` environment variable, if present.
+ */
+static void sz_dispatch_table_init(void) {
+    sz_capability_t mask = sz_cap_any_k;
+#if !SZ_AVOID_LIBC
+    char const *forced = getenv("SZ_FORCE_CAPS");
+    if (forced && *forced) {
+        sz_size_t length = 0;
+        while (forced[length]) ++length;
+        mask = sz_capabilities_parse(forced, length);
+    }
+#endif
+    sz_capabilities_override(mask);
 }
 
 #if defined(_MSC_VER)
@@ -212,66 +439,238 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpReserved) {
 __attribute__((constructor)) static void sz_dispatch_table_init_on_gcc_or_clang(void) { sz_dispatch_table_init(); }
 #endif
 
+/**
+ *  @brief  Reads the timestamp counter of the current core, or returns zero on unknown platforms.
+ */
+SZ_INTERNAL sz_u64_t _sz_stats_ticks(void) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    sz_u64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return 0;
+#endif
+}
+
+SZ_INTERNAL void _sz_stats_add(sz_u64_t *counter, sz_u64_t value) {
+#if defined(_MSC_VER)
+    InterlockedExchangeAdd64((LONG64 volatile *)counter, (LONG64)value);
+#else
+    __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+SZ_INTERNAL sz_u64_t _sz_stats_begin(void) { return sz_stats_mode == sz_stats_cycles_k ? _sz_stats_ticks() : 0; }
+
+SZ_INTERNAL void _sz_stats_end(sz_kernel_t kernel, sz_size_t bytes, sz_u64_t start) {
+    sz_kernel_counters_t *counters = &sz_kernel_counters[kernel];
+    _sz_stats_add(&counters->calls, 1);
+    _sz_stats_add(&counters->bytes, bytes);
+    if (start) _sz_stats_add(&counters->cycles, _sz_stats_ticks() - start);
+}
+
+/**
+ *  @brief  Calls the backend from the dispatch table, returning its result of the given @p type,
+ *          and accounting for the call in the statistics of the @p kernel, if those are enabled.
+ */
+#define _sz_dispatch_return(type, kernel, bytes, call)         \
+    do {                                                       \
+        if (sz_stats_mode == sz_stats_disabled_k) return call; \
+        sz_u64_t _sz_start = _sz_stats_begin();                \
+        type _sz_result = call;                                \
+        _sz_stats_end(kernel, bytes, _sz_start);               \
+        return _sz_result;                                     \
+    } while (0)
+
+/**
+ *  @brief  Calls the backend from the dispatch table, that returns nothing,
+ *          and accounts for the call in the statistics of the @p kernel, if those are enabled.
+ */
+#define _sz_dispatch_void(kernel, bytes, call)              \
+    do {                                                    \
+        if (sz_stats_mode == sz_stats_disabled_k) { call; } \
+        else {                                              \
+            sz_u64_t _sz_start = _sz_stats_begin();         \
+            call;                                           \
+            _sz_stats_end(kernel, bytes, _sz_start);        \
+        }                                                   \
+    } while (0)
+
+SZ_DYNAMIC sz_u64_t sz_hash(sz_cptr_t text, sz_size_t length) {
+    _sz_dispatch_return(sz_u64_t, sz_kernel_hash_k, length, sz_dispatch_table.hash(text, length));
+}
+
+SZ_DYNAMIC void sz_hash_batch(sz_sequence_t const *sequence, sz_u64_t *hashes) {
+    _sz_dispatch_void(sz_kernel_hash_batch_k, 0, sz_dispatch_table.hash_batch(sequence, hashes));
+}
+
 SZ_DYNAMIC sz_bool_t sz_equal(sz_cptr_t a, sz_cptr_t b, sz_size_t length) {
-    return sz_dispatch_table.equal(a, b, length);
+    _sz_dispatch_return(sz_bool_t, sz_kernel_equal_k, length * 2, sz_dispatch_table.equal(a, b, length));
 }
 
 SZ_DYNAMIC sz_ordering_t sz_order(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length) {
-    return sz_dispatch_table.order(a, a_length, b, b_length);
+    _sz_dispatch_return(sz_ordering_t, sz_kernel_order_k, a_length + b_length,
+                        sz_dispatch_table.order(a, a_length, b, b_length));
 }
 
 SZ_DYNAMIC void sz_copy(sz_ptr_t target, sz_cptr_t source, sz_size_t length) {
-    sz_dispatch_table.copy(target, source, length);
+    _sz_dispatch_void(sz_kernel_copy_k, length, sz_dispatch_table.copy(target, source, length));
 }
 
 SZ_DYNAMIC void sz_move(sz_ptr_t target, sz_cptr_t source, sz_size_t length) {
-    sz_dispatch_table.move(target, source, length);
+    _sz_dispatch_void(sz_kernel_move_k, length, sz_dispatch_table.move(target, source, length));
 }
 
 SZ_DYNAMIC void sz_fill(sz_ptr_t target, sz_size_t length, sz_u8_t value) {
-    sz_dispatch_table.fill(target, length, value);
+    _sz_dispatch_void(sz_kernel_fill_k, length, sz_dispatch_table.fill(target, length, value));
 }
 
 SZ_DYNAMIC sz_cptr_t sz_find_byte(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle) {
-    return sz_dispatch_table.find_byte(haystack, h_length, needle);
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_find_byte_k, h_length,
+                        sz_dispatch_table.find_byte(haystack, h_length, needle));
 }
 
 SZ_DYNAMIC sz_cptr_t sz_rfind_byte(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle) {
-    return sz_dispatch_table.rfind_byte(haystack, h_length, needle);
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_rfind_byte_k, h_length,
+                        sz_dispatch_table.rfind_byte(haystack, h_length, needle));
 }
 
 SZ_DYNAMIC sz_cptr_t sz_find(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length) {
-    return sz_dispatch_table.find(haystack, h_length, needle, n_length);
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_find_k, h_length,
+                        sz_dispatch_table.find(haystack, h_length, needle, n_length));
 }
 
 SZ_DYNAMIC sz_cptr_t sz_rfind(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length) {
-    return sz_dispatch_table.rfind(haystack, h_length, needle, n_length);
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_rfind_k, h_length,
+                        sz_dispatch_table.rfind(haystack, h_length, needle, n_length));
 }
 
 SZ_DYNAMIC sz_cptr_t sz_find_charset(sz_cptr_t text, sz_size_t length, sz_charset_t const *set) {
-    return sz_dispatch_table.find_from_set(text, length, set);
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_find_charset_k, length,
+                        sz_dispatch_table.find_from_set(text, length, set));
 }
 
 SZ_DYNAMIC sz_cptr_t sz_rfind_charset(sz_cptr_t text, sz_size_t length, sz_charset_t const *set) {
-    return sz_dispatch_table.rfind_from_set(text, length, set);
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_rfind_charset_k, length,
+                        sz_dispatch_table.rfind_from_set(text, length, set));
+}
+
+SZ_DYNAMIC sz_cptr_t sz_find_any(sz_multi_pattern_t const *pattern, sz_cptr_t haystack, sz_size_t h_length,
+                                 sz_size_t *needle_id) {
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_find_any_k, h_length,
+                        sz_dispatch_table.find_any(pattern, haystack, h_length, needle_id));
+}
+
+SZ_DYNAMIC sz_cptr_t sz_find_case_insensitive(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                              sz_size_t n_length) {
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_find_case_insensitive_k, h_length,
+                        sz_dispatch_table.find_case_insensitive(haystack, h_length, needle, n_length));
+}
+
+SZ_DYNAMIC sz_cptr_t sz_find_prepared(sz_needle_t const *needle, sz_cptr_t haystack, sz_size_t h_length) {
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_find_prepared_k, h_length,
+                        sz_dispatch_table.find_prepared(needle, haystack, h_length));
+}
+
+SZ_DYNAMIC void sz_tolower(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    _sz_dispatch_void(sz_kernel_tolower_k, length, sz_dispatch_table.to_lower(text, length, result));
+}
+
+SZ_DYNAMIC void sz_toupper(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    _sz_dispatch_void(sz_kernel_toupper_k, length, sz_dispatch_table.to_upper(text, length, result));
+}
+
+SZ_DYNAMIC void sz_toascii(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    _sz_dispatch_void(sz_kernel_toascii_k, length, sz_dispatch_table.to_ascii(text, length, result));
+}
+
+SZ_DYNAMIC sz_bool_t sz_isascii(sz_cptr_t text, sz_size_t length) {
+    _sz_dispatch_return(sz_bool_t, sz_kernel_isascii_k, length, sz_dispatch_table.is_ascii(text, length));
+}
+
+SZ_DYNAMIC void sz_translate(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result) {
+    _sz_dispatch_void(sz_kernel_translate_k, length, sz_dispatch_table.translate(text, length, lut, result));
+}
+
+SZ_DYNAMIC sz_bool_t sz_utf8_valid(sz_cptr_t text, sz_size_t length) {
+    _sz_dispatch_return(sz_bool_t, sz_kernel_utf8_valid_k, length, sz_dispatch_table.utf8_valid(text, length));
+}
+
+SZ_DYNAMIC sz_size_t sz_utf8_count(sz_cptr_t text, sz_size_t length) {
+    _sz_dispatch_return(sz_size_t, sz_kernel_utf8_count_k, length, sz_dispatch_table.utf8_count(text, length));
+}
+
+SZ_DYNAMIC sz_cptr_t sz_utf8_find_nth(sz_cptr_t text, sz_size_t length, sz_size_t n) {
+    _sz_dispatch_return(sz_cptr_t, sz_kernel_utf8_find_nth_k, length,
+                        sz_dispatch_table.utf8_find_nth(text, length, n));
+}
+
+SZ_DYNAMIC sz_size_t sz_utf8_to_utf32(sz_cptr_t text, sz_size_t length, sz_rune_t *runes) {
+    _sz_dispatch_return(sz_size_t, sz_kernel_utf8_to_utf32_k, length,
+                        sz_dispatch_table.utf8_to_utf32(text, length, runes));
 }
 
 SZ_DYNAMIC sz_size_t sz_edit_distance( //
     sz_cptr_t a, sz_size_t a_length,   //
     sz_cptr_t b, sz_size_t b_length,   //
     sz_size_t bound, sz_memory_allocator_t *alloc) {
-    return sz_dispatch_table.edit_distance(a, a_length, b, b_length, bound, alloc);
+    _sz_dispatch_return(sz_size_t, sz_kernel_edit_distance_k, a_length + b_length,
+                        sz_dispatch_table.edit_distance(a, a_length, b, b_length, bound, alloc));
+}
+
+SZ_DYNAMIC sz_bool_t sz_edit_distances_batch(sz_cptr_t query, sz_size_t query_length, sz_sequence_t const *candidates,
+                                             sz_size_t bound, sz_size_t *distances, sz_memory_allocator_t *alloc) {
+    _sz_dispatch_return(
+        sz_bool_t, sz_kernel_edit_distances_batch_k, query_length,
+        sz_dispatch_table.edit_distances_batch(query, query_length, candidates, bound, distances, alloc));
+}
+
+SZ_DYNAMIC sz_cptr_t sz_find_fuzzy(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length, //
+                                   sz_size_t max_edits, sz_memory_allocator_t *alloc, sz_size_t *match_length) {
+    _sz_dispatch_return(
+        sz_cptr_t, sz_kernel_find_fuzzy_k, h_length,
+        sz_dispatch_table.find_fuzzy(haystack, h_length, needle, n_length, max_edits, alloc, match_length));
 }
 
 SZ_DYNAMIC sz_ssize_t sz_alignment_score(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length,
                                          sz_error_cost_t const *subs, sz_error_cost_t gap,
                                          sz_memory_allocator_t *alloc) {
-    return sz_dispatch_table.alignment_score(a, a_length, b, b_length, subs, gap, alloc);
+    _sz_dispatch_return(sz_ssize_t, sz_kernel_alignment_score_k, a_length + b_length,
+                        sz_dispatch_table.alignment_score(a, a_length, b, b_length, subs, gap, alloc));
 }
 
 SZ_DYNAMIC void sz_hashes(sz_cptr_t text, sz_size_t length, sz_size_t window_length, sz_size_t step, //
                           sz_hash_callback_t callback, void *callback_handle) {
-    sz_dispatch_table.hashes(text, length, window_length, step, callback, callback_handle);
+    _sz_dispatch_void(sz_kernel_hashes_k, length,
+                      sz_dispatch_table.hashes(text, length, window_length, step, callback, callback_handle));
+}
+
+SZ_DYNAMIC void sz_hashes_sketch(sz_cptr_t text, sz_size_t length, sz_size_t const *window_lengths,
+                                 sz_size_t windows_count, sz_size_t permutations_count, sz_u64_t *min_hashes,
+                                 sz_u64_t *sim_hashes) {
+    _sz_dispatch_void(sz_kernel_hashes_sketch_k, length,
+                      sz_dispatch_table.hashes_sketch(text, length, window_lengths, windows_count,
+                                                      permutations_count, min_hashes, sim_hashes));
+}
+
+SZ_DYNAMIC sz_size_t sz_fingerprints_top_k(sz_cptr_t query, sz_cptr_t fingerprints, sz_size_t fingerprint_bytes,
+                                           sz_sorted_idx_t const *ids, sz_size_t count, sz_size_t k,
+                                           sz_fingerprint_metric_t metric, sz_fingerprint_match_t *matches) {
+    _sz_dispatch_return(sz_size_t, sz_kernel_fingerprints_top_k_k, count * fingerprint_bytes,
+                        sz_dispatch_table.fingerprints_top_k(query, fingerprints, fingerprint_bytes, ids, count, k,
+                                                             metric, matches));
+}
+
+SZ_DYNAMIC sz_size_t sz_split_offsets(sz_cptr_t text, sz_size_t length, sz_charset_t const *delimiters,
+                                      sz_size_t base, void *offsets, sz_size_t offset_bytes, sz_size_t capacity,
+                                      sz_size_t *consumed) {
+    _sz_dispatch_return(sz_size_t, sz_kernel_split_offsets_k, length,
+                        sz_dispatch_table.split_offsets(text, length, delimiters, base, offsets, offset_bytes,
+                                                        capacity, consumed));
 }
 
 SZ_DYNAMIC sz_cptr_t sz_find_char_from(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
@@ -7,12 +7,14 @@
  *
  *  - `SZ_DEBUG=0` - whether to enable debug assertions and logging.
  *  - `SZ_DYNAMIC_DISPATCH=0` - whether to use runtime dispatching of the most advanced SIMD backend.
+ *  - `SZ_LAZY_DISPATCH=0` - whether to pick the hottest backends at first use, without linking the library.
  *  - `SZ_USE_MISALIGNED_LOADS=0` - whether to use misaligned loads on platforms that support them.
  *  - `SZ_SWAR_THRESHOLD=24` - threshold for switching to SWAR backend over serial byte-level for-loops.
  *  - `SZ_USE_X86_AVX512=?` - whether to use AVX-512 instructions on x86_64.
  *  - `SZ_USE_X86_AVX2=?` - whether to use AVX2 instructions on x86_64.
  *  - `SZ_USE_ARM_NEON=?` - whether to use NEON instructions on ARM.
  *  - `SZ_USE_ARM_SVE=?` - whether to use SVE instructions on ARM.
+ *  - `SZ_USE_ARM_SVE2=?` - whether to use SVE2 instructions on ARM.
  *
  *  @see    StringZilla: https://github.com/ashvardanian/StringZilla/blob/main/README.md
  *  @see    LibC String: https://pubs.opengroup.org/onlinepubs/009695399/basedefs/string.h.html
@@ -64,6 +66,17 @@
 #define SZ_DYNAMIC_DISPATCH (0) // true or false
 #endif
 
+/**
+ *  @brief  Header-only alternative to `SZ_DYNAMIC_DISPATCH`, that doesn't need the precompiled library.
+ *          All the SIMD backends of the target architecture are compiled into every translation unit, and the
+ *          `sz_find`, `sz_order`, `sz_edit_distance`, and related search and comparison functions pick the most
+ *          advanced one supported by the CPU at their first call, caching it in a function pointer.
+ *          The other functions are dispatched at compile time, only using the extensions the compiler may assume.
+ */
+#ifndef SZ_LAZY_DISPATCH
+#define SZ_LAZY_DISPATCH (0) // true or false
+#endif
+
 /**
  *  @brief  Analogous to `size_t` and `std::size_t`, unsigned integer, identical to pointer size.
  *          64-bit on most platforms where pointers are 64-bit.
@@ -78,6 +91,7 @@
 #define SZ_SIZE_MAX (0xFFFFFFFFu)  // Largest unsigned integer that fits into 32 bits.
 #define SZ_SSIZE_MAX (0x7FFFFFFFu) // Largest signed integer that fits into 32 bits.
 #endif
+#define SZ_U64_MAX (0xFFFFFFFFFFFFFFFFull) // Largest unsigned 64-bit integer, regardless of the pointer size.
 
 /**
  *  @brief  On Big-Endian machines StringZilla will work in compatibility mode.
@@ -226,23 +240,133 @@ typedef enum sz_capability_t {
     sz_cap_any_k = 0x7FFFFFFF, /// Mask representing any capability
 
     sz_cap_arm_neon_k = 1 << 10, /// ARM NEON capability
-    sz_cap_arm_sve_k = 1 << 11,  /// ARM SVE capability TODO: Not yet supported or used
+    sz_cap_arm_sve_k = 1 << 11,  /// ARM SVE capability
+    sz_cap_arm_sve2_k = 1 << 12, /// ARM SVE2 capability
 
-    sz_cap_x86_avx2_k = 1 << 20,       /// x86 AVX2 capability
-    sz_cap_x86_avx512f_k = 1 << 21,    /// x86 AVX512 F capability
-    sz_cap_x86_avx512bw_k = 1 << 22,   /// x86 AVX512 BW instruction capability
-    sz_cap_x86_avx512vl_k = 1 << 23,   /// x86 AVX512 VL instruction capability
-    sz_cap_x86_avx512vbmi_k = 1 << 24, /// x86 AVX512 VBMI instruction capability
-    sz_cap_x86_gfni_k = 1 << 25,       /// x86 AVX512 GFNI instruction capability
+    sz_cap_x86_avx2_k = 1 << 20,            /// x86 AVX2 capability
+    sz_cap_x86_avx512f_k = 1 << 21,         /// x86 AVX512 F capability
+    sz_cap_x86_avx512bw_k = 1 << 22,        /// x86 AVX512 BW instruction capability
+    sz_cap_x86_avx512vl_k = 1 << 23,        /// x86 AVX512 VL instruction capability
+    sz_cap_x86_avx512vbmi_k = 1 << 24,      /// x86 AVX512 VBMI instruction capability
+    sz_cap_x86_gfni_k = 1 << 25,            /// x86 AVX512 GFNI instruction capability
+    sz_cap_x86_avx512vpopcntdq_k = 1 << 26, /// x86 AVX512 VPOPCNTDQ instruction capability
 
 } sz_capability_t;
 
 /**
  *  @brief  Function to determine the SIMD capabilities of the current machine @b only at @b runtime.
+ *          Reports the capabilities used by the dispatch table, which can be narrowed down from the
+ *          ones the CPU supports with `sz_capabilities_override` or the `SZ_FORCE_CAPS` environment variable.
  *  @return A bitmask of the SIMD capabilities represented as a `sz_capability_t` enum value.
  */
 SZ_DYNAMIC sz_capability_t sz_capabilities(void);
 
+/**
+ *  @brief  Re-initializes the dispatch table of the dynamic library to only use the backends from the
+ *          @p mask, that are also supported by the CPU, to compare the backends on the same machine.
+ *          The serial backend is always kept. Passing `sz_cap_any_k` restores the default choice.
+ *          The same can be done at load time, setting the `SZ_FORCE_CAPS` environment variable to a
+ *          comma-separated list of capability names, like "serial,avx2", parsed by `sz_capabilities_parse`.
+ *
+ *  @warning Not thread-safe! Call it before other threads start using the library.
+ *  @return  The capabilities used by the dispatch table from now on.
+ */
+SZ_DYNAMIC sz_capability_t sz_capabilities_override(sz_capability_t mask);
+
+/**
+ *  @brief  Parses a comma-separated list of capability names, like "serial,avx2,avx512f", or a hexadecimal
+ *          bitmask, like "0x100001". The names match the `__capabilities__` of the Python bindings, and
+ *          "avx512" is an alias for all of the AVX-512 subsets. Unknown names are ignored.
+ *  @return A bitmask of the parsed capabilities, always including `sz_cap_serial_k`.
+ */
+SZ_DYNAMIC sz_capability_t sz_capabilities_parse(sz_cptr_t names, sz_size_t length);
+
+/**
+ *  @brief  Entry points of the dynamic library, that are served by different backends,
+ *          and are individually accounted for in the statistics, if those are enabled.
+ *  @see    sz_stats_enable, sz_stats_get
+ */
+typedef enum sz_kernel_t {
+    sz_kernel_equal_k,
+    sz_kernel_order_k,
+    sz_kernel_hash_k,
+    sz_kernel_hash_batch_k,
+    sz_kernel_copy_k,
+    sz_kernel_move_k,
+    sz_kernel_fill_k,
+    sz_kernel_find_byte_k,
+    sz_kernel_rfind_byte_k,
+    sz_kernel_find_k,
+    sz_kernel_rfind_k,
+    sz_kernel_find_charset_k,
+    sz_kernel_rfind_charset_k,
+    sz_kernel_find_any_k,
+    sz_kernel_find_case_insensitive_k,
+    sz_kernel_find_prepared_k,
+    sz_kernel_tolower_k,
+    sz_kernel_toupper_k,
+    sz_kernel_toascii_k,
+    sz_kernel_isascii_k,
+    sz_kernel_translate_k,
+    sz_kernel_utf8_valid_k,
+    sz_kernel_utf8_count_k,
+    sz_kernel_utf8_find_nth_k,
+    sz_kernel_utf8_to_utf32_k,
+    sz_kernel_edit_distance_k,
+    sz_kernel_edit_distances_batch_k,
+    sz_kernel_find_fuzzy_k,
+    sz_kernel_alignment_score_k,
+    sz_kernel_hashes_k,
+    sz_kernel_hashes_sketch_k,
+    sz_kernel_fingerprints_top_k_k,
+    sz_kernel_split_offsets_k,
+    sz_kernels_count_k, /// Number of entry points, not a valid entry point itself
+} sz_kernel_t;
+
+/**
+ *  @brief  Statistics modes, that trade the accuracy of the telemetry for the overhead of every call.
+ *
+ *  - `sz_stats_counts_k` counts the calls and the processed bytes with relaxed atomic additions.
+ *  - `sz_stats_cycles_k` additionally reads the timestamp counter before and after every call,
+ *    like `rdtsc` on x86 or `cntvct_el0` on Arm, which is only meaningful for large inputs.
+ */
+typedef enum sz_stats_mode_t {
+    sz_stats_disabled_k = 0,
+    sz_stats_counts_k = 1,
+    sz_stats_cycles_k = 3,
+} sz_stats_mode_t;
+
+/**
+ *  @brief  Telemetry of a single entry point of the dynamic library, and the backend serving it.
+ *          The number of bytes is the length of the primary input of every call, like the haystack
+ *          of a search, or the sum of lengths of both strings of a comparison. The strings of an
+ *          `sz_sequence_t` aren't accounted for, to avoid traversing them twice.
+ */
+typedef struct sz_kernel_stats_t {
+    char const *name;    /// Name of the public function, like "sz_find"
+    char const *backend; /// Name of the backend serving it, like "serial", "avx2", or "avx512"
+    sz_u64_t calls;
+    sz_u64_t bytes;
+    sz_u64_t cycles;
+} sz_kernel_stats_t;
+
+/**
+ *  @brief  Enables or disables the per-kernel statistics of the dynamic library, disabled by default.
+ *          When disabled, every call only pays for a single predictable branch.
+ */
+SZ_DYNAMIC void sz_stats_enable(sz_stats_mode_t mode);
+
+/**
+ *  @brief  Exports the statistics of up to @p capacity entry points, in the order of `sz_kernel_t`.
+ *  @return The number of entry points, `sz_kernels_count_k`, regardless of the @p capacity.
+ */
+SZ_DYNAMIC sz_size_t sz_stats_get(sz_kernel_stats_t *stats, sz_size_t capacity);
+
+/**
+ *  @brief  Zeroes the counters of all entry points, keeping the statistics mode unchanged.
+ */
+SZ_DYNAMIC void sz_stats_reset(void);
+
 /**
  *  @brief  Bit-set structure for 256 possible byte values. Useful for filtering and search.
  *  @see    sz_charset_init, sz_charset_add, sz_charset_contains, sz_charset_invert
@@ -318,6 +442,71 @@ SZ_PUBLIC void sz_memory_allocator_init_default(sz_memory_allocator_t *alloc);
  */
 SZ_PUBLIC void sz_memory_allocator_init_fixed(sz_memory_allocator_t *alloc, void *buffer, sz_size_t length);
 
+/**
+ *  @brief  Growable bump allocator, that serves allocations from a chain of chunks, and frees them all at once.
+ *          Every new chunk is twice as large as the previous one, or large enough to fit the requested block.
+ *          Individual deallocations are no-ops, unless they release the most recent allocation,
+ *          like the old buffer of a string that has just been reallocated to grow.
+ *  @see    sz_memory_arena_init, sz_memory_allocator_init_arena, sz_memory_arena_reset
+ */
+typedef struct sz_memory_arena_t {
+    sz_memory_allocator_t upstream; /// Allocator for the chunks themselves, like `malloc`
+    void *chunk;                    /// Most recent chunk, starting with a link to the previous one
+    sz_ptr_t cursor;                /// First unused byte of the most recent chunk
+    sz_ptr_t end;                   /// End of the most recent chunk
+    sz_size_t chunk_capacity;       /// Capacity of the next allocated chunk
+} sz_memory_arena_t;
+
+/**
+ *  @brief  Initializes an empty arena, that won't allocate anything until the first request.
+ *
+ *  @param arena            Arena to initialize.
+ *  @param chunk_capacity   Capacity of the first chunk in bytes, or zero for the default of 4096 bytes.
+ *  @param upstream         Allocator for the chunks, or NULL for the system default `malloc` and `free`.
+ *                          @b Must be provided, if the library was compiled with `SZ_AVOID_LIBC`.
+ */
+SZ_PUBLIC void sz_memory_arena_init(sz_memory_arena_t *arena, sz_size_t chunk_capacity,
+                                    sz_memory_allocator_t const *upstream);
+
+/**
+ *  @brief  Invalidates all of the allocations at once, keeping only the most recent and largest chunk for reuse.
+ *          Every string or buffer previously allocated from the arena becomes dangling!
+ */
+SZ_PUBLIC void sz_memory_arena_reset(sz_memory_arena_t *arena);
+
+/**
+ *  @brief  Returns all of the chunks to the upstream allocator. The arena remains usable after that.
+ */
+SZ_PUBLIC void sz_memory_arena_free(sz_memory_arena_t *arena);
+
+/**
+ *  @brief  Initializes a memory allocator to serve the requests from a growable @p arena.
+ *          The arena must outlive the allocator and every allocation made through it.
+ *
+ *  @param alloc    Memory allocator to initialize.
+ *  @param arena    Initialized arena, that will own the allocated memory.
+ */
+SZ_PUBLIC void sz_memory_allocator_init_arena(sz_memory_allocator_t *alloc, sz_memory_arena_t *arena);
+
+/**
+ *  @brief  A single unit of work of a parallel algorithm, that may run concurrently with other tasks.
+ *  @param  task_state  Shared state of the algorithm, passed to every task.
+ *  @param  task_index  Index of the task, less than the number of submitted tasks.
+ */
+typedef void (*sz_task_t)(void *task_state, sz_size_t task_index);
+
+/**
+ *  @brief  User-supplied thread-pool interface, that must run @p task for every index in `[0, tasks_count)`,
+ *          and only return once all of them are finished. Tasks are independent and can be executed in any order.
+ */
+typedef void (*sz_parallel_for_t)(sz_task_t task, void *task_state, sz_size_t tasks_count, void *executor_handle);
+
+typedef struct sz_executor_t {
+    sz_parallel_for_t parallel_for;
+    sz_size_t threads_count; /// Number of threads available to the executor, used to balance the work.
+    void *handle;
+} sz_executor_t;
+
 /**
  *  @brief  The number of bytes a stack-allocated string can hold, including the SZ_NULL termination character.
  *          ! This can't be changed from outside. Don't use the `#error` as it may already be included and set.
@@ -382,6 +571,8 @@ typedef sz_u64_t (*sz_hash_t)(sz_cptr_t, sz_size_t);
 typedef sz_bool_t (*sz_equal_t)(sz_cptr_t, sz_cptr_t, sz_size_t);
 typedef sz_ordering_t (*sz_order_t)(sz_cptr_t, sz_size_t, sz_cptr_t, sz_size_t);
 typedef void (*sz_to_converter_t)(sz_cptr_t, sz_size_t, sz_ptr_t);
+typedef sz_bool_t (*sz_isascii_t)(sz_cptr_t, sz_size_t);
+typedef void (*sz_translate_t)(sz_cptr_t, sz_size_t, sz_cptr_t, sz_ptr_t);
 
 /**
  *  @brief  Computes the 64-bit unsigned hash of a string. Fairly fast for short strings,
@@ -394,7 +585,7 @@ typedef void (*sz_to_converter_t)(sz_cptr_t, sz_size_t, sz_ptr_t);
  *
  *  @see    sz_hashes, sz_hashes_fingerprint, sz_hashes_intersection
  */
-SZ_PUBLIC sz_u64_t sz_hash(sz_cptr_t text, sz_size_t length);
+SZ_DYNAMIC sz_u64_t sz_hash(sz_cptr_t text, sz_size_t length);
 
 /** @copydoc sz_hash */
 SZ_PUBLIC sz_u64_t sz_hash_serial(sz_cptr_t text, sz_size_t length);
@@ -445,7 +636,10 @@ SZ_PUBLIC sz_ordering_t sz_order_serial(sz_cptr_t a, sz_size_t a_length, sz_cptr
  *  @param length   Number of bytes in the string.
  *  @param result   Output string, can point to the same address as ::text.
  */
-SZ_PUBLIC void sz_tolower(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+SZ_DYNAMIC void sz_tolower(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+
+/** @copydoc sz_tolower */
+SZ_PUBLIC void sz_tolower_serial(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
 
 /**
  *  @brief  Equivalent to `for (char & c : text) c = toupper(c)`.
@@ -460,7 +654,10 @@ SZ_PUBLIC void sz_tolower(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
  *  @param length   Number of bytes in the string.
  *  @param result   Output string, can point to the same address as ::text.
  */
-SZ_PUBLIC void sz_toupper(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+SZ_DYNAMIC void sz_toupper(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+
+/** @copydoc sz_toupper */
+SZ_PUBLIC void sz_toupper_serial(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
 
 /**
  *  @brief  Equivalent to `for (char & c : text) c = toascii(c)`.
@@ -469,7 +666,10 @@ SZ_PUBLIC void sz_toupper(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
  *  @param length   Number of bytes in the string.
  *  @param result   Output string, can point to the same address as ::text.
  */
-SZ_PUBLIC void sz_toascii(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+SZ_DYNAMIC void sz_toascii(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+
+/** @copydoc sz_toascii */
+SZ_PUBLIC void sz_toascii_serial(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
 
 /**
  *  @brief  Checks if all characters in the range are valid ASCII characters.
@@ -478,7 +678,99 @@ SZ_PUBLIC void sz_toascii(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
  *  @param length   Number of bytes in the string.
  *  @return         Whether all characters are valid ASCII characters.
  */
-SZ_PUBLIC sz_bool_t sz_isascii(sz_cptr_t text, sz_size_t length);
+SZ_DYNAMIC sz_bool_t sz_isascii(sz_cptr_t text, sz_size_t length);
+
+/** @copydoc sz_isascii */
+SZ_PUBLIC sz_bool_t sz_isascii_serial(sz_cptr_t text, sz_size_t length);
+
+/**
+ *  @brief  Equivalent to `for (char & c : text) c = lut[(unsigned char)c]`, mapping every byte through a table.
+ *          Generalizes ::sz_tolower and ::sz_toupper to escaping, normalizing separators, or complementing DNA.
+ *
+ *  @param text     String to be transformed.
+ *  @param length   Number of bytes in the string.
+ *  @param lut      Lookup table of 256 bytes, with the output byte for every possible input byte.
+ *  @param result   Output string, can point to the same address as ::text.
+ */
+SZ_DYNAMIC void sz_translate(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result);
+
+/** @copydoc sz_translate */
+SZ_PUBLIC void sz_translate_serial(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result);
+
+/**
+ *  @brief  Describes the length of a UTF8 character / codepoint / rune in bytes.
+ */
+typedef enum {
+    sz_utf8_invalid_k = 0,     //!< Invalid UTF8 character.
+    sz_utf8_rune_1byte_k = 1,  //!< 1-byte UTF8 character.
+    sz_utf8_rune_2bytes_k = 2, //!< 2-byte UTF8 character.
+    sz_utf8_rune_3bytes_k = 3, //!< 3-byte UTF8 character.
+    sz_utf8_rune_4bytes_k = 4, //!< 4-byte UTF8 character.
+} sz_rune_length_t;
+
+typedef sz_u32_t sz_rune_t;
+
+typedef sz_size_t (*sz_utf8_count_t)(sz_cptr_t, sz_size_t);
+typedef sz_cptr_t (*sz_utf8_find_nth_t)(sz_cptr_t, sz_size_t, sz_size_t);
+typedef sz_size_t (*sz_utf8_to_utf32_t)(sz_cptr_t, sz_size_t, sz_rune_t *);
+
+/**
+ *  @brief  Checks if the string is a well-formed UTF8 sequence, as defined in Unicode Table 3-7.
+ *          Rejects overlong encodings, surrogates, codepoints beyond U+10FFFF, and truncated runes.
+ *
+ *  @param text     String to be analyzed.
+ *  @param length   Number of bytes in the string.
+ *  @return         Whether the string is valid UTF8.
+ *  @see            https://arxiv.org/abs/2010.03090
+ */
+SZ_DYNAMIC sz_bool_t sz_utf8_valid(sz_cptr_t text, sz_size_t length);
+
+/** @copydoc sz_utf8_valid */
+SZ_PUBLIC sz_bool_t sz_utf8_valid_serial(sz_cptr_t text, sz_size_t length);
+
+/**
+ *  @brief  Counts the number of UTF8 codepoints / runes in a string, which is the number of bytes,
+ *          that are not continuation bytes `10xxxxxx`. Doesn't validate the input.
+ *
+ *  @param text     String to be analyzed.
+ *  @param length   Number of bytes in the string.
+ *  @return         Number of runes.
+ */
+SZ_DYNAMIC sz_size_t sz_utf8_count(sz_cptr_t text, sz_size_t length);
+
+/** @copydoc sz_utf8_count */
+SZ_PUBLIC sz_size_t sz_utf8_count_serial(sz_cptr_t text, sz_size_t length);
+
+/**
+ *  @brief  Locates the rune with the given index, translating an offset in runes into an offset in bytes.
+ *          Uses the same definition of a rune as ::sz_utf8_count and doesn't validate the input.
+ *
+ *  @param text     String to be analyzed.
+ *  @param length   Number of bytes in the string.
+ *  @param n        Zero-based index of the rune to find.
+ *  @return         Address of the first byte of the rune, or SZ_NULL if the string has `n` runes or less.
+ */
+SZ_DYNAMIC sz_cptr_t sz_utf8_find_nth(sz_cptr_t text, sz_size_t length, sz_size_t n);
+
+/** @copydoc sz_utf8_find_nth */
+SZ_PUBLIC sz_cptr_t sz_utf8_find_nth_serial(sz_cptr_t text, sz_size_t length, sz_size_t n);
+
+/**
+ *  @brief  Decodes a UTF8 string into UTF32 codepoints.
+ *          Writes exactly ::sz_utf8_count runes, so the output never needs more than ::length slots.
+ *          The input is expected to be valid. Corrupted input produces unspecified codepoints, but is never
+ *          read out of bounds.
+ *
+ *  @param text     String to be decoded.
+ *  @param length   Number of bytes in the string.
+ *  @param runes    Output buffer for the decoded codepoints.
+ *  @return         Number of exported runes.
+ *  @see            sz_utf8_valid
+ */
+SZ_DYNAMIC sz_size_t sz_utf8_to_utf32(sz_cptr_t text, sz_size_t length, sz_rune_t *runes);
+
+/** @copydoc sz_utf8_to_utf32 */
+SZ_PUBLIC sz_size_t sz_utf8_to_utf32_serial(sz_cptr_t text, sz_size_t length, sz_rune_t *runes);
 
 /**
  *  @brief  Generates a random string for a given alphabet, avoiding integer division and modulo operations.
@@ -710,6 +1002,66 @@ SZ_DYNAMIC sz_cptr_t sz_rfind(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t
 /** @copydoc sz_rfind */
 SZ_PUBLIC sz_cptr_t sz_rfind_serial(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length);
 
+/**
+ *  @brief  Needle with precomputed search metadata, reusable across many haystacks with ::sz_find_prepared.
+ *          Doesn't own the needle, so the original buffer must outlive the prepared state.
+ *
+ *  Contains the offsets of the three most distinctive bytes of the needle, located once with the same
+ *  heuristic the SIMD kernels of ::sz_find use, and the Boyer-Moore-Horspool bad-character shift table
+ *  for the first 256 bytes of the needle, that the serial backend would otherwise rebuild on every call.
+ */
+typedef struct sz_needle_t {
+    sz_cptr_t start;
+    sz_size_t length;
+    sz_size_t offset_first;
+    sz_size_t offset_mid;
+    sz_size_t offset_last;
+    sz_u8_t bad_shifts[256];
+} sz_needle_t;
+
+typedef sz_cptr_t (*sz_find_prepared_t)(sz_needle_t const *, sz_cptr_t, sz_size_t);
+
+/**
+ *  @brief  Prepares the needle for repeated searches with ::sz_find_prepared.
+ *
+ *  @param needle   Needle - substring to find. Must outlive the @p prepared state.
+ *  @param n_length Number of bytes in the needle.
+ *  @param prepared Output state to initialize.
+ */
+SZ_PUBLIC void sz_needle_prepare(sz_cptr_t needle, sz_size_t n_length, sz_needle_t *prepared);
+
+/**
+ *  @brief  Locates first matching substring, like ::sz_find, reusing the precomputed needle state.
+ *          Preferred, when the same needle is searched in many short haystacks, where setup cost dominates.
+ *
+ *  @param needle   Needle, prepared with ::sz_needle_prepare.
+ *  @param haystack Haystack - the string to search in.
+ *  @param h_length Number of bytes in the haystack.
+ *  @return         Address of the first match, or `SZ_NULL` if missing or the needle is empty.
+ */
+SZ_DYNAMIC sz_cptr_t sz_find_prepared(sz_needle_t const *needle, sz_cptr_t haystack, sz_size_t h_length);
+
+/** @copydoc sz_find_prepared */
+SZ_PUBLIC sz_cptr_t sz_find_prepared_serial(sz_needle_t const *needle, sz_cptr_t haystack, sz_size_t h_length);
+
+/**
+ *  @brief  Locates first matching substring, ignoring the case, equivalent to `sz_find` over the
+ *          strings normalized with ::sz_tolower, but folding the bytes on the fly, without copies.
+ *          Like ::sz_tolower, maps both ASCII and single-byte Latin-1 letters.
+ *
+ *  @param haystack Haystack - the string to search in.
+ *  @param h_length Number of bytes in the haystack.
+ *  @param needle   Needle - substring to find.
+ *  @param n_length Number of bytes in the needle.
+ *  @return         Address of the first match.
+ */
+SZ_DYNAMIC sz_cptr_t sz_find_case_insensitive(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                              sz_size_t n_length);
+
+/** @copydoc sz_find_case_insensitive */
+SZ_PUBLIC sz_cptr_t sz_find_case_insensitive_serial(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                                    sz_size_t n_length);
+
 /**
  *  @brief  Finds the first character present from the ::set, present in ::text.
  *          Equivalent to `strspn(text, accepted)` and `strcspn(text, rejected)` in LibC.
@@ -744,6 +1096,200 @@ SZ_DYNAMIC sz_cptr_t sz_rfind_charset(sz_cptr_t text, sz_size_t length, sz_chars
 /** @copydoc sz_rfind_charset */
 SZ_PUBLIC sz_cptr_t sz_rfind_charset_serial(sz_cptr_t text, sz_size_t length, sz_charset_t const *set);
 
+typedef sz_size_t (*sz_split_offsets_t)(sz_cptr_t, sz_size_t, sz_charset_t const *, sz_size_t, void *, sz_size_t,
+                                        sz_size_t, sz_size_t *);
+
+/**
+ *  @brief  Locates all the delimiters from the ::delimiters set in the ::text, exporting their offsets into
+ *          a tape of 32-bit or 64-bit unsigned integers, similar to the offsets of Apache Arrow string arrays.
+ *          Unlike repeated ::sz_find_charset calls, the SIMD backends convert the whole comparison masks into
+ *          offsets at once, using compress-stores, like `VPCOMPRESSD` and `VPCOMPRESSQ` in AVX-512.
+ *
+ *  Every delimiter at `text + i` is exported as `base + i`. Passing `base = 1` produces the exclusive ends of
+ *  the delimited slices with the delimiters included, matching the layout of the `Strs` tapes in Python.
+ *  If the ::capacity is exhausted, the scan stops after the last exported delimiter, but before the next one.
+ *  The function can then be called again with `text + *consumed`, `length - *consumed` and `base + *consumed`.
+ *
+ *  @param text         String to be split.
+ *  @param length       Number of bytes in the string.
+ *  @param delimiters   Set of delimiter characters.
+ *  @param base         Value added to every exported offset, like the position of ::text in a larger file.
+ *  @param offsets      Output tape of offsets, with at least ::capacity entries.
+ *  @param offset_bytes Size of every offset, either 4 or 8 bytes. Wider values are truncated to 32 bits.
+ *  @param capacity     Maximum number of offsets to export.
+ *  @param consumed     Optional output for the number of scanned bytes, equal to ::length unless out of capacity.
+ *  @return             Number of exported offsets.
+ */
+SZ_DYNAMIC sz_size_t sz_split_offsets(sz_cptr_t text, sz_size_t length, sz_charset_t const *delimiters,
+                                      sz_size_t base, void *offsets, sz_size_t offset_bytes, sz_size_t capacity,
+                                      sz_size_t *consumed);
+
+/** @copydoc sz_split_offsets */
+SZ_PUBLIC sz_size_t sz_split_offsets_serial(sz_cptr_t text, sz_size_t length, sz_charset_t const *delimiters,
+                                            sz_size_t base, void *offsets, sz_size_t offset_bytes,
+                                            sz_size_t capacity, sz_size_t *consumed);
+
+/**
+ *  @brief  Compiled set of needles for single-pass multi-pattern search, similar to the "Teddy" algorithm
+ *          from Hyperscan. Needles are sorted by their first (up to 3) bytes and split into 8 buckets.
+ *          For every one of those probed byte positions, we keep a bitmask of buckets every byte value
+ *          (and every nibble, for SIMD shuffles) can be found in. Candidate positions are then verified
+ *          only against the few needles in the matching buckets, that share the probed prefix.
+ *
+ *  The needle views are copied into the structure, but the underlying bytes are not.
+ *  So the needle strings must outlive the matcher. Empty needles are ignored.
+ *
+ *  @see    sz_multi_pattern_init, sz_multi_pattern_free, sz_find_any
+ *  @see    https://github.com/intel/hyperscan/blob/master/src/fdr/teddy.c
+ */
+typedef struct sz_multi_pattern_t {
+    sz_string_view_t *needles;   /// Copy of the needle views, indexed by the needle ID.
+    sz_size_t count;             /// Number of needles, including the empty ones.
+    sz_size_t ids_count;         /// Number of non-empty needles, covered by `ids` and `prefixes`.
+    sz_size_t probe_length;      /// Number of leading bytes used by the prefilter, from 1 to 3, or 0 if empty.
+    sz_u32_t *ids;               /// IDs of non-empty needles, sorted by their probed prefix, and then by ID.
+    sz_u32_t *prefixes;          /// Big-endian probed prefixes of the needles in `ids` order.
+    sz_size_t bucket_starts[9];  /// Offsets of the 8 buckets in `ids`, with a closing sentinel.
+    sz_u8_t bytes[3][256];       /// Bitmasks of buckets, where a byte can appear at every probed position.
+    sz_u8_t low_nibbles[3][16];  /// Bitmasks of buckets, where a low nibble can appear at every probed position.
+    sz_u8_t high_nibbles[3][16]; /// Bitmasks of buckets, where a high nibble can appear at every probed position.
+} sz_multi_pattern_t;
+
+/**
+ *  @brief  Compiles a set of needles for ::sz_find_any. Runs in linear time in the number of needles.
+ *
+ *  @param pattern  Uninitialized structure to populate.
+ *  @param needles  Array of needles to search for. Only the views are copied, not the strings.
+ *  @param count    Number of needles. Must be under 2^32.
+ *  @param alloc    Memory allocator for the internal tables. If SZ_NULL is passed, uses the system `malloc`.
+ *  @return         `sz_true_k` on success, `sz_false_k` if the memory allocation failed.
+ */
+SZ_PUBLIC sz_bool_t sz_multi_pattern_init(sz_multi_pattern_t *pattern, sz_string_view_t const *needles,
+                                          sz_size_t count, sz_memory_allocator_t *alloc);
+
+/**
+ *  @brief  Releases the memory of a compiled multi-pattern matcher.
+ *  @param alloc    Same allocator that was passed to ::sz_multi_pattern_init.
+ */
+SZ_PUBLIC void sz_multi_pattern_free(sz_multi_pattern_t *pattern, sz_memory_allocator_t *alloc);
+
+/**
+ *  @brief  Locates the first occurrence of any of the compiled needles in a single pass over the ::haystack.
+ *          If several needles match at the same offset, the smallest needle ID is reported.
+ *
+ *  @param pattern      Compiled set of needles.
+ *  @param haystack     Haystack - the string to search in.
+ *  @param h_length     Number of bytes in the haystack.
+ *  @param needle_id    Output index of the matched needle, or untouched if nothing was found.
+ *  @return             Address of the first match, or SZ_NULL if no needle was found.
+ *  @see                sz_multi_pattern_init
+ */
+SZ_DYNAMIC sz_cptr_t sz_find_any(sz_multi_pattern_t const *pattern, sz_cptr_t haystack, sz_size_t h_length,
+                                 sz_size_t *needle_id);
+
+/** @copydoc sz_find_any */
+SZ_PUBLIC sz_cptr_t sz_find_any_serial(sz_multi_pattern_t const *pattern, sz_cptr_t haystack, sz_size_t h_length,
+                                       sz_size_t *needle_id);
+
+typedef sz_cptr_t (*sz_find_any_t)(sz_multi_pattern_t const *, sz_cptr_t, sz_size_t, sz_size_t *);
+
+/**
+ *  @brief  State of an incremental substring search over a stream of chunks, like the blocks of a file read
+ *          from the network, reporting the absolute offsets of the matches, including those straddling the
+ *          boundaries between the chunks. The chunks themselves are never copied.
+ *
+ *  Only one number has to be carried between the chunks - the length of the longest prefix of the needle, that is
+ *  a suffix of all the data fed so far. Every other partial match is exactly a border of that prefix, so it can be
+ *  recovered from the needle itself. So the needle must outlive the stream.
+ *
+ *  @see    sz_find_stream_init, sz_find_stream_feed
+ */
+typedef struct sz_find_stream_t {
+    sz_cptr_t needle;           /// Needle - substring to find. Not copied.
+    sz_size_t needle_length;    /// Number of bytes in the needle.
+    sz_size_t offset;           /// Number of bytes fed so far or the absolute offset of the next chunk.
+    sz_size_t matched_prefix;   /// Length of the longest needle prefix, that is a suffix of the fed data.
+    sz_size_t next_allowed;     /// Smallest absolute offset of the next reportable match.
+    sz_bool_t skip_overlapping; /// Whether the next match can't start before the end of the previous one.
+} sz_find_stream_t;
+
+/**
+ *  @brief  Callback for the matches of a streaming search.
+ *  @param  offset  Absolute offset of the match from the start of the stream.
+ *  @param  user    Handle passed to ::sz_find_stream_feed.
+ */
+typedef void (*sz_find_callback_t)(sz_size_t offset, void *user);
+
+/**
+ *  @brief  Initializes the state of an incremental substring search.
+ *
+ *  @param stream           Uninitialized structure to populate.
+ *  @param needle           Needle - substring to find. Must outlive the stream.
+ *  @param n_length         Number of bytes in the needle. Empty needles never match.
+ *  @param skip_overlapping If `sz_true_k`, matches can't overlap, like in splitting, otherwise all are reported.
+ */
+SZ_PUBLIC void sz_find_stream_init(sz_find_stream_t *stream, sz_cptr_t needle, sz_size_t n_length,
+                                   sz_bool_t skip_overlapping);
+
+/**
+ *  @brief  Searches the next chunk of the stream, reporting the matches in the increasing order of their offsets.
+ *          Matches starting in the previous chunks and ending in this one are reported before the others.
+ *
+ *  @param stream           Initialized state of the search.
+ *  @param chunk            Next chunk of the stream, that doesn't have to outlive the call.
+ *  @param length           Number of bytes in the chunk.
+ *  @param callback         Function called for every match.
+ *  @param callback_handle  Optional user-provided pointer to be passed to the ::callback.
+ *  @return                 Number of reported matches.
+ *  @see                    sz_find_stream_init
+ */
+SZ_PUBLIC sz_size_t sz_find_stream_feed(sz_find_stream_t *stream, sz_cptr_t chunk, sz_size_t length,
+                                        sz_find_callback_t callback, void *callback_handle);
+
+/**
+ *  @brief  Counts the occurrences of a needle in a haystack, searching different shards of the haystack on
+ *          different threads. Neighboring shards overlap by `n_length - 1` bytes, and every match is attributed
+ *          to the shard it starts in, so the matches straddling the boundaries are neither lost nor double-counted.
+ *
+ *  Disjoint matches depend on where the previous one ended, so with @p skip_overlapping the first match of every
+ *  shard is checked against the end of the last match of the previous one. In the rare case they overlap, like
+ *  with periodic needles, the shard is searched again from the right position.
+ *
+ *  @param haystack         Haystack - the string to search in.
+ *  @param h_length         Number of bytes in the haystack.
+ *  @param needle           Needle - substring to find. Empty needles never match.
+ *  @param n_length         Number of bytes in the needle.
+ *  @param skip_overlapping If `sz_true_k`, matches can't overlap, like in splitting, otherwise all are counted.
+ *  @param executor         Thread-pool interface to run the tasks. If NULL, or for small inputs, searches serially.
+ *  @return                 Number of matches.
+ */
+SZ_PUBLIC sz_size_t sz_find_count_parallel(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                           sz_size_t n_length, sz_bool_t skip_overlapping,
+                                           sz_executor_t const *executor);
+
+/**
+ *  @brief  Locates all occurrences of a needle in a haystack, searching different shards of the haystack on
+ *          different threads, and merging their offsets in the increasing order.
+ *
+ *  @param haystack         Haystack - the string to search in.
+ *  @param h_length         Number of bytes in the haystack.
+ *  @param needle           Needle - substring to find. Empty needles never match.
+ *  @param n_length         Number of bytes in the needle.
+ *  @param skip_overlapping If `sz_true_k`, matches can't overlap, like in splitting, otherwise all are reported.
+ *  @param offsets          Output pointer to the `*count` offsets of matches, allocated with the @p alloc.
+ *                          It's SZ_NULL if nothing was found, otherwise must be freed by the caller, passing
+ *                          `*count * sizeof(sz_size_t)` as the length.
+ *  @param count            Output number of matches.
+ *  @param alloc            Memory allocator for the offsets. If SZ_NULL is passed, will use the default `malloc`.
+ *  @param executor         Thread-pool interface to run the tasks. If NULL, or for small inputs, searches serially.
+ *  @return                 1 on success, 0 if the offsets couldn't be allocated, leaving the outputs untouched.
+ *  @see                    sz_find_count_parallel
+ */
+SZ_PUBLIC sz_bool_t sz_find_all_parallel(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                         sz_size_t n_length, sz_bool_t skip_overlapping, sz_size_t **offsets,
+                                         sz_size_t *count, sz_memory_allocator_t *alloc,
+                                         sz_executor_t const *executor);
+
 #pragma endregion
 
 #pragma region String Similarity Measures API
@@ -840,6 +1386,40 @@ SZ_PUBLIC sz_size_t sz_edit_distance_utf8(sz_cptr_t a, sz_size_t a_length, sz_cp
 
 typedef sz_size_t (*sz_edit_distance_t)(sz_cptr_t, sz_size_t, sz_cptr_t, sz_size_t, sz_size_t, sz_memory_allocator_t *);
 
+/**
+ *  @brief  Locates the first approximate occurrence of the needle in the haystack - a substring within the given
+ *          number of Levenshtein edits from the needle. Uses the Wu-Manber extension of the Bitap algorithm,
+ *          performing O(h_length * ⌈n_length / 64⌉ * max_edits) word operations, unlike the sliding
+ *          `sz_edit_distance`, which would be quadratic in the needle length for every haystack offset.
+ *
+ *  The match ending earliest in the haystack is reported. If the next characters reduce the number of edits,
+ *  the match is extended over them, so that "abcd" in "xabcdx" with 1 edit is "abcd" rather than "abc".
+ *  Of all the matches ending at the same position, the one with the fewest edits and then the shortest wins.
+ *
+ *  @param haystack     Haystack - the string to search in.
+ *  @param h_length     Number of bytes in the haystack.
+ *  @param needle       Needle - substring to find approximately.
+ *  @param n_length     Number of bytes in the needle.
+ *  @param max_edits    Maximum number of insertions, deletions and substitutions in the match.
+ *                      If it's not smaller than ::n_length, the empty prefix of the haystack matches trivially.
+ *  @param alloc        Temporary memory allocator for `(256 + max_edits + 2) * ⌈n_length / 64⌉` words.
+ *                      If SZ_NULL is passed, will initialize to the systems default `malloc`.
+ *  @param match_length Output: number of bytes in the matched substring, or `SZ_SIZE_MAX` on allocation failure.
+ *  @return             Address of the first byte of the match, or SZ_NULL if not found or the allocation failed.
+ *
+ *  @see    sz_edit_distance
+ *  @see    "Fast Text Searching With Errors" by S. Wu and U. Manber.
+ */
+SZ_DYNAMIC sz_cptr_t sz_find_fuzzy(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length, //
+                                   sz_size_t max_edits, sz_memory_allocator_t *alloc, sz_size_t *match_length);
+
+/** @copydoc sz_find_fuzzy */
+SZ_PUBLIC sz_cptr_t sz_find_fuzzy_serial(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length,
+                                         sz_size_t max_edits, sz_memory_allocator_t *alloc, sz_size_t *match_length);
+
+typedef sz_cptr_t (*sz_find_fuzzy_t)(sz_cptr_t, sz_size_t, sz_cptr_t, sz_size_t, sz_size_t, sz_memory_allocator_t *,
+                                     sz_size_t *);
+
 /**
  *  @brief  Computes Needleman–Wunsch alignment score for two string. Often used in bioinformatics and cheminformatics.
  *          Similar to the Levenshtein edit-distance, parameterized for gap and substitution penalties.
@@ -955,6 +1535,90 @@ SZ_PUBLIC sz_size_t sz_hashes_intersection(sz_cptr_t text, sz_size_t length, sz_
 
 typedef sz_size_t (*sz_hashes_intersection_t)(sz_cptr_t, sz_size_t, sz_size_t, sz_cptr_t, sz_size_t);
 
+/**
+ *  @brief  Computes the MinHash and SimHash sketches of a string for several window lengths in one sweep,
+ *          writing the signatures directly, without invoking a callback for every window, like `sz_hashes`.
+ *          Can be used for near-duplicate detection and clustering of documents.
+ *
+ *  The window hashes are identical to the ones `sz_hashes_serial` reports. Each window length gets its own
+ *  MinHash signature of ::permutations_count values, where the `i`-th value is the smallest of the permuted
+ *  window hashes. The `i`-th permutation maps a hash `h` to `p ^ (p >> 32)`, where `p = (h ^ mask) * multiplier`,
+ *  and the odd multiplier and the mask are derived from `i` with SplitMix64, making signatures reproducible
+ *  across platforms. The share of equal values in two signatures estimates the Jaccard similarity of documents.
+ *
+ *  Each bit of the SimHash signature is set, if it's set in more than half of the window hashes.
+ *  The Hamming distance between two signatures estimates the dissimilarity of documents.
+ *
+ *  @param text                 String to hash.
+ *  @param length               Number of bytes in the string.
+ *  @param window_lengths       Lengths of the rolling windows in bytes.
+ *  @param windows_count        Number of different window lengths.
+ *  @param permutations_count   Number of MinHash permutations for each window length.
+ *  @param min_hashes           Optional output buffer for `windows_count * permutations_count` MinHash values,
+ *                              grouped by window length. Remain `SZ_U64_MAX` if the text is shorter than the window.
+ *  @param sim_hashes           Optional output buffer for `windows_count` SimHash signatures.
+ *  @see                        sz_hashes, sz_hashes_fingerprint
+ */
+SZ_DYNAMIC void sz_hashes_sketch(sz_cptr_t text, sz_size_t length, sz_size_t const *window_lengths,
+                                 sz_size_t windows_count, sz_size_t permutations_count, sz_u64_t *min_hashes,
+                                 sz_u64_t *sim_hashes);
+
+/** @copydoc sz_hashes_sketch */
+SZ_PUBLIC void sz_hashes_sketch_serial(sz_cptr_t text, sz_size_t length, sz_size_t const *window_lengths,
+                                       sz_size_t windows_count, sz_size_t permutations_count, sz_u64_t *min_hashes,
+                                       sz_u64_t *sim_hashes);
+
+typedef void (*sz_hashes_sketch_t)(sz_cptr_t, sz_size_t, sz_size_t const *, sz_size_t, sz_size_t, sz_u64_t *,
+                                   sz_u64_t *);
+
+/**
+ *  @brief  Similarity measures between two binary fingerprints, like the ones `sz_hashes_fingerprint` produces.
+ */
+typedef enum sz_fingerprint_metric_t {
+    sz_fingerprint_jaccard_k = 0, ///< Share of the bits set in both, among the bits set in either, higher is better.
+    sz_fingerprint_hamming_k = 1, ///< Number of differing bits, lower is better.
+} sz_fingerprint_metric_t;
+
+/**
+ *  @brief  One of the most similar fingerprints, reported by `sz_fingerprints_top_k`.
+ *          Both metrics derive from the two counters: the Jaccard similarity is `intersection / union_size`,
+ *          and the Hamming distance is `union_size - intersection`.
+ */
+typedef struct sz_fingerprint_match_t {
+    sz_size_t id;          ///< Index of the fingerprint in the column.
+    sz_u32_t intersection; ///< Number of bits set in both the query and the fingerprint.
+    sz_u32_t union_size;   ///< Number of bits set in either the query or the fingerprint.
+} sz_fingerprint_match_t;
+
+/**
+ *  @brief  Scores a query fingerprint against many fingerprints in a contiguous column, keeping the @p k most
+ *          similar ones in a bounded heap, fused with the population counts, so no scores are materialized.
+ *          Two empty fingerprints are identical under Jaccard. Ties are broken in favor of the smaller ::id.
+ *
+ *  @param query                Query fingerprint of ::fingerprint_bytes bytes.
+ *  @param fingerprints         Column of fingerprints, each ::fingerprint_bytes long, with no gaps between them.
+ *                              Aligning them to cache lines with zeroed padding bytes is recommended.
+ *  @param fingerprint_bytes    Number of bytes in every fingerprint.
+ *  @param ids                  Optional indices of the fingerprints to score, like the contents of the LSH buckets.
+ *                              If NULL, the first ::count fingerprints of the column are scored.
+ *  @param count                Number of fingerprints to score.
+ *  @param k                    Maximum number of matches to report.
+ *  @param metric               Similarity measure used to rank the fingerprints.
+ *  @param matches              Output buffer for @p k matches, that will be sorted from the most similar.
+ *  @return                     Number of reported matches, the smaller of ::k and ::count.
+ */
+SZ_DYNAMIC sz_size_t sz_fingerprints_top_k(sz_cptr_t query, sz_cptr_t fingerprints, sz_size_t fingerprint_bytes,
+                                           sz_sorted_idx_t const *ids, sz_size_t count, sz_size_t k,
+                                           sz_fingerprint_metric_t metric, sz_fingerprint_match_t *matches);
+
+/** @copydoc sz_fingerprints_top_k */
+SZ_PUBLIC sz_size_t sz_fingerprints_top_k_serial(sz_cptr_t query, sz_cptr_t fingerprints, sz_size_t fingerprint_bytes,
+                                                 sz_sorted_idx_t const *ids, sz_size_t count, sz_size_t k,
+                                                 sz_fingerprint_metric_t metric, sz_fingerprint_match_t *matches);
+
+typedef sz_size_t (*sz_fingerprints_top_k_t)(sz_cptr_t, sz_cptr_t, sz_size_t, sz_sorted_idx_t const *, sz_size_t,
+                                             sz_size_t, sz_fingerprint_metric_t, sz_fingerprint_match_t *);
+
 #pragma endregion
 
 #pragma region Convenience API
@@ -1008,20 +1672,54 @@ typedef struct sz_sequence_t {
 } sz_sequence_t;
 
 /**
- *  @brief  Initiates the sequence structure from a tape layout, used by Apache Arrow.
- *          Expects ::offsets to contains `count + 1` entries, the last pointing at the end
- *          of the last string, indicating the total length of the ::tape.
+ *  @brief  Strings concatenated on a tape, the layout used by Apache Arrow for variable-length binary arrays.
+ *          The ::offsets contain `count + 1` entries of 32 or 64 bits, relative to the ::data, the last pointing
+ *          at the end of the last string, indicating the total length of the tape.
+ */
+typedef struct sz_tape_t {
+    sz_cptr_t data;
+    void const *offsets;
+    sz_size_t count;
+} sz_tape_t;
+
+/**
+ *  @brief  Initiates the sequence structure from a tape with 32-bit ::offsets.
+ *          The @p tape is referenced by the sequence, and must outlive it.
+ *
+ *  @param  order   Optional buffer for `tape->count` indices, initialized with the identity permutation.
+ */
+SZ_PUBLIC void sz_sequence_from_u32tape(sz_tape_t const *tape, sz_sorted_idx_t *order, sz_sequence_t *sequence);
+
+/**
+ *  @brief  Initiates the sequence structure from a tape with 64-bit ::offsets.
+ *          The @p tape is referenced by the sequence, and must outlive it.
+ *
+ *  @param  order   Optional buffer for `tape->count` indices, initialized with the identity permutation.
+ */
+SZ_PUBLIC void sz_sequence_from_u64tape(sz_tape_t const *tape, sz_sorted_idx_t *order, sz_sequence_t *sequence);
+
+/**
+ *  @brief  Number of bytes in the header of a serialized tape, followed by the `count + 1` offsets and the strings.
+ */
+#define SZ_TAPE_HEADER_SIZE (32)
+
+/**
+ *  @brief  Fills the ::SZ_TAPE_HEADER_SIZE bytes of a serialized tape header, like the runs of an external sort.
+ *          The serialized tape can be memory-mapped and opened with `sz_tape_parse` without copies.
+ *
+ *  @param  offset_bytes    Width of the offsets, either 4 or 8.
  */
-SZ_PUBLIC void sz_sequence_from_u32tape(sz_cptr_t *start, sz_u32_t const *offsets, sz_size_t count,
-                                        sz_sequence_t *sequence);
+SZ_PUBLIC void sz_tape_header(sz_size_t count, sz_size_t offset_bytes, sz_ptr_t header);
 
 /**
- *  @brief  Initiates the sequence structure from a tape layout, used by Apache Arrow.
- *          Expects ::offsets to contains `count + 1` entries, the last pointing at the end
- *          of the last string, indicating the total length of the ::tape.
+ *  @brief  Validates a serialized tape and locates the offsets and the strings in it.
+ *          Only the first and the last offsets are checked, to keep the parsing `O(1)`.
+ *
+ *  @param  data            Start of the serialized tape, aligned to at least 8 bytes, like any memory-mapped file.
+ *  @param  offset_bytes    Output for the width of the offsets, either 4 or 8.
+ *  @return 1 if the header is valid and matches the ::size, 0 otherwise, including the byte-order mismatches.
  */
-SZ_PUBLIC void sz_sequence_from_u64tape(sz_cptr_t *start, sz_u64_t const *offsets, sz_size_t count,
-                                        sz_sequence_t *sequence);
+SZ_PUBLIC sz_bool_t sz_tape_parse(sz_cptr_t data, sz_size_t size, sz_tape_t *tape, sz_size_t *offset_bytes);
 
 /**
  *  @brief  Similar to `std::partition`, given a predicate splits the sequence into two parts.
@@ -1038,6 +1736,29 @@ SZ_PUBLIC sz_size_t sz_partition(sz_sequence_t *sequence, sz_sequence_predicate_
  */
 SZ_PUBLIC void sz_merge(sz_sequence_t *sequence, sz_size_t partition, sz_sequence_comparator_t less);
 
+/**
+ *  @brief  Callback, receiving the strings in the merged order from `sz_merge_runs`, with the index of their run.
+ */
+typedef void (*sz_merge_callback_t)(sz_cptr_t start, sz_size_t length, sz_size_t run, void *handle);
+
+/**
+ *  @brief  K-way merge of several sorted sequences, or "runs", with a loser tree, taking `O(log k)` comparisons
+ *          per string. Caches the first 8 bytes of the leading string of every run, so most comparisons don't
+ *          touch the strings, and prefetches the next string of the run, that was just advanced.
+ *          Equal strings are reported in the order of their runs, so merging the runs of a stable sort is stable.
+ *          Used for the external sorting of datasets larger than RAM, with memory-mapped runs.
+ *
+ *  @param  runs        Sorted sequences. If the ::order of a run is NULL, its strings are sorted in natural order,
+ *                      otherwise, the `i`-th string of the run is `get_start(run, run->order[i])`.
+ *  @param  runs_count  Number of runs.
+ *  @param  callback    Function to call for every string.
+ *  @param  handle      Optional argument for the callback.
+ *  @param  alloc       Memory allocator for ~64 bytes of scratch space per run. If NULL, uses `malloc`.
+ *  @return 1 on success, 0 if the scratch space couldn't be allocated.
+ */
+SZ_PUBLIC sz_bool_t sz_merge_runs(sz_sequence_t const *runs, sz_size_t runs_count, sz_merge_callback_t callback,
+                                  void *handle, sz_memory_allocator_t *alloc);
+
 /**
  *  @brief  Sorting algorithm, combining Radix Sort for the first 32 bits of every word
  *          and a follow-up by a more conventional sorting procedure on equally prefixed parts.
@@ -1055,22 +1776,148 @@ SZ_PUBLIC void sz_sort_partial(sz_sequence_t *sequence, sz_size_t n);
  */
 SZ_PUBLIC void sz_sort_intro(sz_sequence_t *sequence, sz_sequence_comparator_t less);
 
-#pragma endregion
-
-/*
- *  Hardware feature detection.
- *  All of those can be controlled by the user.
+/**
+ *  @brief  Parallel version of `sz_sort`. Exports the prefixes in parallel, splits the sequence into
+ *          independent buckets with a Radix Sort over the leading bits, and sorts different buckets
+ *          on different threads. The callbacks of the @p sequence must be thread-safe.
+ *
+ *  Buckets are formed only from the first 32 bits of every word, so if most strings share a 4-byte prefix,
+ *  the work will be poorly balanced. Falls back to the serial `sz_sort` for small inputs or a single thread.
+ *
+ *  @param  sequence    The sequence to sort in-place.
+ *  @param  executor    Thread-pool interface to run the tasks. If NULL, the sequence is sorted serially.
  */
-#ifndef SZ_USE_X86_AVX512
-#ifdef __AVX512BW__
-#define SZ_USE_X86_AVX512 1
-#else
-#define SZ_USE_X86_AVX512 0
-#endif
-#endif
+SZ_PUBLIC void sz_sort_parallel(sz_sequence_t *sequence, sz_executor_t const *executor);
+
+/**
+ *  @brief  Stable MSD Radix Sort, that keeps pulling the next 7 bytes of every string into a 64-bit key for
+ *          the buckets that are still unresolved. Unlike `sz_sort`, it isn't limited to the first 4 bytes,
+ *          so it handles long shared prefixes, like URLs and file paths, without falling back to comparisons.
+ *          Doesn't recurse, and takes all of its scratch space of ~40 bytes per entry from the allocator.
+ *
+ *  @param  sequence    The sequence to sort in-place. Entries with equal strings preserve their relative order.
+ *  @param  alloc       Memory allocator for the scratch space. If NULL, the default allocator is used.
+ *  @return 1 on success, 0 if the scratch space couldn't be allocated, leaving the sequence intact.
+ */
+SZ_PUBLIC sz_bool_t sz_sort_stable(sz_sequence_t *sequence, sz_memory_allocator_t *alloc);
+
+/**
+ *  @brief  Builds the suffix array of a text, the offsets of all of its suffixes in lexicographic order,
+ *          with prefix-doubling. The suffixes are first ranked by their leading 7 bytes, and then every round
+ *          doubles the compared prefix length, sorting the pairs of ranks with the `sz_sort_stable` LSD Radix Sort.
+ *          Takes `O(n log n)` time, bounded by the length of the longest repeated substring.
+ *
+ *  @param  text        Text to index. It can contain any bytes, including zeros.
+ *  @param  length      Number of bytes in the text.
+ *  @param  suffixes    Output buffer for ::length offsets.
+ *  @param  alloc       Memory allocator for the scratch space of ~32 bytes per byte of text. If NULL, uses `malloc`.
+ *  @return 1 on success, 0 if the scratch space couldn't be allocated.
+ *  @see    sz_suffix_array_range, sz_suffix_array_longest_prefix
+ */
+SZ_PUBLIC sz_bool_t sz_suffix_array(sz_cptr_t text, sz_size_t length, sz_sorted_idx_t *suffixes,
+                                    sz_memory_allocator_t *alloc);
+
+/**
+ *  @brief  Locates the occurrences of a needle with a binary search over the suffix array in `O(m log n)`.
+ *          The occurrences are the ::suffixes in range `[*first, *first + count)`, ordered lexicographically
+ *          by the following text, rather than by their offsets.
+ *
+ *  @param  suffixes    Suffix array of the text, built with `sz_suffix_array`.
+ *  @param  first       Output position of the first matching entry in the suffix array.
+ *  @return Number of occurrences, the length of the text for an empty needle.
+ */
+SZ_PUBLIC sz_size_t sz_suffix_array_range(sz_cptr_t text, sz_size_t length, sz_sorted_idx_t const *suffixes,
+                                          sz_cptr_t needle, sz_size_t needle_length, sz_size_t *first);
+
+/**
+ *  @brief  Finds the longest prefix of a needle, that occurs in the text, in `O(m log n)`.
+ *          It's the longest common prefix of the needle and the suffixes adjacent to its insertion point.
+ *
+ *  @param  suffixes    Suffix array of the text, built with `sz_suffix_array`.
+ *  @param  offset      Output offset of one occurrence of the prefix in the text, or zero if nothing matches.
+ *  @return Length of the longest matching prefix.
+ */
+SZ_PUBLIC sz_size_t sz_suffix_array_longest_prefix(sz_cptr_t text, sz_size_t length, sz_sorted_idx_t const *suffixes,
+                                                   sz_cptr_t needle, sz_size_t needle_length, sz_size_t *offset);
+
+/**
+ *  @brief  Number of bytes in the header of a serialized suffix index, that is followed by the suffix array
+ *          of 64-bit native-endian offsets, and then by the text itself. Keeps the suffix array 8-byte aligned.
+ */
+#define SZ_SUFFIX_INDEX_HEADER_SIZE (32)
+
+/**
+ *  @brief  Fills the ::SZ_SUFFIX_INDEX_HEADER_SIZE bytes of a serialized suffix index header for a text.
+ *          The serialized index can be memory-mapped and opened with `sz_suffix_index_parse` without copies.
+ */
+SZ_PUBLIC void sz_suffix_index_header(sz_size_t length, sz_ptr_t header);
+
+/**
+ *  @brief  Validates a serialized suffix index and locates the text and the suffix array in it.
+ *  @param  data    Start of the serialized index, aligned to at least 8 bytes, like any memory-mapped file.
+ *  @return 1 if the header is valid and matches the ::size, 0 otherwise, including the byte-order mismatches.
+ */
+SZ_PUBLIC sz_bool_t sz_suffix_index_parse(sz_cptr_t data, sz_size_t size, sz_cptr_t *text, sz_size_t *length,
+                                          sz_sorted_idx_t const **suffixes);
+
+/**
+ *  @brief  Computes the 64-bit unsigned hashes of many strings at once, matching `sz_hash` for each of them.
+ *          On SIMD-capable hardware hashes several strings in different lanes of the same register,
+ *          hiding the latency of the serial dependency chain within each hash, which dominates on short keys.
+ *
+ *  @param  sequence    Strings to hash. The ::order field is ignored, the `i`-th string is `get_start(sequence, i)`.
+ *  @param  hashes      Output buffer for `sequence->count` hashes.
+ *  @see    sz_hash
+ */
+SZ_DYNAMIC void sz_hash_batch(sz_sequence_t const *sequence, sz_u64_t *hashes);
+
+/** @copydoc sz_hash_batch */
+SZ_PUBLIC void sz_hash_batch_serial(sz_sequence_t const *sequence, sz_u64_t *hashes);
+
+typedef void (*sz_hash_batch_t)(sz_sequence_t const *, sz_u64_t *);
+
+/**
+ *  @brief  Computes the Levenshtein edit-distances between one query and many candidate strings,
+ *          matching `sz_edit_distance` for each of them. Allocates the scratch space just once, and
+ *          on SIMD-capable hardware evaluates several short candidates in different lanes of the same register,
+ *          exiting early once every lane has either finished or exceeded the ::bound.
+ *
+ *  @param  query           The string to compare against every candidate.
+ *  @param  query_length    Number of bytes in the query.
+ *  @param  candidates      Strings to compare against. The ::order field is ignored.
+ *  @param  bound           Upper bound on the distance, shared by all candidates. Zero means no bound.
+ *  @param  distances       Output buffer for `candidates->count` distances.
+ *  @param  alloc           Temporary memory allocator. If SZ_NULL is passed, will use the default `malloc`.
+ *  @return 1 on success, 0 if the scratch space couldn't be allocated, leaving ::distances untouched.
+ *  @see    sz_edit_distance
+ */
+SZ_DYNAMIC sz_bool_t sz_edit_distances_batch(sz_cptr_t query, sz_size_t query_length, sz_sequence_t const *candidates,
+                                             sz_size_t bound, sz_size_t *distances, sz_memory_allocator_t *alloc);
+
+/** @copydoc sz_edit_distances_batch */
+SZ_PUBLIC sz_bool_t sz_edit_distances_batch_serial(sz_cptr_t query, sz_size_t query_length,
+                                                   sz_sequence_t const *candidates, sz_size_t bound,
+                                                   sz_size_t *distances, sz_memory_allocator_t *alloc);
+
+typedef sz_bool_t (*sz_edit_distances_batch_t)(sz_cptr_t, sz_size_t, sz_sequence_t const *, sz_size_t, sz_size_t *,
+                                               sz_memory_allocator_t *);
+
+#pragma endregion
+
+/*
+ *  Hardware feature detection.
+ *  All of those can be controlled by the user.
+ */
+#ifndef SZ_USE_X86_AVX512
+#if defined(__AVX512BW__) || (SZ_LAZY_DISPATCH && (defined(__x86_64__) || defined(_M_X64)))
+#define SZ_USE_X86_AVX512 1
+#else
+#define SZ_USE_X86_AVX512 0
+#endif
+#endif
 
 #ifndef SZ_USE_X86_AVX2
-#ifdef __AVX2__
+#if defined(__AVX2__) || (SZ_LAZY_DISPATCH && (defined(__x86_64__) || defined(_M_X64)))
 #define SZ_USE_X86_AVX2 1
 #else
 #define SZ_USE_X86_AVX2 0
@@ -1086,13 +1933,21 @@ SZ_PUBLIC void sz_sort_intro(sz_sequence_t *sequence, sz_sequence_comparator_t l
 #endif
 
 #ifndef SZ_USE_ARM_SVE
-#ifdef __ARM_FEATURE_SVE
+#if defined(__ARM_FEATURE_SVE) || (SZ_LAZY_DISPATCH && defined(__aarch64__) && defined(__linux__))
 #define SZ_USE_ARM_SVE 1
 #else
 #define SZ_USE_ARM_SVE 0
 #endif
 #endif
 
+#ifndef SZ_USE_ARM_SVE2
+#if defined(__ARM_FEATURE_SVE2) || (SZ_LAZY_DISPATCH && defined(__aarch64__) && defined(__linux__))
+#define SZ_USE_ARM_SVE2 1
+#else
+#define SZ_USE_ARM_SVE2 0
+#endif
+#endif
+
 /*
  *  Include hardware-specific headers.
  */
@@ -1103,9 +1958,21 @@ SZ_PUBLIC void sz_sort_intro(sz_sequence_t *sequence, sz_sequence_comparator_t l
 #include <arm_acle.h>
 #include <arm_neon.h>
 #endif // SZ_USE_ARM_NEON
-#if SZ_USE_ARM_SVE
+#if SZ_USE_ARM_SVE || SZ_USE_ARM_SVE2
 #include <arm_sve.h>
-#endif // SZ_USE_ARM_SVE
+#endif // SZ_USE_ARM_SVE || SZ_USE_ARM_SVE2
+#if (SZ_USE_X86_AVX512 || SZ_USE_X86_AVX2) && defined(_MSC_VER)
+#include <intrin.h> // `__cpuidex`, `_xgetbv`
+#endif
+#if (SZ_USE_ARM_SVE || SZ_USE_ARM_SVE2) && defined(__linux__) && !SZ_AVOID_LIBC
+#include <sys/auxv.h> // `getauxval`
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+#ifndef HWCAP2_SVE2
+#define HWCAP2_SVE2 (1 << 1)
+#endif
+#endif
 
 #pragma region Hardware-Specific API
 
@@ -1129,13 +1996,46 @@ SZ_PUBLIC sz_cptr_t sz_rfind_byte_avx512(sz_cptr_t haystack, sz_size_t h_length,
 SZ_PUBLIC sz_cptr_t sz_find_avx512(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length);
 /** @copydoc sz_rfind */
 SZ_PUBLIC sz_cptr_t sz_rfind_avx512(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length);
+/** @copydoc sz_find_prepared */
+SZ_PUBLIC sz_cptr_t sz_find_prepared_avx512(sz_needle_t const *needle, sz_cptr_t haystack, sz_size_t h_length);
+/** @copydoc sz_tolower */
+SZ_PUBLIC void sz_tolower_avx512(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+/** @copydoc sz_toupper */
+SZ_PUBLIC void sz_toupper_avx512(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+/** @copydoc sz_toascii */
+SZ_PUBLIC void sz_toascii_avx512(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+/** @copydoc sz_translate */
+SZ_PUBLIC void sz_translate_avx512(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result);
+/** @copydoc sz_isascii */
+SZ_PUBLIC sz_bool_t sz_isascii_avx512(sz_cptr_t text, sz_size_t length);
+/** @copydoc sz_find_case_insensitive */
+SZ_PUBLIC sz_cptr_t sz_find_case_insensitive_avx512(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                                    sz_size_t n_length);
 /** @copydoc sz_find_charset */
 SZ_PUBLIC sz_cptr_t sz_find_charset_avx512(sz_cptr_t text, sz_size_t length, sz_charset_t const *set);
 /** @copydoc sz_rfind_charset */
 SZ_PUBLIC sz_cptr_t sz_rfind_charset_avx512(sz_cptr_t text, sz_size_t length, sz_charset_t const *set);
+/** @copydoc sz_split_offsets */
+SZ_PUBLIC sz_size_t sz_split_offsets_avx512(sz_cptr_t text, sz_size_t length, sz_charset_t const *delimiters,
+                                            sz_size_t base, void *offsets, sz_size_t offset_bytes,
+                                            sz_size_t capacity, sz_size_t *consumed);
+/** @copydoc sz_utf8_valid */
+SZ_PUBLIC sz_bool_t sz_utf8_valid_avx512(sz_cptr_t text, sz_size_t length);
+/** @copydoc sz_utf8_count */
+SZ_PUBLIC sz_size_t sz_utf8_count_avx512(sz_cptr_t text, sz_size_t length);
+/** @copydoc sz_utf8_find_nth */
+SZ_PUBLIC sz_cptr_t sz_utf8_find_nth_avx512(sz_cptr_t text, sz_size_t length, sz_size_t n);
+/** @copydoc sz_utf8_to_utf32 */
+SZ_PUBLIC sz_size_t sz_utf8_to_utf32_avx512(sz_cptr_t text, sz_size_t length, sz_rune_t *runes);
+/** @copydoc sz_find_any */
+SZ_PUBLIC sz_cptr_t sz_find_any_avx512(sz_multi_pattern_t const *pattern, sz_cptr_t haystack, sz_size_t h_length,
+                                       sz_size_t *needle_id);
 /** @copydoc sz_edit_distance */
 SZ_PUBLIC sz_size_t sz_edit_distance_avx512(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length, //
                                             sz_size_t bound, sz_memory_allocator_t *alloc);
+/** @copydoc sz_find_fuzzy */
+SZ_PUBLIC sz_cptr_t sz_find_fuzzy_avx512(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length,
+                                         sz_size_t max_edits, sz_memory_allocator_t *alloc, sz_size_t *match_length);
 /** @copydoc sz_alignment_score */
 SZ_PUBLIC sz_ssize_t sz_alignment_score_avx512(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length, //
                                                sz_error_cost_t const *subs, sz_error_cost_t gap,                 //
@@ -1143,6 +2043,20 @@ SZ_PUBLIC sz_ssize_t sz_alignment_score_avx512(sz_cptr_t a, sz_size_t a_length,
 /** @copydoc sz_hashes */
 SZ_PUBLIC void sz_hashes_avx512(sz_cptr_t text, sz_size_t length, sz_size_t window_length, sz_size_t step, //
                                 sz_hash_callback_t callback, void *callback_handle);
+/** @copydoc sz_hashes_sketch */
+SZ_PUBLIC void sz_hashes_sketch_avx512(sz_cptr_t text, sz_size_t length, sz_size_t const *window_lengths,
+                                       sz_size_t windows_count, sz_size_t permutations_count, sz_u64_t *min_hashes,
+                                       sz_u64_t *sim_hashes);
+/** @copydoc sz_fingerprints_top_k */
+SZ_PUBLIC sz_size_t sz_fingerprints_top_k_avx512(sz_cptr_t query, sz_cptr_t fingerprints, sz_size_t fingerprint_bytes,
+                                                 sz_sorted_idx_t const *ids, sz_size_t count, sz_size_t k,
+                                                 sz_fingerprint_metric_t metric, sz_fingerprint_match_t *matches);
+/** @copydoc sz_hash_batch */
+SZ_PUBLIC void sz_hash_batch_avx512(sz_sequence_t const *sequence, sz_u64_t *hashes);
+/** @copydoc sz_edit_distances_batch */
+SZ_PUBLIC sz_bool_t sz_edit_distances_batch_avx512(sz_cptr_t query, sz_size_t query_length,
+                                                   sz_sequence_t const *candidates, sz_size_t bound,
+                                                   sz_size_t *distances, sz_memory_allocator_t *alloc);
 #endif
 
 #if SZ_USE_X86_AVX2
@@ -1160,9 +2074,33 @@ SZ_PUBLIC sz_cptr_t sz_rfind_byte_avx2(sz_cptr_t haystack, sz_size_t h_length, s
 SZ_PUBLIC sz_cptr_t sz_find_avx2(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length);
 /** @copydoc sz_rfind */
 SZ_PUBLIC sz_cptr_t sz_rfind_avx2(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length);
+/** @copydoc sz_find_prepared */
+SZ_PUBLIC sz_cptr_t sz_find_prepared_avx2(sz_needle_t const *needle, sz_cptr_t haystack, sz_size_t h_length);
+/** @copydoc sz_tolower */
+SZ_PUBLIC void sz_tolower_avx2(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+/** @copydoc sz_toupper */
+SZ_PUBLIC void sz_toupper_avx2(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+/** @copydoc sz_toascii */
+SZ_PUBLIC void sz_toascii_avx2(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+/** @copydoc sz_translate */
+SZ_PUBLIC void sz_translate_avx2(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result);
+/** @copydoc sz_isascii */
+SZ_PUBLIC sz_bool_t sz_isascii_avx2(sz_cptr_t text, sz_size_t length);
+/** @copydoc sz_find_case_insensitive */
+SZ_PUBLIC sz_cptr_t sz_find_case_insensitive_avx2(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                                  sz_size_t n_length);
+/** @copydoc sz_find_any */
+SZ_PUBLIC sz_cptr_t sz_find_any_avx2(sz_multi_pattern_t const *pattern, sz_cptr_t haystack, sz_size_t h_length,
+                                     sz_size_t *needle_id);
 /** @copydoc sz_hashes */
 SZ_PUBLIC void sz_hashes_avx2(sz_cptr_t text, sz_size_t length, sz_size_t window_length, sz_size_t step, //
                               sz_hash_callback_t callback, void *callback_handle);
+/** @copydoc sz_hash_batch */
+SZ_PUBLIC void sz_hash_batch_avx2(sz_sequence_t const *sequence, sz_u64_t *hashes);
+/** @copydoc sz_alignment_score */
+SZ_PUBLIC sz_ssize_t sz_alignment_score_avx2(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length, //
+                                             sz_error_cost_t const *subs, sz_error_cost_t gap,                 //
+                                             sz_memory_allocator_t *alloc);
 #endif
 
 #if SZ_USE_ARM_NEON
@@ -1176,10 +2114,79 @@ SZ_PUBLIC sz_cptr_t sz_rfind_byte_neon(sz_cptr_t haystack, sz_size_t h_length, s
 SZ_PUBLIC sz_cptr_t sz_find_neon(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length);
 /** @copydoc sz_rfind */
 SZ_PUBLIC sz_cptr_t sz_rfind_neon(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length);
+/** @copydoc sz_find_prepared */
+SZ_PUBLIC sz_cptr_t sz_find_prepared_neon(sz_needle_t const *needle, sz_cptr_t haystack, sz_size_t h_length);
+/** @copydoc sz_tolower */
+SZ_PUBLIC void sz_tolower_neon(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+/** @copydoc sz_toupper */
+SZ_PUBLIC void sz_toupper_neon(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+/** @copydoc sz_toascii */
+SZ_PUBLIC void sz_toascii_neon(sz_cptr_t text, sz_size_t length, sz_ptr_t result);
+/** @copydoc sz_translate */
+SZ_PUBLIC void sz_translate_neon(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result);
+/** @copydoc sz_isascii */
+SZ_PUBLIC sz_bool_t sz_isascii_neon(sz_cptr_t text, sz_size_t length);
+/** @copydoc sz_find_case_insensitive */
+SZ_PUBLIC sz_cptr_t sz_find_case_insensitive_neon(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                                  sz_size_t n_length);
 /** @copydoc sz_find_charset */
 SZ_PUBLIC sz_cptr_t sz_find_charset_neon(sz_cptr_t text, sz_size_t length, sz_charset_t const *set);
 /** @copydoc sz_rfind_charset */
 SZ_PUBLIC sz_cptr_t sz_rfind_charset_neon(sz_cptr_t text, sz_size_t length, sz_charset_t const *set);
+/** @copydoc sz_split_offsets */
+SZ_PUBLIC sz_size_t sz_split_offsets_neon(sz_cptr_t text, sz_size_t length, sz_charset_t const *delimiters,
+                                          sz_size_t base, void *offsets, sz_size_t offset_bytes,
+                                          sz_size_t capacity, sz_size_t *consumed);
+/** @copydoc sz_utf8_valid */
+SZ_PUBLIC sz_bool_t sz_utf8_valid_neon(sz_cptr_t text, sz_size_t length);
+/** @copydoc sz_utf8_count */
+SZ_PUBLIC sz_size_t sz_utf8_count_neon(sz_cptr_t text, sz_size_t length);
+/** @copydoc sz_utf8_find_nth */
+SZ_PUBLIC sz_cptr_t sz_utf8_find_nth_neon(sz_cptr_t text, sz_size_t length, sz_size_t n);
+/** @copydoc sz_utf8_to_utf32 */
+SZ_PUBLIC sz_size_t sz_utf8_to_utf32_neon(sz_cptr_t text, sz_size_t length, sz_rune_t *runes);
+/** @copydoc sz_find_any */
+SZ_PUBLIC sz_cptr_t sz_find_any_neon(sz_multi_pattern_t const *pattern, sz_cptr_t haystack, sz_size_t h_length,
+                                     sz_size_t *needle_id);
+/** @copydoc sz_hash_batch */
+SZ_PUBLIC void sz_hash_batch_neon(sz_sequence_t const *sequence, sz_u64_t *hashes);
+/** @copydoc sz_alignment_score */
+SZ_PUBLIC sz_ssize_t sz_alignment_score_neon(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length, //
+                                             sz_error_cost_t const *subs, sz_error_cost_t gap,                 //
+                                             sz_memory_allocator_t *alloc);
+/** @copydoc sz_fingerprints_top_k */
+SZ_PUBLIC sz_size_t sz_fingerprints_top_k_neon(sz_cptr_t query, sz_cptr_t fingerprints, sz_size_t fingerprint_bytes,
+                                               sz_sorted_idx_t const *ids, sz_size_t count, sz_size_t k,
+                                               sz_fingerprint_metric_t metric, sz_fingerprint_match_t *matches);
+#endif
+
+#if SZ_USE_ARM_SVE
+/** @copydoc sz_equal */
+SZ_PUBLIC sz_bool_t sz_equal_sve(sz_cptr_t a, sz_cptr_t b, sz_size_t length);
+/** @copydoc sz_order */
+SZ_PUBLIC sz_ordering_t sz_order_sve(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length);
+/** @copydoc sz_copy */
+SZ_PUBLIC void sz_copy_sve(sz_ptr_t target, sz_cptr_t source, sz_size_t length);
+/** @copydoc sz_fill */
+SZ_PUBLIC void sz_fill_sve(sz_ptr_t target, sz_size_t length, sz_u8_t value);
+/** @copydoc sz_find_byte */
+SZ_PUBLIC sz_cptr_t sz_find_byte_sve(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle);
+/** @copydoc sz_rfind_byte */
+SZ_PUBLIC sz_cptr_t sz_rfind_byte_sve(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle);
+/** @copydoc sz_find */
+SZ_PUBLIC sz_cptr_t sz_find_sve(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length);
+/** @copydoc sz_rfind */
+SZ_PUBLIC sz_cptr_t sz_rfind_sve(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length);
+/** @copydoc sz_hashes */
+SZ_PUBLIC void sz_hashes_sve(sz_cptr_t text, sz_size_t length, sz_size_t window_length, sz_size_t step, //
+                             sz_hash_callback_t callback, void *callback_handle);
+#endif
+
+#if SZ_USE_ARM_SVE2
+/** @copydoc sz_find_charset */
+SZ_PUBLIC sz_cptr_t sz_find_charset_sve2(sz_cptr_t text, sz_size_t length, sz_charset_t const *set);
+/** @copydoc sz_rfind_charset */
+SZ_PUBLIC sz_cptr_t sz_rfind_charset_sve2(sz_cptr_t text, sz_size_t length, sz_charset_t const *set);
 #endif
 
 #pragma endregion
@@ -1556,6 +2563,46 @@ SZ_INTERNAL void _sz_memory_free_fixed(sz_ptr_t start, sz_size_t length, void *h
     sz_unused(start && length && handle);
 }
 
+/**
+ *  @brief  Every chunk of an arena starts with a link to the previous chunk and its own capacity.
+ *          The same size is used as the alignment of all the allocations, matching the guarantees of `malloc`.
+ */
+#define _SZ_MEMORY_ARENA_HEADER_SIZE (2 * sizeof(sz_size_t))
+
+/** @brief  Helper function, rounding the allocation size up to the alignment of the arena. */
+SZ_INTERNAL sz_size_t _sz_memory_arena_round_up(sz_size_t length) {
+    return (length + _SZ_MEMORY_ARENA_HEADER_SIZE - 1) & ~(sz_size_t)(_SZ_MEMORY_ARENA_HEADER_SIZE - 1);
+}
+
+/** @brief  Helper function, bumping the cursor of the arena, and chaining a new chunk, if the current one is full. */
+SZ_INTERNAL sz_ptr_t _sz_memory_allocate_arena(sz_size_t length, void *handle) {
+    sz_memory_arena_t *arena = (sz_memory_arena_t *)handle;
+    sz_size_t aligned_length = _sz_memory_arena_round_up(length);
+    if ((sz_size_t)(arena->end - arena->cursor) < aligned_length) {
+        sz_size_t required_capacity = _SZ_MEMORY_ARENA_HEADER_SIZE + aligned_length;
+        if (aligned_length < length || required_capacity < aligned_length) return SZ_NULL_CHAR; // Overflow
+        sz_size_t capacity = arena->chunk_capacity;
+        while (capacity < required_capacity) capacity = capacity > SZ_SIZE_MAX / 2 ? required_capacity : capacity * 2;
+        sz_size_t *chunk = (sz_size_t *)arena->upstream.allocate(capacity, arena->upstream.handle);
+        if (!chunk) return SZ_NULL_CHAR;
+        *(void **)chunk = arena->chunk;
+        chunk[1] = capacity;
+        arena->chunk = chunk;
+        arena->cursor = (sz_ptr_t)chunk + _SZ_MEMORY_ARENA_HEADER_SIZE;
+        arena->end = (sz_ptr_t)chunk + capacity;
+        arena->chunk_capacity = capacity > SZ_SIZE_MAX / 2 ? capacity : capacity * 2;
+    }
+    sz_ptr_t result = arena->cursor;
+    arena->cursor += aligned_length;
+    return result;
+}
+
+/** @brief  Helper function, rolling back the cursor of the arena, if the most recent allocation is released. */
+SZ_INTERNAL void _sz_memory_free_arena(sz_ptr_t start, sz_size_t length, void *handle) {
+    sz_memory_arena_t *arena = (sz_memory_arena_t *)handle;
+    if (start + _sz_memory_arena_round_up(length) == arena->cursor) arena->cursor = start;
+}
+
 /** @brief  An internal callback used to set a bit in a power-of-two length binary fingerprint of a string. */
 SZ_INTERNAL void _sz_hashes_fingerprint_pow2_callback(sz_cptr_t start, sz_size_t length, sz_u64_t hash, void *handle) {
     sz_string_view_t *fingerprint_buffer = (sz_string_view_t *)handle;
@@ -1645,10 +2692,49 @@ SZ_PUBLIC void sz_memory_allocator_init_fixed(sz_memory_allocator_t *alloc, void
     // Later use it for bounds checking.
     alloc->allocate = (sz_memory_allocate_t)_sz_memory_allocate_fixed;
     alloc->free = (sz_memory_free_t)_sz_memory_free_fixed;
-    alloc->handle = &buffer;
+    alloc->handle = buffer;
     sz_copy((sz_ptr_t)buffer, (sz_cptr_t)&length, sizeof(sz_size_t));
 }
 
+SZ_PUBLIC void sz_memory_arena_init(sz_memory_arena_t *arena, sz_size_t chunk_capacity,
+                                    sz_memory_allocator_t const *upstream) {
+    if (upstream) { arena->upstream = *upstream; }
+    else { sz_memory_allocator_init_default(&arena->upstream); }
+    // The capacity must fit the header and at least one aligned allocation, to guarantee the doubling progress.
+    if (!chunk_capacity) chunk_capacity = 4096;
+    if (chunk_capacity < 4 * _SZ_MEMORY_ARENA_HEADER_SIZE) chunk_capacity = 4 * _SZ_MEMORY_ARENA_HEADER_SIZE;
+    arena->chunk_capacity = chunk_capacity;
+    arena->chunk = SZ_NULL;
+    arena->cursor = arena->end = SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC void sz_memory_arena_reset(sz_memory_arena_t *arena) {
+    sz_size_t *newest = (sz_size_t *)arena->chunk;
+    if (!newest) return;
+    // Only the most recent chunk is kept, as it's the largest one.
+    for (sz_size_t *chunk = (sz_size_t *)*(void **)newest, *previous; chunk; chunk = previous) {
+        previous = (sz_size_t *)*(void **)chunk;
+        arena->upstream.free(chunk, chunk[1], arena->upstream.handle);
+    }
+    *(void **)newest = SZ_NULL;
+    arena->cursor = (sz_ptr_t)newest + _SZ_MEMORY_ARENA_HEADER_SIZE;
+}
+
+SZ_PUBLIC void sz_memory_arena_free(sz_memory_arena_t *arena) {
+    for (sz_size_t *chunk = (sz_size_t *)arena->chunk, *previous; chunk; chunk = previous) {
+        previous = (sz_size_t *)*(void **)chunk;
+        arena->upstream.free(chunk, chunk[1], arena->upstream.handle);
+    }
+    arena->chunk = SZ_NULL;
+    arena->cursor = arena->end = SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC void sz_memory_allocator_init_arena(sz_memory_allocator_t *alloc, sz_memory_arena_t *arena) {
+    alloc->allocate = (sz_memory_allocate_t)_sz_memory_allocate_arena;
+    alloc->free = (sz_memory_free_t)_sz_memory_free_arena;
+    alloc->handle = arena;
+}
+
 /**
  *  @brief  Byte-level equality comparison between two strings.
  *          If unaligned loads are allowed, uses a switch-table to avoid loops on short strings.
@@ -1685,6 +2771,22 @@ SZ_PUBLIC sz_cptr_t sz_rfind_charset_serial(sz_cptr_t text, sz_size_t length, sz
 #pragma GCC diagnostic pop
 }
 
+SZ_PUBLIC sz_size_t sz_split_offsets_serial(sz_cptr_t text, sz_size_t length, sz_charset_t const *delimiters,
+                                            sz_size_t base, void *offsets, sz_size_t offset_bytes,
+                                            sz_size_t capacity, sz_size_t *consumed) {
+    sz_u32_t *offsets_u32 = (sz_u32_t *)offsets;
+    sz_u64_t *offsets_u64 = (sz_u64_t *)offsets;
+    sz_size_t count = 0, progress = 0;
+    for (; progress != length && count != capacity; ++progress) {
+        if (!sz_charset_contains(delimiters, text[progress])) continue;
+        if (offset_bytes == 4) offsets_u32[count] = (sz_u32_t)(base + progress);
+        else offsets_u64[count] = (sz_u64_t)(base + progress);
+        ++count;
+    }
+    if (consumed) *consumed = progress;
+    return count;
+}
+
 SZ_PUBLIC sz_ordering_t sz_order_serial(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length) {
     sz_ordering_t ordering_lookup[2] = {sz_greater_k, sz_less_k};
     sz_bool_t a_shorter = (sz_bool_t)(a_length < b_length);
@@ -1698,7 +2800,7 @@ SZ_PUBLIC sz_ordering_t sz_order_serial(sz_cptr_t a, sz_size_t a_length, sz_cptr
     }
 #endif
     for (; a != min_end; ++a, ++b)
-        if (*a != *b) return ordering_lookup[*a < *b];
+        if (*a != *b) return ordering_lookup[(sz_u8_t)*a < (sz_u8_t)*b];
     return a_length != b_length ? ordering_lookup[a_shorter] : sz_equal_k;
 }
 
@@ -1937,8 +3039,9 @@ SZ_INTERNAL sz_cptr_t _sz_find_3byte_serial(sz_cptr_t h, sz_size_t h_length, sz_
     sz_u64_vec_t h0_vec, h1_vec, h2_vec, h3_vec, h4_vec;
     sz_u64_vec_t matches0_vec, matches1_vec, matches2_vec, matches3_vec, matches4_vec;
     sz_u64_vec_t n_vec;
+    // Only 3 bytes of the needle can be read, and the 4th must stay zero to avoid carries in the broadcast.
     n_vec.u64 = 0;
-    n_vec.u8s[0] = n[0], n_vec.u8s[1] = n[1], n_vec.u8s[2] = n[2], n_vec.u8s[3] = n[3];
+    n_vec.u8s[0] = n[0], n_vec.u8s[1] = n[1], n_vec.u8s[2] = n[2];
     n_vec.u64 *= 0x0000000001000001ull; // broadcast
 
     // This code simulates hyper-scalar execution, analyzing 8 offsets at a time using three 64-bit words.
@@ -2092,7 +3195,7 @@ SZ_INTERNAL sz_cptr_t _sz_find_with_prefix(sz_cptr_t h, sz_size_t h_length, sz_c
 
         // Verify the remaining part of the needle
         sz_size_t remaining = h_length - (found - h);
-        if (remaining < suffix_length) return SZ_NULL_CHAR;
+        if (remaining < n_length) return SZ_NULL_CHAR;
         if (sz_equal(found + prefix_length, n + prefix_length, suffix_length)) return found;
 
         // Adjust the position.
@@ -2122,7 +3225,7 @@ SZ_INTERNAL sz_cptr_t _sz_rfind_with_suffix(sz_cptr_t h, sz_size_t h_length, sz_
         if (sz_equal(found - prefix_length, n, prefix_length)) return found - prefix_length;
 
         // Adjust the position.
-        h_length = remaining - 1;
+        h_length = remaining + suffix_length - 1;
     }
 
     // Unreachable, but helps silence compiler warnings:
@@ -2208,6 +3311,471 @@ SZ_PUBLIC sz_cptr_t sz_rfind_serial(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n
         (n_length > 256)](h, h_length, n, n_length);
 }
 
+SZ_PUBLIC void sz_needle_prepare(sz_cptr_t n, sz_size_t n_length, sz_needle_t *prepared) {
+    prepared->start = n;
+    prepared->length = n_length;
+    prepared->offset_first = prepared->offset_mid = prepared->offset_last = 0;
+    if (!n_length) return;
+    _sz_locate_needle_anomalies(n, n_length, &prepared->offset_first, &prepared->offset_mid, &prepared->offset_last);
+
+    // The table only covers the first 255 bytes of the needle, so that all the shifts fit into a byte.
+    // Any prefix of the needle produces valid shifts, we just verify the whole needle on every candidate.
+    sz_u8_t const *n_u8 = (sz_u8_t const *)n;
+    sz_size_t const prefix_length = n_length < 255 ? n_length : 255;
+    for (sz_size_t i = 0; i != 256; ++i) prepared->bad_shifts[i] = (sz_u8_t)prefix_length;
+    for (sz_size_t i = 0; i + 1 < prefix_length; ++i) prepared->bad_shifts[n_u8[i]] = (sz_u8_t)(prefix_length - i - 1);
+}
+
+/**
+ *  @brief  Boyer-Moore-Horspool algorithm with the Raita heuristic, reusing the skip table of a prepared needle.
+ *          Unlike `_sz_find_horspool_upto_256bytes_serial`, supports needles of any length above one byte.
+ */
+SZ_INTERNAL sz_cptr_t _sz_find_horspool_prepared_serial(sz_needle_t const *needle, sz_cptr_t h_chars,
+                                                        sz_size_t h_length) {
+    sz_u8_t const *h = (sz_u8_t const *)h_chars;
+    sz_u8_t const *n = (sz_u8_t const *)needle->start;
+    sz_size_t const n_length = needle->length;
+    sz_size_t const prefix_last = (n_length < 255 ? n_length : 255) - 1;
+    sz_size_t const offset_first = needle->offset_first, offset_mid = needle->offset_mid,
+                    offset_last = needle->offset_last;
+
+    sz_u32_vec_t h_vec, n_vec;
+    n_vec.u8s[0] = n[offset_first];
+    n_vec.u8s[1] = n[offset_first + 1];
+    n_vec.u8s[2] = n[offset_mid];
+    n_vec.u8s[3] = n[offset_last];
+
+    for (sz_size_t i = 0; i <= h_length - n_length;) {
+        h_vec.u8s[0] = h[i + offset_first];
+        h_vec.u8s[1] = h[i + offset_first + 1];
+        h_vec.u8s[2] = h[i + offset_mid];
+        h_vec.u8s[3] = h[i + offset_last];
+        if (h_vec.u32 == n_vec.u32 && sz_equal((sz_cptr_t)h + i, needle->start, n_length)) return (sz_cptr_t)h + i;
+        i += needle->bad_shifts[h[i + prefix_last]];
+    }
+    return SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_prepared_serial(sz_needle_t const *needle, sz_cptr_t h, sz_size_t h_length) {
+
+    sz_size_t const n_length = needle->length;
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+    if (n_length == 1) return sz_find_byte_serial(h, h_length, needle->start);
+
+#if !SZ_DETECT_BIG_ENDIAN
+    // Short needles are matched with SWAR and don't need any setup, so there is nothing to reuse.
+    if (n_length <= 8) return sz_find_serial(h, h_length, needle->start, n_length);
+#endif
+    return _sz_find_horspool_prepared_serial(needle, h, h_length);
+}
+
+SZ_PUBLIC sz_bool_t sz_multi_pattern_init(sz_multi_pattern_t *pattern, sz_string_view_t const *needles,
+                                          sz_size_t count, sz_memory_allocator_t *alloc) {
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    pattern->needles = SZ_NULL;
+    pattern->ids = pattern->prefixes = SZ_NULL;
+    pattern->count = count;
+    pattern->ids_count = 0;
+    pattern->probe_length = 0;
+    for (sz_size_t bucket = 0; bucket != 9; ++bucket) pattern->bucket_starts[bucket] = 0;
+    sz_fill((sz_ptr_t)&pattern->bytes[0][0], sizeof(pattern->bytes), 0);
+    sz_fill((sz_ptr_t)&pattern->low_nibbles[0][0], sizeof(pattern->low_nibbles), 0);
+    sz_fill((sz_ptr_t)&pattern->high_nibbles[0][0], sizeof(pattern->high_nibbles), 0);
+    if (!count) return sz_true_k;
+
+    // The shortest non-empty needle defines, how many leading bytes we can probe.
+    sz_size_t ids_count = 0, min_length = SZ_SIZE_MAX;
+    for (sz_size_t i = 0; i != count; ++i)
+        if (needles[i].length) ++ids_count, min_length = sz_min_of_two(min_length, needles[i].length);
+    sz_size_t const probe_length = ids_count ? sz_min_of_two(min_length, 3) : 0;
+
+    // Use a single allocation for the copy of the views, the sorted IDs and prefixes, and a temporary buffer
+    // of the same size to perform the radix sort on those.
+    sz_size_t const buffer_length = count * sizeof(sz_string_view_t) + ids_count * sizeof(sz_u32_t) * 4;
+    sz_ptr_t buffer = (sz_ptr_t)alloc->allocate(buffer_length, alloc->handle);
+    if (!buffer) return sz_false_k;
+    sz_string_view_t *needles_copy = (sz_string_view_t *)buffer;
+    sz_u32_t *ids = (sz_u32_t *)(buffer + count * sizeof(sz_string_view_t));
+    sz_u32_t *prefixes = ids + ids_count;
+    sz_u32_t *ids_temporary = prefixes + ids_count;
+    sz_u32_t *prefixes_temporary = ids_temporary + ids_count;
+    sz_copy((sz_ptr_t)needles_copy, (sz_cptr_t)needles, count * sizeof(sz_string_view_t));
+
+    // Export the probed prefixes in big-endian order, so that integer and lexicographic orders are the same.
+    for (sz_size_t i = 0, j = 0; i != count; ++i) {
+        if (!needles[i].length) continue;
+        sz_u8_t const *needle = (sz_u8_t const *)needles[i].start;
+        sz_u32_t prefix = 0;
+        for (sz_size_t k = 0; k != probe_length; ++k) prefix = (prefix << 8) | needle[k];
+        ids[j] = (sz_u32_t)i, prefixes[j] = prefix, ++j;
+    }
+
+    // Stable LSD radix sort over the probed bytes keeps the IDs ascending within equal prefixes.
+    for (sz_size_t shift = 0; shift != probe_length * 8; shift += 8) {
+        sz_size_t offsets[256] = {0};
+        for (sz_size_t j = 0; j != ids_count; ++j) ++offsets[(prefixes[j] >> shift) & 0xFFu];
+        for (sz_size_t byte = 0, total = 0; byte != 256; ++byte) {
+            sz_size_t byte_count = offsets[byte];
+            offsets[byte] = total, total += byte_count;
+        }
+        for (sz_size_t j = 0; j != ids_count; ++j) {
+            sz_size_t target = offsets[(prefixes[j] >> shift) & 0xFFu]++;
+            ids_temporary[target] = ids[j], prefixes_temporary[target] = prefixes[j];
+        }
+        sz_pointer_swap((void **)&ids, (void **)&ids_temporary);
+        sz_pointer_swap((void **)&prefixes, (void **)&prefixes_temporary);
+    }
+
+    // Split the sorted needles into 8 buckets of similar size. Neighboring needles share prefixes,
+    // so the per-bucket masks of bytes and nibbles stay sparse.
+    for (sz_size_t bucket = 0; bucket != 9; ++bucket) pattern->bucket_starts[bucket] = ids_count * bucket / 8;
+    for (sz_size_t bucket = 0; bucket != 8; ++bucket) {
+        sz_u8_t const bucket_mask = (sz_u8_t)(1u << bucket);
+        for (sz_size_t j = pattern->bucket_starts[bucket]; j != pattern->bucket_starts[bucket + 1]; ++j) {
+            sz_u8_t const *needle = (sz_u8_t const *)needles[ids[j]].start;
+            for (sz_size_t k = 0; k != probe_length; ++k) {
+                pattern->bytes[k][needle[k]] |= bucket_mask;
+                pattern->low_nibbles[k][needle[k] & 0x0F] |= bucket_mask;
+                pattern->high_nibbles[k][needle[k] >> 4] |= bucket_mask;
+            }
+        }
+    }
+
+    // Positions that are not probed shouldn't filter out anything.
+    for (sz_size_t k = probe_length; k != 3; ++k) {
+        sz_fill((sz_ptr_t)&pattern->bytes[k][0], 256, 0xFF);
+        sz_fill((sz_ptr_t)&pattern->low_nibbles[k][0], 16, 0xFF);
+        sz_fill((sz_ptr_t)&pattern->high_nibbles[k][0], 16, 0xFF);
+    }
+
+    pattern->needles = needles_copy;
+    pattern->ids = ids;
+    pattern->prefixes = prefixes;
+    pattern->ids_count = ids_count;
+    pattern->probe_length = probe_length;
+    return sz_true_k;
+}
+
+SZ_PUBLIC void sz_multi_pattern_free(sz_multi_pattern_t *pattern, sz_memory_allocator_t *alloc) {
+    if (!pattern->needles) return;
+
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    sz_size_t const buffer_length =
+        pattern->count * sizeof(sz_string_view_t) + pattern->ids_count * sizeof(sz_u32_t) * 4;
+    alloc->free(pattern->needles, buffer_length, alloc->handle);
+    pattern->needles = SZ_NULL;
+    pattern->ids = pattern->prefixes = SZ_NULL;
+    pattern->count = pattern->ids_count = pattern->probe_length = 0;
+}
+
+/**
+ *  @brief  Verifies a candidate position of a multi-pattern search against the needles in the given ::buckets,
+ *          outputting the smallest matching needle ID.
+ */
+SZ_INTERNAL sz_bool_t _sz_find_any_verify(sz_multi_pattern_t const *pattern, sz_cptr_t h, sz_size_t h_length,
+                                          sz_u8_t buckets, sz_size_t *needle_id) {
+
+    sz_size_t const probe_length = pattern->probe_length;
+    if (h_length < probe_length) return sz_false_k;
+
+    sz_u8_t const *h_unsigned = (sz_u8_t const *)h;
+    sz_u32_t prefix = 0;
+    for (sz_size_t k = 0; k != probe_length; ++k) prefix = (prefix << 8) | h_unsigned[k];
+
+    // Needles with identical prefixes are sorted by their IDs and may only overflow into the next bucket.
+    // So checking the buckets in ascending order, the first found match is the one with the smallest ID.
+    for (; buckets; buckets &= buckets - 1) {
+        sz_size_t const bucket = (sz_size_t)sz_u32_ctz(buckets);
+        sz_size_t low = pattern->bucket_starts[bucket], high = pattern->bucket_starts[bucket + 1];
+        sz_size_t const bucket_end = high;
+        while (low < high) {
+            sz_size_t mid = low + (high - low) / 2;
+            if (pattern->prefixes[mid] < prefix) low = mid + 1;
+            else { high = mid; }
+        }
+        for (; low != bucket_end && pattern->prefixes[low] == prefix; ++low) {
+            sz_string_view_t const needle = pattern->needles[pattern->ids[low]];
+            if (needle.length > h_length) continue;
+            if (sz_equal(h + probe_length, needle.start + probe_length, needle.length - probe_length)) {
+                *needle_id = pattern->ids[low];
+                return sz_true_k;
+            }
+        }
+    }
+    return sz_false_k;
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_any_serial(sz_multi_pattern_t const *pattern, sz_cptr_t h, sz_size_t h_length,
+                                       sz_size_t *needle_id) {
+
+    sz_size_t const probe_length = pattern->probe_length;
+    if (!probe_length || h_length < probe_length) return SZ_NULL_CHAR;
+
+    sz_u8_t const *h_unsigned = (sz_u8_t const *)h;
+    sz_u8_t const *const h_end = h_unsigned + h_length;
+    sz_u8_t const *const candidates_end = h_end - probe_length + 1;
+    for (; h_unsigned != candidates_end; ++h_unsigned) {
+        sz_u8_t buckets = pattern->bytes[0][h_unsigned[0]];
+        if (!buckets) continue;
+        if (probe_length > 1) buckets &= pattern->bytes[1][h_unsigned[1]];
+        if (probe_length > 2) buckets &= pattern->bytes[2][h_unsigned[2]];
+        if (buckets && _sz_find_any_verify(pattern, (sz_cptr_t)h_unsigned, (sz_size_t)(h_end - h_unsigned), buckets,
+                                           needle_id))
+            return (sz_cptr_t)h_unsigned;
+    }
+    return SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC void sz_find_stream_init(sz_find_stream_t *stream, sz_cptr_t needle, sz_size_t n_length,
+                                   sz_bool_t skip_overlapping) {
+    stream->needle = needle;
+    stream->needle_length = n_length;
+    stream->offset = 0;
+    stream->matched_prefix = 0;
+    stream->next_allowed = 0;
+    stream->skip_overlapping = skip_overlapping;
+}
+
+/**
+ *  @brief  Helper function for ::sz_find_stream_feed, reporting a match at the absolute ::offset,
+ *          unless it overlaps with the previous one, when the overlaps are disallowed.
+ *  @return 1 if the match was reported, 0 otherwise.
+ */
+SZ_INTERNAL sz_size_t _sz_find_stream_report(sz_find_stream_t *stream, sz_size_t offset, //
+                                             sz_find_callback_t callback, void *callback_handle) {
+    if (offset < stream->next_allowed) return 0;
+    stream->next_allowed = offset + (stream->skip_overlapping == sz_true_k ? stream->needle_length : 1);
+    callback(offset, callback_handle);
+    return 1;
+}
+
+SZ_PUBLIC sz_size_t sz_find_stream_feed(sz_find_stream_t *stream, sz_cptr_t chunk, sz_size_t length,
+                                        sz_find_callback_t callback, void *callback_handle) {
+
+    sz_cptr_t const needle = stream->needle;
+    sz_size_t const n_length = stream->needle_length;
+    sz_size_t const chunk_offset = stream->offset;
+    sz_size_t const matched_prefix = stream->matched_prefix;
+    stream->offset += length;
+    if (!n_length) return 0;
+
+    // Try completing the partial matches from the previous chunks, starting from the longest, meaning the earliest.
+    // For chunks shorter than the remaining part of the needle, the longest of them becomes the new partial match.
+    sz_size_t matches = 0;
+    sz_size_t extended_prefix = 0;
+    for (sz_size_t prefix = matched_prefix; prefix; --prefix) {
+        // Only the borders of the longest matched prefix are also the suffixes of the fed data.
+        if (prefix != matched_prefix && !sz_equal(needle, needle + matched_prefix - prefix, prefix)) continue;
+        sz_size_t const missing = n_length - prefix;
+        if (length >= missing) {
+            if (sz_equal(chunk, needle + prefix, missing))
+                matches += _sz_find_stream_report(stream, chunk_offset - prefix, callback, callback_handle);
+        }
+        else if (!extended_prefix && sz_equal(chunk, needle + prefix, length)) { extended_prefix = prefix + length; }
+    }
+
+    // Search for the matches fully within this chunk, respecting the end of the previous one.
+    sz_size_t position = stream->next_allowed > chunk_offset ? stream->next_allowed - chunk_offset : 0;
+    while (position < length) {
+        sz_cptr_t match = sz_find(chunk + position, length - position, needle, n_length);
+        if (!match) break;
+        matches += _sz_find_stream_report(stream, chunk_offset + (sz_size_t)(match - chunk), callback, callback_handle);
+        position = stream->next_allowed - chunk_offset;
+    }
+
+    // The partial matches, that started in the previous chunks, are longer than any starting in this one.
+    if (!extended_prefix) {
+        sz_size_t prefix = sz_min_of_two(length, n_length - 1);
+        for (; prefix; --prefix)
+            if (sz_equal(chunk + length - prefix, needle, prefix)) break;
+        extended_prefix = prefix;
+    }
+    stream->matched_prefix = extended_prefix;
+    return matches;
+}
+
+/**
+ *  @brief  Matches starting within one shard of the haystack, as found by ::_sz_find_parallel_shard.
+ */
+typedef struct {
+    sz_size_t start;        /// Offset of the first byte, where the matches of this shard may start.
+    sz_size_t end;          /// Offset of the first byte, where the matches of the next shard may start.
+    sz_size_t count;        /// Number of matches found.
+    sz_size_t first;        /// Offset of the first match, if any.
+    sz_size_t next_allowed; /// Smallest offset of a match, that could follow the last one.
+    sz_size_t *offsets;     /// Offsets of matches, if they are exported.
+    sz_size_t capacity;     /// Number of offsets, that fit into the allocated buffer.
+    sz_bool_t failed;       /// Whether the offsets buffer couldn't be grown.
+} _sz_find_parallel_shard_t;
+
+typedef struct {
+    sz_cptr_t haystack;
+    sz_size_t h_length;
+    sz_cptr_t needle;
+    sz_size_t n_length;
+    sz_bool_t skip_overlapping;
+    sz_memory_allocator_t *alloc; /// If SZ_NULL, the matches are only counted.
+    _sz_find_parallel_shard_t *shards;
+} _sz_find_parallel_state_t;
+
+/**
+ *  @brief  Helper function for ::sz_find_all_parallel, searching for the matches starting at or after the
+ *          @p position and before the end of the shard. The search window is extended into the next shard
+ *          by `n_length - 1` bytes, so that a match can't start past the end of the shard.
+ */
+SZ_INTERNAL void _sz_find_parallel_shard(_sz_find_parallel_state_t const *state, _sz_find_parallel_shard_t *shard,
+                                         sz_size_t position) {
+    sz_size_t const n_length = state->n_length;
+    sz_size_t const step = state->skip_overlapping == sz_true_k ? n_length : 1;
+    sz_size_t const window_end = sz_min_of_two(shard->end + n_length - 1, state->h_length);
+    shard->count = 0;
+    shard->next_allowed = position;
+    while (position < window_end && window_end - position >= n_length) {
+        sz_cptr_t match = sz_find(state->haystack + position, window_end - position, state->needle, n_length);
+        if (!match) break;
+        sz_size_t const offset = (sz_size_t)(match - state->haystack);
+        if (!shard->count) shard->first = offset;
+
+        // Grow the buffer of offsets, if we need to export them
+        if (state->alloc && shard->count == shard->capacity) {
+            sz_size_t const new_capacity = shard->capacity ? shard->capacity * 2 : 64;
+            sz_size_t *new_offsets = (sz_size_t *)state->alloc->allocate( //
+                new_capacity * sizeof(sz_size_t), state->alloc->handle);
+            if (!new_offsets) {
+                shard->failed = sz_true_k;
+                return;
+            }
+            if (shard->offsets) {
+                sz_copy((sz_ptr_t)new_offsets, (sz_cptr_t)shard->offsets, shard->count * sizeof(sz_size_t));
+                state->alloc->free(shard->offsets, shard->capacity * sizeof(sz_size_t), state->alloc->handle);
+            }
+            shard->offsets = new_offsets;
+            shard->capacity = new_capacity;
+        }
+        if (state->alloc) shard->offsets[shard->count] = offset;
+        ++shard->count;
+        position = shard->next_allowed = offset + step;
+    }
+}
+
+SZ_INTERNAL void _sz_find_parallel_task(void *state_ptr, sz_size_t task_index) {
+    _sz_find_parallel_state_t const *state = (_sz_find_parallel_state_t const *)state_ptr;
+    _sz_find_parallel_shard_t *shard = &state->shards[task_index];
+    _sz_find_parallel_shard(state, shard, shard->start);
+}
+
+/**
+ *  @brief  Shared implementation of ::sz_find_count_parallel and ::sz_find_all_parallel.
+ *  @return Number of matches, or `SZ_SIZE_MAX` if the offsets couldn't be allocated.
+ */
+SZ_INTERNAL sz_size_t _sz_find_parallel(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length,
+                                        sz_bool_t skip_overlapping, sz_size_t **offsets, sz_memory_allocator_t *alloc,
+                                        sz_executor_t const *executor) {
+
+    if (offsets) *offsets = SZ_NULL;
+    if (!n_length || h_length < n_length) return 0;
+
+    // Spawning tasks for small inputs only makes things slower.
+    sz_size_t const min_shard_length = 1024 * 1024;
+    _sz_find_parallel_shard_t shards[256];
+    sz_size_t shards_count = 1;
+    if (executor && executor->threads_count > 1)
+        shards_count = sz_min_of_three(executor->threads_count, sizeof(shards) / sizeof(shards[0]),
+                                       sz_max_of_two(h_length / min_shard_length, 1));
+
+    sz_size_t const shard_length = (h_length + shards_count - 1) / shards_count;
+    for (sz_size_t i = 0; i != shards_count; ++i) {
+        shards[i].start = sz_min_of_two(i * shard_length, h_length);
+        shards[i].end = sz_min_of_two(shards[i].start + shard_length, h_length);
+        shards[i].offsets = SZ_NULL;
+        shards[i].capacity = 0;
+        shards[i].failed = sz_false_k;
+    }
+
+    _sz_find_parallel_state_t state;
+    state.haystack = haystack, state.h_length = h_length;
+    state.needle = needle, state.n_length = n_length;
+    state.skip_overlapping = skip_overlapping;
+    state.alloc = alloc;
+    state.shards = shards;
+    if (shards_count > 1) executor->parallel_for(_sz_find_parallel_task, &state, shards_count, executor->handle);
+    else { _sz_find_parallel_task(&state, 0); }
+
+    // Disjoint matches of a shard may be misaligned with the last match of the previous one, if it straddles
+    // their boundary. In that case, the rest of the chain starting from the first valid position must be recomputed.
+    sz_size_t total = 0;
+    sz_size_t next_allowed = 0;
+    sz_bool_t failed = sz_false_k;
+    for (sz_size_t i = 0; i != shards_count; ++i) {
+        _sz_find_parallel_shard_t *shard = &shards[i];
+        if (!shard->failed && shard->count && shard->first < next_allowed)
+            _sz_find_parallel_shard(&state, shard, next_allowed);
+        if (shard->count) next_allowed = shard->next_allowed;
+        if (shard->failed) failed = sz_true_k;
+        total += shard->count;
+    }
+
+    // Concatenate the offsets from different shards
+    if (alloc) {
+        sz_size_t *merged = SZ_NULL;
+        if (!failed && total) {
+            merged = (sz_size_t *)alloc->allocate(total * sizeof(sz_size_t), alloc->handle);
+            failed = merged ? sz_false_k : sz_true_k;
+        }
+        sz_size_t exported = 0;
+        for (sz_size_t i = 0; i != shards_count; ++i) {
+            if (!failed && shards[i].count)
+                sz_copy((sz_ptr_t)(merged + exported), (sz_cptr_t)shards[i].offsets,
+                        shards[i].count * sizeof(sz_size_t));
+            exported += shards[i].count;
+            if (shards[i].offsets)
+                alloc->free(shards[i].offsets, shards[i].capacity * sizeof(sz_size_t), alloc->handle);
+        }
+        if (failed) return SZ_SIZE_MAX;
+        *offsets = merged;
+    }
+    return total;
+}
+
+SZ_PUBLIC sz_size_t sz_find_count_parallel(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                           sz_size_t n_length, sz_bool_t skip_overlapping,
+                                           sz_executor_t const *executor) {
+    return _sz_find_parallel(haystack, h_length, needle, n_length, skip_overlapping, SZ_NULL, SZ_NULL, executor);
+}
+
+SZ_PUBLIC sz_bool_t sz_find_all_parallel(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                         sz_size_t n_length, sz_bool_t skip_overlapping, sz_size_t **offsets,
+                                         sz_size_t *count, sz_memory_allocator_t *alloc,
+                                         sz_executor_t const *executor) {
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    sz_size_t *found_offsets;
+    sz_size_t found_count =
+        _sz_find_parallel(haystack, h_length, needle, n_length, skip_overlapping, &found_offsets, alloc, executor);
+    if (found_count == SZ_SIZE_MAX) return sz_false_k;
+    *offsets = found_offsets;
+    *count = found_count;
+    return sz_true_k;
+}
+
 SZ_INTERNAL sz_size_t _sz_edit_distance_skewed_diagonals_serial( //
     sz_cptr_t shorter, sz_size_t shorter_length,                 //
     sz_cptr_t longer, sz_size_t longer_length,                   //
@@ -2287,74 +3855,188 @@ SZ_INTERNAL sz_size_t _sz_edit_distance_skewed_diagonals_serial( //
 }
 
 /**
- *  @brief  Describes the length of a UTF8 character / codepoint / rune in bytes.
+ *  @brief  Computes the Levenshtein distance with the bit-parallel algorithm of Myers, as formulated by Hyyrö,
+ *          for the case when the shorter string fits into a single 64-bit word. Performs O(longer_length) word
+ *          operations and doesn't allocate any memory, keeping the match-masks of every byte on the stack.
+ *
+ *  Every bit of the `vertical_positive` and `vertical_negative` words encodes, whether the distance increases or
+ *  decreases going down the current column of the Levenshtein matrix, so a whole column is updated at once.
+ *
+ *  @see    "A Fast Bit-Vector Algorithm for Approximate String Matching Based on Dynamic Programming" by G. Myers.
+ *  @see    "A Bit-Vector Algorithm for Computing Levenshtein and Damerau Edit Distances" by H. Hyyrö.
  */
-typedef enum {
-    sz_utf8_invalid_k = 0,     //!< Invalid UTF8 character.
-    sz_utf8_rune_1byte_k = 1,  //!< 1-byte UTF8 character.
-    sz_utf8_rune_2bytes_k = 2, //!< 2-byte UTF8 character.
-    sz_utf8_rune_3bytes_k = 3, //!< 3-byte UTF8 character.
-    sz_utf8_rune_4bytes_k = 4, //!< 4-byte UTF8 character.
-} sz_rune_length_t;
+SZ_INTERNAL sz_size_t _sz_edit_distance_myers64_serial( //
+    sz_cptr_t longer, sz_size_t longer_length,          //
+    sz_cptr_t shorter, sz_size_t shorter_length,        //
+    sz_size_t bound) {
 
-typedef sz_u32_t sz_rune_t;
+    sz_assert(shorter_length && shorter_length <= 64 && "The shorter string must fit into a single word.");
+    sz_u8_t const *const longer_bytes = (sz_u8_t const *)longer;
+    sz_u8_t const *const shorter_bytes = (sz_u8_t const *)shorter;
+
+    // Zeroing all the 256 masks would often be more expensive than the rest of the algorithm,
+    // so we only reset the entries, that will actually be accessed.
+    sz_u64_t matches[256];
+    for (sz_size_t i = 0; i != longer_length; ++i) matches[longer_bytes[i]] = 0;
+    for (sz_size_t i = 0; i != shorter_length; ++i) matches[shorter_bytes[i]] = 0;
+    for (sz_size_t i = 0; i != shorter_length; ++i) matches[shorter_bytes[i]] |= (sz_u64_t)1 << i;
+
+    sz_u64_t vertical_positive = ~(sz_u64_t)0, vertical_negative = 0;
+    sz_u64_t const last_bit = (sz_u64_t)1 << (shorter_length - 1);
+    sz_size_t distance = shorter_length;
+    for (sz_size_t i = 0; i != longer_length; ++i) {
+        sz_u64_t match = matches[longer_bytes[i]];
+        sz_u64_t diagonal = (((match & vertical_positive) + vertical_positive) ^ vertical_positive) | match;
+        sz_u64_t vertical_or_match = match | vertical_negative;
+        sz_u64_t horizontal_positive = vertical_negative | ~(diagonal | vertical_positive);
+        sz_u64_t horizontal_negative = vertical_positive & diagonal;
+        distance += (horizontal_positive & last_bit) != 0;
+        distance -= (horizontal_negative & last_bit) != 0;
+        // The first row of the matrix grows by one with every character, so we shift in a positive delta.
+        horizontal_positive = (horizontal_positive << 1) | 1;
+        horizontal_negative = horizontal_negative << 1;
+        vertical_positive = horizontal_negative | ~(vertical_or_match | horizontal_positive);
+        vertical_negative = horizontal_positive & vertical_or_match;
+        // Every remaining character can reduce the distance by one at most.
+        if (bound && distance >= bound + (longer_length - i - 1)) return bound;
+    }
+    return bound ? sz_min_of_two(distance, bound) : distance;
+}
 
 /**
- *  @brief  Extracts just one UTF8 codepoint from a UTF8 string into a 32-bit unsigned integer.
- */
-SZ_INTERNAL void _sz_extract_utf8_rune(sz_cptr_t utf8, sz_rune_t *code, sz_rune_length_t *code_length) {
-    sz_u8_t const *current = (sz_u8_t const *)utf8;
-    sz_u8_t leading_byte = *current++;
-    sz_rune_t ch;
-    sz_rune_length_t ch_length;
-
-    // TODO: This can be made entirely branchless uing 32-bit SWAR.
-    if (leading_byte < 0x80) {
-        // Single-byte rune (0xxxxxxx)
-        ch = leading_byte;
-        ch_length = sz_utf8_rune_1byte_k;
-    }
-    else if ((leading_byte & 0xE0) == 0xC0) {
-        // Two-byte rune (110xxxxx 10xxxxxx)
-        ch = (leading_byte & 0x1F) << 6;
-        ch |= (*current++ & 0x3F);
-        ch_length = sz_utf8_rune_2bytes_k;
-    }
-    else if ((leading_byte & 0xF0) == 0xE0) {
-        // Three-byte rune (1110xxxx 10xxxxxx 10xxxxxx)
-        ch = (leading_byte & 0x0F) << 12;
-        ch |= (*current++ & 0x3F) << 6;
-        ch |= (*current++ & 0x3F);
-        ch_length = sz_utf8_rune_3bytes_k;
-    }
-    else if ((leading_byte & 0xF8) == 0xF0) {
-        // Four-byte rune (11110xxx 10xxxxxx 10xxxxxx 10xxxxxx)
-        ch = (leading_byte & 0x07) << 18;
-        ch |= (*current++ & 0x3F) << 12;
-        ch |= (*current++ & 0x3F) << 6;
-        ch |= (*current++ & 0x3F);
-        ch_length = sz_utf8_rune_4bytes_k;
+ *  @brief  Advances the multi-word state of the bit-parallel Myers-Hyyrö algorithm by one column,
+ *          chaining the horizontal deltas between the consecutive 64-bit words, like carries in long arithmetic.
+ *  @return The horizontal delta of the cell marked by the ::last_bit of the last word: -1, 0, or +1.
+ */
+SZ_INTERNAL int _sz_edit_distance_myers_words_advance( //
+    sz_u64_t *vertical_positives, sz_u64_t *vertical_negatives, sz_u64_t const *matches, sz_size_t words,
+    sz_u64_t last_bit) {
+
+    // The first row of the matrix grows by one with every character, so we shift in a positive delta.
+    sz_u64_t carry_positive = 1, carry_negative = 0;
+    sz_u64_t horizontal_positive = 0, horizontal_negative = 0;
+    for (sz_size_t i = 0; i != words; ++i) {
+        sz_u64_t vertical_positive = vertical_positives[i], vertical_negative = vertical_negatives[i];
+        sz_u64_t match = matches[i];
+        sz_u64_t vertical_or_match = match | vertical_negative;
+        match |= carry_negative;
+        sz_u64_t diagonal = (((match & vertical_positive) + vertical_positive) ^ vertical_positive) | match;
+        horizontal_positive = vertical_negative | ~(diagonal | vertical_positive);
+        horizontal_negative = vertical_positive & diagonal;
+        sz_u64_t shifted_positive = (horizontal_positive << 1) | carry_positive;
+        sz_u64_t shifted_negative = (horizontal_negative << 1) | carry_negative;
+        carry_positive = horizontal_positive >> 63;
+        carry_negative = horizontal_negative >> 63;
+        vertical_positives[i] = shifted_negative | ~(vertical_or_match | shifted_positive);
+        vertical_negatives[i] = shifted_positive & vertical_or_match;
     }
-    else {
-        // Invalid UTF8 rune.
-        ch = 0;
-        ch_length = sz_utf8_invalid_k;
+    return (int)((horizontal_positive & last_bit) != 0) - (int)((horizontal_negative & last_bit) != 0);
+}
+
+/**
+ *  @brief  Computes the Levenshtein distance with the multi-word variant of the bit-parallel Myers-Hyyrö algorithm,
+ *          performing O(longer_length * ⌈shorter_length / 64⌉) word operations.
+ *          Needs `(256 + 2) * ⌈shorter_length / 64⌉` words of memory for the match-masks and the column state.
+ */
+SZ_INTERNAL sz_size_t _sz_edit_distance_myers_words_serial( //
+    sz_cptr_t longer, sz_size_t longer_length,              //
+    sz_cptr_t shorter, sz_size_t shorter_length,            //
+    sz_size_t bound, sz_memory_allocator_t *alloc) {
+
+    sz_assert(shorter_length && "The shorter string can't be empty.");
+    sz_size_t const words = (shorter_length + 63) / 64;
+    sz_size_t const buffer_length = sizeof(sz_u64_t) * words * (256 + 2);
+    sz_u64_t *const matches = (sz_u64_t *)alloc->allocate(buffer_length, alloc->handle);
+    if (!matches) return SZ_SIZE_MAX;
+    sz_u64_t *const vertical_positives = matches + words * 256;
+    sz_u64_t *const vertical_negatives = vertical_positives + words;
+
+    // Unlike the single-word variant, here the table is much larger than the strings it's applied to.
+    sz_u8_t const *const longer_bytes = (sz_u8_t const *)longer;
+    sz_u8_t const *const shorter_bytes = (sz_u8_t const *)shorter;
+    sz_fill_serial((sz_ptr_t)matches, sizeof(sz_u64_t) * words * 256, 0);
+    sz_fill_serial((sz_ptr_t)vertical_positives, sizeof(sz_u64_t) * words, 0xFF);
+    sz_fill_serial((sz_ptr_t)vertical_negatives, sizeof(sz_u64_t) * words, 0);
+    for (sz_size_t i = 0; i != shorter_length; ++i)
+        matches[shorter_bytes[i] * words + i / 64] |= (sz_u64_t)1 << (i % 64);
+
+    sz_u64_t const last_bit = (sz_u64_t)1 << ((shorter_length - 1) % 64);
+    sz_size_t distance = shorter_length;
+    for (sz_size_t i = 0; i != longer_length; ++i) {
+        distance += _sz_edit_distance_myers_words_advance(vertical_positives, vertical_negatives,
+                                                          matches + longer_bytes[i] * words, words, last_bit);
+        if (bound && distance >= bound + (longer_length - i - 1)) {
+            distance = bound;
+            break;
+        }
     }
-    *code = ch;
-    *code_length = ch_length;
+
+    alloc->free(matches, buffer_length, alloc->handle);
+    return bound ? sz_min_of_two(distance, bound) : distance;
 }
 
 /**
- *  @brief  Exports a UTF8 string into a UTF32 buffer.
- *          ! The result is undefined id the UTF8 string is corrputed.
- *  @return The length in the number of codepoints.
+ *  @brief  Upper bound on the scratch space `_sz_edit_distance_myers_utf32_serial` needs,
+ *          when the shorter string has ::shorter_length codepoints.
  */
-SZ_INTERNAL sz_size_t _sz_export_utf8_to_utf32(sz_cptr_t utf8, sz_size_t utf8_length, sz_rune_t *utf32) {
-    sz_cptr_t const end = utf8 + utf8_length;
-    sz_size_t count = 0;
-    sz_rune_length_t rune_length;
-    for (; utf8 != end; utf8 += rune_length, utf32++, count++) _sz_extract_utf8_rune(utf8, utf32, &rune_length);
-    return count;
+SZ_INTERNAL sz_size_t _sz_edit_distance_myers_utf32_buffer_length(sz_size_t shorter_length) {
+    sz_size_t const words = (shorter_length + 63) / 64;
+    return sizeof(sz_u64_t) * words * (shorter_length + 1 + 2) +
+           (sizeof(sz_rune_t) + sizeof(sz_u16_t)) * (shorter_length * 4 + 2);
+}
+
+/**
+ *  @brief  Computes the Levenshtein distance between two UTF32 strings with the bit-parallel Myers-Hyyrö algorithm.
+ *          The codepoints of the shorter string are enumerated with a tiny hash-table, so that the match-masks
+ *          can be stored densely, with the first row of masks reserved for the codepoints absent in it.
+ *  @param  buffer  Scratch space of at least `_sz_edit_distance_myers_utf32_buffer_length(shorter_length)` bytes.
+ */
+SZ_INTERNAL sz_size_t _sz_edit_distance_myers_utf32_serial( //
+    sz_rune_t const *longer, sz_size_t longer_length,       //
+    sz_rune_t const *shorter, sz_size_t shorter_length,     //
+    sz_size_t bound, sz_ptr_t buffer) {
+
+    sz_assert(shorter_length && shorter_length <= 65535 && "The shorter string must be indexable with 16 bits.");
+    sz_size_t const words = (shorter_length + 63) / 64;
+    sz_size_t slots_log = 1;
+    while (((sz_size_t)1 << slots_log) < shorter_length * 2) ++slots_log;
+    sz_size_t const slots = (sz_size_t)1 << slots_log;
+    sz_size_t const masks_length = sizeof(sz_u64_t) * words * (shorter_length + 1 + 2);
+    sz_u64_t *const vertical_positives = (sz_u64_t *)buffer;
+    sz_u64_t *const vertical_negatives = vertical_positives + words;
+    sz_u64_t *const matches = vertical_negatives + words;
+    sz_rune_t *const slots_runes = (sz_rune_t *)(buffer + masks_length);
+    sz_u16_t *const slots_ids = (sz_u16_t *)(slots_runes + slots);
+    sz_fill_serial((sz_ptr_t)vertical_positives, sizeof(sz_u64_t) * words, 0xFF);
+    sz_fill_serial((sz_ptr_t)vertical_negatives, sizeof(sz_u64_t) * words, 0);
+    sz_fill_serial((sz_ptr_t)matches, sizeof(sz_u64_t) * words * (shorter_length + 1), 0);
+    sz_fill_serial((sz_ptr_t)slots_ids, sizeof(sz_u16_t) * slots, 0);
+
+    // Probes the open-addressing table, returning the slot of the rune, or the empty slot where it belongs.
+#define _sz_myers_rune_slot(rune)                                                       \
+    sz_size_t slot = (sz_size_t)((sz_u32_t)((rune) * 0x9E3779B1u) >> (32 - slots_log)); \
+    while (slots_ids[slot] && slots_runes[slot] != (rune)) slot = (slot + 1) & (slots - 1);
+
+    sz_u16_t unique_runes = 0;
+    for (sz_size_t i = 0; i != shorter_length; ++i) {
+        _sz_myers_rune_slot(shorter[i]);
+        if (!slots_ids[slot]) slots_runes[slot] = shorter[i], slots_ids[slot] = ++unique_runes;
+        matches[slots_ids[slot] * words + i / 64] |= (sz_u64_t)1 << (i % 64);
+    }
+
+    sz_u64_t const last_bit = (sz_u64_t)1 << ((shorter_length - 1) % 64);
+    sz_size_t distance = shorter_length;
+    for (sz_size_t i = 0; i != longer_length; ++i) {
+        _sz_myers_rune_slot(longer[i]);
+        distance += _sz_edit_distance_myers_words_advance(vertical_positives, vertical_negatives,
+                                                          matches + slots_ids[slot] * words, words, last_bit);
+        if (bound && distance >= bound + (longer_length - i - 1)) {
+            distance = bound;
+            break;
+        }
+    }
+#undef _sz_myers_rune_slot
+    return bound ? sz_min_of_two(distance, bound) : distance;
 }
 
 /**
@@ -2395,8 +4077,15 @@ SZ_INTERNAL sz_size_t _sz_edit_distance_wagner_fisher_serial( //
 
     // If the strings contain Unicode characters, let's estimate the max character width,
     // and use it to allocate a larger buffer to decode UTF8.
+    // Short strings will have no more codepoints than bytes and will be handled by the bit-parallel algorithm.
+    sz_size_t const min_length = sz_min_of_two(shorter_length, longer_length);
+    sz_bool_t const use_myers = (sz_bool_t)(min_length && min_length <= 512);
     if ((can_be_unicode == sz_true_k) &&
         (sz_isascii(longer, longer_length) == sz_false_k || sz_isascii(shorter, shorter_length) == sz_false_k)) {
+        if (use_myers) {
+            sz_size_t const myers_length = _sz_edit_distance_myers_utf32_buffer_length(min_length);
+            buffer_length = sz_max_of_two(buffer_length, myers_length);
+        }
         buffer_length += (shorter_length + longer_length) * sizeof(sz_rune_t);
     }
     else { can_be_unicode = sz_false_k; }
@@ -2407,13 +4096,25 @@ SZ_INTERNAL sz_size_t _sz_edit_distance_wagner_fisher_serial( //
 
     // Let's export the UTF8 sequence into the newly allocated buffer at the end.
     if (can_be_unicode == sz_true_k) {
-        sz_rune_t *const longer_utf32 = (sz_rune_t *)(buffer + sizeof(_distance_t) * (n * 2));
+        sz_size_t const runes_offset = buffer_length - (shorter_length + longer_length) * sizeof(sz_rune_t);
+        sz_rune_t *const longer_utf32 = (sz_rune_t *)(buffer + runes_offset);
         sz_rune_t *const shorter_utf32 = longer_utf32 + longer_length;
         // Export the UTF8 sequences into the newly allocated buffer.
-        longer_length = _sz_export_utf8_to_utf32(longer, longer_length, longer_utf32);
-        shorter_length = _sz_export_utf8_to_utf32(shorter, shorter_length, shorter_utf32);
+        longer_length = sz_utf8_to_utf32(longer, longer_length, longer_utf32);
+        shorter_length = sz_utf8_to_utf32(shorter, shorter_length, shorter_utf32);
         longer = (sz_cptr_t)longer_utf32;
         shorter = (sz_cptr_t)shorter_utf32;
+
+        // The front of the buffer is large enough for the bit-parallel kernel, if it fits the shorter string.
+        if (use_myers) {
+            sz_size_t result = shorter_length <= longer_length
+                                   ? _sz_edit_distance_myers_utf32_serial(longer_utf32, longer_length, shorter_utf32,
+                                                                          shorter_length, bound, buffer)
+                                   : _sz_edit_distance_myers_utf32_serial(shorter_utf32, shorter_length, longer_utf32,
+                                                                          longer_length, bound, buffer);
+            alloc->free(buffer, buffer_length, alloc->handle);
+            return result;
+        }
     }
 
     // Let's parameterize the core logic for different character types and distance types.
@@ -2503,10 +4204,15 @@ SZ_INTERNAL sz_size_t _sz_edit_distance_wagner_fisher_serial( //
     }
 }
 
-SZ_PUBLIC sz_size_t sz_edit_distance_serial(     //
-    sz_cptr_t longer, sz_size_t longer_length,   //
-    sz_cptr_t shorter, sz_size_t shorter_length, //
-    sz_size_t bound, sz_memory_allocator_t *alloc) {
+/**
+ *  @brief  Orders the two strings by length and skips their matching prefixes and suffixes,
+ *          as those won't affect the edit distance.
+ */
+SZ_INTERNAL void _sz_edit_distance_skip_affixes( //
+    sz_cptr_t *longer_ptr, sz_size_t *longer_length_ptr, sz_cptr_t *shorter_ptr, sz_size_t *shorter_length_ptr) {
+
+    sz_cptr_t longer = *longer_ptr, shorter = *shorter_ptr;
+    sz_size_t longer_length = *longer_length_ptr, shorter_length = *shorter_length_ptr;
 
     // Let's make sure that we use the amount proportional to the
     // number of elements in the shorter string, not the larger.
@@ -2524,6 +4230,17 @@ SZ_PUBLIC sz_size_t sz_edit_distance_serial(     //
          --longer_length, --shorter_length)
         ;
 
+    *longer_ptr = longer, *shorter_ptr = shorter;
+    *longer_length_ptr = longer_length, *shorter_length_ptr = shorter_length;
+}
+
+SZ_PUBLIC sz_size_t sz_edit_distance_serial(     //
+    sz_cptr_t longer, sz_size_t longer_length,   //
+    sz_cptr_t shorter, sz_size_t shorter_length, //
+    sz_size_t bound, sz_memory_allocator_t *alloc) {
+
+    _sz_edit_distance_skip_affixes(&longer, &longer_length, &shorter, &shorter_length);
+
     // Bounded computations may exit early.
     if (bound) {
         // If one of the strings is empty - the edit distance is equal to the length of the other one.
@@ -2534,10 +4251,248 @@ SZ_PUBLIC sz_size_t sz_edit_distance_serial(     //
     }
 
     if (shorter_length == 0) return longer_length; // If no mismatches were found - the distance is zero.
-    if (shorter_length == longer_length && !bound)
-        return _sz_edit_distance_skewed_diagonals_serial(longer, longer_length, shorter, shorter_length, bound, alloc);
-    return _sz_edit_distance_wagner_fisher_serial(longer, longer_length, shorter, shorter_length, bound, sz_false_k,
-                                                  alloc);
+
+    // The bit-parallel algorithm updates 64 cells of the matrix with a handful of word operations,
+    // and for the shortest strings fits entirely on the stack.
+    if (shorter_length <= 64)
+        return _sz_edit_distance_myers64_serial(longer, longer_length, shorter, shorter_length, bound);
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+    return _sz_edit_distance_myers_words_serial(longer, longer_length, shorter, shorter_length, bound, alloc);
+}
+
+/**
+ *  @brief  Upper bound on the scratch space any pairwise edit-distance kernel may request, when one of the strings
+ *          is no longer than ::shorter_length, including the header of the fixed-capacity allocator.
+ */
+SZ_INTERNAL sz_size_t _sz_edit_distance_scratch_length(sz_size_t shorter_length) {
+    sz_size_t const matrix_words = 3 * (shorter_length + 1);
+    sz_size_t const myers_words = (256 + 2) * ((shorter_length + 63) / 64);
+    return sizeof(sz_size_t) * (sz_max_of_two(matrix_words, myers_words) + 1);
+}
+
+SZ_PUBLIC sz_bool_t sz_edit_distances_batch_serial( //
+    sz_cptr_t query, sz_size_t query_length,        //
+    sz_sequence_t const *candidates, sz_size_t bound, sz_size_t *distances, sz_memory_allocator_t *alloc) {
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    // Every pairwise kernel sizes its buffers by the shorter of the two strings, which is never longer than the
+    // query, so a single allocation can be recycled through a fixed-capacity allocator for all the candidates.
+    sz_size_t const buffer_length = _sz_edit_distance_scratch_length(query_length);
+    sz_ptr_t const buffer = (sz_ptr_t)alloc->allocate(buffer_length, alloc->handle);
+    if (!buffer) return sz_false_k;
+    sz_memory_allocator_t scratch;
+    sz_memory_allocator_init_fixed(&scratch, buffer, buffer_length);
+
+    for (sz_size_t i = 0; i != candidates->count; ++i)
+        distances[i] = sz_edit_distance_serial(query, query_length, candidates->get_start(candidates, i),
+                                               candidates->get_length(candidates, i), bound, &scratch);
+
+    alloc->free(buffer, buffer_length, alloc->handle);
+    return sz_true_k;
+}
+
+/**
+ *  @brief  Populates the Bitap match-masks, where the bit `i` in the row of a byte is set, if the `i`-th character
+ *          of the needle is equal to that byte. Every row is ::words long. With ::reverse, the needle is mirrored.
+ */
+SZ_INTERNAL void _sz_find_fuzzy_masks_serial(sz_cptr_t n, sz_size_t n_length, sz_size_t words, sz_bool_t reverse,
+                                             sz_u64_t *matches) {
+    sz_u8_t const *const n_bytes = (sz_u8_t const *)n;
+    sz_fill_serial((sz_ptr_t)matches, sizeof(sz_u64_t) * words * 256, 0);
+    for (sz_size_t i = 0; i != n_length; ++i) {
+        sz_u8_t const byte = n_bytes[reverse ? n_length - i - 1 : i];
+        matches[byte * words + i / 64] |= (sz_u64_t)1 << (i % 64);
+    }
+}
+
+/**
+ *  @brief  Advances the Wu-Manber states by one haystack character. The bit `i` of the state `d` is set, if the
+ *          first `i + 1` characters of the needle match a suffix of the consumed text with at most `d` edits.
+ *          Matching the empty prefix of the needle costs ::empty_before edits before this character and
+ *          ::empty_after after it, which are zeros in the substring search, where any offset may start a match.
+ *
+ *  @param states   `(max_edits + 1) * words` words of the states, updated in-place.
+ *  @param previous `words` words of scratch space, preserving the old state `d - 1`, while updating the state `d`.
+ */
+SZ_INTERNAL void _sz_find_fuzzy_advance_serial(                                                             //
+    sz_u64_t *states, sz_u64_t *previous, sz_u64_t const *matches, sz_size_t words, sz_size_t max_edits, //
+    sz_size_t empty_before, sz_size_t empty_after) {
+
+    for (sz_size_t d = 0; d <= max_edits; ++d) {
+        sz_u64_t *const state = states + d * words;
+        sz_u64_t const *const lower_state = state - words; // Only accessed for `d > 0`.
+        // Every term shifts the prefix lengths by one, moving in the bit of the empty prefix of the needle.
+        sz_u64_t carry_match = empty_before <= d;
+        sz_u64_t carry_substitution = empty_before + 1 <= d;
+        sz_u64_t carry_deletion = empty_after + 1 <= d;
+        for (sz_size_t i = 0; i != words; ++i) {
+            sz_u64_t const current = state[i];
+            sz_u64_t next = ((current << 1) | carry_match) & matches[i];
+            carry_match = current >> 63;
+            if (d) {
+                // Inserting the haystack character keeps the prefix, substituting or deleting extends it.
+                sz_u64_t const lower_old = previous[i], lower_new = lower_state[i];
+                next |= lower_old | (lower_old << 1) | carry_substitution | (lower_new << 1) | carry_deletion;
+                carry_substitution = lower_old >> 63;
+                carry_deletion = lower_new >> 63;
+            }
+            previous[i] = current;
+            state[i] = next;
+        }
+    }
+}
+
+/**
+ *  @brief  Finds the smallest number of edits, not exceeding ::max_edits, at which the whole needle is matched,
+ *          or returns `SZ_SIZE_MAX`. The states are monotonic, so the largest one is checked first.
+ */
+SZ_INTERNAL sz_size_t _sz_find_fuzzy_min_edits_serial(sz_u64_t const *states, sz_size_t words, sz_size_t max_edits,
+                                                      sz_size_t n_length) {
+    sz_size_t const last_word = (n_length - 1) / 64;
+    sz_u64_t const last_bit = (sz_u64_t)1 << ((n_length - 1) % 64);
+    if (!(states[max_edits * words + last_word] & last_bit)) return SZ_SIZE_MAX;
+    sz_size_t d = 0;
+    while (!(states[d * words + last_word] & last_bit)) ++d;
+    return d;
+}
+
+/**
+ *  @brief  Given the end of an approximate match with the known minimal number of edits, finds its shortest start,
+ *          running the Wu-Manber algorithm backwards with the mirrored needle, anchored at the end of the match.
+ *  @param  buffer  At least `(256 + edits + 2) * words` words of scratch space.
+ */
+SZ_INTERNAL sz_size_t _sz_find_fuzzy_start_serial(sz_cptr_t h, sz_size_t end, sz_cptr_t n, sz_size_t n_length,
+                                                  sz_size_t edits, sz_u64_t *buffer) {
+
+    // Even an empty substring is within `n_length` deletions from the needle.
+    if (edits >= n_length) return end;
+    sz_size_t const words = (n_length + 63) / 64;
+    sz_u64_t *const matches = buffer;
+    sz_u64_t *const previous = matches + 256 * words;
+    sz_u64_t *const states = previous + words;
+    _sz_find_fuzzy_masks_serial(n, n_length, words, sz_true_k, matches);
+
+    // Before consuming any characters, the prefixes of up to `d` characters are matched with `d` deletions.
+    sz_fill_serial((sz_ptr_t)states, sizeof(sz_u64_t) * words * (edits + 1), 0);
+    for (sz_size_t d = 1; d <= edits; ++d)
+        for (sz_size_t i = 0; i != d; ++i) states[d * words + i / 64] |= (sz_u64_t)1 << (i % 64);
+
+    sz_u8_t const *const h_bytes = (sz_u8_t const *)h;
+    sz_size_t const last_word = (n_length - 1) / 64;
+    sz_u64_t const last_bit = (sz_u64_t)1 << ((n_length - 1) % 64);
+    sz_size_t consumed = 0;
+    for (; consumed != end; ++consumed) {
+        _sz_find_fuzzy_advance_serial(states, previous, matches + h_bytes[end - consumed - 1] * words, words, edits,
+                                      consumed, consumed + 1);
+        if (states[edits * words + last_word] & last_bit) break;
+    }
+    sz_assert(consumed != end && "The forward pass has already confirmed the match.");
+    return end - consumed - 1;
+}
+
+/**
+ *  @brief  Finds the end of the first approximate match with the multi-word Wu-Manber algorithm, extending it
+ *          while the following characters reduce the number of edits.
+ *  @param  buffer  At least `(256 + max_edits + 2) * words` words of scratch space.
+ *  @return The offset past the last matched byte, or `SZ_SIZE_MAX` if nothing matches.
+ */
+SZ_INTERNAL sz_size_t _sz_find_fuzzy_end_serial(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length,
+                                                sz_size_t max_edits, sz_u64_t *buffer, sz_size_t *match_edits) {
+
+    sz_size_t const words = (n_length + 63) / 64;
+    sz_u64_t *const matches = buffer;
+    sz_u64_t *const previous = matches + 256 * words;
+    sz_u64_t *const states = previous + words;
+    _sz_find_fuzzy_masks_serial(n, n_length, words, sz_false_k, matches);
+
+    // Before consuming any characters, the prefixes of up to `d` characters are matched with `d` deletions.
+    sz_fill_serial((sz_ptr_t)states, sizeof(sz_u64_t) * words * (max_edits + 1), 0);
+    for (sz_size_t d = 1; d <= max_edits; ++d)
+        for (sz_size_t i = 0; i != d; ++i) states[d * words + i / 64] |= (sz_u64_t)1 << (i % 64);
+
+    sz_u8_t const *const h_bytes = (sz_u8_t const *)h;
+    sz_size_t end = SZ_SIZE_MAX;
+    sz_size_t edits = _sz_find_fuzzy_min_edits_serial(states, words, max_edits, n_length);
+    if (edits != SZ_SIZE_MAX) end = 0;
+
+    // Most needles fit into a single word, where we can skip the carries and check the hits on the fly.
+    if (words == 1) {
+        sz_u64_t const last_bit = (sz_u64_t)1 << (n_length - 1);
+        for (sz_size_t i = 0; i != h_length && edits; ++i) {
+            sz_u64_t const match = matches[h_bytes[i]];
+            sz_u64_t lower_old = states[0];
+            sz_u64_t lower_new = ((lower_old << 1) | 1) & match;
+            states[0] = lower_new;
+            sz_size_t new_edits = (lower_new & last_bit) ? 0 : SZ_SIZE_MAX;
+            for (sz_size_t d = 1; d <= max_edits; ++d) {
+                sz_u64_t const current = states[d];
+                sz_u64_t const next = (((current << 1) | 1) & match) | lower_old | ((lower_old | lower_new) << 1) | 1;
+                states[d] = next;
+                if (new_edits == SZ_SIZE_MAX && (next & last_bit)) new_edits = d;
+                lower_old = current, lower_new = next;
+            }
+            if (new_edits < edits) end = i + 1, edits = new_edits;
+            else if (end != SZ_SIZE_MAX) break;
+        }
+        *match_edits = edits;
+        return end;
+    }
+
+    for (sz_size_t i = 0; i != h_length && edits; ++i) {
+        _sz_find_fuzzy_advance_serial(states, previous, matches + h_bytes[i] * words, words, max_edits, 0, 0);
+        sz_size_t const new_edits = _sz_find_fuzzy_min_edits_serial(states, words, max_edits, n_length);
+        if (new_edits < edits) end = i + 1, edits = new_edits;
+        // Once the match is found, keep going only while the following characters reduce the number of edits.
+        else if (end != SZ_SIZE_MAX) break;
+    }
+    *match_edits = edits;
+    return end;
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_fuzzy_serial(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length, //
+                                         sz_size_t max_edits, sz_memory_allocator_t *alloc, sz_size_t *match_length) {
+
+    sz_size_t unused_length;
+    if (!match_length) match_length = &unused_length;
+    *match_length = 0;
+    if (!n_length) return SZ_NULL_CHAR;
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    // More edits than the needle length behave just like `n_length` edits.
+    max_edits = sz_min_of_two(max_edits, n_length);
+    sz_size_t const words = (n_length + 63) / 64;
+    sz_size_t const buffer_length = sizeof(sz_u64_t) * words * (256 + max_edits + 2);
+    sz_u64_t *const buffer = (sz_u64_t *)alloc->allocate(buffer_length, alloc->handle);
+    if (!buffer) {
+        *match_length = SZ_SIZE_MAX;
+        return SZ_NULL_CHAR;
+    }
+
+    sz_size_t edits;
+    sz_size_t const end = _sz_find_fuzzy_end_serial(h, h_length, n, n_length, max_edits, buffer, &edits);
+    sz_size_t const start = end != SZ_SIZE_MAX ? _sz_find_fuzzy_start_serial(h, end, n, n_length, edits, buffer) : 0;
+    alloc->free(buffer, buffer_length, alloc->handle);
+    if (end == SZ_SIZE_MAX) return SZ_NULL_CHAR;
+    *match_length = end - start;
+    return h + start;
 }
 
 SZ_PUBLIC sz_ssize_t sz_alignment_score_serial(       //
@@ -2625,7 +4580,8 @@ SZ_PUBLIC sz_ssize_t sz_alignment_score_serial(       //
 #define _sz_hash_mix(first, second) ((first * 11400714819323198485ull) ^ (second * 11400714819323198485ull))
 #define _sz_shift_low(x) (x)
 #define _sz_shift_high(x) ((x + 77ull) & 0xFFull)
-#define _sz_prime_mod(x) (x % SZ_U64_MAX_PRIME)
+// Any 64-bit value is below twice the prime, so the modulo is just a conditional subtraction.
+#define _sz_prime_mod(x) ((x) >= SZ_U64_MAX_PRIME ? (x) - SZ_U64_MAX_PRIME : (x))
 
 SZ_PUBLIC sz_u64_t sz_hash_serial(sz_cptr_t start, sz_size_t length) {
 
@@ -2738,6 +4694,34 @@ SZ_PUBLIC sz_u64_t sz_hash_serial(sz_cptr_t start, sz_size_t length) {
     return _sz_hash_mix(hash_low, hash_high);
 }
 
+SZ_PUBLIC void sz_hash_batch_serial(sz_sequence_t const *sequence, sz_u64_t *hashes) {
+    for (sz_size_t i = 0; i != sequence->count; ++i)
+        hashes[i] = sz_hash_serial(sequence->get_start(sequence, i), sequence->get_length(sequence, i));
+}
+
+/**
+ *  @brief  Loads the next up to 8 bytes of a string starting from ::offset, used by the SIMD `sz_hash_batch`
+ *          kernels. The first byte lands in the lowest byte of the result, the missing bytes are zeros.
+ */
+SZ_INTERNAL sz_u64_t _sz_hash_batch_load(sz_u8_t const *start, sz_size_t length, sz_size_t offset) {
+    if (offset >= length) return 0;
+    sz_size_t const remaining = length - offset;
+    start += offset;
+#if SZ_USE_MISALIGNED_LOADS && !SZ_DETECT_BIG_ENDIAN
+    // Short tails are assembled from two overlapping loads, as the overlapping bytes are identical.
+    if (remaining >= 8) return sz_u64_load((sz_cptr_t)start).u64;
+    if (remaining >= 4)
+        return (sz_u64_t)sz_u32_load((sz_cptr_t)start).u32 |
+               ((sz_u64_t)sz_u32_load((sz_cptr_t)start + remaining - 4).u32 << ((remaining - 4) * 8));
+    return (sz_u64_t)start[0] | ((sz_u64_t)start[remaining / 2] << (remaining / 2 * 8)) |
+           ((sz_u64_t)start[remaining - 1] << ((remaining - 1) * 8));
+#else
+    sz_u64_t word = 0;
+    for (sz_size_t j = 0; j != 8 && j < remaining; ++j) word |= (sz_u64_t)start[j] << (j * 8);
+    return word;
+#endif
+}
+
 SZ_PUBLIC void sz_hashes_serial(sz_cptr_t start, sz_size_t length, sz_size_t window_length, sz_size_t step, //
                                 sz_hash_callback_t callback, void *callback_handle) {
 
@@ -2783,13 +4767,241 @@ SZ_PUBLIC void sz_hashes_serial(sz_cptr_t start, sz_size_t length, sz_size_t win
     }
 }
 
+/**
+ *  @brief  State of a rolling hash of one window length, used by the `sz_hashes_sketch` kernels,
+ *          that produce the hashes of all windows of a few different lengths in the same sweep.
+ */
+typedef struct {
+    sz_size_t window_length;
+    sz_size_t next_start; /// Offset of the next window to hash.
+    sz_u64_t hash_low, hash_high;
+    sz_u64_t prime_power_low, prime_power_high;
+} _sz_hashes_rolling_t;
+
+SZ_INTERNAL void _sz_hashes_rolling_init(_sz_hashes_rolling_t *rolling, sz_size_t window_length) {
+    rolling->window_length = window_length;
+    rolling->next_start = 0;
+    rolling->hash_low = rolling->hash_high = 0;
+    rolling->prime_power_low = rolling->prime_power_high = 1;
+    for (sz_size_t i = 0; i + 1 < window_length; ++i)
+        rolling->prime_power_low = (rolling->prime_power_low * 31ull) % SZ_U64_MAX_PRIME,
+        rolling->prime_power_high = (rolling->prime_power_high * 257ull) % SZ_U64_MAX_PRIME;
+}
+
+/**
+ *  @brief  Exports the next up to @p capacity window hashes, identical to the ones `sz_hashes_serial` reports.
+ *  @return Number of exported hashes, zero if all windows are exhausted.
+ */
+SZ_INTERNAL sz_size_t _sz_hashes_rolling_next(_sz_hashes_rolling_t *rolling, sz_u8_t const *text, sz_size_t length,
+                                              sz_u64_t *hashes, sz_size_t capacity) {
+    sz_size_t const window_length = rolling->window_length;
+    if (!window_length || length < window_length) return 0;
+    sz_size_t const windows_count = length - window_length + 1;
+    sz_size_t exported = 0;
+    sz_u64_t hash_low = rolling->hash_low, hash_high = rolling->hash_high;
+
+    // The first window is hashed from scratch.
+    if (rolling->next_start == 0 && capacity) {
+        for (sz_size_t i = 0; i != window_length; ++i)
+            hash_low = (hash_low * 31ull + _sz_shift_low(text[i])) % SZ_U64_MAX_PRIME,
+            hash_high = (hash_high * 257ull + _sz_shift_high(text[i])) % SZ_U64_MAX_PRIME;
+        hashes[exported++] = _sz_hash_mix(hash_low, hash_high);
+        rolling->next_start = 1;
+    }
+
+    // Every following window discards one character and adds a new one.
+    for (; exported != capacity && rolling->next_start != windows_count; ++exported, ++rolling->next_start) {
+        sz_u8_t const dropped = text[rolling->next_start - 1];
+        sz_u8_t const added = text[rolling->next_start + window_length - 1];
+        hash_low -= _sz_shift_low(dropped) * rolling->prime_power_low;
+        hash_high -= _sz_shift_high(dropped) * rolling->prime_power_high;
+        hash_low = 31ull * hash_low + _sz_shift_low(added);
+        hash_high = 257ull * hash_high + _sz_shift_high(added);
+        hash_low = _sz_prime_mod(hash_low);
+        hash_high = _sz_prime_mod(hash_high);
+        hashes[exported] = _sz_hash_mix(hash_low, hash_high);
+    }
+
+    rolling->hash_low = hash_low, rolling->hash_high = hash_high;
+    return exported;
+}
+
+/**
+ *  @brief  SplitMix64 finalizer, used to derive the MinHash permutations from their indices.
+ *          The `i`-th permutation uses `_sz_splitmix64(2 * i) | 1` as the multiplier,
+ *          and `_sz_splitmix64(2 * i + 1)` as the mask.
+ */
+SZ_INTERNAL sz_u64_t _sz_splitmix64(sz_u64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+SZ_PUBLIC void sz_hashes_sketch_serial(sz_cptr_t text, sz_size_t length, sz_size_t const *window_lengths,
+                                       sz_size_t windows_count, sz_size_t permutations_count, sz_u64_t *min_hashes,
+                                       sz_u64_t *sim_hashes) {
+
+    if (min_hashes)
+        for (sz_size_t i = 0; i != windows_count * permutations_count; ++i) min_hashes[i] = SZ_U64_MAX;
+
+    // Up to 4 window lengths are hashed in the same sweep, buffering the hashes for 64 consecutive windows.
+    for (sz_size_t group_start = 0; group_start < windows_count; group_start += 4) {
+        sz_size_t const group_size = sz_min_of_two(windows_count - group_start, 4);
+        _sz_hashes_rolling_t rollings[4];
+        sz_u64_t ones[4][64], totals[4];
+        sz_u64_t hashes[64];
+        for (sz_size_t g = 0; g != group_size; ++g) {
+            _sz_hashes_rolling_init(&rollings[g], window_lengths[group_start + g]);
+            for (sz_size_t bit = 0; bit != 64; ++bit) ones[g][bit] = 0;
+            totals[g] = 0;
+        }
+
+        for (sz_bool_t has_more = sz_true_k; has_more;) {
+            has_more = sz_false_k;
+            for (sz_size_t g = 0; g != group_size; ++g) {
+                sz_size_t const count =
+                    _sz_hashes_rolling_next(&rollings[g], (sz_u8_t const *)text, length, hashes, 64);
+                if (!count) continue;
+                has_more = sz_true_k;
+
+                if (min_hashes) {
+                    sz_u64_t *window_min_hashes = min_hashes + (group_start + g) * permutations_count;
+                    for (sz_size_t p = 0; p != permutations_count; ++p) {
+                        sz_u64_t const multiplier = _sz_splitmix64(2 * p) | 1ull;
+                        sz_u64_t const mask = _sz_splitmix64(2 * p + 1);
+                        sz_u64_t min_hash = window_min_hashes[p];
+                        for (sz_size_t i = 0; i != count; ++i) {
+                            sz_u64_t permuted = (hashes[i] ^ mask) * multiplier;
+                            permuted ^= permuted >> 32;
+                            min_hash = permuted < min_hash ? permuted : min_hash;
+                        }
+                        window_min_hashes[p] = min_hash;
+                    }
+                }
+                if (sim_hashes) {
+                    for (sz_size_t i = 0; i != count; ++i)
+                        for (sz_size_t bit = 0; bit != 64; ++bit) ones[g][bit] += (hashes[i] >> bit) & 1ull;
+                    totals[g] += count;
+                }
+            }
+        }
+
+        // Every bit of the SimHash is the majority vote of the window hashes.
+        if (sim_hashes)
+            for (sz_size_t g = 0; g != group_size; ++g) {
+                sz_u64_t sim_hash = 0;
+                for (sz_size_t bit = 0; bit != 64; ++bit) sim_hash |= (sz_u64_t)(ones[g][bit] * 2 > totals[g]) << bit;
+                sim_hashes[group_start + g] = sim_hash;
+            }
+    }
+}
+
 #undef _sz_shift_low
 #undef _sz_shift_high
 #undef _sz_hash_mix
 #undef _sz_prime_mod
 
 /**
- *  @brief  Uses a small lookup-table to convert a lowercase character to uppercase.
+ *  @brief  Checks if the first fingerprint match should be ranked before the second one. The Jaccard ratios are
+ *          compared by cross-multiplication, to avoid floating-point divisions, and the ties are broken by the ::id.
+ */
+SZ_INTERNAL sz_bool_t _sz_fingerprint_match_better(sz_fingerprint_match_t const *a, sz_fingerprint_match_t const *b,
+                                                   sz_fingerprint_metric_t metric) {
+    if (metric == sz_fingerprint_hamming_k) {
+        sz_u32_t const a_distance = a->union_size - a->intersection, b_distance = b->union_size - b->intersection;
+        if (a_distance != b_distance) return (sz_bool_t)(a_distance < b_distance);
+    }
+    else {
+        // Two empty fingerprints are identical, so let's treat `0 / 0` as `1 / 1`.
+        sz_u64_t const a_union = a->union_size ? a->union_size : 1, b_union = b->union_size ? b->union_size : 1;
+        sz_u64_t const a_intersection = a->union_size ? a->intersection : 1;
+        sz_u64_t const b_intersection = b->union_size ? b->intersection : 1;
+        sz_u64_t const a_score = a_intersection * b_union, b_score = b_intersection * a_union;
+        if (a_score != b_score) return (sz_bool_t)(a_score > b_score);
+    }
+    return (sz_bool_t)(a->id < b->id);
+}
+
+/**
+ *  @brief  Restores the order of a bounded heap, where every parent is ranked after its children,
+ *          so the root is the worst of the retained matches and is the first to be replaced.
+ */
+SZ_INTERNAL void _sz_fingerprint_heap_sift_down(sz_fingerprint_match_t *heap, sz_size_t size, sz_size_t i,
+                                                sz_fingerprint_metric_t metric) {
+    sz_fingerprint_match_t const sifted = heap[i];
+    for (sz_size_t child = 2 * i + 1; child < size; i = child, child = 2 * i + 1) {
+        if (child + 1 < size && _sz_fingerprint_match_better(&heap[child], &heap[child + 1], metric)) ++child;
+        if (!_sz_fingerprint_match_better(&sifted, &heap[child], metric)) break;
+        heap[i] = heap[child];
+    }
+    heap[i] = sifted;
+}
+
+/**
+ *  @brief  Adds a candidate to a heap of at most @p k matches, evicting the worst one, if it's full.
+ */
+SZ_INTERNAL void _sz_fingerprint_heap_push(sz_fingerprint_match_t *heap, sz_size_t *size, sz_size_t k,
+                                           sz_fingerprint_match_t const *candidate, sz_fingerprint_metric_t metric) {
+    if (*size < k) {
+        sz_size_t i = (*size)++;
+        for (; i && _sz_fingerprint_match_better(&heap[(i - 1) / 2], candidate, metric); i = (i - 1) / 2)
+            heap[i] = heap[(i - 1) / 2];
+        heap[i] = *candidate;
+    }
+    else if (_sz_fingerprint_match_better(candidate, &heap[0], metric)) {
+        heap[0] = *candidate;
+        _sz_fingerprint_heap_sift_down(heap, *size, 0, metric);
+    }
+}
+
+/**
+ *  @brief  Sorts the heap in-place from the best match to the worst one, repeatedly moving the root to the back.
+ */
+SZ_INTERNAL void _sz_fingerprint_heap_sort(sz_fingerprint_match_t *heap, sz_size_t size,
+                                           sz_fingerprint_metric_t metric) {
+    for (; size > 1; --size) {
+        sz_fingerprint_match_t const worst = heap[0];
+        heap[0] = heap[size - 1];
+        heap[size - 1] = worst;
+        _sz_fingerprint_heap_sift_down(heap, size - 1, 0, metric);
+    }
+}
+
+SZ_PUBLIC sz_size_t sz_fingerprints_top_k_serial(sz_cptr_t query, sz_cptr_t fingerprints, sz_size_t fingerprint_bytes,
+                                                 sz_sorted_idx_t const *ids, sz_size_t count, sz_size_t k,
+                                                 sz_fingerprint_metric_t metric, sz_fingerprint_match_t *matches) {
+    sz_size_t size = 0;
+    if (!k) return 0;
+    for (sz_size_t i = 0; i != count; ++i) {
+        sz_fingerprint_match_t candidate;
+        candidate.id = ids ? (sz_size_t)ids[i] : i;
+        sz_cptr_t const fingerprint = fingerprints + candidate.id * fingerprint_bytes;
+
+        // Count the bits in 64-bit words, and then in the remaining bytes, if any.
+        sz_size_t intersection = 0, union_size = 0, j = 0;
+        for (; j + 8 <= fingerprint_bytes; j += 8) {
+            sz_u64_t const query_word = sz_u64_load(query + j).u64, fingerprint_word = sz_u64_load(fingerprint + j).u64;
+            intersection += sz_u64_popcount(query_word & fingerprint_word);
+            union_size += sz_u64_popcount(query_word | fingerprint_word);
+        }
+        for (; j != fingerprint_bytes; ++j) {
+            sz_u8_t const query_byte = (sz_u8_t)query[j], fingerprint_byte = (sz_u8_t)fingerprint[j];
+            intersection += sz_u64_popcount(query_byte & fingerprint_byte);
+            union_size += sz_u64_popcount(query_byte | fingerprint_byte);
+        }
+
+        candidate.intersection = (sz_u32_t)intersection;
+        candidate.union_size = (sz_u32_t)union_size;
+        _sz_fingerprint_heap_push(matches, &size, k, &candidate, metric);
+    }
+    _sz_fingerprint_heap_sort(matches, size, metric);
+    return size;
+}
+
+/**
+ *  @brief  Uses a small lookup-table to convert an uppercase character to lowercase.
+ *          Maps the [65, 90] ASCII and [192, 222] Latin-1 ranges, except for 215 - the multiplication sign.
  */
 SZ_INTERNAL sz_u8_t sz_u8_tolower(sz_u8_t c) {
     static sz_u8_t const lowered[256] = {
@@ -2814,7 +5026,9 @@ SZ_INTERNAL sz_u8_t sz_u8_tolower(sz_u8_t c) {
 }
 
 /**
- *  @brief  Uses a small lookup-table to convert an uppercase character to lowercase.
+ *  @brief  Uses a small lookup-table to convert a lowercase character to uppercase.
+ *          Maps the [97, 122] ASCII and [224, 254] Latin-1 ranges, except for 247 - the division sign.
+ *          The 223 sharp S and the 255 Y with diaeresis have no single-byte uppercase forms and are kept.
  */
 SZ_INTERNAL sz_u8_t sz_u8_toupper(sz_u8_t c) {
     static sz_u8_t const upped[256] = {
@@ -2822,18 +5036,18 @@ SZ_INTERNAL sz_u8_t sz_u8_toupper(sz_u8_t c) {
         16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  //
         32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  //
         48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  //
-        64,  97,  98,  99,  100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, //
-        112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 91,  92,  93,  94,  95,  //
+        64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  //
+        80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,  93,  94,  95,  //
         96,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  //
         80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  123, 124, 125, 126, 127, //
         128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, //
         144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, //
         160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, //
         176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, //
-        224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, //
-        240, 241, 242, 243, 244, 245, 246, 215, 248, 249, 250, 251, 252, 253, 254, 223, //
-        224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, //
-        240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255, //
+        192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, //
+        208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, //
+        192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, //
+        208, 209, 210, 211, 212, 213, 214, 247, 216, 217, 218, 219, 220, 221, 222, 255, //
     };
     return upped[c];
 }
@@ -2904,6 +5118,14 @@ SZ_PUBLIC void sz_toascii_serial(sz_cptr_t text, sz_size_t length, sz_ptr_t resu
     for (; unsigned_text != end; ++unsigned_text, ++unsigned_result) *unsigned_result = *unsigned_text & 0x7F;
 }
 
+SZ_PUBLIC void sz_translate_serial(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result) {
+    sz_u8_t *unsigned_result = (sz_u8_t *)result;
+    sz_u8_t const *unsigned_text = (sz_u8_t const *)text;
+    sz_u8_t const *unsigned_lut = (sz_u8_t const *)lut;
+    sz_u8_t const *end = unsigned_text + length;
+    for (; unsigned_text != end; ++unsigned_text, ++unsigned_result) *unsigned_result = unsigned_lut[*unsigned_text];
+}
+
 /**
  *  @brief  Check if there is a byte in this buffer, that exceeds 127 and can't be an ASCII character.
  *          This implementation uses hardware-agnostic SWAR technique, to process 8 characters at a time.
@@ -2933,6 +5155,148 @@ SZ_PUBLIC sz_bool_t sz_isascii_serial(sz_cptr_t text, sz_size_t length) {
     return sz_true_k;
 }
 
+SZ_PUBLIC sz_bool_t sz_utf8_valid_serial(sz_cptr_t text, sz_size_t length) {
+    sz_u8_t const *h = (sz_u8_t const *)text;
+    sz_u8_t const *const h_end = h + length;
+
+    while (h != h_end) {
+        // Skip ASCII runs eight bytes at a time.
+        if (h + 8 <= h_end && !(sz_u64_load((sz_cptr_t)h).u64 & 0x8080808080808080ull)) {
+            h += 8;
+            continue;
+        }
+        sz_u8_t const lead = *h;
+        if (lead < 0x80) {
+            ++h;
+            continue;
+        }
+
+        // The second byte has the narrowest range, following the Unicode Table 3-7.
+        sz_size_t rune_length;
+        sz_u8_t second_min = 0x80, second_max = 0xBF;
+        if (lead < 0xC2) return sz_false_k; // Continuation bytes and overlong 2-byte runes.
+        else if (lead < 0xE0) { rune_length = 2; }
+        else if (lead < 0xF0) {
+            rune_length = 3;
+            if (lead == 0xE0) second_min = 0xA0;      // Overlong 3-byte runes.
+            else if (lead == 0xED) second_max = 0x9F; // Surrogates.
+        }
+        else if (lead < 0xF5) {
+            rune_length = 4;
+            if (lead == 0xF0) second_min = 0x90;      // Overlong 4-byte runes.
+            else if (lead == 0xF4) second_max = 0x8F; // Codepoints beyond U+10FFFF.
+        }
+        else { return sz_false_k; }
+
+        if ((sz_size_t)(h_end - h) < rune_length) return sz_false_k;
+        if (h[1] < second_min || h[1] > second_max) return sz_false_k;
+        for (sz_size_t i = 2; i < rune_length; ++i)
+            if ((h[i] & 0xC0) != 0x80) return sz_false_k;
+        h += rune_length;
+    }
+    return sz_true_k;
+}
+
+/**
+ *  @brief  Marks the continuation bytes `10xxxxxx` in a 64-bit word with their top bits.
+ */
+SZ_INTERNAL sz_u64_t _sz_u64_utf8_continuations(sz_u64_t x) {
+    return x & ~(x << 1) & 0x8080808080808080ull;
+}
+
+SZ_PUBLIC sz_size_t sz_utf8_count_serial(sz_cptr_t text, sz_size_t length) {
+    sz_u8_t const *h = (sz_u8_t const *)text;
+    sz_u8_t const *const h_end = h + length;
+    sz_size_t continuations = 0;
+    for (; h + 8 <= h_end; h += 8)
+        continuations += sz_u64_popcount(_sz_u64_utf8_continuations(sz_u64_load((sz_cptr_t)h).u64));
+    for (; h != h_end; ++h) continuations += (*h & 0xC0) == 0x80;
+    return length - continuations;
+}
+
+SZ_PUBLIC sz_cptr_t sz_utf8_find_nth_serial(sz_cptr_t text, sz_size_t length, sz_size_t n) {
+    sz_u8_t const *h = (sz_u8_t const *)text;
+    sz_u8_t const *const h_end = h + length;
+
+    // Skip whole words, if the rune is further away.
+    for (; h + 8 <= h_end; h += 8) {
+        sz_size_t runes = 8 - sz_u64_popcount(_sz_u64_utf8_continuations(sz_u64_load((sz_cptr_t)h).u64));
+        if (runes > n) break;
+        n -= runes;
+    }
+    for (; h != h_end; ++h) {
+        if ((*h & 0xC0) == 0x80) continue;
+        if (!n) return (sz_cptr_t)h;
+        --n;
+    }
+    return SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC sz_size_t sz_utf8_to_utf32_serial(sz_cptr_t text, sz_size_t length, sz_rune_t *runes) {
+    sz_u8_t const *h = (sz_u8_t const *)text;
+    sz_u8_t const *const h_end = h + length;
+    sz_rune_t *const runes_start = runes;
+
+    while (h != h_end) {
+        // Widen ASCII runs eight bytes at a time.
+        if (h + 8 <= h_end && !(sz_u64_load((sz_cptr_t)h).u64 & 0x8080808080808080ull)) {
+            for (sz_size_t i = 0; i != 8; ++i) runes[i] = h[i];
+            h += 8, runes += 8;
+            continue;
+        }
+
+        // Corrupted inputs may contain stray continuation bytes, that don't start a rune.
+        sz_u8_t const lead = *h++;
+        if ((lead & 0xC0) == 0x80) continue;
+
+        // Each rune is terminated by the expected number of bytes, the first non-continuation, or the end.
+        sz_size_t const rune_length = 1 + (lead >= 0xC0) + (lead >= 0xE0) + (lead >= 0xF0);
+        sz_rune_t rune = lead & (0x7Fu >> (rune_length > 1 ? rune_length : 0));
+        for (sz_size_t i = 1; i != rune_length && h != h_end && (*h & 0xC0) == 0x80; ++i, ++h)
+            rune = (rune << 6) | (*h & 0x3F);
+        *runes++ = rune;
+    }
+    return (sz_size_t)(runes - runes_start);
+}
+
+/**
+ *  @brief  Picks the bit to be set in haystack characters before comparing them to a folded needle character.
+ *          Letters differ from their other case only in the 5th bit, so this is a cheap SIMD-friendly filter,
+ *          that never misses a match, but may pass a few non-letters, later rejected by the full comparison.
+ */
+SZ_INTERNAL sz_u8_t _sz_case_insensitive_filter_bit(sz_u8_t folded) {
+    return sz_u8_toupper(folded) != folded ? 0x20 : 0x00;
+}
+
+/**
+ *  @brief  Compares two strings of equal length, folding the case of both with ::sz_u8_tolower.
+ */
+SZ_INTERNAL sz_bool_t _sz_equal_case_insensitive_serial(sz_cptr_t a, sz_cptr_t b, sz_size_t length) {
+    sz_u8_t const *a_unsigned = (sz_u8_t const *)a;
+    sz_u8_t const *b_unsigned = (sz_u8_t const *)b;
+    sz_u8_t const *const a_end = a_unsigned + length;
+    for (; a_unsigned != a_end; ++a_unsigned, ++b_unsigned)
+        if (sz_u8_tolower(*a_unsigned) != sz_u8_tolower(*b_unsigned)) return sz_false_k;
+    return sz_true_k;
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_case_insensitive_serial(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n,
+                                                    sz_size_t n_length) {
+
+    // This almost never fires, but it's better to be safe than sorry.
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+
+    // Compare the first and the last characters before checking the rest of the needle.
+    sz_u8_t const n_first = sz_u8_tolower((sz_u8_t)n[0]);
+    sz_u8_t const n_last = sz_u8_tolower((sz_u8_t)n[n_length - 1]);
+    sz_cptr_t const h_end = h + h_length - n_length + 1;
+    for (; h != h_end; ++h)
+        if (sz_u8_tolower((sz_u8_t)h[0]) == n_first && sz_u8_tolower((sz_u8_t)h[n_length - 1]) == n_last &&
+            _sz_equal_case_insensitive_serial(h + 1, n + 1, n_length - 1))
+            return h;
+    return SZ_NULL_CHAR;
+}
+
 SZ_PUBLIC void sz_generate(sz_cptr_t alphabet, sz_size_t alphabet_size, sz_ptr_t result, sz_size_t result_length,
                            sz_random_generator_t generator, void *generator_user_data) {
 
@@ -3256,48 +5620,231 @@ SZ_PUBLIC void sz_merge(sz_sequence_t *sequence, sz_size_t partition, sz_sequenc
     }
 }
 
-SZ_PUBLIC void sz_sort_insertion(sz_sequence_t *sequence, sz_sequence_comparator_t less) {
-    sz_u64_t *keys = sequence->order;
-    sz_size_t keys_count = sequence->count;
-    for (sz_size_t i = 1; i < keys_count; i++) {
-        sz_u64_t i_key = keys[i];
-        sz_size_t j = i;
-        for (; j > 0 && less(sequence, i_key, keys[j - 1]); --j) keys[j] = keys[j - 1];
-        keys[j] = i_key;
-    }
+SZ_INTERNAL sz_cptr_t _sz_sequence_u32tape_get_start(sz_sequence_t const *sequence, sz_size_t i) {
+    sz_tape_t const *tape = (sz_tape_t const *)sequence->handle;
+    return tape->data + ((sz_u32_t const *)tape->offsets)[i];
 }
 
-SZ_INTERNAL void _sz_sift_down(sz_sequence_t *sequence, sz_sequence_comparator_t less, sz_u64_t *order, sz_size_t start,
-                               sz_size_t end) {
-    sz_size_t root = start;
-    while (2 * root + 1 <= end) {
-        sz_size_t child = 2 * root + 1;
-        if (child + 1 <= end && less(sequence, order[child], order[child + 1])) { child++; }
-        if (!less(sequence, order[root], order[child])) { return; }
-        sz_u64_swap(order + root, order + child);
-        root = child;
-    }
+SZ_INTERNAL sz_size_t _sz_sequence_u32tape_get_length(sz_sequence_t const *sequence, sz_size_t i) {
+    sz_u32_t const *offsets = (sz_u32_t const *)((sz_tape_t const *)sequence->handle)->offsets;
+    return offsets[i + 1] - offsets[i];
 }
 
-SZ_INTERNAL void _sz_heapify(sz_sequence_t *sequence, sz_sequence_comparator_t less, sz_u64_t *order, sz_size_t count) {
-    sz_size_t start = (count - 2) / 2;
-    while (1) {
-        _sz_sift_down(sequence, less, order, start, count - 1);
-        if (start == 0) return;
-        start--;
-    }
+SZ_INTERNAL sz_cptr_t _sz_sequence_u64tape_get_start(sz_sequence_t const *sequence, sz_size_t i) {
+    sz_tape_t const *tape = (sz_tape_t const *)sequence->handle;
+    return tape->data + ((sz_u64_t const *)tape->offsets)[i];
 }
 
-SZ_INTERNAL void _sz_heapsort(sz_sequence_t *sequence, sz_sequence_comparator_t less, sz_size_t first, sz_size_t last) {
-    sz_u64_t *order = sequence->order;
-    sz_size_t count = last - first;
-    _sz_heapify(sequence, less, order + first, count);
-    sz_size_t end = count - 1;
-    while (end > 0) {
-        sz_u64_swap(order + first, order + first + end);
-        end--;
-        _sz_sift_down(sequence, less, order + first, 0, end);
-    }
+SZ_INTERNAL sz_size_t _sz_sequence_u64tape_get_length(sz_sequence_t const *sequence, sz_size_t i) {
+    sz_u64_t const *offsets = (sz_u64_t const *)((sz_tape_t const *)sequence->handle)->offsets;
+    return (sz_size_t)(offsets[i + 1] - offsets[i]);
+}
+
+SZ_PUBLIC void sz_sequence_from_u32tape(sz_tape_t const *tape, sz_sorted_idx_t *order, sz_sequence_t *sequence) {
+    sequence->order = order;
+    sequence->count = tape->count;
+    sequence->get_start = _sz_sequence_u32tape_get_start;
+    sequence->get_length = _sz_sequence_u32tape_get_length;
+    sequence->handle = tape;
+    if (order)
+        for (sz_size_t i = 0; i != tape->count; ++i) order[i] = i;
+}
+
+SZ_PUBLIC void sz_sequence_from_u64tape(sz_tape_t const *tape, sz_sorted_idx_t *order, sz_sequence_t *sequence) {
+    sequence->order = order;
+    sequence->count = tape->count;
+    sequence->get_start = _sz_sequence_u64tape_get_start;
+    sequence->get_length = _sz_sequence_u64tape_get_length;
+    sequence->handle = tape;
+    if (order)
+        for (sz_size_t i = 0; i != tape->count; ++i) order[i] = i;
+}
+
+/**
+ *  @brief  Signature of a serialized tape, followed by a byte-order mark, the strings count, and the offsets width.
+ */
+#define _SZ_TAPE_MAGIC "SZSTRTAP"
+#define _SZ_TAPE_BYTE_ORDER (0x0102030405060708ull)
+
+SZ_PUBLIC void sz_tape_header(sz_size_t count, sz_size_t offset_bytes, sz_ptr_t header) {
+    sz_u64_t fields[4] = {0, _SZ_TAPE_BYTE_ORDER, (sz_u64_t)count, (sz_u64_t)offset_bytes};
+    sz_copy((sz_ptr_t)&fields[0], _SZ_TAPE_MAGIC, 8);
+    sz_copy(header, (sz_cptr_t)&fields[0], SZ_TAPE_HEADER_SIZE);
+}
+
+SZ_PUBLIC sz_bool_t sz_tape_parse(sz_cptr_t data, sz_size_t size, sz_tape_t *tape, sz_size_t *offset_bytes) {
+    if (size < SZ_TAPE_HEADER_SIZE || ((sz_size_t)data & 7u) != 0) return sz_false_k;
+    sz_u64_t const *fields = (sz_u64_t const *)data;
+    if (!sz_equal(data, _SZ_TAPE_MAGIC, 8) || fields[1] != _SZ_TAPE_BYTE_ORDER) return sz_false_k;
+    if (fields[3] != 4 && fields[3] != 8) return sz_false_k;
+
+    // The `count + 1` offsets must fit, without overflowing on corrupted inputs.
+    sz_u64_t const count = fields[2], width = fields[3];
+    sz_size_t const payload = size - SZ_TAPE_HEADER_SIZE;
+    if (count >= payload / width) return sz_false_k;
+
+    // The first offset must be zero, and the last one must point at the end of the buffer.
+    sz_cptr_t const offsets = data + SZ_TAPE_HEADER_SIZE;
+    sz_size_t const offsets_bytes = (sz_size_t)(count + 1) * (sz_size_t)width;
+    sz_u64_t const first = width == 4 ? ((sz_u32_t const *)offsets)[0] : ((sz_u64_t const *)offsets)[0];
+    sz_u64_t const last = width == 4 ? ((sz_u32_t const *)offsets)[count] : ((sz_u64_t const *)offsets)[count];
+    if (first != 0 || last != payload - offsets_bytes) return sz_false_k;
+
+    tape->data = offsets + offsets_bytes;
+    tape->offsets = offsets;
+    tape->count = (sz_size_t)count;
+    *offset_bytes = (sz_size_t)width;
+    return sz_true_k;
+}
+
+/**
+ *  @brief  Leading string of a run in `sz_merge_runs`, with its first 8 bytes cached in a big-endian integer.
+ */
+typedef struct _sz_merge_run_t {
+    sz_sequence_t const *sequence;
+    sz_size_t position;
+    sz_cptr_t start;
+    sz_size_t length;
+    sz_u64_t prefix;
+} _sz_merge_run_t;
+
+SZ_INTERNAL void _sz_merge_run_load(_sz_merge_run_t *run) {
+    sz_sequence_t const *sequence = run->sequence;
+    if (run->position == sequence->count) return;
+    sz_size_t const idx = sequence->order ? sequence->order[run->position] : run->position;
+    sz_cptr_t const start = run->start = sequence->get_start(sequence, idx);
+    sz_size_t const length = run->length = sequence->get_length(sequence, idx);
+#if defined(__GNUC__) || defined(__clang__)
+    // The runs are usually serialized tapes, where the next string follows the current one.
+    __builtin_prefetch(start + length);
+#endif
+    sz_u64_t prefix = 0;
+#if SZ_DETECT_BIG_ENDIAN
+    if (length >= 8) prefix = sz_u64_load(start).u64;
+#else
+    if (length >= 8) prefix = sz_u64_bytes_reverse(sz_u64_load(start).u64);
+#endif
+    else
+        for (sz_size_t i = 0; i != 8; ++i) prefix = (prefix << 8) | (i < length ? (sz_u8_t)start[i] : 0);
+    run->prefix = prefix;
+}
+
+/**
+ *  @brief  Compares the leading strings of two runs, treating the exhausted runs as the largest,
+ *          and breaking ties in favor of the run with the smaller index.
+ */
+SZ_INTERNAL sz_bool_t _sz_merge_run_less(_sz_merge_run_t const *runs, sz_size_t a, sz_size_t b) {
+    _sz_merge_run_t const *run_a = runs + a, *run_b = runs + b;
+    int const a_done = run_a->position == run_a->sequence->count;
+    int const b_done = run_b->position == run_b->sequence->count;
+    if (a_done || b_done) return (sz_bool_t)(a_done == b_done ? a < b : b_done);
+    if (run_a->prefix != run_b->prefix) return (sz_bool_t)(run_a->prefix < run_b->prefix);
+    // With equal prefixes, a string shorter than the prefix is a prefix of the other one.
+    if (run_a->length < 8 || run_b->length < 8) {
+        if (run_a->length != run_b->length) return (sz_bool_t)(run_a->length < run_b->length);
+    }
+    else {
+        sz_ordering_t const ordering =
+            sz_order(run_a->start + 8, run_a->length - 8, run_b->start + 8, run_b->length - 8);
+        if (ordering != sz_equal_k) return (sz_bool_t)(ordering == sz_less_k);
+    }
+    return (sz_bool_t)(a < b);
+}
+
+SZ_PUBLIC sz_bool_t sz_merge_runs(sz_sequence_t const *runs, sz_size_t runs_count, sz_merge_callback_t callback,
+                                  void *handle, sz_memory_allocator_t *alloc) {
+    if (!runs_count) return sz_true_k;
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    // The tree is laid out like a binary heap, with the runs as the leaves `[runs_count, 2 * runs_count)`,
+    // and the losers of every match in the inner nodes `[1, runs_count)`. The overall winner is kept at zero.
+    sz_size_t const bytes = runs_count * (sizeof(_sz_merge_run_t) + 3 * sizeof(sz_size_t));
+    _sz_merge_run_t *heads = (_sz_merge_run_t *)alloc->allocate(bytes, alloc->handle);
+    if (!heads) return sz_false_k;
+    sz_size_t *losers = (sz_size_t *)(heads + runs_count);
+    sz_size_t *winners = losers + runs_count;
+
+    for (sz_size_t i = 0; i != runs_count; ++i) {
+        heads[i].sequence = runs + i, heads[i].position = 0;
+        _sz_merge_run_load(heads + i);
+        winners[runs_count + i] = i;
+    }
+    for (sz_size_t node = runs_count - 1; node; --node) {
+        sz_size_t const left = winners[2 * node], right = winners[2 * node + 1];
+        sz_bool_t const left_wins = _sz_merge_run_less(heads, left, right);
+        winners[node] = left_wins ? left : right;
+        losers[node] = left_wins ? right : left;
+    }
+    losers[0] = winners[1];
+
+    // Every step advances the winning run, and replays its matches on the path to the root.
+    for (;;) {
+        sz_size_t winner = losers[0];
+        _sz_merge_run_t *run = heads + winner;
+        if (run->position == run->sequence->count) break;
+        callback(run->start, run->length, winner, handle);
+        run->position++;
+        _sz_merge_run_load(run);
+        for (sz_size_t node = (runs_count + winner) / 2; node; node /= 2)
+            if (_sz_merge_run_less(heads, losers[node], winner)) {
+                sz_size_t const loser = losers[node];
+                losers[node] = winner, winner = loser;
+            }
+        losers[0] = winner;
+    }
+
+    alloc->free(heads, bytes, alloc->handle);
+    return sz_true_k;
+}
+
+SZ_PUBLIC void sz_sort_insertion(sz_sequence_t *sequence, sz_sequence_comparator_t less) {
+    sz_u64_t *keys = sequence->order;
+    sz_size_t keys_count = sequence->count;
+    for (sz_size_t i = 1; i < keys_count; i++) {
+        sz_u64_t i_key = keys[i];
+        sz_size_t j = i;
+        for (; j > 0 && less(sequence, i_key, keys[j - 1]); --j) keys[j] = keys[j - 1];
+        keys[j] = i_key;
+    }
+}
+
+SZ_INTERNAL void _sz_sift_down(sz_sequence_t *sequence, sz_sequence_comparator_t less, sz_u64_t *order, sz_size_t start,
+                               sz_size_t end) {
+    sz_size_t root = start;
+    while (2 * root + 1 <= end) {
+        sz_size_t child = 2 * root + 1;
+        if (child + 1 <= end && less(sequence, order[child], order[child + 1])) { child++; }
+        if (!less(sequence, order[root], order[child])) { return; }
+        sz_u64_swap(order + root, order + child);
+        root = child;
+    }
+}
+
+SZ_INTERNAL void _sz_heapify(sz_sequence_t *sequence, sz_sequence_comparator_t less, sz_u64_t *order, sz_size_t count) {
+    sz_size_t start = (count - 2) / 2;
+    while (1) {
+        _sz_sift_down(sequence, less, order, start, count - 1);
+        if (start == 0) return;
+        start--;
+    }
+}
+
+SZ_INTERNAL void _sz_heapsort(sz_sequence_t *sequence, sz_sequence_comparator_t less, sz_size_t first, sz_size_t last) {
+    sz_u64_t *order = sequence->order;
+    sz_size_t count = last - first;
+    _sz_heapify(sequence, less, order + first, count);
+    sz_size_t end = count - 1;
+    while (end > 0) {
+        sz_u64_swap(order + first, order + first + end);
+        end--;
+        _sz_sift_down(sequence, less, order + first, 0, end);
+    }
 }
 
 SZ_PUBLIC void sz_sort_introsort_recursion(sz_sequence_t *sequence, sz_sequence_comparator_t less, sz_size_t first,
@@ -3375,20 +5922,11 @@ SZ_PUBLIC void sz_sort_introsort(sz_sequence_t *sequence, sz_sequence_comparator
     sz_sort_introsort_recursion(sequence, less, 0, sequence->count, depth_limit);
 }
 
-SZ_PUBLIC void sz_sort_recursion( //
-    sz_sequence_t *sequence, sz_size_t bit_idx, sz_size_t bit_max, sz_sequence_comparator_t comparator,
-    sz_size_t partial_order_length) {
-
-    if (!sequence->count) return;
-
-    // Array of size one doesn't need sorting - only needs the prefix to be discarded.
-    if (sequence->count == 1) {
-        sz_u32_t *order_half_words = (sz_u32_t *)sequence->order;
-        order_half_words[1] = 0;
-        return;
-    }
-
-    // Partition a range of integers according to a specific bit value
+/**
+ *  @brief  Partitions a range of integers according to a specific bit value, starting from the most significant one.
+ *  @return The number of entries with the bit unset, that will be placed first.
+ */
+SZ_INTERNAL sz_size_t _sz_sort_partition_by_bit(sz_sequence_t *sequence, sz_size_t bit_idx) {
     sz_size_t split = 0;
     sz_u64_t mask = (1ull << 63) >> bit_idx;
 
@@ -3427,6 +5965,25 @@ SZ_PUBLIC void sz_sort_recursion( //
         }
     }
 
+    return split;
+}
+
+SZ_PUBLIC void sz_sort_recursion( //
+    sz_sequence_t *sequence, sz_size_t bit_idx, sz_size_t bit_max, sz_sequence_comparator_t comparator,
+    sz_size_t partial_order_length) {
+
+    if (!sequence->count) return;
+
+    // Array of size one doesn't need sorting - only needs the prefix to be discarded.
+    if (sequence->count == 1) {
+        sz_u32_t *order_half_words = (sz_u32_t *)sequence->order;
+        order_half_words[1] = 0;
+        return;
+    }
+
+    // Partition a range of integers according to a specific bit value
+    sz_size_t split = _sz_sort_partition_by_bit(sequence, bit_idx);
+
     // Go down recursively.
     if (bit_idx < bit_max) {
         sz_sequence_t a = *sequence;
@@ -3463,6 +6020,20 @@ SZ_INTERNAL sz_bool_t _sz_sort_is_less(sz_sequence_t *sequence, sz_size_t i_key,
     return (sz_bool_t)(sz_order_serial(i_str, i_len, j_str, j_len) == sz_less_k);
 }
 
+/**
+ *  @brief  Exports up to 4 leading bytes of every string in the `[first, last)` range into the upper half
+ *          of the corresponding ::sequence order entries, to be used by the Radix Sort.
+ */
+SZ_INTERNAL void _sz_sort_export_prefixes(sz_sequence_t *sequence, sz_size_t first, sz_size_t last) {
+    for (sz_size_t i = first; i != last; ++i) {
+        sz_cptr_t begin = sequence->get_start(sequence, sequence->order[i]);
+        sz_size_t length = sequence->get_length(sequence, sequence->order[i]);
+        length = length > 4u ? 4u : length;
+        sz_ptr_t prefix = (sz_ptr_t)&sequence->order[i];
+        for (sz_size_t j = 0; j != length; ++j) prefix[7 - j] = begin[j];
+    }
+}
+
 SZ_PUBLIC void sz_sort_partial(sz_sequence_t *sequence, sz_size_t partial_order_length) {
 
 #if SZ_DETECT_BIG_ENDIAN
@@ -3472,13 +6043,7 @@ SZ_PUBLIC void sz_sort_partial(sz_sequence_t *sequence, sz_size_t partial_order_
 #else
 
     // Export up to 4 bytes into the `sequence` bits themselves
-    for (sz_size_t i = 0; i != sequence->count; ++i) {
-        sz_cptr_t begin = sequence->get_start(sequence, sequence->order[i]);
-        sz_size_t length = sequence->get_length(sequence, sequence->order[i]);
-        length = length > 4u ? 4u : length;
-        sz_ptr_t prefix = (sz_ptr_t)&sequence->order[i];
-        for (sz_size_t j = 0; j != length; ++j) prefix[7 - j] = begin[j];
-    }
+    _sz_sort_export_prefixes(sequence, 0, sequence->count);
 
     // Perform optionally-parallel radix sort on them
     sz_sort_recursion(sequence, 0, 32, (sz_sequence_comparator_t)_sz_sort_is_less, partial_order_length);
@@ -3493,6 +6058,391 @@ SZ_PUBLIC void sz_sort(sz_sequence_t *sequence) {
 #endif
 }
 
+/**
+ *  @brief  Unresolved part of a sequence in `sz_sort_stable`. All of its entries share the first ::depth bytes.
+ */
+typedef struct _sz_sort_stable_range_t {
+    sz_size_t start;
+    sz_size_t count;
+    sz_size_t depth;
+} _sz_sort_stable_range_t;
+
+/**
+ *  @brief  Packs up to 7 bytes of a string starting from ::depth into a big-endian key, padded with zeros.
+ *          The lowest byte stores the number of bytes remaining, or 8 if the string continues beyond the key.
+ *          Comparing such keys is equivalent to comparing the strings, up to ::depth + 7 bytes.
+ */
+SZ_INTERNAL sz_u64_t _sz_sort_stable_key(sz_sequence_t const *sequence, sz_sorted_idx_t idx, sz_size_t depth) {
+    sz_u8_t const *start = (sz_u8_t const *)sequence->get_start(sequence, idx);
+    sz_size_t length = sequence->get_length(sequence, idx);
+    sz_size_t remaining = length > depth ? length - depth : 0;
+    sz_u64_t key = 0;
+    for (sz_size_t j = 0; j != 7; ++j) key = (key << 8) | (j < remaining ? start[depth + j] : 0);
+    return (key << 8) | (remaining > 7 ? 8 : remaining);
+}
+
+/**
+ *  @brief  Stable insertion sort for small ranges, comparing the strings starting from ::depth.
+ */
+SZ_INTERNAL void _sz_sort_stable_insertion(sz_sequence_t const *sequence, sz_sorted_idx_t *order, sz_size_t count,
+                                           sz_size_t depth) {
+    for (sz_size_t i = 1; i < count; ++i) {
+        sz_sorted_idx_t current = order[i];
+        sz_cptr_t current_start = sequence->get_start(sequence, current) + depth;
+        sz_size_t current_length = sequence->get_length(sequence, current) - depth;
+        sz_size_t j = i;
+        for (; j > 0; --j) {
+            sz_cptr_t previous_start = sequence->get_start(sequence, order[j - 1]) + depth;
+            sz_size_t previous_length = sequence->get_length(sequence, order[j - 1]) - depth;
+            if (sz_order(current_start, current_length, previous_start, previous_length) != sz_less_k) break;
+            order[j] = order[j - 1];
+        }
+        order[j] = current;
+    }
+}
+
+/**
+ *  @brief  Stable LSD Radix Sort of ::count entries of ::order by their 64-bit ::keys, one byte at a time,
+ *          skipping the bytes shared by all keys. Both arrays are permuted in-place, using the temporary ones.
+ */
+SZ_INTERNAL void _sz_sort_lsd_radix(sz_u64_t *keys, sz_u64_t *keys_temporary, sz_sorted_idx_t *order,
+                                    sz_sorted_idx_t *order_temporary, sz_size_t count) {
+    sz_u64_t *const keys_output = keys;
+    sz_sorted_idx_t *const order_output = order;
+    for (sz_size_t shift = 0; shift != 64; shift += 8) {
+        sz_size_t offsets[256] = {0};
+        for (sz_size_t i = 0; i != count; ++i) ++offsets[(keys[i] >> shift) & 0xFFu];
+        if (offsets[(keys[0] >> shift) & 0xFFu] == count) continue;
+        for (sz_size_t byte = 0, total = 0; byte != 256; ++byte) {
+            sz_size_t byte_count = offsets[byte];
+            offsets[byte] = total, total += byte_count;
+        }
+        for (sz_size_t i = 0; i != count; ++i) {
+            sz_size_t target = offsets[(keys[i] >> shift) & 0xFFu]++;
+            keys_temporary[target] = keys[i], order_temporary[target] = order[i];
+        }
+        sz_pointer_swap((void **)&keys, (void **)&keys_temporary);
+        sz_pointer_swap((void **)&order, (void **)&order_temporary);
+    }
+    if (order == order_output) return;
+    sz_copy((sz_ptr_t)keys_output, (sz_cptr_t)keys, count * sizeof(sz_u64_t));
+    sz_copy((sz_ptr_t)order_output, (sz_cptr_t)order, count * sizeof(sz_sorted_idx_t));
+}
+
+SZ_PUBLIC sz_bool_t sz_sort_stable(sz_sequence_t *sequence, sz_memory_allocator_t *alloc) {
+
+    sz_size_t const count = sequence->count;
+    if (count < 2) return sz_true_k;
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    // Pending ranges are disjoint and contain at least two entries each, so there can't be more than `count / 2`.
+    sz_size_t const max_ranges = count / 2 + 1;
+    sz_size_t const buffer_length = count * sizeof(sz_u64_t) * 3 + max_ranges * sizeof(_sz_sort_stable_range_t);
+    sz_ptr_t buffer = (sz_ptr_t)alloc->allocate(buffer_length, alloc->handle);
+    if (!buffer) return sz_false_k;
+    sz_u64_t *keys = (sz_u64_t *)buffer;
+    sz_u64_t *keys_temporary = keys + count;
+    sz_sorted_idx_t *order_temporary = (sz_sorted_idx_t *)(keys_temporary + count);
+    _sz_sort_stable_range_t *ranges = (_sz_sort_stable_range_t *)(order_temporary + count);
+
+    // Small ranges are cheaper to sort with comparisons.
+    sz_size_t const insertion_threshold = 16;
+    sz_size_t ranges_count = 1;
+    ranges[0].start = 0, ranges[0].count = count, ranges[0].depth = 0;
+    while (ranges_count) {
+        _sz_sort_stable_range_t range = ranges[--ranges_count];
+        sz_sorted_idx_t *order = sequence->order + range.start;
+        if (range.count <= insertion_threshold) {
+            _sz_sort_stable_insertion(sequence, order, range.count, range.depth);
+            continue;
+        }
+
+        // Export the keys and sort them with a stable LSD Radix Sort, skipping the bytes shared by all keys.
+        sz_u64_t *range_keys = keys + range.start, *range_keys_temporary = keys_temporary + range.start;
+        sz_sorted_idx_t *range_order_temporary = order_temporary + range.start;
+        for (sz_size_t i = 0; i != range.count; ++i)
+            range_keys[i] = _sz_sort_stable_key(sequence, order[i], range.depth);
+
+        _sz_sort_lsd_radix(range_keys, range_keys_temporary, order, range_order_temporary, range.count);
+
+        // Entries with equal keys, that continue beyond the key, are resolved on the next iterations.
+        for (sz_size_t run_start = 0, run_end; run_start != range.count; run_start = run_end) {
+            for (run_end = run_start + 1; run_end != range.count && range_keys[run_end] == range_keys[run_start];)
+                ++run_end;
+            if (run_end - run_start < 2 || (range_keys[run_start] & 0xFFu) != 8) continue;
+            _sz_sort_stable_range_t *next = &ranges[ranges_count++];
+            next->start = range.start + run_start, next->count = run_end - run_start, next->depth = range.depth + 7;
+        }
+    }
+
+    alloc->free(buffer, buffer_length, alloc->handle);
+    return sz_true_k;
+}
+
+/**
+ *  @brief  Assigns dense ranks starting from one to the sorted ::suffixes, equal for the neighbors that have
+ *          equal ::keys and, if the ::ranks are given, equal ranks of the suffixes ::shift bytes further.
+ *  @return Number of distinct ranks.
+ */
+SZ_INTERNAL sz_size_t _sz_suffix_array_rerank(sz_sorted_idx_t const *suffixes, sz_size_t length, sz_u64_t const *keys,
+                                              sz_u64_t const *ranks, sz_size_t shift, sz_u64_t *new_ranks) {
+    sz_u64_t rank = 1;
+    new_ranks[suffixes[0]] = rank;
+    for (sz_size_t i = 1; i != length; ++i) {
+        sz_size_t const previous = suffixes[i - 1], current = suffixes[i];
+        sz_bool_t differs = keys[i] != keys[i - 1] ? sz_true_k : sz_false_k;
+        if (!differs && ranks) {
+            sz_u64_t const previous_next = previous + shift < length ? ranks[previous + shift] : 0;
+            sz_u64_t const current_next = current + shift < length ? ranks[current + shift] : 0;
+            differs = previous_next != current_next ? sz_true_k : sz_false_k;
+        }
+        rank += differs;
+        new_ranks[current] = rank;
+    }
+    return (sz_size_t)rank;
+}
+
+SZ_PUBLIC sz_bool_t sz_suffix_array(sz_cptr_t text, sz_size_t length, sz_sorted_idx_t *suffixes,
+                                    sz_memory_allocator_t *alloc) {
+
+    if (length == 0) return sz_true_k;
+    if (length == 1) {
+        suffixes[0] = 0;
+        return sz_true_k;
+    }
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    sz_size_t const buffer_length = length * sizeof(sz_u64_t) * 4;
+    sz_ptr_t buffer = (sz_ptr_t)alloc->allocate(buffer_length, alloc->handle);
+    if (!buffer) return sz_false_k;
+    sz_u64_t *keys = (sz_u64_t *)buffer;
+    sz_u64_t *keys_temporary = keys + length;
+    sz_sorted_idx_t *suffixes_temporary = (sz_sorted_idx_t *)(keys_temporary + length);
+    sz_u64_t *ranks = (sz_u64_t *)(suffixes_temporary + length);
+
+    // The initial ranks compare the leading 7 bytes of every suffix, with the lowest byte of the key storing
+    // the number of remaining bytes, so that shorter suffixes precede the longer ones with the same prefix.
+    // Zero ranks are reserved for the empty suffixes past the end of the text.
+    sz_u8_t const *bytes = (sz_u8_t const *)text;
+    for (sz_size_t i = 0; i != length; ++i) {
+        sz_size_t const remaining = length - i;
+        sz_u64_t key = 0;
+        for (sz_size_t j = 0; j != 7; ++j) key = (key << 8) | (j < remaining ? bytes[i + j] : 0);
+        keys[i] = (key << 8) | (remaining > 7 ? 8 : remaining);
+        suffixes[i] = i;
+    }
+    _sz_sort_lsd_radix(keys, keys_temporary, suffixes, suffixes_temporary, length);
+    sz_size_t distinct = _sz_suffix_array_rerank(suffixes, length, keys, SZ_NULL, 0, ranks);
+
+    // Every round sorts by the rank of the suffix `shift` bytes further, and then stably by the own rank,
+    // doubling the length of the prefixes that the ranks compare, until all of them are distinct.
+    for (sz_size_t shift = 7; distinct != length; shift *= 2) {
+        for (sz_size_t i = 0; i != length; ++i) keys[i] = suffixes[i] + shift < length ? ranks[suffixes[i] + shift] : 0;
+        _sz_sort_lsd_radix(keys, keys_temporary, suffixes, suffixes_temporary, length);
+        for (sz_size_t i = 0; i != length; ++i) keys[i] = ranks[suffixes[i]];
+        _sz_sort_lsd_radix(keys, keys_temporary, suffixes, suffixes_temporary, length);
+        distinct = _sz_suffix_array_rerank(suffixes, length, keys, ranks, shift, keys_temporary);
+        sz_pointer_swap((void **)&ranks, (void **)&keys_temporary);
+    }
+
+    alloc->free(buffer, buffer_length, alloc->handle);
+    return sz_true_k;
+}
+
+/**
+ *  @brief  Compares the first ::needle_length bytes of a suffix with the needle.
+ */
+SZ_INTERNAL sz_ordering_t _sz_suffix_array_order(sz_cptr_t text, sz_size_t length, sz_sorted_idx_t suffix,
+                                                 sz_cptr_t needle, sz_size_t needle_length) {
+    sz_size_t const suffix_length = sz_min_of_two(length - suffix, needle_length);
+    return sz_order(text + suffix, suffix_length, needle, needle_length);
+}
+
+SZ_PUBLIC sz_size_t sz_suffix_array_range(sz_cptr_t text, sz_size_t length, sz_sorted_idx_t const *suffixes,
+                                          sz_cptr_t needle, sz_size_t needle_length, sz_size_t *first) {
+
+    // The lower bound is the first suffix, that isn't smaller than the needle.
+    sz_size_t low = 0, high = length;
+    while (low < high) {
+        sz_size_t const middle = low + (high - low) / 2;
+        if (_sz_suffix_array_order(text, length, suffixes[middle], needle, needle_length) == sz_less_k)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    *first = low;
+
+    // The upper bound is the first suffix, which prefix is greater than the needle.
+    high = length;
+    while (low < high) {
+        sz_size_t const middle = low + (high - low) / 2;
+        if (_sz_suffix_array_order(text, length, suffixes[middle], needle, needle_length) != sz_greater_k)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low - *first;
+}
+
+SZ_PUBLIC sz_size_t sz_suffix_array_longest_prefix(sz_cptr_t text, sz_size_t length, sz_sorted_idx_t const *suffixes,
+                                                   sz_cptr_t needle, sz_size_t needle_length, sz_size_t *offset) {
+
+    sz_size_t position, longest = 0;
+    *offset = 0;
+    sz_suffix_array_range(text, length, suffixes, needle, needle_length, &position);
+
+    // The suffixes sharing the most with the needle surround its insertion point.
+    for (sz_size_t i = position ? position - 1 : 0; i != position + 1 && i != length; ++i) {
+        sz_size_t const suffix = suffixes[i];
+        sz_size_t const limit = sz_min_of_two(length - suffix, needle_length);
+        sz_size_t common = 0;
+        while (common != limit && text[suffix + common] == needle[common]) ++common;
+        if (common > longest) longest = common, *offset = suffix;
+    }
+    return longest;
+}
+
+/**
+ *  @brief  Signature of a serialized suffix index, followed by a byte-order mark, the text length, and reserved zeros.
+ */
+#define _SZ_SUFFIX_INDEX_MAGIC "SZSUFIDX"
+#define _SZ_SUFFIX_INDEX_BYTE_ORDER (0x0102030405060708ull)
+
+SZ_PUBLIC void sz_suffix_index_header(sz_size_t length, sz_ptr_t header) {
+    sz_u64_t fields[4] = {0, _SZ_SUFFIX_INDEX_BYTE_ORDER, (sz_u64_t)length, 0};
+    sz_copy((sz_ptr_t)&fields[0], _SZ_SUFFIX_INDEX_MAGIC, 8);
+    sz_copy(header, (sz_cptr_t)&fields[0], SZ_SUFFIX_INDEX_HEADER_SIZE);
+}
+
+SZ_PUBLIC sz_bool_t sz_suffix_index_parse(sz_cptr_t data, sz_size_t size, sz_cptr_t *text, sz_size_t *length,
+                                          sz_sorted_idx_t const **suffixes) {
+    if (size < SZ_SUFFIX_INDEX_HEADER_SIZE || ((sz_size_t)data & 7u) != 0) return sz_false_k;
+    sz_u64_t const *fields = (sz_u64_t const *)data;
+    if (!sz_equal(data, _SZ_SUFFIX_INDEX_MAGIC, 8) || fields[1] != _SZ_SUFFIX_INDEX_BYTE_ORDER) return sz_false_k;
+
+    // The text length must be consistent with the size, without overflowing on corrupted inputs.
+    sz_u64_t const text_length = fields[2];
+    sz_size_t const payload = size - SZ_SUFFIX_INDEX_HEADER_SIZE;
+    if (text_length > payload / (sizeof(sz_sorted_idx_t) + 1) || payload != text_length * (sizeof(sz_sorted_idx_t) + 1))
+        return sz_false_k;
+
+    *suffixes = (sz_sorted_idx_t const *)(data + SZ_SUFFIX_INDEX_HEADER_SIZE);
+    *text = data + SZ_SUFFIX_INDEX_HEADER_SIZE + text_length * sizeof(sz_sorted_idx_t);
+    *length = (sz_size_t)text_length;
+    return sz_true_k;
+}
+
+/**
+ *  @brief  Contiguous part of a sequence, that is sorted independently from others in `sz_sort_parallel`.
+ *          All of its entries share the first ::bit_idx bits of the exported prefix.
+ */
+typedef struct _sz_sort_bucket_t {
+    sz_sorted_idx_t *order;
+    sz_size_t count;
+    sz_size_t bit_idx;
+} _sz_sort_bucket_t;
+
+typedef struct _sz_sort_parallel_state_t {
+    sz_sequence_t const *sequence;
+    _sz_sort_bucket_t *buckets;
+    sz_size_t chunk_size;
+} _sz_sort_parallel_state_t;
+
+SZ_INTERNAL void _sz_sort_parallel_export_task(void *task_state, sz_size_t task_index) {
+    _sz_sort_parallel_state_t *state = (_sz_sort_parallel_state_t *)task_state;
+    sz_sequence_t sequence = *state->sequence;
+    sz_size_t first = task_index * state->chunk_size;
+    sz_size_t last = sz_min_of_two(first + state->chunk_size, sequence.count);
+    _sz_sort_export_prefixes(&sequence, first, last);
+}
+
+SZ_INTERNAL void _sz_sort_parallel_bucket_task(void *task_state, sz_size_t task_index) {
+    _sz_sort_parallel_state_t *state = (_sz_sort_parallel_state_t *)task_state;
+    _sz_sort_bucket_t bucket = state->buckets[task_index];
+    sz_sequence_t sequence = *state->sequence;
+    sequence.order = bucket.order;
+    sequence.count = bucket.count;
+    sz_sort_recursion(&sequence, bucket.bit_idx, 32, (sz_sequence_comparator_t)_sz_sort_is_less, sequence.count);
+}
+
+SZ_PUBLIC void sz_sort_parallel(sz_sequence_t *sequence, sz_executor_t const *executor) {
+
+    // Spawning tasks for small inputs only makes things slower.
+    sz_size_t const min_count_per_thread = 4096;
+    if (!executor || executor->threads_count < 2 || sequence->count < min_count_per_thread * 2) {
+        sz_sort(sequence);
+        return;
+    }
+
+#if SZ_DETECT_BIG_ENDIAN
+    // TODO: Implement parallel sort for big-endian systems. For now this sorts the whole thing serially.
+    sz_sort(sequence);
+#else
+
+    sz_size_t const threads_count = executor->threads_count;
+    _sz_sort_bucket_t buckets[256];
+    _sz_sort_parallel_state_t state;
+    state.sequence = sequence;
+    state.buckets = buckets;
+
+    // The prefix export is the most memory-bound part, as it walks through the strings
+    state.chunk_size = sz_max_of_two(min_count_per_thread, (sequence->count + threads_count - 1) / threads_count);
+    executor->parallel_for(_sz_sort_parallel_export_task, &state,
+                           (sequence->count + state.chunk_size - 1) / state.chunk_size, executor->handle);
+
+    // Keep splitting the largest bucket in two by the next bit until we have enough work for every thread.
+    // Every split preserves the relative order of buckets, so sorting them independently sorts the whole sequence.
+    sz_size_t const max_buckets_count = sz_min_of_two(threads_count * 4, sizeof(buckets) / sizeof(buckets[0]));
+    sz_size_t const target_bucket_size = sequence->count / max_buckets_count;
+    sz_size_t buckets_count = 1;
+    buckets[0].order = sequence->order, buckets[0].count = sequence->count, buckets[0].bit_idx = 0;
+    while (buckets_count < max_buckets_count) {
+        sz_size_t largest = buckets_count;
+        for (sz_size_t i = 0; i != buckets_count; ++i)
+            if (buckets[i].bit_idx < 32 && buckets[i].count > target_bucket_size &&
+                (largest == buckets_count || buckets[i].count > buckets[largest].count))
+                largest = i;
+        if (largest == buckets_count) break;
+
+        _sz_sort_bucket_t *bucket = &buckets[largest];
+        sz_sequence_t bucket_sequence = *sequence;
+        bucket_sequence.order = bucket->order;
+        bucket_sequence.count = bucket->count;
+        sz_size_t split = _sz_sort_partition_by_bit(&bucket_sequence, bucket->bit_idx);
+        bucket->bit_idx++;
+        if (split == 0 || split == bucket->count) continue;
+
+        _sz_sort_bucket_t *second = &buckets[buckets_count++];
+        second->order = bucket->order + split;
+        second->count = bucket->count - split;
+        second->bit_idx = bucket->bit_idx;
+        bucket->count = split;
+    }
+
+    // Put the largest buckets first, so that dynamic schedulers pick them up early.
+    for (sz_size_t i = 1; i < buckets_count; ++i) {
+        _sz_sort_bucket_t bucket = buckets[i];
+        sz_size_t j = i;
+        for (; j > 0 && buckets[j - 1].count < bucket.count; --j) buckets[j] = buckets[j - 1];
+        buckets[j] = bucket;
+    }
+
+    executor->parallel_for(_sz_sort_parallel_bucket_task, &state, buckets_count, executor->handle);
+#endif
+}
+
 #pragma endregion
 
 /*
@@ -3574,15 +6524,12 @@ SZ_PUBLIC sz_cptr_t sz_rfind_byte_avx2(sz_cptr_t h, sz_size_t h_length, sz_cptr_
     return sz_rfind_byte_serial(h, h_length, n);
 }
 
-SZ_PUBLIC sz_cptr_t sz_find_avx2(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
-
-    // This almost never fires, but it's better to be safe than sorry.
-    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
-    if (n_length == 1) return sz_find_byte_avx2(h, h_length, n);
-
-    // Pick the parts of the needle that are worth comparing.
-    sz_size_t offset_first, offset_mid, offset_last;
-    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+/**
+ *  @brief  Substring search kernel, comparing the three given needle bytes at 32 offsets at a time,
+ *          shared by ::sz_find_avx2 and ::sz_find_prepared_avx2.
+ */
+SZ_INTERNAL sz_cptr_t _sz_find_raita_avx2(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length, //
+                                          sz_size_t offset_first, sz_size_t offset_mid, sz_size_t offset_last) {
 
     // Broadcast those characters into YMM registers.
     int matches;
@@ -3606,22 +6553,49 @@ SZ_PUBLIC sz_cptr_t sz_find_avx2(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, s
         }
     }
 
-    return sz_find_serial(h, h_length, n, n_length);
+    // The few remaining offsets are checked one by one, to avoid the setup costs of the serial backend.
+    for (; h_length >= n_length; ++h, --h_length)
+        if (h[offset_first] == n[offset_first] && h[offset_mid] == n[offset_mid] && h[offset_last] == n[offset_last] &&
+            sz_equal(h, n, n_length))
+            return h;
+    return SZ_NULL_CHAR;
 }
 
-SZ_PUBLIC sz_cptr_t sz_rfind_avx2(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
+SZ_PUBLIC sz_cptr_t sz_find_avx2(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
 
     // This almost never fires, but it's better to be safe than sorry.
     if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
-    if (n_length == 1) return sz_rfind_byte_avx2(h, h_length, n);
+    if (n_length == 1) return sz_find_byte_avx2(h, h_length, n);
 
     // Pick the parts of the needle that are worth comparing.
     sz_size_t offset_first, offset_mid, offset_last;
     _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
 
-    // Broadcast those characters into YMM registers.
-    int matches;
-    sz_u256_vec_t h_first_vec, h_mid_vec, h_last_vec, n_first_vec, n_mid_vec, n_last_vec;
+    return _sz_find_raita_avx2(h, h_length, n, n_length, offset_first, offset_mid, offset_last);
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_prepared_avx2(sz_needle_t const *needle, sz_cptr_t h, sz_size_t h_length) {
+
+    sz_size_t const n_length = needle->length;
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+    if (n_length == 1) return sz_find_byte_avx2(h, h_length, needle->start);
+    return _sz_find_raita_avx2(h, h_length, needle->start, n_length, needle->offset_first, needle->offset_mid,
+                               needle->offset_last);
+}
+
+SZ_PUBLIC sz_cptr_t sz_rfind_avx2(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
+
+    // This almost never fires, but it's better to be safe than sorry.
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+    if (n_length == 1) return sz_rfind_byte_avx2(h, h_length, n);
+
+    // Pick the parts of the needle that are worth comparing.
+    sz_size_t offset_first, offset_mid, offset_last;
+    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+
+    // Broadcast those characters into YMM registers.
+    int matches;
+    sz_u256_vec_t h_first_vec, h_mid_vec, h_last_vec, n_first_vec, n_mid_vec, n_last_vec;
     n_first_vec.ymm = _mm256_set1_epi8(n[offset_first]);
     n_mid_vec.ymm = _mm256_set1_epi8(n[offset_mid]);
     n_last_vec.ymm = _mm256_set1_epi8(n[offset_last]);
@@ -3647,6 +6621,184 @@ SZ_PUBLIC sz_cptr_t sz_rfind_avx2(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n,
     return sz_rfind_serial(h, h_length, n, n_length);
 }
 
+/**
+ *  @brief  Selects the bytes in the `[first, first + count)` unsigned range. AVX2 only has signed comparisons,
+ *          so the range is shifted to start at -128, wrapping around, before the comparison.
+ */
+SZ_INTERNAL __m256i _sz_select_range_avx2(__m256i text, sz_u8_t first, sz_u8_t count) {
+    __m256i shifted = _mm256_sub_epi8(text, _mm256_set1_epi8((char)(first + 128)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(count - 128)), shifted);
+}
+
+/**
+ *  @brief  Vectorized version of ::sz_u8_tolower, that sets the 5th bit of the uppercase ASCII and Latin-1 letters.
+ */
+SZ_INTERNAL __m256i _sz_tolower_avx2(__m256i text) {
+    __m256i ascii_upper = _sz_select_range_avx2(text, 'A', 26);
+    __m256i latin_upper = _mm256_andnot_si256(_mm256_cmpeq_epi8(text, _mm256_set1_epi8((char)215)),
+                                              _sz_select_range_avx2(text, 192, 31));
+    __m256i upper = _mm256_or_si256(ascii_upper, latin_upper);
+    return _mm256_or_si256(text, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+/**
+ *  @brief  Vectorized version of ::sz_u8_toupper, that clears the 5th bit of the lowercase ASCII and Latin-1 letters.
+ */
+SZ_INTERNAL __m256i _sz_toupper_avx2(__m256i text) {
+    __m256i ascii_lower = _sz_select_range_avx2(text, 'a', 26);
+    __m256i latin_lower = _mm256_andnot_si256(_mm256_cmpeq_epi8(text, _mm256_set1_epi8((char)247)),
+                                              _sz_select_range_avx2(text, 224, 31));
+    __m256i lower = _mm256_or_si256(ascii_lower, latin_lower);
+    return _mm256_andnot_si256(_mm256_and_si256(lower, _mm256_set1_epi8(0x20)), text);
+}
+
+SZ_PUBLIC void sz_tolower_avx2(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    for (; length >= 32; text += 32, result += 32, length -= 32)
+        _mm256_storeu_si256((__m256i *)result, _sz_tolower_avx2(_mm256_lddqu_si256((__m256i const *)text)));
+    sz_tolower_serial(text, length, result);
+}
+
+SZ_PUBLIC void sz_toupper_avx2(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    for (; length >= 32; text += 32, result += 32, length -= 32)
+        _mm256_storeu_si256((__m256i *)result, _sz_toupper_avx2(_mm256_lddqu_si256((__m256i const *)text)));
+    sz_toupper_serial(text, length, result);
+}
+
+SZ_PUBLIC void sz_toascii_avx2(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    __m256i const mask_vec = _mm256_set1_epi8(0x7F);
+    for (; length >= 32; text += 32, result += 32, length -= 32)
+        _mm256_storeu_si256((__m256i *)result, _mm256_and_si256(_mm256_lddqu_si256((__m256i const *)text), mask_vec));
+    sz_toascii_serial(text, length, result);
+}
+
+SZ_PUBLIC void sz_translate_avx2(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result) {
+    // The `VPSHUFB` instruction can only look up 16-byte tables, so we split the 256-byte table into 16 rows.
+    // Every row is indexed by the low nibble of the input, and selected, if the high nibble matches its number.
+    __m256i rows_vecs[16];
+    for (int row = 0; row != 16; ++row)
+        rows_vecs[row] = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const *)(lut + row * 16)));
+    __m256i const nibble_mask_vec = _mm256_set1_epi8(0x0F);
+    for (; length >= 32; text += 32, result += 32, length -= 32) {
+        __m256i text_vec = _mm256_lddqu_si256((__m256i const *)text);
+        __m256i low_nibbles_vec = _mm256_and_si256(text_vec, nibble_mask_vec);
+        __m256i high_nibbles_vec = _mm256_and_si256(_mm256_srli_epi16(text_vec, 4), nibble_mask_vec);
+        __m256i result_vec = _mm256_setzero_si256();
+        for (int row = 0; row != 16; ++row) {
+            __m256i row_mask_vec = _mm256_cmpeq_epi8(high_nibbles_vec, _mm256_set1_epi8((char)row));
+            __m256i row_vec = _mm256_shuffle_epi8(rows_vecs[row], low_nibbles_vec);
+            result_vec = _mm256_or_si256(result_vec, _mm256_and_si256(row_mask_vec, row_vec));
+        }
+        _mm256_storeu_si256((__m256i *)result, result_vec);
+    }
+    sz_translate_serial(text, length, lut, result);
+}
+
+SZ_PUBLIC sz_bool_t sz_isascii_avx2(sz_cptr_t text, sz_size_t length) {
+    // Merge pairs of registers to halve the number of `movemask` calls on longer inputs.
+    for (; length >= 64; text += 64, length -= 64)
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_lddqu_si256((__m256i const *)text),
+                                                 _mm256_lddqu_si256((__m256i const *)(text + 32)))))
+            return sz_false_k;
+    for (; length >= 32; text += 32, length -= 32)
+        if (_mm256_movemask_epi8(_mm256_lddqu_si256((__m256i const *)text))) return sz_false_k;
+    return sz_isascii_serial(text, length);
+}
+
+/**
+ *  @brief  Compares two strings of equal length, folding the case of both, like ::sz_tolower.
+ */
+SZ_INTERNAL sz_bool_t _sz_equal_case_insensitive_avx2(sz_cptr_t a, sz_cptr_t b, sz_size_t length) {
+    for (; length >= 32; a += 32, b += 32, length -= 32)
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_sz_tolower_avx2(_mm256_lddqu_si256((__m256i const *)a)),
+                                                   _sz_tolower_avx2(_mm256_lddqu_si256((__m256i const *)b)))) != -1)
+            return sz_false_k;
+    return _sz_equal_case_insensitive_serial(a, b, length);
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_case_insensitive_avx2(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
+
+    // This almost never fires, but it's better to be safe than sorry.
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+
+    // Pick the parts of the needle that are worth comparing.
+    sz_size_t offset_first, offset_mid, offset_last;
+    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+
+    // Broadcast the folded characters into YMM registers, along with the bits to set in the haystack.
+    int matches;
+    sz_u256_vec_t h_first_vec, h_mid_vec, h_last_vec, n_first_vec, n_mid_vec, n_last_vec;
+    sz_u256_vec_t n_first_bit_vec, n_mid_bit_vec, n_last_bit_vec;
+    sz_u8_t const n_first = sz_u8_tolower((sz_u8_t)n[offset_first]);
+    sz_u8_t const n_mid = sz_u8_tolower((sz_u8_t)n[offset_mid]);
+    sz_u8_t const n_last = sz_u8_tolower((sz_u8_t)n[offset_last]);
+    n_first_vec.ymm = _mm256_set1_epi8((char)n_first);
+    n_mid_vec.ymm = _mm256_set1_epi8((char)n_mid);
+    n_last_vec.ymm = _mm256_set1_epi8((char)n_last);
+    n_first_bit_vec.ymm = _mm256_set1_epi8((char)_sz_case_insensitive_filter_bit(n_first));
+    n_mid_bit_vec.ymm = _mm256_set1_epi8((char)_sz_case_insensitive_filter_bit(n_mid));
+    n_last_bit_vec.ymm = _mm256_set1_epi8((char)_sz_case_insensitive_filter_bit(n_last));
+
+    // Scan through the string, without fully folding the haystack characters.
+    for (; h_length >= n_length + 32; h += 32, h_length -= 32) {
+        h_first_vec.ymm = _mm256_or_si256(_mm256_lddqu_si256((__m256i const *)(h + offset_first)), n_first_bit_vec.ymm);
+        h_mid_vec.ymm = _mm256_or_si256(_mm256_lddqu_si256((__m256i const *)(h + offset_mid)), n_mid_bit_vec.ymm);
+        h_last_vec.ymm = _mm256_or_si256(_mm256_lddqu_si256((__m256i const *)(h + offset_last)), n_last_bit_vec.ymm);
+        matches = _mm256_movemask_epi8(_mm256_cmpeq_epi8(h_first_vec.ymm, n_first_vec.ymm)) &
+                  _mm256_movemask_epi8(_mm256_cmpeq_epi8(h_mid_vec.ymm, n_mid_vec.ymm)) &
+                  _mm256_movemask_epi8(_mm256_cmpeq_epi8(h_last_vec.ymm, n_last_vec.ymm));
+        while (matches) {
+            int potential_offset = sz_u32_ctz(matches);
+            if (_sz_equal_case_insensitive_avx2(h + potential_offset, n, n_length))
+                return h + potential_offset;
+            matches &= matches - 1;
+        }
+    }
+
+    return sz_find_case_insensitive_serial(h, h_length, n, n_length);
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_any_avx2(sz_multi_pattern_t const *pattern, sz_cptr_t h, sz_size_t h_length,
+                                     sz_size_t *needle_id) {
+
+    sz_size_t const probe_length = pattern->probe_length;
+    if (!probe_length || h_length < probe_length) return SZ_NULL_CHAR;
+
+    // Every probed position has two lookup tables - for the low and the high nibbles of incoming bytes.
+    // Unused positions are filled with ones, so we can always process all three of them.
+    sz_u256_vec_t low_nibbles_vecs[3], high_nibbles_vecs[3], low_nibbles_mask_vec;
+    sz_u256_vec_t h_vec, h_low_vec, h_high_vec, buckets_vec;
+    for (sz_size_t k = 0; k != 3; ++k) {
+        low_nibbles_vecs[k].ymm =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const *)&pattern->low_nibbles[k][0]));
+        high_nibbles_vecs[k].ymm =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const *)&pattern->high_nibbles[k][0]));
+    }
+    low_nibbles_mask_vec.ymm = _mm256_set1_epi8(0x0F);
+
+    sz_size_t const candidates_count = h_length - probe_length + 1;
+    sz_size_t offset = 0;
+    for (; offset + 32 <= candidates_count; offset += 32) {
+        buckets_vec.ymm = _mm256_set1_epi8((char)0xFF);
+        for (sz_size_t k = 0; k != probe_length; ++k) {
+            h_vec.ymm = _mm256_lddqu_si256((__m256i const *)(h + offset + k));
+            h_low_vec.ymm = _mm256_and_si256(h_vec.ymm, low_nibbles_mask_vec.ymm);
+            h_high_vec.ymm = _mm256_and_si256(_mm256_srli_epi16(h_vec.ymm, 4), low_nibbles_mask_vec.ymm);
+            h_low_vec.ymm = _mm256_shuffle_epi8(low_nibbles_vecs[k].ymm, h_low_vec.ymm);
+            h_high_vec.ymm = _mm256_shuffle_epi8(high_nibbles_vecs[k].ymm, h_high_vec.ymm);
+            buckets_vec.ymm = _mm256_and_si256(buckets_vec.ymm, _mm256_and_si256(h_low_vec.ymm, h_high_vec.ymm));
+        }
+        sz_u32_t matches = ~(sz_u32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(buckets_vec.ymm, _mm256_setzero_si256()));
+        for (; matches; matches &= matches - 1) {
+            int potential_offset = sz_u32_ctz(matches);
+            if (_sz_find_any_verify(pattern, h + offset + potential_offset, h_length - offset - potential_offset,
+                                    buckets_vec.u8s[potential_offset], needle_id))
+                return h + offset + potential_offset;
+        }
+    }
+
+    return sz_find_any_serial(pattern, h + offset, h_length - offset, needle_id);
+}
+
 /**
  *  @brief  There is no AVX2 instruction for fast multiplication of 64-bit integers.
  *          This implementation is coming from Agner Fog's Vector Class Library.
@@ -3662,6 +6814,18 @@ SZ_INTERNAL __m256i _mm256_mul_epu64(__m256i a, __m256i b) {
     return prod;
 }
 
+/**
+ *  @brief  Computes the modulo of every 64-bit lane, assuming it's below twice the `SZ_U64_MAX_PRIME`.
+ *          AVX2 only has signed 64-bit comparisons, so both sides are shifted by the sign bit first.
+ */
+SZ_INTERNAL __m256i _sz_prime_mod_avx2(__m256i hash) {
+    __m256i const sign = _mm256_set1_epi64x((long long)0x8000000000000000ull);
+    __m256i const prime = _mm256_set1_epi64x((long long)SZ_U64_MAX_PRIME);
+    __m256i const threshold = _mm256_set1_epi64x((long long)((SZ_U64_MAX_PRIME - 1) ^ 0x8000000000000000ull));
+    __m256i const overflows = _mm256_cmpgt_epi64(_mm256_xor_si256(hash, sign), threshold);
+    return _mm256_sub_epi64(hash, _mm256_and_si256(overflows, prime));
+}
+
 SZ_PUBLIC void sz_hashes_avx2(sz_cptr_t start, sz_size_t length, sz_size_t window_length, sz_size_t step, //
                               sz_hash_callback_t callback, void *callback_handle) {
 
@@ -3688,12 +6852,11 @@ SZ_PUBLIC void sz_hashes_avx2(sz_cptr_t start, sz_size_t length, sz_size_t windo
         prime_power_high = (prime_power_high * 257ull) % SZ_U64_MAX_PRIME;
 
     // Broadcast the constants into the registers.
-    sz_u256_vec_t prime_vec, golden_ratio_vec;
+    sz_u256_vec_t golden_ratio_vec;
     sz_u256_vec_t base_low_vec, base_high_vec, prime_power_low_vec, prime_power_high_vec, shift_high_vec;
     base_low_vec.ymm = _mm256_set1_epi64x(31ull);
     base_high_vec.ymm = _mm256_set1_epi64x(257ull);
     shift_high_vec.ymm = _mm256_set1_epi64x(77ull);
-    prime_vec.ymm = _mm256_set1_epi64x(SZ_U64_MAX_PRIME);
     golden_ratio_vec.ymm = _mm256_set1_epi64x(11400714819323198485ull);
     prime_power_low_vec.ymm = _mm256_set1_epi64x(prime_power_low);
     prime_power_high_vec.ymm = _mm256_set1_epi64x(prime_power_high);
@@ -3720,17 +6883,14 @@ SZ_PUBLIC void sz_hashes_avx2(sz_cptr_t start, sz_size_t length, sz_size_t windo
 
         // 4. Compute the modulo. Assuming there are only 59 values between our prime
         //    and the 2^64 value, we can simply compute the modulo by conditionally subtracting the prime.
-        hash_low_vec.ymm = _mm256_blendv_epi8(hash_low_vec.ymm, _mm256_sub_epi64(hash_low_vec.ymm, prime_vec.ymm),
-                                              _mm256_cmpgt_epi64(hash_low_vec.ymm, prime_vec.ymm));
-        hash_high_vec.ymm = _mm256_blendv_epi8(hash_high_vec.ymm, _mm256_sub_epi64(hash_high_vec.ymm, prime_vec.ymm),
-                                               _mm256_cmpgt_epi64(hash_high_vec.ymm, prime_vec.ymm));
+        hash_low_vec.ymm = _sz_prime_mod_avx2(hash_low_vec.ymm);
+        hash_high_vec.ymm = _sz_prime_mod_avx2(hash_high_vec.ymm);
     }
 
     // 5. Compute the hash mix, that will be used to index into the fingerprint.
     //    This includes a serial step at the end.
-    hash_low_vec.ymm = _mm256_mul_epu64(hash_low_vec.ymm, golden_ratio_vec.ymm);
-    hash_high_vec.ymm = _mm256_mul_epu64(hash_high_vec.ymm, golden_ratio_vec.ymm);
-    hash_mix_vec.ymm = _mm256_xor_si256(hash_low_vec.ymm, hash_high_vec.ymm);
+    hash_mix_vec.ymm = _mm256_xor_si256(_mm256_mul_epu64(hash_low_vec.ymm, golden_ratio_vec.ymm),
+                                        _mm256_mul_epu64(hash_high_vec.ymm, golden_ratio_vec.ymm));
     callback((sz_cptr_t)text_first, window_length, hash_mix_vec.u64s[0], callback_handle);
     callback((sz_cptr_t)text_second, window_length, hash_mix_vec.u64s[1], callback_handle);
     callback((sz_cptr_t)text_third, window_length, hash_mix_vec.u64s[2], callback_handle);
@@ -3764,16 +6924,13 @@ SZ_PUBLIC void sz_hashes_avx2(sz_cptr_t start, sz_size_t length, sz_size_t windo
 
         // 4. Compute the modulo. Assuming there are only 59 values between our prime
         //    and the 2^64 value, we can simply compute the modulo by conditionally subtracting the prime.
-        hash_low_vec.ymm = _mm256_blendv_epi8(hash_low_vec.ymm, _mm256_sub_epi64(hash_low_vec.ymm, prime_vec.ymm),
-                                              _mm256_cmpgt_epi64(hash_low_vec.ymm, prime_vec.ymm));
-        hash_high_vec.ymm = _mm256_blendv_epi8(hash_high_vec.ymm, _mm256_sub_epi64(hash_high_vec.ymm, prime_vec.ymm),
-                                               _mm256_cmpgt_epi64(hash_high_vec.ymm, prime_vec.ymm));
+        hash_low_vec.ymm = _sz_prime_mod_avx2(hash_low_vec.ymm);
+        hash_high_vec.ymm = _sz_prime_mod_avx2(hash_high_vec.ymm);
 
         // 5. Compute the hash mix, that will be used to index into the fingerprint.
         //    This includes a serial step at the end.
-        hash_low_vec.ymm = _mm256_mul_epu64(hash_low_vec.ymm, golden_ratio_vec.ymm);
-        hash_high_vec.ymm = _mm256_mul_epu64(hash_high_vec.ymm, golden_ratio_vec.ymm);
-        hash_mix_vec.ymm = _mm256_xor_si256(hash_low_vec.ymm, hash_high_vec.ymm);
+        hash_mix_vec.ymm = _mm256_xor_si256(_mm256_mul_epu64(hash_low_vec.ymm, golden_ratio_vec.ymm),
+                                            _mm256_mul_epu64(hash_high_vec.ymm, golden_ratio_vec.ymm));
         if ((cycle & step_mask) == 0) {
             callback((sz_cptr_t)text_first, window_length, hash_mix_vec.u64s[0], callback_handle);
             callback((sz_cptr_t)text_second, window_length, hash_mix_vec.u64s[1], callback_handle);
@@ -3783,6 +6940,183 @@ SZ_PUBLIC void sz_hashes_avx2(sz_cptr_t start, sz_size_t length, sz_size_t windo
     }
 }
 
+SZ_PUBLIC void sz_hash_batch_avx2(sz_sequence_t const *sequence, sz_u64_t *hashes) {
+
+    // Every one of the 8 lanes in 2 registers hashes a different string, blending away the exhausted lanes.
+    // Two independent registers hide the latency of the dependency chain within every step.
+    // AVX2 has no unsigned 64-bit comparisons, so both sides are flipped into the signed domain.
+    sz_u256_vec_t lengths_vecs[2], words_vecs[2], chars_low_vec, chars_high_vec;
+    sz_u256_vec_t hash_low_vecs[2], hash_high_vecs[2], next_low_vec, next_high_vec, active_vec;
+    __m256i const sign_vec = _mm256_set1_epi64x(0x8000000000000000ull);
+    __m256i const below_prime_vec = _mm256_set1_epi64x((SZ_U64_MAX_PRIME - 1) ^ 0x8000000000000000ull);
+    __m256i const prime_complement_vec = _mm256_set1_epi64x(0ull - SZ_U64_MAX_PRIME);
+    __m256i const shift_high_vec = _mm256_set1_epi64x(77);
+    __m256i const byte_mask_vec = _mm256_set1_epi64x(0xFF);
+    sz_u8_t const *starts[8];
+
+    sz_size_t const count = sequence->count;
+    sz_size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        sz_size_t max_length = 0;
+        for (sz_size_t lane = 0; lane != 8; ++lane) {
+            starts[lane] = (sz_u8_t const *)sequence->get_start(sequence, i + lane);
+            lengths_vecs[lane / 4].u64s[lane % 4] = sequence->get_length(sequence, i + lane);
+            max_length = sz_max_of_two(max_length, lengths_vecs[lane / 4].u64s[lane % 4]);
+        }
+
+        for (sz_size_t r = 0; r != 2; ++r)
+            hash_low_vecs[r].ymm = _mm256_setzero_si256(), hash_high_vecs[r].ymm = _mm256_setzero_si256();
+        for (sz_size_t offset = 0; offset < max_length; offset += 8) {
+            for (sz_size_t lane = 0; lane != 8; ++lane)
+                words_vecs[lane / 4].u64s[lane % 4] =
+                    _sz_hash_batch_load(starts[lane], lengths_vecs[lane / 4].u64s[lane % 4], offset);
+            for (sz_size_t k = 0; k != 8 && offset + k < max_length; ++k) {
+                for (sz_size_t r = 0; r != 2; ++r) {
+                    chars_low_vec.ymm = _mm256_and_si256(words_vecs[r].ymm, byte_mask_vec);
+                    chars_high_vec.ymm = _mm256_add_epi64(chars_low_vec.ymm, shift_high_vec);
+                    chars_high_vec.ymm = _mm256_and_si256(chars_high_vec.ymm, byte_mask_vec);
+                    words_vecs[r].ymm = _mm256_srli_epi64(words_vecs[r].ymm, 8);
+
+                    // Multiply by 31 and 257 with shifts, as AVX2 has no 64-bit multiplication.
+                    next_low_vec.ymm = _mm256_slli_epi64(hash_low_vecs[r].ymm, 5);
+                    next_low_vec.ymm = _mm256_sub_epi64(next_low_vec.ymm, hash_low_vecs[r].ymm);
+                    next_low_vec.ymm = _mm256_add_epi64(next_low_vec.ymm, chars_low_vec.ymm);
+                    next_high_vec.ymm = _mm256_slli_epi64(hash_high_vecs[r].ymm, 8);
+                    next_high_vec.ymm = _mm256_add_epi64(next_high_vec.ymm, hash_high_vecs[r].ymm);
+                    next_high_vec.ymm = _mm256_add_epi64(next_high_vec.ymm, chars_high_vec.ymm);
+
+                    // Compute the modulo by conditionally subtracting the prime.
+                    next_low_vec.ymm = _mm256_blendv_epi8(
+                        next_low_vec.ymm, _mm256_add_epi64(next_low_vec.ymm, prime_complement_vec),
+                        _mm256_cmpgt_epi64(_mm256_xor_si256(next_low_vec.ymm, sign_vec), below_prime_vec));
+                    next_high_vec.ymm = _mm256_blendv_epi8(
+                        next_high_vec.ymm, _mm256_add_epi64(next_high_vec.ymm, prime_complement_vec),
+                        _mm256_cmpgt_epi64(_mm256_xor_si256(next_high_vec.ymm, sign_vec), below_prime_vec));
+
+                    // Only update the lanes, where the strings are long enough.
+                    active_vec.ymm = _mm256_set1_epi64x((long long)(offset + k));
+                    active_vec.ymm = _mm256_cmpgt_epi64(lengths_vecs[r].ymm, active_vec.ymm);
+                    hash_low_vecs[r].ymm = _mm256_blendv_epi8(hash_low_vecs[r].ymm, next_low_vec.ymm, active_vec.ymm);
+                    hash_high_vecs[r].ymm =
+                        _mm256_blendv_epi8(hash_high_vecs[r].ymm, next_high_vec.ymm, active_vec.ymm);
+                }
+            }
+        }
+
+        // AVX2 can't multiply 64-bit integers, so the final mixing is serial.
+        for (sz_size_t lane = 0; lane != 8; ++lane)
+            hashes[i + lane] = (hash_low_vecs[lane / 4].u64s[lane % 4] * 11400714819323198485ull) ^
+                               (hash_high_vecs[lane / 4].u64s[lane % 4] * 11400714819323198485ull);
+    }
+
+    for (; i != count; ++i)
+        hashes[i] = sz_hash_serial(sequence->get_start(sequence, i), sequence->get_length(sequence, i));
+}
+
+/**
+ *  @brief  Computes the Needleman-Wunsch alignment score, evaluating the matrix in anti-diagonal order.
+ *          All the cells of an anti-diagonal depend only on the two previous anti-diagonals, so unlike the
+ *          horizontal order there is no running dependency between the neighboring cells.
+ *          The method uses 32-bit integers to accumulate the score, so it's limited to 2^24 characters long strings.
+ *
+ *  The substitution costs are fetched with the VPGATHERDD instruction, 8 at a time. Every lane loads 4 consecutive
+ *  bytes of the substitution matrix, and the needed one is then shifted into place and sign-extended. To avoid
+ *  reading past the end of the 256 x 256 matrix, the last 3 offsets are clamped and compensated with a shift.
+ *  The longer string is reversed once, so that the characters of both strings are loaded in forward order.
+ */
+SZ_PUBLIC sz_ssize_t sz_alignment_score_avx2(         //
+    sz_cptr_t longer, sz_size_t longer_length,        //
+    sz_cptr_t shorter, sz_size_t shorter_length,      //
+    sz_error_cost_t const *subs, sz_error_cost_t gap, //
+    sz_memory_allocator_t *alloc) {
+
+    // If one of the strings is empty - the edit distance is equal to the length of the other one
+    if (longer_length == 0) return (sz_ssize_t)shorter_length * gap;
+    if (shorter_length == 0) return (sz_ssize_t)longer_length * gap;
+
+    // Let's make sure that we use the amount proportional to the
+    // number of elements in the shorter string, not the larger.
+    if (shorter_length > longer_length) {
+        sz_pointer_swap((void **)&longer_length, (void **)&shorter_length);
+        sz_pointer_swap((void **)&longer, (void **)&shorter);
+    }
+    if (longer_length >= 256ull * 256ull * 256ull)
+        return sz_alignment_score_serial(longer, longer_length, shorter, shorter_length, subs, gap, alloc);
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    // We are going to store 3 anti-diagonals of the matrix, indexed by the position in the shorter string,
+    // and a reversed copy of the longer string.
+    sz_size_t const n = shorter_length + 1;
+    sz_size_t const buffer_length = sizeof(sz_i32_t) * n * 3 + longer_length;
+    sz_i32_t *const distances = (sz_i32_t *)alloc->allocate(buffer_length, alloc->handle);
+    if (!distances) return SZ_SSIZE_MAX;
+    sz_i32_t *previous_distances = distances;
+    sz_i32_t *current_distances = previous_distances + n;
+    sz_i32_t *next_distances = current_distances + n;
+    sz_u8_t *const longer_reversed = (sz_u8_t *)(next_distances + n);
+    sz_u8_t const *const longer_unsigned = (sz_u8_t const *)longer;
+    sz_u8_t const *const shorter_unsigned = (sz_u8_t const *)shorter;
+    for (sz_size_t i = 0; i != longer_length; ++i) longer_reversed[i] = longer_unsigned[longer_length - i - 1];
+
+    // Initialize the first two diagonals.
+    previous_distances[0] = 0;
+    current_distances[0] = current_distances[1] = gap;
+
+    __m256i const gap_vec = _mm256_set1_epi32(gap);
+    __m256i const last_offset_vec = _mm256_set1_epi32(256 * 256 - 4);
+    sz_size_t const diagonals_count = shorter_length + longer_length + 1;
+    for (sz_size_t diagonal = 2; diagonal != diagonals_count; ++diagonal) {
+        // The `i`-th cell of this diagonal is at the `i`-th row and the `diagonal - i`-th column of the matrix.
+        sz_size_t const first_row = diagonal > longer_length ? diagonal - longer_length : 1;
+        sz_size_t const last_row = sz_min_of_two(shorter_length, diagonal - 1);
+        if (diagonal <= longer_length) next_distances[0] = (sz_i32_t)diagonal * gap;
+        if (diagonal <= shorter_length) next_distances[diagonal] = (sz_i32_t)diagonal * gap;
+
+        // The `j - 1 = diagonal - i - 1` column maps to the `longer_length - diagonal + i` reversed character.
+        sz_u8_t const *const longer_chars = longer_reversed + longer_length - diagonal;
+        sz_size_t i = first_row;
+        for (; i + 8 <= last_row + 1; i += 8) {
+            __m256i shorter_vec = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i const *)(shorter_unsigned + i - 1)));
+            __m256i longer_vec = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i const *)(longer_chars + i)));
+            __m256i offsets_vec = _mm256_add_epi32(_mm256_slli_epi32(longer_vec, 8), shorter_vec);
+            __m256i clamped_vec = _mm256_min_epi32(offsets_vec, last_offset_vec);
+            __m256i shifts_vec = _mm256_slli_epi32(_mm256_sub_epi32(offsets_vec, clamped_vec), 3);
+            __m256i costs_vec = _mm256_i32gather_epi32((int const *)subs, clamped_vec, 1);
+            costs_vec = _mm256_srai_epi32(_mm256_slli_epi32(_mm256_srlv_epi32(costs_vec, shifts_vec), 24), 24);
+
+            __m256i substitution_vec = _mm256_loadu_si256((__m256i const *)(previous_distances + i - 1));
+            __m256i deletion_vec = _mm256_loadu_si256((__m256i const *)(current_distances + i - 1));
+            __m256i insertion_vec = _mm256_loadu_si256((__m256i const *)(current_distances + i));
+            substitution_vec = _mm256_add_epi32(substitution_vec, costs_vec);
+            deletion_vec = _mm256_add_epi32(_mm256_max_epi32(deletion_vec, insertion_vec), gap_vec);
+            _mm256_storeu_si256((__m256i *)(next_distances + i), _mm256_max_epi32(substitution_vec, deletion_vec));
+        }
+        for (; i <= last_row; ++i) {
+            sz_i32_t cost_substitution =
+                previous_distances[i - 1] + subs[longer_chars[i] * 256u + shorter_unsigned[i - 1]];
+            sz_i32_t cost_deletion_or_insertion = sz_max_of_two(current_distances[i - 1], current_distances[i]) + gap;
+            next_distances[i] = sz_max_of_two(cost_substitution, cost_deletion_or_insertion);
+        }
+
+        // Perform a circular rotation of those buffers, to reuse the memory.
+        sz_i32_t *temporary = previous_distances;
+        previous_distances = current_distances;
+        current_distances = next_distances;
+        next_distances = temporary;
+    }
+
+    // Cache scalar before `free` call.
+    sz_ssize_t result = current_distances[shorter_length];
+    alloc->free(distances, buffer_length, alloc->handle);
+    return result;
+}
+
 #pragma clang attribute pop
 #pragma GCC pop_options
 #endif
@@ -3860,8 +7194,8 @@ SZ_PUBLIC sz_ordering_t sz_order_avx512(sz_cptr_t a, sz_size_t a_length, sz_cptr
         mask_not_equal = _mm512_cmpneq_epi8_mask(a_vec.zmm, b_vec.zmm);
         if (mask_not_equal != 0) {
             int first_diff = _tzcnt_u64(mask_not_equal);
-            char a_char = a[first_diff];
-            char b_char = b[first_diff];
+            sz_u8_t a_char = a[first_diff];
+            sz_u8_t b_char = b[first_diff];
             return ordering_lookup[a_char < b_char];
         }
         a += 64, b += 64, a_length -= 64, b_length -= 64;
@@ -3876,11 +7210,13 @@ SZ_PUBLIC sz_ordering_t sz_order_avx512(sz_cptr_t a, sz_size_t a_length, sz_cptr
         // The AVX-512 `_mm512_mask_cmpneq_epi8_mask` intrinsics are generally handy in such environments.
         // They, however, have latency 3 on most modern CPUs. Using AVX2: `_mm256_cmpeq_epi8` would have
         // been cheaper, if we didn't have to apply `_mm256_movemask_epi8` afterwards.
-        mask_not_equal = _mm512_cmpneq_epi8_mask(a_vec.zmm, b_vec.zmm);
+        // Only the bytes present in both strings are compared, as the zero-padding of the shorter one
+        // may differ from the NULL characters in the longer one, pointing past the end of the shorter one.
+        mask_not_equal = _mm512_mask_cmpneq_epi8_mask(a_mask & b_mask, a_vec.zmm, b_vec.zmm);
         if (mask_not_equal != 0) {
             int first_diff = _tzcnt_u64(mask_not_equal);
-            char a_char = a[first_diff];
-            char b_char = b[first_diff];
+            sz_u8_t a_char = a[first_diff];
+            sz_u8_t b_char = b[first_diff];
             return ordering_lookup[a_char < b_char];
         }
         else
@@ -3971,15 +7307,12 @@ SZ_PUBLIC sz_cptr_t sz_find_byte_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr
     return SZ_NULL_CHAR;
 }
 
-SZ_PUBLIC sz_cptr_t sz_find_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
-
-    // This almost never fires, but it's better to be safe than sorry.
-    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
-    if (n_length == 1) return sz_find_byte_avx512(h, h_length, n);
-
-    // Pick the parts of the needle that are worth comparing.
-    sz_size_t offset_first, offset_mid, offset_last;
-    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+/**
+ *  @brief  Substring search kernel, comparing the three given needle bytes at 64 offsets at a time,
+ *          shared by ::sz_find_avx512 and ::sz_find_prepared_avx512.
+ */
+SZ_INTERNAL sz_cptr_t _sz_find_raita_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length, //
+                                            sz_size_t offset_first, sz_size_t offset_mid, sz_size_t offset_last) {
 
     // Broadcast those characters into ZMM registers.
     __mmask64 matches;
@@ -4014,8 +7347,9 @@ SZ_PUBLIC sz_cptr_t sz_find_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n,
         h_first_vec.zmm = _mm512_maskz_loadu_epi8(mask, h + offset_first);
         h_mid_vec.zmm = _mm512_maskz_loadu_epi8(mask, h + offset_mid);
         h_last_vec.zmm = _mm512_maskz_loadu_epi8(mask, h + offset_last);
+        // The zeroed lanes past the end would otherwise match the NULL characters in the needle.
         matches = _kand_mask64(_kand_mask64( // Intersect the masks
-                                   _mm512_cmpeq_epi8_mask(h_first_vec.zmm, n_first_vec.zmm),
+                                   _mm512_mask_cmpeq_epi8_mask(mask, h_first_vec.zmm, n_first_vec.zmm),
                                    _mm512_cmpeq_epi8_mask(h_mid_vec.zmm, n_mid_vec.zmm)),
                                _mm512_cmpeq_epi8_mask(h_last_vec.zmm, n_last_vec.zmm));
         while (matches) {
@@ -4027,6 +7361,294 @@ SZ_PUBLIC sz_cptr_t sz_find_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n,
     return SZ_NULL_CHAR;
 }
 
+SZ_PUBLIC sz_cptr_t sz_find_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
+
+    // This almost never fires, but it's better to be safe than sorry.
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+    if (n_length == 1) return sz_find_byte_avx512(h, h_length, n);
+
+    // Pick the parts of the needle that are worth comparing.
+    sz_size_t offset_first, offset_mid, offset_last;
+    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+
+    return _sz_find_raita_avx512(h, h_length, n, n_length, offset_first, offset_mid, offset_last);
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_prepared_avx512(sz_needle_t const *needle, sz_cptr_t h, sz_size_t h_length) {
+
+    sz_size_t const n_length = needle->length;
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+    if (n_length == 1) return sz_find_byte_avx512(h, h_length, needle->start);
+    return _sz_find_raita_avx512(h, h_length, needle->start, n_length, needle->offset_first, needle->offset_mid,
+                                 needle->offset_last);
+}
+
+/**
+ *  @brief  Vectorized version of ::sz_u8_tolower, that sets the 5th bit of the uppercase ASCII and Latin-1 letters.
+ *          Those form the [65, 90] and [192, 222] ranges, except for 215 - the multiplication sign.
+ */
+SZ_INTERNAL __m512i _sz_tolower_avx512(__m512i text) {
+    __mmask64 ascii_upper = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(text, _mm512_set1_epi8('A')), _mm512_set1_epi8(26));
+    __mmask64 latin_upper = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(text, _mm512_set1_epi8((char)192)),
+                                                   _mm512_set1_epi8(31));
+    latin_upper = _mm512_mask_cmpneq_epi8_mask(latin_upper, text, _mm512_set1_epi8((char)215));
+    return _mm512_mask_add_epi8(text, _kor_mask64(ascii_upper, latin_upper), text, _mm512_set1_epi8(0x20));
+}
+
+/**
+ *  @brief  Vectorized version of ::sz_u8_toupper, that clears the 5th bit of the lowercase ASCII and Latin-1 letters.
+ *          Those form the [97, 122] and [224, 254] ranges, except for 247 - the division sign.
+ */
+SZ_INTERNAL __m512i _sz_toupper_avx512(__m512i text) {
+    __mmask64 ascii_lower = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(text, _mm512_set1_epi8('a')), _mm512_set1_epi8(26));
+    __mmask64 latin_lower = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(text, _mm512_set1_epi8((char)224)),
+                                                   _mm512_set1_epi8(31));
+    latin_lower = _mm512_mask_cmpneq_epi8_mask(latin_lower, text, _mm512_set1_epi8((char)247));
+    return _mm512_mask_sub_epi8(text, _kor_mask64(ascii_lower, latin_lower), text, _mm512_set1_epi8(0x20));
+}
+
+SZ_PUBLIC void sz_tolower_avx512(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    for (; length >= 64; text += 64, result += 64, length -= 64)
+        _mm512_storeu_epi8(result, _sz_tolower_avx512(_mm512_loadu_epi8(text)));
+    __mmask64 mask = _sz_u64_mask_until(length);
+    _mm512_mask_storeu_epi8(result, mask, _sz_tolower_avx512(_mm512_maskz_loadu_epi8(mask, text)));
+}
+
+SZ_PUBLIC void sz_toupper_avx512(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    for (; length >= 64; text += 64, result += 64, length -= 64)
+        _mm512_storeu_epi8(result, _sz_toupper_avx512(_mm512_loadu_epi8(text)));
+    __mmask64 mask = _sz_u64_mask_until(length);
+    _mm512_mask_storeu_epi8(result, mask, _sz_toupper_avx512(_mm512_maskz_loadu_epi8(mask, text)));
+}
+
+SZ_PUBLIC void sz_toascii_avx512(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    __m512i const mask_vec = _mm512_set1_epi8(0x7F);
+    for (; length >= 64; text += 64, result += 64, length -= 64)
+        _mm512_storeu_epi8(result, _mm512_and_si512(_mm512_loadu_epi8(text), mask_vec));
+    __mmask64 mask = _sz_u64_mask_until(length);
+    _mm512_mask_storeu_epi8(result, mask, _mm512_and_si512(_mm512_maskz_loadu_epi8(mask, text), mask_vec));
+}
+
+SZ_PUBLIC sz_bool_t sz_isascii_avx512(sz_cptr_t text, sz_size_t length) {
+    // Merge pairs of registers to halve the number of mask extractions on longer inputs.
+    for (; length >= 128; text += 128, length -= 128)
+        if (_mm512_movepi8_mask(_mm512_or_si512(_mm512_loadu_epi8(text), _mm512_loadu_epi8(text + 64))))
+            return sz_false_k;
+    for (; length >= 64; text += 64, length -= 64)
+        if (_mm512_movepi8_mask(_mm512_loadu_epi8(text))) return sz_false_k;
+    return _mm512_movepi8_mask(_mm512_maskz_loadu_epi8(_sz_u64_mask_until(length), text)) ? sz_false_k : sz_true_k;
+}
+
+/**
+ *  @brief  Compares two strings of equal length, folding the case of both, like ::sz_tolower.
+ */
+SZ_INTERNAL sz_bool_t _sz_equal_case_insensitive_avx512(sz_cptr_t a, sz_cptr_t b, sz_size_t length) {
+    __mmask64 mask;
+    sz_u512_vec_t a_vec, b_vec;
+    for (; length >= 64; a += 64, b += 64, length -= 64) {
+        a_vec.zmm = _sz_tolower_avx512(_mm512_loadu_epi8(a));
+        b_vec.zmm = _sz_tolower_avx512(_mm512_loadu_epi8(b));
+        if (_mm512_cmpneq_epi8_mask(a_vec.zmm, b_vec.zmm)) return sz_false_k;
+    }
+    mask = _sz_u64_mask_until(length);
+    a_vec.zmm = _sz_tolower_avx512(_mm512_maskz_loadu_epi8(mask, a));
+    b_vec.zmm = _sz_tolower_avx512(_mm512_maskz_loadu_epi8(mask, b));
+    return _mm512_mask_cmpneq_epi8_mask(mask, a_vec.zmm, b_vec.zmm) ? sz_false_k : sz_true_k;
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_case_insensitive_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n,
+                                                    sz_size_t n_length) {
+
+    // This almost never fires, but it's better to be safe than sorry.
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+
+    // Pick the parts of the needle that are worth comparing.
+    sz_size_t offset_first, offset_mid, offset_last;
+    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+
+    // Broadcast the folded characters into ZMM registers, along with the bits to set in the haystack.
+    __mmask64 matches;
+    __mmask64 mask;
+    sz_u512_vec_t h_first_vec, h_mid_vec, h_last_vec, n_first_vec, n_mid_vec, n_last_vec;
+    sz_u512_vec_t n_first_bit_vec, n_mid_bit_vec, n_last_bit_vec;
+    sz_u8_t const n_first = sz_u8_tolower((sz_u8_t)n[offset_first]);
+    sz_u8_t const n_mid = sz_u8_tolower((sz_u8_t)n[offset_mid]);
+    sz_u8_t const n_last = sz_u8_tolower((sz_u8_t)n[offset_last]);
+    n_first_vec.zmm = _mm512_set1_epi8((char)n_first);
+    n_mid_vec.zmm = _mm512_set1_epi8((char)n_mid);
+    n_last_vec.zmm = _mm512_set1_epi8((char)n_last);
+    n_first_bit_vec.zmm = _mm512_set1_epi8((char)_sz_case_insensitive_filter_bit(n_first));
+    n_mid_bit_vec.zmm = _mm512_set1_epi8((char)_sz_case_insensitive_filter_bit(n_mid));
+    n_last_bit_vec.zmm = _mm512_set1_epi8((char)_sz_case_insensitive_filter_bit(n_last));
+
+    // Scan through the string, without fully folding the haystack characters.
+    for (; h_length >= n_length + 64; h += 64, h_length -= 64) {
+        h_first_vec.zmm = _mm512_or_si512(_mm512_loadu_epi8(h + offset_first), n_first_bit_vec.zmm);
+        h_mid_vec.zmm = _mm512_or_si512(_mm512_loadu_epi8(h + offset_mid), n_mid_bit_vec.zmm);
+        h_last_vec.zmm = _mm512_or_si512(_mm512_loadu_epi8(h + offset_last), n_last_bit_vec.zmm);
+        matches = _kand_mask64(_kand_mask64( // Intersect the masks
+                                   _mm512_cmpeq_epi8_mask(h_first_vec.zmm, n_first_vec.zmm),
+                                   _mm512_cmpeq_epi8_mask(h_mid_vec.zmm, n_mid_vec.zmm)),
+                               _mm512_cmpeq_epi8_mask(h_last_vec.zmm, n_last_vec.zmm));
+        while (matches) {
+            int potential_offset = sz_u64_ctz(matches);
+            if (_sz_equal_case_insensitive_avx512(h + potential_offset, n, n_length))
+                return h + potential_offset;
+            matches &= matches - 1;
+        }
+    }
+
+    // The "tail" of the function uses masked loads to process the remaining bytes.
+    {
+        mask = _sz_u64_mask_until(h_length - n_length + 1);
+        h_first_vec.zmm = _mm512_or_si512(_mm512_maskz_loadu_epi8(mask, h + offset_first), n_first_bit_vec.zmm);
+        h_mid_vec.zmm = _mm512_or_si512(_mm512_maskz_loadu_epi8(mask, h + offset_mid), n_mid_bit_vec.zmm);
+        h_last_vec.zmm = _mm512_or_si512(_mm512_maskz_loadu_epi8(mask, h + offset_last), n_last_bit_vec.zmm);
+        matches = _kand_mask64(_kand_mask64( // Intersect the masks
+                                   _mm512_mask_cmpeq_epi8_mask(mask, h_first_vec.zmm, n_first_vec.zmm),
+                                   _mm512_cmpeq_epi8_mask(h_mid_vec.zmm, n_mid_vec.zmm)),
+                               _mm512_cmpeq_epi8_mask(h_last_vec.zmm, n_last_vec.zmm));
+        while (matches) {
+            int potential_offset = sz_u64_ctz(matches);
+            if (_sz_equal_case_insensitive_avx512(h + potential_offset, n, n_length))
+                return h + potential_offset;
+            matches &= matches - 1;
+        }
+    }
+    return SZ_NULL_CHAR;
+}
+
+/**
+ *  @brief  Computes the UTF8 validation errors for a block of 64 bytes with three nibble lookups, following the
+ *          "Validating UTF-8 In Less Than One Instruction Per Byte" paper by John Keiser and Daniel Lemire.
+ *
+ *  @param  text_vec        Current block of text.
+ *  @param  previous_vec    Previous block of text, needed to check the runes crossing the boundary.
+ *  @return                 Zero vector, if the block has no errors.
+ *  @see    https://arxiv.org/abs/2010.03090
+ */
+SZ_INTERNAL __m512i _sz_utf8_errors_avx512(__m512i text_vec, __m512i previous_vec) {
+
+    // Every lookup depends on one nibble of either the previous or the current byte, and reports a set of
+    // error classes, that can be detected by looking at two consecutive bytes:
+    //
+    //      0x01 - too short: a leading byte is followed by a non-continuation byte.
+    //      0x02 - too long: a continuation byte follows an ASCII byte.
+    //      0x04 - overlong 3-byte rune: 11100000 100_____.
+    //      0x08 - too large: 11110100 1001____ and above.
+    //      0x10 - surrogate: 11101101 101_____.
+    //      0x20 - overlong 2-byte rune: 1100000_ 10______.
+    //      0x40 - overlong 4-byte rune: 11110000 1000____, or too large: 11110101 1000____ and above.
+    //      0x80 - two continuations: 10______ 10______, legal only in 3- and 4-byte runes.
+    //
+    // Only the classes present in all three lookups are real errors.
+    static sz_u8_t const byte_1_high_lut[16] = {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+                                                0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49};
+    static sz_u8_t const byte_1_low_lut[16] = {0xE7, 0xA3, 0x83, 0x83, 0x8B, 0xCB, 0xCB, 0xCB,
+                                               0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xDB, 0xCB, 0xCB};
+    static sz_u8_t const byte_2_high_lut[16] = {0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+                                                0xE6, 0xAE, 0xBA, 0xBA, 0x01, 0x01, 0x01, 0x01};
+    // The masked broadcasts avoid GCC warnings about the undefined source of `_mm512_broadcast_i32x4`.
+    __mmask16 const all_words = 0xFFFF;
+    __m512i const byte_1_high_lut_vec =
+        _mm512_maskz_broadcast_i32x4(all_words, _mm_loadu_si128((__m128i const *)byte_1_high_lut));
+    __m512i const byte_1_low_lut_vec =
+        _mm512_maskz_broadcast_i32x4(all_words, _mm_loadu_si128((__m128i const *)byte_1_low_lut));
+    __m512i const byte_2_high_lut_vec =
+        _mm512_maskz_broadcast_i32x4(all_words, _mm_loadu_si128((__m128i const *)byte_2_high_lut));
+    __m512i const nibble_mask_vec = _mm512_set1_epi8(0x0F);
+
+    // The `VPALIGNR` works within 128-bit lanes, so we first shift the whole register by one lane.
+    __m512i const lanes_shifted_vec =
+        _mm512_permutex2var_epi64(text_vec, _mm512_set_epi64(5, 4, 3, 2, 1, 0, 15, 14), previous_vec);
+    __m512i const prev1_vec = _mm512_alignr_epi8(text_vec, lanes_shifted_vec, 15);
+    __m512i const prev2_vec = _mm512_alignr_epi8(text_vec, lanes_shifted_vec, 14);
+    __m512i const prev3_vec = _mm512_alignr_epi8(text_vec, lanes_shifted_vec, 13);
+
+    __m512i const byte_1_high_vec = _mm512_shuffle_epi8(
+        byte_1_high_lut_vec, _mm512_and_si512(_mm512_srli_epi16(prev1_vec, 4), nibble_mask_vec));
+    __m512i const byte_1_low_vec =
+        _mm512_shuffle_epi8(byte_1_low_lut_vec, _mm512_and_si512(prev1_vec, nibble_mask_vec));
+    __m512i const byte_2_high_vec = _mm512_shuffle_epi8(
+        byte_2_high_lut_vec, _mm512_and_si512(_mm512_srli_epi16(text_vec, 4), nibble_mask_vec));
+    __m512i const special_cases_vec =
+        _mm512_ternarylogic_epi64(byte_1_high_vec, byte_1_low_vec, byte_2_high_vec, 0x80); // a & b & c
+
+    // The third and fourth bytes of the runes must be continuations, which the lookups don't check.
+    __m512i const is_third_byte_vec = _mm512_subs_epu8(prev2_vec, _mm512_set1_epi8((char)(0xE0 - 0x80)));
+    __m512i const is_fourth_byte_vec = _mm512_subs_epu8(prev3_vec, _mm512_set1_epi8((char)(0xF0 - 0x80)));
+    __m512i const must_be_continuation_vec =
+        _mm512_and_si512(_mm512_or_si512(is_third_byte_vec, is_fourth_byte_vec), _mm512_set1_epi8((char)0x80));
+    return _mm512_xor_si512(must_be_continuation_vec, special_cases_vec);
+}
+
+SZ_PUBLIC sz_bool_t sz_utf8_valid_avx512(sz_cptr_t text, sz_size_t length) {
+
+    // The last three bytes of a block can't start runes, that don't fit into it.
+    sz_u512_vec_t text_vec, previous_vec, errors_vec, incomplete_vec, max_tail_vec;
+    max_tail_vec.zmm = _mm512_set1_epi8((char)0xFF);
+    max_tail_vec.zmm = _mm512_mask_set1_epi8(max_tail_vec.zmm, 1ull << 61, (char)(0xF0 - 1));
+    max_tail_vec.zmm = _mm512_mask_set1_epi8(max_tail_vec.zmm, 1ull << 62, (char)(0xE0 - 1));
+    max_tail_vec.zmm = _mm512_mask_set1_epi8(max_tail_vec.zmm, 1ull << 63, (char)(0xC0 - 1));
+    previous_vec.zmm = errors_vec.zmm = incomplete_vec.zmm = _mm512_setzero_si512();
+
+    while (length) {
+        sz_size_t const load_length = sz_min_of_two(length, 64);
+        text_vec.zmm = _mm512_maskz_loadu_epi8(_sz_u64_mask_until(load_length), text);
+
+        // ASCII blocks are valid on their own, but may terminate the runes started in the previous block.
+        if (!_mm512_movepi8_mask(text_vec.zmm)) {
+            errors_vec.zmm = _mm512_or_si512(errors_vec.zmm, incomplete_vec.zmm);
+        }
+        else {
+            errors_vec.zmm = _mm512_or_si512(errors_vec.zmm, _sz_utf8_errors_avx512(text_vec.zmm, previous_vec.zmm));
+            incomplete_vec.zmm = _mm512_subs_epu8(text_vec.zmm, max_tail_vec.zmm);
+        }
+        // Exit early on errors.
+        if (_mm512_test_epi8_mask(errors_vec.zmm, errors_vec.zmm)) return sz_false_k;
+        previous_vec.zmm = text_vec.zmm;
+        text += load_length, length -= load_length;
+    }
+
+    // Runes truncated by the end of the string.
+    errors_vec.zmm = _mm512_or_si512(errors_vec.zmm, incomplete_vec.zmm);
+    return (sz_bool_t)!_mm512_test_epi8_mask(errors_vec.zmm, errors_vec.zmm);
+}
+
+SZ_PUBLIC sz_size_t sz_utf8_count_avx512(sz_cptr_t text, sz_size_t length) {
+    // All the bytes, except for the continuation bytes `10xxxxxx`, are larger than -65 in two's complement.
+    sz_u512_vec_t text_vec, continuation_max_vec;
+    continuation_max_vec.zmm = _mm512_set1_epi8((char)0xBF);
+    sz_size_t count = 0;
+    for (; length >= 64; text += 64, length -= 64) {
+        text_vec.zmm = _mm512_loadu_epi8(text);
+        count += sz_u64_popcount(_mm512_cmpgt_epi8_mask(text_vec.zmm, continuation_max_vec.zmm));
+    }
+    if (length) {
+        __mmask64 mask = _sz_u64_mask_until(length);
+        text_vec.zmm = _mm512_maskz_loadu_epi8(mask, text);
+        count += sz_u64_popcount(_mm512_mask_cmpgt_epi8_mask(mask, text_vec.zmm, continuation_max_vec.zmm));
+    }
+    return count;
+}
+
+SZ_PUBLIC sz_cptr_t sz_utf8_find_nth_avx512(sz_cptr_t text, sz_size_t length, sz_size_t n) {
+    sz_u512_vec_t text_vec, continuation_max_vec;
+    continuation_max_vec.zmm = _mm512_set1_epi8((char)0xBF);
+    while (length) {
+        sz_size_t const load_length = sz_min_of_two(length, 64);
+        __mmask64 mask = _sz_u64_mask_until(load_length);
+        text_vec.zmm = _mm512_maskz_loadu_epi8(mask, text);
+        sz_u64_t leads = _mm512_mask_cmpgt_epi8_mask(mask, text_vec.zmm, continuation_max_vec.zmm);
+        sz_size_t const leads_count = sz_u64_popcount(leads);
+        // Deposit a single bit into the position of the n-th set bit of the `leads` mask.
+        if (n < leads_count) return text + sz_u64_ctz(_pdep_u64(1ull << n, leads));
+        n -= leads_count;
+        text += load_length, length -= load_length;
+    }
+    return SZ_NULL_CHAR;
+}
+
 SZ_PUBLIC sz_cptr_t sz_rfind_byte_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n) {
     __mmask64 mask;
     sz_u512_vec_t h_vec, n_vec;
@@ -4095,8 +7717,9 @@ SZ_PUBLIC sz_cptr_t sz_rfind_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n
         h_first_vec.zmm = _mm512_maskz_loadu_epi8(mask, h + offset_first);
         h_mid_vec.zmm = _mm512_maskz_loadu_epi8(mask, h + offset_mid);
         h_last_vec.zmm = _mm512_maskz_loadu_epi8(mask, h + offset_last);
+        // The zeroed lanes past the end would otherwise match the NULL characters in the needle.
         matches = _kand_mask64(_kand_mask64( // Intersect the masks
-                                   _mm512_cmpeq_epi8_mask(h_first_vec.zmm, n_first_vec.zmm),
+                                   _mm512_mask_cmpeq_epi8_mask(mask, h_first_vec.zmm, n_first_vec.zmm),
                                    _mm512_cmpeq_epi8_mask(h_mid_vec.zmm, n_mid_vec.zmm)),
                                _mm512_cmpeq_epi8_mask(h_last_vec.zmm, n_last_vec.zmm));
         while (matches) {
@@ -4112,14 +7735,55 @@ SZ_PUBLIC sz_cptr_t sz_rfind_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n
     return SZ_NULL_CHAR;
 }
 
-SZ_INTERNAL sz_size_t _sz_edit_distance_skewed_diagonals_upto65k_avx512( //
-    sz_cptr_t shorter, sz_size_t shorter_length,                         //
-    sz_cptr_t longer, sz_size_t longer_length,                           //
-    sz_size_t bound, sz_memory_allocator_t *alloc) {
+SZ_PUBLIC sz_cptr_t sz_find_any_avx512(sz_multi_pattern_t const *pattern, sz_cptr_t h, sz_size_t h_length,
+                                       sz_size_t *needle_id) {
 
-    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
-    sz_memory_allocator_t global_alloc;
-    if (!alloc) {
+    sz_size_t const probe_length = pattern->probe_length;
+    if (!probe_length || h_length < probe_length) return SZ_NULL_CHAR;
+
+    // Every probed position has two lookup tables - for the low and the high nibbles of incoming bytes.
+    sz_u512_vec_t low_nibbles_vecs[3], high_nibbles_vecs[3], low_nibbles_mask_vec;
+    sz_u512_vec_t h_vec, h_low_vec, h_high_vec, buckets_vec;
+    for (sz_size_t k = 0; k != probe_length; ++k) {
+        low_nibbles_vecs[k].zmm = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i const *)&pattern->low_nibbles[k][0]));
+        high_nibbles_vecs[k].zmm =
+            _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i const *)&pattern->high_nibbles[k][0]));
+    }
+    low_nibbles_mask_vec.zmm = _mm512_set1_epi8(0x0F);
+
+    // Masked loads let us process the tail in the same loop, without falling back to the serial code.
+    sz_size_t const candidates_count = h_length - probe_length + 1;
+    for (sz_size_t offset = 0; offset < candidates_count; offset += 64) {
+        __mmask64 mask = _sz_u64_mask_until(sz_min_of_two(candidates_count - offset, 64));
+        buckets_vec.zmm = _mm512_set1_epi8((char)0xFF);
+        for (sz_size_t k = 0; k != probe_length; ++k) {
+            h_vec.zmm = _mm512_maskz_loadu_epi8(mask, h + offset + k);
+            h_low_vec.zmm = _mm512_and_si512(h_vec.zmm, low_nibbles_mask_vec.zmm);
+            h_high_vec.zmm = _mm512_and_si512(_mm512_srli_epi16(h_vec.zmm, 4), low_nibbles_mask_vec.zmm);
+            h_low_vec.zmm = _mm512_shuffle_epi8(low_nibbles_vecs[k].zmm, h_low_vec.zmm);
+            h_high_vec.zmm = _mm512_shuffle_epi8(high_nibbles_vecs[k].zmm, h_high_vec.zmm);
+            buckets_vec.zmm = _mm512_and_si512(buckets_vec.zmm, _mm512_and_si512(h_low_vec.zmm, h_high_vec.zmm));
+        }
+        sz_u64_t matches = _mm512_mask_test_epi8_mask(mask, buckets_vec.zmm, buckets_vec.zmm);
+        for (; matches; matches &= matches - 1) {
+            int potential_offset = sz_u64_ctz(matches);
+            if (_sz_find_any_verify(pattern, h + offset + potential_offset, h_length - offset - potential_offset,
+                                    buckets_vec.u8s[potential_offset], needle_id))
+                return h + offset + potential_offset;
+        }
+    }
+
+    return SZ_NULL_CHAR;
+}
+
+SZ_INTERNAL sz_size_t _sz_edit_distance_skewed_diagonals_upto65k_avx512( //
+    sz_cptr_t shorter, sz_size_t shorter_length,                         //
+    sz_cptr_t longer, sz_size_t longer_length,                           //
+    sz_size_t bound, sz_memory_allocator_t *alloc) {
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
         sz_memory_allocator_init_default(&global_alloc);
         alloc = &global_alloc;
     }
@@ -4253,16 +7917,401 @@ SZ_INTERNAL sz_size_t _sz_edit_distance_skewed_diagonals_upto65k_avx512( //
     return result;
 }
 
+/**
+ *  @brief  Computes the Levenshtein distance with the bit-parallel Myers-Hyyrö algorithm, treating a whole ZMM
+ *          register as a single 512-bit word, for shorter strings of up to 512 bytes. The carries of the addition
+ *          and the bits of the shifts are propagated between the 64-bit lanes using mask-register arithmetic.
+ *  @see    _sz_edit_distance_myers64_serial
+ */
+SZ_INTERNAL sz_size_t _sz_edit_distance_myers512_avx512( //
+    sz_cptr_t longer, sz_size_t longer_length,           //
+    sz_cptr_t shorter, sz_size_t shorter_length,         //
+    sz_size_t bound, sz_memory_allocator_t *alloc) {
+
+    sz_assert(shorter_length && shorter_length <= 512 && "The shorter string must fit into a single register.");
+    sz_size_t const buffer_length = sizeof(sz_u512_vec_t) * 256;
+    sz_u512_vec_t *const matches = (sz_u512_vec_t *)alloc->allocate(buffer_length, alloc->handle);
+    if (!matches) return SZ_SIZE_MAX;
+
+    sz_u8_t const *const longer_bytes = (sz_u8_t const *)longer;
+    sz_u8_t const *const shorter_bytes = (sz_u8_t const *)shorter;
+    __m512i const zeros = _mm512_setzero_si512();
+    __m512i const ones = _mm512_set1_epi64(-1);
+    for (sz_size_t i = 0; i != 256; ++i) _mm512_storeu_si512(&matches[i].zmm, zeros);
+    for (sz_size_t i = 0; i != shorter_length; ++i)
+        matches[shorter_bytes[i]].u64s[i / 64] |= (sz_u64_t)1 << (i % 64);
+
+    // Only one bit is set in the whole register, marking the last cell of the column.
+    __m512i const last_bit = _mm512_maskz_set1_epi64((__mmask8)(1u << ((shorter_length - 1) / 64)),
+                                                     (long long)((sz_u64_t)1 << ((shorter_length - 1) % 64)));
+    // The first row of the matrix grows by one with every character, so we shift in a positive delta.
+    __m512i const first_bit = _mm512_maskz_set1_epi64(1, 1);
+
+    __m512i vertical_positive = ones, vertical_negative = zeros;
+    sz_size_t distance = shorter_length;
+    for (sz_size_t i = 0; i != longer_length; ++i) {
+        __m512i match = _mm512_loadu_si512(&matches[longer_bytes[i]].zmm);
+        __m512i vertical_or_match = _mm512_or_si512(match, vertical_negative);
+
+        // Compute the 512-bit `(match & vertical_positive) + vertical_positive`, where lanes that overflow generate
+        // a carry, and lanes that are all ones propagate it further, just like the bits in a scalar addition.
+        __m512i sum = _mm512_add_epi64(_mm512_and_si512(match, vertical_positive), vertical_positive);
+        unsigned generated = _mm512_cmplt_epu64_mask(sum, vertical_positive);
+        unsigned propagated = _mm512_cmpeq_epu64_mask(sum, ones);
+        unsigned carried = (((generated << 1) + propagated) ^ propagated) & 0xFFu;
+        sum = _mm512_mask_sub_epi64(sum, (__mmask8)carried, sum, ones);
+
+        // The diagonal is `(sum ^ vertical_positive) | match`.
+        __m512i diagonal = _mm512_ternarylogic_epi64(sum, vertical_positive, match, 0xBE);
+        // The horizontal positive is `vertical_negative | ~(diagonal | vertical_positive)`.
+        __m512i horizontal_positive = _mm512_ternarylogic_epi64(vertical_negative, diagonal, vertical_positive, 0xF1);
+        __m512i horizontal_negative = _mm512_and_si512(vertical_positive, diagonal);
+        distance += _mm512_test_epi64_mask(horizontal_positive, last_bit) != 0;
+        distance -= _mm512_test_epi64_mask(horizontal_negative, last_bit) != 0;
+
+        // Shift both 512-bit words left by one, moving the top bit of every lane into the bottom of the next one.
+        horizontal_positive = _mm512_or_si512(
+            _mm512_slli_epi64(horizontal_positive, 1),
+            _mm512_alignr_epi64(_mm512_srli_epi64(horizontal_positive, 63), zeros, 7));
+        horizontal_positive = _mm512_or_si512(horizontal_positive, first_bit);
+        horizontal_negative = _mm512_or_si512(
+            _mm512_slli_epi64(horizontal_negative, 1),
+            _mm512_alignr_epi64(_mm512_srli_epi64(horizontal_negative, 63), zeros, 7));
+
+        // The vertical positive is `horizontal_negative | ~(vertical_or_match | horizontal_positive)`.
+        vertical_positive = _mm512_ternarylogic_epi64(horizontal_negative, vertical_or_match, horizontal_positive, 0xF1);
+        vertical_negative = _mm512_and_si512(horizontal_positive, vertical_or_match);
+
+        // Every remaining character can reduce the distance by one at most.
+        if (bound && distance >= bound + (longer_length - i - 1)) {
+            distance = bound;
+            break;
+        }
+    }
+
+    alloc->free(matches, buffer_length, alloc->handle);
+    return bound ? sz_min_of_two(distance, bound) : distance;
+}
+
 SZ_INTERNAL sz_size_t sz_edit_distance_avx512(   //
     sz_cptr_t shorter, sz_size_t shorter_length, //
     sz_cptr_t longer, sz_size_t longer_length,   //
     sz_size_t bound, sz_memory_allocator_t *alloc) {
 
-    if (shorter_length == longer_length && !bound && shorter_length && shorter_length < 256u * 256u)
-        return _sz_edit_distance_skewed_diagonals_upto65k_avx512(shorter, shorter_length, longer, longer_length, bound,
-                                                                 alloc);
+    // The bit-parallel algorithm beats the diagonal kernels on all lengths, but the carry propagation across the
+    // lanes of a ZMM register only pays off, when the shorter string spans at least 4-5 words.
+    // The shorter ones are handled by the scalar variants, where the shortest ones don't even touch the allocator.
+    _sz_edit_distance_skip_affixes(&longer, &longer_length, &shorter, &shorter_length);
+    if (shorter_length > 256 && shorter_length <= 512 && (!bound || longer_length - shorter_length <= bound)) {
+        // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+        sz_memory_allocator_t global_alloc;
+        if (!alloc) {
+            sz_memory_allocator_init_default(&global_alloc);
+            alloc = &global_alloc;
+        }
+        return _sz_edit_distance_myers512_avx512(longer, longer_length, shorter, shorter_length, bound, alloc);
+    }
     else
-        return sz_edit_distance_serial(shorter, shorter_length, longer, longer_length, bound, alloc);
+        return sz_edit_distance_serial(longer, longer_length, shorter, shorter_length, bound, alloc);
+}
+
+/**
+ *  @brief  Shifts a 512-bit word left by one, moving the top bit of every lane into the bottom of the next one.
+ */
+SZ_INTERNAL __m512i _sz_shift_left_u512_avx512(__m512i word) {
+    return _mm512_or_si512(_mm512_slli_epi64(word, 1),
+                           _mm512_alignr_epi64(_mm512_srli_epi64(word, 63), _mm512_setzero_si512(), 7));
+}
+
+/**
+ *  @brief  Finds the end of the first approximate match with the Wu-Manber algorithm for needles of up to 512 bytes,
+ *          treating a whole ZMM register as a single 512-bit state, with bits shifted between the 64-bit lanes.
+ *  @param  buffer  At least `256 + max_edits + 1` registers of scratch space.
+ *  @see    _sz_find_fuzzy_end_serial
+ */
+SZ_INTERNAL sz_size_t _sz_find_fuzzy_end_upto512bytes_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n,
+                                                             sz_size_t n_length, sz_size_t max_edits,
+                                                             sz_u512_vec_t *buffer, sz_size_t *match_edits) {
+
+    sz_assert(n_length && n_length <= 512 && "The needle must fit into a single register.");
+    sz_u512_vec_t *const matches = buffer;
+    sz_u512_vec_t *const states = buffer + 256;
+    _sz_find_fuzzy_masks_serial(n, n_length, 8, sz_false_k, &matches[0].u64s[0]);
+
+    // Before consuming any characters, the prefixes of up to `d` characters are matched with `d` deletions.
+    __m512i const zeros = _mm512_setzero_si512();
+    for (sz_size_t d = 0; d <= max_edits; ++d) _mm512_storeu_si512(&states[d].zmm, zeros);
+    for (sz_size_t d = 1; d <= max_edits; ++d)
+        for (sz_size_t i = 0; i != d; ++i) states[d].u64s[i / 64] |= (sz_u64_t)1 << (i % 64);
+
+    // Only one bit is set in the whole register, marking the whole needle.
+    __m512i const last_bit = _mm512_maskz_set1_epi64((__mmask8)(1u << ((n_length - 1) / 64)),
+                                                     (long long)((sz_u64_t)1 << ((n_length - 1) % 64)));
+    // Any offset of the haystack may start a match, so the empty prefix of the needle is always shifted in.
+    __m512i const first_bit = _mm512_maskz_set1_epi64(1, 1);
+
+    sz_u8_t const *const h_bytes = (sz_u8_t const *)h;
+    sz_size_t end = SZ_SIZE_MAX;
+    sz_size_t edits = SZ_SIZE_MAX;
+    for (sz_size_t d = 0; d <= max_edits && edits == SZ_SIZE_MAX; ++d)
+        if (_mm512_test_epi64_mask(_mm512_loadu_si512(&states[d].zmm), last_bit)) edits = d, end = 0;
+
+    for (sz_size_t i = 0; i != h_length && edits; ++i) {
+        __m512i const match = _mm512_loadu_si512(&matches[h_bytes[i]].zmm);
+        __m512i lower_old = _mm512_loadu_si512(&states[0].zmm);
+        __m512i lower_new = _mm512_and_si512(_mm512_or_si512(_sz_shift_left_u512_avx512(lower_old), first_bit), match);
+        _mm512_storeu_si512(&states[0].zmm, lower_new);
+        sz_size_t new_edits = _mm512_test_epi64_mask(lower_new, last_bit) ? 0 : SZ_SIZE_MAX;
+        for (sz_size_t d = 1; d <= max_edits; ++d) {
+            __m512i const current = _mm512_loadu_si512(&states[d].zmm);
+            // Matching the character extends the prefix of the same state, inserting it keeps the lower prefix,
+            // substituting it or deleting a needle character extends the lower prefix.
+            __m512i const matched = _mm512_and_si512(_mm512_or_si512(_sz_shift_left_u512_avx512(current), first_bit),
+                                                     match);
+            __m512i const extended = _sz_shift_left_u512_avx512(_mm512_or_si512(lower_old, lower_new));
+            // The next state is `matched | lower_old | extended | first_bit`.
+            __m512i const next = _mm512_or_si512(_mm512_ternarylogic_epi64(matched, lower_old, extended, 0xFE),
+                                                 first_bit);
+            _mm512_storeu_si512(&states[d].zmm, next);
+            if (new_edits == SZ_SIZE_MAX && _mm512_test_epi64_mask(next, last_bit)) new_edits = d;
+            lower_old = current, lower_new = next;
+        }
+        if (new_edits < edits) end = i + 1, edits = new_edits;
+        // Once the match is found, keep going only while the following characters reduce the number of edits.
+        else if (end != SZ_SIZE_MAX) break;
+    }
+    *match_edits = edits;
+    return end;
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_fuzzy_avx512(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length, //
+                                         sz_size_t max_edits, sz_memory_allocator_t *alloc, sz_size_t *match_length) {
+
+    // Just like with `sz_edit_distance_avx512`, shifting bits across the lanes only pays off for multi-word needles,
+    // while the longest needles don't fit into a single register.
+    if (n_length <= 64 || n_length > 512)
+        return sz_find_fuzzy_serial(h, h_length, n, n_length, max_edits, alloc, match_length);
+
+    sz_size_t unused_length;
+    if (!match_length) match_length = &unused_length;
+    *match_length = 0;
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    // The same buffer is later reused by the serial backward pass, that needs fewer words per row.
+    max_edits = sz_min_of_two(max_edits, n_length);
+    sz_size_t const buffer_length = sizeof(sz_u512_vec_t) * (256 + max_edits + 2);
+    sz_u512_vec_t *const buffer = (sz_u512_vec_t *)alloc->allocate(buffer_length, alloc->handle);
+    if (!buffer) {
+        *match_length = SZ_SIZE_MAX;
+        return SZ_NULL_CHAR;
+    }
+
+    sz_size_t edits;
+    sz_size_t const end = _sz_find_fuzzy_end_upto512bytes_avx512(h, h_length, n, n_length, max_edits, buffer, &edits);
+    sz_size_t const start =
+        end != SZ_SIZE_MAX ? _sz_find_fuzzy_start_serial(h, end, n, n_length, edits, &buffer[0].u64s[0]) : 0;
+    alloc->free(buffer, buffer_length, alloc->handle);
+    if (end == SZ_SIZE_MAX) return SZ_NULL_CHAR;
+    *match_length = end - start;
+    return h + start;
+}
+
+/**
+ *  @brief  Evaluates the Wagner-Fisher matrices of up to 64 candidates at once, one per 8-bit lane of a ZMM register,
+ *          stepping through the rows of all the candidates in lockstep, while the query spans the columns.
+ *          All the lengths must be under 255, so that the saturating 8-bit arithmetic never overflows.
+ *
+ *  @param  transposed  The candidates' characters, with the `i`-th character of every lane in the `i`-th 64 bytes.
+ *  @param  lengths_vec Lengths of the candidates in every lane.
+ *  @param  row         Scratch space for `query_length + 1` vectors of 64 bytes, containing one matrix row per lane.
+ */
+SZ_INTERNAL sz_u512_vec_t _sz_edit_distances_lanes_avx512( //
+    sz_cptr_t query, sz_size_t query_length,               //
+    sz_u8_t const *transposed, sz_u512_vec_t lengths_vec, __mmask64 lanes_mask, sz_size_t max_length, //
+    sz_size_t bound, sz_u8_t *row) {
+
+    sz_u512_vec_t ones_vec, bound_vec, results_vec;
+    ones_vec.zmm = _mm512_set1_epi8(1);
+    bound_vec.zmm = _mm512_set1_epi8((char)(bound && bound < 255 ? bound : 255));
+    results_vec.zmm = _mm512_set1_epi8((char)query_length);
+
+    // Initialize the first row of the Levenshtein matrix with `iota`-style arithmetic progression.
+    for (sz_size_t j = 0; j <= query_length; ++j) _mm512_storeu_si512(row + 64 * j, _mm512_set1_epi8((char)j));
+
+    // Empty candidates are resolved right away, as the distance is equal to the length of the query.
+    __mmask64 pending_mask = lanes_mask & ~_mm512_cmpeq_epi8_mask(lengths_vec.zmm, _mm512_setzero_si512());
+    for (sz_size_t i = 1; i <= max_length && pending_mask; ++i) {
+        sz_u512_vec_t chars_vec, diagonal_vec, left_vec, up_vec, row_min_vec, substitution_vec;
+        chars_vec.zmm = _mm512_loadu_si512(transposed + 64 * (i - 1));
+        diagonal_vec.zmm = _mm512_loadu_si512(row);
+        left_vec.zmm = _mm512_set1_epi8((char)i);
+        row_min_vec.zmm = left_vec.zmm;
+        _mm512_storeu_si512(row, left_vec.zmm);
+        for (sz_size_t j = 1; j <= query_length; ++j) {
+            up_vec.zmm = _mm512_loadu_si512(row + 64 * j);
+            __mmask64 mismatches = _mm512_cmpneq_epi8_mask(chars_vec.zmm, _mm512_set1_epi8(query[j - 1]));
+            substitution_vec.zmm = _mm512_mask_adds_epu8(diagonal_vec.zmm, mismatches, diagonal_vec.zmm, ones_vec.zmm);
+            left_vec.zmm = _mm512_adds_epu8(_mm512_min_epu8(up_vec.zmm, left_vec.zmm), ones_vec.zmm);
+            left_vec.zmm = _mm512_min_epu8(left_vec.zmm, substitution_vec.zmm);
+            row_min_vec.zmm = _mm512_min_epu8(row_min_vec.zmm, left_vec.zmm);
+            _mm512_storeu_si512(row + 64 * j, left_vec.zmm);
+            diagonal_vec.zmm = up_vec.zmm;
+        }
+
+        // The last column of the row contains the final distance for the candidates, that end at this row.
+        __mmask64 finished_mask = pending_mask & _mm512_cmpeq_epi8_mask(lengths_vec.zmm, _mm512_set1_epi8((char)i));
+        results_vec.zmm = _mm512_mask_mov_epi8(results_vec.zmm, finished_mask, left_vec.zmm);
+        pending_mask &= ~finished_mask;
+
+        // The minimum of each row never decreases, so once it reaches the bound, the lane is done.
+        if (bound) {
+            __mmask64 exceeded_mask = pending_mask & _mm512_cmpge_epu8_mask(row_min_vec.zmm, bound_vec.zmm);
+            results_vec.zmm = _mm512_mask_mov_epi8(results_vec.zmm, exceeded_mask, bound_vec.zmm);
+            pending_mask &= ~exceeded_mask;
+        }
+    }
+
+    if (bound) results_vec.zmm = _mm512_min_epu8(results_vec.zmm, bound_vec.zmm);
+    return results_vec;
+}
+
+SZ_PUBLIC sz_bool_t sz_edit_distances_batch_avx512( //
+    sz_cptr_t query, sz_size_t query_length,        //
+    sz_sequence_t const *candidates, sz_size_t bound, sz_size_t *distances, sz_memory_allocator_t *alloc) {
+
+    // Distances to long queries don't fit into 8-bit lanes.
+    if (query_length >= 255)
+        return sz_edit_distances_batch_serial(query, query_length, candidates, bound, distances, alloc);
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    // One buffer holds a row of the matrix for every lane, the transposed characters of up to 64 candidates
+    // under 255 bytes long, and the scratch space for the pairwise kernel, used for longer candidates.
+    sz_size_t const row_length = 64 * (query_length + 1);
+    sz_size_t const transposed_length = 64 * 254;
+    sz_size_t const serial_length = _sz_edit_distance_scratch_length(query_length);
+    sz_size_t const buffer_length = row_length + transposed_length + serial_length;
+    sz_u8_t *const buffer = (sz_u8_t *)alloc->allocate(buffer_length, alloc->handle);
+    if (!buffer) return sz_false_k;
+    sz_u8_t *const row = buffer;
+    sz_u8_t *const transposed = buffer + row_length;
+    sz_memory_allocator_t scratch;
+    sz_memory_allocator_init_fixed(&scratch, transposed + transposed_length, serial_length);
+
+    sz_u512_vec_t lengths_vec, results_vec;
+    sz_size_t lanes_indices[64];
+    sz_size_t lanes_count = 0, max_length = 0;
+    lengths_vec.zmm = _mm512_setzero_si512();
+    for (sz_size_t i = 0; i != candidates->count; ++i) {
+        sz_cptr_t start = candidates->get_start(candidates, i);
+        sz_size_t length = candidates->get_length(candidates, i);
+        if (length >= 255) {
+            distances[i] = sz_edit_distance_serial(query, query_length, start, length, bound, &scratch);
+            continue;
+        }
+
+        // Scatter the characters into the transposed layout, one lane per candidate.
+        for (sz_size_t j = 0; j != length; ++j) transposed[64 * j + lanes_count] = (sz_u8_t)start[j];
+        lengths_vec.u8s[lanes_count] = (sz_u8_t)length;
+        lanes_indices[lanes_count] = i;
+        max_length = sz_max_of_two(max_length, length);
+        if (++lanes_count != 64) continue;
+
+        results_vec = _sz_edit_distances_lanes_avx512(query, query_length, transposed, lengths_vec,
+                                                      0xFFFFFFFFFFFFFFFFull, max_length, bound, row);
+        for (sz_size_t lane = 0; lane != 64; ++lane) distances[lanes_indices[lane]] = results_vec.u8s[lane];
+        lanes_count = max_length = 0;
+    }
+
+    // Handle the last partially-filled batch.
+    if (lanes_count) {
+        results_vec = _sz_edit_distances_lanes_avx512(query, query_length, transposed, lengths_vec,
+                                                      _bzhi_u64(0xFFFFFFFFFFFFFFFFull, lanes_count), max_length,
+                                                      bound, row);
+        for (sz_size_t lane = 0; lane != lanes_count; ++lane) distances[lanes_indices[lane]] = results_vec.u8s[lane];
+    }
+
+    alloc->free(buffer, buffer_length, alloc->handle);
+    return sz_true_k;
+}
+
+SZ_PUBLIC void sz_hash_batch_avx512(sz_sequence_t const *sequence, sz_u64_t *hashes) {
+
+    // Every one of the 16 lanes in 2 registers hashes a different string, using masks to skip the exhausted lanes.
+    // Two independent registers hide the latency of the dependency chain within every step.
+    sz_u512_vec_t lengths_vecs[2], words_vecs[2], chars_low_vec, chars_high_vec;
+    sz_u512_vec_t hash_low_vecs[2], hash_high_vecs[2], next_low_vec, next_high_vec;
+    __m512i const prime_vec = _mm512_set1_epi64(SZ_U64_MAX_PRIME);
+    __m512i const prime_complement_vec = _mm512_set1_epi64(0ull - SZ_U64_MAX_PRIME);
+    __m512i const shift_high_vec = _mm512_set1_epi64(77);
+    __m512i const byte_mask_vec = _mm512_set1_epi64(0xFF);
+    __mmask8 active_mask;
+    sz_u8_t const *starts[16];
+
+    sz_size_t const count = sequence->count;
+    sz_size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        sz_size_t max_length = 0;
+        for (sz_size_t lane = 0; lane != 16; ++lane) {
+            starts[lane] = (sz_u8_t const *)sequence->get_start(sequence, i + lane);
+            lengths_vecs[lane / 8].u64s[lane % 8] = sequence->get_length(sequence, i + lane);
+            max_length = sz_max_of_two(max_length, lengths_vecs[lane / 8].u64s[lane % 8]);
+        }
+
+        for (sz_size_t r = 0; r != 2; ++r)
+            hash_low_vecs[r].zmm = _mm512_setzero_si512(), hash_high_vecs[r].zmm = _mm512_setzero_si512();
+        for (sz_size_t offset = 0; offset < max_length; offset += 8) {
+            for (sz_size_t lane = 0; lane != 16; ++lane)
+                words_vecs[lane / 8].u64s[lane % 8] =
+                    _sz_hash_batch_load(starts[lane], lengths_vecs[lane / 8].u64s[lane % 8], offset);
+            for (sz_size_t k = 0; k != 8 && offset + k < max_length; ++k) {
+                for (sz_size_t r = 0; r != 2; ++r) {
+                    chars_low_vec.zmm = _mm512_and_si512(words_vecs[r].zmm, byte_mask_vec);
+                    chars_high_vec.zmm = _mm512_add_epi64(chars_low_vec.zmm, shift_high_vec);
+                    chars_high_vec.zmm = _mm512_and_si512(chars_high_vec.zmm, byte_mask_vec);
+                    words_vecs[r].zmm = _mm512_srli_epi64(words_vecs[r].zmm, 8);
+
+                    // Multiply by 31 and 257 with shifts, which is cheaper than `_mm512_mullo_epi64`.
+                    next_low_vec.zmm = _mm512_slli_epi64(hash_low_vecs[r].zmm, 5);
+                    next_low_vec.zmm = _mm512_sub_epi64(next_low_vec.zmm, hash_low_vecs[r].zmm);
+                    next_low_vec.zmm = _mm512_add_epi64(next_low_vec.zmm, chars_low_vec.zmm);
+                    next_high_vec.zmm = _mm512_slli_epi64(hash_high_vecs[r].zmm, 8);
+                    next_high_vec.zmm = _mm512_add_epi64(next_high_vec.zmm, hash_high_vecs[r].zmm);
+                    next_high_vec.zmm = _mm512_add_epi64(next_high_vec.zmm, chars_high_vec.zmm);
+
+                    // Compute the modulo by conditionally subtracting the prime, only in lanes with remaining bytes.
+                    active_mask = _mm512_cmpgt_epu64_mask(lengths_vecs[r].zmm, _mm512_set1_epi64(offset + k));
+                    hash_low_vecs[r].zmm = _mm512_mask_mov_epi64(
+                        hash_low_vecs[r].zmm, active_mask,
+                        _mm512_mask_add_epi64(next_low_vec.zmm, _mm512_cmpge_epu64_mask(next_low_vec.zmm, prime_vec),
+                                              next_low_vec.zmm, prime_complement_vec));
+                    hash_high_vecs[r].zmm = _mm512_mask_mov_epi64(
+                        hash_high_vecs[r].zmm, active_mask,
+                        _mm512_mask_add_epi64(next_high_vec.zmm, _mm512_cmpge_epu64_mask(next_high_vec.zmm, prime_vec),
+                                              next_high_vec.zmm, prime_complement_vec));
+                }
+            }
+        }
+
+        // The `_mm512_mullo_epi64` requires AVX-512DQ, so the final mixing is serial.
+        for (sz_size_t lane = 0; lane != 16; ++lane)
+            hashes[i + lane] = (hash_low_vecs[lane / 8].u64s[lane % 8] * 11400714819323198485ull) ^
+                               (hash_high_vecs[lane / 8].u64s[lane % 8] * 11400714819323198485ull);
+    }
+
+    for (; i != count; ++i)
+        hashes[i] = sz_hash_serial(sequence->get_start(sequence, i), sequence->get_length(sequence, i));
 }
 
 #pragma clang attribute pop
@@ -4332,8 +8381,8 @@ SZ_PUBLIC void sz_hashes_avx512(sz_cptr_t start, sz_size_t length, sz_size_t win
 
         // 4. Compute the modulo. Assuming there are only 59 values between our prime
         //    and the 2^64 value, we can simply compute the modulo by conditionally subtracting the prime.
-        hash_vec.zmm = _mm512_mask_blend_epi8(_mm512_cmpgt_epi64_mask(hash_vec.zmm, prime_vec.zmm), hash_vec.zmm,
-                                              _mm512_sub_epi64(hash_vec.zmm, prime_vec.zmm));
+        hash_vec.zmm = _mm512_mask_sub_epi64(hash_vec.zmm, _mm512_cmpge_epu64_mask(hash_vec.zmm, prime_vec.zmm),
+                                             hash_vec.zmm, prime_vec.zmm);
     }
 
     // 5. Compute the hash mix, that will be used to index into the fingerprint.
@@ -4380,8 +8429,8 @@ SZ_PUBLIC void sz_hashes_avx512(sz_cptr_t start, sz_size_t length, sz_size_t win
 
         // 4. Compute the modulo. Assuming there are only 59 values between our prime
         //    and the 2^64 value, we can simply compute the modulo by conditionally subtracting the prime.
-        hash_vec.zmm = _mm512_mask_blend_epi8(_mm512_cmpgt_epi64_mask(hash_vec.zmm, prime_vec.zmm), hash_vec.zmm,
-                                              _mm512_sub_epi64(hash_vec.zmm, prime_vec.zmm));
+        hash_vec.zmm = _mm512_mask_sub_epi64(hash_vec.zmm, _mm512_cmpge_epu64_mask(hash_vec.zmm, prime_vec.zmm),
+                                             hash_vec.zmm, prime_vec.zmm);
 
         // 5. Compute the hash mix, that will be used to index into the fingerprint.
         //    This includes a serial step at the end.
@@ -4398,6 +8447,287 @@ SZ_PUBLIC void sz_hashes_avx512(sz_cptr_t start, sz_size_t length, sz_size_t win
     }
 }
 
+/**
+ *  @brief  Vectorized SplitMix64 finalizer, matching `_sz_splitmix64` in every 64-bit lane.
+ */
+SZ_INTERNAL __m512i _sz_splitmix64_avx512(__m512i x) {
+    x = _mm512_add_epi64(x, _mm512_set1_epi64(0x9E3779B97F4A7C15ull));
+    x = _mm512_mullo_epi64(_mm512_xor_si512(x, _mm512_srli_epi64(x, 30)), _mm512_set1_epi64(0xBF58476D1CE4E5B9ull));
+    x = _mm512_mullo_epi64(_mm512_xor_si512(x, _mm512_srli_epi64(x, 27)), _mm512_set1_epi64(0x94D049BB133111EBull));
+    return _mm512_xor_si512(x, _mm512_srli_epi64(x, 31));
+}
+
+SZ_PUBLIC void sz_hashes_sketch_avx512(sz_cptr_t text, sz_size_t length, sz_size_t const *window_lengths,
+                                       sz_size_t windows_count, sz_size_t permutations_count, sz_u64_t *min_hashes,
+                                       sz_u64_t *sim_hashes) {
+
+    if (min_hashes)
+        for (sz_size_t i = 0; i != windows_count * permutations_count; ++i) min_hashes[i] = SZ_U64_MAX;
+
+    // The rolling hashes have a long serial dependency chain, but are cheap compared to the permutations,
+    // which are evaluated 8 at a time for every buffered window hash. The SimHash votes are accumulated in
+    // 8-bit counters of a single register, one per bit, and are flushed into 64-bit ones for every block.
+    sz_u512_vec_t lanes_vec;
+    lanes_vec.zmm = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+    for (sz_size_t group_start = 0; group_start < windows_count; group_start += 4) {
+        sz_size_t const group_size = sz_min_of_two(windows_count - group_start, 4);
+        _sz_hashes_rolling_t rollings[4];
+        sz_u64_t ones[4][64], totals[4];
+        sz_u64_t hashes[64];
+        for (sz_size_t g = 0; g != group_size; ++g) {
+            _sz_hashes_rolling_init(&rollings[g], window_lengths[group_start + g]);
+            for (sz_size_t bit = 0; bit != 64; ++bit) ones[g][bit] = 0;
+            totals[g] = 0;
+        }
+
+        for (sz_bool_t has_more = sz_true_k; has_more;) {
+            has_more = sz_false_k;
+            for (sz_size_t g = 0; g != group_size; ++g) {
+                sz_size_t const count =
+                    _sz_hashes_rolling_next(&rollings[g], (sz_u8_t const *)text, length, hashes, 64);
+                if (!count) continue;
+                has_more = sz_true_k;
+
+                if (min_hashes) {
+                    sz_u64_t *window_min_hashes = min_hashes + (group_start + g) * permutations_count;
+                    for (sz_size_t p = 0; p < permutations_count; p += 8) {
+                        __mmask8 const mask = (__mmask8)_bzhi_u32(0xFF, (sz_u32_t)(permutations_count - p));
+                        sz_u512_vec_t indices_vec, multipliers_vec, masks_vec, min_vec, permuted_vec;
+                        indices_vec.zmm = _mm512_add_epi64(lanes_vec.zmm, _mm512_set1_epi64((sz_i64_t)(2 * p)));
+                        multipliers_vec.zmm =
+                            _mm512_or_si512(_sz_splitmix64_avx512(indices_vec.zmm), _mm512_set1_epi64(1));
+                        masks_vec.zmm =
+                            _sz_splitmix64_avx512(_mm512_add_epi64(indices_vec.zmm, _mm512_set1_epi64(1)));
+                        min_vec.zmm = _mm512_maskz_loadu_epi64(mask, window_min_hashes + p);
+                        for (sz_size_t i = 0; i != count; ++i) {
+                            __m512i hash_vec = _mm512_set1_epi64((sz_i64_t)hashes[i]);
+                            permuted_vec.zmm = _mm512_mullo_epi64(_mm512_xor_si512(hash_vec, masks_vec.zmm),
+                                                                  multipliers_vec.zmm);
+                            permuted_vec.zmm =
+                                _mm512_xor_si512(permuted_vec.zmm, _mm512_srli_epi64(permuted_vec.zmm, 32));
+                            min_vec.zmm = _mm512_min_epu64(min_vec.zmm, permuted_vec.zmm);
+                        }
+                        _mm512_mask_storeu_epi64(window_min_hashes + p, mask, min_vec.zmm);
+                    }
+                }
+                if (sim_hashes) {
+                    // At most 64 votes per block, so the 8-bit counters can't overflow.
+                    sz_u512_vec_t votes_vec;
+                    votes_vec.zmm = _mm512_setzero_si512();
+                    for (sz_size_t i = 0; i != count; ++i)
+                        votes_vec.zmm = _mm512_sub_epi8(votes_vec.zmm, _mm512_movm_epi8((__mmask64)hashes[i]));
+                    for (sz_size_t q = 0; q != 8; ++q) {
+                        sz_u512_vec_t ones_vec;
+                        __m128i votes_octet = _mm_loadl_epi64((__m128i const *)&votes_vec.u8s[q * 8]);
+                        ones_vec.zmm = _mm512_loadu_si512(&ones[g][q * 8]);
+                        ones_vec.zmm = _mm512_add_epi64(ones_vec.zmm, _mm512_cvtepu8_epi64(votes_octet));
+                        _mm512_storeu_si512(&ones[g][q * 8], ones_vec.zmm);
+                    }
+                    totals[g] += count;
+                }
+            }
+        }
+
+        // Every bit of the SimHash is the majority vote of the window hashes.
+        if (sim_hashes)
+            for (sz_size_t g = 0; g != group_size; ++g) {
+                sz_u64_t sim_hash = 0;
+                for (sz_size_t q = 0; q != 8; ++q) {
+                    __m512i doubled_ones = _mm512_slli_epi64(_mm512_loadu_si512(&ones[g][q * 8]), 1);
+                    __m512i totals_vec = _mm512_set1_epi64((sz_i64_t)totals[g]);
+                    __mmask8 majority = _mm512_cmpgt_epu64_mask(doubled_ones, totals_vec);
+                    sim_hash |= (sz_u64_t)majority << (q * 8);
+                }
+                sim_hashes[group_start + g] = sim_hash;
+            }
+    }
+}
+
+#pragma clang attribute pop
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx", "avx512f", "avx512vl", "avx512bw", "avx512vpopcntdq", "bmi", "bmi2")
+#pragma clang attribute push(__attribute__((target("avx,avx512f,avx512vl,avx512bw,avx512vpopcntdq,bmi,bmi2"))), \
+                             apply_to = function)
+
+SZ_PUBLIC sz_size_t sz_fingerprints_top_k_avx512(sz_cptr_t query, sz_cptr_t fingerprints, sz_size_t fingerprint_bytes,
+                                                 sz_sorted_idx_t const *ids, sz_size_t count, sz_size_t k,
+                                                 sz_fingerprint_metric_t metric, sz_fingerprint_match_t *matches) {
+    sz_size_t size = 0;
+    if (!k) return 0;
+
+    // The tail of the fingerprint, shorter than a cache line, is handled with masked loads.
+    sz_size_t const body_bytes = fingerprint_bytes & ~(sz_size_t)63;
+    __mmask64 const tail_mask = _sz_u64_mask_until(fingerprint_bytes - body_bytes);
+    sz_u512_vec_t query_vec, fingerprint_vec, intersection_vec, union_vec;
+    for (sz_size_t i = 0; i != count; ++i) {
+        sz_fingerprint_match_t candidate;
+        candidate.id = ids ? (sz_size_t)ids[i] : i;
+        sz_cptr_t const fingerprint = fingerprints + candidate.id * fingerprint_bytes;
+
+        // The LSH candidates are scattered across the column, so let's fetch the next one in the background.
+        if (ids && i + 1 != count) _mm_prefetch(fingerprints + ids[i + 1] * fingerprint_bytes, _MM_HINT_T0);
+
+        intersection_vec.zmm = _mm512_setzero_si512();
+        union_vec.zmm = _mm512_setzero_si512();
+        for (sz_size_t j = 0; j != body_bytes; j += 64) {
+            query_vec.zmm = _mm512_loadu_si512(query + j);
+            fingerprint_vec.zmm = _mm512_loadu_si512(fingerprint + j);
+            intersection_vec.zmm = _mm512_add_epi64(
+                intersection_vec.zmm, _mm512_popcnt_epi64(_mm512_and_si512(query_vec.zmm, fingerprint_vec.zmm)));
+            union_vec.zmm = _mm512_add_epi64(union_vec.zmm,
+                                             _mm512_popcnt_epi64(_mm512_or_si512(query_vec.zmm, fingerprint_vec.zmm)));
+        }
+        if (tail_mask) {
+            query_vec.zmm = _mm512_maskz_loadu_epi8(tail_mask, query + body_bytes);
+            fingerprint_vec.zmm = _mm512_maskz_loadu_epi8(tail_mask, fingerprint + body_bytes);
+            intersection_vec.zmm = _mm512_add_epi64(
+                intersection_vec.zmm, _mm512_popcnt_epi64(_mm512_and_si512(query_vec.zmm, fingerprint_vec.zmm)));
+            union_vec.zmm = _mm512_add_epi64(union_vec.zmm,
+                                             _mm512_popcnt_epi64(_mm512_or_si512(query_vec.zmm, fingerprint_vec.zmm)));
+        }
+
+        candidate.intersection = (sz_u32_t)_mm512_reduce_add_epi64(intersection_vec.zmm);
+        candidate.union_size = (sz_u32_t)_mm512_reduce_add_epi64(union_vec.zmm);
+        _sz_fingerprint_heap_push(matches, &size, k, &candidate, metric);
+    }
+    _sz_fingerprint_heap_sort(matches, size, metric);
+    return size;
+}
+
+#pragma clang attribute pop
+#pragma GCC pop_options
+
+/*
+ *  The byte permutations of `sz_translate` and `sz_split_offsets` only add VBMI to the base AVX-512 subsets,
+ *  without assuming GFNI. The VL is also used by the masking helpers, and every CPU with VBMI supports it.
+ */
+#pragma GCC push_options
+#pragma GCC target("avx", "avx512f", "avx512vl", "avx512bw", "avx512vbmi", "bmi", "bmi2")
+#pragma clang attribute push(__attribute__((target("avx,avx512f,avx512vl,avx512bw,avx512vbmi,bmi,bmi2"))), \
+                             apply_to = function)
+
+SZ_PUBLIC void sz_translate_avx512(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result) {
+    // The `VPERMI2B` instruction looks up 128-byte tables, spread across two ZMM registers,
+    // using the lower 7 bits of every byte. So we look up both halves and blend them by the highest bit.
+    sz_u512_vec_t lut_0_to_63_vec, lut_64_to_127_vec, lut_128_to_191_vec, lut_192_to_255_vec;
+    lut_0_to_63_vec.zmm = _mm512_loadu_epi8(lut);
+    lut_64_to_127_vec.zmm = _mm512_loadu_epi8(lut + 64);
+    lut_128_to_191_vec.zmm = _mm512_loadu_epi8(lut + 128);
+    lut_192_to_255_vec.zmm = _mm512_loadu_epi8(lut + 192);
+
+    sz_u512_vec_t text_vec, lower_half_vec, upper_half_vec;
+    __mmask64 load_mask;
+    while (length) {
+        load_mask = _sz_u64_clamp_mask_until(length);
+        text_vec.zmm = _mm512_maskz_loadu_epi8(load_mask, text);
+        lower_half_vec.zmm = _mm512_permutex2var_epi8(lut_0_to_63_vec.zmm, text_vec.zmm, lut_64_to_127_vec.zmm);
+        upper_half_vec.zmm = _mm512_permutex2var_epi8(lut_128_to_191_vec.zmm, text_vec.zmm, lut_192_to_255_vec.zmm);
+        _mm512_mask_storeu_epi8(
+            result, load_mask,
+            _mm512_mask_blend_epi8(_mm512_movepi8_mask(text_vec.zmm), lower_half_vec.zmm, upper_half_vec.zmm));
+        sz_size_t load_length = length < 64 ? length : 64;
+        text += load_length, result += load_length, length -= load_length;
+    }
+}
+
+/**
+ *  @brief  Exports the positions of all set bits in a 64-bit @p matches mask into the @p offsets tape,
+ *          compressing the incrementing offsets in 16x 32-bit or 8x 64-bit slices, and storing them
+ *          with masked stores, that are cheaper than the memory-operand `VPCOMPRESS` on most CPUs.
+ */
+SZ_INTERNAL void _sz_split_offsets_export_avx512(sz_u64_t matches, sz_size_t first, void *offsets,
+                                                 sz_size_t offset_bytes) {
+    sz_u512_vec_t offsets_vec;
+    if (offset_bytes == 4) {
+        sz_u32_t *offsets_u32 = (sz_u32_t *)offsets;
+        __m512i const iota_vec = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        for (; matches; matches >>= 16, first += 16) {
+            __mmask16 slice_mask = (__mmask16)(matches & 0xFFFFu);
+            if (!slice_mask) continue;
+            unsigned slice_count = (unsigned)sz_u32_popcount(slice_mask);
+            offsets_vec.zmm = _mm512_add_epi32(iota_vec, _mm512_set1_epi32((int)(sz_u32_t)first));
+            offsets_vec.zmm = _mm512_maskz_compress_epi32(slice_mask, offsets_vec.zmm);
+            _mm512_mask_storeu_epi32(offsets_u32, (__mmask16)_bzhi_u32(0xFFFFu, slice_count), offsets_vec.zmm);
+            offsets_u32 += slice_count;
+        }
+    }
+    else {
+        sz_u64_t *offsets_u64 = (sz_u64_t *)offsets;
+        __m512i const iota_vec = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+        for (; matches; matches >>= 8, first += 8) {
+            __mmask8 slice_mask = (__mmask8)(matches & 0xFFu);
+            if (!slice_mask) continue;
+            unsigned slice_count = (unsigned)sz_u32_popcount(slice_mask);
+            offsets_vec.zmm = _mm512_add_epi64(iota_vec, _mm512_set1_epi64((long long)first));
+            offsets_vec.zmm = _mm512_maskz_compress_epi64(slice_mask, offsets_vec.zmm);
+            _mm512_mask_storeu_epi64(offsets_u64, (__mmask8)_bzhi_u32(0xFFu, slice_count), offsets_vec.zmm);
+            offsets_u64 += slice_count;
+        }
+    }
+}
+
+SZ_PUBLIC sz_size_t sz_split_offsets_avx512(sz_cptr_t text, sz_size_t length, sz_charset_t const *delimiters,
+                                            sz_size_t base, void *offsets, sz_size_t offset_bytes,
+                                            sz_size_t capacity, sz_size_t *consumed) {
+
+    // Most splits are performed on a single delimiter, like the newline, for which a plain comparison suffices.
+    sz_size_t const members_count = sz_u64_popcount(delimiters->_u64s[0]) + sz_u64_popcount(delimiters->_u64s[1]) +
+                                    sz_u64_popcount(delimiters->_u64s[2]) + sz_u64_popcount(delimiters->_u64s[3]);
+    sz_u8_t delimiter = 0;
+    if (members_count == 1)
+        while (!sz_charset_contains_u8(delimiters, delimiter)) ++delimiter;
+
+    // For arbitrary sets, the top 5 bits of every byte select one of 32 bytes of the set with `VPERMB`,
+    // and the bottom 3 bits select the bit within it, looked up with an in-lane `VPSHUFB`.
+    sz_u512_vec_t text_vec, delimiter_vec, set_vec, slices_vec, bits_vec, bits_lut_vec;
+    bits_lut_vec.zmm = _mm512_set1_epi64(0x8040201008040201ull);
+    delimiter_vec.zmm = _mm512_set1_epi8((char)delimiter);
+    set_vec.zmm = _mm512_setzero_si512();
+    set_vec.ymms[0] = _mm256_loadu_epi64(&delimiters->_u64s[0]);
+
+    sz_u32_t *offsets_u32 = (sz_u32_t *)offsets;
+    sz_u64_t *offsets_u64 = (sz_u64_t *)offsets;
+    sz_size_t count = 0, progress = 0;
+    while (progress != length && count != capacity) {
+        sz_size_t const load_length = sz_min_of_two(length - progress, 64);
+        __mmask64 const load_mask = _sz_u64_mask_until(load_length);
+        text_vec.zmm = _mm512_maskz_loadu_epi8(load_mask, text + progress);
+
+        sz_u64_t matches;
+        if (members_count == 1) matches = _mm512_mask_cmpeq_epi8_mask(load_mask, text_vec.zmm, delimiter_vec.zmm);
+        else {
+            slices_vec.zmm = _mm512_and_si512(_mm512_srli_epi16(text_vec.zmm, 3), _mm512_set1_epi8(0x1F));
+            slices_vec.zmm = _mm512_permutexvar_epi8(slices_vec.zmm, set_vec.zmm);
+            bits_vec.zmm = _mm512_shuffle_epi8(bits_lut_vec.zmm, _mm512_and_si512(text_vec.zmm, _mm512_set1_epi8(7)));
+            matches = _mm512_mask_test_epi8_mask(load_mask, slices_vec.zmm, bits_vec.zmm);
+        }
+
+        // When the remaining capacity is too small for all the matches, export them one by one,
+        // stopping right after the last delimiter, that fits.
+        sz_size_t const matches_count = sz_u64_popcount(matches);
+        if (count + matches_count > capacity) {
+            sz_size_t match_offset = 0;
+            for (; count != capacity; matches &= matches - 1, ++count) {
+                match_offset = sz_u64_ctz(matches);
+                if (offset_bytes == 4) offsets_u32[count] = (sz_u32_t)(base + progress + match_offset);
+                else offsets_u64[count] = (sz_u64_t)(base + progress + match_offset);
+            }
+            progress += match_offset + 1;
+            break;
+        }
+
+        _sz_split_offsets_export_avx512(matches, base + progress, (sz_ptr_t)offsets + count * offset_bytes,
+                                        offset_bytes);
+        count += matches_count;
+        progress += load_length;
+    }
+
+    if (consumed) *consumed = progress;
+    return count;
+}
+
 #pragma clang attribute pop
 #pragma GCC pop_options
 
@@ -4516,6 +8846,74 @@ SZ_PUBLIC sz_cptr_t sz_rfind_charset_avx512(sz_cptr_t text, sz_size_t length, sz
     return SZ_NULL_CHAR;
 }
 
+SZ_PUBLIC sz_size_t sz_utf8_to_utf32_avx512(sz_cptr_t text, sz_size_t length, sz_rune_t *runes) {
+
+    sz_rune_t *const runes_start = runes;
+    sz_u512_vec_t text_vec, positions_vec, gathered_vec, lead_vec, continuation_vec, rune_vec;
+    sz_u512_vec_t lead_mask_vec, shifts_vec;
+
+    // Every rune is gathered into a 32-bit word, starting with the leading byte in the lowest position.
+    __m512i const iota_vec = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i const broadcast_low_byte_vec = _mm512_set4_epi64( //
+        0x0C0C0C0C08080808ull, 0x0404040400000000ull, 0x0C0C0C0C08080808ull, 0x0404040400000000ull);
+    __m512i const bytes_in_rune_vec = _mm512_set1_epi32(0x03020100);
+    __m512i const continuation_max_vec = _mm512_set1_epi8((char)0xBF);
+    __m512i const payload_vec = _mm512_set1_epi32(0x3F);
+
+    while (length >= 64) {
+        text_vec.zmm = _mm512_loadu_epi8(text);
+
+        // Pure ASCII blocks are just zero-extended.
+        if (!_mm512_movepi8_mask(text_vec.zmm)) {
+            _mm512_storeu_si512(runes + 0, _mm512_cvtepu8_epi32(text_vec.xmms[0]));
+            _mm512_storeu_si512(runes + 16, _mm512_cvtepu8_epi32(text_vec.xmms[1]));
+            _mm512_storeu_si512(runes + 32, _mm512_cvtepu8_epi32(text_vec.xmms[2]));
+            _mm512_storeu_si512(runes + 48, _mm512_cvtepu8_epi32(text_vec.xmms[3]));
+            text += 64, length -= 64, runes += 64;
+            continue;
+        }
+
+        // Decode the runes starting in the first 48 bytes, so that all 4 of their bytes are in the register.
+        sz_u64_t const leads = _mm512_cmpgt_epi8_mask(text_vec.zmm, continuation_max_vec);
+        for (int offset = 0; offset != 48; offset += 16) {
+            __mmask16 const window_leads = (__mmask16)(leads >> offset);
+            positions_vec.zmm =
+                _mm512_maskz_compress_epi32(window_leads, _mm512_add_epi32(iota_vec, _mm512_set1_epi32(offset)));
+            positions_vec.zmm =
+                _mm512_add_epi8(_mm512_shuffle_epi8(positions_vec.zmm, broadcast_low_byte_vec), bytes_in_rune_vec);
+            gathered_vec.zmm = _mm512_permutexvar_epi8(positions_vec.zmm, text_vec.zmm);
+
+            // Assemble all runes as if they were 4 bytes long, and shift out the extra continuations.
+            lead_vec.zmm = _mm512_and_si512(gathered_vec.zmm, _mm512_set1_epi32(0xFF));
+            __mmask16 const is_2_bytes = _mm512_cmpge_epu32_mask(lead_vec.zmm, _mm512_set1_epi32(0xC0));
+            __mmask16 const is_3_bytes = _mm512_cmpge_epu32_mask(lead_vec.zmm, _mm512_set1_epi32(0xE0));
+            __mmask16 const is_4_bytes = _mm512_cmpge_epu32_mask(lead_vec.zmm, _mm512_set1_epi32(0xF0));
+            lead_mask_vec.zmm = _mm512_mask_mov_epi32(_mm512_set1_epi32(0x7F), is_2_bytes, _mm512_set1_epi32(0x1F));
+            lead_mask_vec.zmm = _mm512_mask_mov_epi32(lead_mask_vec.zmm, is_3_bytes, _mm512_set1_epi32(0x0F));
+            lead_mask_vec.zmm = _mm512_mask_mov_epi32(lead_mask_vec.zmm, is_4_bytes, _mm512_set1_epi32(0x07));
+            shifts_vec.zmm = _mm512_mask_mov_epi32(_mm512_set1_epi32(18), is_2_bytes, _mm512_set1_epi32(12));
+            shifts_vec.zmm = _mm512_mask_mov_epi32(shifts_vec.zmm, is_3_bytes, _mm512_set1_epi32(6));
+            shifts_vec.zmm = _mm512_mask_mov_epi32(shifts_vec.zmm, is_4_bytes, _mm512_setzero_si512());
+
+            rune_vec.zmm = _mm512_slli_epi32(_mm512_and_si512(lead_vec.zmm, lead_mask_vec.zmm), 18);
+            continuation_vec.zmm = _mm512_and_si512(_mm512_srli_epi32(gathered_vec.zmm, 8), payload_vec);
+            rune_vec.zmm = _mm512_or_si512(rune_vec.zmm, _mm512_slli_epi32(continuation_vec.zmm, 12));
+            continuation_vec.zmm = _mm512_and_si512(_mm512_srli_epi32(gathered_vec.zmm, 16), payload_vec);
+            rune_vec.zmm = _mm512_or_si512(rune_vec.zmm, _mm512_slli_epi32(continuation_vec.zmm, 6));
+            continuation_vec.zmm = _mm512_and_si512(_mm512_srli_epi32(gathered_vec.zmm, 24), payload_vec);
+            rune_vec.zmm = _mm512_or_si512(rune_vec.zmm, continuation_vec.zmm);
+            rune_vec.zmm = _mm512_srlv_epi32(rune_vec.zmm, shifts_vec.zmm);
+
+            int const window_count = sz_u64_popcount(window_leads);
+            _mm512_mask_storeu_epi32(runes, (__mmask16)((1u << window_count) - 1u), rune_vec.zmm);
+            runes += window_count;
+        }
+        text += 48, length -= 48;
+    }
+
+    return (sz_size_t)(runes - runes_start) + sz_utf8_to_utf32_serial(text, length, runes);
+}
+
 /**
  *  Computes the Needleman Wunsch alignment score between two strings.
  *  The method uses 32-bit integers to accumulate the running score for every cell in the matrix.
@@ -4530,19 +8928,20 @@ SZ_PUBLIC sz_cptr_t sz_rfind_charset_avx512(sz_cptr_t text, sz_size_t length, sz
  *  a 256 x 256 matrix, but from a single row!
  */
 SZ_INTERNAL sz_ssize_t _sz_alignment_score_wagner_fisher_upto17m_avx512( //
-    sz_cptr_t shorter, sz_size_t shorter_length,                         //
     sz_cptr_t longer, sz_size_t longer_length,                           //
+    sz_cptr_t shorter, sz_size_t shorter_length,                         //
     sz_error_cost_t const *subs, sz_error_cost_t gap, sz_memory_allocator_t *alloc) {
 
     // If one of the strings is empty - the edit distance is equal to the length of the other one
-    if (longer_length == 0) return (sz_ssize_t)shorter_length * gap;
     if (shorter_length == 0) return (sz_ssize_t)longer_length * gap;
+    if (longer_length == 0) return (sz_ssize_t)shorter_length * gap;
 
     // Let's make sure that we use the amount proportional to the
     // number of elements in the shorter string, not the larger.
+    // Same as in the serial variant, the rows of the substitution matrix are picked by the longer string.
     if (shorter_length > longer_length) {
-        sz_pointer_swap((void **)&longer_length, (void **)&shorter_length);
-        sz_pointer_swap((void **)&longer, (void **)&shorter);
+        sz_pointer_swap((void **)&shorter_length, (void **)&longer_length);
+        sz_pointer_swap((void **)&shorter, (void **)&longer);
     }
 
     // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
@@ -4553,9 +8952,9 @@ SZ_INTERNAL sz_ssize_t _sz_alignment_score_wagner_fisher_upto17m_avx512( //
     }
 
     sz_size_t const max_length = 256ull * 256ull * 256ull;
-    sz_size_t const n = longer_length + 1;
+    sz_size_t const n = shorter_length + 1;
     sz_assert(n < max_length && "The length must fit into 24-bit integer. Otherwise use serial variant.");
-    sz_unused(longer_length && max_length);
+    sz_unused(shorter_length && max_length);
 
     sz_size_t buffer_length = sizeof(sz_i32_t) * n * 2;
     sz_i32_t *distances = (sz_i32_t *)alloc->allocate(buffer_length, alloc->handle);
@@ -4563,11 +8962,11 @@ SZ_INTERNAL sz_ssize_t _sz_alignment_score_wagner_fisher_upto17m_avx512( //
     sz_i32_t *current_distances = previous_distances + n;
 
     // Intialize the first row of the Levenshtein matrix with `iota`.
-    for (sz_size_t idx_longer = 0; idx_longer != n; ++idx_longer)
-        previous_distances[idx_longer] = (sz_ssize_t)idx_longer * gap;
+    for (sz_size_t idx_shorter = 0; idx_shorter != n; ++idx_shorter)
+        previous_distances[idx_shorter] = (sz_ssize_t)idx_shorter * gap;
 
-    /// Contains up to 16 consecutive characters from the longer string.
-    sz_u512_vec_t longer_vec;
+    /// Contains up to 16 consecutive characters from the shorter string.
+    sz_u512_vec_t shorter_vec;
     sz_u512_vec_t cost_deletion_vec, cost_substitution_vec, lookup_substitution_vec, current_vec;
     sz_u512_vec_t row_first_subs_vec, row_second_subs_vec, row_third_subs_vec, row_fourth_subs_vec;
     sz_u512_vec_t shuffled_first_subs_vec, shuffled_second_subs_vec, shuffled_third_subs_vec, shuffled_fourth_subs_vec;
@@ -4582,12 +8981,12 @@ SZ_INTERNAL sz_ssize_t _sz_alignment_score_wagner_fisher_upto17m_avx512( //
         gap_vec.zmm = _mm512_set1_epi32(gap);
     }
 
-    sz_u8_t const *shorter_unsigned = (sz_u8_t const *)shorter;
-    for (sz_size_t idx_shorter = 0; idx_shorter != shorter_length; ++idx_shorter) {
-        sz_i32_t last_in_row = current_distances[0] = (sz_ssize_t)(idx_shorter + 1) * gap;
+    sz_u8_t const *longer_unsigned = (sz_u8_t const *)longer;
+    for (sz_size_t idx_longer = 0; idx_longer != longer_length; ++idx_longer) {
+        sz_i32_t last_in_row = current_distances[0] = (sz_ssize_t)(idx_longer + 1) * gap;
 
         // Load one row of the substitution matrix into four ZMM registers.
-        sz_error_cost_t const *row_subs = subs + shorter_unsigned[idx_shorter] * 256u;
+        sz_error_cost_t const *row_subs = subs + longer_unsigned[idx_longer] * 256u;
         row_first_subs_vec.zmm = _mm512_loadu_epi8(row_subs + 64 * 0);
         row_second_subs_vec.zmm = _mm512_loadu_epi8(row_subs + 64 * 1);
         row_third_subs_vec.zmm = _mm512_loadu_epi8(row_subs + 64 * 2);
@@ -4595,11 +8994,11 @@ SZ_INTERNAL sz_ssize_t _sz_alignment_score_wagner_fisher_upto17m_avx512( //
 
         // In the serial version we have one forward pass, that computes the deletion,
         // insertion, and substitution costs at once.
-        //    for (sz_size_t idx_longer = 0; idx_longer < longer_length; ++idx_longer) {
-        //        sz_ssize_t cost_deletion = previous_distances[idx_longer + 1] + gap;
-        //        sz_ssize_t cost_insertion = current_distances[idx_longer] + gap;
-        //        sz_ssize_t cost_substitution = previous_distances[idx_longer] + row_subs[longer_unsigned[idx_longer]];
-        //        current_distances[idx_longer + 1] = sz_min_of_three(cost_deletion, cost_insertion, cost_substitution);
+        //    for (sz_size_t idx_shorter = 0; idx_shorter < shorter_length; ++idx_shorter) {
+        //        sz_ssize_t cost_deletion = previous_distances[idx_shorter + 1] + gap;
+        //        sz_ssize_t cost_insertion = current_distances[idx_shorter] + gap;
+        //        sz_ssize_t cost_substitution = previous_distances[idx_shorter] + row_subs[shorter_unsigned[idx_shorter]];
+        //        current_distances[idx_shorter + 1] = sz_min_of_three(cost_deletion, cost_insertion, cost_substitution);
         //    }
         //
         // Given the complexity of handling the data-dependency between consecutive insertion cost computations
@@ -4609,25 +9008,25 @@ SZ_INTERNAL sz_ssize_t _sz_alignment_score_wagner_fisher_upto17m_avx512( //
         //      2. Compute the pairwise minimum with deletion costs.
         //      3. Inclusive prefix minimum computation to combine with addition costs.
         // Proceeding with substitutions:
-        for (sz_size_t idx_longer = 0; idx_longer < longer_length; idx_longer += 64) {
-            sz_size_t register_length = sz_min_of_two(longer_length - idx_longer, 64);
+        for (sz_size_t idx_shorter = 0; idx_shorter < shorter_length; idx_shorter += 64) {
+            sz_size_t register_length = sz_min_of_two(shorter_length - idx_shorter, 64);
             __mmask64 mask = _sz_u64_mask_until(register_length);
-            longer_vec.zmm = _mm512_maskz_loadu_epi8(mask, longer + idx_longer);
+            shorter_vec.zmm = _mm512_maskz_loadu_epi8(mask, shorter + idx_shorter);
 
             // Blend the `row_(first|second|third|fourth)_subs_vec` into `current_vec`, picking the right source
-            // for every character in `longer_vec`. Before that, we need to permute the subsititution vectors.
+            // for every character in `shorter_vec`. Before that, we need to permute the subsititution vectors.
             // Only the bottom 6 bits of a byte are used in VPERB, so we don't even need to mask.
-            shuffled_first_subs_vec.zmm = _mm512_maskz_permutexvar_epi8(mask, longer_vec.zmm, row_first_subs_vec.zmm);
-            shuffled_second_subs_vec.zmm = _mm512_maskz_permutexvar_epi8(mask, longer_vec.zmm, row_second_subs_vec.zmm);
-            shuffled_third_subs_vec.zmm = _mm512_maskz_permutexvar_epi8(mask, longer_vec.zmm, row_third_subs_vec.zmm);
-            shuffled_fourth_subs_vec.zmm = _mm512_maskz_permutexvar_epi8(mask, longer_vec.zmm, row_fourth_subs_vec.zmm);
+            shuffled_first_subs_vec.zmm = _mm512_maskz_permutexvar_epi8(mask, shorter_vec.zmm, row_first_subs_vec.zmm);
+            shuffled_second_subs_vec.zmm = _mm512_maskz_permutexvar_epi8(mask, shorter_vec.zmm, row_second_subs_vec.zmm);
+            shuffled_third_subs_vec.zmm = _mm512_maskz_permutexvar_epi8(mask, shorter_vec.zmm, row_third_subs_vec.zmm);
+            shuffled_fourth_subs_vec.zmm = _mm512_maskz_permutexvar_epi8(mask, shorter_vec.zmm, row_fourth_subs_vec.zmm);
 
             // To blend we can invoke three `_mm512_cmplt_epu8_mask`, but we can also achieve the same using
             // the AND logical operation, checking the top two bits of every byte.
             // Continuing this thought, we can use the VPTESTMB instruction to output the mask after the AND.
-            __mmask64 is_third_or_fourth = _mm512_mask_test_epi8_mask(mask, longer_vec.zmm, is_third_or_fourth_vec.zmm);
+            __mmask64 is_third_or_fourth = _mm512_mask_test_epi8_mask(mask, shorter_vec.zmm, is_third_or_fourth_vec.zmm);
             __mmask64 is_second_or_fourth =
-                _mm512_mask_test_epi8_mask(mask, longer_vec.zmm, is_second_or_fourth_vec.zmm);
+                _mm512_mask_test_epi8_mask(mask, shorter_vec.zmm, is_second_or_fourth_vec.zmm);
             lookup_substitution_vec.zmm = _mm512_mask_blend_epi8(
                 is_third_or_fourth,
                 // Choose between the first and the second.
@@ -4644,19 +9043,19 @@ SZ_INTERNAL sz_ssize_t _sz_alignment_score_wagner_fisher_upto17m_avx512( //
             // To minimize the number of loads and stores, we can combine our substitution costs with the previous
             // distances, containing the deletion costs.
             {
-                cost_substitution_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + idx_longer);
+                cost_substitution_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + idx_shorter);
                 cost_substitution_vec.zmm = _mm512_add_epi32(
                     cost_substitution_vec.zmm, _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(current_0_31_vec, 0)));
-                cost_deletion_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + 1 + idx_longer);
+                cost_deletion_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + 1 + idx_shorter);
                 cost_deletion_vec.zmm = _mm512_add_epi32(cost_deletion_vec.zmm, gap_vec.zmm);
                 current_vec.zmm = _mm512_max_epi32(cost_substitution_vec.zmm, cost_deletion_vec.zmm);
 
                 // Inclusive prefix minimum computation to combine with insertion costs.
                 // Simply disabling this operation results in 5x performance improvement, meaning
                 // that this operation is responsible for 80% of the total runtime.
-                //    for (sz_size_t idx_longer = 0; idx_longer < longer_length; ++idx_longer) {
-                //        current_distances[idx_longer + 1] =
-                //            sz_max_of_two(current_distances[idx_longer] + gap, current_distances[idx_longer + 1]);
+                //    for (sz_size_t idx_shorter = 0; idx_shorter < shorter_length; ++idx_shorter) {
+                //        current_distances[idx_shorter + 1] =
+                //            sz_max_of_two(current_distances[idx_shorter] + gap, current_distances[idx_shorter + 1]);
                 //    }
                 //
                 // To perform the same operation in vectorized form, we need to perform a tree-like reduction,
@@ -4670,55 +9069,55 @@ SZ_INTERNAL sz_ssize_t _sz_alignment_score_wagner_fisher_upto17m_avx512( //
                 //      ... yet this approach is also quite expensive.
                 for (int i = 0; i != 16; ++i)
                     current_vec.i32s[i] = last_in_row = sz_max_of_two(current_vec.i32s[i], last_in_row + gap);
-                _mm512_mask_storeu_epi32(current_distances + idx_longer + 1, mask, current_vec.zmm);
+                _mm512_mask_storeu_epi32(current_distances + idx_shorter + 1, mask, current_vec.zmm);
             }
 
             // Export the values from 16 to 31.
             if (register_length > 16) {
                 mask = _kshiftri_mask64(mask, 16);
-                cost_substitution_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + idx_longer + 16);
+                cost_substitution_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + idx_shorter + 16);
                 cost_substitution_vec.zmm = _mm512_add_epi32(
                     cost_substitution_vec.zmm, _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(current_0_31_vec, 1)));
-                cost_deletion_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + 1 + idx_longer + 16);
+                cost_deletion_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + 1 + idx_shorter + 16);
                 cost_deletion_vec.zmm = _mm512_add_epi32(cost_deletion_vec.zmm, gap_vec.zmm);
                 current_vec.zmm = _mm512_max_epi32(cost_substitution_vec.zmm, cost_deletion_vec.zmm);
 
                 // Aggregate running insertion costs within the register.
                 for (int i = 0; i != 16; ++i)
                     current_vec.i32s[i] = last_in_row = sz_max_of_two(current_vec.i32s[i], last_in_row + gap);
-                _mm512_mask_storeu_epi32(current_distances + idx_longer + 1 + 16, mask, current_vec.zmm);
+                _mm512_mask_storeu_epi32(current_distances + idx_shorter + 1 + 16, mask, current_vec.zmm);
             }
 
             // Export the values from 32 to 47.
             if (register_length > 32) {
                 mask = _kshiftri_mask64(mask, 16);
-                cost_substitution_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + idx_longer + 32);
+                cost_substitution_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + idx_shorter + 32);
                 cost_substitution_vec.zmm = _mm512_add_epi32(
                     cost_substitution_vec.zmm, _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(current_32_63_vec, 0)));
-                cost_deletion_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + 1 + idx_longer + 32);
+                cost_deletion_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + 1 + idx_shorter + 32);
                 cost_deletion_vec.zmm = _mm512_add_epi32(cost_deletion_vec.zmm, gap_vec.zmm);
                 current_vec.zmm = _mm512_max_epi32(cost_substitution_vec.zmm, cost_deletion_vec.zmm);
 
                 // Aggregate running insertion costs within the register.
                 for (int i = 0; i != 16; ++i)
                     current_vec.i32s[i] = last_in_row = sz_max_of_two(current_vec.i32s[i], last_in_row + gap);
-                _mm512_mask_storeu_epi32(current_distances + idx_longer + 1 + 32, mask, current_vec.zmm);
+                _mm512_mask_storeu_epi32(current_distances + idx_shorter + 1 + 32, mask, current_vec.zmm);
             }
 
             // Export the values from 32 to 47.
             if (register_length > 48) {
                 mask = _kshiftri_mask64(mask, 16);
-                cost_substitution_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + idx_longer + 48);
+                cost_substitution_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + idx_shorter + 48);
                 cost_substitution_vec.zmm = _mm512_add_epi32(
                     cost_substitution_vec.zmm, _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(current_32_63_vec, 1)));
-                cost_deletion_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + 1 + idx_longer + 48);
+                cost_deletion_vec.zmm = _mm512_maskz_loadu_epi32(mask, previous_distances + 1 + idx_shorter + 48);
                 cost_deletion_vec.zmm = _mm512_add_epi32(cost_deletion_vec.zmm, gap_vec.zmm);
                 current_vec.zmm = _mm512_max_epi32(cost_substitution_vec.zmm, cost_deletion_vec.zmm);
 
                 // Aggregate running insertion costs within the register.
                 for (int i = 0; i != 16; ++i)
                     current_vec.i32s[i] = last_in_row = sz_max_of_two(current_vec.i32s[i], last_in_row + gap);
-                _mm512_mask_storeu_epi32(current_distances + idx_longer + 1 + 48, mask, current_vec.zmm);
+                _mm512_mask_storeu_epi32(current_distances + idx_shorter + 1 + 48, mask, current_vec.zmm);
             }
         }
 
@@ -4727,7 +9126,7 @@ SZ_INTERNAL sz_ssize_t _sz_alignment_score_wagner_fisher_upto17m_avx512( //
     }
 
     // Cache scalar before `free` call.
-    sz_ssize_t result = previous_distances[longer_length];
+    sz_ssize_t result = previous_distances[shorter_length];
     alloc->free(distances, buffer_length, alloc->handle);
     return result;
 }
@@ -4833,15 +9232,12 @@ SZ_PUBLIC sz_u64_t _sz_find_charset_neon_register(sz_u128_vec_t h_vec, uint8x16_
     return vreinterpretq_u8_u4(matches_vec);
 }
 
-SZ_PUBLIC sz_cptr_t sz_find_neon(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
-
-    // This almost never fires, but it's better to be safe than sorry.
-    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
-    if (n_length == 1) return sz_find_byte_neon(h, h_length, n);
-
-    // Pick the parts of the needle that are worth comparing.
-    sz_size_t offset_first, offset_mid, offset_last;
-    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+/**
+ *  @brief  Substring search kernel, comparing the three given needle bytes at 16 offsets at a time,
+ *          shared by ::sz_find_neon and ::sz_find_prepared_neon.
+ */
+SZ_INTERNAL sz_cptr_t _sz_find_raita_neon(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length, //
+                                          sz_size_t offset_first, sz_size_t offset_mid, sz_size_t offset_last) {
 
     // Broadcast those characters into SIMD registers.
     sz_u64_t matches;
@@ -4868,7 +9264,34 @@ SZ_PUBLIC sz_cptr_t sz_find_neon(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, s
         }
     }
 
-    return sz_find_serial(h, h_length, n, n_length);
+    // The few remaining offsets are checked one by one, to avoid the setup costs of the serial backend.
+    for (; h_length >= n_length; ++h, --h_length)
+        if (h[offset_first] == n[offset_first] && h[offset_mid] == n[offset_mid] && h[offset_last] == n[offset_last] &&
+            sz_equal(h, n, n_length))
+            return h;
+    return SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_neon(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
+
+    // This almost never fires, but it's better to be safe than sorry.
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+    if (n_length == 1) return sz_find_byte_neon(h, h_length, n);
+
+    // Pick the parts of the needle that are worth comparing.
+    sz_size_t offset_first, offset_mid, offset_last;
+    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+
+    return _sz_find_raita_neon(h, h_length, n, n_length, offset_first, offset_mid, offset_last);
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_prepared_neon(sz_needle_t const *needle, sz_cptr_t h, sz_size_t h_length) {
+
+    sz_size_t const n_length = needle->length;
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+    if (n_length == 1) return sz_find_byte_neon(h, h_length, needle->start);
+    return _sz_find_raita_neon(h, h_length, needle->start, n_length, needle->offset_first, needle->offset_mid,
+                               needle->offset_last);
 }
 
 SZ_PUBLIC sz_cptr_t sz_rfind_neon(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
@@ -4913,6 +9336,137 @@ SZ_PUBLIC sz_cptr_t sz_rfind_neon(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n,
     return sz_rfind_serial(h, h_length, n, n_length);
 }
 
+/**
+ *  @brief  Vectorized version of ::sz_u8_tolower, that sets the 5th bit of the uppercase ASCII and Latin-1 letters.
+ *          Those form the [65, 90] and [192, 222] ranges, except for 215 - the multiplication sign.
+ */
+SZ_INTERNAL uint8x16_t _sz_tolower_neon(uint8x16_t text) {
+    uint8x16_t ascii_upper = vcltq_u8(vsubq_u8(text, vdupq_n_u8('A')), vdupq_n_u8(26));
+    uint8x16_t latin_upper = vbicq_u8(vcltq_u8(vsubq_u8(text, vdupq_n_u8(192)), vdupq_n_u8(31)),
+                                      vceqq_u8(text, vdupq_n_u8(215)));
+    return vorrq_u8(text, vandq_u8(vorrq_u8(ascii_upper, latin_upper), vdupq_n_u8(0x20)));
+}
+
+/**
+ *  @brief  Vectorized version of ::sz_u8_toupper, that clears the 5th bit of the lowercase ASCII and Latin-1 letters.
+ *          Those form the [97, 122] and [224, 254] ranges, except for 247 - the division sign.
+ */
+SZ_INTERNAL uint8x16_t _sz_toupper_neon(uint8x16_t text) {
+    uint8x16_t ascii_lower = vcltq_u8(vsubq_u8(text, vdupq_n_u8('a')), vdupq_n_u8(26));
+    uint8x16_t latin_lower = vbicq_u8(vcltq_u8(vsubq_u8(text, vdupq_n_u8(224)), vdupq_n_u8(31)),
+                                      vceqq_u8(text, vdupq_n_u8(247)));
+    return vbicq_u8(text, vandq_u8(vorrq_u8(ascii_lower, latin_lower), vdupq_n_u8(0x20)));
+}
+
+SZ_PUBLIC void sz_tolower_neon(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    for (; length >= 16; text += 16, result += 16, length -= 16)
+        vst1q_u8((sz_u8_t *)result, _sz_tolower_neon(vld1q_u8((sz_u8_t const *)text)));
+    sz_tolower_serial(text, length, result);
+}
+
+SZ_PUBLIC void sz_toupper_neon(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    for (; length >= 16; text += 16, result += 16, length -= 16)
+        vst1q_u8((sz_u8_t *)result, _sz_toupper_neon(vld1q_u8((sz_u8_t const *)text)));
+    sz_toupper_serial(text, length, result);
+}
+
+SZ_PUBLIC void sz_toascii_neon(sz_cptr_t text, sz_size_t length, sz_ptr_t result) {
+    uint8x16_t const mask_vec = vdupq_n_u8(0x7F);
+    for (; length >= 16; text += 16, result += 16, length -= 16)
+        vst1q_u8((sz_u8_t *)result, vandq_u8(vld1q_u8((sz_u8_t const *)text), mask_vec));
+    sz_toascii_serial(text, length, result);
+}
+
+SZ_PUBLIC void sz_translate_neon(sz_cptr_t text, sz_size_t length, sz_cptr_t lut, sz_ptr_t result) {
+    // The `TBL` instruction looks up 64-byte tables, spread across four registers, returning zeros for larger
+    // indices, while the `TBX` keeps the previous value for those. So we shift the input into every quarter.
+    uint8x16x4_t const lut_0_to_63_vecs = vld1q_u8_x4((sz_u8_t const *)lut);
+    uint8x16x4_t const lut_64_to_127_vecs = vld1q_u8_x4((sz_u8_t const *)lut + 64);
+    uint8x16x4_t const lut_128_to_191_vecs = vld1q_u8_x4((sz_u8_t const *)lut + 128);
+    uint8x16x4_t const lut_192_to_255_vecs = vld1q_u8_x4((sz_u8_t const *)lut + 192);
+    uint8x16_t const quarter_vec = vdupq_n_u8(64);
+    for (; length >= 16; text += 16, result += 16, length -= 16) {
+        uint8x16_t text_vec = vld1q_u8((sz_u8_t const *)text);
+        uint8x16_t result_vec = vqtbl4q_u8(lut_0_to_63_vecs, text_vec);
+        text_vec = vsubq_u8(text_vec, quarter_vec);
+        result_vec = vqtbx4q_u8(result_vec, lut_64_to_127_vecs, text_vec);
+        text_vec = vsubq_u8(text_vec, quarter_vec);
+        result_vec = vqtbx4q_u8(result_vec, lut_128_to_191_vecs, text_vec);
+        text_vec = vsubq_u8(text_vec, quarter_vec);
+        result_vec = vqtbx4q_u8(result_vec, lut_192_to_255_vecs, text_vec);
+        vst1q_u8((sz_u8_t *)result, result_vec);
+    }
+    sz_translate_serial(text, length, lut, result);
+}
+
+SZ_PUBLIC sz_bool_t sz_isascii_neon(sz_cptr_t text, sz_size_t length) {
+    // Merge groups of registers to reduce the number of horizontal reductions on longer inputs.
+    for (; length >= 64; text += 64, length -= 64) {
+        uint8x16x4_t text_vecs = vld1q_u8_x4((sz_u8_t const *)text);
+        uint8x16_t merged_vec = vorrq_u8(vorrq_u8(text_vecs.val[0], text_vecs.val[1]),
+                                         vorrq_u8(text_vecs.val[2], text_vecs.val[3]));
+        if (vmaxvq_u8(merged_vec) & 0x80) return sz_false_k;
+    }
+    for (; length >= 16; text += 16, length -= 16)
+        if (vmaxvq_u8(vld1q_u8((sz_u8_t const *)text)) & 0x80) return sz_false_k;
+    return sz_isascii_serial(text, length);
+}
+
+/**
+ *  @brief  Compares two strings of equal length, folding the case of both, like ::sz_tolower.
+ */
+SZ_INTERNAL sz_bool_t _sz_equal_case_insensitive_neon(sz_cptr_t a, sz_cptr_t b, sz_size_t length) {
+    for (; length >= 16; a += 16, b += 16, length -= 16)
+        if (vminvq_u8(vceqq_u8(_sz_tolower_neon(vld1q_u8((sz_u8_t const *)a)),
+                               _sz_tolower_neon(vld1q_u8((sz_u8_t const *)b)))) != 0xFF)
+            return sz_false_k;
+    return _sz_equal_case_insensitive_serial(a, b, length);
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_case_insensitive_neon(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
+
+    // This almost never fires, but it's better to be safe than sorry.
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+
+    // Pick the parts of the needle that are worth comparing.
+    sz_size_t offset_first, offset_mid, offset_last;
+    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+
+    // Broadcast the folded characters into SIMD registers, along with the bits to set in the haystack.
+    sz_u64_t matches;
+    sz_u128_vec_t h_first_vec, h_mid_vec, h_last_vec, n_first_vec, n_mid_vec, n_last_vec, matches_vec;
+    sz_u128_vec_t n_first_bit_vec, n_mid_bit_vec, n_last_bit_vec;
+    sz_u8_t const n_first = sz_u8_tolower((sz_u8_t)n[offset_first]);
+    sz_u8_t const n_mid = sz_u8_tolower((sz_u8_t)n[offset_mid]);
+    sz_u8_t const n_last = sz_u8_tolower((sz_u8_t)n[offset_last]);
+    n_first_vec.u8x16 = vdupq_n_u8(n_first);
+    n_mid_vec.u8x16 = vdupq_n_u8(n_mid);
+    n_last_vec.u8x16 = vdupq_n_u8(n_last);
+    n_first_bit_vec.u8x16 = vdupq_n_u8(_sz_case_insensitive_filter_bit(n_first));
+    n_mid_bit_vec.u8x16 = vdupq_n_u8(_sz_case_insensitive_filter_bit(n_mid));
+    n_last_bit_vec.u8x16 = vdupq_n_u8(_sz_case_insensitive_filter_bit(n_last));
+
+    // Scan through the string, without fully folding the haystack characters.
+    for (; h_length >= n_length + 16; h += 16, h_length -= 16) {
+        h_first_vec.u8x16 = vorrq_u8(vld1q_u8((sz_u8_t const *)(h + offset_first)), n_first_bit_vec.u8x16);
+        h_mid_vec.u8x16 = vorrq_u8(vld1q_u8((sz_u8_t const *)(h + offset_mid)), n_mid_bit_vec.u8x16);
+        h_last_vec.u8x16 = vorrq_u8(vld1q_u8((sz_u8_t const *)(h + offset_last)), n_last_bit_vec.u8x16);
+        matches_vec.u8x16 = vandq_u8(                           //
+            vandq_u8(                                           //
+                vceqq_u8(h_first_vec.u8x16, n_first_vec.u8x16), //
+                vceqq_u8(h_mid_vec.u8x16, n_mid_vec.u8x16)),
+            vceqq_u8(h_last_vec.u8x16, n_last_vec.u8x16));
+        matches = vreinterpretq_u8_u4(matches_vec.u8x16);
+        while (matches) {
+            int potential_offset = sz_u64_ctz(matches) / 4;
+            if (_sz_equal_case_insensitive_neon(h + potential_offset, n, n_length)) return h + potential_offset;
+            matches &= matches - 1;
+        }
+    }
+
+    return sz_find_case_insensitive_serial(h, h_length, n, n_length);
+}
+
 SZ_PUBLIC sz_cptr_t sz_find_charset_neon(sz_cptr_t h, sz_size_t h_length, sz_charset_t const *set) {
     sz_u64_t matches;
     sz_u128_vec_t h_vec;
@@ -4944,23 +9498,831 @@ SZ_PUBLIC sz_cptr_t sz_rfind_charset_neon(sz_cptr_t h, sz_size_t h_length, sz_ch
     return sz_rfind_charset_serial(h, h_length, set);
 }
 
-#endif // Arm Neon
+SZ_PUBLIC sz_size_t sz_split_offsets_neon(sz_cptr_t text, sz_size_t length, sz_charset_t const *delimiters,
+                                          sz_size_t base, void *offsets, sz_size_t offset_bytes,
+                                          sz_size_t capacity, sz_size_t *consumed) {
+    sz_u64_t matches;
+    sz_u128_vec_t text_vec;
+    uint8x16_t set_top_vec_u8x16 = vld1q_u8(&delimiters->_u8s[0]);
+    uint8x16_t set_bottom_vec_u8x16 = vld1q_u8(&delimiters->_u8s[16]);
+    sz_u32_t *offsets_u32 = (sz_u32_t *)offsets;
+    sz_u64_t *offsets_u64 = (sz_u64_t *)offsets;
+    sz_size_t count = 0, progress = 0;
+
+    // NEON has no compress-stores, but the nibble-masks are sparse for most delimiters, like the newlines.
+    for (; progress + 16 <= length && count != capacity; progress += 16) {
+        text_vec.u8x16 = vld1q_u8((sz_u8_t const *)(text + progress));
+        matches = _sz_find_charset_neon_register(text_vec, set_top_vec_u8x16, set_bottom_vec_u8x16);
+        sz_size_t match_offset = 0;
+        for (; matches && count != capacity; matches &= matches - 1, ++count) {
+            match_offset = sz_u64_ctz(matches) / 4;
+            if (offset_bytes == 4) offsets_u32[count] = (sz_u32_t)(base + progress + match_offset);
+            else offsets_u64[count] = (sz_u64_t)(base + progress + match_offset);
+        }
+        // Out of capacity with more matches left in the register - stop right after the last exported one.
+        if (matches) {
+            if (consumed) *consumed = progress + match_offset + 1;
+            return count;
+        }
+    }
 
-#pragma endregion
+    sz_size_t tail_consumed;
+    count += sz_split_offsets_serial(text + progress, length - progress, delimiters, base + progress,
+                                     (sz_ptr_t)offsets + count * offset_bytes, offset_bytes, capacity - count,
+                                     &tail_consumed);
+    if (consumed) *consumed = progress + tail_consumed;
+    return count;
+}
 
-/*
- *  @brief  Pick the right implementation for the string search algorithms.
+/**
+ *  @brief  Computes the UTF8 validation errors for a block of 16 bytes.
+ *  @see    _sz_utf8_errors_avx512
  */
-#pragma region Compile-Time Dispatching
+SZ_INTERNAL uint8x16_t _sz_utf8_errors_neon(uint8x16_t text_vec, uint8x16_t previous_vec) {
+    // Same tables as in `_sz_utf8_errors_avx512`, check it for the meaning of every bit.
+    static sz_u8_t const byte_1_high_lut[16] = {0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+                                                0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49};
+    static sz_u8_t const byte_1_low_lut[16] = {0xE7, 0xA3, 0x83, 0x83, 0x8B, 0xCB, 0xCB, 0xCB,
+                                               0xCB, 0xCB, 0xCB, 0xCB, 0xCB, 0xDB, 0xCB, 0xCB};
+    static sz_u8_t const byte_2_high_lut[16] = {0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+                                                0xE6, 0xAE, 0xBA, 0xBA, 0x01, 0x01, 0x01, 0x01};
+
+    uint8x16_t const prev1_vec = vextq_u8(previous_vec, text_vec, 15);
+    uint8x16_t const prev2_vec = vextq_u8(previous_vec, text_vec, 14);
+    uint8x16_t const prev3_vec = vextq_u8(previous_vec, text_vec, 13);
+    uint8x16_t const byte_1_high_vec = vqtbl1q_u8(vld1q_u8(byte_1_high_lut), vshrq_n_u8(prev1_vec, 4));
+    uint8x16_t const byte_1_low_vec = vqtbl1q_u8(vld1q_u8(byte_1_low_lut), vandq_u8(prev1_vec, vdupq_n_u8(0x0F)));
+    uint8x16_t const byte_2_high_vec = vqtbl1q_u8(vld1q_u8(byte_2_high_lut), vshrq_n_u8(text_vec, 4));
+    uint8x16_t const special_cases_vec = vandq_u8(vandq_u8(byte_1_high_vec, byte_1_low_vec), byte_2_high_vec);
+
+    uint8x16_t const is_third_byte_vec = vqsubq_u8(prev2_vec, vdupq_n_u8(0xE0 - 0x80));
+    uint8x16_t const is_fourth_byte_vec = vqsubq_u8(prev3_vec, vdupq_n_u8(0xF0 - 0x80));
+    uint8x16_t const must_be_continuation_vec =
+        vandq_u8(vorrq_u8(is_third_byte_vec, is_fourth_byte_vec), vdupq_n_u8(0x80));
+    return veorq_u8(must_be_continuation_vec, special_cases_vec);
+}
+
+SZ_PUBLIC sz_bool_t sz_utf8_valid_neon(sz_cptr_t text, sz_size_t length) {
+    static sz_u8_t const max_tail[16] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                         0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+    uint8x16_t const max_tail_vec = vld1q_u8(max_tail);
+    uint8x16_t previous_vec = vdupq_n_u8(0), incomplete_vec = vdupq_n_u8(0), errors_vec = vdupq_n_u8(0);
+    sz_u128_vec_t text_vec;
 
-SZ_PUBLIC sz_u64_t sz_hash(sz_cptr_t ins, sz_size_t length) { return sz_hash_serial(ins, length); }
-SZ_PUBLIC void sz_tolower(sz_cptr_t ins, sz_size_t length, sz_ptr_t outs) { sz_tolower_serial(ins, length, outs); }
-SZ_PUBLIC void sz_toupper(sz_cptr_t ins, sz_size_t length, sz_ptr_t outs) { sz_toupper_serial(ins, length, outs); }
-SZ_PUBLIC void sz_toascii(sz_cptr_t ins, sz_size_t length, sz_ptr_t outs) { sz_toascii_serial(ins, length, outs); }
-SZ_PUBLIC sz_bool_t sz_isascii(sz_cptr_t ins, sz_size_t length) { return sz_isascii_serial(ins, length); }
+    while (length) {
+        // The tail is copied into a zero-padded buffer, as zeros are valid and terminate the runes.
+        sz_size_t const load_length = sz_min_of_two(length, 16);
+        if (load_length == 16) { text_vec.u8x16 = vld1q_u8((sz_u8_t const *)text); }
+        else {
+            text_vec.u8x16 = vdupq_n_u8(0);
+            for (sz_size_t i = 0; i != load_length; ++i) text_vec.u8s[i] = (sz_u8_t)text[i];
+        }
 
-SZ_PUBLIC void sz_hashes_fingerprint(sz_cptr_t start, sz_size_t length, sz_size_t window_length, sz_ptr_t fingerprint,
-                                     sz_size_t fingerprint_bytes) {
+        // ASCII blocks are valid on their own, but may terminate the runes started in the previous block.
+        if (vmaxvq_u8(text_vec.u8x16) < 0x80) { errors_vec = vorrq_u8(errors_vec, incomplete_vec); }
+        else {
+            errors_vec = vorrq_u8(errors_vec, _sz_utf8_errors_neon(text_vec.u8x16, previous_vec));
+            incomplete_vec = vqsubq_u8(text_vec.u8x16, max_tail_vec);
+        }
+        if (vmaxvq_u8(errors_vec)) return sz_false_k;
+        previous_vec = text_vec.u8x16;
+        text += load_length, length -= load_length;
+    }
+    return (sz_bool_t)(vmaxvq_u8(incomplete_vec) == 0);
+}
+
+SZ_PUBLIC sz_size_t sz_utf8_count_neon(sz_cptr_t text, sz_size_t length) {
+    // All the bytes, except for the continuation bytes `10xxxxxx`, are larger than -65 in two's complement.
+    int8x16_t const continuation_max_vec = vdupq_n_s8(-65);
+    sz_size_t count = 0;
+    for (; length >= 16; text += 16, length -= 16) {
+        uint8x16_t leads_vec = vcgtq_s8(vld1q_s8((sz_i8_t const *)text), continuation_max_vec);
+        count += vaddvq_u8(vandq_u8(leads_vec, vdupq_n_u8(1)));
+    }
+    return count + sz_utf8_count_serial(text, length);
+}
+
+SZ_PUBLIC sz_cptr_t sz_utf8_find_nth_neon(sz_cptr_t text, sz_size_t length, sz_size_t n) {
+    int8x16_t const continuation_max_vec = vdupq_n_s8(-65);
+    for (; length >= 16; text += 16, length -= 16) {
+        uint8x16_t leads_vec = vcgtq_s8(vld1q_s8((sz_i8_t const *)text), continuation_max_vec);
+        sz_size_t const leads_count = vaddvq_u8(vandq_u8(leads_vec, vdupq_n_u8(1)));
+        if (n < leads_count) break;
+        n -= leads_count;
+    }
+    return sz_utf8_find_nth_serial(text, length, n);
+}
+
+SZ_PUBLIC sz_size_t sz_utf8_to_utf32_neon(sz_cptr_t text, sz_size_t length, sz_rune_t *runes) {
+    sz_rune_t *const runes_start = runes;
+    while (length >= 16) {
+        uint8x16_t text_vec = vld1q_u8((sz_u8_t const *)text);
+        // Pure ASCII blocks are just zero-extended.
+        if (vmaxvq_u8(text_vec) < 0x80) {
+            uint16x8_t low_vec = vmovl_u8(vget_low_u8(text_vec)), high_vec = vmovl_u8(vget_high_u8(text_vec));
+            vst1q_u32(runes + 0, vmovl_u16(vget_low_u16(low_vec)));
+            vst1q_u32(runes + 4, vmovl_u16(vget_high_u16(low_vec)));
+            vst1q_u32(runes + 8, vmovl_u16(vget_low_u16(high_vec)));
+            vst1q_u32(runes + 12, vmovl_u16(vget_high_u16(high_vec)));
+            text += 16, length -= 16, runes += 16;
+            continue;
+        }
+        // Otherwise decode serially until the first rune boundary after this block.
+        sz_size_t block_length = 16;
+        while (block_length < length && (text[block_length] & 0xC0) == 0x80) ++block_length;
+        runes += sz_utf8_to_utf32_serial(text, block_length, runes);
+        text += block_length, length -= block_length;
+    }
+    return (sz_size_t)(runes - runes_start) + sz_utf8_to_utf32_serial(text, length, runes);
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_any_neon(sz_multi_pattern_t const *pattern, sz_cptr_t h, sz_size_t h_length,
+                                     sz_size_t *needle_id) {
+
+    sz_size_t const probe_length = pattern->probe_length;
+    if (!probe_length || h_length < probe_length) return SZ_NULL_CHAR;
+
+    // Every probed position has two lookup tables - for the low and the high nibbles of incoming bytes.
+    sz_u64_t matches;
+    sz_u128_vec_t h_vec, h_low_vec, h_high_vec, buckets_vec;
+    uint8x16_t low_nibbles_vecs[3], high_nibbles_vecs[3];
+    for (sz_size_t k = 0; k != probe_length; ++k) {
+        low_nibbles_vecs[k] = vld1q_u8(&pattern->low_nibbles[k][0]);
+        high_nibbles_vecs[k] = vld1q_u8(&pattern->high_nibbles[k][0]);
+    }
+
+    sz_size_t const candidates_count = h_length - probe_length + 1;
+    sz_size_t offset = 0;
+    for (; offset + 16 <= candidates_count; offset += 16) {
+        buckets_vec.u8x16 = vdupq_n_u8(0xFF);
+        for (sz_size_t k = 0; k != probe_length; ++k) {
+            h_vec.u8x16 = vld1q_u8((sz_u8_t const *)(h + offset + k));
+            h_low_vec.u8x16 = vqtbl1q_u8(low_nibbles_vecs[k], vandq_u8(h_vec.u8x16, vdupq_n_u8(0x0F)));
+            h_high_vec.u8x16 = vqtbl1q_u8(high_nibbles_vecs[k], vshrq_n_u8(h_vec.u8x16, 4));
+            buckets_vec.u8x16 = vandq_u8(buckets_vec.u8x16, vandq_u8(h_low_vec.u8x16, h_high_vec.u8x16));
+        }
+        matches = vreinterpretq_u8_u4(vtstq_u8(buckets_vec.u8x16, buckets_vec.u8x16));
+        for (; matches; matches &= matches - 1) {
+            int potential_offset = sz_u64_ctz(matches) / 4;
+            if (_sz_find_any_verify(pattern, h + offset + potential_offset, h_length - offset - potential_offset,
+                                    buckets_vec.u8s[potential_offset], needle_id))
+                return h + offset + potential_offset;
+        }
+    }
+
+    return sz_find_any_serial(pattern, h + offset, h_length - offset, needle_id);
+}
+
+SZ_PUBLIC void sz_hash_batch_neon(sz_sequence_t const *sequence, sz_u64_t *hashes) {
+
+    // Every one of the 2 lanes hashes a different string, using masks to skip the lanes that are exhausted.
+    sz_u128_vec_t lengths_vec, words_vec, chars_low_vec, chars_high_vec;
+    sz_u128_vec_t hash_low_vec, hash_high_vec, next_low_vec, next_high_vec, active_vec;
+    uint64x2_t const prime_vec = vdupq_n_u64(SZ_U64_MAX_PRIME);
+    uint64x2_t const prime_complement_vec = vdupq_n_u64(0ull - SZ_U64_MAX_PRIME);
+    uint64x2_t const shift_high_vec = vdupq_n_u64(77);
+    uint64x2_t const byte_mask_vec = vdupq_n_u64(0xFF);
+    sz_u8_t const *starts[2];
+
+    sz_size_t const count = sequence->count;
+    sz_size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        starts[0] = (sz_u8_t const *)sequence->get_start(sequence, i);
+        starts[1] = (sz_u8_t const *)sequence->get_start(sequence, i + 1);
+        lengths_vec.u64s[0] = sequence->get_length(sequence, i);
+        lengths_vec.u64s[1] = sequence->get_length(sequence, i + 1);
+        sz_size_t const max_length = sz_max_of_two(lengths_vec.u64s[0], lengths_vec.u64s[1]);
+
+        hash_low_vec.u64x2 = vdupq_n_u64(0);
+        hash_high_vec.u64x2 = vdupq_n_u64(0);
+        for (sz_size_t offset = 0; offset < max_length; offset += 8) {
+            words_vec.u64s[0] = _sz_hash_batch_load(starts[0], lengths_vec.u64s[0], offset);
+            words_vec.u64s[1] = _sz_hash_batch_load(starts[1], lengths_vec.u64s[1], offset);
+            for (sz_size_t k = 0; k != 8 && offset + k < max_length; ++k) {
+                chars_low_vec.u64x2 = vandq_u64(words_vec.u64x2, byte_mask_vec);
+                chars_high_vec.u64x2 = vandq_u64(vaddq_u64(chars_low_vec.u64x2, shift_high_vec), byte_mask_vec);
+                words_vec.u64x2 = vshrq_n_u64(words_vec.u64x2, 8);
+
+                // Multiply by 31 and 257 with shifts, as NEON has no 64-bit multiplication, and add the characters.
+                next_low_vec.u64x2 = vsubq_u64(vshlq_n_u64(hash_low_vec.u64x2, 5), hash_low_vec.u64x2);
+                next_low_vec.u64x2 = vaddq_u64(next_low_vec.u64x2, chars_low_vec.u64x2);
+                next_high_vec.u64x2 = vaddq_u64(vshlq_n_u64(hash_high_vec.u64x2, 8), hash_high_vec.u64x2);
+                next_high_vec.u64x2 = vaddq_u64(next_high_vec.u64x2, chars_high_vec.u64x2);
+
+                // Compute the modulo by conditionally subtracting the prime.
+                next_low_vec.u64x2 = vbslq_u64(vcgeq_u64(next_low_vec.u64x2, prime_vec),
+                                               vaddq_u64(next_low_vec.u64x2, prime_complement_vec), next_low_vec.u64x2);
+                next_high_vec.u64x2 = vbslq_u64(vcgeq_u64(next_high_vec.u64x2, prime_vec),
+                                                vaddq_u64(next_high_vec.u64x2, prime_complement_vec),
+                                                next_high_vec.u64x2);
+
+                // Only update the lanes, where the strings are long enough.
+                active_vec.u64x2 = vcgtq_u64(lengths_vec.u64x2, vdupq_n_u64(offset + k));
+                hash_low_vec.u64x2 = vbslq_u64(active_vec.u64x2, next_low_vec.u64x2, hash_low_vec.u64x2);
+                hash_high_vec.u64x2 = vbslq_u64(active_vec.u64x2, next_high_vec.u64x2, hash_high_vec.u64x2);
+            }
+        }
+
+        hashes[i] = (hash_low_vec.u64s[0] * 11400714819323198485ull) ^
+                    (hash_high_vec.u64s[0] * 11400714819323198485ull);
+        hashes[i + 1] = (hash_low_vec.u64s[1] * 11400714819323198485ull) ^
+                        (hash_high_vec.u64s[1] * 11400714819323198485ull);
+    }
+
+    for (; i != count; ++i)
+        hashes[i] = sz_hash_serial(sequence->get_start(sequence, i), sequence->get_length(sequence, i));
+}
+
+/**
+ *  @brief  Computes the Needleman-Wunsch alignment score, evaluating the matrix in anti-diagonal order,
+ *          similar to `sz_alignment_score_avx2`, but with 4 cells per register.
+ *
+ *  NEON has no gathers, and the TBL instructions can only address 64 bytes at a time, while the costs on an
+ *  anti-diagonal come from different rows of the 256 x 256 matrix. So the 4 costs are fetched with scalar loads,
+ *  which are still cheaper than the data-dependency between the neighboring cells of the horizontal order.
+ */
+SZ_PUBLIC sz_ssize_t sz_alignment_score_neon(         //
+    sz_cptr_t longer, sz_size_t longer_length,        //
+    sz_cptr_t shorter, sz_size_t shorter_length,      //
+    sz_error_cost_t const *subs, sz_error_cost_t gap, //
+    sz_memory_allocator_t *alloc) {
+
+    // If one of the strings is empty - the edit distance is equal to the length of the other one
+    if (longer_length == 0) return (sz_ssize_t)shorter_length * gap;
+    if (shorter_length == 0) return (sz_ssize_t)longer_length * gap;
+
+    // Let's make sure that we use the amount proportional to the
+    // number of elements in the shorter string, not the larger.
+    if (shorter_length > longer_length) {
+        sz_pointer_swap((void **)&longer_length, (void **)&shorter_length);
+        sz_pointer_swap((void **)&longer, (void **)&shorter);
+    }
+    if (longer_length >= 256ull * 256ull * 256ull)
+        return sz_alignment_score_serial(longer, longer_length, shorter, shorter_length, subs, gap, alloc);
+
+    // Simplify usage in higher-level libraries, where wrapping custom allocators may be troublesome.
+    sz_memory_allocator_t global_alloc;
+    if (!alloc) {
+        sz_memory_allocator_init_default(&global_alloc);
+        alloc = &global_alloc;
+    }
+
+    // We are going to store 3 anti-diagonals of the matrix, indexed by the position in the shorter string,
+    // and a reversed copy of the longer string.
+    sz_size_t const n = shorter_length + 1;
+    sz_size_t const buffer_length = sizeof(sz_i32_t) * n * 3 + longer_length;
+    sz_i32_t *const distances = (sz_i32_t *)alloc->allocate(buffer_length, alloc->handle);
+    if (!distances) return SZ_SSIZE_MAX;
+    sz_i32_t *previous_distances = distances;
+    sz_i32_t *current_distances = previous_distances + n;
+    sz_i32_t *next_distances = current_distances + n;
+    sz_u8_t *const longer_reversed = (sz_u8_t *)(next_distances + n);
+    sz_u8_t const *const longer_unsigned = (sz_u8_t const *)longer;
+    sz_u8_t const *const shorter_unsigned = (sz_u8_t const *)shorter;
+    for (sz_size_t i = 0; i != longer_length; ++i) longer_reversed[i] = longer_unsigned[longer_length - i - 1];
+
+    // Initialize the first two diagonals.
+    previous_distances[0] = 0;
+    current_distances[0] = current_distances[1] = gap;
+
+    int32x4_t const gap_vec = vdupq_n_s32(gap);
+    sz_size_t const diagonals_count = shorter_length + longer_length + 1;
+    for (sz_size_t diagonal = 2; diagonal != diagonals_count; ++diagonal) {
+        // The `i`-th cell of this diagonal is at the `i`-th row and the `diagonal - i`-th column of the matrix.
+        sz_size_t const first_row = diagonal > longer_length ? diagonal - longer_length : 1;
+        sz_size_t const last_row = sz_min_of_two(shorter_length, diagonal - 1);
+        if (diagonal <= longer_length) next_distances[0] = (sz_i32_t)diagonal * gap;
+        if (diagonal <= shorter_length) next_distances[diagonal] = (sz_i32_t)diagonal * gap;
+
+        // The `j - 1 = diagonal - i - 1` column maps to the `longer_length - diagonal + i` reversed character.
+        sz_u8_t const *const longer_chars = longer_reversed + longer_length - diagonal;
+        sz_size_t i = first_row;
+        for (; i + 4 <= last_row + 1; i += 4) {
+            sz_i32_t costs[4];
+            costs[0] = subs[longer_chars[i + 0] * 256u + shorter_unsigned[i - 1]];
+            costs[1] = subs[longer_chars[i + 1] * 256u + shorter_unsigned[i + 0]];
+            costs[2] = subs[longer_chars[i + 2] * 256u + shorter_unsigned[i + 1]];
+            costs[3] = subs[longer_chars[i + 3] * 256u + shorter_unsigned[i + 2]];
+
+            int32x4_t substitution_vec = vld1q_s32(previous_distances + i - 1);
+            int32x4_t deletion_vec = vld1q_s32(current_distances + i - 1);
+            int32x4_t insertion_vec = vld1q_s32(current_distances + i);
+            substitution_vec = vaddq_s32(substitution_vec, vld1q_s32(costs));
+            deletion_vec = vaddq_s32(vmaxq_s32(deletion_vec, insertion_vec), gap_vec);
+            vst1q_s32(next_distances + i, vmaxq_s32(substitution_vec, deletion_vec));
+        }
+        for (; i <= last_row; ++i) {
+            sz_i32_t cost_substitution =
+                previous_distances[i - 1] + subs[longer_chars[i] * 256u + shorter_unsigned[i - 1]];
+            sz_i32_t cost_deletion_or_insertion = sz_max_of_two(current_distances[i - 1], current_distances[i]) + gap;
+            next_distances[i] = sz_max_of_two(cost_substitution, cost_deletion_or_insertion);
+        }
+
+        // Perform a circular rotation of those buffers, to reuse the memory.
+        sz_i32_t *temporary = previous_distances;
+        previous_distances = current_distances;
+        current_distances = next_distances;
+        next_distances = temporary;
+    }
+
+    // Cache scalar before `free` call.
+    sz_ssize_t result = current_distances[shorter_length];
+    alloc->free(distances, buffer_length, alloc->handle);
+    return result;
+}
+
+SZ_PUBLIC sz_size_t sz_fingerprints_top_k_neon(sz_cptr_t query, sz_cptr_t fingerprints, sz_size_t fingerprint_bytes,
+                                               sz_sorted_idx_t const *ids, sz_size_t count, sz_size_t k,
+                                               sz_fingerprint_metric_t metric, sz_fingerprint_match_t *matches) {
+    sz_size_t size = 0;
+    if (!k) return 0;
+
+    sz_size_t const body_bytes = fingerprint_bytes & ~(sz_size_t)15;
+    sz_u128_vec_t query_vec, fingerprint_vec;
+    for (sz_size_t i = 0; i != count; ++i) {
+        sz_fingerprint_match_t candidate;
+        candidate.id = ids ? (sz_size_t)ids[i] : i;
+        sz_cptr_t const fingerprint = fingerprints + candidate.id * fingerprint_bytes;
+
+        // The `CNT` instruction counts the bits in every byte, and the 16 counts can't exceed 128,
+        // so they can be summed horizontally with `ADDV` into a single byte for every block.
+        sz_size_t intersection = 0, union_size = 0, j = 0;
+        for (; j != body_bytes; j += 16) {
+            query_vec.u8x16 = vld1q_u8((sz_u8_t const *)(query + j));
+            fingerprint_vec.u8x16 = vld1q_u8((sz_u8_t const *)(fingerprint + j));
+            intersection += vaddvq_u8(vcntq_u8(vandq_u8(query_vec.u8x16, fingerprint_vec.u8x16)));
+            union_size += vaddvq_u8(vcntq_u8(vorrq_u8(query_vec.u8x16, fingerprint_vec.u8x16)));
+        }
+        for (; j != fingerprint_bytes; ++j) {
+            sz_u8_t const query_byte = (sz_u8_t)query[j], fingerprint_byte = (sz_u8_t)fingerprint[j];
+            intersection += sz_u64_popcount(query_byte & fingerprint_byte);
+            union_size += sz_u64_popcount(query_byte | fingerprint_byte);
+        }
+
+        candidate.intersection = (sz_u32_t)intersection;
+        candidate.union_size = (sz_u32_t)union_size;
+        _sz_fingerprint_heap_push(matches, &size, k, &candidate, metric);
+    }
+    _sz_fingerprint_heap_sort(matches, size, metric);
+    return size;
+}
+
+#endif // Arm Neon
+
+#pragma endregion
+
+/*  @brief  Implementation of the string search algorithms using the Arm SVE and SVE2 instruction sets, available on
+ *          Graviton 3, Neoverse V1 and newer cores. Unlike NEON, those kernels are vector-length agnostic: they
+ *          process `svcntb()` bytes per iteration and handle the tails with predicated loads and stores.
+ */
+#pragma region ARM SVE
+
+#if SZ_USE_ARM_SVE
+#pragma GCC push_options
+#pragma GCC target("arch=armv8.2-a+sve")
+#pragma clang attribute push(__attribute__((target("arch=armv8.2-a+sve"))), apply_to = function)
+
+SZ_PUBLIC sz_bool_t sz_equal_sve(sz_cptr_t a, sz_cptr_t b, sz_size_t length) {
+    sz_u8_t const *a_bytes = (sz_u8_t const *)a, *b_bytes = (sz_u8_t const *)b;
+    sz_size_t const vector_length = svcntb();
+    for (sz_size_t progress = 0; progress < length; progress += vector_length) {
+        svbool_t const progress_mask = svwhilelt_b8_u64(progress, length);
+        svuint8_t const a_vec = svld1_u8(progress_mask, a_bytes + progress);
+        svuint8_t const b_vec = svld1_u8(progress_mask, b_bytes + progress);
+        if (svptest_any(progress_mask, svcmpne_u8(progress_mask, a_vec, b_vec))) return sz_false_k;
+    }
+    return sz_true_k;
+}
+
+SZ_PUBLIC sz_ordering_t sz_order_sve(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length) {
+    sz_ordering_t ordering_lookup[2] = {sz_greater_k, sz_less_k};
+    sz_u8_t const *a_bytes = (sz_u8_t const *)a, *b_bytes = (sz_u8_t const *)b;
+    sz_size_t const min_length = sz_min_of_two(a_length, b_length);
+    sz_size_t const vector_length = svcntb();
+    for (sz_size_t progress = 0; progress < min_length; progress += vector_length) {
+        svbool_t const progress_mask = svwhilelt_b8_u64(progress, min_length);
+        svuint8_t const a_vec = svld1_u8(progress_mask, a_bytes + progress);
+        svuint8_t const b_vec = svld1_u8(progress_mask, b_bytes + progress);
+        svbool_t const mismatches = svcmpne_u8(progress_mask, a_vec, b_vec);
+        if (svptest_any(progress_mask, mismatches)) {
+            // All the lanes before the first mismatch are equal, so we can just count them.
+            sz_size_t const offset = progress + svcntp_b8(progress_mask, svbrkb_b_z(progress_mask, mismatches));
+            return ordering_lookup[a_bytes[offset] < b_bytes[offset]];
+        }
+    }
+    return a_length != b_length ? ordering_lookup[a_length < b_length] : sz_equal_k;
+}
+
+SZ_PUBLIC void sz_copy_sve(sz_ptr_t target, sz_cptr_t source, sz_size_t length) {
+    sz_u8_t *target_bytes = (sz_u8_t *)target;
+    sz_u8_t const *source_bytes = (sz_u8_t const *)source;
+    sz_size_t const vector_length = svcntb();
+    for (sz_size_t progress = 0; progress < length; progress += vector_length) {
+        svbool_t const progress_mask = svwhilelt_b8_u64(progress, length);
+        svst1_u8(progress_mask, target_bytes + progress, svld1_u8(progress_mask, source_bytes + progress));
+    }
+}
+
+SZ_PUBLIC void sz_fill_sve(sz_ptr_t target, sz_size_t length, sz_u8_t value) {
+    sz_u8_t *target_bytes = (sz_u8_t *)target;
+    svuint8_t const value_vec = svdup_n_u8(value);
+    sz_size_t const vector_length = svcntb();
+    for (sz_size_t progress = 0; progress < length; progress += vector_length)
+        svst1_u8(svwhilelt_b8_u64(progress, length), target_bytes + progress, value_vec);
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_byte_sve(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n) {
+    sz_u8_t const *h_bytes = (sz_u8_t const *)h;
+    svuint8_t const n_vec = svdup_n_u8(*(sz_u8_t const *)n);
+    sz_size_t const vector_length = svcntb();
+    for (sz_size_t progress = 0; progress < h_length; progress += vector_length) {
+        svbool_t const progress_mask = svwhilelt_b8_u64(progress, h_length);
+        svbool_t const matches = svcmpeq_u8(progress_mask, svld1_u8(progress_mask, h_bytes + progress), n_vec);
+        if (svptest_any(progress_mask, matches))
+            return h + progress + svcntp_b8(progress_mask, svbrkb_b_z(progress_mask, matches));
+    }
+    return SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC sz_cptr_t sz_rfind_byte_sve(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n) {
+    sz_u8_t const *h_bytes = (sz_u8_t const *)h;
+    svuint8_t const n_vec = svdup_n_u8(*(sz_u8_t const *)n);
+    // Even the longest 2048-bit vectors have just 256 byte lanes, so their indices fit into 8-bit integers.
+    svuint8_t const indices_vec = svindex_u8(0, 1);
+    sz_size_t const vector_length = svcntb();
+    for (sz_size_t remaining = h_length; remaining;) {
+        sz_size_t const chunk_length = sz_min_of_two(remaining, vector_length);
+        sz_size_t const progress = remaining - chunk_length;
+        svbool_t const chunk_mask = svwhilelt_b8_u64(0, chunk_length);
+        svbool_t const matches = svcmpeq_u8(chunk_mask, svld1_u8(chunk_mask, h_bytes + progress), n_vec);
+        if (svptest_any(chunk_mask, matches)) return h + progress + svmaxv_u8(matches, indices_vec);
+        remaining = progress;
+    }
+    return SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_sve(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
+
+    // This almost never fires, but it's better to be safe than sorry.
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+    if (n_length == 1) return sz_find_byte_sve(h, h_length, n);
+
+    // Pick the parts of the needle that are worth comparing.
+    sz_size_t offset_first, offset_mid, offset_last;
+    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+
+    // Broadcast those characters into SIMD registers.
+    sz_u8_t const *h_bytes = (sz_u8_t const *)h, *n_bytes = (sz_u8_t const *)n;
+    svuint8_t const n_first_vec = svdup_n_u8(n_bytes[offset_first]);
+    svuint8_t const n_mid_vec = svdup_n_u8(n_bytes[offset_mid]);
+    svuint8_t const n_last_vec = svdup_n_u8(n_bytes[offset_last]);
+    svuint8_t const indices_vec = svindex_u8(0, 1);
+
+    // Every comparison is predicated on the previous one, so the later loads skip the lanes that already failed.
+    sz_size_t const vector_length = svcntb();
+    sz_size_t const candidates = h_length - n_length + 1;
+    for (sz_size_t progress = 0; progress < candidates; progress += vector_length) {
+        svbool_t const progress_mask = svwhilelt_b8_u64(progress, candidates);
+        svbool_t matches;
+        matches = svcmpeq_u8(progress_mask, svld1_u8(progress_mask, h_bytes + progress + offset_first), n_first_vec);
+        matches = svcmpeq_u8(matches, svld1_u8(matches, h_bytes + progress + offset_mid), n_mid_vec);
+        matches = svcmpeq_u8(matches, svld1_u8(matches, h_bytes + progress + offset_last), n_last_vec);
+        while (svptest_any(progress_mask, matches)) {
+            sz_size_t const potential_offset = svminv_u8(matches, indices_vec);
+            if (sz_equal_sve(h + progress + potential_offset, n, n_length)) return h + progress + potential_offset;
+            matches = svcmpgt_n_u8(matches, indices_vec, (sz_u8_t)potential_offset);
+        }
+    }
+    return SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC sz_cptr_t sz_rfind_sve(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
+
+    // This almost never fires, but it's better to be safe than sorry.
+    if (h_length < n_length || !n_length) return SZ_NULL_CHAR;
+    if (n_length == 1) return sz_rfind_byte_sve(h, h_length, n);
+
+    // Pick the parts of the needle that are worth comparing.
+    sz_size_t offset_first, offset_mid, offset_last;
+    _sz_locate_needle_anomalies(n, n_length, &offset_first, &offset_mid, &offset_last);
+
+    // Broadcast those characters into SIMD registers.
+    sz_u8_t const *h_bytes = (sz_u8_t const *)h, *n_bytes = (sz_u8_t const *)n;
+    svuint8_t const n_first_vec = svdup_n_u8(n_bytes[offset_first]);
+    svuint8_t const n_mid_vec = svdup_n_u8(n_bytes[offset_mid]);
+    svuint8_t const n_last_vec = svdup_n_u8(n_bytes[offset_last]);
+    svuint8_t const indices_vec = svindex_u8(0, 1);
+
+    // Check `sz_find_sve` for explanations.
+    sz_size_t const vector_length = svcntb();
+    for (sz_size_t remaining = h_length - n_length + 1; remaining;) {
+        sz_size_t const chunk_length = sz_min_of_two(remaining, vector_length);
+        sz_size_t const progress = remaining - chunk_length;
+        svbool_t const chunk_mask = svwhilelt_b8_u64(0, chunk_length);
+        svbool_t matches;
+        matches = svcmpeq_u8(chunk_mask, svld1_u8(chunk_mask, h_bytes + progress + offset_first), n_first_vec);
+        matches = svcmpeq_u8(matches, svld1_u8(matches, h_bytes + progress + offset_mid), n_mid_vec);
+        matches = svcmpeq_u8(matches, svld1_u8(matches, h_bytes + progress + offset_last), n_last_vec);
+        while (svptest_any(chunk_mask, matches)) {
+            sz_size_t const potential_offset = svmaxv_u8(matches, indices_vec);
+            if (sz_equal_sve(h + progress + potential_offset, n, n_length)) return h + progress + potential_offset;
+            matches = svcmplt_n_u8(matches, indices_vec, (sz_u8_t)potential_offset);
+        }
+        remaining = progress;
+    }
+    return SZ_NULL_CHAR;
+}
+
+/**
+ *  @brief  Computes the modulo of every 64-bit lane, assuming it's below twice the `SZ_U64_MAX_PRIME`.
+ *          Mirrors the `_sz_prime_mod` macro used by the serial backend.
+ */
+SZ_INTERNAL svuint64_t _sz_prime_mod_sve(svuint64_t hash_vec) {
+    svbool_t const all_mask = svptrue_b64();
+    svuint64_t const prime_vec = svdup_n_u64(SZ_U64_MAX_PRIME);
+    return svsub_u64_m(svcmpge_u64(all_mask, hash_vec, prime_vec), hash_vec, prime_vec);
+}
+
+SZ_PUBLIC void sz_hashes_sve(sz_cptr_t start, sz_size_t length, sz_size_t window_length, sz_size_t step, //
+                             sz_hash_callback_t callback, void *callback_handle) {
+
+    if (length < window_length || !window_length) return;
+    sz_size_t const lanes = svcntd();
+    if (length < lanes * window_length) {
+        sz_hashes_serial(start, length, window_length, step, callback, callback_handle);
+        return;
+    }
+
+    // Similar to the AVX-512 kernel, slice the entire string into overlapping parts, one per 64-bit lane,
+    // and slide over them in parallel, gathering one character from every slice on each iteration.
+    sz_size_t const max_hashes = length - window_length + 1;
+    sz_size_t const min_hashes_per_thread = max_hashes / lanes; // At most one sequence can overlap between 2 threads.
+    sz_size_t const last_slice_offset = min_hashes_per_thread * (lanes - 1);
+    sz_u8_t const *text = (sz_u8_t const *)start;
+    svbool_t const all_mask = svptrue_b64();
+    svuint64_t const slices_vec = svindex_u64(0, min_hashes_per_thread);
+
+    // Prepare the `prime ^ window_length` values, that we are going to use for modulo arithmetic.
+    sz_u64_t prime_power_low = 1, prime_power_high = 1;
+    for (sz_size_t i = 0; i + 1 < window_length; ++i)
+        prime_power_low = (prime_power_low * 31ull) % SZ_U64_MAX_PRIME,
+        prime_power_high = (prime_power_high * 257ull) % SZ_U64_MAX_PRIME;
+
+    // Compute the initial hash values for every one of the slices.
+    svuint64_t hash_low_vec = svdup_n_u64(0), hash_high_vec = svdup_n_u64(0), chars_vec, hash_mix_vec;
+    for (sz_size_t i = 0; i != window_length; ++i) {
+        chars_vec = svld1ub_gather_u64offset_u64(all_mask, text + i, slices_vec);
+        hash_low_vec = _sz_prime_mod_sve(svmla_n_u64_x(all_mask, chars_vec, hash_low_vec, 31ull));
+        chars_vec = svand_n_u64_x(all_mask, svadd_n_u64_x(all_mask, chars_vec, 77ull), 0xFFull);
+        hash_high_vec = _sz_prime_mod_sve(svmla_n_u64_x(all_mask, chars_vec, hash_high_vec, 257ull));
+    }
+
+    // The widest 2048-bit vectors have 32 lanes, so the mixed hashes can be exported through a small buffer.
+    sz_u64_t hash_mix_buffer[32];
+    hash_mix_vec = sveor_u64_x(all_mask, svmul_n_u64_x(all_mask, hash_low_vec, 11400714819323198485ull),
+                               svmul_n_u64_x(all_mask, hash_high_vec, 11400714819323198485ull));
+    svst1_u64(all_mask, hash_mix_buffer, hash_mix_vec);
+    for (sz_size_t lane = 0; lane != lanes; ++lane)
+        callback((sz_cptr_t)(text + window_length + lane * min_hashes_per_thread), window_length,
+                 hash_mix_buffer[lane], callback_handle);
+
+    // Now repeat that operation for the remaining characters, discarding older characters.
+    sz_size_t cycle = 1;
+    sz_size_t const step_mask = step - 1;
+    for (sz_size_t i = window_length; i + last_slice_offset != length; ++i, ++cycle) {
+        // Discard one character from every slice:
+        chars_vec = svld1ub_gather_u64offset_u64(all_mask, text + i - window_length, slices_vec);
+        hash_low_vec = svmls_n_u64_x(all_mask, hash_low_vec, chars_vec, prime_power_low);
+        chars_vec = svand_n_u64_x(all_mask, svadd_n_u64_x(all_mask, chars_vec, 77ull), 0xFFull);
+        hash_high_vec = svmls_n_u64_x(all_mask, hash_high_vec, chars_vec, prime_power_high);
+        // And add a new one, wrapping the hashes around:
+        chars_vec = svld1ub_gather_u64offset_u64(all_mask, text + i, slices_vec);
+        hash_low_vec = _sz_prime_mod_sve(svmla_n_u64_x(all_mask, chars_vec, hash_low_vec, 31ull));
+        chars_vec = svand_n_u64_x(all_mask, svadd_n_u64_x(all_mask, chars_vec, 77ull), 0xFFull);
+        hash_high_vec = _sz_prime_mod_sve(svmla_n_u64_x(all_mask, chars_vec, hash_high_vec, 257ull));
+        // Mix only if we've skipped enough hashes.
+        if ((cycle & step_mask) == 0) {
+            hash_mix_vec = sveor_u64_x(all_mask, svmul_n_u64_x(all_mask, hash_low_vec, 11400714819323198485ull),
+                                       svmul_n_u64_x(all_mask, hash_high_vec, 11400714819323198485ull));
+            svst1_u64(all_mask, hash_mix_buffer, hash_mix_vec);
+            for (sz_size_t lane = 0; lane != lanes; ++lane)
+                callback((sz_cptr_t)(text + i + lane * min_hashes_per_thread), window_length, hash_mix_buffer[lane],
+                         callback_handle);
+        }
+    }
+}
+
+#pragma clang attribute pop
+#pragma GCC pop_options
+#endif // Arm SVE
+
+#if SZ_USE_ARM_SVE2
+#pragma GCC push_options
+#pragma GCC target("arch=armv8.2-a+sve2")
+#pragma clang attribute push(__attribute__((target("arch=armv8.2-a+sve2"))), apply_to = function)
+
+/**
+ *  @brief  Packs the members of a small character set into two 16-byte tables for the SVE2 `MATCH` instruction,
+ *          which compares every byte against all the bytes of the same 128-bit segment of the other vector.
+ *          The unused slots are padded with repetitions of the first member.
+ *  @return False, if the set is empty or has more than 32 members, and the bitset-based kernels should be used.
+ */
+SZ_INTERNAL sz_bool_t _sz_charset_members_sve2(sz_charset_t const *set, sz_u8_t *members) {
+    sz_size_t count = 0;
+    for (sz_size_t word = 0; word != 4; ++word) count += sz_u64_popcount(set->_u64s[word]);
+    if (!count || count > 32) return sz_false_k;
+    count = 0;
+    for (sz_size_t word = 0; word != 4; ++word)
+        for (sz_u64_t bits = set->_u64s[word]; bits; bits &= bits - 1)
+            members[count++] = (sz_u8_t)(word * 64 + sz_u64_ctz(bits));
+    for (; count != 32; ++count) members[count] = members[0];
+    return sz_true_k;
+}
+
+SZ_PUBLIC sz_cptr_t sz_find_charset_sve2(sz_cptr_t text, sz_size_t length, sz_charset_t const *set) {
+    sz_u8_t members[32];
+    if (!_sz_charset_members_sve2(set, members))
+#if SZ_USE_ARM_NEON
+        return sz_find_charset_neon(text, length, set);
+#else
+        return sz_find_charset_serial(text, length, set);
+#endif
+
+    // Replicate both 16-byte tables into every 128-bit segment of the vectors.
+    sz_u8_t const *text_bytes = (sz_u8_t const *)text;
+    svuint8_t const members_low_vec = svld1rq_u8(svptrue_b8(), members);
+    svuint8_t const members_high_vec = svld1rq_u8(svptrue_b8(), members + 16);
+    sz_size_t const vector_length = svcntb();
+    for (sz_size_t progress = 0; progress < length; progress += vector_length) {
+        svbool_t const progress_mask = svwhilelt_b8_u64(progress, length);
+        svuint8_t const text_vec = svld1_u8(progress_mask, text_bytes + progress);
+        svbool_t const matches = svorr_b_z(progress_mask, svmatch_u8(progress_mask, text_vec, members_low_vec),
+                                           svmatch_u8(progress_mask, text_vec, members_high_vec));
+        if (svptest_any(progress_mask, matches))
+            return text + progress + svcntp_b8(progress_mask, svbrkb_b_z(progress_mask, matches));
+    }
+    return SZ_NULL_CHAR;
+}
+
+SZ_PUBLIC sz_cptr_t sz_rfind_charset_sve2(sz_cptr_t text, sz_size_t length, sz_charset_t const *set) {
+    sz_u8_t members[32];
+    if (!_sz_charset_members_sve2(set, members))
+#if SZ_USE_ARM_NEON
+        return sz_rfind_charset_neon(text, length, set);
+#else
+        return sz_rfind_charset_serial(text, length, set);
+#endif
+
+    // Check `sz_find_charset_sve2` for explanations.
+    sz_u8_t const *text_bytes = (sz_u8_t const *)text;
+    svuint8_t const members_low_vec = svld1rq_u8(svptrue_b8(), members);
+    svuint8_t const members_high_vec = svld1rq_u8(svptrue_b8(), members + 16);
+    svuint8_t const indices_vec = svindex_u8(0, 1);
+    sz_size_t const vector_length = svcntb();
+    for (sz_size_t remaining = length; remaining;) {
+        sz_size_t const chunk_length = sz_min_of_two(remaining, vector_length);
+        sz_size_t const progress = remaining - chunk_length;
+        svbool_t const chunk_mask = svwhilelt_b8_u64(0, chunk_length);
+        svuint8_t const text_vec = svld1_u8(chunk_mask, text_bytes + progress);
+        svbool_t const matches = svorr_b_z(chunk_mask, svmatch_u8(chunk_mask, text_vec, members_low_vec),
+                                           svmatch_u8(chunk_mask, text_vec, members_high_vec));
+        if (svptest_any(chunk_mask, matches)) return text + progress + svmaxv_u8(matches, indices_vec);
+        remaining = progress;
+    }
+    return SZ_NULL_CHAR;
+}
+
+#pragma clang attribute pop
+#pragma GCC pop_options
+#endif // Arm SVE2
+
+#pragma endregion
+
+#pragma region Capability Detection
+
+/**
+ *  @brief  Queries the CPU for the SIMD capabilities, ignoring the user-provided overrides.
+ */
+SZ_INTERNAL sz_capability_t _sz_capabilities_detect(void) {
+
+#if SZ_USE_X86_AVX512 || SZ_USE_X86_AVX2
+
+    /// The states of 4 registers populated for a specific "cpuid" assembly call
+    union four_registers_t {
+        int array[4];
+        struct separate_t {
+            unsigned eax, ebx, ecx, edx;
+        } named;
+    } info0, info1, info7 = {{0, 0, 0, 0}};
+
+#ifdef _MSC_VER
+    __cpuidex(info0.array, 0, 0);
+    __cpuidex(info1.array, 1, 0);
+    if (info0.named.eax >= 7) __cpuidex(info7.array, 7, 0);
+#else
+    __asm__ __volatile__("cpuid"
+                         : "=a"(info0.named.eax), "=b"(info0.named.ebx), "=c"(info0.named.ecx), "=d"(info0.named.edx)
+                         : "a"(0), "c"(0));
+    __asm__ __volatile__("cpuid"
+                         : "=a"(info1.named.eax), "=b"(info1.named.ebx), "=c"(info1.named.ecx), "=d"(info1.named.edx)
+                         : "a"(1), "c"(0));
+    // Older CPUs return the data of the highest supported leaf for the unsupported ones, so check the range first
+    if (info0.named.eax >= 7)
+        __asm__ __volatile__("cpuid"
+                             : "=a"(info7.named.eax), "=b"(info7.named.ebx), "=c"(info7.named.ecx),
+                               "=d"(info7.named.edx)
+                             : "a"(7), "c"(0));
+#endif
+
+    // The CPU may support AVX, while the OS doesn't preserve the wider registers on context switches.
+    // So check for OSXSAVE (Function ID 1, ECX register) and the enabled states in the XCR0 register.
+    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L116
+    unsigned long long xcr0 = 0;
+    if (info1.named.ecx & 0x08000000) {
+#ifdef _MSC_VER
+        xcr0 = _xgetbv(0);
+#else
+        unsigned xcr0_low, xcr0_high;
+        __asm__ __volatile__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+        xcr0 = ((unsigned long long)xcr0_high << 32) | xcr0_low;
+#endif
+    }
+    // The XMM and YMM states for AVX, plus the opmask and both halves of the ZMM registers for AVX-512
+    unsigned os_supports_avx = (xcr0 & 0x06) == 0x06;
+    unsigned os_supports_avx512 = os_supports_avx && (xcr0 & 0xE0) == 0xE0;
+
+    // Check for AVX2 (Function ID 7, EBX register)
+    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L148
+    unsigned supports_avx2 = (info7.named.ebx & 0x00000020) != 0;
+    // Check for AVX512F (Function ID 7, EBX register)
+    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L155
+    unsigned supports_avx512f = (info7.named.ebx & 0x00010000) != 0;
+    // Check for AVX512BW (Function ID 7, EBX register)
+    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L166
+    unsigned supports_avx512bw = (info7.named.ebx & 0x40000000) != 0;
+    // Check for AVX512VL (Function ID 7, EBX register)
+    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L167C25-L167C35
+    unsigned supports_avx512vl = (info7.named.ebx & 0x80000000) != 0;
+    // Check for AVX512VBMI (Function ID 7, ECX register)
+    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L171C30-L171C40
+    unsigned supports_avx512vbmi = (info7.named.ecx & 0x00000002) != 0;
+    // Check for GFNI (Function ID 7, ECX register)
+    // https://github.com/llvm/llvm-project/blob/50598f0ff44f3a4e75706f8c53f3380fe7faa896/clang/lib/Headers/cpuid.h#L177C30-L177C40
+    unsigned supports_gfni = (info7.named.ecx & 0x00000100) != 0;
+    // Check for AVX512VPOPCNTDQ (Function ID 7, ECX register)
+    unsigned supports_avx512vpopcntdq = (info7.named.ecx & 0x00004000) != 0;
+
+    // GFNI is only used in the AVX-512 kernels, so it needs the same OS support
+    supports_avx2 &= os_supports_avx;
+    supports_avx512f &= os_supports_avx512, supports_avx512vl &= os_supports_avx512;
+    supports_avx512bw &= os_supports_avx512, supports_avx512vbmi &= os_supports_avx512;
+    supports_gfni &= os_supports_avx512, supports_avx512vpopcntdq &= os_supports_avx512;
+
+    return (sz_capability_t)(                                       //
+        (sz_cap_x86_avx2_k * supports_avx2) |                       //
+        (sz_cap_x86_avx512f_k * supports_avx512f) |                 //
+        (sz_cap_x86_avx512vl_k * supports_avx512vl) |               //
+        (sz_cap_x86_avx512bw_k * supports_avx512bw) |               //
+        (sz_cap_x86_avx512vbmi_k * supports_avx512vbmi) |           //
+        (sz_cap_x86_gfni_k * (supports_gfni)) |                     //
+        (sz_cap_x86_avx512vpopcntdq_k * supports_avx512vpopcntdq) | //
+        (sz_cap_serial_k));
+
+#endif // SZ_USE_X86_AVX512 || SZ_USE_X86_AVX2
+
+#if SZ_USE_ARM_NEON || SZ_USE_ARM_SVE
+
+    // Every 64-bit Arm CPU supports NEON
+    unsigned supports_neon = 1;
+    unsigned supports_sve = 0;
+    unsigned supports_sve2 = 0;
+#if (SZ_USE_ARM_SVE || SZ_USE_ARM_SVE2) && defined(__linux__) && !SZ_AVOID_LIBC
+    // The kernel reports the optional extensions in the auxiliary vector, without trapping on `mrs` reads.
+    unsigned long hwcaps = getauxval(AT_HWCAP), hwcaps2 = getauxval(AT_HWCAP2);
+    supports_sve = (hwcaps & HWCAP_SVE) != 0;
+    supports_sve2 = supports_sve && (hwcaps2 & HWCAP2_SVE2) != 0;
+#endif
+
+    return (sz_capability_t)(                 //
+        (sz_cap_arm_neon_k * supports_neon) | //
+        (sz_cap_arm_sve_k * supports_sve) |   //
+        (sz_cap_arm_sve2_k * supports_sve2) | //
+        (sz_cap_serial_k));
+
+#endif // SZ_USE_ARM_NEON || SZ_USE_ARM_SVE
+
+    return sz_cap_serial_k;
+}
+
+#pragma endregion
+
+/*
+ *  @brief  Pick the right implementation for the string search algorithms.
+ */
+#pragma region Compile-Time Dispatching
+
+SZ_PUBLIC void sz_hashes_fingerprint(sz_cptr_t start, sz_size_t length, sz_size_t window_length, sz_ptr_t fingerprint,
+                                     sz_size_t fingerprint_bytes) {
 
     sz_bool_t fingerprint_length_is_power_of_two = (sz_bool_t)((fingerprint_bytes & (fingerprint_bytes - 1)) == 0);
     sz_string_view_t fingerprint_buffer = {fingerprint, fingerprint_bytes};
@@ -5009,80 +10371,329 @@ SZ_PUBLIC sz_size_t sz_hamming_distance_utf8( //
     sz_cptr_t b, sz_size_t b_length,          //
     sz_size_t bound) {
 
-    sz_cptr_t const a_end = a + a_length;
-    sz_cptr_t const b_end = b + b_length;
+    if (!bound) bound = SZ_SIZE_MAX;
     sz_size_t distance = 0;
 
-    sz_rune_t a_rune, b_rune;
-    sz_rune_length_t a_rune_length, b_rune_length;
-
-    if (bound) {
-        for (; a < a_end && b < b_end && distance < bound; a += a_rune_length, b += b_rune_length) {
-            _sz_extract_utf8_rune(a, &a_rune, &a_rune_length);
-            _sz_extract_utf8_rune(b, &b_rune, &b_rune_length);
-            distance += (a_rune != b_rune);
-        }
-        // If one string has more runes, we need to go through the tail.
-        if (distance < bound) {
-            for (; a < a_end && distance < bound; a += a_rune_length, ++distance)
-                _sz_extract_utf8_rune(a, &a_rune, &a_rune_length);
-
-            for (; b < b_end && distance < bound; b += b_rune_length, ++distance)
-                _sz_extract_utf8_rune(b, &b_rune, &b_rune_length);
-        }
-    }
-    else {
-        for (; a < a_end && b < b_end; a += a_rune_length, b += b_rune_length) {
-            _sz_extract_utf8_rune(a, &a_rune, &a_rune_length);
-            _sz_extract_utf8_rune(b, &b_rune, &b_rune_length);
-            distance += (a_rune != b_rune);
-        }
-        // If one string has more runes, we need to go through the tail.
-        for (; a < a_end; a += a_rune_length, ++distance) _sz_extract_utf8_rune(a, &a_rune, &a_rune_length);
-        for (; b < b_end; b += b_rune_length, ++distance) _sz_extract_utf8_rune(b, &b_rune, &b_rune_length);
+    // Decode both strings in small chunks on the stack, containing the same number of runes.
+    sz_rune_t a_runes[64], b_runes[64];
+    while (a_length && b_length && distance < bound) {
+        // Take up to 64 bytes from the first string, without splitting a rune in halves.
+        sz_size_t a_chunk_length = sz_min_of_two(a_length, 64);
+        while (a_chunk_length < a_length && a_chunk_length && (a[a_chunk_length] & 0xC0) == 0x80) --a_chunk_length;
+        if (!a_chunk_length) a_chunk_length = sz_min_of_two(a_length, 64); //< Only happens on corrupted inputs.
+        sz_size_t const a_count = sz_utf8_to_utf32(a, a_chunk_length, a_runes);
+
+        // Take just as many runes from the second string, or less, if it ends earlier.
+        sz_cptr_t const b_chunk_end = sz_utf8_find_nth(b, b_length, a_count);
+        sz_size_t const b_chunk_length = b_chunk_end ? (sz_size_t)(b_chunk_end - b) : b_length;
+        sz_size_t const b_count = sz_utf8_to_utf32(b, b_chunk_length, b_runes);
+
+        for (sz_size_t i = 0; i != b_count; ++i) distance += a_runes[i] != b_runes[i];
+        distance += a_count - b_count;
+        a += a_chunk_length, a_length -= a_chunk_length;
+        b += b_chunk_length, b_length -= b_chunk_length;
     }
-    return distance;
+
+    // If one string has more runes, they all count as mismatches.
+    if (distance < bound) distance += sz_utf8_count(a, a_length) + sz_utf8_count(b, b_length);
+    return sz_min_of_two(distance, bound);
 }
 
 SZ_PUBLIC sz_size_t sz_edit_distance_utf8( //
     sz_cptr_t a, sz_size_t a_length,       //
     sz_cptr_t b, sz_size_t b_length,       //
     sz_size_t bound, sz_memory_allocator_t *alloc) {
+    // Pure ASCII inputs can benefit from the affix trimming and the byte-level bit-parallel kernels.
+    if (sz_isascii(a, a_length) == sz_true_k && sz_isascii(b, b_length) == sz_true_k)
+        return sz_edit_distance_serial(a, a_length, b, b_length, bound, alloc);
     return _sz_edit_distance_wagner_fisher_serial(a, a_length, b, b_length, bound, sz_true_k, alloc);
 }
 
+/*
+ *  With `SZ_LAZY_DISPATCH`, the `SZ_USE_*` macros only control which backends are compiled, and the compile-time
+ *  dispatch is limited to the extensions the compiler may assume for the whole binary, like with `-march=haswell`.
+ */
+#if !SZ_LAZY_DISPATCH
+#define _SZ_STATIC_X86_AVX512 SZ_USE_X86_AVX512
+#define _SZ_STATIC_X86_AVX2 SZ_USE_X86_AVX2
+#define _SZ_STATIC_ARM_NEON SZ_USE_ARM_NEON
+#define _SZ_STATIC_ARM_SVE SZ_USE_ARM_SVE
+#define _SZ_STATIC_ARM_SVE2 SZ_USE_ARM_SVE2
+#else
+#if SZ_USE_X86_AVX512 && defined(__AVX512VL__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && \
+    defined(__AVX512VBMI__) && defined(__AVX512VPOPCNTDQ__) && defined(__GFNI__) && defined(__BMI2__)
+#define _SZ_STATIC_X86_AVX512 1
+#else
+#define _SZ_STATIC_X86_AVX512 0
+#endif
+#if SZ_USE_X86_AVX2 && defined(__AVX2__)
+#define _SZ_STATIC_X86_AVX2 1
+#else
+#define _SZ_STATIC_X86_AVX2 0
+#endif
+#if SZ_USE_ARM_NEON && defined(__ARM_NEON)
+#define _SZ_STATIC_ARM_NEON 1
+#else
+#define _SZ_STATIC_ARM_NEON 0
+#endif
+#if SZ_USE_ARM_SVE && defined(__ARM_FEATURE_SVE)
+#define _SZ_STATIC_ARM_SVE 1
+#else
+#define _SZ_STATIC_ARM_SVE 0
+#endif
+#if SZ_USE_ARM_SVE2 && defined(__ARM_FEATURE_SVE2)
+#define _SZ_STATIC_ARM_SVE2 1
+#else
+#define _SZ_STATIC_ARM_SVE2 0
+#endif
+#endif // SZ_LAZY_DISPATCH
+
 #if !SZ_DYNAMIC_DISPATCH
 
-SZ_DYNAMIC sz_bool_t sz_equal(sz_cptr_t a, sz_cptr_t b, sz_size_t length) {
+#if SZ_LAZY_DISPATCH
+
+/*
+ *  Every lazily dispatched function keeps its backend in a function-local static pointer, resolved on the first call.
+ *  Threads racing through the first call may all run the detection, but will store the same pointer.
+ *  In C++, every translation unit has its own copy of those pointers, as all the functions are `static`.
+ *  The preference order mirrors the `sz_dispatch_table_update` of the precompiled library.
+ */
+
+#define _sz_cap_x86_avx512_charset_k                                                                  \
+    (sz_cap_x86_avx512f_k | sz_cap_x86_avx512vl_k | sz_cap_x86_avx512bw_k | sz_cap_x86_avx512vbmi_k | \
+     sz_cap_x86_gfni_k)
+
+SZ_INTERNAL sz_equal_t _sz_equal_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_equal_t kernel = sz_equal_serial;
+#if SZ_USE_X86_AVX512
+    if (caps & sz_cap_x86_avx512f_k) kernel = sz_equal_avx512;
+#endif
+#if SZ_USE_ARM_SVE
+    if (caps & sz_cap_arm_sve_k) kernel = sz_equal_sve;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+SZ_INTERNAL sz_order_t _sz_order_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_order_t kernel = sz_order_serial;
+#if SZ_USE_X86_AVX512
+    if (caps & sz_cap_x86_avx512f_k) kernel = sz_order_avx512;
+#endif
+#if SZ_USE_ARM_SVE
+    if (caps & sz_cap_arm_sve_k) kernel = sz_order_sve;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+SZ_INTERNAL sz_find_byte_t _sz_find_byte_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_find_byte_t kernel = sz_find_byte_serial;
+#if SZ_USE_X86_AVX2
+    if (caps & sz_cap_x86_avx2_k) kernel = sz_find_byte_avx2;
+#endif
+#if SZ_USE_X86_AVX512
+    if (caps & sz_cap_x86_avx512f_k) kernel = sz_find_byte_avx512;
+#endif
+#if SZ_USE_ARM_NEON
+    if (caps & sz_cap_arm_neon_k) kernel = sz_find_byte_neon;
+#endif
+#if SZ_USE_ARM_SVE
+    if (caps & sz_cap_arm_sve_k) kernel = sz_find_byte_sve;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+SZ_INTERNAL sz_find_byte_t _sz_rfind_byte_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_find_byte_t kernel = sz_rfind_byte_serial;
+#if SZ_USE_X86_AVX2
+    if (caps & sz_cap_x86_avx2_k) kernel = sz_rfind_byte_avx2;
+#endif
+#if SZ_USE_X86_AVX512
+    if (caps & sz_cap_x86_avx512f_k) kernel = sz_rfind_byte_avx512;
+#endif
+#if SZ_USE_ARM_NEON
+    if (caps & sz_cap_arm_neon_k) kernel = sz_rfind_byte_neon;
+#endif
+#if SZ_USE_ARM_SVE
+    if (caps & sz_cap_arm_sve_k) kernel = sz_rfind_byte_sve;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+SZ_INTERNAL sz_find_t _sz_find_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_find_t kernel = sz_find_serial;
+#if SZ_USE_X86_AVX2
+    if (caps & sz_cap_x86_avx2_k) kernel = sz_find_avx2;
+#endif
+#if SZ_USE_X86_AVX512
+    if (caps & sz_cap_x86_avx512f_k) kernel = sz_find_avx512;
+#endif
+#if SZ_USE_ARM_NEON
+    if (caps & sz_cap_arm_neon_k) kernel = sz_find_neon;
+#endif
+#if SZ_USE_ARM_SVE
+    if (caps & sz_cap_arm_sve_k) kernel = sz_find_sve;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+SZ_INTERNAL sz_find_t _sz_rfind_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_find_t kernel = sz_rfind_serial;
+#if SZ_USE_X86_AVX2
+    if (caps & sz_cap_x86_avx2_k) kernel = sz_rfind_avx2;
+#endif
+#if SZ_USE_X86_AVX512
+    if (caps & sz_cap_x86_avx512f_k) kernel = sz_rfind_avx512;
+#endif
+#if SZ_USE_ARM_NEON
+    if (caps & sz_cap_arm_neon_k) kernel = sz_rfind_neon;
+#endif
+#if SZ_USE_ARM_SVE
+    if (caps & sz_cap_arm_sve_k) kernel = sz_rfind_sve;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+SZ_INTERNAL sz_find_prepared_t _sz_find_prepared_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_find_prepared_t kernel = sz_find_prepared_serial;
+#if SZ_USE_X86_AVX2
+    if (caps & sz_cap_x86_avx2_k) kernel = sz_find_prepared_avx2;
+#endif
+#if SZ_USE_X86_AVX512
+    if (caps & sz_cap_x86_avx512f_k) kernel = sz_find_prepared_avx512;
+#endif
+#if SZ_USE_ARM_NEON
+    if (caps & sz_cap_arm_neon_k) kernel = sz_find_prepared_neon;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+SZ_INTERNAL sz_find_set_t _sz_find_charset_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_find_set_t kernel = sz_find_charset_serial;
 #if SZ_USE_X86_AVX512
+    if ((caps & _sz_cap_x86_avx512_charset_k) == _sz_cap_x86_avx512_charset_k) kernel = sz_find_charset_avx512;
+#endif
+#if SZ_USE_ARM_NEON
+    if (caps & sz_cap_arm_neon_k) kernel = sz_find_charset_neon;
+#endif
+#if SZ_USE_ARM_SVE2
+    if (caps & sz_cap_arm_sve2_k) kernel = sz_find_charset_sve2;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+SZ_INTERNAL sz_find_set_t _sz_rfind_charset_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_find_set_t kernel = sz_rfind_charset_serial;
+#if SZ_USE_X86_AVX512
+    if ((caps & _sz_cap_x86_avx512_charset_k) == _sz_cap_x86_avx512_charset_k) kernel = sz_rfind_charset_avx512;
+#endif
+#if SZ_USE_ARM_NEON
+    if (caps & sz_cap_arm_neon_k) kernel = sz_rfind_charset_neon;
+#endif
+#if SZ_USE_ARM_SVE2
+    if (caps & sz_cap_arm_sve2_k) kernel = sz_rfind_charset_sve2;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+SZ_INTERNAL sz_edit_distance_t _sz_edit_distance_pick(void) {
+    sz_capability_t caps = _sz_capabilities_detect();
+    sz_edit_distance_t kernel = sz_edit_distance_serial;
+#if SZ_USE_X86_AVX512
+    if (caps & sz_cap_x86_avx512f_k) kernel = sz_edit_distance_avx512;
+#endif
+    sz_unused(caps);
+    return kernel;
+}
+
+#endif // SZ_LAZY_DISPATCH
+
+SZ_DYNAMIC sz_capability_t sz_capabilities(void) { return _sz_capabilities_detect(); }
+
+SZ_DYNAMIC sz_u64_t sz_hash(sz_cptr_t text, sz_size_t length) { return sz_hash_serial(text, length); }
+
+SZ_DYNAMIC sz_bool_t sz_edit_distances_batch(sz_cptr_t query, sz_size_t query_length, sz_sequence_t const *candidates,
+                                             sz_size_t bound, sz_size_t *distances, sz_memory_allocator_t *alloc) {
+#if _SZ_STATIC_X86_AVX512
+    return sz_edit_distances_batch_avx512(query, query_length, candidates, bound, distances, alloc);
+#else
+    return sz_edit_distances_batch_serial(query, query_length, candidates, bound, distances, alloc);
+#endif
+}
+
+SZ_DYNAMIC void sz_hash_batch(sz_sequence_t const *sequence, sz_u64_t *hashes) {
+#if _SZ_STATIC_X86_AVX512
+    sz_hash_batch_avx512(sequence, hashes);
+#elif _SZ_STATIC_X86_AVX2
+    sz_hash_batch_avx2(sequence, hashes);
+#elif _SZ_STATIC_ARM_NEON
+    sz_hash_batch_neon(sequence, hashes);
+#else
+    sz_hash_batch_serial(sequence, hashes);
+#endif
+}
+
+SZ_DYNAMIC sz_bool_t sz_equal(sz_cptr_t a, sz_cptr_t b, sz_size_t length) {
+#if SZ_LAZY_DISPATCH
+    static sz_equal_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_equal_pick();
+    return kernel(a, b, length);
+#elif _SZ_STATIC_X86_AVX512
     return sz_equal_avx512(a, b, length);
+#elif _SZ_STATIC_ARM_SVE
+    return sz_equal_sve(a, b, length);
 #else
     return sz_equal_serial(a, b, length);
 #endif
 }
 
 SZ_DYNAMIC sz_ordering_t sz_order(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length) {
-#if SZ_USE_X86_AVX512
+#if SZ_LAZY_DISPATCH
+    static sz_order_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_order_pick();
+    return kernel(a, a_length, b, b_length);
+#elif _SZ_STATIC_X86_AVX512
     return sz_order_avx512(a, a_length, b, b_length);
+#elif _SZ_STATIC_ARM_SVE
+    return sz_order_sve(a, a_length, b, b_length);
 #else
     return sz_order_serial(a, a_length, b, b_length);
 #endif
 }
 
 SZ_DYNAMIC void sz_copy(sz_ptr_t target, sz_cptr_t source, sz_size_t length) {
-#if SZ_USE_X86_AVX512
+#if _SZ_STATIC_X86_AVX512
     sz_copy_avx512(target, source, length);
-#elif SZ_USE_X86_AVX2
+#elif _SZ_STATIC_X86_AVX2
     sz_copy_avx2(target, source, length);
+#elif _SZ_STATIC_ARM_SVE
+    sz_copy_sve(target, source, length);
 #else
     sz_copy_serial(target, source, length);
 #endif
 }
 
 SZ_DYNAMIC void sz_move(sz_ptr_t target, sz_cptr_t source, sz_size_t length) {
-#if SZ_USE_X86_AVX512
+#if _SZ_STATIC_X86_AVX512
     sz_move_avx512(target, source, length);
-#elif SZ_USE_X86_AVX2
+#elif _SZ_STATIC_X86_AVX2
     sz_move_avx2(target, source, length);
 #else
     sz_move_serial(target, source, length);
@@ -5090,21 +10701,29 @@ SZ_DYNAMIC void sz_move(sz_ptr_t target, sz_cptr_t source, sz_size_t length) {
 }
 
 SZ_DYNAMIC void sz_fill(sz_ptr_t target, sz_size_t length, sz_u8_t value) {
-#if SZ_USE_X86_AVX512
+#if _SZ_STATIC_X86_AVX512
     sz_fill_avx512(target, length, value);
-#elif SZ_USE_X86_AVX2
+#elif _SZ_STATIC_X86_AVX2
     sz_fill_avx2(target, length, value);
+#elif _SZ_STATIC_ARM_SVE
+    sz_fill_sve(target, length, value);
 #else
     sz_fill_serial(target, length, value);
 #endif
 }
 
 SZ_DYNAMIC sz_cptr_t sz_find_byte(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle) {
-#if SZ_USE_X86_AVX512
+#if SZ_LAZY_DISPATCH
+    static sz_find_byte_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_find_byte_pick();
+    return kernel(haystack, h_length, needle);
+#elif _SZ_STATIC_X86_AVX512
     return sz_find_byte_avx512(haystack, h_length, needle);
-#elif SZ_USE_X86_AVX2
+#elif _SZ_STATIC_X86_AVX2
     return sz_find_byte_avx2(haystack, h_length, needle);
-#elif SZ_USE_ARM_NEON
+#elif _SZ_STATIC_ARM_SVE
+    return sz_find_byte_sve(haystack, h_length, needle);
+#elif _SZ_STATIC_ARM_NEON
     return sz_find_byte_neon(haystack, h_length, needle);
 #else
     return sz_find_byte_serial(haystack, h_length, needle);
@@ -5112,11 +10731,17 @@ SZ_DYNAMIC sz_cptr_t sz_find_byte(sz_cptr_t haystack, sz_size_t h_length, sz_cpt
 }
 
 SZ_DYNAMIC sz_cptr_t sz_rfind_byte(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle) {
-#if SZ_USE_X86_AVX512
+#if SZ_LAZY_DISPATCH
+    static sz_find_byte_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_rfind_byte_pick();
+    return kernel(haystack, h_length, needle);
+#elif _SZ_STATIC_X86_AVX512
     return sz_rfind_byte_avx512(haystack, h_length, needle);
-#elif SZ_USE_X86_AVX2
+#elif _SZ_STATIC_X86_AVX2
     return sz_rfind_byte_avx2(haystack, h_length, needle);
-#elif SZ_USE_ARM_NEON
+#elif _SZ_STATIC_ARM_SVE
+    return sz_rfind_byte_sve(haystack, h_length, needle);
+#elif _SZ_STATIC_ARM_NEON
     return sz_rfind_byte_neon(haystack, h_length, needle);
 #else
     return sz_rfind_byte_serial(haystack, h_length, needle);
@@ -5124,33 +10749,180 @@ SZ_DYNAMIC sz_cptr_t sz_rfind_byte(sz_cptr_t haystack, sz_size_t h_length, sz_cp
 }
 
 SZ_DYNAMIC sz_cptr_t sz_find(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length) {
-#if SZ_USE_X86_AVX512
+#if SZ_LAZY_DISPATCH
+    static sz_find_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_find_pick();
+    return kernel(haystack, h_length, needle, n_length);
+#elif _SZ_STATIC_X86_AVX512
     return sz_find_avx512(haystack, h_length, needle, n_length);
-#elif SZ_USE_X86_AVX2
+#elif _SZ_STATIC_X86_AVX2
     return sz_find_avx2(haystack, h_length, needle, n_length);
-#elif SZ_USE_ARM_NEON
+#elif _SZ_STATIC_ARM_SVE
+    return sz_find_sve(haystack, h_length, needle, n_length);
+#elif _SZ_STATIC_ARM_NEON
     return sz_find_neon(haystack, h_length, needle, n_length);
 #else
     return sz_find_serial(haystack, h_length, needle, n_length);
 #endif
 }
 
+SZ_DYNAMIC sz_cptr_t sz_find_prepared(sz_needle_t const *needle, sz_cptr_t haystack, sz_size_t h_length) {
+#if SZ_LAZY_DISPATCH
+    static sz_find_prepared_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_find_prepared_pick();
+    return kernel(needle, haystack, h_length);
+#elif _SZ_STATIC_X86_AVX512
+    return sz_find_prepared_avx512(needle, haystack, h_length);
+#elif _SZ_STATIC_X86_AVX2
+    return sz_find_prepared_avx2(needle, haystack, h_length);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_find_prepared_neon(needle, haystack, h_length);
+#else
+    return sz_find_prepared_serial(needle, haystack, h_length);
+#endif
+}
+
 SZ_DYNAMIC sz_cptr_t sz_rfind(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length) {
-#if SZ_USE_X86_AVX512
+#if SZ_LAZY_DISPATCH
+    static sz_find_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_rfind_pick();
+    return kernel(haystack, h_length, needle, n_length);
+#elif _SZ_STATIC_X86_AVX512
     return sz_rfind_avx512(haystack, h_length, needle, n_length);
-#elif SZ_USE_X86_AVX2
+#elif _SZ_STATIC_X86_AVX2
     return sz_rfind_avx2(haystack, h_length, needle, n_length);
-#elif SZ_USE_ARM_NEON
+#elif _SZ_STATIC_ARM_SVE
+    return sz_rfind_sve(haystack, h_length, needle, n_length);
+#elif _SZ_STATIC_ARM_NEON
     return sz_rfind_neon(haystack, h_length, needle, n_length);
 #else
     return sz_rfind_serial(haystack, h_length, needle, n_length);
 #endif
 }
 
+SZ_DYNAMIC sz_cptr_t sz_find_case_insensitive(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle,
+                                              sz_size_t n_length) {
+#if _SZ_STATIC_X86_AVX512
+    return sz_find_case_insensitive_avx512(haystack, h_length, needle, n_length);
+#elif _SZ_STATIC_X86_AVX2
+    return sz_find_case_insensitive_avx2(haystack, h_length, needle, n_length);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_find_case_insensitive_neon(haystack, h_length, needle, n_length);
+#else
+    return sz_find_case_insensitive_serial(haystack, h_length, needle, n_length);
+#endif
+}
+
+SZ_DYNAMIC void sz_tolower(sz_cptr_t ins, sz_size_t length, sz_ptr_t outs) {
+#if _SZ_STATIC_X86_AVX512
+    sz_tolower_avx512(ins, length, outs);
+#elif _SZ_STATIC_X86_AVX2
+    sz_tolower_avx2(ins, length, outs);
+#elif _SZ_STATIC_ARM_NEON
+    sz_tolower_neon(ins, length, outs);
+#else
+    sz_tolower_serial(ins, length, outs);
+#endif
+}
+
+SZ_DYNAMIC void sz_toupper(sz_cptr_t ins, sz_size_t length, sz_ptr_t outs) {
+#if _SZ_STATIC_X86_AVX512
+    sz_toupper_avx512(ins, length, outs);
+#elif _SZ_STATIC_X86_AVX2
+    sz_toupper_avx2(ins, length, outs);
+#elif _SZ_STATIC_ARM_NEON
+    sz_toupper_neon(ins, length, outs);
+#else
+    sz_toupper_serial(ins, length, outs);
+#endif
+}
+
+SZ_DYNAMIC void sz_toascii(sz_cptr_t ins, sz_size_t length, sz_ptr_t outs) {
+#if _SZ_STATIC_X86_AVX512
+    sz_toascii_avx512(ins, length, outs);
+#elif _SZ_STATIC_X86_AVX2
+    sz_toascii_avx2(ins, length, outs);
+#elif _SZ_STATIC_ARM_NEON
+    sz_toascii_neon(ins, length, outs);
+#else
+    sz_toascii_serial(ins, length, outs);
+#endif
+}
+
+SZ_DYNAMIC void sz_translate(sz_cptr_t ins, sz_size_t length, sz_cptr_t lut, sz_ptr_t outs) {
+#if _SZ_STATIC_X86_AVX512 && defined(__AVX512VBMI__)
+    sz_translate_avx512(ins, length, lut, outs);
+#elif _SZ_STATIC_X86_AVX2
+    sz_translate_avx2(ins, length, lut, outs);
+#elif _SZ_STATIC_ARM_NEON
+    sz_translate_neon(ins, length, lut, outs);
+#else
+    sz_translate_serial(ins, length, lut, outs);
+#endif
+}
+
+SZ_DYNAMIC sz_bool_t sz_isascii(sz_cptr_t ins, sz_size_t length) {
+#if _SZ_STATIC_X86_AVX512
+    return sz_isascii_avx512(ins, length);
+#elif _SZ_STATIC_X86_AVX2
+    return sz_isascii_avx2(ins, length);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_isascii_neon(ins, length);
+#else
+    return sz_isascii_serial(ins, length);
+#endif
+}
+
+SZ_DYNAMIC sz_bool_t sz_utf8_valid(sz_cptr_t text, sz_size_t length) {
+#if _SZ_STATIC_X86_AVX512
+    return sz_utf8_valid_avx512(text, length);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_utf8_valid_neon(text, length);
+#else
+    return sz_utf8_valid_serial(text, length);
+#endif
+}
+
+SZ_DYNAMIC sz_size_t sz_utf8_count(sz_cptr_t text, sz_size_t length) {
+#if _SZ_STATIC_X86_AVX512
+    return sz_utf8_count_avx512(text, length);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_utf8_count_neon(text, length);
+#else
+    return sz_utf8_count_serial(text, length);
+#endif
+}
+
+SZ_DYNAMIC sz_cptr_t sz_utf8_find_nth(sz_cptr_t text, sz_size_t length, sz_size_t n) {
+#if _SZ_STATIC_X86_AVX512
+    return sz_utf8_find_nth_avx512(text, length, n);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_utf8_find_nth_neon(text, length, n);
+#else
+    return sz_utf8_find_nth_serial(text, length, n);
+#endif
+}
+
+SZ_DYNAMIC sz_size_t sz_utf8_to_utf32(sz_cptr_t text, sz_size_t length, sz_rune_t *runes) {
+#if _SZ_STATIC_X86_AVX512
+    return sz_utf8_to_utf32_avx512(text, length, runes);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_utf8_to_utf32_neon(text, length, runes);
+#else
+    return sz_utf8_to_utf32_serial(text, length, runes);
+#endif
+}
+
 SZ_DYNAMIC sz_cptr_t sz_find_charset(sz_cptr_t text, sz_size_t length, sz_charset_t const *set) {
-#if SZ_USE_X86_AVX512
+#if SZ_LAZY_DISPATCH
+    static sz_find_set_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_find_charset_pick();
+    return kernel(text, length, set);
+#elif _SZ_STATIC_X86_AVX512
     return sz_find_charset_avx512(text, length, set);
-#elif SZ_USE_ARM_NEON
+#elif _SZ_STATIC_ARM_SVE2
+    return sz_find_charset_sve2(text, length, set);
+#elif _SZ_STATIC_ARM_NEON
     return sz_find_charset_neon(text, length, set);
 #else
     return sz_find_charset_serial(text, length, set);
@@ -5158,31 +10930,80 @@ SZ_DYNAMIC sz_cptr_t sz_find_charset(sz_cptr_t text, sz_size_t length, sz_charse
 }
 
 SZ_DYNAMIC sz_cptr_t sz_rfind_charset(sz_cptr_t text, sz_size_t length, sz_charset_t const *set) {
-#if SZ_USE_X86_AVX512
+#if SZ_LAZY_DISPATCH
+    static sz_find_set_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_rfind_charset_pick();
+    return kernel(text, length, set);
+#elif _SZ_STATIC_X86_AVX512
     return sz_rfind_charset_avx512(text, length, set);
-#elif SZ_USE_ARM_NEON
+#elif _SZ_STATIC_ARM_SVE2
+    return sz_rfind_charset_sve2(text, length, set);
+#elif _SZ_STATIC_ARM_NEON
     return sz_rfind_charset_neon(text, length, set);
 #else
     return sz_rfind_charset_serial(text, length, set);
 #endif
 }
 
+SZ_DYNAMIC sz_size_t sz_split_offsets(sz_cptr_t text, sz_size_t length, sz_charset_t const *delimiters,
+                                      sz_size_t base, void *offsets, sz_size_t offset_bytes, sz_size_t capacity,
+                                      sz_size_t *consumed) {
+#if _SZ_STATIC_X86_AVX512 && defined(__AVX512VBMI__)
+    return sz_split_offsets_avx512(text, length, delimiters, base, offsets, offset_bytes, capacity, consumed);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_split_offsets_neon(text, length, delimiters, base, offsets, offset_bytes, capacity, consumed);
+#else
+    return sz_split_offsets_serial(text, length, delimiters, base, offsets, offset_bytes, capacity, consumed);
+#endif
+}
+
+SZ_DYNAMIC sz_cptr_t sz_find_any(sz_multi_pattern_t const *pattern, sz_cptr_t haystack, sz_size_t h_length,
+                                 sz_size_t *needle_id) {
+#if _SZ_STATIC_X86_AVX512
+    return sz_find_any_avx512(pattern, haystack, h_length, needle_id);
+#elif _SZ_STATIC_X86_AVX2
+    return sz_find_any_avx2(pattern, haystack, h_length, needle_id);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_find_any_neon(pattern, haystack, h_length, needle_id);
+#else
+    return sz_find_any_serial(pattern, haystack, h_length, needle_id);
+#endif
+}
+
 SZ_DYNAMIC sz_size_t sz_edit_distance( //
     sz_cptr_t a, sz_size_t a_length,   //
     sz_cptr_t b, sz_size_t b_length,   //
     sz_size_t bound, sz_memory_allocator_t *alloc) {
-#if SZ_USE_X86_AVX512
+#if SZ_LAZY_DISPATCH
+    static sz_edit_distance_t kernel = SZ_NULL;
+    if (!kernel) kernel = _sz_edit_distance_pick();
+    return kernel(a, a_length, b, b_length, bound, alloc);
+#elif _SZ_STATIC_X86_AVX512
     return sz_edit_distance_avx512(a, a_length, b, b_length, bound, alloc);
 #else
     return sz_edit_distance_serial(a, a_length, b, b_length, bound, alloc);
 #endif
 }
 
+SZ_DYNAMIC sz_cptr_t sz_find_fuzzy(sz_cptr_t haystack, sz_size_t h_length, sz_cptr_t needle, sz_size_t n_length, //
+                                   sz_size_t max_edits, sz_memory_allocator_t *alloc, sz_size_t *match_length) {
+#if _SZ_STATIC_X86_AVX512
+    return sz_find_fuzzy_avx512(haystack, h_length, needle, n_length, max_edits, alloc, match_length);
+#else
+    return sz_find_fuzzy_serial(haystack, h_length, needle, n_length, max_edits, alloc, match_length);
+#endif
+}
+
 SZ_DYNAMIC sz_ssize_t sz_alignment_score(sz_cptr_t a, sz_size_t a_length, sz_cptr_t b, sz_size_t b_length,
                                          sz_error_cost_t const *subs, sz_error_cost_t gap,
                                          sz_memory_allocator_t *alloc) {
-#if SZ_USE_X86_AVX512
+    // The anti-diagonal AVX2 kernel outperforms the horizontal AVX-512 one, bottlenecked by prefix maximums.
+#if _SZ_STATIC_X86_AVX2
+    return sz_alignment_score_avx2(a, a_length, b, b_length, subs, gap, alloc);
+#elif _SZ_STATIC_X86_AVX512
     return sz_alignment_score_avx512(a, a_length, b, b_length, subs, gap, alloc);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_alignment_score_neon(a, a_length, b, b_length, subs, gap, alloc);
 #else
     return sz_alignment_score_serial(a, a_length, b, b_length, subs, gap, alloc);
 #endif
@@ -5190,15 +11011,40 @@ SZ_DYNAMIC sz_ssize_t sz_alignment_score(sz_cptr_t a, sz_size_t a_length, sz_cpt
 
 SZ_DYNAMIC void sz_hashes(sz_cptr_t text, sz_size_t length, sz_size_t window_length, sz_size_t window_step, //
                           sz_hash_callback_t callback, void *callback_handle) {
-#if SZ_USE_X86_AVX512
+#if _SZ_STATIC_X86_AVX512
     sz_hashes_avx512(text, length, window_length, window_step, callback, callback_handle);
-#elif SZ_USE_X86_AVX2
+#elif _SZ_STATIC_X86_AVX2
     sz_hashes_avx2(text, length, window_length, window_step, callback, callback_handle);
+#elif _SZ_STATIC_ARM_SVE
+    sz_hashes_sve(text, length, window_length, window_step, callback, callback_handle);
 #else
     sz_hashes_serial(text, length, window_length, window_step, callback, callback_handle);
 #endif
 }
 
+SZ_DYNAMIC void sz_hashes_sketch(sz_cptr_t text, sz_size_t length, sz_size_t const *window_lengths,
+                                 sz_size_t windows_count, sz_size_t permutations_count, sz_u64_t *min_hashes,
+                                 sz_u64_t *sim_hashes) {
+#if _SZ_STATIC_X86_AVX512
+    sz_hashes_sketch_avx512(text, length, window_lengths, windows_count, permutations_count, min_hashes, sim_hashes);
+#else
+    sz_hashes_sketch_serial(text, length, window_lengths, windows_count, permutations_count, min_hashes, sim_hashes);
+#endif
+}
+
+SZ_DYNAMIC sz_size_t sz_fingerprints_top_k(sz_cptr_t query, sz_cptr_t fingerprints, sz_size_t fingerprint_bytes,
+                                           sz_sorted_idx_t const *ids, sz_size_t count, sz_size_t k,
+                                           sz_fingerprint_metric_t metric, sz_fingerprint_match_t *matches) {
+    // Unlike the rest of the AVX-512 kernels, this one needs VPOPCNTDQ, missing on Skylake-X and Cascade Lake.
+#if _SZ_STATIC_X86_AVX512 && defined(__AVX512VPOPCNTDQ__)
+    return sz_fingerprints_top_k_avx512(query, fingerprints, fingerprint_bytes, ids, count, k, metric, matches);
+#elif _SZ_STATIC_ARM_NEON
+    return sz_fingerprints_top_k_neon(query, fingerprints, fingerprint_bytes, ids, count, k, metric, matches);
+#else
+    return sz_fingerprints_top_k_serial(query, fingerprints, fingerprint_bytes, ids, count, k, metric, matches);
+#endif
+}
+
 SZ_DYNAMIC sz_cptr_t sz_find_char_from(sz_cptr_t h, sz_size_t h_length, sz_cptr_t n, sz_size_t n_length) {
     sz_charset_t set;
     sz_charset_init(&set);
@@ -44,9 +44,21 @@
 #define sz_constexpr_if_cpp20
 #endif
 
+/**
+ *  @brief  When set to 1, the library will not include the OS headers needed for `mapped_file`,
+ *          like `<windows.h>` or `<sys/mman.h>`, and won't define the `mapped_file` class.
+ */
+#ifndef SZ_AVOID_MMAP
+#define SZ_AVOID_MMAP (0) // true or false
+#endif
+
 #if !SZ_AVOID_STL
-#include <bitset>
-#include <string>
+#include <algorithm> // `std::sort`, `std::lower_bound`
+#include <array>     // `std::array`
+#include <bitset>    // `std::bitset`
+#include <memory>    // `std::allocator`
+#include <string>    // `std::string`, `std::to_string`
+#include <vector>    // `std::vector`
 #if SZ_DETECT_CPP_17 && __cpp_lib_string_view
 #include <string_view>
 #endif
@@ -54,10 +66,27 @@
 
 #include <cassert>   // `assert`
 #include <cstddef>   // `std::size_t`
+#include <cstdio>    // `std::fopen`, `std::fwrite`
+#include <cstring>   // `std::memcpy`, `std::memcmp`
 #include <iosfwd>    // `std::basic_ostream`
+#include <new>       // `std::bad_alloc`, placement `new`
 #include <stdexcept> // `std::out_of_range`
 #include <utility>   // `std::swap`
 
+#if !SZ_AVOID_MMAP
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h> // `CreateFileMapping`, `MapViewOfFile`, `PrefetchVirtualMemory`
+#else
+#include <fcntl.h>    // `open`
+#include <sys/mman.h> // `mmap`, `madvise`
+#include <sys/stat.h> // `fstat`
+#include <unistd.h>   // `close`
+#endif
+#endif
+
 #include <stringzilla/stringzilla.h>
 
 namespace ashvardanian {
@@ -252,6 +281,7 @@ class basic_charset {
         }
     }
 
+#if !SZ_AVOID_STL
     template <std::size_t count_characters>
     explicit basic_charset(std::array<char_type, count_characters> const &chars) noexcept : basic_charset() {
         static_assert(count_characters > 0, "Character array cannot be empty");
@@ -260,6 +290,7 @@ class basic_charset {
             bitset_._u64s[sz_bitcast(sz_u8_t, c) >> 6] |= (1ull << (sz_bitcast(sz_u8_t, c) & 63u));
         }
     }
+#endif
 
     basic_charset(basic_charset const &other) noexcept : bitset_(other.bitset_) {}
     basic_charset &operator=(basic_charset const &other) noexcept {
@@ -334,6 +365,33 @@ struct matcher_find {
     }
 };
 
+/**
+ *  @brief  Specialization for StringZilla views, that prepares the needle once with `sz_needle_prepare`,
+ *          as the `range_matches` and `range_splits` iterators search for it over and over again.
+ *          The view doesn't own the needle, so the prepared state remains valid in the copies.
+ */
+template <typename char_type_, typename overlaps_type>
+struct matcher_find<basic_string_slice<char_type_>, overlaps_type> {
+    using string_type_ = basic_string_slice<char_type_>;
+    using size_type = typename string_type_::size_type;
+    string_type_ needle_;
+    sz_needle_t prepared_;
+
+    matcher_find(string_type_ needle = {}) noexcept : needle_(needle) {
+        sz_needle_prepare(needle_.data(), needle_.size(), &prepared_);
+    }
+    size_type needle_length() const noexcept { return needle_.length(); }
+    size_type operator()(string_type_ haystack) const noexcept {
+        if (needle_.empty()) return 0; // Empty needles match everywhere, unlike in `sz_find_prepared`.
+        sz_cptr_t match = sz_find_prepared(&prepared_, haystack.data(), haystack.size());
+        return match ? static_cast<size_type>(match - haystack.data()) : string_type_::npos;
+    }
+    size_type skip_length() const noexcept {
+        // TODO: Apply Galil rule to match repetitive patterns in strictly linear time.
+        return std::is_same<overlaps_type, include_overlaps_type>() ? 1 : needle_.length();
+    }
+};
+
 /**
  *  @brief  Zero-cost wrapper around the `.rfind` member function of string-like classes.
  */
@@ -399,6 +457,32 @@ struct matcher_find_last_not_of {
     size_type operator()(haystack_type haystack) const noexcept { return haystack.find_last_not_of(needles_); }
 };
 
+/**
+ *  @brief  Wrapper around the approximate `sz_find_fuzzy` search of StringZilla views. Unlike other matchers,
+ *          every match may have a different length, so it's remembered after each search. The matches never
+ *          overlap, and if the temporary memory can't be allocated, no more matches are reported.
+ */
+template <typename string_type_>
+struct matcher_find_fuzzy {
+    using size_type = typename string_type_::size_type;
+    string_type_ needle_;
+    size_type max_edits_;
+    mutable size_type match_length_;
+
+    matcher_find_fuzzy(string_type_ needle = {}, size_type max_edits = 0) noexcept
+        : needle_(needle), max_edits_(max_edits), match_length_(0) {}
+    size_type needle_length() const noexcept { return match_length_; }
+    size_type skip_length() const noexcept { return match_length_ ? match_length_ : 1; }
+    size_type operator()(string_type_ haystack) const noexcept {
+        sz_size_t match_length;
+        sz_cptr_t match = sz_find_fuzzy(haystack.data(), haystack.size(), needle_.data(), needle_.size(), max_edits_,
+                                        nullptr, &match_length);
+        if (!match) return string_type_::npos;
+        match_length_ = static_cast<size_type>(match_length);
+        return static_cast<size_type>(match - haystack.data());
+    }
+};
+
 /**
  *  @brief  A range of string slices representing the matches of a substring search.
  *          Compatible with C++23 ranges, C++11 string views, and of course, StringZilla.
@@ -938,6 +1022,236 @@ std::size_t range_length(iterator_type first, iterator_type last) {
 
 #pragma endregion
 
+#pragma region Compile-Time Needles
+
+/**
+ *  @brief  Substring needle known at compile time, like the `"\r\n\r\n"` or `"HTTP/1.1"` protocol tokens.
+ *          Unlike `sz_find`, that dispatches on the needle length and locates the anomalous needle bytes in
+ *          every call, the kernel is picked at compile time, and the anomaly offsets are computed by the compiler.
+ *          Single-byte needles are forwarded to `sz_find_byte`.
+ *
+ *  When a SIMD backend is compiled in, the prepared needle is a `constexpr` constant, so once the kernel is
+ *  inlined, the needle bytes and offsets turn into immediates. Serial builds use a SWAR loop, that probes the
+ *  first and the last byte of the needle at 8 offsets at a time, and verifies the candidates with a single
+ *  64-bit comparison for needles of up to 8 bytes. With runtime dispatch, the needle is prepared once.
+ *
+ *  @tparam chars_  The bytes of the needle. In C++ 20, prefer the `static_needle<"...">` alias.
+ *  @see    find, find_all, split
+ */
+template <char... chars_>
+struct basic_static_needle {
+    using size_type = std::size_t;
+    static constexpr size_type npos = SZ_SIZE_MAX;
+    static constexpr size_type length_k = sizeof...(chars_);
+    static constexpr char chars_k[sizeof...(chars_) + 1] = {chars_..., '\0'};
+
+    static constexpr char const *data() noexcept { return chars_k; }
+    static constexpr size_type size() noexcept { return length_k; }
+    static constexpr size_type length() noexcept { return length_k; }
+
+    /**
+     *  @brief  Locates the first occurrence of the needle in the @p haystack.
+     *  @return The offset of the match, or ::npos, if there is none. Empty needles match at zero offset.
+     */
+    static size_type find(sz_cptr_t haystack, size_type haystack_length) noexcept {
+        return find_(haystack, haystack_length, std::integral_constant<int, (length_k > 1 ? 2 : (int)length_k)>());
+    }
+
+  private:
+    static constexpr sz_u8_t byte_(size_type i) noexcept { return static_cast<sz_u8_t>(chars_k[i]); }
+    static constexpr sz_u64_t prefix_word_(size_type i = 0) noexcept {
+        return i == (length_k < 8 ? length_k : 8) ? 0ull : (sz_u64_t)byte_(i) << (i * 8) | prefix_word_(i + 1);
+    }
+    static size_type offset_(sz_cptr_t haystack, sz_cptr_t match) noexcept {
+        return match ? static_cast<size_type>(match - haystack) : npos;
+    }
+
+    static size_type find_(sz_cptr_t, size_type, std::integral_constant<int, 0>) noexcept { return 0; }
+    static size_type find_(sz_cptr_t h, size_type h_length, std::integral_constant<int, 1>) noexcept {
+        return offset_(h, sz_find_byte(h, h_length, chars_k));
+    }
+    static size_type find_(sz_cptr_t h, size_type h_length, std::integral_constant<int, 2>) noexcept {
+        if (h_length < length_k) return npos;
+#if SZ_DYNAMIC_DISPATCH || SZ_LAZY_DISPATCH
+        // The skip table of the serial backend can't be built in C++ 11 `constexpr` code, so prepare it once.
+        static sz_needle_t const prepared = prepare_();
+        return offset_(h, sz_find_prepared(&prepared, h, h_length));
+#elif _SZ_STATIC_X86_AVX512
+        // The SIMD kernels don't use the skip table, so the whole state is known at compile time.
+        // They are called directly, so that the zeroed skip table can never reach the serial Horspool.
+        return offset_(h, sz_find_prepared_avx512(&prepared_k, h, h_length));
+#elif _SZ_STATIC_X86_AVX2
+        return offset_(h, sz_find_prepared_avx2(&prepared_k, h, h_length));
+#elif _SZ_STATIC_ARM_NEON
+        return offset_(h, sz_find_prepared_neon(&prepared_k, h, h_length));
+#elif SZ_DETECT_BIG_ENDIAN
+        return offset_(h, sz_find(h, h_length, chars_k, length_k));
+#else
+        constexpr sz_u64_t ones_vec = 0x0101010101010101ull, tops_vec = 0x8080808080808080ull;
+        constexpr sz_u64_t first_vec = ones_vec * byte_(0), last_vec = ones_vec * byte_(length_k - 1);
+        size_type offset = 0;
+        for (; offset + 8 + length_k - 1 <= h_length; offset += 8) {
+            sz_u64_t firsts = sz_u64_load(h + offset).u64 ^ first_vec;
+            sz_u64_t lasts = sz_u64_load(h + offset + length_k - 1).u64 ^ last_vec;
+            // Zero bytes mark the matches, but the borrows may flag a few extra bytes above them for verification.
+            sz_u64_t candidates = (firsts - ones_vec) & ~firsts & (lasts - ones_vec) & ~lasts & tops_vec;
+            for (; candidates; candidates &= candidates - 1) {
+                size_type candidate = offset + sz_u64_ctz(candidates) / 8;
+                if (equal_(h + candidate)) return candidate;
+            }
+        }
+        for (; offset + length_k <= h_length; ++offset)
+            if (equal_(h + offset)) return offset;
+        return npos;
+#endif
+    }
+
+    /**
+     *  @brief  Replicates `_sz_locate_needle_anomalies` in C++ 11 `constexpr` recursion, so that the offsets of
+     *          the non-colliding first, middle and last bytes are evaluated by the compiler.
+     */
+    static constexpr bool has_duplicates_() noexcept {
+        return length_k > 3 && (byte_(0) == byte_(length_k / 2) || byte_(0) == byte_(length_k - 1) ||
+                                byte_(length_k / 2) == byte_(length_k - 1));
+    }
+    static constexpr size_type mid_left_(size_type mid) noexcept {
+        return byte_(mid) == byte_(0) && mid ? mid_left_(mid - 1) : mid;
+    }
+    static constexpr size_type mid_right_(size_type mid) noexcept {
+        return byte_(mid) == byte_(0) && mid + 1 < length_k - 1 ? mid_right_(mid + 1) : mid;
+    }
+    static constexpr size_type last_left_(size_type last, size_type mid) noexcept {
+        return (byte_(last) == byte_(mid) || byte_(last) == byte_(0)) && last > mid + 1 ? last_left_(last - 1, mid)
+                                                                                          : last;
+    }
+    static constexpr size_type offset_mid_() noexcept {
+        return length_k < 2 ? 0 : has_duplicates_() ? mid_right_(mid_left_(length_k / 2)) : length_k / 2;
+    }
+    static constexpr size_type offset_last_() noexcept {
+        return length_k < 2 ? 0 : has_duplicates_() ? last_left_(length_k - 1, offset_mid_()) : length_k - 1;
+    }
+
+  public:
+    /**
+     *  @brief  Needle state, matching the output of `sz_needle_prepare`, except for the zeroed skip table.
+     *          Only pass it to the SIMD kernels, as the serial Horspool would never advance with such a table.
+     */
+    static constexpr sz_needle_t prepared_k = {chars_k, length_k, 0, offset_mid_(), offset_last_(), {0}};
+
+  private:
+    static sz_needle_t prepare_() noexcept {
+        sz_needle_t prepared;
+        sz_needle_prepare(chars_k, length_k, &prepared);
+        return prepared;
+    }
+
+    /** @brief  Compares the prefix of the @p text against the needle, with a constant-length load and compare. */
+    static bool equal_(sz_cptr_t text) noexcept {
+        constexpr sz_u64_t prefix_word = prefix_word_();
+        constexpr size_type prefix_length = length_k < 8 ? length_k : 8;
+        sz_u64_t text_word = 0;
+        std::memcpy(&text_word, text, prefix_length);
+        return text_word == prefix_word &&
+               (length_k <= 8 || std::memcmp(text + 8, chars_k + 8, length_k - prefix_length) == 0);
+    }
+};
+
+#if !SZ_DETECT_CPP_17
+template <char... chars_>
+constexpr char basic_static_needle<chars_...>::chars_k[sizeof...(chars_) + 1];
+template <char... chars_>
+constexpr sz_needle_t basic_static_needle<chars_...>::prepared_k;
+#endif
+
+#if SZ_DETECT_CPP20
+
+/**
+ *  @brief  Structural wrapper for string literals, that can be passed as template arguments in C++ 20.
+ */
+template <std::size_t size_>
+struct static_string {
+    char chars[size_];
+    constexpr static_string(char const (&literal)[size_]) noexcept {
+        for (std::size_t i = 0; i != size_; ++i) chars[i] = literal[i];
+    }
+};
+
+template <static_string literal_, typename = std::make_index_sequence<sizeof(literal_.chars) - 1>>
+struct _static_needle_from_literal;
+
+template <static_string literal_, std::size_t... indices_>
+struct _static_needle_from_literal<literal_, std::index_sequence<indices_...>> {
+    using type = basic_static_needle<literal_.chars[indices_]...>;
+};
+
+/**
+ *  @brief  Compile-time needle, defined by a string literal, like `sz::static_needle<"\r\n\r\n">`.
+ *          The trailing null-terminator of the literal is not a part of the needle.
+ */
+template <static_string literal_>
+using static_needle = typename _static_needle_from_literal<literal_>::type;
+
+#endif
+
+/**
+ *  @brief  Zero-cost wrapper around the @b compile-time needle search, for `range_matches` and `range_splits`.
+ *  @tparam needle_type_    A `basic_static_needle` specialization.
+ */
+template <typename needle_type_, typename string_type_, typename overlaps_type = include_overlaps_type>
+struct matcher_find_static {
+    using size_type = typename string_type_::size_type;
+    constexpr size_type needle_length() const noexcept { return needle_type_::length_k; }
+    constexpr size_type skip_length() const noexcept {
+        return std::is_same<overlaps_type, include_overlaps_type>::value ? 1 : needle_type_::length_k;
+    }
+    size_type operator()(string_type_ haystack) const noexcept {
+        std::size_t position = needle_type_::find(haystack.data(), haystack.size());
+        return position != needle_type_::npos ? static_cast<size_type>(position) : string_type_::npos;
+    }
+};
+
+/**
+ *  @brief  Finds the first inclusion of a @b compile-time needle, like `sz::find<sz::static_needle<"\r\n">>(h)`.
+ *  @tparam needle_type_    A `basic_static_needle` specialization.
+ *  @return The offset of the match, or `npos` of the @p h string type, if there is none.
+ */
+template <typename needle_type_, typename string>
+typename string::size_type find(string const &h) noexcept {
+    return matcher_find_static<needle_type_, string>()(h);
+}
+
+/**
+ *  @brief  Find all potentially @b overlapping inclusions of a @b compile-time needle.
+ *  @tparam needle_type_    A `basic_static_needle` specialization.
+ */
+template <typename needle_type_, typename string>
+range_matches<string, matcher_find_static<needle_type_, string, include_overlaps_type>> find_all(
+    string const &h, include_overlaps_type = {}) noexcept {
+    return {h, {}};
+}
+
+/**
+ *  @brief  Find all @b non-overlapping inclusions of a @b compile-time needle.
+ *  @tparam needle_type_    A `basic_static_needle` specialization.
+ */
+template <typename needle_type_, typename string>
+range_matches<string, matcher_find_static<needle_type_, string, exclude_overlaps_type>> find_all(
+    string const &h, exclude_overlaps_type) noexcept {
+    return {h, {}};
+}
+
+/**
+ *  @brief  Splits a string around every @b non-overlapping inclusion of a @b compile-time needle.
+ *  @tparam needle_type_    A `basic_static_needle` specialization.
+ */
+template <typename needle_type_, typename string>
+range_splits<string, matcher_find_static<needle_type_, string, exclude_overlaps_type>> split(
+    string const &h) noexcept {
+    return {h, {}};
+}
+
+#pragma endregion
+
 #pragma region Global Operations with Dynamic Memory
 
 template <typename allocator_type_>
@@ -973,2762 +1287,4507 @@ static bool _with_alloc(allocator_callback_ &&callback) noexcept {
 
 #pragma endregion
 
-#pragma region Helper Template Classes
+#pragma region Memory Arenas
 
 /**
- *  @brief  A result of split a string once, containing the string slice ::before,
- *          the ::match itself, and the slice ::after.
+ *  @brief  Growable bump allocator, wrapping the `sz_memory_arena_t`, that releases all of its memory at once.
+ *          Suited for short-lived strings, like the ones constructed while handling a single request.
+ *          Neither copyable nor movable, as every allocator issued by it refers to its address.
+ *
+ *  @see    arena_allocator for a stateless allocator on top of a thread-local arena.
  */
-template <typename string_>
-struct string_partition_result {
-    string_ before;
-    string_ match;
-    string_ after;
-};
+class memory_arena {
+    sz_memory_arena_t arena_;
+    sz_memory_allocator_t allocator_;
 
-/**
- *  @brief  A reverse iterator for mutable and immutable character buffers.
- *          Replaces `std::reverse_iterator` to avoid including `<iterator>`.
- */
-template <typename value_type_>
-class reversed_iterator_for {
   public:
-    using iterator_category = std::random_access_iterator_tag;
-    using value_type = value_type_;
-    using difference_type = std::ptrdiff_t;
-    using pointer = value_type_ *;
-    using reference = value_type_ &;
-
-    reversed_iterator_for(pointer ptr) noexcept : ptr_(ptr) {}
-    reference operator*() const noexcept { return *ptr_; }
+    /**
+     *  @brief  Creates an empty arena, that would allocate chunks starting from @p chunk_capacity bytes.
+     *  @param  chunk_capacity  Capacity of the first chunk in bytes, or zero for the default of 4096 bytes.
+     */
+    explicit memory_arena(std::size_t chunk_capacity = 0) noexcept {
+        sz_memory_arena_init(&arena_, chunk_capacity, nullptr);
+        sz_memory_allocator_init_arena(&allocator_, &arena_);
+    }
+    ~memory_arena() noexcept { sz_memory_arena_free(&arena_); }
 
-    bool operator==(reversed_iterator_for const &other) const noexcept { return ptr_ == other.ptr_; }
-    bool operator!=(reversed_iterator_for const &other) const noexcept { return ptr_ != other.ptr_; }
-    reference operator[](difference_type n) const noexcept { return *(*this + n); }
-    reversed_iterator_for operator+(difference_type n) const noexcept { return reversed_iterator_for(ptr_ - n); }
-    reversed_iterator_for operator-(difference_type n) const noexcept { return reversed_iterator_for(ptr_ + n); }
-    difference_type operator-(reversed_iterator_for const &other) const noexcept { return other.ptr_ - ptr_; }
+    memory_arena(memory_arena const &) = delete;
+    memory_arena(memory_arena &&) = delete;
+    memory_arena &operator=(memory_arena const &) = delete;
+    memory_arena &operator=(memory_arena &&) = delete;
 
-    reversed_iterator_for &operator++() noexcept {
-        --ptr_;
-        return *this;
+    /** @brief  Bumps the arena cursor, returning @b nullptr if the upstream allocator fails. */
+    char *allocate(std::size_t length) noexcept {
+        return static_cast<char *>(allocator_.allocate(length, allocator_.handle));
     }
 
-    reversed_iterator_for operator++(int) const noexcept {
-        reversed_iterator_for temp = *this;
-        --ptr_;
-        return temp;
-    }
+    /** @brief  No-op, unless the most recent allocation is released, in which case it's reused. */
+    void deallocate(char *start, std::size_t length) noexcept { allocator_.free(start, length, allocator_.handle); }
 
-    reversed_iterator_for &operator--() const noexcept {
-        ++ptr_;
-        return *this;
-    }
+    /** @brief  Invalidates all of the allocations at once, keeping the largest chunk for reuse. */
+    void reset() noexcept { sz_memory_arena_reset(&arena_); }
 
-    reversed_iterator_for operator--(int) const noexcept {
-        reversed_iterator_for temp = *this;
-        ++ptr_;
-        return temp;
-    }
+    /** @brief  Returns all of the memory to the upstream allocator. */
+    void release() noexcept { sz_memory_arena_free(&arena_); }
 
-  private:
-    value_type_ *ptr_;
+    /** @brief  Exports a C allocator, that can be passed to the `sz_` functions, as long as the arena is alive. */
+    sz_memory_allocator_t c_allocator() noexcept { return allocator_; }
+
+    /** @brief  The arena used by all of the `arena_allocator` instances in the calling thread. */
+    static memory_arena &thread_local_instance() noexcept {
+        static thread_local memory_arena arena;
+        return arena;
+    }
 };
 
 /**
- *  @brief  An "expression template" for lazy concatenation of strings using the `operator|`.
+ *  @brief  Stateless allocator, that serves the requests from the `memory_arena::thread_local_instance()`.
+ *          Unlike the STL allocators, it returns @b nullptr on failure, as expected by `basic_string`.
  *
- *  TODO: Ensure eqnership passing and move semantics are preserved.
+ *  @warning Strings must not outlive the @b reset of the arena, and can't be shared between threads,
+ *           as their memory would be released by a different thread-local arena.
  */
-template <typename first_type, typename second_type>
-struct concatenation {
-
-    using value_type = typename first_type::value_type;
-    using pointer = value_type *;
-    using const_pointer = value_type const *;
-    using size_type = typename first_type::size_type;
-    using difference_type = typename first_type::difference_type;
-
-    first_type first;
-    second_type second;
-
-    std::size_t size() const noexcept { return first.size() + second.size(); }
-    std::size_t length() const noexcept { return first.size() + second.size(); }
+class arena_allocator {
+  public:
+    using value_type = char;
 
-    size_type copy(pointer destination) const noexcept {
-        first.copy(destination);
-        second.copy(destination + first.length());
-        return first.length() + second.length();
+    char *allocate(std::size_t length) noexcept { return memory_arena::thread_local_instance().allocate(length); }
+    void deallocate(char *start, std::size_t length) noexcept {
+        memory_arena::thread_local_instance().deallocate(start, length);
     }
 
-    size_type copy(pointer destination, size_type length) const noexcept {
-        auto first_length = std::min(first.length(), length);
-        auto second_length = std::min(second.length(), length - first_length);
-        first.copy(destination, first_length);
-        second.copy(destination + first_length, second_length);
-        return first_length + second_length;
-    }
+    /** @brief  Invalidates all of the strings allocated by the calling thread at once. */
+    static void reset() noexcept { memory_arena::thread_local_instance().reset(); }
 
-    template <typename last_type>
-    concatenation<concatenation<first_type, second_type>, last_type> operator|(last_type &&last) const {
-        return {*this, last};
-    }
+    bool operator==(arena_allocator const &) const noexcept { return true; }
+    bool operator!=(arena_allocator const &) const noexcept { return false; }
 };
 
 #pragma endregion
 
-#pragma region String Views/Spans
+#pragma region Multi-Pattern Search
 
 /**
- *  @brief  A string slice (view/span) class implementing a superset of C++23 functionality
- *          with much faster SIMD-accelerated substring search and approximate matching.
- *          Constructors are `constexpr` enabling `_sz` literals.
+ *  @brief  Compiled set of needles for simultaneous search, wrapping the `sz_multi_pattern_t`.
+ *          Non-copyable, as the compiled tables may be large. Ordering of needles defines their IDs.
  *
- *  @tparam char_type_  The character type, usually `char const` or `char`. Must be a single byte long.
+ *  @tparam allocator_type_  Stateless allocator, used to store the copy of needle views and the lookup tables.
+ *  @warning The needles themselves are not copied and must outlive the pattern!
  */
-template <typename char_type_>
-class basic_string_slice {
+template <typename allocator_type_ = std::allocator<char>>
+class basic_multi_pattern {
 
-    static_assert(sizeof(char_type_) == 1, "Characters must be a single byte long");
-    static_assert(std::is_reference<char_type_>::value == false, "Characters can't be references");
+    static_assert(std::is_empty<allocator_type_>::value, "We currently only support stateless allocators");
 
-    using char_type = char_type_;
-    using mutable_char_type = typename std::remove_const<char_type_>::type;
-    using immutable_char_type = typename std::add_const<char_type_>::type;
+    sz_multi_pattern_t pattern_;
 
-    char_type *start_;
-    std::size_t length_;
+    template <typename allocator_callback>
+    static bool _with_alloc(allocator_callback &&callback) noexcept {
+        return ashvardanian::stringzilla::_with_alloc<allocator_type_>(callback);
+    }
+
+    template <typename iterator_type_>
+    void init(iterator_type_ first, iterator_type_ last) noexcept(false) {
+        std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+        sz_string_view_t *views = nullptr;
+        bool succeeded = _with_alloc([&](sz_memory_allocator_t &alloc) {
+            views = (sz_string_view_t *)alloc.allocate(count * sizeof(sz_string_view_t), alloc.handle);
+            if (count && !views) return false;
+            for (std::size_t i = 0; first != last; ++first, ++i)
+                views[i].start = (sz_cptr_t)first->data(), views[i].length = first->size();
+            bool compiled = sz_multi_pattern_init(&pattern_, views, count, &alloc) == sz_true_k;
+            if (views) alloc.free(views, count * sizeof(sz_string_view_t), alloc.handle);
+            return compiled;
+        });
+        if (!succeeded) throw std::bad_alloc();
+    }
 
   public:
-    // STL compatibility
-    using traits_type = std::char_traits<char_type_>;
-    using value_type = mutable_char_type;
-    using pointer = char_type *;
-    using const_pointer = immutable_char_type *;
-    using reference = char_type &;
-    using const_reference = immutable_char_type &;
-    using const_iterator = const_pointer;
-    using iterator = pointer;
-    using reverse_iterator = reversed_iterator_for<char_type>;
-    using const_reverse_iterator = reversed_iterator_for<immutable_char_type>;
     using size_type = std::size_t;
-    using difference_type = std::ptrdiff_t;
 
-    // Non-STL type definitions
-    using string_slice = basic_string_slice<char_type>;
-    using string_span = basic_string_slice<mutable_char_type>;
-    using string_view = basic_string_slice<immutable_char_type>;
-    using partition_type = string_partition_result<string_slice>;
+    /**  @brief  Compiles needles from any forward-iterable range of string-like objects. */
+    template <typename iterator_type_>
+    basic_multi_pattern(iterator_type_ first, iterator_type_ last) noexcept(false) {
+        init(first, last);
+    }
 
-    /** @brief  Special value for missing matches.
-     *
-     *  We take the largest 63-bit unsigned integer on 64-bit machines.
-     *  We take the largest 31-bit unsigned integer on 32-bit machines.
-     */
-    static constexpr size_type npos = SZ_SSIZE_MAX;
+    /**  @brief  Compiles needles from a container of string-like objects, like `std::vector<std::string>`. */
+    template <typename container_type_>
+    explicit basic_multi_pattern(container_type_ const &needles) noexcept(false) {
+        init(needles.begin(), needles.end());
+    }
 
-#pragma region Constructors and STL Utilities
+    basic_multi_pattern(std::initializer_list<string_view> needles) noexcept(false) {
+        init(needles.begin(), needles.end());
+    }
 
-    constexpr basic_string_slice() noexcept : start_(nullptr), length_(0) {}
-    constexpr basic_string_slice(pointer c_string) noexcept
-        : start_(c_string), length_(null_terminated_length(c_string)) {}
-    constexpr basic_string_slice(pointer c_string, size_type length) noexcept : start_(c_string), length_(length) {}
+    basic_multi_pattern(basic_multi_pattern const &) = delete;
+    basic_multi_pattern &operator=(basic_multi_pattern const &) = delete;
 
-    sz_constexpr_if_cpp20 basic_string_slice(basic_string_slice const &other) noexcept = default;
-    sz_constexpr_if_cpp20 basic_string_slice &operator=(basic_string_slice const &other) noexcept = default;
-    basic_string_slice(std::nullptr_t) = delete;
+    basic_multi_pattern(basic_multi_pattern &&other) noexcept : pattern_(other.pattern_) {
+        other.pattern_.needles = nullptr;
+        other.pattern_.count = other.pattern_.ids_count = other.pattern_.probe_length = 0;
+    }
 
-    /**  @brief Exchanges the view with that of the `other`. */
-    void swap(string_slice &other) noexcept { std::swap(start_, other.start_), std::swap(length_, other.length_); }
+    basic_multi_pattern &operator=(basic_multi_pattern &&other) noexcept {
+        std::swap(pattern_, other.pattern_);
+        return *this;
+    }
 
-#if !SZ_AVOID_STL
+    ~basic_multi_pattern() noexcept {
+        _with_alloc([&](sz_memory_allocator_t &alloc) {
+            sz_multi_pattern_free(&pattern_, &alloc);
+            return true;
+        });
+    }
 
-    template <typename sfinae_ = char_type, typename std::enable_if<std::is_const<sfinae_>::value, int>::type = 0>
-    sz_constexpr_if_cpp20 basic_string_slice(std::string const &other) noexcept
-        : basic_string_slice(other.data(), other.size()) {}
+    /**  @brief  Number of needles, including the empty ones, that will never match. */
+    size_type size() const noexcept { return pattern_.count; }
+    bool empty() const noexcept { return pattern_.ids_count == 0; }
 
-    template <typename sfinae_ = char_type, typename std::enable_if<!std::is_const<sfinae_>::value, int>::type = 0>
-    sz_constexpr_if_cpp20 basic_string_slice(std::string &other) noexcept
-        : basic_string_slice(&other[0], other.size()) {} // The `.data()` has mutable variant only since C++17
+    /**  @brief  Length of the needle with the given ID. */
+    size_type needle_length(size_type needle_id) const noexcept { return pattern_.needles[needle_id].length; }
 
-    template <typename sfinae_ = char_type, typename std::enable_if<std::is_const<sfinae_>::value, int>::type = 0>
-    sz_constexpr_if_cpp20 string_slice &operator=(std::string const &other) noexcept {
-        return assign({other.data(), other.size()});
-    }
+    sz_multi_pattern_t const *c_pattern() const noexcept { return &pattern_; }
+};
 
-    template <typename sfinae_ = char_type, typename std::enable_if<!std::is_const<sfinae_>::value, int>::type = 0>
-    sz_constexpr_if_cpp20 string_slice &operator=(std::string &other) noexcept {
-        return assign({other.data(), other.size()});
-    }
+using multi_pattern = basic_multi_pattern<>;
 
-    operator std::string() const { return {data(), size()}; }
+/**
+ *  @brief  A single match of a multi-pattern search, containing the matched slice,
+ *          its ::offset in the haystack, and the ::needle ID, or `npos` values if nothing was found.
+ */
+template <typename string_>
+struct multi_pattern_match {
+    using string_type = string_;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
-    /**
-     *  @brief  Formatted output function for compatibility with STL's `std::basic_ostream`.
-     *  @throw  `std::ios_base::failure` if an exception occurred during output.
-     */
-    template <typename stream_traits>
-    friend std::basic_ostream<value_type, stream_traits> &operator<<(std::basic_ostream<value_type, stream_traits> &os,
-                                                                     string_slice const &str) noexcept(false) {
-        return os.write(str.data(), str.size());
-    }
+    string_type match;
+    std::size_t offset = npos;
+    std::size_t needle = npos;
 
-#if SZ_DETECT_CPP_17 && __cpp_lib_string_view
+    explicit operator bool() const noexcept { return offset != npos; }
+};
 
-    template <typename sfinae_ = char_type, typename std::enable_if<std::is_const<sfinae_>::value, int>::type = 0>
-    sz_constexpr_if_cpp20 basic_string_slice(std::string_view const &other) noexcept
-        : basic_string_slice(other.data(), other.size()) {}
+/**
+ *  @brief  Locates the earliest occurrence of any of the compiled needles.
+ *          If several needles match at the same offset, the one with the smallest ID is reported.
+ *  @tparam string  A string-like type, ideally a view, like StringZilla or STL `string_view`.
+ */
+template <typename string, typename allocator_type_>
+multi_pattern_match<string> find_any(string const &h, basic_multi_pattern<allocator_type_> const &patterns) noexcept {
+    multi_pattern_match<string> result;
+    sz_size_t needle_id;
+    sz_cptr_t match = sz_find_any(patterns.c_pattern(), (sz_cptr_t)h.data(), h.size(), &needle_id);
+    if (!match) return result;
+    result.offset = static_cast<std::size_t>(match - (sz_cptr_t)h.data());
+    result.needle = needle_id;
+    result.match = h.substr(result.offset, patterns.needle_length(needle_id));
+    return result;
+}
 
-    template <typename sfinae_ = char_type, typename std::enable_if<std::is_const<sfinae_>::value, int>::type = 0>
-    sz_constexpr_if_cpp20 string_slice &operator=(std::string_view const &other) noexcept {
-        return assign({other.data(), other.size()});
-    }
-    operator std::string_view() const noexcept { return {data(), size()}; }
+/**
+ *  @brief  A range of multi-pattern matches, walking through the haystack from left to right.
+ *          Compatible with C++23 ranges, C++11 string views, and of course, StringZilla.
+ *
+ *  When overlaps are included, every needle matching at every offset is reported, in the ascending order of IDs
+ *  within the same offset. So "ab" and "abc" both match the "abcd" haystack at zero offset. When excluded, only
+ *  the smallest ID is reported and the search continues after the end of its match.
+ */
+template <typename string_type_, typename pattern_type_, typename overlaps_type = include_overlaps_type>
+class range_multi_matches {
+  public:
+    using string_type = string_type_;
+    using pattern_type = pattern_type_;
 
-#endif
+  private:
+    pattern_type const *pattern_;
+    string_type haystack_;
 
-#endif
+  public:
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using value_type = multi_pattern_match<string_type>;
+    using pointer = value_type;   // Needed for compatibility with STL container constructors.
+    using reference = value_type; // Needed for compatibility with STL container constructors.
 
-#pragma endregion
+    range_multi_matches(string_type haystack, pattern_type const &pattern) noexcept
+        : pattern_(&pattern), haystack_(haystack) {}
 
-#pragma region Iterators and Element Access
+    class iterator {
+        pattern_type const *pattern_;
+        string_type haystack_;
+        multi_pattern_match<string_type> match_;
+
+        void seek(std::size_t start) noexcept {
+            multi_pattern_match<string_type> next = find_any(haystack_.substr(start), *pattern_);
+            if (next) next.offset += start;
+            else { next.offset = haystack_.size(); }
+            match_ = next;
+        }
 
-    iterator begin() const noexcept { return iterator(start_); }
-    iterator end() const noexcept { return iterator(start_ + length_); }
-    const_iterator cbegin() const noexcept { return const_iterator(start_); }
-    const_iterator cend() const noexcept { return const_iterator(start_ + length_); }
-    reverse_iterator rbegin() const noexcept { return reverse_iterator(start_ + length_ - 1); }
-    reverse_iterator rend() const noexcept { return reverse_iterator(start_ - 1); }
-    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(start_ + length_ - 1); }
-    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(start_ - 1); }
+        /**
+         *  @brief  Switches to the next needle with a larger ID, that matches at the same offset, if any.
+         *          Only the needles sharing the probed prefix with the current match are compared. Those are
+         *          adjacent in the sorted `ids` and ascending by ID, so a binary search finds the first one.
+         */
+        bool seek_same_offset() noexcept {
+            sz_multi_pattern_t const *c_pattern = pattern_->c_pattern();
+            sz_cptr_t const text = (sz_cptr_t)haystack_.data() + match_.offset;
+            std::size_t const remaining = haystack_.size() - match_.offset;
+            std::size_t const probe_length = c_pattern->probe_length;
+            if (remaining < probe_length) return false;
+
+            sz_u8_t const *text_unsigned = (sz_u8_t const *)text;
+            sz_u32_t prefix = 0;
+            for (std::size_t k = 0; k != probe_length; ++k) prefix = (prefix << 8) | text_unsigned[k];
+
+            // Find the first needle ordered after the current one, comparing the prefixes and then the IDs
+            std::size_t low = 0, high = c_pattern->ids_count;
+            while (low < high) {
+                std::size_t mid = low + (high - low) / 2;
+                sz_u32_t const mid_prefix = c_pattern->prefixes[mid];
+                if (mid_prefix < prefix || (mid_prefix == prefix && c_pattern->ids[mid] <= match_.needle))
+                    low = mid + 1;
+                else { high = mid; }
+            }
+            for (; low != c_pattern->ids_count && c_pattern->prefixes[low] == prefix; ++low) {
+                std::size_t const id = c_pattern->ids[low];
+                sz_string_view_t const &needle = c_pattern->needles[id];
+                if (needle.length > remaining) continue;
+                if (sz_equal(text + probe_length, needle.start + probe_length, needle.length - probe_length) !=
+                    sz_true_k)
+                    continue;
+                match_.needle = id;
+                match_.match = haystack_.substr(match_.offset, needle.length);
+                return true;
+            }
+            return false;
+        }
 
-    reference operator[](size_type pos) const noexcept { return start_[pos]; }
-    reference at(size_type pos) const noexcept { return start_[pos]; }
-    reference front() const noexcept { return start_[0]; }
-    reference back() const noexcept { return start_[length_ - 1]; }
-    pointer data() const noexcept { return start_; }
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = multi_pattern_match<string_type>;
+        using pointer = value_type;   // Needed for compatibility with STL container constructors.
+        using reference = value_type; // Needed for compatibility with STL container constructors.
 
-    difference_type ssize() const noexcept { return static_cast<difference_type>(length_); }
-    size_type size() const noexcept { return length_; }
-    size_type length() const noexcept { return length_; }
-    size_type max_size() const noexcept { return npos - 1; }
-    bool empty() const noexcept { return length_ == 0; }
+        iterator(string_type haystack, pattern_type const *pattern, std::size_t start) noexcept
+            : pattern_(pattern), haystack_(haystack) {
+            seek(start);
+        }
 
-#pragma endregion
+        pointer operator->() const noexcept = delete;
+        value_type operator*() const noexcept { return match_; }
 
-#pragma region Slicing
+        iterator &operator++() noexcept {
+            bool include = std::is_same<overlaps_type, include_overlaps_type>();
+            if (include && seek_same_offset()) return *this;
+            seek(match_.offset + (include ? 1 : match_.match.size()));
+            return *this;
+        }
 
-#pragma region Safe and Signed Extensions
+        iterator operator++(int) noexcept {
+            iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
 
-    /**
-     *  @brief  Equivalent to Python's `"abc"[-3:-1]`. Exception-safe, unlike STL's `substr`.
-     *          Supports signed and unsigned intervals.
-     */
-    string_slice operator[](std::initializer_list<difference_type> signed_offsets) const noexcept {
-        assert(signed_offsets.size() == 2 && "operator[] can't take more than 2 offsets");
-        return sub(signed_offsets.begin()[0], signed_offsets.begin()[1]);
-    }
+        bool operator!=(iterator const &other) const noexcept { return !(*this == other); }
+        bool operator==(iterator const &other) const noexcept {
+            return match_.offset == other.match_.offset && match_.needle == other.match_.needle;
+        }
+        bool operator!=(end_sentinel_type) const noexcept { return match_.offset != haystack_.size(); }
+        bool operator==(end_sentinel_type) const noexcept { return match_.offset == haystack_.size(); }
+    };
 
-    /**
-     *  @brief  Signed alternative to `at()`. Handy if you often write `str[str.size() - 2]`.
-     *  @warning The behavior is @b undefined if the position is beyond bounds.
-     */
-    reference sat(difference_type signed_offset) const noexcept {
-        size_type pos = (signed_offset < 0) ? size() + signed_offset : signed_offset;
-        assert(pos < size() && "string_slice::sat(i) out of bounds");
-        return start_[pos];
-    }
+    iterator begin() const noexcept { return {haystack_, pattern_, 0}; }
+    iterator end() const noexcept { return {haystack_, pattern_, haystack_.size()}; }
+    size_type size() const noexcept { return static_cast<size_type>(ssize()); }
+    difference_type ssize() const noexcept { return std::distance(begin(), end()); }
+    bool empty() const noexcept { return begin() == end_sentinel_type {}; }
 
     /**
-     *  @brief  The opposite operation to `remove_prefix`, that does no bounds checking.
-     *  @warning The behavior is @b undefined if `n > size()`.
+     *  @brief  Copies the matches into a container.
      */
-    string_slice front(size_type n) const noexcept {
-        assert(n <= size() && "string_slice::front(n) out of bounds");
-        return {start_, n};
+    template <typename container_>
+    void to(container_ &container) {
+        for (auto match : *this) { container.push_back(match); }
     }
 
     /**
-     *  @brief  The opposite operation to `remove_prefix`, that does no bounds checking.
-     *  @warning The behavior is @b undefined if `n > size()`.
+     *  @brief  Copies the matches into a consumed container, returning it at the end.
      */
-    string_slice back(size_type n) const noexcept {
-        assert(n <= size() && "string_slice::back(n) out of bounds");
-        return {start_ + length_ - n, n};
+    template <typename container_>
+    container_ to() {
+        return container_ {begin(), end()};
     }
+};
 
-    /**
-     *  @brief  Equivalent to Python's `"abc"[-3:-1]`. Exception-safe, unlike STL's `substr`.
-     *          Supports signed and unsigned intervals.
-     */
-    string_slice sub(difference_type signed_start_offset, difference_type signed_end_offset = npos) const noexcept {
-        sz_size_t normalized_offset, normalized_length;
-        sz_ssize_clamp_interval(length_, signed_start_offset, signed_end_offset, &normalized_offset,
-                                &normalized_length);
-        return string_slice(start_ + normalized_offset, normalized_length);
-    }
+/**
+ *  @brief  Find all potentially @b overlapping occurrences of any of the compiled needles,
+ *          including the different needles matching at the same offset.
+ *  @tparam string  A string-like type, ideally a view, like StringZilla or STL `string_view`.
+ */
+template <typename string, typename allocator_type_>
+range_multi_matches<string, basic_multi_pattern<allocator_type_>, include_overlaps_type> find_all_any(
+    string const &h, basic_multi_pattern<allocator_type_> const &patterns, include_overlaps_type = {}) noexcept {
+    return {h, patterns};
+}
 
-    /**
-     *  @brief  Exports this entire view. Not an STL function, but useful for concatenations.
-     *          The STL variant expects at least two arguments.
-     */
-    size_type copy(value_type *destination) const noexcept {
-        sz_copy((sz_ptr_t)destination, start_, length_);
-        return length_;
-    }
+/**
+ *  @brief  Find all @b non-overlapping occurrences of any of the compiled needles.
+ *  @tparam string  A string-like type, ideally a view, like StringZilla or STL `string_view`.
+ */
+template <typename string, typename allocator_type_>
+range_multi_matches<string, basic_multi_pattern<allocator_type_>, exclude_overlaps_type> find_all_any(
+    string const &h, basic_multi_pattern<allocator_type_> const &patterns, exclude_overlaps_type) noexcept {
+    return {h, patterns};
+}
 
 #pragma endregion
 
-#pragma region STL Style
+#pragma region Helper Template Classes
 
-    /**
-     *  @brief  Removes the first `n` characters from the view.
-     *  @warning The behavior is @b undefined if `n > size()`.
-     */
-    void remove_prefix(size_type n) noexcept { assert(n <= size()), start_ += n, length_ -= n; }
+/**
+ *  @brief  A result of split a string once, containing the string slice ::before,
+ *          the ::match itself, and the slice ::after.
+ */
+template <typename string_>
+struct string_partition_result {
+    string_ before;
+    string_ match;
+    string_ after;
+};
 
-    /**
-     *  @brief  Removes the last `n` characters from the view.
-     *  @warning The behavior is @b undefined if `n > size()`.
-     */
-    void remove_suffix(size_type n) noexcept { assert(n <= size()), length_ -= n; }
+/**
+ *  @brief  A reverse iterator for mutable and immutable character buffers.
+ *          Replaces `std::reverse_iterator` to avoid including `<iterator>`.
+ */
+template <typename value_type_>
+class reversed_iterator_for {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = value_type_;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type_ *;
+    using reference = value_type_ &;
 
-    /**  @brief  Added for STL compatibility. */
-    string_slice substr() const noexcept { return *this; }
+    reversed_iterator_for(pointer ptr) noexcept : ptr_(ptr) {}
+    reference operator*() const noexcept { return *ptr_; }
 
-    /**
-     *  @brief  Return a slice of this view after first `skip` bytes.
-     *  @throws `std::out_of_range` if `skip > size()`.
-     *  @see    `sub` for a cleaner exception-less alternative.
-     */
-    string_slice substr(size_type skip) const noexcept(false) {
-        if (skip > size()) throw std::out_of_range("string_slice::substr");
-        return string_slice(start_ + skip, length_ - skip);
-    }
+    bool operator==(reversed_iterator_for const &other) const noexcept { return ptr_ == other.ptr_; }
+    bool operator!=(reversed_iterator_for const &other) const noexcept { return ptr_ != other.ptr_; }
+    reference operator[](difference_type n) const noexcept { return *(*this + n); }
+    reversed_iterator_for operator+(difference_type n) const noexcept { return reversed_iterator_for(ptr_ - n); }
+    reversed_iterator_for operator-(difference_type n) const noexcept { return reversed_iterator_for(ptr_ + n); }
+    difference_type operator-(reversed_iterator_for const &other) const noexcept { return other.ptr_ - ptr_; }
 
-    /**
-     *  @brief  Return a slice of this view after first `skip` bytes, taking at most `count` bytes.
-     *  @throws `std::out_of_range` if `skip > size()`.
-     *  @see    `sub` for a cleaner exception-less alternative.
-     */
-    string_slice substr(size_type skip, size_type count) const noexcept(false) {
-        if (skip > size()) throw std::out_of_range("string_slice::substr");
-        return string_slice(start_ + skip, sz_min_of_two(count, length_ - skip));
+    reversed_iterator_for &operator++() noexcept {
+        --ptr_;
+        return *this;
     }
 
-    /**
-     *  @brief  Exports a slice of this view after first `skip` bytes, taking at most `count` bytes.
-     *  @throws `std::out_of_range` if `skip > size()`.
-     *  @see    `sub` for a cleaner exception-less alternative.
-     */
-    size_type copy(value_type *destination, size_type count, size_type skip = 0) const noexcept(false) {
-        if (skip > size()) throw std::out_of_range("string_slice::copy");
-        count = sz_min_of_two(count, length_ - skip);
-        sz_copy((sz_ptr_t)destination, start_ + skip, count);
-        return count;
+    reversed_iterator_for operator++(int) const noexcept {
+        reversed_iterator_for temp = *this;
+        --ptr_;
+        return temp;
     }
 
-#pragma endregion
-
-#pragma endregion
+    reversed_iterator_for &operator--() const noexcept {
+        ++ptr_;
+        return *this;
+    }
 
-#pragma region Comparisons
+    reversed_iterator_for operator--(int) const noexcept {
+        reversed_iterator_for temp = *this;
+        ++ptr_;
+        return temp;
+    }
 
-#pragma region Whole String Comparisons
+  private:
+    value_type_ *ptr_;
+};
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     */
-    int compare(string_view other) const noexcept {
-        return (int)sz_order(start_, length_, other.start_, other.length_);
-    }
+/**
+ *  @brief  An "expression template" for lazy concatenation of strings using the `operator|`.
+ *
+ *  TODO: Ensure eqnership passing and move semantics are preserved.
+ */
+template <typename first_type, typename second_type>
+struct concatenation {
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *          Equivalent to `substr(pos1, count1).compare(other)`.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     *  @throw  `std::out_of_range` if `pos1 > size()`.
-     */
-    int compare(size_type pos1, size_type count1, string_view other) const noexcept(false) {
-        return substr(pos1, count1).compare(other);
-    }
+    using value_type = typename first_type::value_type;
+    using pointer = value_type *;
+    using const_pointer = value_type const *;
+    using size_type = typename first_type::size_type;
+    using difference_type = typename first_type::difference_type;
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *          Equivalent to `substr(pos1, count1).compare(other.substr(pos2, count2))`.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     *  @throw  `std::out_of_range` if `pos1 > size()` or if `pos2 > other.size()`.
-     */
-    int compare(size_type pos1, size_type count1, string_view other, size_type pos2, size_type count2) const
-        noexcept(false) {
-        return substr(pos1, count1).compare(other.substr(pos2, count2));
-    }
+    first_type first;
+    second_type second;
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     */
-    int compare(const_pointer other) const noexcept { return compare(string_view(other)); }
+    std::size_t size() const noexcept { return first.size() + second.size(); }
+    std::size_t length() const noexcept { return first.size() + second.size(); }
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *          Equivalent to substr(pos1, count1).compare(other).
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     *  @throw  `std::out_of_range` if `pos1 > size()`.
-     */
-    int compare(size_type pos1, size_type count1, const_pointer other) const noexcept(false) {
-        return substr(pos1, count1).compare(string_view(other));
+    size_type copy(pointer destination) const noexcept {
+        first.copy(destination);
+        second.copy(destination + first.length());
+        return first.length() + second.length();
     }
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *          Equivalent to `substr(pos1, count1).compare({s, count2})`.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     *  @throw  `std::out_of_range` if `pos1 > size()`.
-     */
-    int compare(size_type pos1, size_type count1, const_pointer other, size_type count2) const noexcept(false) {
-        return substr(pos1, count1).compare(string_view(other, count2));
+    size_type copy(pointer destination, size_type length) const noexcept {
+        auto first_length = std::min(first.length(), length);
+        auto second_length = std::min(second.length(), length - first_length);
+        first.copy(destination, first_length);
+        second.copy(destination + first_length, second_length);
+        return first_length + second_length;
     }
 
-    /**  @brief  Checks if the string is equal to the other string. */
-    bool operator==(string_view other) const noexcept {
-        return size() == other.size() && sz_equal(data(), other.data(), other.size()) == sz_true_k;
+    template <typename last_type>
+    concatenation<concatenation<first_type, second_type>, last_type> operator|(last_type &&last) const {
+        return {*this, last};
     }
+};
 
-    /**  @brief  Checks if the string is equal to a concatenation of two strings. */
-    bool operator==(concatenation<string_view, string_view> const &other) const noexcept {
-        return size() == other.size() && sz_equal(data(), other.first.data(), other.first.size()) == sz_true_k &&
-               sz_equal(data() + other.first.size(), other.second.data(), other.second.size()) == sz_true_k;
-    }
+#pragma endregion
 
-#if SZ_DETECT_CPP20
+#pragma region String Views/Spans
 
-    /**  @brief  Computes the lexicographic ordering between this and the ::other string. */
-    std::strong_ordering operator<=>(string_view other) const noexcept {
-        std::strong_ordering orders[3] {std::strong_ordering::less, std::strong_ordering::equal,
-                                        std::strong_ordering::greater};
-        return orders[compare(other) + 1];
-    }
+/**
+ *  @brief  A string slice (view/span) class implementing a superset of C++23 functionality
+ *          with much faster SIMD-accelerated substring search and approximate matching.
+ *          Constructors are `constexpr` enabling `_sz` literals.
+ *
+ *  @tparam char_type_  The character type, usually `char const` or `char`. Must be a single byte long.
+ */
+template <typename char_type_>
+class basic_string_slice {
 
-#else
+    static_assert(sizeof(char_type_) == 1, "Characters must be a single byte long");
+    static_assert(std::is_reference<char_type_>::value == false, "Characters can't be references");
 
-    /**  @brief  Checks if the string is not equal to the other string. */
-    bool operator!=(string_view other) const noexcept { return !operator==(other); }
+    using char_type = char_type_;
+    using mutable_char_type = typename std::remove_const<char_type_>::type;
+    using immutable_char_type = typename std::add_const<char_type_>::type;
 
-    /**  @brief  Checks if the string is lexicographically smaller than the other string. */
-    bool operator<(string_view other) const noexcept { return compare(other) == sz_less_k; }
+    char_type *start_;
+    std::size_t length_;
 
-    /**  @brief  Checks if the string is lexicographically equal or smaller than the other string. */
-    bool operator<=(string_view other) const noexcept { return compare(other) != sz_greater_k; }
+  public:
+    // STL compatibility
+    using traits_type = std::char_traits<char_type_>;
+    using value_type = mutable_char_type;
+    using pointer = char_type *;
+    using const_pointer = immutable_char_type *;
+    using reference = char_type &;
+    using const_reference = immutable_char_type &;
+    using const_iterator = const_pointer;
+    using iterator = pointer;
+    using reverse_iterator = reversed_iterator_for<char_type>;
+    using const_reverse_iterator = reversed_iterator_for<immutable_char_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
 
-    /**  @brief  Checks if the string is lexicographically greater than the other string. */
-    bool operator>(string_view other) const noexcept { return compare(other) == sz_greater_k; }
+    // Non-STL type definitions
+    using string_slice = basic_string_slice<char_type>;
+    using string_span = basic_string_slice<mutable_char_type>;
+    using string_view = basic_string_slice<immutable_char_type>;
+    using partition_type = string_partition_result<string_slice>;
 
-    /**  @brief  Checks if the string is lexicographically equal or greater than the other string. */
-    bool operator>=(string_view other) const noexcept { return compare(other) != sz_less_k; }
+    /** @brief  Special value for missing matches.
+     *
+     *  We take the largest 63-bit unsigned integer on 64-bit machines.
+     *  We take the largest 31-bit unsigned integer on 32-bit machines.
+     */
+    static constexpr size_type npos = SZ_SSIZE_MAX;
 
-#endif
+#pragma region Constructors and STL Utilities
 
-#pragma endregion
-#pragma region Prefix and Suffix Comparisons
+    constexpr basic_string_slice() noexcept : start_(nullptr), length_(0) {}
+    constexpr basic_string_slice(pointer c_string) noexcept
+        : start_(c_string), length_(null_terminated_length(c_string)) {}
+    constexpr basic_string_slice(pointer c_string, size_type length) noexcept : start_(c_string), length_(length) {}
 
-    /**  @brief  Checks if the string starts with the other string. */
-    bool starts_with(string_view other) const noexcept {
-        return length_ >= other.length_ && sz_equal(start_, other.start_, other.length_) == sz_true_k;
-    }
+    sz_constexpr_if_cpp20 basic_string_slice(basic_string_slice const &other) noexcept = default;
+    sz_constexpr_if_cpp20 basic_string_slice &operator=(basic_string_slice const &other) noexcept = default;
+    basic_string_slice(std::nullptr_t) = delete;
 
-    /**  @brief  Checks if the string starts with the other string. */
-    bool starts_with(const_pointer other) const noexcept {
-        auto other_length = null_terminated_length(other);
-        return length_ >= other_length && sz_equal(start_, other, other_length) == sz_true_k;
-    }
+    /**  @brief Exchanges the view with that of the `other`. */
+    void swap(string_slice &other) noexcept { std::swap(start_, other.start_), std::swap(length_, other.length_); }
 
-    /**  @brief  Checks if the string starts with the other character. */
-    bool starts_with(value_type other) const noexcept { return length_ && start_[0] == other; }
+#if !SZ_AVOID_STL
 
-    /**  @brief  Checks if the string ends with the other string. */
-    bool ends_with(string_view other) const noexcept {
-        return length_ >= other.length_ &&
-               sz_equal(start_ + length_ - other.length_, other.start_, other.length_) == sz_true_k;
+    template <typename sfinae_ = char_type, typename std::enable_if<std::is_const<sfinae_>::value, int>::type = 0>
+    sz_constexpr_if_cpp20 basic_string_slice(std::string const &other) noexcept
+        : basic_string_slice(other.data(), other.size()) {}
+
+    template <typename sfinae_ = char_type, typename std::enable_if<!std::is_const<sfinae_>::value, int>::type = 0>
+    sz_constexpr_if_cpp20 basic_string_slice(std::string &other) noexcept
+        : basic_string_slice(&other[0], other.size()) {} // The `.data()` has mutable variant only since C++17
+
+    template <typename sfinae_ = char_type, typename std::enable_if<std::is_const<sfinae_>::value, int>::type = 0>
+    sz_constexpr_if_cpp20 string_slice &operator=(std::string const &other) noexcept {
+        return assign({other.data(), other.size()});
     }
 
-    /**  @brief  Checks if the string ends with the other string. */
-    bool ends_with(const_pointer other) const noexcept {
-        auto other_length = null_terminated_length(other);
-        return length_ >= other_length && sz_equal(start_ + length_ - other_length, other, other_length) == sz_true_k;
+    template <typename sfinae_ = char_type, typename std::enable_if<!std::is_const<sfinae_>::value, int>::type = 0>
+    sz_constexpr_if_cpp20 string_slice &operator=(std::string &other) noexcept {
+        return assign({other.data(), other.size()});
     }
 
-    /**  @brief  Checks if the string ends with the other character. */
-    bool ends_with(value_type other) const noexcept { return length_ && start_[length_ - 1] == other; }
+    operator std::string() const { return {data(), size()}; }
 
-    /**  @brief  Python-like convenience function, dropping the matching prefix. */
-    string_slice remove_prefix(string_view other) const noexcept {
-        return starts_with(other) ? string_slice {start_ + other.length_, length_ - other.length_} : *this;
+    /**
+     *  @brief  Formatted output function for compatibility with STL's `std::basic_ostream`.
+     *  @throw  `std::ios_base::failure` if an exception occurred during output.
+     */
+    template <typename stream_traits>
+    friend std::basic_ostream<value_type, stream_traits> &operator<<(std::basic_ostream<value_type, stream_traits> &os,
+                                                                     string_slice const &str) noexcept(false) {
+        return os.write(str.data(), str.size());
     }
 
-    /**  @brief  Python-like convenience function, dropping the matching suffix. */
-    string_slice remove_suffix(string_view other) const noexcept {
-        return ends_with(other) ? string_slice {start_, length_ - other.length_} : *this;
+#if SZ_DETECT_CPP_17 && __cpp_lib_string_view
+
+    template <typename sfinae_ = char_type, typename std::enable_if<std::is_const<sfinae_>::value, int>::type = 0>
+    sz_constexpr_if_cpp20 basic_string_slice(std::string_view const &other) noexcept
+        : basic_string_slice(other.data(), other.size()) {}
+
+    template <typename sfinae_ = char_type, typename std::enable_if<std::is_const<sfinae_>::value, int>::type = 0>
+    sz_constexpr_if_cpp20 string_slice &operator=(std::string_view const &other) noexcept {
+        return assign({other.data(), other.size()});
     }
+    operator std::string_view() const noexcept { return {data(), size()}; }
+
+#endif
+
+#endif
 
-#pragma endregion
 #pragma endregion
 
-#pragma region Matching Substrings
+#pragma region Iterators and Element Access
 
-    bool contains(string_view other) const noexcept { return find(other) != npos; }
-    bool contains(value_type character) const noexcept { return find(character) != npos; }
-    bool contains(const_pointer other) const noexcept { return find(other) != npos; }
+    iterator begin() const noexcept { return iterator(start_); }
+    iterator end() const noexcept { return iterator(start_ + length_); }
+    const_iterator cbegin() const noexcept { return const_iterator(start_); }
+    const_iterator cend() const noexcept { return const_iterator(start_ + length_); }
+    reverse_iterator rbegin() const noexcept { return reverse_iterator(start_ + length_ - 1); }
+    reverse_iterator rend() const noexcept { return reverse_iterator(start_ - 1); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(start_ + length_ - 1); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(start_ - 1); }
 
-#pragma region Returning offsets
+    reference operator[](size_type pos) const noexcept { return start_[pos]; }
+    reference at(size_type pos) const noexcept { return start_[pos]; }
+    reference front() const noexcept { return start_[0]; }
+    reference back() const noexcept { return start_[length_ - 1]; }
+    pointer data() const noexcept { return start_; }
 
-    /**
-     *  @brief  Find the first occurrence of a substring, skipping the first `skip` characters.
-     *          The behavior is @b undefined if `skip > size()`.
-     *  @return The offset of the first character of the match, or `npos` if not found.
-     */
-    size_type find(string_view other, size_type skip = 0) const noexcept {
-        auto ptr = sz_find(start_ + skip, length_ - skip, other.start_, other.length_);
-        return ptr ? ptr - start_ : npos;
-    }
+    difference_type ssize() const noexcept { return static_cast<difference_type>(length_); }
+    size_type size() const noexcept { return length_; }
+    size_type length() const noexcept { return length_; }
+    size_type max_size() const noexcept { return npos - 1; }
+    bool empty() const noexcept { return length_ == 0; }
 
-    /**
-     *  @brief  Find the first occurrence of a character, skipping the first `skip` characters.
-     *          The behavior is @b undefined if `skip > size()`.
-     *  @return The offset of the match, or `npos` if not found.
-     */
-    size_type find(value_type character, size_type skip = 0) const noexcept {
-        auto ptr = sz_find_byte(start_ + skip, length_ - skip, &character);
-        return ptr ? ptr - start_ : npos;
-    }
+#pragma endregion
+
+#pragma region Slicing
+
+#pragma region Safe and Signed Extensions
 
     /**
-     *  @brief  Find the first occurrence of a substring, skipping the first `skip` characters.
-     *          The behavior is @b undefined if `skip > size()`.
-     *  @return The offset of the first character of the match, or `npos` if not found.
+     *  @brief  Equivalent to Python's `"abc"[-3:-1]`. Exception-safe, unlike STL's `substr`.
+     *          Supports signed and unsigned intervals.
      */
-    size_type find(const_pointer other, size_type pos, size_type count) const noexcept {
-        return find(string_view(other, count), pos);
+    string_slice operator[](std::initializer_list<difference_type> signed_offsets) const noexcept {
+        assert(signed_offsets.size() == 2 && "operator[] can't take more than 2 offsets");
+        return sub(signed_offsets.begin()[0], signed_offsets.begin()[1]);
     }
 
     /**
-     *  @brief  Find the last occurrence of a substring.
-     *  @return The offset of the first character of the match, or `npos` if not found.
+     *  @brief  Signed alternative to `at()`. Handy if you often write `str[str.size() - 2]`.
+     *  @warning The behavior is @b undefined if the position is beyond bounds.
      */
-    size_type rfind(string_view other) const noexcept {
-        auto ptr = sz_rfind(start_, length_, other.start_, other.length_);
-        return ptr ? ptr - start_ : npos;
+    reference sat(difference_type signed_offset) const noexcept {
+        size_type pos = (signed_offset < 0) ? size() + signed_offset : signed_offset;
+        assert(pos < size() && "string_slice::sat(i) out of bounds");
+        return start_[pos];
     }
 
     /**
-     *  @brief  Find the last occurrence of a substring, within first `until` characters.
-     *  @return The offset of the first character of the match, or `npos` if not found.
+     *  @brief  The opposite operation to `remove_prefix`, that does no bounds checking.
+     *  @warning The behavior is @b undefined if `n > size()`.
      */
-    size_type rfind(string_view other, size_type until) const noexcept(false) {
-        return until + other.size() < length_ ? substr(0, until + other.size()).rfind(other) : rfind(other);
+    string_slice front(size_type n) const noexcept {
+        assert(n <= size() && "string_slice::front(n) out of bounds");
+        return {start_, n};
     }
 
     /**
-     *  @brief  Find the last occurrence of a character.
-     *  @return The offset of the match, or `npos` if not found.
+     *  @brief  The opposite operation to `remove_prefix`, that does no bounds checking.
+     *  @warning The behavior is @b undefined if `n > size()`.
      */
-    size_type rfind(value_type character) const noexcept {
-        auto ptr = sz_rfind_byte(start_, length_, &character);
-        return ptr ? ptr - start_ : npos;
+    string_slice back(size_type n) const noexcept {
+        assert(n <= size() && "string_slice::back(n) out of bounds");
+        return {start_ + length_ - n, n};
     }
 
     /**
-     *  @brief  Find the last occurrence of a character, within first `until` characters.
-     *  @return The offset of the match, or `npos` if not found.
+     *  @brief  Equivalent to Python's `"abc"[-3:-1]`. Exception-safe, unlike STL's `substr`.
+     *          Supports signed and unsigned intervals.
      */
-    size_type rfind(value_type character, size_type until) const noexcept {
-        return until < length_ ? substr(0, until + 1).rfind(character) : rfind(character);
+    string_slice sub(difference_type signed_start_offset, difference_type signed_end_offset = npos) const noexcept {
+        sz_size_t normalized_offset, normalized_length;
+        sz_ssize_clamp_interval(length_, signed_start_offset, signed_end_offset, &normalized_offset,
+                                &normalized_length);
+        return string_slice(start_ + normalized_offset, normalized_length);
     }
 
     /**
-     *  @brief  Find the last occurrence of a substring, within first `until` characters.
-     *  @return The offset of the first character of the match, or `npos` if not found.
+     *  @brief  Exports this entire view. Not an STL function, but useful for concatenations.
+     *          The STL variant expects at least two arguments.
      */
-    size_type rfind(const_pointer other, size_type until, size_type count) const noexcept {
-        return rfind(string_view(other, count), until);
+    size_type copy(value_type *destination) const noexcept {
+        sz_copy((sz_ptr_t)destination, start_, length_);
+        return length_;
     }
 
-    /**  @brief  Find the first occurrence of a character from a set. */
-    size_type find(char_set set) const noexcept { return find_first_of(set); }
-
-    /**  @brief  Find the last occurrence of a character from a set. */
-    size_type rfind(char_set set) const noexcept { return find_last_of(set); }
-
-#pragma endregion
-#pragma region Returning Partitions
-
-    /**  @brief  Split the string into three parts, before the match, the match itself, and after it. */
-    partition_type partition(string_view pattern) const noexcept { return partition_(pattern, pattern.length()); }
-
-    /**  @brief  Split the string into three parts, before the match, the match itself, and after it. */
-    partition_type partition(char_set pattern) const noexcept { return partition_(pattern, 1); }
-
-    /**  @brief  Split the string into three parts, before the @b last match, the last match itself, and after it. */
-    partition_type rpartition(string_view pattern) const noexcept { return rpartition_(pattern, pattern.length()); }
-
-    /**  @brief  Split the string into three parts, before the @b last match, the last match itself, and after it. */
-    partition_type rpartition(char_set pattern) const noexcept { return rpartition_(pattern, 1); }
-
-#pragma endregion
 #pragma endregion
 
-#pragma region Matching Character Sets
-
-    // `isascii` is a macro in MSVC headers
-    bool contains_only(char_set set) const noexcept { return find_first_not_of(set) == npos; }
-    bool is_alpha() const noexcept { return !empty() && contains_only(ascii_letters_set()); }
-    bool is_alnum() const noexcept { return !empty() && contains_only(ascii_letters_set() | digits_set()); }
-    bool is_ascii() const noexcept { return empty() || contains_only(ascii_controls_set() | ascii_printables_set()); }
-    bool is_digit() const noexcept { return !empty() && contains_only(digits_set()); }
-    bool is_lower() const noexcept { return !empty() && contains_only(ascii_lowercase_set()); }
-    bool is_space() const noexcept { return !empty() && contains_only(whitespaces_set()); }
-    bool is_upper() const noexcept { return !empty() && contains_only(ascii_uppercase_set()); }
-    bool is_printable() const noexcept { return empty() || contains_only(ascii_printables_set()); }
+#pragma region STL Style
 
-#pragma region Character Set Arguments
     /**
-     *  @brief  Find the first occurrence of a character from a set.
-     *  @param  skip Number of characters to skip before the search.
-     *  @warning The behavior is @b undefined if `skip > size()`.
+     *  @brief  Removes the first `n` characters from the view.
+     *  @warning The behavior is @b undefined if `n > size()`.
      */
-    size_type find_first_of(char_set set, size_type skip = 0) const noexcept {
-        auto ptr = sz_find_charset(start_ + skip, length_ - skip, &set.raw());
-        return ptr ? ptr - start_ : npos;
-    }
+    void remove_prefix(size_type n) noexcept { assert(n <= size()), start_ += n, length_ -= n; }
 
     /**
-     *  @brief  Find the first occurrence of a character outside a set.
-     *  @param  skip  The number of first characters to be skipped.
-     *  @warning The behavior is @b undefined if `skip > size()`.
+     *  @brief  Removes the last `n` characters from the view.
+     *  @warning The behavior is @b undefined if `n > size()`.
      */
-    size_type find_first_not_of(char_set set, size_type skip = 0) const noexcept {
-        return find_first_of(set.inverted(), skip);
-    }
+    void remove_suffix(size_type n) noexcept { assert(n <= size()), length_ -= n; }
 
-    /**
-     *  @brief  Find the last occurrence of a character from a set.
-     */
-    size_type find_last_of(char_set set) const noexcept {
-        auto ptr = sz_rfind_charset(start_, length_, &set.raw());
-        return ptr ? ptr - start_ : npos;
-    }
+    /**  @brief  Added for STL compatibility. */
+    string_slice substr() const noexcept { return *this; }
 
     /**
-     *  @brief  Find the last occurrence of a character outside a set.
+     *  @brief  Return a slice of this view after first `skip` bytes.
+     *  @throws `std::out_of_range` if `skip > size()`.
+     *  @see    `sub` for a cleaner exception-less alternative.
      */
-    size_type find_last_not_of(char_set set) const noexcept { return find_last_of(set.inverted()); }
+    string_slice substr(size_type skip) const noexcept(false) {
+        if (skip > size()) throw std::out_of_range("string_slice::substr");
+        return string_slice(start_ + skip, length_ - skip);
+    }
 
     /**
-     *  @brief  Find the last occurrence of a character from a set.
-     *  @param  until  The offset of the last character to be considered.
+     *  @brief  Return a slice of this view after first `skip` bytes, taking at most `count` bytes.
+     *  @throws `std::out_of_range` if `skip > size()`.
+     *  @see    `sub` for a cleaner exception-less alternative.
      */
-    size_type find_last_of(char_set set, size_type until) const noexcept {
-        auto len = sz_min_of_two(until + 1, length_);
-        auto ptr = sz_rfind_charset(start_, len, &set.raw());
-        return ptr ? ptr - start_ : npos;
+    string_slice substr(size_type skip, size_type count) const noexcept(false) {
+        if (skip > size()) throw std::out_of_range("string_slice::substr");
+        return string_slice(start_ + skip, sz_min_of_two(count, length_ - skip));
     }
 
     /**
-     *  @brief  Find the last occurrence of a character outside a set.
-     *  @param  until  The offset of the last character to be considered.
+     *  @brief  Exports a slice of this view after first `skip` bytes, taking at most `count` bytes.
+     *  @throws `std::out_of_range` if `skip > size()`.
+     *  @see    `sub` for a cleaner exception-less alternative.
      */
-    size_type find_last_not_of(char_set set, size_type until) const noexcept {
-        return find_last_of(set.inverted(), until);
+    size_type copy(value_type *destination, size_type count, size_type skip = 0) const noexcept(false) {
+        if (skip > size()) throw std::out_of_range("string_slice::copy");
+        count = sz_min_of_two(count, length_ - skip);
+        sz_copy((sz_ptr_t)destination, start_ + skip, count);
+        return count;
     }
 
 #pragma endregion
-#pragma region String Arguments
+
+#pragma endregion
+
+#pragma region Comparisons
+
+#pragma region Whole String Comparisons
 
     /**
-     *  @brief  Find the first occurrence of a character from a ::set.
-     *  @param  skip  The number of first characters to be skipped.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
      */
-    size_type find_first_of(string_view other, size_type skip = 0) const noexcept {
-        return find_first_of(other.as_set(), skip);
+    int compare(string_view other) const noexcept {
+        return (int)sz_order(start_, length_, other.start_, other.length_);
     }
 
     /**
-     *  @brief  Find the first occurrence of a character outside a ::set.
-     *  @param  skip  The number of first characters to be skipped.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *          Equivalent to `substr(pos1, count1).compare(other)`.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
+     *  @throw  `std::out_of_range` if `pos1 > size()`.
      */
-    size_type find_first_not_of(string_view other, size_type skip = 0) const noexcept {
-        return find_first_not_of(other.as_set(), skip);
+    int compare(size_type pos1, size_type count1, string_view other) const noexcept(false) {
+        return substr(pos1, count1).compare(other);
     }
 
     /**
-     *  @brief  Find the last occurrence of a character from a ::set.
-     *  @param  until  The offset of the last character to be considered.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *          Equivalent to `substr(pos1, count1).compare(other.substr(pos2, count2))`.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
+     *  @throw  `std::out_of_range` if `pos1 > size()` or if `pos2 > other.size()`.
      */
-    size_type find_last_of(string_view other, size_type until = npos) const noexcept {
-        return find_last_of(other.as_set(), until);
+    int compare(size_type pos1, size_type count1, string_view other, size_type pos2, size_type count2) const
+        noexcept(false) {
+        return substr(pos1, count1).compare(other.substr(pos2, count2));
     }
 
     /**
-     *  @brief  Find the last occurrence of a character outside a ::set.
-     *  @param  until  The offset of the last character to be considered.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
      */
-    size_type find_last_not_of(string_view other, size_type until = npos) const noexcept {
-        return find_last_not_of(other.as_set(), until);
-    }
-
-#pragma endregion
-#pragma region C-Style Arguments
+    int compare(const_pointer other) const noexcept { return compare(string_view(other)); }
 
     /**
-     *  @brief  Find the first occurrence of a character from a set.
-     *  @param  skip  The number of first characters to be skipped.
-     *  @warning The behavior is @b undefined if `skip > size()`.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *          Equivalent to substr(pos1, count1).compare(other).
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
+     *  @throw  `std::out_of_range` if `pos1 > size()`.
      */
-    size_type find_first_of(const_pointer other, size_type skip, size_type count) const noexcept {
-        return find_first_of(string_view(other, count), skip);
+    int compare(size_type pos1, size_type count1, const_pointer other) const noexcept(false) {
+        return substr(pos1, count1).compare(string_view(other));
     }
 
     /**
-     *  @brief  Find the first occurrence of a character outside a set.
-     *  @param  skip  The number of first characters to be skipped.
-     *  @warning The behavior is @b undefined if `skip > size()`.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *          Equivalent to `substr(pos1, count1).compare({s, count2})`.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
+     *  @throw  `std::out_of_range` if `pos1 > size()`.
      */
-    size_type find_first_not_of(const_pointer other, size_type skip, size_type count) const noexcept {
-        return find_first_not_of(string_view(other, count), skip);
+    int compare(size_type pos1, size_type count1, const_pointer other, size_type count2) const noexcept(false) {
+        return substr(pos1, count1).compare(string_view(other, count2));
     }
 
-    /**
-     *  @brief  Find the last occurrence of a character from a set.
-     *  @param  until  The number of first characters to be considered.
-     */
-    size_type find_last_of(const_pointer other, size_type until, size_type count) const noexcept {
-        return find_last_of(string_view(other, count), until);
+    /**  @brief  Checks if the string is equal to the other string. */
+    bool operator==(string_view other) const noexcept {
+        return size() == other.size() && sz_equal(data(), other.data(), other.size()) == sz_true_k;
     }
 
-    /**
-     *  @brief  Find the last occurrence of a character outside a set.
-     *  @param  until  The number of first characters to be considered.
-     */
-    size_type find_last_not_of(const_pointer other, size_type until, size_type count) const noexcept {
-        return find_last_not_of(string_view(other, count), until);
+    /**  @brief  Checks if the string is equal to a concatenation of two strings. */
+    bool operator==(concatenation<string_view, string_view> const &other) const noexcept {
+        return size() == other.size() && sz_equal(data(), other.first.data(), other.first.size()) == sz_true_k &&
+               sz_equal(data() + other.first.size(), other.second.data(), other.second.size()) == sz_true_k;
     }
 
-#pragma endregion
-#pragma region Slicing
+#if SZ_DETECT_CPP20
 
-    /**
-     *  @brief  Python-like convenience function, dropping prefix formed of given characters.
-     *          Similar to `boost::algorithm::trim_left_if(str, is_any_of(set))`.
-     */
-    string_slice lstrip(char_set set) const noexcept {
-        set = set.inverted();
-        auto new_start = sz_find_charset(start_, length_, &set.raw());
-        return new_start ? string_slice {new_start, length_ - static_cast<size_type>(new_start - start_)}
-                         : string_slice();
+    /**  @brief  Computes the lexicographic ordering between this and the ::other string. */
+    std::strong_ordering operator<=>(string_view other) const noexcept {
+        std::strong_ordering orders[3] {std::strong_ordering::less, std::strong_ordering::equal,
+                                        std::strong_ordering::greater};
+        return orders[compare(other) + 1];
     }
 
-    /**
-     *  @brief  Python-like convenience function, dropping suffix formed of given characters.
-     *          Similar to `boost::algorithm::trim_right_if(str, is_any_of(set))`.
-     */
-    string_slice rstrip(char_set set) const noexcept {
-        set = set.inverted();
-        auto new_end = sz_rfind_charset(start_, length_, &set.raw());
-        return new_end ? string_slice {start_, static_cast<size_type>(new_end - start_ + 1)} : string_slice();
-    }
+#else
 
-    /**
-     *  @brief  Python-like convenience function, dropping both the prefix & the suffix formed of given characters.
-     *          Similar to `boost::algorithm::trim_if(str, is_any_of(set))`.
-     */
-    string_slice strip(char_set set) const noexcept {
-        set = set.inverted();
-        auto new_start = sz_find_charset(start_, length_, &set.raw());
-        return new_start ? string_slice {new_start,
-                                         static_cast<size_type>(
-                                             sz_rfind_charset(new_start, length_ - (new_start - start_), &set.raw()) -
-                                             new_start + 1)}
-                         : string_slice();
-    }
+    /**  @brief  Checks if the string is not equal to the other string. */
+    bool operator!=(string_view other) const noexcept { return !operator==(other); }
 
-#pragma endregion
-#pragma endregion
+    /**  @brief  Checks if the string is lexicographically smaller than the other string. */
+    bool operator<(string_view other) const noexcept { return compare(other) == sz_less_k; }
 
-#pragma region Search Ranges
+    /**  @brief  Checks if the string is lexicographically equal or smaller than the other string. */
+    bool operator<=(string_view other) const noexcept { return compare(other) != sz_greater_k; }
 
-    using find_all_type = range_matches<string_slice, matcher_find<string_view, include_overlaps_type>>;
-    using rfind_all_type = range_rmatches<string_slice, matcher_rfind<string_view, include_overlaps_type>>;
+    /**  @brief  Checks if the string is lexicographically greater than the other string. */
+    bool operator>(string_view other) const noexcept { return compare(other) == sz_greater_k; }
 
-    using find_disjoint_type = range_matches<string_slice, matcher_find<string_view, exclude_overlaps_type>>;
-    using rfind_disjoint_type = range_rmatches<string_slice, matcher_rfind<string_view, exclude_overlaps_type>>;
+    /**  @brief  Checks if the string is lexicographically equal or greater than the other string. */
+    bool operator>=(string_view other) const noexcept { return compare(other) != sz_less_k; }
 
-    using find_all_chars_type = range_matches<string_slice, matcher_find_first_of<string_view, char_set>>;
-    using rfind_all_chars_type = range_rmatches<string_slice, matcher_find_last_of<string_view, char_set>>;
+#endif
 
-    /**  @brief  Find all potentially @b overlapping occurrences of a given string. */
-    find_all_type find_all(string_view needle, include_overlaps_type = {}) const noexcept { return {*this, needle}; }
+#pragma endregion
+#pragma region Prefix and Suffix Comparisons
 
-    /**  @brief  Find all potentially @b overlapping occurrences of a given string in @b reverse order. */
-    rfind_all_type rfind_all(string_view needle, include_overlaps_type = {}) const noexcept { return {*this, needle}; }
+    /**  @brief  Checks if the string starts with the other string. */
+    bool starts_with(string_view other) const noexcept {
+        return length_ >= other.length_ && sz_equal(start_, other.start_, other.length_) == sz_true_k;
+    }
 
-    /**  @brief  Find all @b non-overlapping occurrences of a given string. */
-    find_disjoint_type find_all(string_view needle, exclude_overlaps_type) const noexcept { return {*this, needle}; }
+    /**  @brief  Checks if the string starts with the other string. */
+    bool starts_with(const_pointer other) const noexcept {
+        auto other_length = null_terminated_length(other);
+        return length_ >= other_length && sz_equal(start_, other, other_length) == sz_true_k;
+    }
 
-    /**  @brief  Find all @b non-overlapping occurrences of a given string in @b reverse order. */
-    rfind_disjoint_type rfind_all(string_view needle, exclude_overlaps_type) const noexcept { return {*this, needle}; }
+    /**  @brief  Checks if the string starts with the other character. */
+    bool starts_with(value_type other) const noexcept { return length_ && start_[0] == other; }
 
-    /**  @brief  Find all occurrences of given characters. */
-    find_all_chars_type find_all(char_set set) const noexcept { return {*this, {set}}; }
+    /**  @brief  Checks if the string ends with the other string. */
+    bool ends_with(string_view other) const noexcept {
+        return length_ >= other.length_ &&
+               sz_equal(start_ + length_ - other.length_, other.start_, other.length_) == sz_true_k;
+    }
 
-    /**  @brief  Find all occurrences of given characters in @b reverse order. */
-    rfind_all_chars_type rfind_all(char_set set) const noexcept { return {*this, {set}}; }
+    /**  @brief  Checks if the string ends with the other string. */
+    bool ends_with(const_pointer other) const noexcept {
+        auto other_length = null_terminated_length(other);
+        return length_ >= other_length && sz_equal(start_ + length_ - other_length, other, other_length) == sz_true_k;
+    }
 
-    using split_type = range_splits<string_slice, matcher_find<string_view, exclude_overlaps_type>>;
-    using rsplit_type = range_rsplits<string_slice, matcher_rfind<string_view, exclude_overlaps_type>>;
+    /**  @brief  Checks if the string ends with the other character. */
+    bool ends_with(value_type other) const noexcept { return length_ && start_[length_ - 1] == other; }
 
-    using split_chars_type = range_splits<string_slice, matcher_find_first_of<string_view, char_set>>;
-    using rsplit_chars_type = range_rsplits<string_slice, matcher_find_last_of<string_view, char_set>>;
+    /**  @brief  Python-like convenience function, dropping the matching prefix. */
+    string_slice remove_prefix(string_view other) const noexcept {
+        return starts_with(other) ? string_slice {start_ + other.length_, length_ - other.length_} : *this;
+    }
 
-    /**  @brief  Split around occurrences of a given string. */
-    split_type split(string_view delimiter) const noexcept { return {*this, delimiter}; }
+    /**  @brief  Python-like convenience function, dropping the matching suffix. */
+    string_slice remove_suffix(string_view other) const noexcept {
+        return ends_with(other) ? string_slice {start_, length_ - other.length_} : *this;
+    }
 
-    /**  @brief  Split around occurrences of a given string in @b reverse order. */
-    rsplit_type rsplit(string_view delimiter) const noexcept { return {*this, delimiter}; }
+#pragma endregion
+#pragma endregion
 
-    /**  @brief  Split around occurrences of given characters. */
-    split_chars_type split(char_set set = whitespaces_set()) const noexcept { return {*this, {set}}; }
+#pragma region Matching Substrings
 
-    /**  @brief  Split around occurrences of given characters in @b reverse order. */
-    rsplit_chars_type rsplit(char_set set = whitespaces_set()) const noexcept { return {*this, {set}}; }
+    bool contains(string_view other) const noexcept { return find(other) != npos; }
+    bool contains(value_type character) const noexcept { return find(character) != npos; }
+    bool contains(const_pointer other) const noexcept { return find(other) != npos; }
 
-    /**  @brief  Split around the occurrences of all newline characters. */
-    split_chars_type splitlines() const noexcept { return split(newlines_set); }
+#pragma region Returning offsets
 
-#pragma endregion
+    /**
+     *  @brief  Find the first occurrence of a substring, skipping the first `skip` characters.
+     *          The behavior is @b undefined if `skip > size()`.
+     *  @return The offset of the first character of the match, or `npos` if not found.
+     */
+    size_type find(string_view other, size_type skip = 0) const noexcept {
+        auto ptr = sz_find(start_ + skip, length_ - skip, other.start_, other.length_);
+        return ptr ? ptr - start_ : npos;
+    }
 
-    /**  @brief  Hashes the string, equivalent to `std::hash<string_view>{}(str)`. */
-    size_type hash() const noexcept { return static_cast<size_type>(sz_hash(start_, length_)); }
+    /**
+     *  @brief  Find the first occurrence of a character, skipping the first `skip` characters.
+     *          The behavior is @b undefined if `skip > size()`.
+     *  @return The offset of the match, or `npos` if not found.
+     */
+    size_type find(value_type character, size_type skip = 0) const noexcept {
+        auto ptr = sz_find_byte(start_ + skip, length_ - skip, &character);
+        return ptr ? ptr - start_ : npos;
+    }
 
-    /**  @brief  Populate a character set with characters present in this string. */
-    char_set as_set() const noexcept {
-        char_set set;
-        for (auto c : *this) set.add(c);
-        return set;
+    /**
+     *  @brief  Find the first occurrence of a substring, skipping the first `skip` characters.
+     *          The behavior is @b undefined if `skip > size()`.
+     *  @return The offset of the first character of the match, or `npos` if not found.
+     */
+    size_type find(const_pointer other, size_type pos, size_type count) const noexcept {
+        return find(string_view(other, count), pos);
     }
 
-  private:
-    sz_constexpr_if_cpp20 string_view &assign(string_view const &other) noexcept {
-        start_ = other.start_;
-        length_ = other.length_;
-        return *this;
+    /**
+     *  @brief  Find the last occurrence of a substring.
+     *  @return The offset of the first character of the match, or `npos` if not found.
+     */
+    size_type rfind(string_view other) const noexcept {
+        auto ptr = sz_rfind(start_, length_, other.start_, other.length_);
+        return ptr ? ptr - start_ : npos;
     }
 
-    sz_constexpr_if_cpp20 static size_type null_terminated_length(const_pointer s) noexcept {
-        const_pointer p = s;
-        while (*p) ++p;
-        return p - s;
+    /**
+     *  @brief  Find the last occurrence of a substring, within first `until` characters.
+     *  @return The offset of the first character of the match, or `npos` if not found.
+     */
+    size_type rfind(string_view other, size_type until) const noexcept(false) {
+        return until + other.size() < length_ ? substr(0, until + other.size()).rfind(other) : rfind(other);
     }
 
-    template <typename pattern_>
-    partition_type partition_(pattern_ &&pattern, std::size_t pattern_length) const noexcept {
-        size_type pos = find(pattern);
-        if (pos == npos) return {*this, string_view(), string_view()};
-        return {string_view(start_, pos), string_view(start_ + pos, pattern_length),
-                string_view(start_ + pos + pattern_length, length_ - pos - pattern_length)};
+    /**
+     *  @brief  Find the last occurrence of a character.
+     *  @return The offset of the match, or `npos` if not found.
+     */
+    size_type rfind(value_type character) const noexcept {
+        auto ptr = sz_rfind_byte(start_, length_, &character);
+        return ptr ? ptr - start_ : npos;
     }
 
-    template <typename pattern_>
-    partition_type rpartition_(pattern_ &&pattern, std::size_t pattern_length) const noexcept {
-        size_type pos = rfind(pattern);
-        if (pos == npos) return {*this, string_view(), string_view()};
-        return {string_view(start_, pos), string_view(start_ + pos, pattern_length),
-                string_view(start_ + pos + pattern_length, length_ - pos - pattern_length)};
+    /**
+     *  @brief  Find the last occurrence of a character, within first `until` characters.
+     *  @return The offset of the match, or `npos` if not found.
+     */
+    size_type rfind(value_type character, size_type until) const noexcept {
+        return until < length_ ? substr(0, until + 1).rfind(character) : rfind(character);
     }
-};
+
+    /**
+     *  @brief  Find the last occurrence of a substring, within first `until` characters.
+     *  @return The offset of the first character of the match, or `npos` if not found.
+     */
+    size_type rfind(const_pointer other, size_type until, size_type count) const noexcept {
+        return rfind(string_view(other, count), until);
+    }
+
+    /**  @brief  Find the first occurrence of a character from a set. */
+    size_type find(char_set set) const noexcept { return find_first_of(set); }
+
+    /**  @brief  Find the last occurrence of a character from a set. */
+    size_type rfind(char_set set) const noexcept { return find_last_of(set); }
 
 #pragma endregion
+#pragma region Returning Partitions
 
-/**
- *  @brief  Memory-owning string class with a Small String Optimization.
- *
- *  @section API
- *
- *  Some APIs are different from `basic_string_slice`:
- *      * `lstrip`, `rstrip`, `strip` modify the string in-place, instead of returning a new view.
- *      * `sat`, `sub`, and element access has non-const overloads returning references to mutable objects.
- *
- *  Functions defined for `basic_string`, but not present in `basic_string_slice`:
- *      * `replace`, `insert`, `erase`, `append`, `push_back`, `pop_back`, `resize`, `shrink_to_fit`... from STL,
- *      * `try_` exception-free "try" operations that returning non-zero values on succces,
- *      * `replace_all` and `erase_all` similar to Boost,
- *      * `edit_distance` - Levenshtein distance computation reusing the allocator,
- *      * `randomize`, `random` - for fast random string generation.
- *
- *  Functions defined for `basic_string_slice`, but not present in `basic_string`:
- *      * `[r]partition`, `[r]split`, `[r]find_all` missing to enforce lifetime on long operations.
- *      * `remove_prefix`, `remove_suffix` for now.
- *
- *  @section Exceptions
- *
- *  Default constructor is `constexpr`. Move constructor and move assignment operator are `noexcept`.
- *  Copy constructor and copy assignment operator are not! They may throw `std::bad_alloc` if the memory
- *  allocation fails. Similar to STL `std::out_of_range` if the position argument to some of the functions
- *  is out of bounds. Same as with STL, the bound checks are often assymetric, so pay attention to docs.
- *  If exceptions are disabled, on failure, `std::terminate` is called.
- */
-template <typename char_type_, typename allocator_type_ = std::allocator<char_type_>>
-class basic_string {
+    /**  @brief  Split the string into three parts, before the match, the match itself, and after it. */
+    partition_type partition(string_view pattern) const noexcept { return partition_(pattern, pattern.length()); }
 
-    static_assert(sizeof(char_type_) == 1, "Characters must be a single byte long");
-    static_assert(std::is_reference<char_type_>::value == false, "Characters can't be references");
-    static_assert(std::is_const<char_type_>::value == false, "Characters must be mutable");
+    /**  @brief  Split the string into three parts, before the match, the match itself, and after it. */
+    partition_type partition(char_set pattern) const noexcept { return partition_(pattern, 1); }
 
-    using char_type = char_type_;
-    using sz_alloc_type = sz_memory_allocator_t;
+    /**  @brief  Split the string into three parts, before the @b last match, the last match itself, and after it. */
+    partition_type rpartition(string_view pattern) const noexcept { return rpartition_(pattern, pattern.length()); }
 
-    sz_string_t string_;
+    /**  @brief  Split the string into three parts, before the @b last match, the last match itself, and after it. */
+    partition_type rpartition(char_set pattern) const noexcept { return rpartition_(pattern, 1); }
 
-    /**
-     *  Stateful allocators and their support in C++ strings is extremely error-prone by design.
-     *  Depending on traits like `propagate_on_container_copy_assignment` and `propagate_on_container_move_assignment`,
-     *  its state will be copied from one string to another. It goes against the design of most string constructors,
-     *  as they also receive allocator as the last argument!
-     */
-    static_assert(std::is_empty<allocator_type_>::value, "We currently only support stateless allocators");
+#pragma endregion
+#pragma endregion
 
-    template <typename allocator_callback>
-    static bool _with_alloc(allocator_callback &&callback) noexcept {
-        return ashvardanian::stringzilla::_with_alloc<allocator_type_>(callback);
-    }
+#pragma region Matching Character Sets
 
-    bool is_internal() const noexcept { return sz_string_is_on_stack(&string_); }
+    // `isascii` is a macro in MSVC headers
+    bool contains_only(char_set set) const noexcept { return find_first_not_of(set) == npos; }
+    bool is_alpha() const noexcept { return !empty() && contains_only(ascii_letters_set()); }
+    bool is_alnum() const noexcept { return !empty() && contains_only(ascii_letters_set() | digits_set()); }
+    bool is_ascii() const noexcept { return empty() || contains_only(ascii_controls_set() | ascii_printables_set()); }
+    bool is_digit() const noexcept { return !empty() && contains_only(digits_set()); }
+    bool is_lower() const noexcept { return !empty() && contains_only(ascii_lowercase_set()); }
+    bool is_space() const noexcept { return !empty() && contains_only(whitespaces_set()); }
+    bool is_upper() const noexcept { return !empty() && contains_only(ascii_uppercase_set()); }
+    bool is_printable() const noexcept { return empty() || contains_only(ascii_printables_set()); }
 
-    void init(std::size_t length, char_type value) noexcept(false) {
-        sz_ptr_t start;
-        if (!_with_alloc(
-                [&](sz_alloc_type &alloc) { return (start = sz_string_init_length(&string_, length, &alloc)); }))
-            throw std::bad_alloc();
-        sz_fill(start, length, *(sz_u8_t *)&value);
+#pragma region Character Set Arguments
+    /**
+     *  @brief  Find the first occurrence of a character from a set.
+     *  @param  skip Number of characters to skip before the search.
+     *  @warning The behavior is @b undefined if `skip > size()`.
+     */
+    size_type find_first_of(char_set set, size_type skip = 0) const noexcept {
+        auto ptr = sz_find_charset(start_ + skip, length_ - skip, &set.raw());
+        return ptr ? ptr - start_ : npos;
     }
 
-    void init(string_view other) noexcept(false) {
-        sz_ptr_t start;
-        if (!_with_alloc(
-                [&](sz_alloc_type &alloc) { return (start = sz_string_init_length(&string_, other.size(), &alloc)); }))
-            throw std::bad_alloc();
-        sz_copy(start, (sz_cptr_t)other.data(), other.size());
+    /**
+     *  @brief  Find the first occurrence of a character outside a set.
+     *  @param  skip  The number of first characters to be skipped.
+     *  @warning The behavior is @b undefined if `skip > size()`.
+     */
+    size_type find_first_not_of(char_set set, size_type skip = 0) const noexcept {
+        return find_first_of(set.inverted(), skip);
     }
 
-    void move(basic_string &other) noexcept {
-        // We can't just assign the other string state, as its start address may be somewhere else on the stack.
-        sz_ptr_t string_start;
-        sz_size_t string_length;
-        sz_size_t string_space;
-        sz_bool_t string_is_external;
-        sz_string_unpack(&other.string_, &string_start, &string_length, &string_space, &string_is_external);
-
-        // Acquire the old string's value bitwise
-        *(&string_) = *(&other.string_);
-        // Reposition the string start pointer to the stack if it fits.
-        // Ternary condition may be optimized to a branchless version.
-        string_.internal.start = string_is_external ? string_.internal.start : &string_.internal.chars[0];
-        sz_string_init(&other.string_); // Discard the other string.
+    /**
+     *  @brief  Find the last occurrence of a character from a set.
+     */
+    size_type find_last_of(char_set set) const noexcept {
+        auto ptr = sz_rfind_charset(start_, length_, &set.raw());
+        return ptr ? ptr - start_ : npos;
     }
 
-  public:
-    // STL compatibility
-    using traits_type = std::char_traits<char_type>;
-    using value_type = char_type;
-    using pointer = char_type *;
-    using const_pointer = char_type const *;
-    using reference = char_type &;
-    using const_reference = char_type const &;
-    using const_iterator = const_pointer;
-    using iterator = pointer;
-    using const_reverse_iterator = reversed_iterator_for<char_type const>;
-    using reverse_iterator = reversed_iterator_for<char_type>;
-    using size_type = std::size_t;
-    using difference_type = std::ptrdiff_t;
+    /**
+     *  @brief  Find the last occurrence of a character outside a set.
+     */
+    size_type find_last_not_of(char_set set) const noexcept { return find_last_of(set.inverted()); }
 
-    // Non-STL type definitions
-    using allocator_type = allocator_type_;
-    using string_span = basic_string_slice<char_type>;
-    using string_view = basic_string_slice<typename std::add_const<char_type>::type>;
-    using partition_type = string_partition_result<string_view>;
+    /**
+     *  @brief  Find the last occurrence of a character from a set.
+     *  @param  until  The offset of the last character to be considered.
+     */
+    size_type find_last_of(char_set set, size_type until) const noexcept {
+        auto len = sz_min_of_two(until + 1, length_);
+        auto ptr = sz_rfind_charset(start_, len, &set.raw());
+        return ptr ? ptr - start_ : npos;
+    }
 
-    /** @brief  Special value for missing matches.
-     *
-     *  We take the largest 63-bit unsigned integer on 64-bit machines.
-     *  We take the largest 31-bit unsigned integer on 32-bit machines.
+    /**
+     *  @brief  Find the last occurrence of a character outside a set.
+     *  @param  until  The offset of the last character to be considered.
      */
-    static constexpr size_type npos = SZ_SSIZE_MAX;
+    size_type find_last_not_of(char_set set, size_type until) const noexcept {
+        return find_last_of(set.inverted(), until);
+    }
 
-#pragma region Constructors and STL Utilities
+#pragma endregion
+#pragma region String Arguments
 
-    sz_constexpr_if_cpp20 basic_string() noexcept {
-        // ! Instead of relying on the `sz_string_init`, we have to reimplement it to support `constexpr`.
-        string_.internal.start = &string_.internal.chars[0];
-        string_.words[1] = 0;
-        string_.words[2] = 0;
-        string_.words[3] = 0;
+    /**
+     *  @brief  Find the first occurrence of a character from a ::set.
+     *  @param  skip  The number of first characters to be skipped.
+     */
+    size_type find_first_of(string_view other, size_type skip = 0) const noexcept {
+        return find_first_of(other.as_set(), skip);
     }
 
-    ~basic_string() noexcept {
-        _with_alloc([&](sz_alloc_type &alloc) {
-            sz_string_free(&string_, &alloc);
-            return true;
-        });
+    /**
+     *  @brief  Find the first occurrence of a character outside a ::set.
+     *  @param  skip  The number of first characters to be skipped.
+     */
+    size_type find_first_not_of(string_view other, size_type skip = 0) const noexcept {
+        return find_first_not_of(other.as_set(), skip);
     }
 
-    basic_string(basic_string &&other) noexcept { move(other); }
-    basic_string &operator=(basic_string &&other) noexcept {
-        if (!is_internal()) {
-            _with_alloc([&](sz_alloc_type &alloc) {
-                sz_string_free(&string_, &alloc);
-                return true;
-            });
-        }
-        move(other);
-        return *this;
+    /**
+     *  @brief  Find the last occurrence of a character from a ::set.
+     *  @param  until  The offset of the last character to be considered.
+     */
+    size_type find_last_of(string_view other, size_type until = npos) const noexcept {
+        return find_last_of(other.as_set(), until);
     }
 
-    basic_string(basic_string const &other) noexcept(false) { init(other); }
-    basic_string &operator=(basic_string const &other) noexcept(false) { return assign(other); }
-    basic_string(string_view view) noexcept(false) { init(view); }
-    basic_string &operator=(string_view view) noexcept(false) { return assign(view); }
-
-    basic_string(const_pointer c_string) noexcept(false) : basic_string(string_view(c_string)) {}
-    basic_string(const_pointer c_string, size_type length) noexcept(false)
-        : basic_string(string_view(c_string, length)) {}
-    basic_string &operator=(const_pointer other) noexcept(false) { return assign(string_view(other)); }
-
-    basic_string(std::nullptr_t) = delete;
+    /**
+     *  @brief  Find the last occurrence of a character outside a ::set.
+     *  @param  until  The offset of the last character to be considered.
+     */
+    size_type find_last_not_of(string_view other, size_type until = npos) const noexcept {
+        return find_last_not_of(other.as_set(), until);
+    }
 
-    /**  @brief  Construct a string by repeating a certain ::character ::count times. */
-    basic_string(size_type count, value_type character) noexcept(false) { init(count, character); }
+#pragma endregion
+#pragma region C-Style Arguments
 
-    basic_string(basic_string const &other, size_type pos) noexcept(false) { init(string_view(other).substr(pos)); }
-    basic_string(basic_string const &other, size_type pos, size_type count) noexcept(false) {
-        init(string_view(other).substr(pos, count));
+    /**
+     *  @brief  Find the first occurrence of a character from a set.
+     *  @param  skip  The number of first characters to be skipped.
+     *  @warning The behavior is @b undefined if `skip > size()`.
+     */
+    size_type find_first_of(const_pointer other, size_type skip, size_type count) const noexcept {
+        return find_first_of(string_view(other, count), skip);
     }
 
-    basic_string(std::initializer_list<value_type> list) noexcept(false) {
-        init(string_view(list.begin(), list.size()));
+    /**
+     *  @brief  Find the first occurrence of a character outside a set.
+     *  @param  skip  The number of first characters to be skipped.
+     *  @warning The behavior is @b undefined if `skip > size()`.
+     */
+    size_type find_first_not_of(const_pointer other, size_type skip, size_type count) const noexcept {
+        return find_first_not_of(string_view(other, count), skip);
     }
 
-    operator string_view() const noexcept { return view(); }
-    string_view view() const noexcept {
-        sz_ptr_t string_start;
-        sz_size_t string_length;
-        sz_string_range(&string_, &string_start, &string_length);
-        return {string_start, string_length};
+    /**
+     *  @brief  Find the last occurrence of a character from a set.
+     *  @param  until  The number of first characters to be considered.
+     */
+    size_type find_last_of(const_pointer other, size_type until, size_type count) const noexcept {
+        return find_last_of(string_view(other, count), until);
     }
 
-    operator string_span() noexcept { return span(); }
-    string_span span() noexcept {
-        sz_ptr_t string_start;
-        sz_size_t string_length;
-        sz_string_range(&string_, &string_start, &string_length);
-        return {string_start, string_length};
+    /**
+     *  @brief  Find the last occurrence of a character outside a set.
+     *  @param  until  The number of first characters to be considered.
+     */
+    size_type find_last_not_of(const_pointer other, size_type until, size_type count) const noexcept {
+        return find_last_not_of(string_view(other, count), until);
     }
 
-    /**  @brief Exchanges the string contents witt the `other` string. */
-    void swap(basic_string &other) noexcept {
-        // If at least one of the strings is on the stack, a basic `std::swap(string_, other.string_)` won't work,
-        // as the pointer to the stack-allocated memory will be swapped, instead of the contents.
-        sz_ptr_t first_start, second_start;
-        sz_size_t first_length, second_length;
-        sz_size_t first_space, second_space;
-        sz_bool_t first_is_external, second_is_external;
-        sz_string_unpack(&string_, &first_start, &first_length, &first_space, &first_is_external);
-        sz_string_unpack(&other.string_, &second_start, &second_length, &second_space, &second_is_external);
-        std::swap(string_, other.string_);
-        if (!first_is_external) other.string_.internal.start = &other.string_.internal.chars[0];
-        if (!second_is_external) string_.internal.start = &string_.internal.chars[0];
-    }
-
-#if !SZ_AVOID_STL
-
-    basic_string(std::string const &other) noexcept(false) : basic_string(other.data(), other.size()) {}
-    basic_string &operator=(std::string const &other) noexcept(false) { return assign({other.data(), other.size()}); }
-
-    // As we are need both `data()` and `size()`, going through `operator string_view()`
-    // and `sz_string_unpack` is faster than separate invocations.
-    operator std::string() const { return view(); }
+#pragma endregion
+#pragma region Slicing
 
     /**
-     *  @brief  Formatted output function for compatibility with STL's `std::basic_ostream`.
-     *  @throw  `std::ios_base::failure` if an exception occurred during output.
+     *  @brief  Python-like convenience function, dropping prefix formed of given characters.
+     *          Similar to `boost::algorithm::trim_left_if(str, is_any_of(set))`.
      */
-    template <typename stream_traits>
-    friend std::basic_ostream<value_type, stream_traits> &operator<<(std::basic_ostream<value_type, stream_traits> &os,
-                                                                     basic_string const &str) noexcept(false) {
-        return os.write(str.data(), str.size());
+    string_slice lstrip(char_set set) const noexcept {
+        set = set.inverted();
+        auto new_start = sz_find_charset(start_, length_, &set.raw());
+        return new_start ? string_slice {new_start, length_ - static_cast<size_type>(new_start - start_)}
+                         : string_slice();
     }
 
-#if SZ_DETECT_CPP_17 && __cpp_lib_string_view
-
-    basic_string(std::string_view other) noexcept(false) : basic_string(other.data(), other.size()) {}
-    basic_string &operator=(std::string_view other) noexcept(false) { return assign({other.data(), other.size()}); }
-    operator std::string_view() const noexcept { return view(); }
-
-#endif
-
-#endif
-
-    template <typename first_type, typename second_type>
-    explicit basic_string(concatenation<first_type, second_type> const &expression) noexcept(false) {
-        _with_alloc([&](sz_alloc_type &alloc) {
-            sz_ptr_t ptr = sz_string_init_length(&string_, expression.length(), &alloc);
-            if (!ptr) return false;
-            expression.copy(ptr);
-            return true;
-        });
+    /**
+     *  @brief  Python-like convenience function, dropping suffix formed of given characters.
+     *          Similar to `boost::algorithm::trim_right_if(str, is_any_of(set))`.
+     */
+    string_slice rstrip(char_set set) const noexcept {
+        set = set.inverted();
+        auto new_end = sz_rfind_charset(start_, length_, &set.raw());
+        return new_end ? string_slice {start_, static_cast<size_type>(new_end - start_ + 1)} : string_slice();
     }
 
-    template <typename first_type, typename second_type>
-    basic_string &operator=(concatenation<first_type, second_type> const &expression) noexcept(false) {
-        if (!try_assign(expression)) throw std::bad_alloc();
-        return *this;
+    /**
+     *  @brief  Python-like convenience function, dropping both the prefix & the suffix formed of given characters.
+     *          Similar to `boost::algorithm::trim_if(str, is_any_of(set))`.
+     */
+    string_slice strip(char_set set) const noexcept {
+        set = set.inverted();
+        auto new_start = sz_find_charset(start_, length_, &set.raw());
+        return new_start ? string_slice {new_start,
+                                         static_cast<size_type>(
+                                             sz_rfind_charset(new_start, length_ - (new_start - start_), &set.raw()) -
+                                             new_start + 1)}
+                         : string_slice();
     }
 
 #pragma endregion
+#pragma endregion
 
-#pragma region Iterators and Accessors
-
-    iterator begin() noexcept { return iterator(data()); }
-    const_iterator begin() const noexcept { return const_iterator(data()); }
-    const_iterator cbegin() const noexcept { return const_iterator(data()); }
-
-    // As we are need both `data()` and `size()`, going through `operator string_view()`
-    // and `sz_string_unpack` is faster than separate invocations.
-    iterator end() noexcept { return span().end(); }
-    const_iterator end() const noexcept { return view().end(); }
-    const_iterator cend() const noexcept { return view().end(); }
+#pragma region Search Ranges
 
-    reverse_iterator rbegin() noexcept { return span().rbegin(); }
-    const_reverse_iterator rbegin() const noexcept { return view().rbegin(); }
-    const_reverse_iterator crbegin() const noexcept { return view().crbegin(); }
+    using find_all_type = range_matches<string_slice, matcher_find<string_view, include_overlaps_type>>;
+    using rfind_all_type = range_rmatches<string_slice, matcher_rfind<string_view, include_overlaps_type>>;
 
-    reverse_iterator rend() noexcept { return span().rend(); }
-    const_reverse_iterator rend() const noexcept { return view().rend(); }
-    const_reverse_iterator crend() const noexcept { return view().crend(); }
+    using find_disjoint_type = range_matches<string_slice, matcher_find<string_view, exclude_overlaps_type>>;
+    using rfind_disjoint_type = range_rmatches<string_slice, matcher_rfind<string_view, exclude_overlaps_type>>;
 
-    reference operator[](size_type pos) noexcept { return string_.internal.start[pos]; }
-    const_reference operator[](size_type pos) const noexcept { return string_.internal.start[pos]; }
+    using find_all_chars_type = range_matches<string_slice, matcher_find_first_of<string_view, char_set>>;
+    using rfind_all_chars_type = range_rmatches<string_slice, matcher_find_last_of<string_view, char_set>>;
 
-    reference front() noexcept { return string_.internal.start[0]; }
-    const_reference front() const noexcept { return string_.internal.start[0]; }
-    reference back() noexcept { return string_.internal.start[size() - 1]; }
-    const_reference back() const noexcept { return string_.internal.start[size() - 1]; }
-    pointer data() noexcept { return string_.internal.start; }
-    const_pointer data() const noexcept { return string_.internal.start; }
-    pointer c_str() noexcept { return string_.internal.start; }
-    const_pointer c_str() const noexcept { return string_.internal.start; }
+    using find_all_fuzzy_type = range_matches<string_slice, matcher_find_fuzzy<string_view>>;
 
-    reference at(size_type pos) noexcept(false) {
-        if (pos >= size()) throw std::out_of_range("sz::basic_string::at");
-        return string_.internal.start[pos];
-    }
-    const_reference at(size_type pos) const noexcept(false) {
-        if (pos >= size()) throw std::out_of_range("sz::basic_string::at");
-        return string_.internal.start[pos];
-    }
+    /**  @brief  Find all potentially @b overlapping occurrences of a given string. */
+    find_all_type find_all(string_view needle, include_overlaps_type = {}) const noexcept { return {*this, needle}; }
 
-    difference_type ssize() const noexcept { return static_cast<difference_type>(size()); }
-    size_type size() const noexcept { return view().size(); }
-    size_type length() const noexcept { return size(); }
-    size_type max_size() const noexcept { return npos - 1; }
-    bool empty() const noexcept { return string_.external.length == 0; }
-    size_type capacity() const noexcept {
-        sz_ptr_t string_start;
-        sz_size_t string_length;
-        sz_size_t string_space;
-        sz_bool_t string_is_external;
-        sz_string_unpack(&string_, &string_start, &string_length, &string_space, &string_is_external);
-        return string_space - 1;
-    }
+    /**  @brief  Find all potentially @b overlapping occurrences of a given string in @b reverse order. */
+    rfind_all_type rfind_all(string_view needle, include_overlaps_type = {}) const noexcept { return {*this, needle}; }
 
-    allocator_type get_allocator() const noexcept { return {}; }
+    /**  @brief  Find all @b non-overlapping occurrences of a given string. */
+    find_disjoint_type find_all(string_view needle, exclude_overlaps_type) const noexcept { return {*this, needle}; }
 
-#pragma endregion
+    /**  @brief  Find all @b non-overlapping occurrences of a given string in @b reverse order. */
+    rfind_disjoint_type rfind_all(string_view needle, exclude_overlaps_type) const noexcept { return {*this, needle}; }
 
-#pragma region Slicing
+    /**  @brief  Find all occurrences of given characters. */
+    find_all_chars_type find_all(char_set set) const noexcept { return {*this, {set}}; }
 
-#pragma region Safe and Signed Extensions
+    /**  @brief  Find all occurrences of given characters in @b reverse order. */
+    rfind_all_chars_type rfind_all(char_set set) const noexcept { return {*this, {set}}; }
 
     /**
-     *  @brief  Equivalent to Python's `"abc"[-3:-1]`. Exception-safe, unlike STL's `substr`.
-     *          Supports signed and unsigned intervals.
+     *  @brief  Find all @b non-overlapping approximate occurrences of a given string with up to `max_edits`
+     *          Levenshtein edits, like the OCR-corrupted spellings of a word.
+     *  @see    sz_find_fuzzy
      */
-    string_view operator[](std::initializer_list<difference_type> offsets) const noexcept { return view()[offsets]; }
-    string_span operator[](std::initializer_list<difference_type> offsets) noexcept { return span()[offsets]; }
+    find_all_fuzzy_type find_all_fuzzy(string_view needle, size_type max_edits) const noexcept {
+        return {*this, {needle, max_edits}};
+    }
 
-    /**
-     *  @brief  Signed alternative to `at()`. Handy if you often write `str[str.size() - 2]`.
-     *  @warning The behavior is @b undefined if the position is beyond bounds.
-     */
-    value_type sat(difference_type offset) const noexcept { return view().sat(offset); }
-    reference sat(difference_type offset) noexcept { return span().sat(offset); }
+    using split_type = range_splits<string_slice, matcher_find<string_view, exclude_overlaps_type>>;
+    using rsplit_type = range_rsplits<string_slice, matcher_rfind<string_view, exclude_overlaps_type>>;
 
-    /**
-     *  @brief  The opposite operation to `remove_prefix`, that does no bounds checking.
-     *  @warning The behavior is @b undefined if `n > size()`.
-     */
-    string_view front(size_type n) const noexcept { return view().front(n); }
-    string_span front(size_type n) noexcept { return span().front(n); }
+    using split_chars_type = range_splits<string_slice, matcher_find_first_of<string_view, char_set>>;
+    using rsplit_chars_type = range_rsplits<string_slice, matcher_find_last_of<string_view, char_set>>;
 
-    /**
-     *  @brief  The opposite operation to `remove_prefix`, that does no bounds checking.
-     *  @warning The behavior is @b undefined if `n > size()`.
-     */
-    string_view back(size_type n) const noexcept { return view().back(n); }
-    string_span back(size_type n) noexcept { return span().back(n); }
+    /**  @brief  Split around occurrences of a given string. */
+    split_type split(string_view delimiter) const noexcept { return {*this, delimiter}; }
 
-    /**
-     *  @brief  Equivalent to Python's `"abc"[-3:-1]`. Exception-safe, unlike STL's `substr`.
-     *          Supports signed and unsigned intervals. @b Doesn't copy or allocate memory!
-     */
-    string_view sub(difference_type start, difference_type end = npos) const noexcept { return view().sub(start, end); }
-    string_span sub(difference_type start, difference_type end = npos) noexcept { return span().sub(start, end); }
+    /**  @brief  Split around occurrences of a given string in @b reverse order. */
+    rsplit_type rsplit(string_view delimiter) const noexcept { return {*this, delimiter}; }
 
-    /**
-     *  @brief  Exports this entire view. Not an STL function, but useful for concatenations.
-     *          The STL variant expects at least two arguments.
-     */
-    size_type copy(value_type *destination) const noexcept { return view().copy(destination); }
+    /**  @brief  Split around occurrences of given characters. */
+    split_chars_type split(char_set set = whitespaces_set()) const noexcept { return {*this, {set}}; }
+
+    /**  @brief  Split around occurrences of given characters in @b reverse order. */
+    rsplit_chars_type rsplit(char_set set = whitespaces_set()) const noexcept { return {*this, {set}}; }
+
+    /**  @brief  Split around the occurrences of all newline characters. */
+    split_chars_type splitlines() const noexcept { return split(newlines_set); }
 
 #pragma endregion
 
-#pragma region STL Style
+    /**  @brief  Hashes the string, equivalent to `std::hash<string_view>{}(str)`. */
+    size_type hash() const noexcept { return static_cast<size_type>(sz_hash(start_, length_)); }
 
-    /**
-     *  @brief  Removes the first `n` characters from the view.
-     *  @warning The behavior is @b undefined if `n > size()`.
-     */
-    void remove_prefix(size_type n) noexcept {
-        assert(n <= size());
-        sz_string_erase(&string_, 0, n);
+    /**  @brief  Populate a character set with characters present in this string. */
+    char_set as_set() const noexcept {
+        char_set set;
+        for (auto c : *this) set.add(c);
+        return set;
     }
 
-    /**
-     *  @brief  Removes the last `n` characters from the view.
-     *  @warning The behavior is @b undefined if `n > size()`.
-     */
-    void remove_suffix(size_type n) noexcept {
-        assert(n <= size());
-        sz_string_erase(&string_, size() - n, n);
+  private:
+    sz_constexpr_if_cpp20 string_view &assign(string_view const &other) noexcept {
+        start_ = other.start_;
+        length_ = other.length_;
+        return *this;
     }
 
-    /**  @brief  Added for STL compatibility. */
-    basic_string substr() const noexcept { return *this; }
-
-    /**
-     *  @brief  Return a slice of this view after first `skip` bytes.
-     *  @throws `std::out_of_range` if `skip > size()`.
-     *  @see    `sub` for a cleaner exception-less alternative.
-     */
-    basic_string substr(size_type skip) const noexcept(false) { return view().substr(skip); }
-
-    /**
-     *  @brief  Return a slice of this view after first `skip` bytes, taking at most `count` bytes.
-     *  @throws `std::out_of_range` if `skip > size()`.
-     *  @see    `sub` for a cleaner exception-less alternative.
-     */
-    basic_string substr(size_type skip, size_type count) const noexcept(false) { return view().substr(skip, count); }
+    sz_constexpr_if_cpp20 static size_type null_terminated_length(const_pointer s) noexcept {
+        const_pointer p = s;
+        while (*p) ++p;
+        return p - s;
+    }
 
-    /**
-     *  @brief  Exports a slice of this view after first `skip` bytes, taking at most `count` bytes.
-     *  @throws `std::out_of_range` if `skip > size()`.
-     *  @see    `sub` for a cleaner exception-less alternative.
-     */
-    size_type copy(value_type *destination, size_type count, size_type skip = 0) const noexcept(false) {
-        return view().copy(destination, count, skip);
+    template <typename pattern_>
+    partition_type partition_(pattern_ &&pattern, std::size_t pattern_length) const noexcept {
+        size_type pos = find(pattern);
+        if (pos == npos) return {*this, string_view(), string_view()};
+        return {string_view(start_, pos), string_view(start_ + pos, pattern_length),
+                string_view(start_ + pos + pattern_length, length_ - pos - pattern_length)};
     }
 
-#pragma endregion
+    template <typename pattern_>
+    partition_type rpartition_(pattern_ &&pattern, std::size_t pattern_length) const noexcept {
+        size_type pos = rfind(pattern);
+        if (pos == npos) return {*this, string_view(), string_view()};
+        return {string_view(start_, pos), string_view(start_ + pos, pattern_length),
+                string_view(start_ + pos + pattern_length, length_ - pos - pattern_length)};
+    }
+};
 
 #pragma endregion
 
-#pragma region Comparisons
+/**
+ *  @brief  Memory-owning string class with a Small String Optimization.
+ *
+ *  @section API
+ *
+ *  Some APIs are different from `basic_string_slice`:
+ *      * `lstrip`, `rstrip`, `strip` modify the string in-place, instead of returning a new view.
+ *      * `sat`, `sub`, and element access has non-const overloads returning references to mutable objects.
+ *
+ *  Functions defined for `basic_string`, but not present in `basic_string_slice`:
+ *      * `replace`, `insert`, `erase`, `append`, `push_back`, `pop_back`, `resize`, `shrink_to_fit`... from STL,
+ *      * `try_` exception-free "try" operations that returning non-zero values on succces,
+ *      * `replace_all` and `erase_all` similar to Boost,
+ *      * `edit_distance` - Levenshtein distance computation reusing the allocator,
+ *      * `randomize`, `random` - for fast random string generation.
+ *
+ *  Functions defined for `basic_string_slice`, but not present in `basic_string`:
+ *      * `[r]partition`, `[r]split`, `[r]find_all` missing to enforce lifetime on long operations.
+ *      * `remove_prefix`, `remove_suffix` for now.
+ *
+ *  @section Exceptions
+ *
+ *  Default constructor is `constexpr`. Move constructor and move assignment operator are `noexcept`.
+ *  Copy constructor and copy assignment operator are not! They may throw `std::bad_alloc` if the memory
+ *  allocation fails. Similar to STL `std::out_of_range` if the position argument to some of the functions
+ *  is out of bounds. Same as with STL, the bound checks are often assymetric, so pay attention to docs.
+ *  If exceptions are disabled, on failure, `std::terminate` is called.
+ */
+template <typename char_type_, typename allocator_type_ = std::allocator<char_type_>>
+class basic_string {
 
-#pragma region Whole String Comparisons
+    static_assert(sizeof(char_type_) == 1, "Characters must be a single byte long");
+    static_assert(std::is_reference<char_type_>::value == false, "Characters can't be references");
+    static_assert(std::is_const<char_type_>::value == false, "Characters must be mutable");
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     */
-    int compare(string_view other) const noexcept { return view().compare(other); }
+    using char_type = char_type_;
+    using sz_alloc_type = sz_memory_allocator_t;
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *          Equivalent to `substr(pos1, count1).compare(other)`.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     *  @throw  `std::out_of_range` if `pos1 > size()`.
-     */
-    int compare(size_type pos1, size_type count1, string_view other) const noexcept(false) {
-        return view().compare(pos1, count1, other);
-    }
+    sz_string_t string_;
 
     /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *          Equivalent to `substr(pos1, count1).compare(other.substr(pos2, count2))`.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     *  @throw  `std::out_of_range` if `pos1 > size()` or if `pos2 > other.size()`.
+     *  Stateful allocators and their support in C++ strings is extremely error-prone by design.
+     *  Depending on traits like `propagate_on_container_copy_assignment` and `propagate_on_container_move_assignment`,
+     *  its state will be copied from one string to another. It goes against the design of most string constructors,
+     *  as they also receive allocator as the last argument!
      */
-    int compare(size_type pos1, size_type count1, string_view other, size_type pos2, size_type count2) const
-        noexcept(false) {
-        return view().compare(pos1, count1, other, pos2, count2);
+    static_assert(std::is_empty<allocator_type_>::value, "We currently only support stateless allocators");
+
+    template <typename allocator_callback>
+    static bool _with_alloc(allocator_callback &&callback) noexcept {
+        return ashvardanian::stringzilla::_with_alloc<allocator_type_>(callback);
     }
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     */
-    int compare(const_pointer other) const noexcept { return view().compare(other); }
+    bool is_internal() const noexcept { return sz_string_is_on_stack(&string_); }
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *          Equivalent to substr(pos1, count1).compare(other).
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     *  @throw  `std::out_of_range` if `pos1 > size()`.
-     */
-    int compare(size_type pos1, size_type count1, const_pointer other) const noexcept(false) {
-        return view().compare(pos1, count1, other);
+    void init(std::size_t length, char_type value) noexcept(false) {
+        sz_ptr_t start;
+        if (!_with_alloc(
+                [&](sz_alloc_type &alloc) { return (start = sz_string_init_length(&string_, length, &alloc)); }))
+            throw std::bad_alloc();
+        sz_fill(start, length, *(sz_u8_t *)&value);
     }
 
-    /**
-     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
-     *          Equivalent to `substr(pos1, count1).compare({s, count2})`.
-     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
-     *  @throw  `std::out_of_range` if `pos1 > size()`.
-     */
-    int compare(size_type pos1, size_type count1, const_pointer other, size_type count2) const noexcept(false) {
-        return view().compare(pos1, count1, other, count2);
+    void init(string_view other) noexcept(false) {
+        sz_ptr_t start;
+        if (!_with_alloc(
+                [&](sz_alloc_type &alloc) { return (start = sz_string_init_length(&string_, other.size(), &alloc)); }))
+            throw std::bad_alloc();
+        sz_copy(start, (sz_cptr_t)other.data(), other.size());
     }
 
-    /**  @brief  Checks if the string is equal to the other string. */
-    bool operator==(basic_string const &other) const noexcept { return view() == other.view(); }
-    bool operator==(string_view other) const noexcept { return view() == other; }
-    bool operator==(const_pointer other) const noexcept { return view() == string_view(other); }
-
-#if SZ_DETECT_CPP20
-
-    /**  @brief  Computes the lexicographic ordering between this and the ::other string. */
-    std::strong_ordering operator<=>(basic_string const &other) const noexcept { return view() <=> other.view(); }
-    std::strong_ordering operator<=>(string_view other) const noexcept { return view() <=> other; }
-    std::strong_ordering operator<=>(const_pointer other) const noexcept { return view() <=> string_view(other); }
-
-#else
-
-    /**  @brief  Checks if the string is not equal to the other string. */
-    bool operator!=(string_view other) const noexcept { return !operator==(other); }
+    void move(basic_string &other) noexcept {
+        // We can't just assign the other string state, as its start address may be somewhere else on the stack.
+        sz_ptr_t string_start;
+        sz_size_t string_length;
+        sz_size_t string_space;
+        sz_bool_t string_is_external;
+        sz_string_unpack(&other.string_, &string_start, &string_length, &string_space, &string_is_external);
 
-    /**  @brief  Checks if the string is lexicographically smaller than the other string. */
-    bool operator<(string_view other) const noexcept { return compare(other) == sz_less_k; }
+        // Acquire the old string's value bitwise
+        *(&string_) = *(&other.string_);
+        // Reposition the string start pointer to the stack if it fits.
+        // Ternary condition may be optimized to a branchless version.
+        string_.internal.start = string_is_external ? string_.internal.start : &string_.internal.chars[0];
+        sz_string_init(&other.string_); // Discard the other string.
+    }
 
-    /**  @brief  Checks if the string is lexicographically equal or smaller than the other string. */
-    bool operator<=(string_view other) const noexcept { return compare(other) != sz_greater_k; }
+  public:
+    // STL compatibility
+    using traits_type = std::char_traits<char_type>;
+    using value_type = char_type;
+    using pointer = char_type *;
+    using const_pointer = char_type const *;
+    using reference = char_type &;
+    using const_reference = char_type const &;
+    using const_iterator = const_pointer;
+    using iterator = pointer;
+    using const_reverse_iterator = reversed_iterator_for<char_type const>;
+    using reverse_iterator = reversed_iterator_for<char_type>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
 
-    /**  @brief  Checks if the string is lexicographically greater than the other string. */
-    bool operator>(string_view other) const noexcept { return compare(other) == sz_greater_k; }
+    // Non-STL type definitions
+    using allocator_type = allocator_type_;
+    using string_span = basic_string_slice<char_type>;
+    using string_view = basic_string_slice<typename std::add_const<char_type>::type>;
+    using partition_type = string_partition_result<string_view>;
 
-    /**  @brief  Checks if the string is lexicographically equal or greater than the other string. */
-    bool operator>=(string_view other) const noexcept { return compare(other) != sz_less_k; }
+    /** @brief  Special value for missing matches.
+     *
+     *  We take the largest 63-bit unsigned integer on 64-bit machines.
+     *  We take the largest 31-bit unsigned integer on 32-bit machines.
+     */
+    static constexpr size_type npos = SZ_SSIZE_MAX;
 
-#endif
+#pragma region Constructors and STL Utilities
 
-#pragma endregion
-#pragma region Prefix and Suffix Comparisons
+    sz_constexpr_if_cpp20 basic_string() noexcept {
+        // ! Instead of relying on the `sz_string_init`, we have to reimplement it to support `constexpr`.
+        string_.internal.start = &string_.internal.chars[0];
+        string_.words[1] = 0;
+        string_.words[2] = 0;
+        string_.words[3] = 0;
+    }
 
-    /**  @brief  Checks if the string starts with the other string. */
-    bool starts_with(string_view other) const noexcept { return view().starts_with(other); }
+    ~basic_string() noexcept {
+        _with_alloc([&](sz_alloc_type &alloc) {
+            sz_string_free(&string_, &alloc);
+            return true;
+        });
+    }
 
-    /**  @brief  Checks if the string starts with the other string. */
-    bool starts_with(const_pointer other) const noexcept { return view().starts_with(other); }
+    basic_string(basic_string &&other) noexcept { move(other); }
+    basic_string &operator=(basic_string &&other) noexcept {
+        if (!is_internal()) {
+            _with_alloc([&](sz_alloc_type &alloc) {
+                sz_string_free(&string_, &alloc);
+                return true;
+            });
+        }
+        move(other);
+        return *this;
+    }
 
-    /**  @brief  Checks if the string starts with the other character. */
-    bool starts_with(value_type other) const noexcept { return view().starts_with(other); }
+    basic_string(basic_string const &other) noexcept(false) { init(other); }
+    basic_string &operator=(basic_string const &other) noexcept(false) { return assign(other); }
+    basic_string(string_view view) noexcept(false) { init(view); }
+    basic_string &operator=(string_view view) noexcept(false) { return assign(view); }
 
-    /**  @brief  Checks if the string ends with the other string. */
-    bool ends_with(string_view other) const noexcept { return view().ends_with(other); }
+    basic_string(const_pointer c_string) noexcept(false) : basic_string(string_view(c_string)) {}
+    basic_string(const_pointer c_string, size_type length) noexcept(false)
+        : basic_string(string_view(c_string, length)) {}
+    basic_string &operator=(const_pointer other) noexcept(false) { return assign(string_view(other)); }
 
-    /**  @brief  Checks if the string ends with the other string. */
-    bool ends_with(const_pointer other) const noexcept { return view().ends_with(other); }
+    basic_string(std::nullptr_t) = delete;
 
-    /**  @brief  Checks if the string ends with the other character. */
-    bool ends_with(value_type other) const noexcept { return view().ends_with(other); }
+    /**  @brief  Construct a string by repeating a certain ::character ::count times. */
+    basic_string(size_type count, value_type character) noexcept(false) { init(count, character); }
 
-#pragma endregion
-#pragma endregion
+    basic_string(basic_string const &other, size_type pos) noexcept(false) { init(string_view(other).substr(pos)); }
+    basic_string(basic_string const &other, size_type pos, size_type count) noexcept(false) {
+        init(string_view(other).substr(pos, count));
+    }
 
-#pragma region Matching Substrings
+    basic_string(std::initializer_list<value_type> list) noexcept(false) {
+        init(string_view(list.begin(), list.size()));
+    }
 
-    bool contains(string_view other) const noexcept { return view().contains(other); }
-    bool contains(value_type character) const noexcept { return view().contains(character); }
-    bool contains(const_pointer other) const noexcept { return view().contains(other); }
+    operator string_view() const noexcept { return view(); }
+    string_view view() const noexcept {
+        sz_ptr_t string_start;
+        sz_size_t string_length;
+        sz_string_range(&string_, &string_start, &string_length);
+        return {string_start, string_length};
+    }
 
-#pragma region Returning offsets
+    operator string_span() noexcept { return span(); }
+    string_span span() noexcept {
+        sz_ptr_t string_start;
+        sz_size_t string_length;
+        sz_string_range(&string_, &string_start, &string_length);
+        return {string_start, string_length};
+    }
 
-    /**
-     *  @brief  Find the first occurrence of a substring, skipping the first `skip` characters.
-     *          The behavior is @b undefined if `skip > size()`.
-     *  @return The offset of the first character of the match, or `npos` if not found.
-     */
-    size_type find(string_view other, size_type skip = 0) const noexcept { return view().find(other, skip); }
+    /**  @brief Exchanges the string contents witt the `other` string. */
+    void swap(basic_string &other) noexcept {
+        // If at least one of the strings is on the stack, a basic `std::swap(string_, other.string_)` won't work,
+        // as the pointer to the stack-allocated memory will be swapped, instead of the contents.
+        sz_ptr_t first_start, second_start;
+        sz_size_t first_length, second_length;
+        sz_size_t first_space, second_space;
+        sz_bool_t first_is_external, second_is_external;
+        sz_string_unpack(&string_, &first_start, &first_length, &first_space, &first_is_external);
+        sz_string_unpack(&other.string_, &second_start, &second_length, &second_space, &second_is_external);
+        std::swap(string_, other.string_);
+        if (!first_is_external) other.string_.internal.start = &other.string_.internal.chars[0];
+        if (!second_is_external) string_.internal.start = &string_.internal.chars[0];
+    }
 
-    /**
-     *  @brief  Find the first occurrence of a character, skipping the first `skip` characters.
-     *          The behavior is @b undefined if `skip > size()`.
-     *  @return The offset of the match, or `npos` if not found.
-     */
-    size_type find(value_type character, size_type skip = 0) const noexcept { return view().find(character, skip); }
+#if !SZ_AVOID_STL
+
+    basic_string(std::string const &other) noexcept(false) : basic_string(other.data(), other.size()) {}
+    basic_string &operator=(std::string const &other) noexcept(false) { return assign({other.data(), other.size()}); }
+
+    // As we are need both `data()` and `size()`, going through `operator string_view()`
+    // and `sz_string_unpack` is faster than separate invocations.
+    operator std::string() const { return view(); }
 
     /**
-     *  @brief  Find the first occurrence of a substring, skipping the first `skip` characters.
-     *          The behavior is @b undefined if `skip > size()`.
-     *  @return The offset of the first character of the match, or `npos` if not found.
+     *  @brief  Formatted output function for compatibility with STL's `std::basic_ostream`.
+     *  @throw  `std::ios_base::failure` if an exception occurred during output.
      */
-    size_type find(const_pointer other, size_type pos, size_type count) const noexcept {
-        return view().find(other, pos, count);
+    template <typename stream_traits>
+    friend std::basic_ostream<value_type, stream_traits> &operator<<(std::basic_ostream<value_type, stream_traits> &os,
+                                                                     basic_string const &str) noexcept(false) {
+        return os.write(str.data(), str.size());
     }
 
-    /**
-     *  @brief  Find the last occurrence of a substring.
-     *  @return The offset of the first character of the match, or `npos` if not found.
-     */
-    size_type rfind(string_view other) const noexcept { return view().rfind(other); }
+#if SZ_DETECT_CPP_17 && __cpp_lib_string_view
 
-    /**
-     *  @brief  Find the last occurrence of a substring, within first `until` characters.
-     *  @return The offset of the first character of the match, or `npos` if not found.
-     */
-    size_type rfind(string_view other, size_type until) const noexcept { return view().rfind(other, until); }
+    basic_string(std::string_view other) noexcept(false) : basic_string(other.data(), other.size()) {}
+    basic_string &operator=(std::string_view other) noexcept(false) { return assign({other.data(), other.size()}); }
+    operator std::string_view() const noexcept { return view(); }
 
-    /**
-     *  @brief  Find the last occurrence of a character.
-     *  @return The offset of the match, or `npos` if not found.
-     */
-    size_type rfind(value_type character) const noexcept { return view().rfind(character); }
+#endif
 
-    /**
-     *  @brief  Find the last occurrence of a character, within first `until` characters.
-     *  @return The offset of the match, or `npos` if not found.
-     */
-    size_type rfind(value_type character, size_type until) const noexcept { return view().rfind(character, until); }
+#endif
 
-    /**
-     *  @brief  Find the last occurrence of a substring, within first `until` characters.
-     *  @return The offset of the first character of the match, or `npos` if not found.
-     */
-    size_type rfind(const_pointer other, size_type until, size_type count) const noexcept {
-        return view().rfind(other, until, count);
+    template <typename first_type, typename second_type>
+    explicit basic_string(concatenation<first_type, second_type> const &expression) noexcept(false) {
+        _with_alloc([&](sz_alloc_type &alloc) {
+            sz_ptr_t ptr = sz_string_init_length(&string_, expression.length(), &alloc);
+            if (!ptr) return false;
+            expression.copy(ptr);
+            return true;
+        });
     }
 
-    /**  @brief  Find the first occurrence of a character from a set. */
-    size_type find(char_set set) const noexcept { return view().find(set); }
-
-    /**  @brief  Find the last occurrence of a character from a set. */
-    size_type rfind(char_set set) const noexcept { return view().rfind(set); }
+    template <typename first_type, typename second_type>
+    basic_string &operator=(concatenation<first_type, second_type> const &expression) noexcept(false) {
+        if (!try_assign(expression)) throw std::bad_alloc();
+        return *this;
+    }
 
 #pragma endregion
-#pragma endregion
 
-#pragma region Matching Character Sets
+#pragma region Iterators and Accessors
 
-    bool contains_only(char_set set) const noexcept { return find_first_not_of(set) == npos; }
-    bool is_alpha() const noexcept { return !empty() && contains_only(ascii_letters_set()); }
-    bool is_alnum() const noexcept { return !empty() && contains_only(ascii_letters_set() | digits_set()); }
-    bool is_ascii() const noexcept { return empty() || contains_only(ascii_controls_set() | ascii_printables_set()); }
-    bool is_digit() const noexcept { return !empty() && contains_only(digits_set()); }
-    bool is_lower() const noexcept { return !empty() && contains_only(ascii_lowercase_set()); }
-    bool is_space() const noexcept { return !empty() && contains_only(whitespaces_set()); }
-    bool is_upper() const noexcept { return !empty() && contains_only(ascii_uppercase_set()); }
-    bool is_printable() const noexcept { return empty() || contains_only(ascii_printables_set()); }
+    iterator begin() noexcept { return iterator(data()); }
+    const_iterator begin() const noexcept { return const_iterator(data()); }
+    const_iterator cbegin() const noexcept { return const_iterator(data()); }
 
-#pragma region Character Set Arguments
+    // As we are need both `data()` and `size()`, going through `operator string_view()`
+    // and `sz_string_unpack` is faster than separate invocations.
+    iterator end() noexcept { return span().end(); }
+    const_iterator end() const noexcept { return view().end(); }
+    const_iterator cend() const noexcept { return view().end(); }
+
+    reverse_iterator rbegin() noexcept { return span().rbegin(); }
+    const_reverse_iterator rbegin() const noexcept { return view().rbegin(); }
+    const_reverse_iterator crbegin() const noexcept { return view().crbegin(); }
+
+    reverse_iterator rend() noexcept { return span().rend(); }
+    const_reverse_iterator rend() const noexcept { return view().rend(); }
+    const_reverse_iterator crend() const noexcept { return view().crend(); }
+
+    reference operator[](size_type pos) noexcept { return string_.internal.start[pos]; }
+    const_reference operator[](size_type pos) const noexcept { return string_.internal.start[pos]; }
+
+    reference front() noexcept { return string_.internal.start[0]; }
+    const_reference front() const noexcept { return string_.internal.start[0]; }
+    reference back() noexcept { return string_.internal.start[size() - 1]; }
+    const_reference back() const noexcept { return string_.internal.start[size() - 1]; }
+    pointer data() noexcept { return string_.internal.start; }
+    const_pointer data() const noexcept { return string_.internal.start; }
+    pointer c_str() noexcept { return string_.internal.start; }
+    const_pointer c_str() const noexcept { return string_.internal.start; }
+
+    reference at(size_type pos) noexcept(false) {
+        if (pos >= size()) throw std::out_of_range("sz::basic_string::at");
+        return string_.internal.start[pos];
+    }
+    const_reference at(size_type pos) const noexcept(false) {
+        if (pos >= size()) throw std::out_of_range("sz::basic_string::at");
+        return string_.internal.start[pos];
+    }
+
+    difference_type ssize() const noexcept { return static_cast<difference_type>(size()); }
+    size_type size() const noexcept { return view().size(); }
+    size_type length() const noexcept { return size(); }
+    size_type max_size() const noexcept { return npos - 1; }
+    bool empty() const noexcept { return string_.external.length == 0; }
+    size_type capacity() const noexcept {
+        sz_ptr_t string_start;
+        sz_size_t string_length;
+        sz_size_t string_space;
+        sz_bool_t string_is_external;
+        sz_string_unpack(&string_, &string_start, &string_length, &string_space, &string_is_external);
+        return string_space - 1;
+    }
+
+    allocator_type get_allocator() const noexcept { return {}; }
+
+#pragma endregion
+
+#pragma region Slicing
+
+#pragma region Safe and Signed Extensions
 
     /**
-     *  @brief  Find the first occurrence of a character from a set.
-     *  @param  skip Number of characters to skip before the search.
-     *  @warning The behavior is @b undefined if `skip > size()`.
+     *  @brief  Equivalent to Python's `"abc"[-3:-1]`. Exception-safe, unlike STL's `substr`.
+     *          Supports signed and unsigned intervals.
      */
-    size_type find_first_of(char_set set, size_type skip = 0) const noexcept { return view().find_first_of(set, skip); }
+    string_view operator[](std::initializer_list<difference_type> offsets) const noexcept { return view()[offsets]; }
+    string_span operator[](std::initializer_list<difference_type> offsets) noexcept { return span()[offsets]; }
 
     /**
-     *  @brief  Find the first occurrence of a character outside a set.
-     *  @param  skip  The number of first characters to be skipped.
-     *  @warning The behavior is @b undefined if `skip > size()`.
+     *  @brief  Signed alternative to `at()`. Handy if you often write `str[str.size() - 2]`.
+     *  @warning The behavior is @b undefined if the position is beyond bounds.
      */
-    size_type find_first_not_of(char_set set, size_type skip = 0) const noexcept {
-        return view().find_first_not_of(set, skip);
-    }
+    value_type sat(difference_type offset) const noexcept { return view().sat(offset); }
+    reference sat(difference_type offset) noexcept { return span().sat(offset); }
 
     /**
-     *  @brief  Find the last occurrence of a character from a set.
+     *  @brief  The opposite operation to `remove_prefix`, that does no bounds checking.
+     *  @warning The behavior is @b undefined if `n > size()`.
      */
-    size_type find_last_of(char_set set) const noexcept { return view().find_last_of(set); }
+    string_view front(size_type n) const noexcept { return view().front(n); }
+    string_span front(size_type n) noexcept { return span().front(n); }
 
     /**
-     *  @brief  Find the last occurrence of a character outside a set.
+     *  @brief  The opposite operation to `remove_prefix`, that does no bounds checking.
+     *  @warning The behavior is @b undefined if `n > size()`.
      */
-    size_type find_last_not_of(char_set set) const noexcept { return view().find_last_not_of(set); }
+    string_view back(size_type n) const noexcept { return view().back(n); }
+    string_span back(size_type n) noexcept { return span().back(n); }
 
     /**
-     *  @brief  Find the last occurrence of a character from a set.
-     *  @param  until  The offset of the last character to be considered.
+     *  @brief  Equivalent to Python's `"abc"[-3:-1]`. Exception-safe, unlike STL's `substr`.
+     *          Supports signed and unsigned intervals. @b Doesn't copy or allocate memory!
      */
-    size_type find_last_of(char_set set, size_type until) const noexcept { return view().find_last_of(set, until); }
+    string_view sub(difference_type start, difference_type end = npos) const noexcept { return view().sub(start, end); }
+    string_span sub(difference_type start, difference_type end = npos) noexcept { return span().sub(start, end); }
 
     /**
-     *  @brief  Find the last occurrence of a character outside a set.
-     *  @param  until  The offset of the last character to be considered.
+     *  @brief  Exports this entire view. Not an STL function, but useful for concatenations.
+     *          The STL variant expects at least two arguments.
      */
-    size_type find_last_not_of(char_set set, size_type until) const noexcept {
-        return view().find_last_not_of(set, until);
-    }
+    size_type copy(value_type *destination) const noexcept { return view().copy(destination); }
 
 #pragma endregion
-#pragma region String Arguments
+
+#pragma region STL Style
 
     /**
-     *  @brief  Find the first occurrence of a character from a ::set.
-     *  @param  skip  The number of first characters to be skipped.
+     *  @brief  Removes the first `n` characters from the view.
+     *  @warning The behavior is @b undefined if `n > size()`.
      */
-    size_type find_first_of(string_view other, size_type skip = 0) const noexcept {
-        return view().find_first_of(other, skip);
+    void remove_prefix(size_type n) noexcept {
+        assert(n <= size());
+        sz_string_erase(&string_, 0, n);
     }
 
     /**
-     *  @brief  Find the first occurrence of a character outside a ::set.
-     *  @param  skip  The number of first characters to be skipped.
+     *  @brief  Removes the last `n` characters from the view.
+     *  @warning The behavior is @b undefined if `n > size()`.
      */
-    size_type find_first_not_of(string_view other, size_type skip = 0) const noexcept {
-        return view().find_first_not_of(other, skip);
+    void remove_suffix(size_type n) noexcept {
+        assert(n <= size());
+        sz_string_erase(&string_, size() - n, n);
     }
 
+    /**  @brief  Added for STL compatibility. */
+    basic_string substr() const noexcept { return *this; }
+
     /**
-     *  @brief  Find the last occurrence of a character from a ::set.
-     *  @param  until  The offset of the last character to be considered.
+     *  @brief  Return a slice of this view after first `skip` bytes.
+     *  @throws `std::out_of_range` if `skip > size()`.
+     *  @see    `sub` for a cleaner exception-less alternative.
      */
-    size_type find_last_of(string_view other, size_type until = npos) const noexcept {
-        return view().find_last_of(other, until);
-    }
+    basic_string substr(size_type skip) const noexcept(false) { return view().substr(skip); }
 
     /**
-     *  @brief  Find the last occurrence of a character outside a ::set.
-     *  @param  until  The offset of the last character to be considered.
+     *  @brief  Return a slice of this view after first `skip` bytes, taking at most `count` bytes.
+     *  @throws `std::out_of_range` if `skip > size()`.
+     *  @see    `sub` for a cleaner exception-less alternative.
      */
-    size_type find_last_not_of(string_view other, size_type until = npos) const noexcept {
-        return view().find_last_not_of(other, until);
-    }
-
-#pragma endregion
-#pragma region C-Style Arguments
+    basic_string substr(size_type skip, size_type count) const noexcept(false) { return view().substr(skip, count); }
 
     /**
-     *  @brief  Find the first occurrence of a character from a set.
-     *  @param  skip  The number of first characters to be skipped.
-     *  @warning The behavior is @b undefined if `skip > size()`.
+     *  @brief  Exports a slice of this view after first `skip` bytes, taking at most `count` bytes.
+     *  @throws `std::out_of_range` if `skip > size()`.
+     *  @see    `sub` for a cleaner exception-less alternative.
      */
-    size_type find_first_of(const_pointer other, size_type skip, size_type count) const noexcept {
-        return view().find_first_of(other, skip, count);
+    size_type copy(value_type *destination, size_type count, size_type skip = 0) const noexcept(false) {
+        return view().copy(destination, count, skip);
     }
 
+#pragma endregion
+
+#pragma endregion
+
+#pragma region Comparisons
+
+#pragma region Whole String Comparisons
+
     /**
-     *  @brief  Find the first occurrence of a character outside a set.
-     *  @param  skip  The number of first characters to be skipped.
-     *  @warning The behavior is @b undefined if `skip > size()`.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
      */
-    size_type find_first_not_of(const_pointer other, size_type skip, size_type count) const noexcept {
-        return view().find_first_not_of(other, skip, count);
-    }
+    int compare(string_view other) const noexcept { return view().compare(other); }
 
     /**
-     *  @brief  Find the last occurrence of a character from a set.
-     *  @param  until  The number of first characters to be considered.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *          Equivalent to `substr(pos1, count1).compare(other)`.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
+     *  @throw  `std::out_of_range` if `pos1 > size()`.
      */
-    size_type find_last_of(const_pointer other, size_type until, size_type count) const noexcept {
-        return view().find_last_of(other, until, count);
+    int compare(size_type pos1, size_type count1, string_view other) const noexcept(false) {
+        return view().compare(pos1, count1, other);
     }
 
     /**
-     *  @brief  Find the last occurrence of a character outside a set.
-     *  @param  until  The number of first characters to be considered.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *          Equivalent to `substr(pos1, count1).compare(other.substr(pos2, count2))`.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
+     *  @throw  `std::out_of_range` if `pos1 > size()` or if `pos2 > other.size()`.
      */
-    size_type find_last_not_of(const_pointer other, size_type until, size_type count) const noexcept {
-        return view().find_last_not_of(other, until, count);
+    int compare(size_type pos1, size_type count1, string_view other, size_type pos2, size_type count2) const
+        noexcept(false) {
+        return view().compare(pos1, count1, other, pos2, count2);
     }
 
-#pragma endregion
-#pragma region Slicing
-
     /**
-     *  @brief  Python-like convenience function, dropping prefix formed of given characters.
-     *          Similar to `boost::algorithm::trim_left_if(str, is_any_of(set))`.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
      */
-    basic_string &lstrip(char_set set) noexcept {
-        auto remaining = view().lstrip(set);
-        remove_prefix(size() - remaining.size());
-        return *this;
-    }
+    int compare(const_pointer other) const noexcept { return view().compare(other); }
 
     /**
-     *  @brief  Python-like convenience function, dropping suffix formed of given characters.
-     *          Similar to `boost::algorithm::trim_right_if(str, is_any_of(set))`.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *          Equivalent to substr(pos1, count1).compare(other).
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
+     *  @throw  `std::out_of_range` if `pos1 > size()`.
      */
-    basic_string &rstrip(char_set set) noexcept {
-        auto remaining = view().rstrip(set);
-        remove_suffix(size() - remaining.size());
-        return *this;
+    int compare(size_type pos1, size_type count1, const_pointer other) const noexcept(false) {
+        return view().compare(pos1, count1, other);
     }
 
     /**
-     *  @brief  Python-like convenience function, dropping both the prefix & the suffix formed of given characters.
-     *          Similar to `boost::algorithm::trim_if(str, is_any_of(set))`.
+     *  @brief  Compares two strings lexicographically. If prefix matches, lengths are compared.
+     *          Equivalent to `substr(pos1, count1).compare({s, count2})`.
+     *  @return 0 if equal, negative if `*this` is less than `other`, positive if `*this` is greater than `other`.
+     *  @throw  `std::out_of_range` if `pos1 > size()`.
      */
-    basic_string &strip(char_set set) noexcept { return lstrip(set).rstrip(set); }
+    int compare(size_type pos1, size_type count1, const_pointer other, size_type count2) const noexcept(false) {
+        return view().compare(pos1, count1, other, count2);
+    }
 
-#pragma endregion
-#pragma endregion
+    /**  @brief  Checks if the string is equal to the other string. */
+    bool operator==(basic_string const &other) const noexcept { return view() == other.view(); }
+    bool operator==(string_view other) const noexcept { return view() == other; }
+    bool operator==(const_pointer other) const noexcept { return view() == string_view(other); }
 
-#pragma region Modifiers
-#pragma region Non-STL API
+#if SZ_DETECT_CPP20
 
-    bool try_resize(size_type count, value_type character = '\0') noexcept;
+    /**  @brief  Computes the lexicographic ordering between this and the ::other string. */
+    std::strong_ordering operator<=>(basic_string const &other) const noexcept { return view() <=> other.view(); }
+    std::strong_ordering operator<=>(string_view other) const noexcept { return view() <=> other; }
+    std::strong_ordering operator<=>(const_pointer other) const noexcept { return view() <=> string_view(other); }
 
-    bool try_reserve(size_type capacity) noexcept {
-        return _with_alloc([&](sz_alloc_type &alloc) { return sz_string_reserve(&string_, capacity, &alloc); });
-    }
+#else
 
-    bool try_assign(string_view other) noexcept;
+    /**  @brief  Checks if the string is not equal to the other string. */
+    bool operator!=(string_view other) const noexcept { return !operator==(other); }
 
-    template <typename first_type, typename second_type>
-    bool try_assign(concatenation<first_type, second_type> const &other) noexcept;
+    /**  @brief  Checks if the string is lexicographically smaller than the other string. */
+    bool operator<(string_view other) const noexcept { return compare(other) == sz_less_k; }
 
-    bool try_push_back(char_type c) noexcept;
+    /**  @brief  Checks if the string is lexicographically equal or smaller than the other string. */
+    bool operator<=(string_view other) const noexcept { return compare(other) != sz_greater_k; }
 
-    bool try_append(const_pointer str, size_type length) noexcept;
+    /**  @brief  Checks if the string is lexicographically greater than the other string. */
+    bool operator>(string_view other) const noexcept { return compare(other) == sz_greater_k; }
 
-    bool try_append(string_view str) noexcept { return try_append(str.data(), str.size()); }
+    /**  @brief  Checks if the string is lexicographically equal or greater than the other string. */
+    bool operator>=(string_view other) const noexcept { return compare(other) != sz_less_k; }
 
-    /**
-     *  @brief  Erases ( @b in-place ) a range of characters defined with signed offsets.
-     *  @return Number of characters removed.
-     */
-    size_type try_erase(difference_type signed_start_offset = 0, difference_type signed_end_offset = npos) noexcept {
-        sz_size_t normalized_offset, normalized_length;
-        sz_ssize_clamp_interval(size(), signed_start_offset, signed_end_offset, &normalized_offset, &normalized_length);
-        if (!normalized_length) return false;
-        sz_string_erase(&string_, normalized_offset, normalized_length);
-        return normalized_length;
-    }
+#endif
 
-    /**
-     *  @brief  Inserts ( @b in-place ) a range of characters at a given signed offset.
-     *  @return `true` if the insertion was successful, `false` otherwise.
-     */
-    bool try_insert(difference_type signed_offset, string_view string) noexcept {
-        sz_size_t normalized_offset, normalized_length;
-        sz_ssize_clamp_interval(size(), signed_offset, 0, &normalized_offset, &normalized_length);
-        if (!_with_alloc([&](sz_alloc_type &alloc) {
-                return sz_string_expand(&string_, normalized_offset, string.size(), &alloc);
-            }))
-            return false;
+#pragma endregion
+#pragma region Prefix and Suffix Comparisons
 
-        sz_copy(data() + normalized_offset, string.data(), string.size());
-        return true;
-    }
+    /**  @brief  Checks if the string starts with the other string. */
+    bool starts_with(string_view other) const noexcept { return view().starts_with(other); }
 
-    /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
-     *  @return `true` if the replacement was successful, `false` otherwise.
-     */
-    bool try_replace(difference_type signed_start_offset, difference_type signed_end_offset,
-                     string_view replacement) noexcept {
+    /**  @brief  Checks if the string starts with the other string. */
+    bool starts_with(const_pointer other) const noexcept { return view().starts_with(other); }
 
-        sz_size_t normalized_offset, normalized_length;
-        sz_ssize_clamp_interval(size(), signed_start_offset, signed_end_offset, &normalized_offset, &normalized_length);
-        if (!try_preparing_replacement(normalized_offset, normalized_length, replacement)) return false;
-        sz_copy(data() + normalized_offset, replacement.data(), replacement.size());
-        return true;
-    }
+    /**  @brief  Checks if the string starts with the other character. */
+    bool starts_with(value_type other) const noexcept { return view().starts_with(other); }
 
+    /**  @brief  Checks if the string ends with the other string. */
+    bool ends_with(string_view other) const noexcept { return view().ends_with(other); }
+
+    /**  @brief  Checks if the string ends with the other string. */
+    bool ends_with(const_pointer other) const noexcept { return view().ends_with(other); }
+
+    /**  @brief  Checks if the string ends with the other character. */
+    bool ends_with(value_type other) const noexcept { return view().ends_with(other); }
+
+#pragma endregion
 #pragma endregion
 
-#pragma region STL Interfaces
+#pragma region Matching Substrings
+
+    bool contains(string_view other) const noexcept { return view().contains(other); }
+    bool contains(value_type character) const noexcept { return view().contains(character); }
+    bool contains(const_pointer other) const noexcept { return view().contains(other); }
+
+#pragma region Returning offsets
 
     /**
-     *  @brief  Clears the string contents, but @b no deallocations happen.
+     *  @brief  Find the first occurrence of a substring, skipping the first `skip` characters.
+     *          The behavior is @b undefined if `skip > size()`.
+     *  @return The offset of the first character of the match, or `npos` if not found.
      */
-    void clear() noexcept { sz_string_erase(&string_, 0, SZ_SIZE_MAX); }
+    size_type find(string_view other, size_type skip = 0) const noexcept { return view().find(other, skip); }
 
     /**
-     *  @brief  Resizes the string to the given size, filling the new space with the given character,
-     *          or NULL-character if nothing is provided.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @brief  Find the first occurrence of a character, skipping the first `skip` characters.
+     *          The behavior is @b undefined if `skip > size()`.
+     *  @return The offset of the match, or `npos` if not found.
      */
-    void resize(size_type count, value_type character = '\0') noexcept(false) {
-        if (count > max_size()) throw std::length_error("sz::basic_string::resize");
-        if (!try_resize(count, character)) throw std::bad_alloc();
-    }
+    size_type find(value_type character, size_type skip = 0) const noexcept { return view().find(character, skip); }
 
     /**
-     *  @brief  Informs the string object of a planned change in size, so that it pre-allocate once.
-     *  @throw  `std::length_error` if the string is too long.
+     *  @brief  Find the first occurrence of a substring, skipping the first `skip` characters.
+     *          The behavior is @b undefined if `skip > size()`.
+     *  @return The offset of the first character of the match, or `npos` if not found.
      */
-    void reserve(size_type capacity) noexcept(false) {
-        if (capacity > max_size()) throw std::length_error("sz::basic_string::reserve");
-        if (!try_reserve(capacity)) throw std::bad_alloc();
+    size_type find(const_pointer other, size_type pos, size_type count) const noexcept {
+        return view().find(other, pos, count);
     }
 
     /**
-     *  @brief  Inserts ( @b in-place ) a ::character multiple times at the given offset.
-     *  @throw  `std::out_of_range` if `offset > size()`.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @brief  Find the last occurrence of a substring.
+     *  @return The offset of the first character of the match, or `npos` if not found.
      */
-    basic_string &insert(size_type offset, size_type repeats, char_type character) noexcept(false) {
-        if (offset > size()) throw std::out_of_range("sz::basic_string::insert");
-        if (size() + repeats > max_size()) throw std::length_error("sz::basic_string::insert");
-        if (!_with_alloc([&](sz_alloc_type &alloc) { return sz_string_expand(&string_, offset, repeats, &alloc); }))
-            throw std::bad_alloc();
-
-        sz_fill(data() + offset, repeats, character);
-        return *this;
-    }
+    size_type rfind(string_view other) const noexcept { return view().rfind(other); }
 
     /**
-     *  @brief  Inserts ( @b in-place ) a range of characters at the given offset.
-     *  @throw  `std::out_of_range` if `offset > size()`.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @brief  Find the last occurrence of a substring, within first `until` characters.
+     *  @return The offset of the first character of the match, or `npos` if not found.
      */
-    basic_string &insert(size_type offset, string_view other) noexcept(false) {
-        if (offset > size()) throw std::out_of_range("sz::basic_string::insert");
-        if (size() + other.size() > max_size()) throw std::length_error("sz::basic_string::insert");
-        if (!_with_alloc(
-                [&](sz_alloc_type &alloc) { return sz_string_expand(&string_, offset, other.size(), &alloc); }))
-            throw std::bad_alloc();
-
-        sz_copy(data() + offset, other.data(), other.size());
-        return *this;
-    }
+    size_type rfind(string_view other, size_type until) const noexcept { return view().rfind(other, until); }
 
     /**
-     *  @brief  Inserts ( @b in-place ) a range of characters at the given offset.
-     *  @throw  `std::out_of_range` if `offset > size()`.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @brief  Find the last occurrence of a character.
+     *  @return The offset of the match, or `npos` if not found.
      */
-    basic_string &insert(size_type offset, const_pointer start, size_type length) noexcept(false) {
-        return insert(offset, string_view(start, length));
-    }
+    size_type rfind(value_type character) const noexcept { return view().rfind(character); }
 
     /**
-     *  @brief  Inserts ( @b in-place ) a slice of another string at the given offset.
-     *  @throw  `std::out_of_range` if `offset > size()` or `other_index > other.size()`.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @brief  Find the last occurrence of a character, within first `until` characters.
+     *  @return The offset of the match, or `npos` if not found.
      */
-    basic_string &insert(size_type offset, string_view other, size_type other_index,
-                         size_type count = npos) noexcept(false) {
-        return insert(offset, other.substr(other_index, count));
-    }
+    size_type rfind(value_type character, size_type until) const noexcept { return view().rfind(character, until); }
 
     /**
-     *  @brief  Inserts ( @b in-place ) one ::character at the given iterator position.
-     *  @throw  `std::out_of_range` if `pos > size()` or `other_index > other.size()`.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @brief  Find the last occurrence of a substring, within first `until` characters.
+     *  @return The offset of the first character of the match, or `npos` if not found.
      */
-    iterator insert(const_iterator it, char_type character) noexcept(false) {
-        auto pos = range_length(cbegin(), it);
-        insert(pos, string_view(&character, 1));
-        return begin() + pos;
+    size_type rfind(const_pointer other, size_type until, size_type count) const noexcept {
+        return view().rfind(other, until, count);
     }
 
-    /**
-     *  @brief  Inserts ( @b in-place ) a ::character multiple times at the given iterator position.
-     *  @throw  `std::out_of_range` if `pos > size()` or `other_index > other.size()`.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
-     */
-    iterator insert(const_iterator it, size_type repeats, char_type character) noexcept(false) {
-        auto pos = range_length(cbegin(), it);
-        insert(pos, repeats, character);
-        return begin() + pos;
-    }
+    /**  @brief  Find the first occurrence of a character from a set. */
+    size_type find(char_set set) const noexcept { return view().find(set); }
 
-    /**
-     *  @brief  Inserts ( @b in-place ) a range at the given iterator position.
-     *  @throw  `std::out_of_range` if `pos > size()` or `other_index > other.size()`.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
-     */
-    template <typename input_iterator>
-    iterator insert(const_iterator it, input_iterator first, input_iterator last) noexcept(false) {
+    /**  @brief  Find the last occurrence of a character from a set. */
+    size_type rfind(char_set set) const noexcept { return view().rfind(set); }
 
-        auto pos = range_length(cbegin(), it);
-        if (pos > size()) throw std::out_of_range("sz::basic_string::insert");
+#pragma endregion
+#pragma endregion
 
-        auto added_length = range_length(first, last);
-        if (size() + added_length > max_size()) throw std::length_error("sz::basic_string::insert");
+#pragma region Matching Character Sets
 
-        if (!_with_alloc([&](sz_alloc_type &alloc) { return sz_string_expand(&string_, pos, added_length, &alloc); }))
-            throw std::bad_alloc();
+    bool contains_only(char_set set) const noexcept { return find_first_not_of(set) == npos; }
+    bool is_alpha() const noexcept { return !empty() && contains_only(ascii_letters_set()); }
+    bool is_alnum() const noexcept { return !empty() && contains_only(ascii_letters_set() | digits_set()); }
+    bool is_ascii() const noexcept { return empty() || contains_only(ascii_controls_set() | ascii_printables_set()); }
+    bool is_digit() const noexcept { return !empty() && contains_only(digits_set()); }
+    bool is_lower() const noexcept { return !empty() && contains_only(ascii_lowercase_set()); }
+    bool is_space() const noexcept { return !empty() && contains_only(whitespaces_set()); }
+    bool is_upper() const noexcept { return !empty() && contains_only(ascii_uppercase_set()); }
+    bool is_printable() const noexcept { return empty() || contains_only(ascii_printables_set()); }
 
-        iterator result = begin() + pos;
-        for (iterator output = result; first != last; ++first, ++output) *output = *first;
-        return result;
-    }
+#pragma region Character Set Arguments
 
     /**
-     *  @brief  Inserts ( @b in-place ) an initializer list of characters.
-     *  @throw  `std::out_of_range` if `pos > size()` or `other_index > other.size()`.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @brief  Find the first occurrence of a character from a set.
+     *  @param  skip Number of characters to skip before the search.
+     *  @warning The behavior is @b undefined if `skip > size()`.
      */
-    iterator insert(const_iterator it, std::initializer_list<char_type> ilist) noexcept(false) {
-        return insert(it, ilist.begin(), ilist.end());
-    }
+    size_type find_first_of(char_set set, size_type skip = 0) const noexcept { return view().find_first_of(set, skip); }
 
     /**
-     *  @brief  Erases ( @b in-place ) the given range of characters.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @see    `try_erase_slice` for a cleaner exception-less alternative.
+     *  @brief  Find the first occurrence of a character outside a set.
+     *  @param  skip  The number of first characters to be skipped.
+     *  @warning The behavior is @b undefined if `skip > size()`.
      */
-    basic_string &erase(size_type pos = 0, size_type count = npos) noexcept(false) {
-        if (!count || empty()) return *this;
-        if (pos >= size()) throw std::out_of_range("sz::basic_string::erase");
-        sz_string_erase(&string_, pos, count);
-        return *this;
+    size_type find_first_not_of(char_set set, size_type skip = 0) const noexcept {
+        return view().find_first_not_of(set, skip);
     }
 
     /**
-     *  @brief  Erases ( @b in-place ) the given range of characters.
-     *  @return Iterator pointing following the erased character, or end() if no such character exists.
+     *  @brief  Find the last occurrence of a character from a set.
      */
-    iterator erase(const_iterator first, const_iterator last) noexcept {
-        auto start = begin();
-        auto offset = first - start;
-        sz_string_erase(&string_, offset, last - first);
-        return start + offset;
-    }
+    size_type find_last_of(char_set set) const noexcept { return view().find_last_of(set); }
 
     /**
-     *  @brief  Erases ( @b in-place ) the one character at a given postion.
-     *  @return Iterator pointing following the erased character, or end() if no such character exists.
+     *  @brief  Find the last occurrence of a character outside a set.
      */
-    iterator erase(const_iterator pos) noexcept { return erase(pos, pos + 1); }
+    size_type find_last_not_of(char_set set) const noexcept { return view().find_last_not_of(set); }
 
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Find the last occurrence of a character from a set.
+     *  @param  until  The offset of the last character to be considered.
      */
-    basic_string &replace(size_type pos, size_type count, string_view const &str) noexcept(false) {
-        if (pos > size()) throw std::out_of_range("sz::basic_string::replace");
-        if (size() - count + str.size() > max_size()) throw std::length_error("sz::basic_string::replace");
-        if (!try_preparing_replacement(pos, count, str.size())) throw std::bad_alloc();
-        sz_copy(data() + pos, str.data(), str.size());
-        return *this;
+    size_type find_last_of(char_set set, size_type until) const noexcept { return view().find_last_of(set, until); }
+
+    /**
+     *  @brief  Find the last occurrence of a character outside a set.
+     *  @param  until  The offset of the last character to be considered.
+     */
+    size_type find_last_not_of(char_set set, size_type until) const noexcept {
+        return view().find_last_not_of(set, until);
     }
 
+#pragma endregion
+#pragma region String Arguments
+
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Find the first occurrence of a character from a ::set.
+     *  @param  skip  The number of first characters to be skipped.
      */
-    basic_string &replace(const_iterator first, const_iterator last, string_view const &str) noexcept(false) {
-        return replace(range_length(cbegin(), first), last - first, str);
+    size_type find_first_of(string_view other, size_type skip = 0) const noexcept {
+        return view().find_first_of(other, skip);
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
-     *  @throws `std::out_of_range` if `pos > size()` or `pos2 > str.size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Find the first occurrence of a character outside a ::set.
+     *  @param  skip  The number of first characters to be skipped.
      */
-    basic_string &replace(size_type pos, size_type count, string_view const &str, size_type pos2,
-                          size_type count2 = npos) noexcept(false) {
-        return replace(pos, count, str.substr(pos2, count2));
+    size_type find_first_not_of(string_view other, size_type skip = 0) const noexcept {
+        return view().find_first_not_of(other, skip);
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Find the last occurrence of a character from a ::set.
+     *  @param  until  The offset of the last character to be considered.
      */
-    basic_string &replace(size_type pos, size_type count, const_pointer cstr, size_type count2) noexcept(false) {
-        return replace(pos, count, string_view(cstr, count2));
+    size_type find_last_of(string_view other, size_type until = npos) const noexcept {
+        return view().find_last_of(other, until);
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Find the last occurrence of a character outside a ::set.
+     *  @param  until  The offset of the last character to be considered.
      */
-    basic_string &replace(const_iterator first, const_iterator last, const_pointer cstr,
-                          size_type count2) noexcept(false) {
-        return replace(range_length(cbegin(), first), last - first, string_view(cstr, count2));
+    size_type find_last_not_of(string_view other, size_type until = npos) const noexcept {
+        return view().find_last_not_of(other, until);
     }
 
+#pragma endregion
+#pragma region C-Style Arguments
+
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Find the first occurrence of a character from a set.
+     *  @param  skip  The number of first characters to be skipped.
+     *  @warning The behavior is @b undefined if `skip > size()`.
      */
-    basic_string &replace(size_type pos, size_type count, const_pointer cstr) noexcept(false) {
-        return replace(pos, count, string_view(cstr));
+    size_type find_first_of(const_pointer other, size_type skip, size_type count) const noexcept {
+        return view().find_first_of(other, skip, count);
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Find the first occurrence of a character outside a set.
+     *  @param  skip  The number of first characters to be skipped.
+     *  @warning The behavior is @b undefined if `skip > size()`.
      */
-    basic_string &replace(const_iterator first, const_iterator last, const_pointer cstr) noexcept(false) {
-        return replace(range_length(cbegin(), first), last - first, string_view(cstr));
+    size_type find_first_not_of(const_pointer other, size_type skip, size_type count) const noexcept {
+        return view().find_first_not_of(other, skip, count);
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a repetition of given characters.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Find the last occurrence of a character from a set.
+     *  @param  until  The number of first characters to be considered.
      */
-    basic_string &replace(size_type pos, size_type count, size_type count2, char_type character) noexcept(false) {
-        if (pos > size()) throw std::out_of_range("sz::basic_string::replace");
-        if (size() - count + count2 > max_size()) throw std::length_error("sz::basic_string::replace");
-        if (!try_preparing_replacement(pos, count, count2)) throw std::bad_alloc();
-        sz_fill(data() + pos, count2, character);
-        return *this;
+    size_type find_last_of(const_pointer other, size_type until, size_type count) const noexcept {
+        return view().find_last_of(other, until, count);
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a repetition of given characters.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Find the last occurrence of a character outside a set.
+     *  @param  until  The number of first characters to be considered.
      */
-    basic_string &replace(const_iterator first, const_iterator last, size_type count2,
-                          char_type character) noexcept(false) {
-        return replace(range_length(cbegin(), first), last - first, count2, character);
+    size_type find_last_not_of(const_pointer other, size_type until, size_type count) const noexcept {
+        return view().find_last_not_of(other, until, count);
     }
 
+#pragma endregion
+#pragma region Slicing
+
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Python-like convenience function, dropping prefix formed of given characters.
+     *          Similar to `boost::algorithm::trim_left_if(str, is_any_of(set))`.
      */
-    template <typename input_iterator>
-    basic_string &replace(const_iterator first, const_iterator last, input_iterator first2,
-                          input_iterator last2) noexcept(false) {
-        auto pos = range_length(cbegin(), first);
-        auto count = range_length(first, last);
-        auto count2 = range_length(first2, last2);
-        if (pos > size()) throw std::out_of_range("sz::basic_string::replace");
-        if (size() - count + count2 > max_size()) throw std::length_error("sz::basic_string::replace");
-        if (!try_preparing_replacement(pos, count, count2)) throw std::bad_alloc();
-        for (iterator output = begin() + pos; first2 != last2; ++first2, ++output) *output = *first2;
+    basic_string &lstrip(char_set set) noexcept {
+        auto remaining = view().lstrip(set);
+        remove_prefix(size() - remaining.size());
         return *this;
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) a range of characters with a given initializer list.
-     *  @throws `std::out_of_range` if `pos > size()`.
-     *  @throws `std::length_error` if the string is too long.
-     *  @see    `try_replace` for a cleaner exception-less alternative.
+     *  @brief  Python-like convenience function, dropping suffix formed of given characters.
+     *          Similar to `boost::algorithm::trim_right_if(str, is_any_of(set))`.
      */
-    basic_string &replace(const_iterator first, const_iterator last,
-                          std::initializer_list<char_type> ilist) noexcept(false) {
-        return replace(first, last, ilist.begin(), ilist.end());
+    basic_string &rstrip(char_set set) noexcept {
+        auto remaining = view().rstrip(set);
+        remove_suffix(size() - remaining.size());
+        return *this;
     }
 
     /**
-     *  @brief  Appends the given character at the end.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @brief  Python-like convenience function, dropping both the prefix & the suffix formed of given characters.
+     *          Similar to `boost::algorithm::trim_if(str, is_any_of(set))`.
      */
-    void push_back(char_type ch) noexcept(false) {
-        if (size() == max_size()) throw std::length_error("string::push_back");
-        if (!try_push_back(ch)) throw std::bad_alloc();
+    basic_string &strip(char_set set) noexcept { return lstrip(set).rstrip(set); }
+
+#pragma endregion
+#pragma endregion
+
+#pragma region Modifiers
+#pragma region Non-STL API
+
+    bool try_resize(size_type count, value_type character = '\0') noexcept;
+
+    bool try_reserve(size_type capacity) noexcept {
+        return _with_alloc([&](sz_alloc_type &alloc) { return sz_string_reserve(&string_, capacity, &alloc); });
     }
 
-    /**
-     *  @brief  Removes the last character from the string.
-     *  @warning The behavior is @b undefined if the string is empty.
-     */
-    void pop_back() noexcept { sz_string_erase(&string_, size() - 1, 1); }
+    bool try_assign(string_view other) noexcept;
+
+    template <typename first_type, typename second_type>
+    bool try_assign(concatenation<first_type, second_type> const &other) noexcept;
+
+    bool try_push_back(char_type c) noexcept;
+
+    bool try_append(const_pointer str, size_type length) noexcept;
+
+    bool try_append(string_view str) noexcept { return try_append(str.data(), str.size()); }
 
     /**
-     *  @brief  Overwrites the string with the given string.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_assign` for a cleaner exception-less alternative.
+     *  @brief  Erases ( @b in-place ) a range of characters defined with signed offsets.
+     *  @return Number of characters removed.
      */
-    basic_string &assign(string_view other) noexcept(false) {
-        if (!try_assign(other)) throw std::bad_alloc();
-        return *this;
+    size_type try_erase(difference_type signed_start_offset = 0, difference_type signed_end_offset = npos) noexcept {
+        sz_size_t normalized_offset, normalized_length;
+        sz_ssize_clamp_interval(size(), signed_start_offset, signed_end_offset, &normalized_offset, &normalized_length);
+        if (!normalized_length) return false;
+        sz_string_erase(&string_, normalized_offset, normalized_length);
+        return normalized_length;
     }
 
     /**
-     *  @brief  Overwrites the string with the given repeated character.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_assign` for a cleaner exception-less alternative.
+     *  @brief  Inserts ( @b in-place ) a range of characters at a given signed offset.
+     *  @return `true` if the insertion was successful, `false` otherwise.
      */
-    basic_string &assign(size_type repeats, char_type character) noexcept(false) {
-        resize(repeats, character);
-        sz_fill(data(), repeats, *(sz_u8_t *)&character);
-        return *this;
+    bool try_insert(difference_type signed_offset, string_view string) noexcept {
+        sz_size_t normalized_offset, normalized_length;
+        sz_ssize_clamp_interval(size(), signed_offset, 0, &normalized_offset, &normalized_length);
+        if (!_with_alloc([&](sz_alloc_type &alloc) {
+                return sz_string_expand(&string_, normalized_offset, string.size(), &alloc);
+            }))
+            return false;
+
+        sz_copy(data() + normalized_offset, string.data(), string.size());
+        return true;
     }
 
     /**
-     *  @brief  Overwrites the string with the given string.
-     *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_assign` for a cleaner exception-less alternative.
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
+     *  @return `true` if the replacement was successful, `false` otherwise.
      */
-    basic_string &assign(const_pointer other, size_type length) noexcept(false) { return assign({other, length}); }
+    bool try_replace(difference_type signed_start_offset, difference_type signed_end_offset,
+                     string_view replacement) noexcept {
+
+        sz_size_t normalized_offset, normalized_length;
+        sz_ssize_clamp_interval(size(), signed_start_offset, signed_end_offset, &normalized_offset, &normalized_length);
+        if (!try_preparing_replacement(normalized_offset, normalized_length, replacement)) return false;
+        sz_copy(data() + normalized_offset, replacement.data(), replacement.size());
+        return true;
+    }
+
+#pragma endregion
+
+#pragma region STL Interfaces
 
     /**
-     *  @brief  Overwrites the string with the given string.
-     *  @throw  `std::length_error` if the string is too long or `pos > str.size()`.
-     *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_assign` for a cleaner exception-less alternative.
+     *  @brief  Clears the string contents, but @b no deallocations happen.
      */
-    basic_string &assign(string_view str, size_type pos, size_type count = npos) noexcept(false) {
-        return assign(str.substr(pos, count));
-    }
+    void clear() noexcept { sz_string_erase(&string_, 0, SZ_SIZE_MAX); }
 
     /**
-     *  @brief  Overwrites the string with the given iterator range.
+     *  @brief  Resizes the string to the given size, filling the new space with the given character,
+     *          or NULL-character if nothing is provided.
      *  @throw  `std::length_error` if the string is too long.
      *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_assign` for a cleaner exception-less alternative.
      */
-    template <typename input_iterator>
-    basic_string &assign(input_iterator first, input_iterator last) noexcept(false) {
-        resize(range_length(first, last));
-        for (iterator output = begin(); first != last; ++first, ++output) *output = *first;
-        return *this;
+    void resize(size_type count, value_type character = '\0') noexcept(false) {
+        if (count > max_size()) throw std::length_error("sz::basic_string::resize");
+        if (!try_resize(count, character)) throw std::bad_alloc();
     }
 
     /**
-     *  @brief  Overwrites the string with the given initializer list.
+     *  @brief  Informs the string object of a planned change in size, so that it pre-allocate once.
      *  @throw  `std::length_error` if the string is too long.
-     *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_assign` for a cleaner exception-less alternative.
      */
-    basic_string &assign(std::initializer_list<char_type> ilist) noexcept(false) {
-        return assign(ilist.begin(), ilist.end());
+    void reserve(size_type capacity) noexcept(false) {
+        if (capacity > max_size()) throw std::length_error("sz::basic_string::reserve");
+        if (!try_reserve(capacity)) throw std::bad_alloc();
     }
 
     /**
-     *  @brief  Appends to the end of the current string.
+     *  @brief  Inserts ( @b in-place ) a ::character multiple times at the given offset.
+     *  @throw  `std::out_of_range` if `offset > size()`.
      *  @throw  `std::length_error` if the string is too long.
      *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_append` for a cleaner exception-less alternative.
      */
-    basic_string &append(string_view str) noexcept(false) {
-        if (!try_append(str)) throw std::bad_alloc();
+    basic_string &insert(size_type offset, size_type repeats, char_type character) noexcept(false) {
+        if (offset > size()) throw std::out_of_range("sz::basic_string::insert");
+        if (size() + repeats > max_size()) throw std::length_error("sz::basic_string::insert");
+        if (!_with_alloc([&](sz_alloc_type &alloc) { return sz_string_expand(&string_, offset, repeats, &alloc); }))
+            throw std::bad_alloc();
+
+        sz_fill(data() + offset, repeats, character);
         return *this;
     }
 
     /**
-     *  @brief  Appends to the end of the current string.
-     *  @throw  `std::length_error` if the string is too long or `pos > str.size()`.
+     *  @brief  Inserts ( @b in-place ) a range of characters at the given offset.
+     *  @throw  `std::out_of_range` if `offset > size()`.
+     *  @throw  `std::length_error` if the string is too long.
      *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_append` for a cleaner exception-less alternative.
      */
-    basic_string &append(string_view str, size_type pos, size_type length = npos) noexcept(false) {
-        return append(str.substr(pos, length));
+    basic_string &insert(size_type offset, string_view other) noexcept(false) {
+        if (offset > size()) throw std::out_of_range("sz::basic_string::insert");
+        if (size() + other.size() > max_size()) throw std::length_error("sz::basic_string::insert");
+        if (!_with_alloc(
+                [&](sz_alloc_type &alloc) { return sz_string_expand(&string_, offset, other.size(), &alloc); }))
+            throw std::bad_alloc();
+
+        sz_copy(data() + offset, other.data(), other.size());
+        return *this;
     }
 
     /**
-     *  @brief  Appends to the end of the current string.
+     *  @brief  Inserts ( @b in-place ) a range of characters at the given offset.
+     *  @throw  `std::out_of_range` if `offset > size()`.
      *  @throw  `std::length_error` if the string is too long.
      *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_append` for a cleaner exception-less alternative.
      */
-    basic_string &append(const_pointer str, size_type length) noexcept(false) { return append({str, length}); }
+    basic_string &insert(size_type offset, const_pointer start, size_type length) noexcept(false) {
+        return insert(offset, string_view(start, length));
+    }
 
     /**
-     *  @brief  Appends to the end of the current string.
+     *  @brief  Inserts ( @b in-place ) a slice of another string at the given offset.
+     *  @throw  `std::out_of_range` if `offset > size()` or `other_index > other.size()`.
      *  @throw  `std::length_error` if the string is too long.
      *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_append` for a cleaner exception-less alternative.
      */
-    basic_string &append(const_pointer str) noexcept(false) { return append(string_view(str)); }
+    basic_string &insert(size_type offset, string_view other, size_type other_index,
+                         size_type count = npos) noexcept(false) {
+        return insert(offset, other.substr(other_index, count));
+    }
 
     /**
-     *  @brief  Appends a repeated character to the end of the current string.
+     *  @brief  Inserts ( @b in-place ) one ::character at the given iterator position.
+     *  @throw  `std::out_of_range` if `pos > size()` or `other_index > other.size()`.
      *  @throw  `std::length_error` if the string is too long.
      *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_append` for a cleaner exception-less alternative.
      */
-    basic_string &append(size_type repeats, char_type ch) noexcept(false) {
-        resize(size() + repeats, ch);
-        return *this;
+    iterator insert(const_iterator it, char_type character) noexcept(false) {
+        auto pos = range_length(cbegin(), it);
+        insert(pos, string_view(&character, 1));
+        return begin() + pos;
     }
 
     /**
-     *  @brief  Appends to the end of the current string.
+     *  @brief  Inserts ( @b in-place ) a ::character multiple times at the given iterator position.
+     *  @throw  `std::out_of_range` if `pos > size()` or `other_index > other.size()`.
      *  @throw  `std::length_error` if the string is too long.
      *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_append` for a cleaner exception-less alternative.
      */
-    basic_string &append(std::initializer_list<char_type> other) noexcept(false) {
-        return append(other.begin(), other.end());
+    iterator insert(const_iterator it, size_type repeats, char_type character) noexcept(false) {
+        auto pos = range_length(cbegin(), it);
+        insert(pos, repeats, character);
+        return begin() + pos;
     }
 
     /**
-     *  @brief  Appends to the end of the current string.
+     *  @brief  Inserts ( @b in-place ) a range at the given iterator position.
+     *  @throw  `std::out_of_range` if `pos > size()` or `other_index > other.size()`.
      *  @throw  `std::length_error` if the string is too long.
      *  @throw  `std::bad_alloc` if the allocation fails.
-     *  @see    `try_append` for a cleaner exception-less alternative.
      */
     template <typename input_iterator>
-    basic_string &append(input_iterator first, input_iterator last) noexcept(false) {
-        insert<input_iterator>(cend(), first, last);
-        return *this;
-    }
-
-    basic_string &operator+=(string_view other) noexcept(false) { return append(other); }
-    basic_string &operator+=(std::initializer_list<char_type> other) noexcept(false) { return append(other); }
-    basic_string &operator+=(char_type character) noexcept(false) { return operator+=(string_view(&character, 1)); }
-    basic_string &operator+=(const_pointer other) noexcept(false) { return operator+=(string_view(other)); }
+    iterator insert(const_iterator it, input_iterator first, input_iterator last) noexcept(false) {
 
-    basic_string operator+(char_type character) const noexcept(false) { return operator+(string_view(&character, 1)); }
-    basic_string operator+(const_pointer other) const noexcept(false) { return operator+(string_view(other)); }
-    basic_string operator+(string_view other) const noexcept(false) {
-        return basic_string {concatenation<string_view, string_view> {view(), other}};
-    }
-    basic_string operator+(std::initializer_list<char_type> other) const noexcept(false) {
-        return basic_string {concatenation<string_view, string_view> {view(), other}};
-    }
+        auto pos = range_length(cbegin(), it);
+        if (pos > size()) throw std::out_of_range("sz::basic_string::insert");
 
-#pragma endregion
-#pragma endregion
+        auto added_length = range_length(first, last);
+        if (size() + added_length > max_size()) throw std::length_error("sz::basic_string::insert");
 
-    concatenation<string_view, string_view> operator|(string_view other) const noexcept { return {view(), other}; }
+        if (!_with_alloc([&](sz_alloc_type &alloc) { return sz_string_expand(&string_, pos, added_length, &alloc); }))
+            throw std::bad_alloc();
 
-    size_type edit_distance(string_view other, size_type bound = 0) const noexcept {
-        size_type distance;
-        _with_alloc([&](sz_alloc_type &alloc) {
-            distance = sz_edit_distance(data(), size(), other.data(), other.size(), bound, &alloc);
-            return true;
-        });
-        return distance;
+        iterator result = begin() + pos;
+        for (iterator output = result; first != last; ++first, ++output) *output = *first;
+        return result;
     }
 
-    /**  @brief  Hashes the string, equivalent to `std::hash<string_view>{}(str)`. */
-    size_type hash() const noexcept { return view().hash(); }
+    /**
+     *  @brief  Inserts ( @b in-place ) an initializer list of characters.
+     *  @throw  `std::out_of_range` if `pos > size()` or `other_index > other.size()`.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    iterator insert(const_iterator it, std::initializer_list<char_type> ilist) noexcept(false) {
+        return insert(it, ilist.begin(), ilist.end());
+    }
 
     /**
-     *  @brief  Overwrites the string with random characters from the given alphabet using the random generator.
-     *
-     *  @param  generator  A random generator function object that returns a random number in the range [0, 2^64).
-     *  @param  alphabet   A string of characters to choose from.
+     *  @brief  Erases ( @b in-place ) the given range of characters.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @see    `try_erase_slice` for a cleaner exception-less alternative.
      */
-    template <typename generator_type>
-    basic_string &randomize(generator_type &generator, string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept {
-        sz_ptr_t start;
-        sz_size_t length;
-        sz_string_range(&string_, &start, &length);
-        sz_random_generator_t generator_callback = &_call_random_generator<generator_type>;
-        sz_generate(alphabet.data(), alphabet.size(), start, length, generator_callback, &generator);
+    basic_string &erase(size_type pos = 0, size_type count = npos) noexcept(false) {
+        if (!count || empty()) return *this;
+        if (pos >= size()) throw std::out_of_range("sz::basic_string::erase");
+        sz_string_erase(&string_, pos, count);
         return *this;
     }
 
     /**
-     *  @brief  Overwrites the string with random characters from the given alphabet
-     *          using `std::rand` as the random generator.
-     *
-     *  @param  alphabet   A string of characters to choose from.
+     *  @brief  Erases ( @b in-place ) the given range of characters.
+     *  @return Iterator pointing following the erased character, or end() if no such character exists.
      */
-    basic_string &randomize(string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept {
-        return randomize(&std::rand, alphabet);
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        auto start = begin();
+        auto offset = first - start;
+        sz_string_erase(&string_, offset, last - first);
+        return start + offset;
     }
 
     /**
-     *  @brief  Generate a new random string of given length using `std::rand` as the random generator.
-     *          May throw exceptions if the memory allocation fails.
-     *
-     *  @param  length     The length of the generated string.
-     *  @param  alphabet   A string of characters to choose from.
+     *  @brief  Erases ( @b in-place ) the one character at a given postion.
+     *  @return Iterator pointing following the erased character, or end() if no such character exists.
      */
-    static basic_string random(size_type length, string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept(false) {
-        return basic_string(length, '\0').randomize(alphabet);
-    }
+    iterator erase(const_iterator pos) noexcept { return erase(pos, pos + 1); }
 
     /**
-     *  @brief  Generate a new random string of given length using the provided random number generator.
-     *          May throw exceptions if the memory allocation fails.
-     *
-     *  @param  generator  A random generator function object that returns a random number in the range [0, 2^64).
-     *  @param  length     The length of the generated string.
-     *  @param  alphabet   A string of characters to choose from.
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
      */
-    template <typename generator_type>
-    static basic_string random(generator_type &generator, size_type length,
-                               string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept(false) {
-        return basic_string(length, '\0').randomize(generator, alphabet);
+    basic_string &replace(size_type pos, size_type count, string_view const &str) noexcept(false) {
+        if (pos > size()) throw std::out_of_range("sz::basic_string::replace");
+        if (size() - count + str.size() > max_size()) throw std::length_error("sz::basic_string::replace");
+        if (!try_preparing_replacement(pos, count, str.size())) throw std::bad_alloc();
+        sz_copy(data() + pos, str.data(), str.size());
+        return *this;
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) all occurrences of a given string with the ::replacement string.
-     *          Similar to `boost::algorithm::replace_all` and Python's `str.replace`.
-     *
-     *  The implementation is not as composable, as using search ranges combined with a replacing mapping for matches,
-     *  and might be suboptimal, if you are exporting the cleaned-up string to another buffer.
-     *  The algorithm is suboptimal when this string is made exclusively of the pattern.
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
      */
-    basic_string &replace_all(string_view pattern, string_view replacement) noexcept(false) {
-        if (!try_replace_all(pattern, replacement)) throw std::bad_alloc();
-        return *this;
+    basic_string &replace(const_iterator first, const_iterator last, string_view const &str) noexcept(false) {
+        return replace(range_length(cbegin(), first), last - first, str);
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) all occurrences of a given character set with the ::replacement string.
-     *          Similar to `boost::algorithm::replace_all` and Python's `str.replace`.
-     *
-     *  The implementation is not as composable, as using search ranges combined with a replacing mapping for matches,
-     *  and might be suboptimal, if you are exporting the cleaned-up string to another buffer.
-     *  The algorithm is suboptimal when this string is made exclusively of the pattern.
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
+     *  @throws `std::out_of_range` if `pos > size()` or `pos2 > str.size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
      */
-    basic_string &replace_all(char_set pattern, string_view replacement) noexcept(false) {
-        if (!try_replace_all(pattern, replacement)) throw std::bad_alloc();
-        return *this;
+    basic_string &replace(size_type pos, size_type count, string_view const &str, size_type pos2,
+                          size_type count2 = npos) noexcept(false) {
+        return replace(pos, count, str.substr(pos2, count2));
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) all occurrences of a given string with the ::replacement string.
-     *          Similar to `boost::algorithm::replace_all` and Python's `str.replace`.
-     *
-     *  The implementation is not as composable, as using search ranges combined with a replacing mapping for matches,
-     *  and might be suboptimal, if you are exporting the cleaned-up string to another buffer.
-     *  The algorithm is suboptimal when this string is made exclusively of the pattern.
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
      */
-    bool try_replace_all(string_view pattern, string_view replacement) noexcept {
-        return try_replace_all_<string_view>(pattern, replacement);
+    basic_string &replace(size_type pos, size_type count, const_pointer cstr, size_type count2) noexcept(false) {
+        return replace(pos, count, string_view(cstr, count2));
     }
 
     /**
-     *  @brief  Replaces ( @b in-place ) all occurrences of a given character set with the ::replacement string.
-     *          Similar to `boost::algorithm::replace_all` and Python's `str.replace`.
-     *
-     *  The implementation is not as composable, as using search ranges combined with a replacing mapping for matches,
-     *  and might be suboptimal, if you are exporting the cleaned-up string to another buffer.
-     *  The algorithm is suboptimal when this string is made exclusively of the pattern.
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
      */
-    bool try_replace_all(char_set pattern, string_view replacement) noexcept {
-        return try_replace_all_<char_set>(pattern, replacement);
+    basic_string &replace(const_iterator first, const_iterator last, const_pointer cstr,
+                          size_type count2) noexcept(false) {
+        return replace(range_length(cbegin(), first), last - first, string_view(cstr, count2));
     }
 
-  private:
-    template <typename pattern_type>
-    bool try_replace_all_(pattern_type pattern, string_view replacement) noexcept;
-
     /**
-     *  @brief  Tries to prepare the string for a replacement of a given range with a new string.
-     *          The allocation may occur, if the replacement is longer than the replaced range.
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
      */
-    bool try_preparing_replacement(size_type offset, size_type length, size_type new_length) noexcept;
-};
+    basic_string &replace(size_type pos, size_type count, const_pointer cstr) noexcept(false) {
+        return replace(pos, count, string_view(cstr));
+    }
 
-using string = basic_string<char, std::allocator<char>>;
+    /**
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
+     */
+    basic_string &replace(const_iterator first, const_iterator last, const_pointer cstr) noexcept(false) {
+        return replace(range_length(cbegin(), first), last - first, string_view(cstr));
+    }
 
-static_assert(sizeof(string) == 4 * sizeof(void *), "String size must be 4 pointers.");
+    /**
+     *  @brief  Replaces ( @b in-place ) a range of characters with a repetition of given characters.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
+     */
+    basic_string &replace(size_type pos, size_type count, size_type count2, char_type character) noexcept(false) {
+        if (pos > size()) throw std::out_of_range("sz::basic_string::replace");
+        if (size() - count + count2 > max_size()) throw std::length_error("sz::basic_string::replace");
+        if (!try_preparing_replacement(pos, count, count2)) throw std::bad_alloc();
+        sz_fill(data() + pos, count2, character);
+        return *this;
+    }
 
-namespace literals {
-constexpr string_view operator""_sz(char const *str, std::size_t length) noexcept { return {str, length}; }
-} // namespace literals
+    /**
+     *  @brief  Replaces ( @b in-place ) a range of characters with a repetition of given characters.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
+     */
+    basic_string &replace(const_iterator first, const_iterator last, size_type count2,
+                          char_type character) noexcept(false) {
+        return replace(range_length(cbegin(), first), last - first, count2, character);
+    }
 
-template <typename char_type_, typename allocator_>
-bool basic_string<char_type_, allocator_>::try_resize(size_type count, value_type character) noexcept {
-    sz_ptr_t string_start;
-    sz_size_t string_length;
-    sz_size_t string_space;
-    sz_bool_t string_is_external;
-    sz_string_unpack(&string_, &string_start, &string_length, &string_space, &string_is_external);
+    /**
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given string.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
+     */
+    template <typename input_iterator>
+    basic_string &replace(const_iterator first, const_iterator last, input_iterator first2,
+                          input_iterator last2) noexcept(false) {
+        auto pos = range_length(cbegin(), first);
+        auto count = range_length(first, last);
+        auto count2 = range_length(first2, last2);
+        if (pos > size()) throw std::out_of_range("sz::basic_string::replace");
+        if (size() - count + count2 > max_size()) throw std::length_error("sz::basic_string::replace");
+        if (!try_preparing_replacement(pos, count, count2)) throw std::bad_alloc();
+        for (iterator output = begin() + pos; first2 != last2; ++first2, ++output) *output = *first2;
+        return *this;
+    }
 
-    // Allocate more space if needed.
-    if (count >= string_space) {
-        if (!_with_alloc(
-                [&](sz_alloc_type &alloc) { return sz_string_expand(&string_, SZ_SIZE_MAX, count, &alloc) != NULL; }))
-            return false;
-        sz_string_unpack(&string_, &string_start, &string_length, &string_space, &string_is_external);
+    /**
+     *  @brief  Replaces ( @b in-place ) a range of characters with a given initializer list.
+     *  @throws `std::out_of_range` if `pos > size()`.
+     *  @throws `std::length_error` if the string is too long.
+     *  @see    `try_replace` for a cleaner exception-less alternative.
+     */
+    basic_string &replace(const_iterator first, const_iterator last,
+                          std::initializer_list<char_type> ilist) noexcept(false) {
+        return replace(first, last, ilist.begin(), ilist.end());
     }
 
-    // Fill the trailing characters.
-    if (count > string_length) {
-        sz_fill(string_start + string_length, count - string_length, character);
-        string_start[count] = '\0';
-        // Knowing the layout of the string, we can perform this operation safely,
-        // even if its located on stack.
-        string_.external.length += count - string_length;
+    /**
+     *  @brief  Appends the given character at the end.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    void push_back(char_type ch) noexcept(false) {
+        if (size() == max_size()) throw std::length_error("string::push_back");
+        if (!try_push_back(ch)) throw std::bad_alloc();
     }
-    else { sz_string_erase(&string_, count, SZ_SIZE_MAX); }
-    return true;
-}
 
-template <typename char_type_, typename allocator_>
-bool basic_string<char_type_, allocator_>::try_assign(string_view other) noexcept {
-    // We can't just assign the other string state, as its start address may be somewhere else on the stack.
-    sz_ptr_t string_start;
-    sz_size_t string_length;
-    sz_string_range(&string_, &string_start, &string_length);
+    /**
+     *  @brief  Removes the last character from the string.
+     *  @warning The behavior is @b undefined if the string is empty.
+     */
+    void pop_back() noexcept { sz_string_erase(&string_, size() - 1, 1); }
 
-    if (string_length >= other.length()) {
-        other.copy(string_start, other.length());
-        sz_string_erase(&string_, other.length(), SZ_SIZE_MAX);
+    /**
+     *  @brief  Overwrites the string with the given string.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_assign` for a cleaner exception-less alternative.
+     */
+    basic_string &assign(string_view other) noexcept(false) {
+        if (!try_assign(other)) throw std::bad_alloc();
+        return *this;
     }
-    else {
-        if (!_with_alloc([&](sz_alloc_type &alloc) {
-                string_start = sz_string_expand(&string_, SZ_SIZE_MAX, other.length(), &alloc);
-                if (!string_start) return false;
-                other.copy(string_start, other.length());
-                return true;
-            }))
-            return false;
+
+    /**
+     *  @brief  Overwrites the string with the given repeated character.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_assign` for a cleaner exception-less alternative.
+     */
+    basic_string &assign(size_type repeats, char_type character) noexcept(false) {
+        resize(repeats, character);
+        sz_fill(data(), repeats, *(sz_u8_t *)&character);
+        return *this;
     }
-    return true;
-}
 
-template <typename char_type_, typename allocator_>
+    /**
+     *  @brief  Overwrites the string with the given string.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_assign` for a cleaner exception-less alternative.
+     */
+    basic_string &assign(const_pointer other, size_type length) noexcept(false) { return assign({other, length}); }
+
+    /**
+     *  @brief  Overwrites the string with the given string.
+     *  @throw  `std::length_error` if the string is too long or `pos > str.size()`.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_assign` for a cleaner exception-less alternative.
+     */
+    basic_string &assign(string_view str, size_type pos, size_type count = npos) noexcept(false) {
+        return assign(str.substr(pos, count));
+    }
+
+    /**
+     *  @brief  Overwrites the string with the given iterator range.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_assign` for a cleaner exception-less alternative.
+     */
+    template <typename input_iterator>
+    basic_string &assign(input_iterator first, input_iterator last) noexcept(false) {
+        resize(range_length(first, last));
+        for (iterator output = begin(); first != last; ++first, ++output) *output = *first;
+        return *this;
+    }
+
+    /**
+     *  @brief  Overwrites the string with the given initializer list.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_assign` for a cleaner exception-less alternative.
+     */
+    basic_string &assign(std::initializer_list<char_type> ilist) noexcept(false) {
+        return assign(ilist.begin(), ilist.end());
+    }
+
+    /**
+     *  @brief  Appends to the end of the current string.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_append` for a cleaner exception-less alternative.
+     */
+    basic_string &append(string_view str) noexcept(false) {
+        if (!try_append(str)) throw std::bad_alloc();
+        return *this;
+    }
+
+    /**
+     *  @brief  Appends to the end of the current string.
+     *  @throw  `std::length_error` if the string is too long or `pos > str.size()`.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_append` for a cleaner exception-less alternative.
+     */
+    basic_string &append(string_view str, size_type pos, size_type length = npos) noexcept(false) {
+        return append(str.substr(pos, length));
+    }
+
+    /**
+     *  @brief  Appends to the end of the current string.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_append` for a cleaner exception-less alternative.
+     */
+    basic_string &append(const_pointer str, size_type length) noexcept(false) { return append({str, length}); }
+
+    /**
+     *  @brief  Appends to the end of the current string.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_append` for a cleaner exception-less alternative.
+     */
+    basic_string &append(const_pointer str) noexcept(false) { return append(string_view(str)); }
+
+    /**
+     *  @brief  Appends a repeated character to the end of the current string.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_append` for a cleaner exception-less alternative.
+     */
+    basic_string &append(size_type repeats, char_type ch) noexcept(false) {
+        resize(size() + repeats, ch);
+        return *this;
+    }
+
+    /**
+     *  @brief  Appends to the end of the current string.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_append` for a cleaner exception-less alternative.
+     */
+    basic_string &append(std::initializer_list<char_type> other) noexcept(false) {
+        return append(other.begin(), other.end());
+    }
+
+    /**
+     *  @brief  Appends to the end of the current string.
+     *  @throw  `std::length_error` if the string is too long.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     *  @see    `try_append` for a cleaner exception-less alternative.
+     */
+    template <typename input_iterator>
+    basic_string &append(input_iterator first, input_iterator last) noexcept(false) {
+        insert<input_iterator>(cend(), first, last);
+        return *this;
+    }
+
+    basic_string &operator+=(string_view other) noexcept(false) { return append(other); }
+    basic_string &operator+=(std::initializer_list<char_type> other) noexcept(false) { return append(other); }
+    basic_string &operator+=(char_type character) noexcept(false) { return operator+=(string_view(&character, 1)); }
+    basic_string &operator+=(const_pointer other) noexcept(false) { return operator+=(string_view(other)); }
+
+    basic_string operator+(char_type character) const noexcept(false) { return operator+(string_view(&character, 1)); }
+    basic_string operator+(const_pointer other) const noexcept(false) { return operator+(string_view(other)); }
+    basic_string operator+(string_view other) const noexcept(false) {
+        return basic_string {concatenation<string_view, string_view> {view(), other}};
+    }
+    basic_string operator+(std::initializer_list<char_type> other) const noexcept(false) {
+        return basic_string {concatenation<string_view, string_view> {view(), other}};
+    }
+
+#pragma endregion
+#pragma endregion
+
+    concatenation<string_view, string_view> operator|(string_view other) const noexcept { return {view(), other}; }
+
+    size_type edit_distance(string_view other, size_type bound = 0) const noexcept {
+        size_type distance;
+        _with_alloc([&](sz_alloc_type &alloc) {
+            distance = sz_edit_distance(data(), size(), other.data(), other.size(), bound, &alloc);
+            return true;
+        });
+        return distance;
+    }
+
+    /**  @brief  Hashes the string, equivalent to `std::hash<string_view>{}(str)`. */
+    size_type hash() const noexcept { return view().hash(); }
+
+    /**
+     *  @brief  Overwrites the string with random characters from the given alphabet using the random generator.
+     *
+     *  @param  generator  A random generator function object that returns a random number in the range [0, 2^64).
+     *  @param  alphabet   A string of characters to choose from.
+     */
+    template <typename generator_type>
+    basic_string &randomize(generator_type &generator, string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept {
+        sz_ptr_t start;
+        sz_size_t length;
+        sz_string_range(&string_, &start, &length);
+        sz_random_generator_t generator_callback = &_call_random_generator<generator_type>;
+        sz_generate(alphabet.data(), alphabet.size(), start, length, generator_callback, &generator);
+        return *this;
+    }
+
+    /**
+     *  @brief  Overwrites the string with random characters from the given alphabet
+     *          using `std::rand` as the random generator.
+     *
+     *  @param  alphabet   A string of characters to choose from.
+     */
+    basic_string &randomize(string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept {
+        return randomize(&std::rand, alphabet);
+    }
+
+    /**
+     *  @brief  Maps ( @b in-place ) every byte of the string through a lookup table, like `lut[(unsigned char)c]`.
+     *  @see    sz_translate
+     */
+    basic_string &translate(char const (&lut)[256]) noexcept {
+        sz_ptr_t start;
+        sz_size_t length;
+        sz_string_range(&string_, &start, &length);
+        sz_translate(start, length, lut, start);
+        return *this;
+    }
+
+    /**
+     *  @brief  Generate a new random string of given length using `std::rand` as the random generator.
+     *          May throw exceptions if the memory allocation fails.
+     *
+     *  @param  length     The length of the generated string.
+     *  @param  alphabet   A string of characters to choose from.
+     */
+    static basic_string random(size_type length, string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept(false) {
+        return basic_string(length, '\0').randomize(alphabet);
+    }
+
+    /**
+     *  @brief  Generate a new random string of given length using the provided random number generator.
+     *          May throw exceptions if the memory allocation fails.
+     *
+     *  @param  generator  A random generator function object that returns a random number in the range [0, 2^64).
+     *  @param  length     The length of the generated string.
+     *  @param  alphabet   A string of characters to choose from.
+     */
+    template <typename generator_type>
+    static basic_string random(generator_type &generator, size_type length,
+                               string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept(false) {
+        return basic_string(length, '\0').randomize(generator, alphabet);
+    }
+
+    /**
+     *  @brief  Replaces ( @b in-place ) all occurrences of a given string with the ::replacement string.
+     *          Similar to `boost::algorithm::replace_all` and Python's `str.replace`.
+     *
+     *  The implementation is not as composable, as using search ranges combined with a replacing mapping for matches,
+     *  and might be suboptimal, if you are exporting the cleaned-up string to another buffer.
+     *  The algorithm is suboptimal when this string is made exclusively of the pattern.
+     */
+    basic_string &replace_all(string_view pattern, string_view replacement) noexcept(false) {
+        if (!try_replace_all(pattern, replacement)) throw std::bad_alloc();
+        return *this;
+    }
+
+    /**
+     *  @brief  Replaces ( @b in-place ) all occurrences of a given character set with the ::replacement string.
+     *          Similar to `boost::algorithm::replace_all` and Python's `str.replace`.
+     *
+     *  The implementation is not as composable, as using search ranges combined with a replacing mapping for matches,
+     *  and might be suboptimal, if you are exporting the cleaned-up string to another buffer.
+     *  The algorithm is suboptimal when this string is made exclusively of the pattern.
+     */
+    basic_string &replace_all(char_set pattern, string_view replacement) noexcept(false) {
+        if (!try_replace_all(pattern, replacement)) throw std::bad_alloc();
+        return *this;
+    }
+
+    /**
+     *  @brief  Replaces ( @b in-place ) all occurrences of a given string with the ::replacement string.
+     *          Similar to `boost::algorithm::replace_all` and Python's `str.replace`.
+     *
+     *  The implementation is not as composable, as using search ranges combined with a replacing mapping for matches,
+     *  and might be suboptimal, if you are exporting the cleaned-up string to another buffer.
+     *  The algorithm is suboptimal when this string is made exclusively of the pattern.
+     */
+    bool try_replace_all(string_view pattern, string_view replacement) noexcept {
+        return try_replace_all_<string_view>(pattern, replacement);
+    }
+
+    /**
+     *  @brief  Replaces ( @b in-place ) all occurrences of a given character set with the ::replacement string.
+     *          Similar to `boost::algorithm::replace_all` and Python's `str.replace`.
+     *
+     *  The implementation is not as composable, as using search ranges combined with a replacing mapping for matches,
+     *  and might be suboptimal, if you are exporting the cleaned-up string to another buffer.
+     *  The algorithm is suboptimal when this string is made exclusively of the pattern.
+     */
+    bool try_replace_all(char_set pattern, string_view replacement) noexcept {
+        return try_replace_all_<char_set>(pattern, replacement);
+    }
+
+    /**
+     *  @brief  Replaces ( @b in-place ) all occurrences of every compiled needle with its replacement,
+     *          walking through the string just once, instead of chaining `replace_all` for every pair.
+     *          Matches don't overlap, and if several needles match at the same offset, the first one wins.
+     *
+     *  @param  patterns        Compiled needles, like `sz::multi_pattern`.
+     *  @param  replacements    Random-access container of string-like replacements, indexed by the needle ID.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    template <typename pattern_allocator_type_, typename replacements_type_>
+    basic_string &replace_all(basic_multi_pattern<pattern_allocator_type_> const &patterns,
+                              replacements_type_ const &replacements) noexcept(false) {
+        if (!try_replace_all(patterns, replacements)) throw std::bad_alloc();
+        return *this;
+    }
+
+    /**
+     *  @brief  Replaces ( @b in-place ) all occurrences of every pattern with the paired replacement in one pass.
+     *          If several patterns match at the same offset, the first one in the list wins.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    basic_string &replace_all(std::initializer_list<std::pair<string_view, string_view>> pairs) noexcept(false) {
+        if (!try_replace_all(pairs)) throw std::bad_alloc();
+        return *this;
+    }
+
+    /**
+     *  @brief  Replaces ( @b in-place ) all occurrences of every pattern with the paired replacement in one pass.
+     *          If several patterns match at the same offset, the first one in the list wins.
+     *  @return `false` if the allocation fails, leaving the string unchanged.
+     */
+    bool try_replace_all(std::initializer_list<std::pair<string_view, string_view>> pairs) noexcept {
+        std::size_t const count = pairs.size();
+        if (count == 0) return true;
+        auto const *pairs_data = pairs.begin();
+        return _with_alloc([&](sz_alloc_type &alloc) {
+            // The compiled pattern keeps a copy of the needle views, so the temporary array can be freed right away.
+            sz_multi_pattern_t pattern;
+            sz_string_view_t *needles =
+                (sz_string_view_t *)alloc.allocate(count * sizeof(sz_string_view_t), alloc.handle);
+            if (!needles) return false;
+            for (std::size_t i = 0; i != count; ++i)
+                needles[i].start = pairs_data[i].first.data(), needles[i].length = pairs_data[i].first.size();
+            bool compiled = sz_multi_pattern_init(&pattern, needles, count, &alloc) == sz_true_k;
+            alloc.free(needles, count * sizeof(sz_string_view_t), alloc.handle);
+            if (!compiled) return false;
+            bool replaced = try_replace_any_(&pattern, [&](std::size_t id) { return pairs_data[id].second; });
+            sz_multi_pattern_free(&pattern, &alloc);
+            return replaced;
+        });
+    }
+
+    /**
+     *  @brief  Replaces ( @b in-place ) all occurrences of every compiled needle with its replacement in one pass.
+     *          If no replacement is longer than its needle, the string is compacted in-place without allocations.
+     *          Otherwise, it's assembled in a new buffer, that grows geometrically, and swapped with this one.
+     *
+     *  @param  patterns        Compiled needles, like `sz::multi_pattern`.
+     *  @param  replacements    Random-access container of string-like replacements, indexed by the needle ID.
+     *  @return `false` if the allocation fails, leaving the string unchanged.
+     */
+    template <typename pattern_allocator_type_, typename replacements_type_>
+    bool try_replace_all(basic_multi_pattern<pattern_allocator_type_> const &patterns,
+                         replacements_type_ const &replacements) noexcept {
+        return try_replace_any_(patterns.c_pattern(), [&](std::size_t id) { return string_view(replacements[id]); });
+    }
+
+  private:
+    template <typename pattern_type>
+    bool try_replace_all_(pattern_type pattern, string_view replacement) noexcept;
+
+    template <typename replacement_callback_type>
+    bool try_replace_any_(sz_multi_pattern_t const *pattern, replacement_callback_type &&replacement_for) noexcept;
+
+    /**
+     *  @brief  Tries to prepare the string for a replacement of a given range with a new string.
+     *          The allocation may occur, if the replacement is longer than the replaced range.
+     */
+    bool try_preparing_replacement(size_type offset, size_type length, size_type new_length) noexcept;
+};
+
+using string = basic_string<char, std::allocator<char>>;
+
+static_assert(sizeof(string) == 4 * sizeof(void *), "String size must be 4 pointers.");
+
+/**
+ *  @brief  String, that takes its memory from a thread-local arena, to avoid the `malloc` and `free` calls
+ *          for every short-lived string beyond the SSO capacity. Call `arena_allocator::reset()` to release
+ *          all of them at once, once none of them are in use.
+ */
+using arena_string = basic_string<char, arena_allocator>;
+
+namespace literals {
+constexpr string_view operator""_sz(char const *str, std::size_t length) noexcept { return {str, length}; }
+} // namespace literals
+
+template <typename char_type_, typename allocator_>
+bool basic_string<char_type_, allocator_>::try_resize(size_type count, value_type character) noexcept {
+    sz_ptr_t string_start;
+    sz_size_t string_length;
+    sz_size_t string_space;
+    sz_bool_t string_is_external;
+    sz_string_unpack(&string_, &string_start, &string_length, &string_space, &string_is_external);
+
+    // Allocate more space if needed.
+    if (count >= string_space) {
+        if (!_with_alloc(
+                [&](sz_alloc_type &alloc) { return sz_string_expand(&string_, SZ_SIZE_MAX, count, &alloc) != NULL; }))
+            return false;
+        sz_string_unpack(&string_, &string_start, &string_length, &string_space, &string_is_external);
+    }
+
+    // Fill the trailing characters.
+    if (count > string_length) {
+        sz_fill(string_start + string_length, count - string_length, character);
+        string_start[count] = '\0';
+        // Knowing the layout of the string, we can perform this operation safely,
+        // even if its located on stack.
+        string_.external.length += count - string_length;
+    }
+    else { sz_string_erase(&string_, count, SZ_SIZE_MAX); }
+    return true;
+}
+
+template <typename char_type_, typename allocator_>
+bool basic_string<char_type_, allocator_>::try_assign(string_view other) noexcept {
+    // We can't just assign the other string state, as its start address may be somewhere else on the stack.
+    sz_ptr_t string_start;
+    sz_size_t string_length;
+    sz_string_range(&string_, &string_start, &string_length);
+
+    if (string_length >= other.length()) {
+        other.copy(string_start, other.length());
+        sz_string_erase(&string_, other.length(), SZ_SIZE_MAX);
+    }
+    else {
+        if (!_with_alloc([&](sz_alloc_type &alloc) {
+                string_start = sz_string_expand(&string_, SZ_SIZE_MAX, other.length(), &alloc);
+                if (!string_start) return false;
+                other.copy(string_start, other.length());
+                return true;
+            }))
+            return false;
+    }
+    return true;
+}
+
+template <typename char_type_, typename allocator_>
 bool basic_string<char_type_, allocator_>::try_push_back(char_type c) noexcept {
     return _with_alloc([&](sz_alloc_type &alloc) {
         auto old_size = size();
-        sz_ptr_t start = sz_string_expand(&string_, SZ_SIZE_MAX, 1, &alloc);
+        sz_ptr_t start = sz_string_expand(&string_, SZ_SIZE_MAX, 1, &alloc);
+        if (!start) return false;
+        start[old_size] = c;
+        return true;
+    });
+}
+
+template <typename char_type_, typename allocator_>
+bool basic_string<char_type_, allocator_>::try_append(const_pointer str, size_type length) noexcept {
+    return _with_alloc([&](sz_alloc_type &alloc) {
+        auto old_size = size();
+        sz_ptr_t start = sz_string_expand(&string_, SZ_SIZE_MAX, length, &alloc);
         if (!start) return false;
-        start[old_size] = c;
+        sz_copy(start + old_size, str, length);
+        return true;
+    });
+}
+
+template <typename char_type_, typename allocator_>
+template <typename pattern_type>
+bool basic_string<char_type_, allocator_>::try_replace_all_(pattern_type pattern, string_view replacement) noexcept {
+    // Depending on the size of the pattern and the replacement, we may need to allocate more space.
+    // There are 3 cases to consider:
+    // 1. The pattern and the replacement are of the same length. Piece of cake!
+    // 2. The pattern is longer than the replacement. We need to compact the strings.
+    // 3. The pattern is shorter than the replacement. We may have to allocate more memory.
+    using matcher_type = typename std::conditional<std::is_same<pattern_type, char_set>::value,
+                                                   matcher_find_first_of<string_view, pattern_type>,
+                                                   matcher_find<string_view, exclude_overlaps_type>>::type;
+    matcher_type matcher({pattern});
+    string_view this_view = view();
+
+    // 1. The pattern and the replacement are of the same length.
+    if (matcher.needle_length() == replacement.length()) {
+        using matches_type = range_matches<string_view, matcher_type>;
+        // Instead of iterating with `begin()` and `end()`, we could use the cheaper sentinel-based approach.
+        //      for (string_view match : matches) { ... }
+        matches_type matches = matches_type(this_view, {pattern});
+        for (auto matches_iterator = matches.begin(); matches_iterator != end_sentinel_type {}; ++matches_iterator) {
+            replacement.copy(const_cast<pointer>((*matches_iterator).data()));
+        }
+        return true;
+    }
+
+    // 2. The pattern is longer than the replacement. We need to compact the strings.
+    else if (matcher.needle_length() > replacement.length()) {
+        // Dealing with shorter replacements, we will avoid memory allocations, but we can also mimnimize the number
+        // of `memmove`-s, by keeping one more iterator, pointing to the end of the last compacted area.
+        // Having the split-ranges, however, we reuse their logic.
+        using splits_type = range_splits<string_view, matcher_type>;
+        splits_type splits = splits_type(this_view, {pattern});
+        auto matches_iterator = splits.begin();
+        auto compacted_end = (*matches_iterator).end();
+        if (compacted_end == end()) return true; // No matches.
+
+        ++matches_iterator; // Skip the first match.
+        do {
+            string_view match_view = *matches_iterator;
+            replacement.copy(const_cast<pointer>(compacted_end));
+            compacted_end += replacement.length();
+            sz_move((sz_ptr_t)compacted_end, match_view.begin(), match_view.length());
+            compacted_end += match_view.length();
+            ++matches_iterator;
+        } while (matches_iterator != end_sentinel_type {});
+
+        // Can't fail, so let's just return true :)
+        try_resize(compacted_end - begin());
+        return true;
+    }
+
+    // 3. The pattern is shorter than the replacement. We may have to allocate more memory.
+    else {
+        using rmatcher_type = typename std::conditional<std::is_same<pattern_type, char_set>::value,
+                                                        matcher_find_last_of<string_view, pattern_type>,
+                                                        matcher_rfind<string_view, exclude_overlaps_type>>::type;
+        using rmatches_type = range_rmatches<string_view, rmatcher_type>;
+        rmatches_type rmatches = rmatches_type(this_view, {pattern});
+
+        // It's cheaper to iterate through the whole string once, counting the number of matches,
+        // reserving memory once, than re-allocating and copying the string multiple times.
+        auto matches_count = rmatches.size();
+        if (matches_count == 0) return true; // No matches.
+
+        // TODO: Resize without initializing the memory.
+        auto replacement_delta_length = replacement.length() - matcher.needle_length();
+        auto added_length = matches_count * replacement_delta_length;
+        auto old_length = size();
+        auto new_length = old_length + added_length;
+        if (!try_resize(new_length)) return false;
+        this_view = view().front(old_length);
+
+        // Now iterate through splits similarly to the 2nd case, but in reverse order.
+        using rsplits_type = range_rsplits<string_view, rmatcher_type>;
+        rsplits_type splits = rsplits_type(this_view, {pattern});
+        auto splits_iterator = splits.begin();
+
+        // Put the compacted pointer to the end of the new string, and walk left.
+        auto compacted_begin = this_view.data() + new_length;
+
+        // By now we know that at least one match exists, which means the splits .
+        do {
+            string_view slice_view = *splits_iterator;
+            compacted_begin -= slice_view.length();
+            sz_move((sz_ptr_t)compacted_begin, slice_view.begin(), slice_view.length());
+            compacted_begin -= replacement.length();
+            replacement.copy(const_cast<pointer>(compacted_begin));
+            ++splits_iterator;
+        } while (!splits_iterator.is_last());
+
+        return true;
+    }
+}
+
+template <typename char_type_, typename allocator_>
+template <typename replacement_callback_type>
+bool basic_string<char_type_, allocator_>::try_replace_any_(sz_multi_pattern_t const *pattern,
+                                                            replacement_callback_type &&replacement_for) noexcept {
+    sz_ptr_t start;
+    sz_size_t length;
+    sz_string_range(&string_, &start, &length);
+    sz_cptr_t const end = start + length;
+    sz_cptr_t match, read = start;
+    sz_size_t needle_id;
+
+    // If none of the replacements is longer than its needle, the writes never outrun the reads,
+    // and the string can be compacted in-place, similar to the 2nd case of `try_replace_all_`.
+    bool may_grow = false;
+    for (std::size_t id = 0; id != pattern->count; ++id) {
+        sz_size_t needle_length = pattern->needles[id].length;
+        may_grow |= needle_length && string_view(replacement_for(id)).size() > needle_length;
+    }
+
+    if (!may_grow) {
+        sz_ptr_t write = start;
+        bool matched = false;
+        while ((match = sz_find_any(pattern, read, static_cast<sz_size_t>(end - read), &needle_id))) {
+            string_view replacement = replacement_for(needle_id);
+            sz_move(write, read, static_cast<sz_size_t>(match - read));
+            write += match - read;
+            sz_move(write, replacement.data(), replacement.size());
+            write += replacement.size();
+            read = match + pattern->needles[needle_id].length;
+            matched = true;
+        }
+        if (!matched) return true;
+        sz_move(write, read, static_cast<sz_size_t>(end - read));
+        write += end - read;
+        sz_string_erase(&string_, static_cast<sz_size_t>(write - start), SZ_SIZE_MAX);
+        return true;
+    }
+
+    // Otherwise, assemble the result in a new buffer, that grows geometrically, as the replacements are appended.
+    basic_string result;
+    while ((match = sz_find_any(pattern, read, static_cast<sz_size_t>(end - read), &needle_id))) {
+        string_view replacement = replacement_for(needle_id);
+        if (read == start && !result.try_reserve(length + length / 8)) return false;
+        if (!result.try_append(read, static_cast<size_type>(match - read)) || !result.try_append(replacement))
+            return false;
+        read = match + pattern->needles[needle_id].length;
+    }
+    if (read == start) return true; // No matches.
+    if (!result.try_append(read, static_cast<size_type>(end - read))) return false;
+    swap(result);
+    return true;
+}
+
+template <typename char_type_, typename allocator_>
+template <typename first_type, typename second_type>
+bool basic_string<char_type_, allocator_>::try_assign(concatenation<first_type, second_type> const &other) noexcept {
+    // We can't just assign the other string state, as its start address may be somewhere else on the stack.
+    sz_ptr_t string_start;
+    sz_size_t string_length;
+    sz_string_range(&string_, &string_start, &string_length);
+
+    if (string_length >= other.length()) {
+        sz_string_erase(&string_, other.length(), SZ_SIZE_MAX);
+        other.copy(string_start, other.length());
+    }
+    else {
+        if (!_with_alloc([&](sz_alloc_type &alloc) {
+                string_start = sz_string_expand(&string_, SZ_SIZE_MAX, other.length(), &alloc);
+                if (!string_start) return false;
+                other.copy(string_start, other.length());
+                return true;
+            }))
+            return false;
+    }
+    return true;
+}
+
+template <typename char_type_, typename allocator_>
+bool basic_string<char_type_, allocator_>::try_preparing_replacement(size_type offset, size_type length,
+                                                                     size_type replacement_length) noexcept {
+    // There are three cases:
+    // 1. The replacement is the same length as the replaced range.
+    // 2. The replacement is shorter than the replaced range.
+    // 3. The replacement is longer than the replaced range. An allocation may occur.
+    assert(offset + length <= size());
+
+    // 1. The replacement is the same length as the replaced range.
+    if (replacement_length == length) { return true; }
+
+    // 2. The replacement is shorter than the replaced range.
+    else if (replacement_length < length) {
+        sz_string_erase(&string_, offset + replacement_length, length - replacement_length);
         return true;
+    }
+    // 3. The replacement is longer than the replaced range. An allocation may occur.
+    else {
+        return _with_alloc([&](sz_alloc_type &alloc) {
+            return sz_string_expand(&string_, offset + length, replacement_length - length, &alloc);
+        });
+    }
+}
+
+/**  @brief  SFINAE-type used to infer the resulting type of concatenating multiple string together. */
+template <typename... args_types>
+struct concatenation_result {};
+
+template <typename first_type, typename second_type>
+struct concatenation_result<first_type, second_type> {
+    using type = concatenation<first_type, second_type>;
+};
+
+template <typename first_type, typename... following_types>
+struct concatenation_result<first_type, following_types...> {
+    using type = concatenation<first_type, typename concatenation_result<following_types...>::type>;
+};
+
+/**
+ *  @brief  Concatenates two strings into a template expression.
+ *  @see    `concatenation` class for more details.
+ */
+template <typename first_type, typename second_type>
+concatenation<first_type, second_type> concatenate(first_type &&first, second_type &&second) noexcept(false) {
+    return {first, second};
+}
+
+/**
+ *  @brief  Concatenates two or more strings into a template expression.
+ *  @see    `concatenation` class for more details.
+ */
+template <typename first_type, typename second_type, typename... following_types>
+typename concatenation_result<first_type, second_type, following_types...>::type concatenate(
+    first_type &&first, second_type &&second, following_types &&...following) noexcept(false) {
+    // Fold expression like the one below would result in faster compile times,
+    // but would incur the penalty of additional `if`-statements in every `append` call.
+    // Moreover, those are only supported in C++17 and later.
+    //      std::size_t total_size = (strings.size() + ... + 0);
+    //      std::string result;
+    //      result.reserve(total_size);
+    //      (result.append(strings), ...);
+    return ashvardanian::stringzilla::concatenate(
+        std::forward<first_type>(first),
+        ashvardanian::stringzilla::concatenate(std::forward<second_type>(second),
+                                               std::forward<following_types>(following)...));
+}
+
+/**
+ *  @brief  Calculates the Hamming edit distance in @b bytes between two strings.
+ *  @see    sz_edit_distance
+ */
+template <typename char_type_>
+std::size_t hamming_distance(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
+                             std::size_t bound = 0) noexcept {
+    return sz_hamming_distance(a.data(), a.size(), b.data(), b.size(), bound);
+}
+
+/**
+ *  @brief  Calculates the Hamming edit distance in @b bytes between two strings.
+ *  @see    sz_edit_distance
+ */
+template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
+std::size_t hamming_distance(basic_string<char_type_, allocator_type_> const &a,
+                             basic_string<char_type_, allocator_type_> const &b, std::size_t bound = 0) noexcept {
+    return ashvardanian::stringzilla::hamming_distance(a.view(), b.view(), bound);
+}
+
+/**
+ *  @brief  Calculates the Hamming edit distance in @b unicode codepoints between two strings.
+ *  @see    sz_hamming_distance_utf8
+ */
+template <typename char_type_>
+std::size_t hamming_distance_utf8(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
+                                  std::size_t bound = 0) noexcept {
+    return sz_hamming_distance_utf8(a.data(), a.size(), b.data(), b.size(), bound);
+}
+
+/**
+ *  @brief  Calculates the Hamming edit distance in @b unicode codepoints between two strings.
+ *  @see    sz_edit_distance
+ */
+template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
+std::size_t hamming_distance_utf8(basic_string<char_type_, allocator_type_> const &a,
+                                  basic_string<char_type_, allocator_type_> const &b, std::size_t bound = 0) noexcept {
+    return ashvardanian::stringzilla::hamming_distance_utf8(a.view(), b.view(), bound);
+}
+
+/**
+ *  @brief  Calculates the Levenshtein edit distance in @b bytes between two strings.
+ *  @see    sz_edit_distance
+ */
+template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
+std::size_t edit_distance(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
+                          std::size_t bound = 0, allocator_type_ &&allocator = allocator_type_ {}) noexcept(false) {
+    std::size_t result;
+    if (!_with_alloc(allocator, [&](sz_memory_allocator_t &alloc) {
+            result = sz_edit_distance(a.data(), a.size(), b.data(), b.size(), bound, &alloc);
+            return result != SZ_SIZE_MAX;
+        }))
+        throw std::bad_alloc();
+    return result;
+}
+
+/**
+ *  @brief  Calculates the Levenshtein edit distance in @b bytes between two strings.
+ *  @see    sz_edit_distance
+ */
+template <typename char_type_, typename allocator_type_ = std::allocator<char_type_>>
+std::size_t edit_distance(basic_string<char_type_, allocator_type_> const &a,
+                          basic_string<char_type_, allocator_type_> const &b, std::size_t bound = 0) noexcept(false) {
+    return ashvardanian::stringzilla::edit_distance(a.view(), b.view(), bound, a.get_allocator());
+}
+
+/**
+ *  @brief  Calculates the Levenshtein edit distance in @b unicode codepoints between two strings.
+ *  @see    sz_edit_distance_utf8
+ */
+template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
+std::size_t edit_distance_utf8(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
+                               std::size_t bound = 0,
+                               allocator_type_ &&allocator = allocator_type_ {}) noexcept(false) {
+    std::size_t result;
+    if (!_with_alloc(allocator, [&](sz_memory_allocator_t &alloc) {
+            result = sz_edit_distance_utf8(a.data(), a.size(), b.data(), b.size(), bound, &alloc);
+            return result != SZ_SIZE_MAX;
+        }))
+        throw std::bad_alloc();
+    return result;
+}
+
+/**
+ *  @brief  Calculates the Levenshtein edit distance in @b unicode codepoints between two strings.
+ *  @see    sz_edit_distance_utf8
+ */
+template <typename char_type_, typename allocator_type_ = std::allocator<char_type_>>
+std::size_t edit_distance_utf8(basic_string<char_type_, allocator_type_> const &a,
+                               basic_string<char_type_, allocator_type_> const &b,
+                               std::size_t bound = 0) noexcept(false) {
+    return ashvardanian::stringzilla::edit_distance_utf8(a.view(), b.view(), bound, a.get_allocator());
+}
+
+/**
+ *  @brief  Calculates the Needleman-Wunsch alignment score between two strings.
+ *  @see    sz_alignment_score
+ */
+template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
+std::ptrdiff_t alignment_score(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
+                               std::int8_t const (&subs)[256][256], std::int8_t gap = -1,
+                               allocator_type_ &&allocator = allocator_type_ {}) noexcept(false) {
+
+    static_assert(sizeof(sz_error_cost_t) == sizeof(std::int8_t), "sz_error_cost_t must be 8-bit.");
+    static_assert(std::is_signed<sz_error_cost_t>() == std::is_signed<std::int8_t>(),
+                  "sz_error_cost_t must be signed.");
+
+    std::ptrdiff_t result;
+    if (!_with_alloc(allocator, [&](sz_memory_allocator_t &alloc) {
+            result = sz_alignment_score(a.data(), a.size(), b.data(), b.size(), &subs[0][0], gap, &alloc);
+            return result != SZ_SSIZE_MAX;
+        }))
+        throw std::bad_alloc();
+    return result;
+}
+
+/**
+ *  @brief  Calculates the Needleman-Wunsch alignment score between two strings.
+ *  @see    sz_alignment_score
+ */
+template <typename char_type_, typename allocator_type_ = std::allocator<char_type_>>
+std::ptrdiff_t alignment_score(basic_string<char_type_, allocator_type_> const &a,
+                               basic_string<char_type_, allocator_type_> const &b, //
+                               std::int8_t const (&subs)[256][256], std::int8_t gap = -1) noexcept(false) {
+    return ashvardanian::stringzilla::alignment_score(a.view(), b.view(), subs, gap, a.get_allocator());
+}
+
+/**
+ *  @brief  Overwrites the string slice with random characters from the given alphabet using the random generator.
+ *
+ *  @param  string     The string to overwrite.
+ *  @param  generator  A random generator function object that returns a random number in the range [0, 2^64).
+ *  @param  alphabet   A string of characters to choose from.
+ */
+template <typename char_type_, typename generator_type_>
+void randomize(basic_string_slice<char_type_> string, generator_type_ &generator,
+               string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept {
+    static_assert(!std::is_const<char_type_>::value, "The string must be mutable.");
+    sz_random_generator_t generator_callback = &_call_random_generator<generator_type_>;
+    sz_generate(alphabet.data(), alphabet.size(), string.data(), string.size(), generator_callback, &generator);
+}
+
+/**
+ *  @brief  Overwrites the string slice with random characters from the given alphabet
+ *          using `std::rand` as the random generator.
+ *
+ *  @param  string     The string to overwrite.
+ *  @param  alphabet   A string of characters to choose from.
+ */
+template <typename char_type_>
+void randomize(basic_string_slice<char_type_> string, string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept {
+    randomize(string, &std::rand, alphabet);
+}
+
+/**
+ *  @brief  Maps ( @b in-place ) every byte of the string slice through a lookup table, like `lut[(unsigned char)c]`.
+ *
+ *  @param  string  The string to overwrite.
+ *  @param  lut     Lookup table with the output byte for every possible input byte.
+ *  @see    sz_translate
+ */
+template <typename char_type_>
+void translate(basic_string_slice<char_type_> string, char const (&lut)[256]) noexcept {
+    static_assert(!std::is_const<char_type_>::value, "The string must be mutable.");
+    sz_translate(string.data(), string.size(), lut, string.data());
+}
+
+/**
+ *  @brief  Maps every byte of the @p source through a lookup table, exporting into the @p target of the same size.
+ *  @see    sz_translate
+ */
+template <typename char_type_>
+void translate(string_view source, char const (&lut)[256], basic_string_slice<char_type_> target) noexcept {
+    static_assert(!std::is_const<char_type_>::value, "The target must be mutable.");
+    assert(source.size() == target.size() && "The source and the target must have the same size.");
+    sz_translate(source.data(), source.size(), lut, target.data());
+}
+
+using sorted_idx_t = sz_sorted_idx_t;
+
+/**
+ *  @brief  Internal data-structure used to forward the arguments to the `sz_sort` function.
+ *  @see    sorted_order
+ */
+template <typename objects_type_, typename string_extractor_>
+struct _sequence_args {
+    objects_type_ const *begin;
+    std::size_t count;
+    sorted_idx_t *order;
+    string_extractor_ extractor;
+};
+
+template <typename objects_type_, typename string_extractor_>
+sz_cptr_t _call_sequence_member_start(struct sz_sequence_t const *sequence, sz_size_t i) {
+    using handle_type = _sequence_args<objects_type_, string_extractor_>;
+    handle_type const *args = reinterpret_cast<handle_type const *>(sequence->handle);
+    string_view member = args->extractor(args->begin[i]);
+    return member.data();
+}
+
+template <typename objects_type_, typename string_extractor_>
+sz_size_t _call_sequence_member_length(struct sz_sequence_t const *sequence, sz_size_t i) {
+    using handle_type = _sequence_args<objects_type_, string_extractor_>;
+    handle_type const *args = reinterpret_cast<handle_type const *>(sequence->handle);
+    string_view member = args->extractor(args->begin[i]);
+    return static_cast<sz_size_t>(member.size());
+}
+
+/**
+ *  @brief  Computes the permutation of an array, that would lead to sorted order.
+ *          The elements of the array must be convertible to a `string_view` with the given extractor.
+ *          Unlike the `sz_sort` C interface, overwrites the output array.
+ *
+ *  @param[in] begin       The pointer to the first element of the array.
+ *  @param[in] end         The pointer to the element after the last element of the array.
+ *  @param[out] order      The pointer to the output array of indices, that will be populated with the permutation.
+ *  @param[in] extractor   The function object that extracts the string from the object.
+ *
+ *  @see    sz_sort
+ */
+template <typename objects_type_, typename string_extractor_>
+void sorted_order(objects_type_ const *begin, objects_type_ const *end, sorted_idx_t *order,
+                  string_extractor_ &&extractor) noexcept {
+
+    // Pack the arguments into a single structure to reference it from the callback.
+    _sequence_args<objects_type_, string_extractor_> args = {begin, static_cast<std::size_t>(end - begin), order,
+                                                             std::forward<string_extractor_>(extractor)};
+    // Populate the array with `iota`-style order.
+    for (std::size_t i = 0; i != args.count; ++i) order[i] = static_cast<sorted_idx_t>(i);
+
+    sz_sequence_t array;
+    array.order = reinterpret_cast<sorted_idx_t *>(order);
+    array.count = args.count;
+    array.handle = &args;
+    array.get_start = _call_sequence_member_start<objects_type_, string_extractor_>;
+    array.get_length = _call_sequence_member_length<objects_type_, string_extractor_>;
+    sz_sort(&array);
+}
+
+template <typename executor_type_>
+static void _call_parallel_for(sz_task_t task, void *task_state, sz_size_t tasks_count, void *handle) noexcept {
+    executor_type_ &executor = *reinterpret_cast<executor_type_ *>(handle);
+    executor(static_cast<std::size_t>(tasks_count), [=](std::size_t task_index) { task(task_state, task_index); });
+}
+
+/**
+ *  @brief  Computes the permutation of an array, that would lead to sorted order, using multiple threads.
+ *          The elements of the array must be convertible to a `string_view` with the given extractor.
+ *          Unlike the `sz_sort_parallel` C interface, overwrites the output array.
+ *
+ *  @param[in] begin           The pointer to the first element of the array.
+ *  @param[in] end             The pointer to the element after the last element of the array.
+ *  @param[out] order          The pointer to the output array of indices, that will be populated with the permutation.
+ *  @param[in] extractor       The thread-safe function object that extracts the string from the object.
+ *  @param[in] executor        The thread-pool, callable with a number of tasks and a function object, that must
+ *                             be invoked with every task index in `[0, tasks_count)` before returning.
+ *  @param[in] threads_count   The number of threads in the ::executor, used to balance the work.
+ *
+ *  @see    sz_sort_parallel
+ */
+template <typename objects_type_, typename string_extractor_, typename executor_type_>
+void sorted_order(objects_type_ const *begin, objects_type_ const *end, sorted_idx_t *order,
+                  string_extractor_ &&extractor, executor_type_ &&executor, std::size_t threads_count) noexcept {
+
+    // Pack the arguments into a single structure to reference it from the callback.
+    _sequence_args<objects_type_, string_extractor_> args = {begin, static_cast<std::size_t>(end - begin), order,
+                                                             std::forward<string_extractor_>(extractor)};
+    // Populate the array with `iota`-style order.
+    for (std::size_t i = 0; i != args.count; ++i) order[i] = static_cast<sorted_idx_t>(i);
+
+    sz_sequence_t array;
+    array.order = reinterpret_cast<sorted_idx_t *>(order);
+    array.count = args.count;
+    array.handle = &args;
+    array.get_start = _call_sequence_member_start<objects_type_, string_extractor_>;
+    array.get_length = _call_sequence_member_length<objects_type_, string_extractor_>;
+
+    using executor_type = typename std::remove_reference<executor_type_>::type;
+    sz_executor_t pool;
+    pool.parallel_for = &_call_parallel_for<executor_type>;
+    pool.threads_count = threads_count;
+    pool.handle = (void *)&executor;
+    sz_sort_parallel(&array, &pool);
+}
+
+/**
+ *  @brief  Helper function for the parallel algorithms, that locates all matches with ::sz_find_all_parallel
+ *          and passes their offsets to the @p callback, before releasing them.
+ *  @throw  `std::bad_alloc` if the offsets couldn't be allocated.
+ */
+template <typename executor_type_, typename offsets_callback_>
+void _find_all_parallel(string_view h, string_view n, bool skip_overlapping, executor_type_ &executor,
+                        std::size_t threads_count, offsets_callback_ &&callback) noexcept(false) {
+    sz_executor_t pool;
+    pool.parallel_for = &_call_parallel_for<executor_type_>;
+    pool.threads_count = threads_count;
+    pool.handle = (void *)&executor;
+    sz_size_t *offsets = nullptr;
+    sz_size_t count = 0;
+    bool succeeded = _with_alloc<std::allocator<char>>([&](sz_memory_allocator_t &alloc) {
+        return sz_find_all_parallel(h.data(), h.size(), n.data(), n.size(), skip_overlapping ? sz_true_k : sz_false_k,
+                                    &offsets, &count, &alloc, &pool) == sz_true_k;
     });
+    if (!succeeded) throw std::bad_alloc();
+
+    // The callback may throw, like when the container of matches can't grow, so the offsets are released
+    // by a scope guard, outside of the `noexcept` allocator wrapper.
+    struct offsets_guard_t {
+        sz_size_t *offsets;
+        sz_size_t count;
+        ~offsets_guard_t() noexcept {
+            if (!offsets) return;
+            _with_alloc<std::allocator<char>>([&](sz_memory_allocator_t &alloc) {
+                alloc.free(offsets, count * sizeof(sz_size_t), alloc.handle);
+                return true;
+            });
+        }
+    } const guard = {offsets, count};
+    callback(static_cast<std::size_t const *>(guard.offsets), static_cast<std::size_t>(guard.count));
+}
+
+/**
+ *  @brief  Find all potentially @b overlapping inclusions of a needle substring, using multiple threads.
+ *          Appends them to the @p matches in the same order, as the single-threaded `find_all`.
+ *
+ *  @param[in] h               The haystack, split into shards, searched on different threads.
+ *  @param[in] n               The needle.
+ *  @param[out] matches        The container supporting `push_back`, that will be populated with the slices.
+ *  @param[in] executor        The thread-pool, callable with a number of tasks and a function object, that must
+ *                             be invoked with every task index in `[0, tasks_count)` before returning.
+ *  @param[in] threads_count   The number of threads in the ::executor, used to balance the work.
+ *  @see    sz_find_all_parallel
+ */
+template <typename string, typename container_, typename executor_type_>
+void find_all(string const &h, string const &n, container_ &matches, executor_type_ &&executor,
+              std::size_t threads_count, include_overlaps_type = {}) noexcept(false) {
+    using executor_type = typename std::remove_reference<executor_type_>::type;
+    _find_all_parallel<executor_type>(
+        {h.data(), h.size()}, {n.data(), n.size()}, false, executor, threads_count,
+        [&](std::size_t const *offsets, std::size_t count) {
+            for (std::size_t i = 0; i != count; ++i) matches.push_back(h.substr(offsets[i], n.size()));
+        });
+}
+
+/**
+ *  @brief  Find all @b non-overlapping inclusions of a needle substring, using multiple threads.
+ *          Appends them to the @p matches in the same order, as the single-threaded `find_all`.
+ *  @see    sz_find_all_parallel
+ */
+template <typename string, typename container_, typename executor_type_>
+void find_all(string const &h, string const &n, container_ &matches, executor_type_ &&executor,
+              std::size_t threads_count, exclude_overlaps_type) noexcept(false) {
+    using executor_type = typename std::remove_reference<executor_type_>::type;
+    _find_all_parallel<executor_type>(
+        {h.data(), h.size()}, {n.data(), n.size()}, true, executor, threads_count,
+        [&](std::size_t const *offsets, std::size_t count) {
+            for (std::size_t i = 0; i != count; ++i) matches.push_back(h.substr(offsets[i], n.size()));
+        });
+}
+
+/**
+ *  @brief  Splits a string around every @b non-overlapping inclusion of the second string, using multiple threads.
+ *          Appends the parts to the @p parts in the same order, as the single-threaded `split`.
+ *  @see    sz_find_all_parallel
+ */
+template <typename string, typename container_, typename executor_type_>
+void split(string const &h, string const &n, container_ &parts, executor_type_ &&executor,
+           std::size_t threads_count) noexcept(false) {
+    using executor_type = typename std::remove_reference<executor_type_>::type;
+    _find_all_parallel<executor_type>(
+        {h.data(), h.size()}, {n.data(), n.size()}, true, executor, threads_count,
+        [&](std::size_t const *offsets, std::size_t count) {
+            std::size_t part_start = 0;
+            for (std::size_t i = 0; i != count; ++i) {
+                parts.push_back(h.substr(part_start, offsets[i] - part_start));
+                part_start = offsets[i] + n.size();
+            }
+            parts.push_back(h.substr(part_start, h.size() - part_start));
+        });
 }
 
-template <typename char_type_, typename allocator_>
-bool basic_string<char_type_, allocator_>::try_append(const_pointer str, size_type length) noexcept {
-    return _with_alloc([&](sz_alloc_type &alloc) {
-        auto old_size = size();
-        sz_ptr_t start = sz_string_expand(&string_, SZ_SIZE_MAX, length, &alloc);
-        if (!start) return false;
-        sz_copy(start + old_size, str, length);
-        return true;
-    });
-}
+#pragma region Streaming Search
+
+/**
+ *  @brief  Substring search over a sequence of chunks, like socket reads or memory-mapped pages, reporting the
+ *          absolute offsets of matches, including the ones straddling the chunk boundaries. Chunks aren't copied.
+ *          The needle must outlive the stream.
+ *
+ *  @tparam overlaps_type   Either `include_overlaps_type` or `exclude_overlaps_type`.
+ *  @see    sz_find_stream_feed
+ */
+template <typename overlaps_type = include_overlaps_type>
+class find_stream {
+    sz_find_stream_t stream_;
+
+    template <typename callback_type_>
+    static void _forward(sz_size_t offset, void *handle) noexcept {
+        (*reinterpret_cast<callback_type_ *>(handle))(static_cast<std::size_t>(offset));
+    }
+
+  public:
+    find_stream(string_view needle) noexcept { reset(needle); }
+
+    void reset(string_view needle) noexcept {
+        sz_bool_t skip_overlapping = std::is_same<overlaps_type, exclude_overlaps_type>::value ? sz_true_k : sz_false_k;
+        sz_find_stream_init(&stream_, needle.data(), needle.size(), skip_overlapping);
+    }
+
+    /**
+     *  @brief  Continues the search in the next chunk of the input.
+     *  @param  callback    Invoked with the absolute offset of every match, in the increasing order.
+     *  @return Number of matches reported.
+     */
+    template <typename callback_type_>
+    std::size_t feed(string_view chunk, callback_type_ &&callback) noexcept {
+        using callback_type = typename std::remove_reference<callback_type_>::type;
+        return sz_find_stream_feed(&stream_, chunk.data(), chunk.size(), &_forward<callback_type>,
+                                   (void *)std::addressof(callback));
+    }
+
+    /** @brief  Number of bytes fed so far, or the absolute offset of the next chunk. */
+    std::size_t offset() const noexcept { return stream_.offset; }
+    /** @brief  Number of trailing bytes fed so far, that may be a part of a match straddling the next chunk. */
+    std::size_t pending_length() const noexcept { return stream_.matched_prefix; }
+    string_view needle() const noexcept { return {stream_.needle, stream_.needle_length}; }
+};
+
+/**
+ *  @brief  Splits a sequence of chunks, like socket reads, by a substring delimiter, mimicking `range_splits`.
+ *          Every piece is reported as one or more fragments, the last of which is marked as `complete`.
+ *          Fragments point into the fed chunks, or into the delimiter, if the piece ends with the bytes withheld
+ *          from the previous chunk, as a possible beginning of a straddling delimiter. No bytes are copied.
+ *
+ *  @code{.cpp}
+ *      sz::split_stream lines("\r\n");
+ *      std::string line;
+ *      auto on_fragment = [&](sz::string_view fragment, bool complete) {
+ *          line.append(fragment.data(), fragment.size());
+ *          if (complete) handle(line), line.clear();
+ *      };
+ *      while (auto chunk = read_from_socket()) lines.feed(chunk, on_fragment);
+ *      lines.finish(on_fragment);
+ *  @endcode
+ */
+class split_stream {
+    find_stream<exclude_overlaps_type> matches_;
+    std::size_t emitted_until_ = 0;
+
+    /**
+     *  @brief  Reports the `[from, until)` absolute range of input, where the `chunk` starts at `chunk_offset`,
+     *          and the `withheld_length` bytes before it, not emitted before, are equal to the delimiter prefix.
+     */
+    template <typename callback_type_>
+    void _emit(std::size_t from, std::size_t until, bool complete, string_view chunk, std::size_t chunk_offset,
+               std::size_t withheld_length, callback_type_ &callback) const noexcept {
+        if (from < chunk_offset) {
+            std::size_t withheld_until = (std::min)(until, chunk_offset);
+            std::size_t withheld_offset = chunk_offset - withheld_length;
+            callback(string_view(matches_.needle().data() + (from - withheld_offset), withheld_until - from),
+                     complete && until <= chunk_offset);
+            if (until <= chunk_offset) return;
+            from = chunk_offset;
+        }
+        if (from < until || complete) callback(string_view(chunk.data() + (from - chunk_offset), until - from), complete);
+    }
+
+  public:
+    split_stream(string_view delimiter) noexcept : matches_(delimiter) {}
+
+    /**
+     *  @brief  Continues splitting with the next chunk of the input.
+     *  @param  callback    Invoked with a `string_view` fragment and a `bool` flag, marking the end of a piece.
+     *  @return Number of complete pieces reported.
+     */
+    template <typename callback_type_>
+    std::size_t feed(string_view chunk, callback_type_ &&callback) noexcept {
+        std::size_t const chunk_offset = matches_.offset();
+        std::size_t const withheld_length = matches_.pending_length();
+        std::size_t const delimiter_length = matches_.needle().size();
+        std::size_t pieces = matches_.feed(chunk, [&](std::size_t match) noexcept {
+            _emit(emitted_until_, match, true, chunk, chunk_offset, withheld_length, callback);
+            emitted_until_ = match + delimiter_length;
+        });
+        // Emit everything, but the possible beginning of the next straddling delimiter.
+        std::size_t safe_until = matches_.offset() - matches_.pending_length();
+        if (emitted_until_ < safe_until)
+            _emit(emitted_until_, safe_until, false, chunk, chunk_offset, withheld_length, callback),
+                emitted_until_ = safe_until;
+        return pieces;
+    }
+
+    /**
+     *  @brief  Reports the last piece after the end of the input, even if it's empty, and resets the stream.
+     */
+    template <typename callback_type_>
+    void finish(callback_type_ &&callback) noexcept {
+        std::size_t const offset = matches_.offset();
+        _emit(emitted_until_, offset, true, {}, offset, matches_.pending_length(), callback);
+        matches_.reset(matches_.needle());
+        emitted_until_ = 0;
+    }
+};
+
+#pragma endregion
 
-template <typename char_type_, typename allocator_>
-template <typename pattern_type>
-bool basic_string<char_type_, allocator_>::try_replace_all_(pattern_type pattern, string_view replacement) noexcept {
-    // Depending on the size of the pattern and the replacement, we may need to allocate more space.
-    // There are 3 cases to consider:
-    // 1. The pattern and the replacement are of the same length. Piece of cake!
-    // 2. The pattern is longer than the replacement. We need to compact the strings.
-    // 3. The pattern is shorter than the replacement. We may have to allocate more memory.
-    using matcher_type = typename std::conditional<std::is_same<pattern_type, char_set>::value,
-                                                   matcher_find_first_of<string_view, pattern_type>,
-                                                   matcher_find<string_view, exclude_overlaps_type>>::type;
-    matcher_type matcher({pattern});
-    string_view this_view = view();
+#pragma region Flat Hash Containers
 
-    // 1. The pattern and the replacement are of the same length.
-    if (matcher.needle_length() == replacement.length()) {
-        using matches_type = range_matches<string_view, matcher_type>;
-        // Instead of iterating with `begin()` and `end()`, we could use the cheaper sentinel-based approach.
-        //      for (string_view match : matches) { ... }
-        matches_type matches = matches_type(this_view, {pattern});
-        for (auto matches_iterator = matches.begin(); matches_iterator != end_sentinel_type {}; ++matches_iterator) {
-            replacement.copy(const_cast<pointer>((*matches_iterator).data()));
+/**
+ *  @brief  Owning key of the flat hash containers, mimicking the SSO layout of `sz_string_t`, but without the
+ *          self-referencing pointer, so that slots can be relocated with a plain copy during rehashing.
+ *          Keys up to `SZ_STRING_INTERNAL_SPACE` bytes are stored inline, longer ones in the shared arena.
+ */
+union _flat_key {
+    struct internal {
+        char chars[SZ_STRING_INTERNAL_SPACE];
+        sz_u8_t length; // Set to `external_k` for keys stored in the arena.
+    } internal;
+    struct external {
+        sz_cptr_t start;
+        sz_size_t length;
+        sz_size_t padding; // The last byte is shared with the `internal.length`.
+    } external;
+
+    static constexpr sz_u8_t external_k = 0xFF;
+
+    string_view view() const noexcept {
+        return internal.length == external_k ? string_view(external.start, external.length)
+                                             : string_view(internal.chars, internal.length);
+    }
+};
+
+static_assert(sizeof(_flat_key) == 3 * sizeof(void *), "Flat keys must be 3 pointers.");
+
+/**
+ *  @brief  Slot of a flat hash map, carrying the folded 32-bit hash to avoid re-hashing keys on growth.
+ *          Together with the 24-byte key, it fits two slots with 4-byte values into a cache line.
+ */
+template <typename mapped_type_>
+struct _flat_slot {
+    _flat_key key;
+    sz_u32_t hash;
+    mapped_type_ value;
+
+    template <typename... mapped_args_>
+    _flat_slot(_flat_key const &k, sz_u32_t h, mapped_args_ &&...args)
+        : key(k), hash(h), value(std::forward<mapped_args_>(args)...) {}
+    _flat_slot(_flat_key const &k, _flat_slot const &other) : key(k), hash(other.hash), value(other.value) {}
+};
+
+/**
+ *  @brief  Slot of a flat hash set, only holding the key and its hash.
+ */
+template <>
+struct _flat_slot<void> {
+    _flat_key key;
+    sz_u32_t hash;
+
+    _flat_slot(_flat_key const &k, sz_u32_t h) noexcept : key(k), hash(h) {}
+    _flat_slot(_flat_key const &k, _flat_slot const &other) noexcept : key(k), hash(other.hash) {}
+};
+
+/**
+ *  @brief  Open-addressing hash table with SwissTable-like layout, shared by `basic_flat_set` and `basic_flat_map`.
+ *
+ *  Every slot has a 1-byte control code: the top 7 bits of the hash for occupied slots, or `empty_k` and
+ *  `deleted_k` markers. Control bytes are probed in groups of 8 with the same SWAR tricks as the serial
+ *  substring search, so a single comparison filters out most of the slots in a group without touching them.
+ *  The first group is mirrored past the end of the control bytes to avoid wrapping around in the middle of a load.
+ *  Probing is quadratic over groups, and the table never gets more than 7/8 full, so it always terminates.
+ *
+ *  Long keys are appended to a chunked arena, that is only released on `clear` or destruction,
+ *  so erasing long keys doesn't reclaim their memory until then.
+ *
+ *  @tparam slot_type_       Either `_flat_slot<mapped_type>` or `_flat_slot<void>`.
+ *  @tparam allocator_type_  Stateless allocator, used for the slots, control bytes and the arena.
+ */
+template <typename slot_type_, typename allocator_type_>
+class _flat_table {
+
+    static_assert(std::is_empty<allocator_type_>::value, "We currently only support stateless allocators");
+
+  public:
+    using size_type = std::size_t;
+    using slot_type = slot_type_;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+    static constexpr size_type group_k = 8;
+    static constexpr sz_u8_t empty_k = 0x80;
+    static constexpr sz_u8_t deleted_k = 0xFE;
+
+  private:
+    struct arena_chunk_t {
+        arena_chunk_t *previous;
+        size_type capacity;
+        size_type used;
+    };
+
+    static constexpr size_type arena_chunk_min_k = 4096;
+    static constexpr size_type arena_chunk_max_k = 1024 * 1024;
+
+    slot_type_ *slots_ = nullptr;
+    sz_u8_t *controls_ = nullptr;
+    size_type capacity_ = 0;
+    size_type size_ = 0;
+    size_type tombstones_ = 0;
+    arena_chunk_t *arena_ = nullptr;
+
+    /**  @brief  Top 7 bits of the hash are stored in control bytes, while the folded bottom half in slots. */
+    static sz_u8_t control_tag(sz_u64_t hash) noexcept { return static_cast<sz_u8_t>(hash >> 57); }
+    static sz_u32_t fold(sz_u64_t hash) noexcept { return static_cast<sz_u32_t>(hash ^ (hash >> 32)); }
+    static size_type buffer_size(size_type capacity) noexcept {
+        return capacity * sizeof(slot_type_) + capacity + group_k;
+    }
+
+    void set_control(size_type index, sz_u8_t control) noexcept {
+        controls_[index] = control;
+        if (index < group_k) controls_[capacity_ + index] = control;
+    }
+
+    /**  @brief  Finds the first empty or deleted slot on the probing path of the given folded hash. */
+    size_type find_free(sz_u32_t folded) const noexcept {
+        size_type const mask = capacity_ - 1;
+        for (size_type position = folded & mask, step = group_k;; position = (position + step) & mask) {
+            sz_u64_vec_t group = sz_u64_load((sz_cptr_t)controls_ + position);
+            // Both `empty_k` and `deleted_k` have the top bit set, unlike the 7-bit tags of occupied slots.
+            sz_u64_t frees = group.u64 & 0x8080808080808080ull;
+            if (frees) return (position + sz_u64_ctz(frees) / 8) & mask;
+            step += group_k;
         }
-        return true;
     }
 
-    // 2. The pattern is longer than the replacement. We need to compact the strings.
-    else if (matcher.needle_length() > replacement.length()) {
-        // Dealing with shorter replacements, we will avoid memory allocations, but we can also mimnimize the number
-        // of `memmove`-s, by keeping one more iterator, pointing to the end of the last compacted area.
-        // Having the split-ranges, however, we reuse their logic.
-        using splits_type = range_splits<string_view, matcher_type>;
-        splits_type splits = splits_type(this_view, {pattern});
-        auto matches_iterator = splits.begin();
-        auto compacted_end = (*matches_iterator).end();
-        if (compacted_end == end()) return true; // No matches.
+    _flat_key store(string_view key) noexcept(false) {
+        _flat_key record;
+        if (key.size() <= sizeof(record.internal.chars)) {
+            sz_copy(record.internal.chars, key.data(), key.size());
+            record.internal.length = static_cast<sz_u8_t>(key.size());
+            return record;
+        }
 
-        ++matches_iterator; // Skip the first match.
-        do {
-            string_view match_view = *matches_iterator;
-            replacement.copy(const_cast<pointer>(compacted_end));
-            compacted_end += replacement.length();
-            sz_move((sz_ptr_t)compacted_end, match_view.begin(), match_view.length());
-            compacted_end += match_view.length();
-            ++matches_iterator;
-        } while (matches_iterator != end_sentinel_type {});
+        if (!arena_ || arena_->capacity - arena_->used < key.size()) {
+            size_type capacity = arena_ ? arena_->capacity * 2 : arena_chunk_min_k;
+            if (capacity > arena_chunk_max_k) capacity = arena_chunk_max_k;
+            if (capacity < key.size()) capacity = key.size();
+            allocator_type_ allocator;
+            arena_chunk_t *chunk = reinterpret_cast<arena_chunk_t *>(
+                allocator.allocate(sizeof(arena_chunk_t) + capacity));
+            chunk->previous = arena_;
+            chunk->capacity = capacity;
+            chunk->used = 0;
+            arena_ = chunk;
+        }
 
-        // Can't fail, so let's just return true :)
-        try_resize(compacted_end - begin());
-        return true;
+        sz_ptr_t start = reinterpret_cast<sz_ptr_t>(arena_ + 1) + arena_->used;
+        sz_copy(start, key.data(), key.size());
+        arena_->used += key.size();
+        record.external.start = start;
+        record.external.length = key.size();
+        record.internal.length = _flat_key::external_k;
+        return record;
     }
 
-    // 3. The pattern is shorter than the replacement. We may have to allocate more memory.
-    else {
-        using rmatcher_type = typename std::conditional<std::is_same<pattern_type, char_set>::value,
-                                                        matcher_find_last_of<string_view, pattern_type>,
-                                                        matcher_rfind<string_view, exclude_overlaps_type>>::type;
-        using rmatches_type = range_rmatches<string_view, rmatcher_type>;
-        rmatches_type rmatches = rmatches_type(this_view, {pattern});
+    void destroy_slots() noexcept {
+        for (size_type i = 0; i != capacity_; ++i)
+            if (controls_[i] < empty_k) slots_[i].~slot_type_();
+    }
 
-        // It's cheaper to iterate through the whole string once, counting the number of matches,
-        // reserving memory once, than re-allocating and copying the string multiple times.
-        auto matches_count = rmatches.size();
-        if (matches_count == 0) return true; // No matches.
+    void release_arena() noexcept {
+        allocator_type_ allocator;
+        while (arena_) {
+            arena_chunk_t *previous = arena_->previous;
+            allocator.deallocate(reinterpret_cast<char *>(arena_), sizeof(arena_chunk_t) + arena_->capacity);
+            arena_ = previous;
+        }
+    }
 
-        // TODO: Resize without initializing the memory.
-        auto replacement_delta_length = replacement.length() - matcher.needle_length();
-        auto added_length = matches_count * replacement_delta_length;
-        auto old_length = size();
-        auto new_length = old_length + added_length;
-        if (!try_resize(new_length)) return false;
-        this_view = view().front(old_length);
+    void release() noexcept {
+        destroy_slots();
+        release_arena();
+        if (slots_) allocator_type_ {}.deallocate(reinterpret_cast<char *>(slots_), buffer_size(capacity_));
+        slots_ = nullptr, controls_ = nullptr;
+        capacity_ = size_ = tombstones_ = 0;
+    }
+
+    /**  @brief  Relocates all the slots into a new table of ::new_capacity, dropping the tombstones. */
+    void rehash(size_type new_capacity) noexcept(false) {
+        allocator_type_ allocator;
+        char *buffer = allocator.allocate(buffer_size(new_capacity));
+        slot_type_ *old_slots = slots_;
+        sz_u8_t *old_controls = controls_;
+        size_type old_capacity = capacity_;
+
+        slots_ = reinterpret_cast<slot_type_ *>(buffer);
+        controls_ = reinterpret_cast<sz_u8_t *>(buffer + new_capacity * sizeof(slot_type_));
+        capacity_ = new_capacity;
+        tombstones_ = 0;
+        sz_fill((sz_ptr_t)controls_, new_capacity + group_k, empty_k);
+
+        for (size_type i = 0; i != old_capacity; ++i) {
+            if (old_controls[i] >= empty_k) continue;
+            slot_type_ &old_slot = old_slots[i];
+            size_type index = find_free(old_slot.hash);
+            new (&slots_[index]) slot_type_(std::move(old_slot));
+            set_control(index, old_controls[i]);
+            old_slot.~slot_type_();
+        }
+        if (old_slots) allocator.deallocate(reinterpret_cast<char *>(old_slots), buffer_size(old_capacity));
+    }
 
-        // Now iterate through splits similarly to the 2nd case, but in reverse order.
-        using rsplits_type = range_rsplits<string_view, rmatcher_type>;
-        rsplits_type splits = rsplits_type(this_view, {pattern});
-        auto splits_iterator = splits.begin();
+    /**  @brief  Smallest power-of-two capacity, that fits ::count entries under the 7/8 load factor. */
+    static size_type capacity_for(size_type count) noexcept {
+        size_type capacity = group_k;
+        while (capacity * 7 < count * 8) capacity *= 2;
+        return capacity;
+    }
 
-        // Put the compacted pointer to the end of the new string, and walk left.
-        auto compacted_begin = this_view.data() + new_length;
+  public:
+    _flat_table() noexcept = default;
+    ~_flat_table() noexcept { release(); }
+
+    _flat_table(_flat_table const &other) noexcept(false) {
+        if (!other.size_) return;
+        rehash(capacity_for(other.size_));
+        for (size_type i = 0; i != other.capacity_; ++i) {
+            if (other.controls_[i] >= empty_k) continue;
+            slot_type_ const &other_slot = other.slots_[i];
+            size_type index = find_free(other_slot.hash);
+            new (&slots_[index]) slot_type_(store(other_slot.key.view()), other_slot);
+            set_control(index, other.controls_[i]);
+            ++size_;
+        }
+    }
 
-        // By now we know that at least one match exists, which means the splits .
-        do {
-            string_view slice_view = *splits_iterator;
-            compacted_begin -= slice_view.length();
-            sz_move((sz_ptr_t)compacted_begin, slice_view.begin(), slice_view.length());
-            compacted_begin -= replacement.length();
-            replacement.copy(const_cast<pointer>(compacted_begin));
-            ++splits_iterator;
-        } while (!splits_iterator.is_last());
+    _flat_table(_flat_table &&other) noexcept { swap(other); }
+
+    _flat_table &operator=(_flat_table other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(_flat_table &other) noexcept {
+        std::swap(slots_, other.slots_);
+        std::swap(controls_, other.controls_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(tombstones_, other.tombstones_);
+        std::swap(arena_, other.arena_);
+    }
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    slot_type_ &slot(size_type index) noexcept { return slots_[index]; }
+    slot_type_ const &slot(size_type index) const noexcept { return slots_[index]; }
+
+    /**  @brief  Index of the first occupied slot at or after ::index, or `capacity()` if there are none. */
+    size_type next_occupied(size_type index) const noexcept {
+        while (index < capacity_ && controls_[index] >= empty_k) ++index;
+        return index < capacity_ ? index : capacity_;
+    }
+
+    /**  @brief  Locates the slot with the given key and its precomputed hash, or returns `npos`. */
+    size_type find(string_view key, sz_u64_t hash) const noexcept {
+        if (!capacity_) return npos;
+        size_type const mask = capacity_ - 1;
+        sz_u64_vec_t tags, empties;
+        sz_u32_t const folded = fold(hash);
+        tags.u64 = 0x0101010101010101ull * control_tag(hash);
+        empties.u64 = 0x0101010101010101ull * empty_k;
+        for (size_type position = folded & mask, step = group_k;; position = (position + step) & mask) {
+            sz_u64_vec_t group = sz_u64_load((sz_cptr_t)controls_ + position);
+            for (sz_u64_t matches = _sz_u64_each_byte_equal(group, tags).u64; matches; matches &= matches - 1) {
+                size_type index = (position + sz_u64_ctz(matches) / 8) & mask;
+                slot_type_ const &candidate = slots_[index];
+                if (candidate.hash != folded) continue;
+                string_view candidate_key = candidate.key.view();
+                if (candidate_key.size() == key.size() && sz_equal(candidate_key.data(), key.data(), key.size()))
+                    return index;
+            }
+            // Any empty slot in the group means, that the key was never inserted further along the path.
+            if (_sz_u64_each_byte_equal(group, empties).u64) return npos;
+            step += group_k;
+        }
+    }
+
+    size_type find(string_view key) const noexcept { return find(key, sz_hash(key.data(), key.size())); }
+
+    /**
+     *  @brief  Inserts a new slot constructing its value from ::args, unless the ::key is already present.
+     *  @return The index of the slot with the ::key, and whether it was inserted.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    template <typename... mapped_args_>
+    std::pair<size_type, bool> emplace(string_view key, mapped_args_ &&...args) noexcept(false) {
+        sz_u64_t hash = sz_hash(key.data(), key.size());
+        size_type index = find(key, hash);
+        if (index != npos) return {index, false};
+
+        // Grow if the table is getting too crowded with live entries, or just drop the tombstones otherwise.
+        if ((size_ + tombstones_ + 1) * 8 > capacity_ * 7)
+            rehash((size_ + 1) * 16 > capacity_ * 7 ? (capacity_ ? capacity_ * 2 : group_k) : capacity_);
+
+        index = find_free(fold(hash));
+        new (&slots_[index]) slot_type_(store(key), fold(hash), std::forward<mapped_args_>(args)...);
+        tombstones_ -= controls_[index] == deleted_k;
+        set_control(index, control_tag(hash));
+        ++size_;
+        return {index, true};
+    }
+
+    void erase_at(size_type index) noexcept {
+        slots_[index].~slot_type_();
+        set_control(index, deleted_k);
+        --size_;
+        ++tombstones_;
+    }
+
+    /**
+     *  @brief  Preallocates enough slots to fit ::count entries without further rehashing.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    void reserve(size_type count) noexcept(false) {
+        size_type capacity = capacity_for(count);
+        if (capacity > capacity_) rehash(capacity);
+    }
+
+    /**  @brief  Removes all the entries and releases the arena, but keeps the slots allocated. */
+    void clear() noexcept {
+        destroy_slots();
+        release_arena();
+        if (controls_) sz_fill((sz_ptr_t)controls_, capacity_ + group_k, empty_k);
+        size_ = tombstones_ = 0;
+    }
+};
+
+/**
+ *  @brief  Open-addressing hash set of strings, that owns copies of the inserted keys.
+ *          Short keys are stored inline in the slots, long keys in a shared arena.
+ *          Iterators are invalidated by every insertion, erasure invalidates only the erased entry.
+ *
+ *  @tparam allocator_type_  Stateless allocator, used for the slots, control codes and the arena.
+ *  @see    _flat_table
+ */
+template <typename allocator_type_ = std::allocator<char>>
+class basic_flat_set {
+
+    using table_type = _flat_table<_flat_slot<void>, allocator_type_>;
+    table_type table_;
+
+  public:
+    using key_type = string_view;
+    using value_type = string_view;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    class iterator {
+        table_type const *table_;
+        size_type index_;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = string_view;
+        using pointer = void;
+        using reference = string_view;
+
+        iterator(table_type const *table, size_type index) noexcept : table_(table), index_(index) {}
+
+        value_type operator*() const noexcept { return table_->slot(index_).key.view(); }
+        iterator &operator++() noexcept {
+            index_ = table_->next_occupied(index_ + 1);
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator!=(iterator const &other) const noexcept { return index_ != other.index_; }
+        bool operator==(iterator const &other) const noexcept { return index_ == other.index_; }
+    };
+
+    using const_iterator = iterator;
+
+    basic_flat_set() noexcept = default;
+
+    basic_flat_set(std::initializer_list<string_view> keys) noexcept(false) {
+        reserve(keys.size());
+        for (string_view key : keys) insert(key);
+    }
+
+    iterator begin() const noexcept { return {&table_, table_.next_occupied(0)}; }
+    iterator end() const noexcept { return {&table_, table_.capacity()}; }
+
+    size_type size() const noexcept { return table_.size(); }
+    bool empty() const noexcept { return table_.size() == 0; }
+    void reserve(size_type count) noexcept(false) { table_.reserve(count); }
+    void clear() noexcept { table_.clear(); }
+    void swap(basic_flat_set &other) noexcept { table_.swap(other.table_); }
+
+    /**
+     *  @brief  Copies the ::key into the set, unless it's already present.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    std::pair<iterator, bool> insert(string_view key) noexcept(false) {
+        std::pair<size_type, bool> result = table_.emplace(key);
+        return {iterator(&table_, result.first), result.second};
+    }
+
+    iterator find(string_view key) const noexcept {
+        size_type index = table_.find(key);
+        return index != table_type::npos ? iterator(&table_, index) : end();
+    }
+
+    bool contains(string_view key) const noexcept { return table_.find(key) != table_type::npos; }
+    size_type count(string_view key) const noexcept { return contains(key); }
+
+    /**  @brief  Removes the ::key from the set, returning the number of erased entries. */
+    size_type erase(string_view key) noexcept {
+        size_type index = table_.find(key);
+        if (index == table_type::npos) return 0;
+        table_.erase_at(index);
+        return 1;
+    }
+};
+
+/**
+ *  @brief  Open-addressing hash map with string keys, that owns copies of the inserted keys.
+ *          Short keys are stored inline in the slots, long keys in a shared arena.
+ *          Iterators are invalidated by every insertion, erasure invalidates only the erased entry.
+ *
+ *  Unlike `std::unordered_map`, the iterators dereference into a pair of a `string_view` and
+ *  a reference to the mapped value, instead of a reference to a stored `std::pair`.
+ *
+ *  @tparam mapped_type_     Type of the values, must be nothrow-movable.
+ *  @tparam allocator_type_  Stateless allocator, used for the slots, control codes and the arena.
+ *  @see    _flat_table
+ */
+template <typename mapped_type_, typename allocator_type_ = std::allocator<char>>
+class basic_flat_map {
+
+    using table_type = _flat_table<_flat_slot<mapped_type_>, allocator_type_>;
+    table_type table_;
+
+    template <bool is_const_>
+    class iterator_ {
+        using table_pointer = typename std::conditional<is_const_, table_type const *, table_type *>::type;
+        using mapped_reference = typename std::conditional<is_const_, mapped_type_ const &, mapped_type_ &>::type;
+
+        table_pointer table_;
+        std::size_t index_;
+
+        friend class basic_flat_map;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::pair<string_view, mapped_reference>;
+        using reference = value_type;
+
+        /**  @brief  Temporary holder of the dereferenced pair, enabling `it->second` access. */
+        struct pointer {
+            value_type pair;
+            value_type *operator->() noexcept { return &pair; }
+        };
+
+        iterator_(table_pointer table, std::size_t index) noexcept : table_(table), index_(index) {}
+
+        reference operator*() const noexcept {
+            auto &slot = table_->slot(index_);
+            return {slot.key.view(), slot.value};
+        }
+        pointer operator->() const noexcept { return {**this}; }
+
+        iterator_ &operator++() noexcept {
+            index_ = table_->next_occupied(index_ + 1);
+            return *this;
+        }
+        iterator_ operator++(int) noexcept {
+            iterator_ temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator!=(iterator_ const &other) const noexcept { return index_ != other.index_; }
+        bool operator==(iterator_ const &other) const noexcept { return index_ == other.index_; }
+    };
+
+  public:
+    using key_type = string_view;
+    using mapped_type = mapped_type_;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = iterator_<false>;
+    using const_iterator = iterator_<true>;
+
+    basic_flat_map() noexcept = default;
+
+    basic_flat_map(std::initializer_list<std::pair<string_view, mapped_type_>> entries) noexcept(false) {
+        reserve(entries.size());
+        for (auto const &entry : entries) try_emplace(entry.first, entry.second);
+    }
+
+    iterator begin() noexcept { return {&table_, table_.next_occupied(0)}; }
+    iterator end() noexcept { return {&table_, table_.capacity()}; }
+    const_iterator begin() const noexcept { return {&table_, table_.next_occupied(0)}; }
+    const_iterator end() const noexcept { return {&table_, table_.capacity()}; }
+
+    size_type size() const noexcept { return table_.size(); }
+    bool empty() const noexcept { return table_.size() == 0; }
+    void reserve(size_type count) noexcept(false) { table_.reserve(count); }
+    void clear() noexcept { table_.clear(); }
+    void swap(basic_flat_map &other) noexcept { table_.swap(other.table_); }
+
+    /**
+     *  @brief  Copies the ::key into the map constructing the value from ::args, unless it's already present.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    template <typename... mapped_args_>
+    std::pair<iterator, bool> try_emplace(string_view key, mapped_args_ &&...args) noexcept(false) {
+        std::pair<size_type, bool> result = table_.emplace(key, std::forward<mapped_args_>(args)...);
+        return {iterator(&table_, result.first), result.second};
+    }
+
+    /**
+     *  @brief  Inserts the ::value under the ::key or overwrites the existing one.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    template <typename mapped_arg_>
+    std::pair<iterator, bool> insert_or_assign(string_view key, mapped_arg_ &&value) noexcept(false) {
+        std::pair<iterator, bool> result = try_emplace(key, std::forward<mapped_arg_>(value));
+        if (!result.second) table_.slot(result.first.index_).value = std::forward<mapped_arg_>(value);
+        return result;
+    }
+
+    /**
+     *  @brief  Accesses the value under the ::key, default-constructing it if missing.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    mapped_type_ &operator[](string_view key) noexcept(false) {
+        return table_.slot(table_.emplace(key).first).value;
+    }
+
+    /**
+     *  @brief  Accesses the value under the ::key.
+     *  @throw  `std::out_of_range` if the key is missing.
+     */
+    mapped_type_ &at(string_view key) noexcept(false) {
+        size_type index = table_.find(key);
+        if (index == table_type::npos) throw std::out_of_range("sz::flat_map::at");
+        return table_.slot(index).value;
+    }
 
-        return true;
+    mapped_type_ const &at(string_view key) const noexcept(false) {
+        size_type index = table_.find(key);
+        if (index == table_type::npos) throw std::out_of_range("sz::flat_map::at");
+        return table_.slot(index).value;
     }
-}
 
-template <typename char_type_, typename allocator_>
-template <typename first_type, typename second_type>
-bool basic_string<char_type_, allocator_>::try_assign(concatenation<first_type, second_type> const &other) noexcept {
-    // We can't just assign the other string state, as its start address may be somewhere else on the stack.
-    sz_ptr_t string_start;
-    sz_size_t string_length;
-    sz_string_range(&string_, &string_start, &string_length);
+    iterator find(string_view key) noexcept {
+        size_type index = table_.find(key);
+        return index != table_type::npos ? iterator(&table_, index) : end();
+    }
 
-    if (string_length >= other.length()) {
-        sz_string_erase(&string_, other.length(), SZ_SIZE_MAX);
-        other.copy(string_start, other.length());
+    const_iterator find(string_view key) const noexcept {
+        size_type index = table_.find(key);
+        return index != table_type::npos ? const_iterator(&table_, index) : end();
     }
-    else {
-        if (!_with_alloc([&](sz_alloc_type &alloc) {
-                string_start = sz_string_expand(&string_, SZ_SIZE_MAX, other.length(), &alloc);
-                if (!string_start) return false;
-                other.copy(string_start, other.length());
-                return true;
-            }))
-            return false;
+
+    bool contains(string_view key) const noexcept { return table_.find(key) != table_type::npos; }
+    size_type count(string_view key) const noexcept { return contains(key); }
+
+    /**  @brief  Removes the ::key from the map, returning the number of erased entries. */
+    size_type erase(string_view key) noexcept {
+        size_type index = table_.find(key);
+        if (index == table_type::npos) return 0;
+        table_.erase_at(index);
+        return 1;
     }
-    return true;
-}
+};
 
-template <typename char_type_, typename allocator_>
-bool basic_string<char_type_, allocator_>::try_preparing_replacement(size_type offset, size_type length,
-                                                                     size_type replacement_length) noexcept {
-    // There are three cases:
-    // 1. The replacement is the same length as the replaced range.
-    // 2. The replacement is shorter than the replaced range.
-    // 3. The replacement is longer than the replaced range. An allocation may occur.
-    assert(offset + length <= size());
+using flat_set = basic_flat_set<>;
 
-    // 1. The replacement is the same length as the replaced range.
-    if (replacement_length == length) { return true; }
+template <typename mapped_type_>
+using flat_map = basic_flat_map<mapped_type_>;
 
-    // 2. The replacement is shorter than the replaced range.
-    else if (replacement_length < length) {
-        sz_string_erase(&string_, offset + replacement_length, length - replacement_length);
+#pragma endregion
+
+#if !SZ_AVOID_MMAP
+#pragma region Memory-Mapped Files
+
+/**
+ *  @brief  Read-only memory-mapping of a whole file, exposing its content as a `string_view`.
+ *          Unlike buffered reads, avoids copies, but the first access to every page triggers a page fault,
+ *          which dominates cold scans of large files, unless the kernel is hinted about the access pattern.
+ *
+ *  @code{.cpp}
+ *      sz::mapped_file corpus("corpus.txt", sz::mapped_file::sequential | sz::mapped_file::huge_pages);
+ *      std::size_t lines = corpus.view().find_all("\n").size();
+ *  @endcode
+ */
+class mapped_file {
+    char const *data_ = nullptr;
+    std::size_t size_ = 0;
+
+  public:
+    /**
+     *  @brief  Access-pattern hints, that can be combined with a bitwise OR, and are ignored where unsupported.
+     *
+     *  - `sequential` enables aggressive read-ahead with `MADV_SEQUENTIAL` or `FILE_FLAG_SEQUENTIAL_SCAN`,
+     *    and prefetches the whole view with `PrefetchVirtualMemory` on Windows.
+     *  - `random` disables read-ahead with `MADV_RANDOM` or `FILE_FLAG_RANDOM_ACCESS`.
+     *  - `huge_pages` asks for transparent huge pages with `MADV_HUGEPAGE`, reducing the number of faults
+     *    and TLB misses, if the file-system supports it. Windows doesn't support large pages for files.
+     *  - `populate` pre-faults the whole mapping with `MAP_POPULATE`, `MADV_WILLNEED`, or `PrefetchVirtualMemory`.
+     */
+    enum hints : unsigned { none = 0, sequential = 1, random = 2, huge_pages = 4, populate = 8 };
+
+    mapped_file() noexcept = default;
+    mapped_file(mapped_file const &) = delete;
+    mapped_file &operator=(mapped_file const &) = delete;
+    mapped_file(mapped_file &&other) noexcept : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr, other.size_ = 0;
+    }
+    mapped_file &operator=(mapped_file &&other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+    ~mapped_file() noexcept { close(); }
+
+    /**
+     *  @brief  Maps the file at the given path.
+     *  @throw  `std::runtime_error` if the file can't be opened or mapped.
+     */
+    mapped_file(char const *path, unsigned file_hints = none) noexcept(false) {
+        if (!try_open(path, file_hints)) throw std::runtime_error("Couldn't map the file!");
+    }
+
+    /**
+     *  @brief  Maps the file at the given path, unmapping the previous one.
+     *  @return `true` on success, `false` if the file can't be opened or mapped.
+     */
+    bool try_open(char const *path, unsigned file_hints = none) noexcept {
+        close();
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+        DWORD file_flags = FILE_ATTRIBUTE_NORMAL;
+        if (file_hints & sequential) file_flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+        if (file_hints & random) file_flags |= FILE_FLAG_RANDOM_ACCESS;
+        HANDLE file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, file_flags, 0);
+        if (file_handle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_handle, &file_size)) return CloseHandle(file_handle), false;
+        // Mapping empty files fails, but they are still valid inputs.
+        if (file_size.QuadPart == 0) return CloseHandle(file_handle), true;
+        // The view keeps the mapping alive, so both handles can be closed right away.
+        HANDLE mapping_handle = CreateFileMapping(file_handle, 0, PAGE_READONLY, 0, 0, 0);
+        CloseHandle(file_handle);
+        if (!mapping_handle) return false;
+        void *view = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping_handle);
+        if (!view) return false;
+        data_ = static_cast<char const *>(view);
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602 // Windows 8 and newer
+        if (file_hints & (sequential | populate)) {
+            WIN32_MEMORY_RANGE_ENTRY range;
+            range.VirtualAddress = view;
+            range.NumberOfBytes = size_;
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+#endif
+#else
+        int file_descriptor = ::open(path, O_RDONLY);
+        if (file_descriptor < 0) return false;
+        struct stat file_stats;
+        if (::fstat(file_descriptor, &file_stats) != 0) return ::close(file_descriptor), false;
+        // Mapping empty files fails with `EINVAL`, but they are still valid inputs.
+        std::size_t file_size = static_cast<std::size_t>(file_stats.st_size);
+        if (file_size == 0) return ::close(file_descriptor), true;
+        int map_flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+        if (file_hints & populate) map_flags |= MAP_POPULATE;
+#endif
+        // The mapping keeps the file referenced, so the descriptor can be closed right away.
+        void *map = ::mmap(nullptr, file_size, PROT_READ, map_flags, file_descriptor, 0);
+        ::close(file_descriptor);
+        if (map == MAP_FAILED) return false;
+        data_ = static_cast<char const *>(map);
+        size_ = file_size;
+        // The hints are advisory, so their failures are ignored.
+        if (file_hints & sequential) ::madvise(map, file_size, MADV_SEQUENTIAL);
+        if (file_hints & random) ::madvise(map, file_size, MADV_RANDOM);
+#if defined(MADV_HUGEPAGE)
+        if (file_hints & huge_pages) ::madvise(map, file_size, MADV_HUGEPAGE);
+#endif
+#if !defined(MAP_POPULATE)
+        if (file_hints & populate) ::madvise(map, file_size, MADV_WILLNEED);
+#endif
+#endif
         return true;
     }
-    // 3. The replacement is longer than the replaced range. An allocation may occur.
-    else {
-        return _with_alloc([&](sz_alloc_type &alloc) {
-            return sz_string_expand(&string_, offset + length, replacement_length - length, &alloc);
-        });
+
+    /** @brief  Unmaps the file, if any. */
+    void close() noexcept {
+        if (!data_) return;
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+        UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<char *>(data_), size_);
+#endif
+        data_ = nullptr, size_ = 0;
     }
-}
 
-/**  @brief  SFINAE-type used to infer the resulting type of concatenating multiple string together. */
-template <typename... args_types>
-struct concatenation_result {};
+    char const *data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    std::size_t length() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
 
-template <typename first_type, typename second_type>
-struct concatenation_result<first_type, second_type> {
-    using type = concatenation<first_type, second_type>;
+    string_view view() const noexcept { return {data_, size_}; }
+    operator string_view() const noexcept { return view(); }
 };
 
-template <typename first_type, typename... following_types>
-struct concatenation_result<first_type, following_types...> {
-    using type = concatenation<first_type, typename concatenation_result<following_types...>::type>;
-};
+#pragma endregion
+#endif
 
-/**
- *  @brief  Concatenates two strings into a template expression.
- *  @see    `concatenation` class for more details.
- */
-template <typename first_type, typename second_type>
-concatenation<first_type, second_type> concatenate(first_type &&first, second_type &&second) noexcept(false) {
-    return {first, second};
-}
+#pragma region Suffix Index
 
 /**
- *  @brief  Concatenates two or more strings into a template expression.
- *  @see    `concatenation` class for more details.
+ *  @brief  Suffix array over a static text, answering repeated substring queries in `O(m log n)` time,
+ *          without rescanning the text. Can be saved into a file, that is later memory-mapped and opened
+ *          without any load cost. Non-copyable, as the suffix array takes 8 bytes per byte of text.
+ *
+ *  @code{.cpp}
+ *      sz::suffix_index index(genome);
+ *      index.save("genome.sfx");
+ *
+ *      sz::mapped_file file("genome.sfx", sz::mapped_file::random);
+ *      auto mapped_index = sz::suffix_index::open(file.view());
+ *      std::size_t repeats = mapped_index.count("ACGT");
+ *  @endcode
+ *
+ *  @tparam allocator_type_  Stateless allocator, used for the suffix array of the built indexes.
+ *  @warning The text, or the serialized index, is not copied and must outlive the index!
+ *  @see    sz_suffix_array, sz_suffix_index_parse
  */
-template <typename first_type, typename second_type, typename... following_types>
-typename concatenation_result<first_type, second_type, following_types...>::type concatenate(
-    first_type &&first, second_type &&second, following_types &&...following) noexcept(false) {
-    // Fold expression like the one below would result in faster compile times,
-    // but would incur the penalty of additional `if`-statements in every `append` call.
-    // Moreover, those are only supported in C++17 and later.
-    //      std::size_t total_size = (strings.size() + ... + 0);
-    //      std::string result;
-    //      result.reserve(total_size);
-    //      (result.append(strings), ...);
-    return ashvardanian::stringzilla::concatenate(
-        std::forward<first_type>(first),
-        ashvardanian::stringzilla::concatenate(std::forward<second_type>(second),
-                                               std::forward<following_types>(following)...));
-}
+template <typename allocator_type_ = std::allocator<char>>
+class basic_suffix_index {
 
-/**
- *  @brief  Calculates the Hamming edit distance in @b bytes between two strings.
- *  @see    sz_edit_distance
- */
-template <typename char_type_>
-std::size_t hamming_distance(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
-                             std::size_t bound = 0) noexcept {
-    return sz_hamming_distance(a.data(), a.size(), b.data(), b.size(), bound);
-}
+    static_assert(std::is_empty<allocator_type_>::value, "We currently only support stateless allocators");
 
-/**
- *  @brief  Calculates the Hamming edit distance in @b bytes between two strings.
- *  @see    sz_edit_distance
- */
-template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
-std::size_t hamming_distance(basic_string<char_type_, allocator_type_> const &a,
-                             basic_string<char_type_, allocator_type_> const &b, std::size_t bound = 0) noexcept {
-    return ashvardanian::stringzilla::hamming_distance(a.view(), b.view(), bound);
-}
+    string_view text_;
+    sz_sorted_idx_t const *suffixes_ = nullptr;
+    sz_sorted_idx_t *owned_suffixes_ = nullptr;
 
-/**
- *  @brief  Calculates the Hamming edit distance in @b unicode codepoints between two strings.
- *  @see    sz_hamming_distance_utf8
- */
-template <typename char_type_>
-std::size_t hamming_distance_utf8(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
-                                  std::size_t bound = 0) noexcept {
-    return sz_hamming_distance_utf8(a.data(), a.size(), b.data(), b.size(), bound);
-}
+    template <typename allocator_callback>
+    static bool _with_alloc(allocator_callback &&callback) noexcept {
+        return ashvardanian::stringzilla::_with_alloc<allocator_type_>(callback);
+    }
 
-/**
- *  @brief  Calculates the Hamming edit distance in @b unicode codepoints between two strings.
- *  @see    sz_edit_distance
- */
-template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
-std::size_t hamming_distance_utf8(basic_string<char_type_, allocator_type_> const &a,
-                                  basic_string<char_type_, allocator_type_> const &b, std::size_t bound = 0) noexcept {
-    return ashvardanian::stringzilla::hamming_distance_utf8(a.view(), b.view(), bound);
-}
+  public:
+    using size_type = std::size_t;
 
-/**
- *  @brief  Calculates the Levenshtein edit distance in @b bytes between two strings.
- *  @see    sz_edit_distance
- */
-template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
-std::size_t edit_distance(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
-                          std::size_t bound = 0, allocator_type_ &&allocator = allocator_type_ {}) noexcept(false) {
-    std::size_t result;
-    if (!_with_alloc(allocator, [&](sz_memory_allocator_t &alloc) {
-            result = sz_edit_distance(a.data(), a.size(), b.data(), b.size(), bound, &alloc);
-            return result != SZ_SIZE_MAX;
-        }))
-        throw std::bad_alloc();
-    return result;
-}
+    /**
+     *  @brief  Matches of a needle, as offsets in the text, ordered lexicographically by the following text.
+     */
+    struct matches_type {
+        sz_sorted_idx_t const *first = nullptr;
+        sz_sorted_idx_t const *last = nullptr;
 
-/**
- *  @brief  Calculates the Levenshtein edit distance in @b bytes between two strings.
- *  @see    sz_edit_distance
- */
-template <typename char_type_, typename allocator_type_ = std::allocator<char_type_>>
-std::size_t edit_distance(basic_string<char_type_, allocator_type_> const &a,
-                          basic_string<char_type_, allocator_type_> const &b, std::size_t bound = 0) noexcept(false) {
-    return ashvardanian::stringzilla::edit_distance(a.view(), b.view(), bound, a.get_allocator());
-}
+        sz_sorted_idx_t const *begin() const noexcept { return first; }
+        sz_sorted_idx_t const *end() const noexcept { return last; }
+        size_type size() const noexcept { return static_cast<size_type>(last - first); }
+        bool empty() const noexcept { return first == last; }
+        size_type operator[](size_type i) const noexcept { return static_cast<size_type>(first[i]); }
+    };
 
-/**
- *  @brief  Calculates the Levenshtein edit distance in @b unicode codepoints between two strings.
- *  @see    sz_edit_distance_utf8
- */
-template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
-std::size_t edit_distance_utf8(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
-                               std::size_t bound = 0,
-                               allocator_type_ &&allocator = allocator_type_ {}) noexcept(false) {
-    std::size_t result;
-    if (!_with_alloc(allocator, [&](sz_memory_allocator_t &alloc) {
-            result = sz_edit_distance_utf8(a.data(), a.size(), b.data(), b.size(), bound, &alloc);
-            return result != SZ_SIZE_MAX;
-        }))
-        throw std::bad_alloc();
-    return result;
-}
+    basic_suffix_index() noexcept = default;
 
-/**
- *  @brief  Calculates the Levenshtein edit distance in @b unicode codepoints between two strings.
- *  @see    sz_edit_distance_utf8
- */
-template <typename char_type_, typename allocator_type_ = std::allocator<char_type_>>
-std::size_t edit_distance_utf8(basic_string<char_type_, allocator_type_> const &a,
-                               basic_string<char_type_, allocator_type_> const &b,
-                               std::size_t bound = 0) noexcept(false) {
-    return ashvardanian::stringzilla::edit_distance_utf8(a.view(), b.view(), bound, a.get_allocator());
-}
+    /**
+     *  @brief  Builds the suffix array of the text.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    explicit basic_suffix_index(string_view text) noexcept(false) {
+        if (!try_build(text)) throw std::bad_alloc();
+    }
 
-/**
- *  @brief  Calculates the Needleman-Wunsch alignment score between two strings.
- *  @see    sz_alignment_score
- */
-template <typename char_type_, typename allocator_type_ = std::allocator<typename std::remove_const<char_type_>::type>>
-std::ptrdiff_t alignment_score(basic_string_slice<char_type_> const &a, basic_string_slice<char_type_> const &b,
-                               std::int8_t const (&subs)[256][256], std::int8_t gap = -1,
-                               allocator_type_ &&allocator = allocator_type_ {}) noexcept(false) {
+    basic_suffix_index(basic_suffix_index const &) = delete;
+    basic_suffix_index &operator=(basic_suffix_index const &) = delete;
 
-    static_assert(sizeof(sz_error_cost_t) == sizeof(std::int8_t), "sz_error_cost_t must be 8-bit.");
-    static_assert(std::is_signed<sz_error_cost_t>() == std::is_signed<std::int8_t>(),
-                  "sz_error_cost_t must be signed.");
+    basic_suffix_index(basic_suffix_index &&other) noexcept
+        : text_(other.text_), suffixes_(other.suffixes_), owned_suffixes_(other.owned_suffixes_) {
+        other.text_ = {}, other.suffixes_ = nullptr, other.owned_suffixes_ = nullptr;
+    }
 
-    std::ptrdiff_t result;
-    if (!_with_alloc(allocator, [&](sz_memory_allocator_t &alloc) {
-            result = sz_alignment_score(a.data(), a.size(), b.data(), b.size(), &subs[0][0], gap, &alloc);
-            return result != SZ_SSIZE_MAX;
-        }))
-        throw std::bad_alloc();
-    return result;
-}
+    basic_suffix_index &operator=(basic_suffix_index &&other) noexcept {
+        std::swap(text_, other.text_);
+        std::swap(suffixes_, other.suffixes_);
+        std::swap(owned_suffixes_, other.owned_suffixes_);
+        return *this;
+    }
+
+    ~basic_suffix_index() noexcept { reset(); }
+
+    /**
+     *  @brief  Opens a serialized index, like a memory-mapped file produced by `save`, without copies.
+     *  @throw  `std::invalid_argument` if the buffer doesn't contain a valid index.
+     */
+    static basic_suffix_index open(string_view serialized) noexcept(false) {
+        basic_suffix_index index;
+        if (!index.try_open(serialized)) throw std::invalid_argument("Not a valid suffix index!");
+        return index;
+    }
+
+    /**
+     *  @brief  Builds the suffix array of the text, releasing the previous one.
+     *  @return `true` on success, `false` if the allocation fails, leaving the index empty.
+     */
+    bool try_build(string_view text) noexcept {
+        reset();
+        if (text.empty()) return true;
+        sz_size_t const bytes = text.size() * sizeof(sz_sorted_idx_t);
+        sz_sorted_idx_t *suffixes = nullptr;
+        bool built = _with_alloc([&](sz_memory_allocator_t &alloc) {
+            suffixes = (sz_sorted_idx_t *)alloc.allocate(bytes, alloc.handle);
+            if (!suffixes) return false;
+            if (sz_suffix_array(text.data(), text.size(), suffixes, &alloc)) return true;
+            alloc.free(suffixes, bytes, alloc.handle);
+            return false;
+        });
+        if (!built) return false;
+        text_ = text, suffixes_ = owned_suffixes_ = suffixes;
+        return true;
+    }
+
+    /**
+     *  @brief  Opens a serialized index, like a memory-mapped file produced by `save`, without copies.
+     *  @return `true` on success, `false` if the buffer doesn't contain a valid index, leaving the index empty.
+     */
+    bool try_open(string_view serialized) noexcept {
+        reset();
+        sz_cptr_t text;
+        sz_size_t length;
+        sz_sorted_idx_t const *suffixes;
+        if (!sz_suffix_index_parse(serialized.data(), serialized.size(), &text, &length, &suffixes)) return false;
+        text_ = string_view(text, length), suffixes_ = suffixes;
+        return true;
+    }
+
+    /**  @brief  Releases the suffix array, if it was built rather than opened. */
+    void reset() noexcept {
+        if (owned_suffixes_)
+            _with_alloc([&](sz_memory_allocator_t &alloc) {
+                alloc.free(owned_suffixes_, text_.size() * sizeof(sz_sorted_idx_t), alloc.handle);
+                return true;
+            });
+        text_ = {}, suffixes_ = owned_suffixes_ = nullptr;
+    }
+
+    string_view text() const noexcept { return text_; }
+    sz_sorted_idx_t const *suffixes() const noexcept { return suffixes_; }
+    size_type size() const noexcept { return text_.size(); }
+    bool empty() const noexcept { return text_.empty(); }
 
-/**
- *  @brief  Calculates the Needleman-Wunsch alignment score between two strings.
- *  @see    sz_alignment_score
- */
-template <typename char_type_, typename allocator_type_ = std::allocator<char_type_>>
-std::ptrdiff_t alignment_score(basic_string<char_type_, allocator_type_> const &a,
-                               basic_string<char_type_, allocator_type_> const &b, //
-                               std::int8_t const (&subs)[256][256], std::int8_t gap = -1) noexcept(false) {
-    return ashvardanian::stringzilla::alignment_score(a.view(), b.view(), subs, gap, a.get_allocator());
-}
+    /**  @brief  Number of bytes in the serialized form of the index, produced by `save`. */
+    size_type serialized_size() const noexcept {
+        return SZ_SUFFIX_INDEX_HEADER_SIZE + text_.size() * (sizeof(sz_sorted_idx_t) + 1);
+    }
 
-/**
- *  @brief  Overwrites the string slice with random characters from the given alphabet using the random generator.
- *
- *  @param  string     The string to overwrite.
- *  @param  generator  A random generator function object that returns a random number in the range [0, 2^64).
- *  @param  alphabet   A string of characters to choose from.
- */
-template <typename char_type_, typename generator_type_>
-void randomize(basic_string_slice<char_type_> string, generator_type_ &generator,
-               string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept {
-    static_assert(!std::is_const<char_type_>::value, "The string must be mutable.");
-    sz_random_generator_t generator_callback = &_call_random_generator<generator_type_>;
-    sz_generate(alphabet.data(), alphabet.size(), string.data(), string.size(), generator_callback, &generator);
-}
+    /**  @brief  Number of occurrences of the needle, including the overlapping ones. */
+    size_type count(string_view needle) const noexcept {
+        sz_size_t first;
+        return sz_suffix_array_range(text_.data(), text_.size(), suffixes_, needle.data(), needle.size(), &first);
+    }
 
-/**
- *  @brief  Overwrites the string slice with random characters from the given alphabet
- *          using `std::rand` as the random generator.
- *
- *  @param  string     The string to overwrite.
- *  @param  alphabet   A string of characters to choose from.
- */
-template <typename char_type_>
-void randomize(basic_string_slice<char_type_> string, string_view alphabet = "abcdefghijklmnopqrstuvwxyz") noexcept {
-    randomize(string, &std::rand, alphabet);
-}
+    /**  @brief  Offsets of all occurrences of the needle, including the overlapping ones, in no particular order. */
+    matches_type find_all(string_view needle) const noexcept {
+        sz_size_t first;
+        sz_size_t count =
+            sz_suffix_array_range(text_.data(), text_.size(), suffixes_, needle.data(), needle.size(), &first);
+        return {suffixes_ + first, suffixes_ + first + count};
+    }
 
-using sorted_idx_t = sz_sorted_idx_t;
+    /**
+     *  @brief  Finds the longest prefix of the needle, that occurs in the text.
+     *  @return A slice of the text, matching the longest prefix, or an empty slice at its start.
+     */
+    string_view longest_prefix(string_view needle) const noexcept {
+        sz_size_t offset;
+        sz_size_t length = sz_suffix_array_longest_prefix(text_.data(), text_.size(), suffixes_, needle.data(),
+                                                          needle.size(), &offset);
+        return text_.sub(offset, offset + length);
+    }
 
-/**
- *  @brief  Internal data-structure used to forward the arguments to the `sz_sort` function.
- *  @see    sorted_order
- */
-template <typename objects_type_, typename string_extractor_>
-struct _sequence_args {
-    objects_type_ const *begin;
-    std::size_t count;
-    sorted_idx_t *order;
-    string_extractor_ extractor;
+    /**
+     *  @brief  Writes the index and the text into a file, that can be memory-mapped and passed to `open`.
+     *  @return `true` on success, `false` if the file can't be written.
+     */
+    bool try_save(char const *path) const noexcept {
+        std::FILE *file = std::fopen(path, "wb");
+        if (!file) return false;
+        char header[SZ_SUFFIX_INDEX_HEADER_SIZE];
+        sz_suffix_index_header(text_.size(), header);
+        bool written = std::fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+                       std::fwrite(suffixes_, sizeof(sz_sorted_idx_t), text_.size(), file) == text_.size() &&
+                       std::fwrite(text_.data(), 1, text_.size(), file) == text_.size();
+        return std::fclose(file) == 0 && written;
+    }
+
+    /**
+     *  @brief  Writes the index and the text into a file, that can be memory-mapped and passed to `open`.
+     *  @throw  `std::runtime_error` if the file can't be written.
+     */
+    void save(char const *path) const noexcept(false) {
+        if (!try_save(path)) throw std::runtime_error("Couldn't save the suffix index!");
+    }
 };
 
-template <typename objects_type_, typename string_extractor_>
-sz_cptr_t _call_sequence_member_start(struct sz_sequence_t const *sequence, sz_size_t i) {
-    using handle_type = _sequence_args<objects_type_, string_extractor_>;
-    handle_type const *args = reinterpret_cast<handle_type const *>(sequence->handle);
-    string_view member = args->extractor(args->begin[i]);
-    return member.data();
-}
+using suffix_index = basic_suffix_index<>;
 
-template <typename objects_type_, typename string_extractor_>
-sz_size_t _call_sequence_member_length(struct sz_sequence_t const *sequence, sz_size_t i) {
-    using handle_type = _sequence_args<objects_type_, string_extractor_>;
-    handle_type const *args = reinterpret_cast<handle_type const *>(sequence->handle);
-    string_view member = args->extractor(args->begin[i]);
-    return static_cast<sz_size_t>(member.size());
-}
+#pragma endregion
 
 /**
- *  @brief  Computes the permutation of an array, that would lead to sorted order.
- *          The elements of the array must be convertible to a `string_view` with the given extractor.
- *          Unlike the `sz_sort` C interface, overwrites the output array.
- *
- *  @param[in] begin       The pointer to the first element of the array.
- *  @param[in] end         The pointer to the element after the last element of the array.
- *  @param[out] order      The pointer to the output array of indices, that will be populated with the permutation.
- *  @param[in] extractor   The function object that extracts the string from the object.
- *
- *  @see    sz_sort
+ *  @brief  Computes the MinHash and SimHash sketches of a string for several window lengths in one sweep.
+ *  @param  min_hashes  Optional buffer for `windows_count * permutations_count` values, grouped by window length.
+ *  @param  sim_hashes  Optional buffer for `windows_count` values.
+ *  @see    sz_hashes_sketch
  */
-template <typename objects_type_, typename string_extractor_>
-void sorted_order(objects_type_ const *begin, objects_type_ const *end, sorted_idx_t *order,
-                  string_extractor_ &&extractor) noexcept {
-
-    // Pack the arguments into a single structure to reference it from the callback.
-    _sequence_args<objects_type_, string_extractor_> args = {begin, static_cast<std::size_t>(end - begin), order,
-                                                             std::forward<string_extractor_>(extractor)};
-    // Populate the array with `iota`-style order.
-    for (std::size_t i = 0; i != args.count; ++i) order[i] = static_cast<sorted_idx_t>(i);
+template <typename char_type_>
+void hashes_sketch(basic_string_slice<char_type_> const &str, std::size_t const *window_lengths,
+                   std::size_t windows_count, std::size_t permutations_count, sz_u64_t *min_hashes,
+                   sz_u64_t *sim_hashes) noexcept {
+    sz_hashes_sketch(str.data(), str.size(), window_lengths, windows_count, permutations_count, min_hashes,
+                     sim_hashes);
+}
 
-    sz_sequence_t array;
-    array.order = reinterpret_cast<sorted_idx_t *>(order);
-    array.count = args.count;
-    array.handle = &args;
-    array.get_start = _call_sequence_member_start<objects_type_, string_extractor_>;
-    array.get_length = _call_sequence_member_length<objects_type_, string_extractor_>;
-    sz_sort(&array);
+/**
+ *  @brief  Computes the MinHash and SimHash sketches of a string for several window lengths in one sweep.
+ *  @see    sz_hashes_sketch
+ */
+template <std::size_t windows_count_, std::size_t permutations_count_, typename char_type_>
+void hashes_sketch(basic_string_slice<char_type_> const &str, std::size_t const (&window_lengths)[windows_count_],
+                   sz_u64_t (&min_hashes)[windows_count_][permutations_count_],
+                   sz_u64_t (&sim_hashes)[windows_count_]) noexcept {
+    sz_hashes_sketch(str.data(), str.size(), &window_lengths[0], windows_count_, permutations_count_,
+                     &min_hashes[0][0], &sim_hashes[0]);
 }
 
 #if !SZ_AVOID_STL
@@ -3765,6 +5824,364 @@ std::bitset<bitset_bits_> hashes_fingerprint(basic_string<char_type_> const &str
     return ashvardanian::stringzilla::hashes_fingerprint<bitset_bits_>(str.view(), window_length);
 }
 
+#pragma region Fingerprint Index
+
+/**
+ *  @brief  Column of binary fingerprints, like the ones produced by `hashes_fingerprint`, answering the top-k
+ *          Jaccard and Hamming similarity queries with fused population-count scans. Every fingerprint is padded
+ *          with zeros to whole cache lines. Optional banded LSH buckets narrow the scans down to the fingerprints,
+ *          that match the query exactly in at least one band. Can be saved into a file, that is later
+ *          memory-mapped and opened without any load cost.
+ *
+ *  @code{.cpp}
+ *      sz::fingerprint_index<1024> index;
+ *      for (auto const &document : documents) index.push_back(sz::hashes_fingerprint<1024>(document, 5));
+ *      index.build_buckets(16);
+ *      index.save("documents.fpi");
+ *
+ *      sz::mapped_file file("documents.fpi", sz::mapped_file::random);
+ *      auto mapped_index = sz::fingerprint_index<1024>::open(file.view());
+ *      auto neighbors = mapped_index.search_buckets(sz::hashes_fingerprint<1024>(query, 5), 10);
+ *  @endcode
+ *
+ *  @tparam bits_            Number of bits in every fingerprint.
+ *  @tparam allocator_type_  Stateless allocator, used for the fingerprints and the buckets of the built indexes.
+ *  @warning The serialized index, if opened rather than built, is not copied and must outlive the index!
+ *  @see    sz_fingerprints_top_k
+ */
+template <std::size_t bits_, typename allocator_type_ = std::allocator<char>>
+class basic_fingerprint_index {
+
+    static_assert(std::is_empty<allocator_type_>::value, "We currently only support stateless allocators");
+
+  public:
+    using size_type = std::size_t;
+    using fingerprint_type = std::bitset<bits_>;
+    using match_type = sz_fingerprint_match_t;
+
+    /**  @brief  Number of bytes between consecutive fingerprints in the column, rounded up to cache lines. */
+    static constexpr size_type stride_k = (sizeof(fingerprint_type) + 63) / 64 * 64;
+
+    /**  @brief  Entry of the LSH buckets, sorted by the hash of the band within every band. */
+    struct bucket_type {
+        sz_u64_t key;
+        sz_u64_t id;
+    };
+
+  private:
+    static constexpr size_type header_size_k = 64;
+
+    sz_cptr_t column_ = nullptr;
+    sz_ptr_t owned_column_ = nullptr; // Unaligned allocation, holding the `column_`, if it was built.
+    size_type size_ = 0;
+    size_type capacity_ = 0;
+    bucket_type const *buckets_ = nullptr;
+    bucket_type *owned_buckets_ = nullptr;
+    size_type bands_ = 0;
+
+    template <typename allocator_callback>
+    static bool _with_alloc(allocator_callback &&callback) noexcept {
+        return ashvardanian::stringzilla::_with_alloc<allocator_type_>(callback);
+    }
+
+    static void _header(size_type count, size_type bands, sz_u64_t (&header)[8]) noexcept {
+        sz_copy((sz_ptr_t)&header[0], "SZFPRIDX", 8);
+        header[1] = 0x0102030405060708ull, header[2] = count, header[3] = stride_k, header[4] = bands;
+        header[5] = bits_, header[6] = 0, header[7] = 0;
+    }
+
+    void _release_column() noexcept {
+        if (owned_column_)
+            _with_alloc([&](sz_memory_allocator_t &alloc) {
+                alloc.free(owned_column_, capacity_ * stride_k + 64, alloc.handle);
+                return true;
+            });
+        column_ = owned_column_ = nullptr, size_ = capacity_ = 0;
+    }
+
+    static sz_size_t _copy_padded(fingerprint_type const &fingerprint, sz_ptr_t padded) noexcept {
+        sz_copy(padded, (sz_cptr_t)&fingerprint, sizeof(fingerprint_type));
+        sz_fill(padded + sizeof(fingerprint_type), stride_k - sizeof(fingerprint_type), 0);
+        return stride_k;
+    }
+
+  public:
+    basic_fingerprint_index() noexcept = default;
+    basic_fingerprint_index(basic_fingerprint_index const &) = delete;
+    basic_fingerprint_index &operator=(basic_fingerprint_index const &) = delete;
+
+    basic_fingerprint_index(basic_fingerprint_index &&other) noexcept
+        : column_(other.column_), owned_column_(other.owned_column_), size_(other.size_), capacity_(other.capacity_),
+          buckets_(other.buckets_), owned_buckets_(other.owned_buckets_), bands_(other.bands_) {
+        other.column_ = other.owned_column_ = nullptr, other.size_ = other.capacity_ = 0;
+        other.buckets_ = other.owned_buckets_ = nullptr, other.bands_ = 0;
+    }
+
+    basic_fingerprint_index &operator=(basic_fingerprint_index &&other) noexcept {
+        std::swap(column_, other.column_);
+        std::swap(owned_column_, other.owned_column_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(buckets_, other.buckets_);
+        std::swap(owned_buckets_, other.owned_buckets_);
+        std::swap(bands_, other.bands_);
+        return *this;
+    }
+
+    ~basic_fingerprint_index() noexcept { reset(); }
+
+    /**
+     *  @brief  Opens a serialized index, like a memory-mapped file produced by `save`, without copies.
+     *  @throw  `std::invalid_argument` if the buffer doesn't contain a valid index of `bits_`-bit fingerprints.
+     */
+    static basic_fingerprint_index open(string_view serialized) noexcept(false) {
+        basic_fingerprint_index index;
+        if (!index.try_open(serialized)) throw std::invalid_argument("Not a valid fingerprint index!");
+        return index;
+    }
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    size_type bands() const noexcept { return bands_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**  @brief  Column of `size()` fingerprints, each taking `stride_k` bytes, aligned to cache lines if built. */
+    sz_cptr_t data() const noexcept { return column_; }
+
+    /**  @brief  LSH buckets of `size()` entries per band, if they were built, or NULL. */
+    bucket_type const *buckets() const noexcept { return buckets_; }
+
+    /**  @brief  Copy of the fingerprint at the given position. */
+    fingerprint_type operator[](size_type i) const noexcept {
+        fingerprint_type fingerprint;
+        sz_copy((sz_ptr_t)&fingerprint, column_ + i * stride_k, sizeof(fingerprint_type));
+        return fingerprint;
+    }
+
+    /**  @brief  Number of bytes in the serialized form of the index, produced by `save`. */
+    size_type serialized_size() const noexcept {
+        return header_size_k + size_ * stride_k + size_ * bands_ * sizeof(bucket_type);
+    }
+
+    /**
+     *  @brief  Allocates an aligned column for at least @p capacity fingerprints, copying the existing ones.
+     *          An opened index is copied into owned memory, so it can grow.
+     *  @return `true` on success, `false` if the allocation fails, leaving the index unchanged.
+     */
+    bool try_reserve(size_type capacity) noexcept {
+        if (capacity <= capacity_ && owned_column_) return true;
+        if (capacity < size_) capacity = size_;
+        if (capacity > (SZ_SIZE_MAX - 64) / stride_k) return false;
+        sz_ptr_t owned = nullptr;
+        bool allocated = _with_alloc([&](sz_memory_allocator_t &alloc) {
+            owned = (sz_ptr_t)alloc.allocate(capacity * stride_k + 64, alloc.handle);
+            return owned != nullptr;
+        });
+        if (!allocated) return false;
+        sz_ptr_t column = owned + (64 - reinterpret_cast<sz_size_t>(owned) % 64) % 64;
+        size_type const size = size_;
+        if (size) sz_copy(column, column_, size * stride_k);
+        _release_column();
+        column_ = column, owned_column_ = owned, size_ = size, capacity_ = capacity;
+        return true;
+    }
+
+    /**
+     *  @brief  Allocates an aligned column for at least @p capacity fingerprints, copying the existing ones.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    void reserve(size_type capacity) noexcept(false) {
+        if (!try_reserve(capacity)) throw std::bad_alloc();
+    }
+
+    /**
+     *  @brief  Appends a fingerprint to the column, releasing the LSH buckets, that have to be rebuilt.
+     *  @return `true` on success, `false` if the allocation fails, leaving the fingerprints unchanged.
+     */
+    bool try_push_back(fingerprint_type const &fingerprint) noexcept {
+        if ((size_ == capacity_ || !owned_column_) && !try_reserve(size_ < 32 ? 64 : size_ * 2)) return false;
+        reset_buckets();
+        _copy_padded(fingerprint, const_cast<sz_ptr_t>(column_) + size_ * stride_k);
+        ++size_;
+        return true;
+    }
+
+    /**
+     *  @brief  Appends a fingerprint to the column, releasing the LSH buckets, that have to be rebuilt.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    void push_back(fingerprint_type const &fingerprint) noexcept(false) {
+        if (!try_push_back(fingerprint)) throw std::bad_alloc();
+    }
+
+    /**
+     *  @brief  Builds the banded LSH buckets, splitting every fingerprint into @p bands equal slices and keying
+     *          them by their hashes. More bands find more distant neighbors, at the cost of larger candidate sets.
+     *  @param  bands   Number of bands, from one to the number of bytes in a fingerprint. Zero drops the buckets.
+     *  @return `true` on success, `false` if the allocation fails or the @p bands is too large.
+     */
+    bool try_build_buckets(size_type bands) noexcept {
+        reset_buckets();
+        if (bands == 0 || size_ == 0) return bands <= sizeof(fingerprint_type);
+        if (bands > sizeof(fingerprint_type) || size_ > SZ_SIZE_MAX / sizeof(bucket_type) / bands) return false;
+        sz_size_t const bytes = size_ * bands * sizeof(bucket_type);
+        bucket_type *buckets = nullptr;
+        bool allocated = _with_alloc([&](sz_memory_allocator_t &alloc) {
+            buckets = (bucket_type *)alloc.allocate(bytes, alloc.handle);
+            return buckets != nullptr;
+        });
+        if (!allocated) return false;
+
+        size_type const band_bytes = sizeof(fingerprint_type) / bands;
+        for (size_type band = 0; band != bands; ++band) {
+            bucket_type *first = buckets + band * size_;
+            for (size_type i = 0; i != size_; ++i)
+                first[i].key = sz_hash(column_ + i * stride_k + band * band_bytes, band_bytes), first[i].id = i;
+            std::sort(first, first + size_, [](bucket_type const &a, bucket_type const &b) {
+                return a.key < b.key || (a.key == b.key && a.id < b.id);
+            });
+        }
+        buckets_ = owned_buckets_ = buckets, bands_ = bands;
+        return true;
+    }
+
+    /**
+     *  @brief  Builds the banded LSH buckets, splitting every fingerprint into @p bands equal slices.
+     *  @throw  `std::bad_alloc` if the allocation fails, `std::invalid_argument` if the @p bands is too large.
+     */
+    void build_buckets(size_type bands) noexcept(false) {
+        if (bands > sizeof(fingerprint_type)) throw std::invalid_argument("Too many bands for the fingerprint!");
+        if (!try_build_buckets(bands)) throw std::bad_alloc();
+    }
+
+    /**
+     *  @brief  Scores the query against every fingerprint in the index.
+     *  @param  matches Output buffer for @p k matches, sorted from the most similar.
+     *  @return Number of reported matches, the smaller of @p k and `size()`.
+     */
+    size_type try_search(fingerprint_type const &query, size_type k, match_type *matches,
+                         sz_fingerprint_metric_t metric = sz_fingerprint_jaccard_k) const noexcept {
+        alignas(64) char padded[stride_k];
+        sz_size_t const stride = _copy_padded(query, padded);
+        return sz_fingerprints_top_k(padded, column_, stride, nullptr, size_, k, metric, matches);
+    }
+
+    /**
+     *  @brief  Scores the query against every fingerprint in the index.
+     *  @return Up to @p k matches, sorted from the most similar.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    std::vector<match_type> search(fingerprint_type const &query, size_type k,
+                                   sz_fingerprint_metric_t metric = sz_fingerprint_jaccard_k) const noexcept(false) {
+        std::vector<match_type> matches(k < size_ ? k : size_);
+        matches.resize(try_search(query, k, matches.data(), metric));
+        return matches;
+    }
+
+    /**
+     *  @brief  Scores the query only against the fingerprints, that share at least one LSH bucket with it.
+     *          Falls back to the exhaustive `search`, if the buckets weren't built.
+     *  @return Up to @p k matches, sorted from the most similar.
+     *  @throw  `std::bad_alloc` if the allocation fails.
+     */
+    std::vector<match_type> search_buckets(fingerprint_type const &query, size_type k,
+                                           sz_fingerprint_metric_t metric = sz_fingerprint_jaccard_k) const
+        noexcept(false) {
+        if (!buckets_) return search(query, k, metric);
+        alignas(64) char padded[stride_k];
+        sz_size_t const stride = _copy_padded(query, padded);
+
+        std::vector<sz_sorted_idx_t> candidates;
+        size_type const band_bytes = sizeof(fingerprint_type) / bands_;
+        for (size_type band = 0; band != bands_; ++band) {
+            sz_u64_t key = sz_hash(padded + band * band_bytes, band_bytes);
+            bucket_type const *first = buckets_ + band * size_;
+            first = std::lower_bound(first, first + size_, key,
+                                     [](bucket_type const &bucket, sz_u64_t value) { return bucket.key < value; });
+            for (bucket_type const *last = buckets_ + (band + 1) * size_; first != last && first->key == key; ++first)
+                candidates.push_back(first->id);
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        std::vector<match_type> matches(k < candidates.size() ? k : candidates.size());
+        matches.resize(sz_fingerprints_top_k(padded, column_, stride, candidates.data(), candidates.size(), k, metric,
+                                             matches.data()));
+        return matches;
+    }
+
+    /**
+     *  @brief  Opens a serialized index, like a memory-mapped file produced by `save`, without copies.
+     *  @return `true` on success, `false` if the buffer doesn't contain a valid index, leaving the index empty.
+     */
+    bool try_open(string_view serialized) noexcept {
+        reset();
+        sz_u64_t header[8];
+        if (serialized.size() < header_size_k || reinterpret_cast<sz_size_t>(serialized.data()) % 8) return false;
+        sz_copy((sz_ptr_t)&header[0], serialized.data(), sizeof(header));
+        sz_u64_t expected[8];
+        _header(0, 0, expected);
+        if (header[0] != expected[0] || header[1] != expected[1] || header[3] != stride_k || header[5] != bits_)
+            return false;
+
+        sz_size_t const body_bytes = serialized.size() - header_size_k;
+        sz_u64_t const count = header[2], bands = header[4];
+        if (count > body_bytes / stride_k || bands > sizeof(fingerprint_type)) return false;
+        sz_size_t const buckets_bytes = body_bytes - count * stride_k;
+        if (bands && count > buckets_bytes / sizeof(bucket_type) / bands) return false;
+        if (buckets_bytes != count * bands * sizeof(bucket_type)) return false;
+
+        column_ = serialized.data() + header_size_k, size_ = capacity_ = count;
+        if (bands && count) buckets_ = (bucket_type const *)(column_ + count * stride_k), bands_ = bands;
+        return true;
+    }
+
+    /**
+     *  @brief  Writes the fingerprints and the LSH buckets into a file, that can be memory-mapped and opened.
+     *  @return `true` on success, `false` if the file can't be written.
+     */
+    bool try_save(char const *path) const noexcept {
+        std::FILE *file = std::fopen(path, "wb");
+        if (!file) return false;
+        sz_u64_t header[8];
+        _header(size_, bands_, header);
+        size_type const buckets_count = size_ * bands_;
+        bool written = std::fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+                       std::fwrite(column_, stride_k, size_, file) == size_ &&
+                       std::fwrite(buckets_, sizeof(bucket_type), buckets_count, file) == buckets_count;
+        return std::fclose(file) == 0 && written;
+    }
+
+    /**
+     *  @brief  Writes the fingerprints and the LSH buckets into a file, that can be memory-mapped and opened.
+     *  @throw  `std::runtime_error` if the file can't be written.
+     */
+    void save(char const *path) const noexcept(false) {
+        if (!try_save(path)) throw std::runtime_error("Couldn't save the fingerprint index!");
+    }
+
+    /**  @brief  Releases the LSH buckets, if they were built rather than opened, keeping the fingerprints. */
+    void reset_buckets() noexcept {
+        if (owned_buckets_)
+            _with_alloc([&](sz_memory_allocator_t &alloc) {
+                alloc.free(owned_buckets_, size_ * bands_ * sizeof(bucket_type), alloc.handle);
+                return true;
+            });
+        buckets_ = owned_buckets_ = nullptr, bands_ = 0;
+    }
+
+    /**  @brief  Releases the fingerprints and the LSH buckets, if they were built rather than opened. */
+    void reset() noexcept {
+        reset_buckets();
+        _release_column();
+    }
+};
+
+template <std::size_t bits_ = 1024>
+using fingerprint_index = basic_fingerprint_index<bits_>;
+
+#pragma endregion
+
 /**
  *  @brief  Computes the permutation of an array, that would lead to sorted order.
  *  @return The array of indices, that will be populated with the permutation.
@@ -3803,6 +6220,150 @@ std::vector<sorted_idx_t> sorted_order(std::vector<string_like_type_> const &arr
                         [](string_like_type_ const &s) -> string_view { return s; });
 }
 
+#if !SZ_AVOID_MMAP
+#pragma region External Sort
+
+/**
+ *  @brief  Writes the records of a run in sorted order into a tape, that can be memory-mapped and parsed
+ *          with `sz_tape_parse`. Uses 32-bit offsets, unless the records are longer than 4 GB in total.
+ */
+inline bool _external_sort_write_run(char const *path, std::vector<string_view> const &records,
+                                     std::vector<sorted_idx_t> const &order) noexcept {
+    std::size_t total_length = 0;
+    for (string_view record : records) total_length += record.size();
+    std::size_t const offset_bytes = total_length > 0xFFFFFFFFull ? 8 : 4;
+    std::FILE *file = std::fopen(path, "wb");
+    if (!file) return false;
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+    char header[SZ_TAPE_HEADER_SIZE];
+    sz_tape_header(records.size(), offset_bytes, header);
+    bool written = std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+    // Export the `count + 1` offsets in batches, to avoid a temporary array as large as the run.
+    sz_u32_t offsets_u32[256];
+    sz_u64_t offsets_u64[256];
+    std::size_t offset = 0;
+    for (std::size_t first = 0; written && first <= records.size(); first += 256) {
+        std::size_t const batch = (std::min)(std::size_t(256), records.size() + 1 - first);
+        for (std::size_t i = 0; i != batch; ++i) {
+            offsets_u32[i] = static_cast<sz_u32_t>(offset), offsets_u64[i] = offset;
+            if (first + i != records.size()) offset += records[order[first + i]].size();
+        }
+        written = offset_bytes == 4 ? std::fwrite(offsets_u32, 4, batch, file) == batch
+                                    : std::fwrite(offsets_u64, 8, batch, file) == batch;
+    }
+    for (std::size_t i = 0; written && i != records.size(); ++i) {
+        string_view record = records[order[i]];
+        written = std::fwrite(record.data(), 1, record.size(), file) == record.size();
+    }
+    return std::fclose(file) == 0 && written;
+}
+
+/**
+ *  @brief  Sorts the records of a text, that may be larger than RAM, like a memory-mapped file, into a file.
+ *          Splits the text into runs, sorts every run in memory with `sz_sort`, writes it into a temporary tape
+ *          next to the output, and merges the memory-mapped runs with the `sz_merge_runs` loser tree.
+ *          The runs are mapped with sequential read-ahead, so the kernel fetches them while the merge is busy.
+ *
+ *  @code{.cpp}
+ *      sz::mapped_file dump("dump.txt", sz::mapped_file::sequential);
+ *      sz::external_sort(dump.view(), "dump.sorted.txt", 1ull << 30);
+ *  @endcode
+ *
+ *  @param  text        Records to sort, delimited by the @p separator. A trailing separator doesn't add a record.
+ *  @param  output_path Path of the output, where every record is followed by the @p separator, including the last.
+ *  @param  run_bytes   Number of bytes of the text, sorted in memory at once, taking 24 more bytes per record.
+ *  @param  separator   Delimiter of the records, like the newline character.
+ *  @return `true` on success, `false` if the runs or the output couldn't be allocated, written, or mapped.
+ *  @see    sz_merge_runs, sz_tape_parse
+ */
+inline bool try_external_sort(string_view text, char const *output_path, std::size_t run_bytes = 1ull << 30,
+                              char separator = '\n') noexcept {
+    std::vector<std::string> run_paths;
+    auto remove_runs = [&]() {
+        for (std::string const &run_path : run_paths) std::remove(run_path.c_str());
+        return false;
+    };
+    try {
+        // Sort the runs in memory, cutting them on the record boundaries.
+        std::vector<string_view> records;
+        std::vector<sorted_idx_t> order;
+        if (!run_bytes) run_bytes = 1;
+        for (std::size_t run_start = 0; run_start != text.size();) {
+            std::size_t run_end = text.size();
+            if (text.size() - run_start > run_bytes) {
+                std::size_t const last = run_start + run_bytes - 1;
+                sz_cptr_t found = sz_find_byte(text.data() + last, text.size() - last, &separator);
+                if (found) run_end = static_cast<std::size_t>(found - text.data()) + 1;
+            }
+            string_view run = text.sub(run_start, run_end);
+            records.clear();
+            for (std::size_t offset = 0; offset != run.size();) {
+                sz_cptr_t found = sz_find_byte(run.data() + offset, run.size() - offset, &separator);
+                std::size_t record_end = found ? static_cast<std::size_t>(found - run.data()) : run.size();
+                records.push_back(run.sub(offset, record_end));
+                offset = found ? record_end + 1 : run.size();
+            }
+            order.resize(records.size());
+            sorted_order(records.data(), records.data() + records.size(), order.data(),
+                         [](string_view record) { return record; });
+            run_paths.push_back(std::string(output_path) + "." + std::to_string(run_paths.size()) + ".run");
+            if (!_external_sort_write_run(run_paths.back().c_str(), records, order)) return remove_runs();
+            run_start = run_end;
+        }
+        records = {}, order = {};
+
+        // Map all of the runs at once, relying on the read-ahead to overlap the I/O with the merge.
+        std::vector<mapped_file> runs(run_paths.size());
+        std::vector<sz_tape_t> tapes(run_paths.size());
+        std::vector<sz_sequence_t> sequences(run_paths.size());
+        for (std::size_t i = 0; i != run_paths.size(); ++i) {
+            sz_size_t offset_bytes;
+            if (!runs[i].try_open(run_paths[i].c_str(), mapped_file::sequential)) return remove_runs();
+            if (!sz_tape_parse(runs[i].data(), runs[i].size(), &tapes[i], &offset_bytes)) return remove_runs();
+            if (offset_bytes == 4) sz_sequence_from_u32tape(&tapes[i], nullptr, &sequences[i]);
+            else { sz_sequence_from_u64tape(&tapes[i], nullptr, &sequences[i]); }
+        }
+
+        struct output_state {
+            std::FILE *file;
+            char separator;
+            bool written;
+        } output = {std::fopen(output_path, "wb"), separator, true};
+        if (!output.file) return remove_runs();
+        std::setvbuf(output.file, nullptr, _IOFBF, 1 << 20);
+        bool merged = sz_merge_runs(
+            sequences.data(), sequences.size(),
+            [](sz_cptr_t start, sz_size_t length, sz_size_t, void *handle) {
+                output_state &output = *reinterpret_cast<output_state *>(handle);
+                output.written = output.written && std::fwrite(start, 1, length, output.file) == length &&
+                                 std::fputc(output.separator, output.file) != EOF;
+            },
+            &output, nullptr);
+        bool closed = std::fclose(output.file) == 0;
+        runs.clear();
+        remove_runs();
+        return merged && output.written && closed;
+    }
+    catch (...) {
+        return remove_runs();
+    }
+}
+
+/**
+ *  @brief  Sorts the records of a text, that may be larger than RAM, like a memory-mapped file, into a file.
+ *  @throw  `std::runtime_error` if the runs or the output couldn't be allocated, written, or mapped.
+ *  @see    try_external_sort
+ */
+inline void external_sort(string_view text, char const *output_path, std::size_t run_bytes = 1ull << 30,
+                          char separator = '\n') noexcept(false) {
+    if (!try_external_sort(text, output_path, run_bytes, separator))
+        throw std::runtime_error("Couldn't sort the records!");
+}
+
+#pragma endregion
+#endif
+
 #endif
 
 } // namespace stringzilla
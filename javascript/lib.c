@@ -9,71 +9,109 @@
  */
 #include <stdio.h>  // `printf` for debug builds
 #include <stdlib.h> // `malloc` to export strings into UTF-8
+#include <string.h> // `memcpy` to export offsets into typed arrays
 
 #include <node_api.h> // `napi_*` functions
 
 #include <stringzilla/stringzilla.h> // `sz_*` functions
 
-napi_value indexOfAPI(napi_env env, napi_callback_info info) {
-    size_t argc = 2;
-    napi_value args[2];
-    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
-
-    // Extract the C string from the JavaScript string for haystack and needle
-    sz_string_view_t haystack = {NULL, 0};
-    sz_string_view_t needle = {NULL, 0};
-
-    // For haystack
-    napi_get_value_string_utf8(env, args[0], NULL, 0, (size_t *)&haystack.length);
-    haystack.start = malloc(haystack.length + 1);
-    napi_get_value_string_utf8(env, args[0], (char *)haystack.start, haystack.length + 1, (size_t *)&haystack.length);
+/**
+ *  @brief  Bytes of a JavaScript argument. Buffers and typed arrays are viewed in place, without copies,
+ *          while strings have to be exported into UTF-8. Only in that case the ::owned copy is set.
+ */
+typedef struct sz_js_text_t {
+    sz_string_view_t view;
+    char *owned;
+} sz_js_text_t;
 
-    // For needle
-    napi_get_value_string_utf8(env, args[1], NULL, 0, (size_t *)&needle.length);
-    needle.start = malloc(needle.length + 1);
-    napi_get_value_string_utf8(env, args[1], (char *)needle.start, needle.length + 1, (size_t *)&needle.length);
+/**
+ *  @brief  Reads a string, a `Buffer`, or any `TypedArray` argument into @p text.
+ *  @return `napi_ok` on success, or `napi_string_expected`, if the argument has an unsupported type.
+ */
+static napi_status sz_js_text_init(napi_env env, napi_value value, sz_js_text_t *text) {
+    bool is_buffer = false, is_typedarray = false;
+    text->view.start = NULL;
+    text->view.length = 0;
+    text->owned = NULL;
 
-    // Convert the result to JavaScript BigInt and return
-    napi_value js_result;
-    if (needle.length == 0) { napi_create_bigint_int64(env, 0, &js_result); }
-    else {
-        sz_cptr_t result = sz_find(haystack.start, haystack.length, needle.start, needle.length);
+    // Node.js `Buffer`-s are `Uint8Array`-s, but are checked first to stay compatible with older N-API versions.
+    napi_is_buffer(env, value, &is_buffer);
+    if (is_buffer) {
+        void *data;
+        size_t length;
+        napi_status status = napi_get_buffer_info(env, value, &data, &length);
+        text->view.start = (sz_cptr_t)data;
+        text->view.length = length;
+        return status;
+    }
 
-        // In JavaScript, if `indexOf` is unable to indexOf the specified value, then it should return -1
-        if (result == NULL) { napi_create_bigint_int64(env, -1, &js_result); }
-        else { napi_create_bigint_uint64(env, result - haystack.start, &js_result); }
+    napi_is_typedarray(env, value, &is_typedarray);
+    if (is_typedarray) {
+        napi_typedarray_type type;
+        size_t count, byte_offset;
+        void *data;
+        napi_value array_buffer;
+        napi_status status = napi_get_typedarray_info(env, value, &type, &count, &data, &array_buffer, &byte_offset);
+        if (status != napi_ok) return status;
+        size_t item_size = type == napi_int8_array || type == napi_uint8_array || type == napi_uint8_clamped_array ? 1
+                           : type == napi_int16_array || type == napi_uint16_array                                ? 2
+                           : type == napi_int32_array || type == napi_uint32_array || type == napi_float32_array   ? 4
+                                                                                                                  : 8;
+        text->view.start = (sz_cptr_t)data;
+        text->view.length = count * item_size;
+        return napi_ok;
     }
 
-    // Cleanup
-    free((void *)haystack.start);
-    free((void *)needle.start);
-    return js_result;
+    size_t length;
+    napi_status status = napi_get_value_string_utf8(env, value, NULL, 0, &length);
+    if (status != napi_ok) return napi_string_expected;
+    text->owned = (char *)malloc(length + 1);
+    if (!text->owned) return napi_generic_failure;
+    napi_get_value_string_utf8(env, value, text->owned, length + 1, &length);
+    text->view.start = text->owned;
+    text->view.length = length;
+    return napi_ok;
 }
 
-napi_value countAPI(napi_env env, napi_callback_info info) {
-    size_t argc = 3;
-    napi_value args[3];
-    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
-
-    // Extract the C string from the JavaScript string for haystack and needle
-    sz_string_view_t haystack = {NULL, 0};
-    sz_string_view_t needle = {NULL, 0};
-
-    // For haystack
-    napi_get_value_string_utf8(env, args[0], NULL, 0, (size_t *)&haystack.length);
-    haystack.start = malloc(haystack.length + 1);
-    napi_get_value_string_utf8(env, args[0], (char *)haystack.start, haystack.length + 1, (size_t *)&haystack.length);
-
-    // For needle
-    napi_get_value_string_utf8(env, args[1], NULL, 0, (size_t *)&needle.length);
-    needle.start = malloc(needle.length + 1);
-    napi_get_value_string_utf8(env, args[1], (char *)needle.start, needle.length + 1, (size_t *)&needle.length);
+static void sz_js_text_free(sz_js_text_t *text) {
+    free(text->owned);
+    text->owned = NULL;
+}
 
-    bool overlap = false;
-    if (argc > 2) { napi_get_value_bool(env, args[2], &overlap); }
+/**
+ *  @brief  Reads the arguments of the function into @p texts, throwing a `TypeError` on the first unsupported one.
+ *  @return True on success. On failure, all the exported strings are already released.
+ */
+static bool sz_js_texts_init(napi_env env, napi_value const *args, size_t count, sz_js_text_t *texts) {
+    for (size_t i = 0; i != count; ++i) {
+        if (sz_js_text_init(env, args[i], &texts[i]) == napi_ok) continue;
+        for (size_t j = 0; j != i; ++j) sz_js_text_free(&texts[j]);
+        napi_throw_type_error(env, NULL, "Expected a string, a Buffer, or a TypedArray");
+        return false;
+    }
+    return true;
+}
 
-    void const *haystack_start = haystack.start, *needle_start = needle.start;
+/** @brief  Reads an optional non-negative integer argument, passed as a `Number` or a `BigInt`. */
+static sz_size_t sz_js_size_get(napi_env env, napi_value value, sz_size_t default_value) {
+    napi_valuetype type;
+    napi_typeof(env, value, &type);
+    if (type == napi_bigint) {
+        uint64_t result;
+        bool lossless;
+        napi_get_value_bigint_uint64(env, value, &result, &lossless);
+        return (sz_size_t)result;
+    }
+    if (type == napi_number) {
+        int64_t result;
+        napi_get_value_int64(env, value, &result);
+        return result > 0 ? (sz_size_t)result : 0;
+    }
+    return default_value;
+}
 
+/** @brief  Counts the occurrences of the @p needle, matching the semantics of the Python `str.count`. */
+static sz_size_t sz_js_count(sz_string_view_t haystack, sz_string_view_t needle, bool overlap) {
     size_t count = 0;
     if (needle.length == 0 || haystack.length == 0 || haystack.length < needle.length) { count = 0; }
     else if (overlap) {
@@ -96,10 +134,95 @@ napi_value countAPI(napi_env env, napi_callback_info info) {
             haystack.length -= offset + needle.length * found;
         }
     }
+    return count;
+}
+
+/**
+ *  @brief  Collects the offsets of all the occurrences of the @p needle into a growing @p offsets array.
+ *  @return False, if the memory couldn't be allocated, releasing the partial results.
+ */
+static bool sz_js_find_all(sz_string_view_t haystack, sz_string_view_t needle, bool overlap, sz_u64_t **offsets,
+                           sz_size_t *count) {
+    sz_cptr_t const start = haystack.start;
+    sz_size_t capacity = 0;
+    *offsets = NULL;
+    *count = 0;
+    if (needle.length == 0) return true;
+
+    sz_size_t const skip = overlap ? 1 : needle.length;
+    for (sz_cptr_t match; haystack.length >= needle.length &&
+                          (match = sz_find(haystack.start, haystack.length, needle.start, needle.length));) {
+        if (*count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            sz_u64_t *grown = (sz_u64_t *)realloc(*offsets, capacity * sizeof(sz_u64_t));
+            if (!grown) {
+                free(*offsets);
+                *offsets = NULL;
+                return false;
+            }
+            *offsets = grown;
+        }
+        (*offsets)[(*count)++] = (sz_u64_t)(match - start);
+        sz_size_t const consumed = (sz_size_t)(match - haystack.start) + skip;
+        haystack.start += consumed;
+        haystack.length -= consumed;
+    }
+    return true;
+}
+
+/** @brief  Exports the @p offsets into a new `BigUint64Array`. */
+static napi_value sz_js_offsets_export(napi_env env, sz_u64_t const *offsets, sz_size_t count) {
+    void *data;
+    napi_value array_buffer, result;
+    napi_create_arraybuffer(env, count * sizeof(sz_u64_t), &data, &array_buffer);
+    if (count) memcpy(data, offsets, count * sizeof(sz_u64_t));
+    napi_create_typedarray(env, napi_biguint64_array, count, array_buffer, 0, &result);
+    return result;
+}
+
+napi_value indexOfAPI(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+
+    // Extract the haystack and the needle, viewing the binary inputs in place
+    sz_js_text_t texts[2];
+    if (argc < 2 || !sz_js_texts_init(env, args, 2, texts)) return NULL;
+    sz_string_view_t haystack = texts[0].view, needle = texts[1].view;
+
+    // Convert the result to JavaScript BigInt and return
+    napi_value js_result;
+    if (needle.length == 0) { napi_create_bigint_int64(env, 0, &js_result); }
+    else {
+        sz_cptr_t result = sz_find(haystack.start, haystack.length, needle.start, needle.length);
+
+        // In JavaScript, if `indexOf` is unable to indexOf the specified value, then it should return -1
+        if (result == NULL) { napi_create_bigint_int64(env, -1, &js_result); }
+        else { napi_create_bigint_uint64(env, result - haystack.start, &js_result); }
+    }
+
+    // Cleanup
+    sz_js_text_free(&texts[0]);
+    sz_js_text_free(&texts[1]);
+    return js_result;
+}
+
+napi_value countAPI(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+
+    // Extract the haystack and the needle, viewing the binary inputs in place
+    sz_js_text_t texts[2];
+    if (argc < 2 || !sz_js_texts_init(env, args, 2, texts)) return NULL;
+
+    bool overlap = false;
+    if (argc > 2) { napi_get_value_bool(env, args[2], &overlap); }
+    size_t count = sz_js_count(texts[0].view, texts[1].view, overlap);
 
     // Cleanup
-    free((void *)haystack_start);
-    free((void *)needle_start);
+    sz_js_text_free(&texts[0]);
+    sz_js_text_free(&texts[1]);
 
     // Convert the `count` to JavaScript `BigInt` and return
     napi_value js_count;
@@ -108,12 +231,343 @@ napi_value countAPI(napi_env env, napi_callback_info info) {
     return js_count;
 }
 
+napi_value findAllAPI(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+
+    sz_js_text_t texts[2];
+    if (argc < 2 || !sz_js_texts_init(env, args, 2, texts)) return NULL;
+
+    bool overlap = false;
+    if (argc > 2) { napi_get_value_bool(env, args[2], &overlap); }
+
+    sz_u64_t *offsets;
+    sz_size_t count;
+    bool success = sz_js_find_all(texts[0].view, texts[1].view, overlap, &offsets, &count);
+    sz_js_text_free(&texts[0]);
+    sz_js_text_free(&texts[1]);
+    if (!success) {
+        napi_throw_error(env, NULL, "Failed to allocate memory for the offsets");
+        return NULL;
+    }
+
+    napi_value js_offsets = sz_js_offsets_export(env, offsets, count);
+    free(offsets);
+    return js_offsets;
+}
+
+napi_value splitAPI(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+
+    sz_js_text_t texts[2];
+    if (argc < 2 || !sz_js_texts_init(env, args, 2, texts)) return NULL;
+    sz_string_view_t text = texts[0].view, separator = texts[1].view;
+    if (separator.length == 0) {
+        sz_js_text_free(&texts[0]);
+        sz_js_text_free(&texts[1]);
+        napi_throw_range_error(env, NULL, "The separator can't be empty");
+        return NULL;
+    }
+
+    // Strings are split into strings, while the binary inputs are split into `Uint8Array` views of the same memory
+    bool const is_string = texts[0].owned != NULL;
+    napi_typedarray_type type;
+    size_t item_count, byte_offset = 0;
+    void *data;
+    napi_value array_buffer = NULL;
+    if (!is_string) {
+        bool is_typedarray = false;
+        napi_is_typedarray(env, args[0], &is_typedarray);
+        if (is_typedarray)
+            napi_get_typedarray_info(env, args[0], &type, &item_count, &data, &array_buffer, &byte_offset);
+    }
+
+    napi_value js_parts, js_part;
+    napi_create_array(env, &js_parts);
+    uint32_t parts_count = 0;
+    for (sz_cptr_t start = text.start, end = text.start + text.length;; ++parts_count) {
+        sz_cptr_t match = sz_find(start, (sz_size_t)(end - start), separator.start, separator.length);
+        sz_cptr_t part_end = match ? match : end;
+        sz_size_t part_length = (sz_size_t)(part_end - start);
+        if (is_string) napi_create_string_utf8(env, start, part_length, &js_part);
+        else if (array_buffer)
+            napi_create_typedarray(env, napi_uint8_array, part_length, array_buffer,
+                                   byte_offset + (size_t)(start - text.start), &js_part);
+        else napi_create_buffer_copy(env, part_length, start, NULL, &js_part);
+        napi_set_element(env, js_parts, parts_count, js_part);
+        if (!match) break;
+        start = match + separator.length;
+    }
+
+    sz_js_text_free(&texts[0]);
+    sz_js_text_free(&texts[1]);
+    return js_parts;
+}
+
+napi_value hashAPI(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+
+    sz_js_text_t text;
+    if (argc < 1 || !sz_js_texts_init(env, args, 1, &text)) return NULL;
+    sz_u64_t hash = sz_hash(text.view.start, text.view.length);
+    sz_js_text_free(&text);
+
+    napi_value js_hash;
+    napi_create_bigint_uint64(env, hash, &js_hash);
+    return js_hash;
+}
+
+napi_value editDistanceAPI(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+
+    sz_js_text_t texts[2];
+    if (argc < 2 || !sz_js_texts_init(env, args, 2, texts)) return NULL;
+    sz_size_t bound = argc > 2 ? sz_js_size_get(env, args[2], 0) : 0;
+
+    sz_memory_allocator_t alloc;
+    sz_memory_allocator_init_default(&alloc);
+    sz_size_t distance = sz_edit_distance(texts[0].view.start, texts[0].view.length, texts[1].view.start,
+                                          texts[1].view.length, bound, &alloc);
+    sz_js_text_free(&texts[0]);
+    sz_js_text_free(&texts[1]);
+    if (distance == SZ_SIZE_MAX) {
+        napi_throw_error(env, NULL, "Failed to allocate memory for the edit distance");
+        return NULL;
+    }
+
+    napi_value js_distance;
+    napi_create_bigint_uint64(env, distance, &js_distance);
+    return js_distance;
+}
+
+static sz_cptr_t sz_js_texts_get_start(sz_sequence_t const *sequence, sz_size_t i) {
+    return ((sz_js_text_t const *)sequence->handle)[i].view.start;
+}
+
+static sz_size_t sz_js_texts_get_length(sz_sequence_t const *sequence, sz_size_t i) {
+    return ((sz_js_text_t const *)sequence->handle)[i].view.length;
+}
+
+napi_value sortAPI(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+
+    bool is_array = false;
+    if (argc > 0) napi_is_array(env, args[0], &is_array);
+    if (!is_array) {
+        napi_throw_type_error(env, NULL, "Expected an array of strings, Buffers, or TypedArrays");
+        return NULL;
+    }
+
+    uint32_t count;
+    napi_get_array_length(env, args[0], &count);
+    napi_value *items = (napi_value *)malloc(sizeof(napi_value) * (count + 1));
+    sz_js_text_t *texts = (sz_js_text_t *)malloc(sizeof(sz_js_text_t) * (count + 1));
+    sz_sorted_idx_t *order = (sz_sorted_idx_t *)malloc(sizeof(sz_sorted_idx_t) * (count + 1));
+    if (!items || !texts || !order) {
+        free(items), free(texts), free(order);
+        napi_throw_error(env, NULL, "Failed to allocate memory for sorting");
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i != count; ++i) napi_get_element(env, args[0], i, &items[i]);
+    if (!sz_js_texts_init(env, items, count, texts)) {
+        free(items), free(texts), free(order);
+        return NULL;
+    }
+
+    // Sort stably, so that the equal strings and buffers preserve their relative order
+    sz_sequence_t sequence;
+    sequence.order = order;
+    sequence.count = count;
+    sequence.get_start = sz_js_texts_get_start;
+    sequence.get_length = sz_js_texts_get_length;
+    sequence.handle = texts;
+    for (sz_size_t i = 0; i != count; ++i) order[i] = i;
+    if (!sz_sort_stable(&sequence, NULL)) {
+        for (uint32_t i = 0; i != count; ++i) sz_js_text_free(&texts[i]);
+        free(items), free(texts), free(order);
+        napi_throw_error(env, NULL, "Failed to allocate memory for sorting");
+        return NULL;
+    }
+
+    // The original objects are placed into the new array in the sorted order, without copies
+    napi_value js_sorted;
+    napi_create_array_with_length(env, count, &js_sorted);
+    for (uint32_t i = 0; i != count; ++i) napi_set_element(env, js_sorted, i, items[order[i]]);
+
+    for (uint32_t i = 0; i != count; ++i) sz_js_text_free(&texts[i]);
+    free(items), free(texts), free(order);
+    return js_sorted;
+}
+
+/**
+ *  @brief  Kernels, that can run on the worker threads of the Node.js thread-pool via `napi_create_async_work`.
+ */
+typedef enum sz_js_task_kind_t {
+    sz_js_task_index_of_k,
+    sz_js_task_count_k,
+    sz_js_task_find_all_k,
+    sz_js_task_hash_k,
+    sz_js_task_edit_distance_k,
+} sz_js_task_kind_t;
+
+/**
+ *  @brief  State of an asynchronous call. The strings are exported before the work is queued, while the binary
+ *          inputs are referenced, to keep them alive until the task completes. They must not be resized meanwhile.
+ */
+typedef struct sz_js_task_t {
+    napi_async_work work;
+    napi_deferred deferred;
+    sz_js_task_kind_t kind;
+    sz_js_text_t texts[2];
+    napi_ref references[2];
+    size_t texts_count;
+    bool overlap;
+    sz_size_t bound;
+
+    sz_u64_t result;
+    sz_u64_t *offsets;
+    sz_size_t offsets_count;
+    bool failed;
+} sz_js_task_t;
+
+static void sz_js_task_execute(napi_env env, void *data) {
+    sz_js_task_t *task = (sz_js_task_t *)data;
+    sz_string_view_t first = task->texts[0].view, second = task->texts[1].view;
+    (void)env; // Worker threads can't call into JavaScript
+
+    switch (task->kind) {
+    case sz_js_task_index_of_k: {
+        sz_cptr_t match = second.length ? sz_find(first.start, first.length, second.start, second.length) : first.start;
+        task->result = match ? (sz_u64_t)(match - first.start) : (sz_u64_t)-1;
+    } break;
+    case sz_js_task_count_k: task->result = sz_js_count(first, second, task->overlap); break;
+    case sz_js_task_find_all_k:
+        task->failed = !sz_js_find_all(first, second, task->overlap, &task->offsets, &task->offsets_count);
+        break;
+    case sz_js_task_hash_k: task->result = sz_hash(first.start, first.length); break;
+    case sz_js_task_edit_distance_k: {
+        sz_memory_allocator_t alloc;
+        sz_memory_allocator_init_default(&alloc);
+        task->result = sz_edit_distance(first.start, first.length, second.start, second.length, task->bound, &alloc);
+        task->failed = task->result == SZ_SIZE_MAX;
+    } break;
+    }
+}
+
+static void sz_js_task_complete(napi_env env, napi_status status, void *data) {
+    sz_js_task_t *task = (sz_js_task_t *)data;
+    napi_value js_result;
+
+    if (status != napi_ok || task->failed) {
+        napi_value js_message;
+        napi_create_string_utf8(env, "Failed to complete the StringZilla task", NAPI_AUTO_LENGTH, &js_message);
+        napi_create_error(env, NULL, js_message, &js_result);
+        napi_reject_deferred(env, task->deferred, js_result);
+    }
+    else {
+        if (task->kind == sz_js_task_find_all_k)
+            js_result = sz_js_offsets_export(env, task->offsets, task->offsets_count);
+        else if (task->kind == sz_js_task_index_of_k && task->result == (sz_u64_t)-1)
+            napi_create_bigint_int64(env, -1, &js_result);
+        else napi_create_bigint_uint64(env, task->result, &js_result);
+        napi_resolve_deferred(env, task->deferred, js_result);
+    }
+
+    for (size_t i = 0; i != task->texts_count; ++i) {
+        if (task->references[i]) napi_delete_reference(env, task->references[i]);
+        sz_js_text_free(&task->texts[i]);
+    }
+    napi_delete_async_work(env, task->work);
+    free(task->offsets);
+    free(task);
+}
+
+/**
+ *  @brief  Queues the @p kind of kernel on the thread-pool, returning a `Promise` for its result.
+ *          Takes @p texts_count leading arguments and the optional third, that is either `overlap` or `bound`.
+ */
+static napi_value sz_js_task_queue(napi_env env, napi_callback_info info, sz_js_task_kind_t kind, size_t texts_count) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+    if (argc < texts_count) {
+        napi_throw_type_error(env, NULL, "Not enough arguments");
+        return NULL;
+    }
+
+    sz_js_task_t *task = (sz_js_task_t *)calloc(1, sizeof(sz_js_task_t));
+    if (!task) {
+        napi_throw_error(env, NULL, "Failed to allocate memory for the task");
+        return NULL;
+    }
+    if (!sz_js_texts_init(env, args, texts_count, task->texts)) {
+        free(task);
+        return NULL;
+    }
+    task->kind = kind;
+    task->texts_count = texts_count;
+    for (size_t i = 0; i != texts_count; ++i)
+        if (!task->texts[i].owned) napi_create_reference(env, args[i], 1, &task->references[i]);
+    if (argc > 2) {
+        if (kind == sz_js_task_edit_distance_k) task->bound = sz_js_size_get(env, args[2], 0);
+        else napi_get_value_bool(env, args[2], &task->overlap);
+    }
+
+    napi_value js_promise, js_name;
+    napi_create_promise(env, &task->deferred, &js_promise);
+    napi_create_string_utf8(env, "StringZilla", NAPI_AUTO_LENGTH, &js_name);
+    napi_create_async_work(env, NULL, js_name, sz_js_task_execute, sz_js_task_complete, task, &task->work);
+    napi_queue_async_work(env, task->work);
+    return js_promise;
+}
+
+napi_value indexOfAsyncAPI(napi_env env, napi_callback_info info) {
+    return sz_js_task_queue(env, info, sz_js_task_index_of_k, 2);
+}
+
+napi_value countAsyncAPI(napi_env env, napi_callback_info info) {
+    return sz_js_task_queue(env, info, sz_js_task_count_k, 2);
+}
+
+napi_value findAllAsyncAPI(napi_env env, napi_callback_info info) {
+    return sz_js_task_queue(env, info, sz_js_task_find_all_k, 2);
+}
+
+napi_value hashAsyncAPI(napi_env env, napi_callback_info info) {
+    return sz_js_task_queue(env, info, sz_js_task_hash_k, 1);
+}
+
+napi_value editDistanceAsyncAPI(napi_env env, napi_callback_info info) {
+    return sz_js_task_queue(env, info, sz_js_task_edit_distance_k, 2);
+}
+
 napi_value Init(napi_env env, napi_value exports) {
 
     // Define an array of property descriptors
-    napi_property_descriptor findDesc = {"indexOf", 0, indexOfAPI, 0, 0, 0, napi_default, 0};
-    napi_property_descriptor countDesc = {"count", 0, countAPI, 0, 0, 0, napi_default, 0};
-    napi_property_descriptor properties[] = {findDesc, countDesc};
+    napi_property_descriptor properties[] = {
+        {"indexOf", 0, indexOfAPI, 0, 0, 0, napi_default, 0},
+        {"count", 0, countAPI, 0, 0, 0, napi_default, 0},
+        {"findAll", 0, findAllAPI, 0, 0, 0, napi_default, 0},
+        {"split", 0, splitAPI, 0, 0, 0, napi_default, 0},
+        {"hash", 0, hashAPI, 0, 0, 0, napi_default, 0},
+        {"editDistance", 0, editDistanceAPI, 0, 0, 0, napi_default, 0},
+        {"sort", 0, sortAPI, 0, 0, 0, napi_default, 0},
+        {"indexOfAsync", 0, indexOfAsyncAPI, 0, 0, 0, napi_default, 0},
+        {"countAsync", 0, countAsyncAPI, 0, 0, 0, napi_default, 0},
+        {"findAllAsync", 0, findAllAsyncAPI, 0, 0, 0, napi_default, 0},
+        {"hashAsync", 0, hashAsyncAPI, 0, 0, 0, napi_default, 0},
+        {"editDistanceAsync", 0, editDistanceAsyncAPI, 0, 0, 0, napi_default, 0},
+    };
 
     // Define the properties on the `exports` object
     size_t propertyCount = sizeof(properties) / sizeof(properties[0]);
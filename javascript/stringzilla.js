@@ -1,22 +1,132 @@
 const compiled = require('bindings')('stringzilla');
 
+/**
+ * Every function accepts strings, as well as `Buffer`-s and other `TypedArray`-s.
+ * Binary inputs are viewed in place, while strings are exported into UTF-8 once per call.
+ * @typedef {string | Buffer | ArrayBufferView} Text
+ */
+
 module.exports = {
     /**
      * Searches for a short string in a long one.
-     * 
-     * @param {string} haystack 
-     * @param {string} needle 
-     * @returns {bigint}
+     *
+     * @param {Text} haystack
+     * @param {Text} needle
+     * @returns {bigint} Byte offset of the first match, or -1n.
+     */
+    find: compiled.indexOf,
+
+    /**
+     * Searches for a short string in a long one.
+     *
+     * @param {Text} haystack
+     * @param {Text} needle
+     * @returns {bigint} Byte offset of the first match, or -1n.
      */
-    find: compiled.find,
+    indexOf: compiled.indexOf,
 
     /**
      * Searches for a substring in a larger string.
-     * 
-     * @param {string} haystack 
-     * @param {string} needle 
-     * @param {boolean} overlap 
+     *
+     * @param {Text} haystack
+     * @param {Text} needle
+     * @param {boolean} overlap
+     * @returns {bigint}
+     */
+    count: compiled.count,
+
+    /**
+     * Locates all the occurrences of a substring in a larger string.
+     *
+     * @param {Text} haystack
+     * @param {Text} needle
+     * @param {boolean} overlap
+     * @returns {BigUint64Array} Byte offsets of the matches.
+     */
+    findAll: compiled.findAll,
+
+    /**
+     * Splits the text around every occurrence of a non-empty separator.
+     * Strings are split into strings, binary inputs into `Uint8Array` views of the same memory.
+     *
+     * @param {Text} text
+     * @param {Text} separator
+     * @returns {Array<string | Uint8Array>}
+     */
+    split: compiled.split,
+
+    /**
+     * Computes the 64-bit hash of the text.
+     *
+     * @param {Text} text
+     * @returns {bigint}
+     */
+    hash: compiled.hash,
+
+    /**
+     * Computes the Levenshtein distance between two byte strings.
+     *
+     * @param {Text} a
+     * @param {Text} b
+     * @param {number | bigint} bound Upper bound on the distance, that allows early exits, or zero for none.
      * @returns {bigint}
      */
-    count: compiled.count
+    editDistance: compiled.editDistance,
+
+    /**
+     * Stably sorts an array of strings or buffers in byte-wise lexicographic order.
+     *
+     * @param {Array<Text>} array
+     * @returns {Array<Text>} New array with the original elements.
+     * @throws {Error} If the temporary buffers of the stable sort can't be allocated.
+     */
+    sort: compiled.sort,
+
+    /**
+     * Asynchronous variant of `indexOf`, running on the thread-pool.
+     * Binary inputs must not be modified until the promise settles.
+     *
+     * @param {Text} haystack
+     * @param {Text} needle
+     * @returns {Promise<bigint>}
+     */
+    indexOfAsync: compiled.indexOfAsync,
+
+    /**
+     * Asynchronous variant of `count`, running on the thread-pool.
+     *
+     * @param {Text} haystack
+     * @param {Text} needle
+     * @param {boolean} overlap
+     * @returns {Promise<bigint>}
+     */
+    countAsync: compiled.countAsync,
+
+    /**
+     * Asynchronous variant of `findAll`, running on the thread-pool.
+     *
+     * @param {Text} haystack
+     * @param {Text} needle
+     * @param {boolean} overlap
+     * @returns {Promise<BigUint64Array>}
+     */
+    findAllAsync: compiled.findAllAsync,
+
+    /**
+     * Asynchronous variant of `hash`, running on the thread-pool.
+     *
+     * @param {Text} text
+     * @returns {Promise<bigint>}
+     */
+    hashAsync: compiled.hashAsync,
+
+    /**
+     * Asynchronous variant of `editDistance`, running on the thread-pool.
+     *
+     * @param {Text} a
+     * @param {Text} b
+     * @param {number | bigint} bound
+     * @returns {Promise<bigint>}
+     */
+    editDistanceAsync: compiled.editDistanceAsync
 };
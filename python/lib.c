@@ -13,10 +13,15 @@
 #define NOMINMAX
 #include <windows.h>
 #else
+// With `-std=c99` the `madvise` hints and `MAP_POPULATE` are hidden, unless requested explicitly.
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
 #include <fcntl.h>    // `O_RDNLY`
 #include <sys/mman.h> // `mmap`
 #include <sys/stat.h> // `stat`
 #include <sys/types.h>
+#include <pthread.h>  // `pthread_create`
 #endif
 
 #ifdef _MSC_VER
@@ -44,9 +49,57 @@ typedef SSIZE_T ssize_t;
 static PyTypeObject FileType;
 static PyTypeObject StrType;
 static PyTypeObject StrsType;
+static PyTypeObject SuffixIndexType;
 
 static sz_string_view_t temporary_memory = {NULL, 0};
 
+/**
+ *  @brief  Apache Arrow C Data Interface structures, as defined in the specification.
+ *          They are ABI-stable and can be redeclared by every producer and consumer.
+ *  @see    https://arrow.apache.org/docs/format/CDataInterface.html
+ */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    char const *format;
+    char const *name;
+    char const *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema *);
+    // Opaque producer-specific data
+    void *private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    void const **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray *);
+    // Opaque producer-specific data
+    void *private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
 /**
  *  @brief  Describes an on-disk file mapped into RAM, which is different from Python's
  *          native `mmap` module, as it exposes the address of the mapping in memory.
@@ -145,6 +198,20 @@ typedef struct {
 
 } Strs;
 
+/**
+ *  @brief  Suffix array over a static text, for repeated substring queries without rescanning it.
+ *          Either owns a freshly built suffix array, or points into a serialized index in a `File`.
+ *          In both cases, the `parent` object's reference count is incremented to preserve lifetime.
+ */
+typedef struct {
+    PyObject_HEAD //
+        PyObject *parent;
+    sz_cptr_t text;
+    sz_size_t length;
+    sz_sorted_idx_t const *suffixes;
+    sz_sorted_idx_t *owned_suffixes;
+} SuffixIndex;
+
 #pragma endregion
 
 #pragma region Helpers
@@ -172,6 +239,102 @@ static sz_size_t parts_get_length(sz_sequence_t *seq, sz_size_t i) {
     return ((sz_string_view_t const *)seq->handle)[i].length;
 }
 
+/**
+ *  @brief  State of a single worker thread of `parallel_for_threads`, that handles every ::threads_count-th task.
+ *          Tasks are assigned in a round-robin fashion, as algorithms submit the largest tasks first.
+ */
+typedef struct {
+    sz_task_t task;
+    void *task_state;
+    sz_size_t tasks_count;
+    sz_size_t threads_count;
+    sz_size_t thread_index;
+} parallel_for_thread_t;
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+static DWORD WINAPI parallel_for_thread(LPVOID argument) {
+#else
+static void *parallel_for_thread(void *argument) {
+#endif
+    parallel_for_thread_t *thread = (parallel_for_thread_t *)argument;
+    for (sz_size_t i = thread->thread_index; i < thread->tasks_count; i += thread->threads_count)
+        thread->task(thread->task_state, i);
+    return 0;
+}
+
+/**
+ *  @brief  Minimalistic executor for the parallel algorithms, spawning up to `*(sz_size_t *)executor_handle` threads
+ *          for every submitted batch of tasks. The calling thread also takes part in the work.
+ */
+static void parallel_for_threads(sz_task_t task, void *task_state, sz_size_t tasks_count, void *executor_handle) {
+    sz_size_t threads_count = *(sz_size_t *)executor_handle;
+    if (threads_count > tasks_count) threads_count = tasks_count;
+    if (threads_count > 256) threads_count = 256;
+
+    parallel_for_thread_t threads[256];
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    HANDLE handles[256];
+#else
+    pthread_t handles[256];
+#endif
+    sz_bool_t spawned[256];
+    for (sz_size_t i = 0; i != threads_count; ++i) {
+        threads[i].task = task, threads[i].task_state = task_state, threads[i].tasks_count = tasks_count;
+        threads[i].threads_count = threads_count, threads[i].thread_index = i;
+    }
+
+    // If a thread can't be spawned, its share of work will be done by the calling thread
+    for (sz_size_t i = 1; i < threads_count; ++i) {
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+        handles[i] = CreateThread(NULL, 0, parallel_for_thread, &threads[i], 0, NULL);
+        spawned[i] = handles[i] != NULL;
+#else
+        spawned[i] = pthread_create(&handles[i], NULL, parallel_for_thread, &threads[i]) == 0;
+#endif
+    }
+    if (threads_count) parallel_for_thread(&threads[0]);
+    for (sz_size_t i = 1; i < threads_count; ++i) {
+        if (!spawned[i]) {
+            parallel_for_thread(&threads[i]);
+            continue;
+        }
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+        WaitForSingleObject(handles[i], INFINITE);
+        CloseHandle(handles[i]);
+#else
+        pthread_join(handles[i], NULL);
+#endif
+    }
+}
+
+/**
+ *  @brief  Number of logical cores available to the process, used when the user asks for `threads=0`.
+ */
+static sz_size_t hardware_concurrency(void) {
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (sz_size_t)info.dwNumberOfProcessors;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (sz_size_t)cores : 1;
+#endif
+}
+
+/**
+ *  @brief  Parses the `threads` argument of the parallel algorithms, where zero means all available cores.
+ *  @return 1 on success, 0 with a Python exception set otherwise.
+ */
+static sz_bool_t parse_threads_count(PyObject *threads_obj, sz_size_t *threads) {
+    Py_ssize_t signed_threads = PyLong_AsSsize_t(threads_obj);
+    if (signed_threads < 0) {
+        if (!PyErr_Occurred()) PyErr_SetString(PyExc_ValueError, "The threads count can't be negative");
+        return 0;
+    }
+    *threads = signed_threads ? (sz_size_t)signed_threads : hardware_concurrency();
+    return 1;
+}
+
 void reverse_offsets(sz_sorted_idx_t *array, size_t length) {
     size_t i, j;
     // Swap array[i] and array[j]
@@ -339,6 +502,223 @@ sz_bool_t prepare_strings_for_extension(Strs *strs, size_t new_parents, size_t n
 
 #pragma endregion
 
+#pragma region External Sort
+
+/**
+ *  @brief  State of an external sort, shared by `File.external_sort` and `Strs.external_sort`, mirroring the
+ *          `sz::external_sort` C++ function. Collects the records of the current run, sorts them with `sz_sort`
+ *          once they reach ::run_bytes, and writes them into a temporary tape next to the output.
+ *          The tapes are later memory-mapped with sequential read-ahead and merged with `sz_merge_runs`.
+ */
+typedef struct {
+    char const *output_path;
+    char *run_path;
+    size_t runs_count;
+    size_t run_bytes;
+    sz_string_view_t *records;
+    sz_sorted_idx_t *order;
+    size_t records_count;
+    size_t records_capacity;
+    size_t records_bytes;
+} external_sort_t;
+
+typedef struct {
+    FILE *file;
+    char separator;
+    int written;
+} external_sort_output_t;
+
+static void external_sort_run_path(external_sort_t *state, size_t run) {
+    sprintf(state->run_path, "%s.%zu.run", state->output_path, run);
+}
+
+static sz_bool_t external_sort_init(external_sort_t *state, char const *output_path, size_t run_bytes) {
+    memset(state, 0, sizeof(*state));
+    state->output_path = output_path;
+    state->run_bytes = run_bytes;
+    state->run_path = (char *)malloc(strlen(output_path) + 32);
+    if (!state->run_path) return PyErr_NoMemory(), 0;
+    return 1;
+}
+
+/**
+ *  @brief  Removes the temporary runs and releases the buffers, even if the sort failed.
+ */
+static void external_sort_free(external_sort_t *state) {
+    for (size_t run = 0; run != state->runs_count; ++run) external_sort_run_path(state, run), remove(state->run_path);
+    free(state->run_path);
+    free(state->records);
+    free(state->order);
+}
+
+/**
+ *  @brief  Sorts the records of the current run, and writes them into a tape with 32-bit offsets,
+ *          unless the records are longer than 4 GB in total.
+ */
+static sz_bool_t external_sort_flush(external_sort_t *state) {
+    size_t const count = state->records_count;
+    if (!count) return 1;
+    sz_sequence_t sequence;
+    memset(&sequence, 0, sizeof(sequence));
+    sequence.order = state->order;
+    sequence.count = count;
+    sequence.handle = state->records;
+    sequence.get_start = parts_get_start;
+    sequence.get_length = parts_get_length;
+    for (sz_sorted_idx_t i = 0; i != count; ++i) sequence.order[i] = i;
+    sz_sort(&sequence);
+
+    external_sort_run_path(state, state->runs_count);
+    FILE *file = fopen(state->run_path, "wb");
+    if (!file) return PyErr_SetFromErrnoWithFilename(PyExc_OSError, state->run_path), 0;
+    state->runs_count++;
+    setvbuf(file, NULL, _IOFBF, 1 << 20);
+    size_t const offset_bytes = state->records_bytes > 0xFFFFFFFFull ? 8 : 4;
+    char header[SZ_TAPE_HEADER_SIZE];
+    sz_tape_header(count, offset_bytes, header);
+    int written = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+    // Export the `count + 1` offsets in batches, to avoid a temporary array as large as the run.
+    sz_u32_t offsets_u32[256];
+    sz_u64_t offsets_u64[256];
+    sz_u64_t offset = 0;
+    for (size_t first = 0; written && first <= count; first += 256) {
+        size_t const batch = sz_min_of_two(256, count + 1 - first);
+        for (size_t i = 0; i != batch; ++i) {
+            offsets_u32[i] = (sz_u32_t)offset, offsets_u64[i] = offset;
+            if (first + i != count) offset += state->records[state->order[first + i]].length;
+        }
+        written = offset_bytes == 4 ? fwrite(offsets_u32, 4, batch, file) == batch
+                                    : fwrite(offsets_u64, 8, batch, file) == batch;
+    }
+    for (size_t i = 0; written && i != count; ++i) {
+        sz_string_view_t record = state->records[state->order[i]];
+        written = fwrite(record.start, 1, record.length, file) == record.length;
+    }
+    if (fclose(file) != 0 || !written) return PyErr_SetFromErrnoWithFilename(PyExc_OSError, state->run_path), 0;
+
+    state->records_count = 0;
+    state->records_bytes = 0;
+    return 1;
+}
+
+/**
+ *  @brief  Appends a record to the current run, flushing the run once it reaches the ::run_bytes.
+ */
+static sz_bool_t external_sort_push(external_sort_t *state, sz_cptr_t start, sz_size_t length) {
+    if (state->records_count == state->records_capacity) {
+        size_t const capacity = state->records_capacity ? state->records_capacity * 2 : 1024;
+        sz_string_view_t *records = (sz_string_view_t *)realloc(state->records, capacity * sizeof(sz_string_view_t));
+        if (!records) return PyErr_NoMemory(), 0;
+        state->records = records;
+        sz_sorted_idx_t *order = (sz_sorted_idx_t *)realloc(state->order, capacity * sizeof(sz_sorted_idx_t));
+        if (!order) return PyErr_NoMemory(), 0;
+        state->order = order;
+        state->records_capacity = capacity;
+    }
+    state->records[state->records_count].start = start;
+    state->records[state->records_count].length = length;
+    state->records_count++;
+    state->records_bytes += length + 1;
+    return state->records_bytes < state->run_bytes ? 1 : external_sort_flush(state);
+}
+
+static void external_sort_write(sz_cptr_t start, sz_size_t length, sz_size_t run, void *handle) {
+    external_sort_output_t *output = (external_sort_output_t *)handle;
+    sz_unused(run);
+    output->written = output->written && fwrite(start, 1, length, output->file) == length &&
+                      fputc(output->separator, output->file) != EOF;
+}
+
+/**
+ *  @brief  Flushes the last run, maps all of the runs, and merges them into the output,
+ *          following every record with the @p separator.
+ */
+static sz_bool_t external_sort_merge(external_sort_t *state, char separator) {
+    if (!external_sort_flush(state)) return 0;
+    size_t const runs_count = state->runs_count;
+    PyObject **files = (PyObject **)calloc(runs_count + 1, sizeof(PyObject *));
+    sz_tape_t *tapes = (sz_tape_t *)malloc((runs_count + 1) * sizeof(sz_tape_t));
+    sz_sequence_t *sequences = (sz_sequence_t *)malloc((runs_count + 1) * sizeof(sz_sequence_t));
+    PyObject *hints = Py_BuildValue("{s:O}", "sequential", Py_True);
+    sz_bool_t success = files && tapes && sequences && hints;
+    if (!success && !PyErr_Occurred()) PyErr_NoMemory();
+
+    for (size_t run = 0; success && run != runs_count; ++run) {
+        external_sort_run_path(state, run);
+        PyObject *file_args = Py_BuildValue("(s)", state->run_path);
+        files[run] = file_args ? PyObject_Call((PyObject *)&FileType, file_args, hints) : NULL;
+        Py_XDECREF(file_args);
+        if (!files[run]) {
+            success = 0;
+            break;
+        }
+        File *file = (File *)files[run];
+        sz_size_t offset_bytes;
+        if (!sz_tape_parse(file->start, file->length, tapes + run, &offset_bytes)) {
+            PyErr_SetString(PyExc_RuntimeError, "The temporary run was corrupted!");
+            success = 0;
+            break;
+        }
+        if (offset_bytes == 4) sz_sequence_from_u32tape(tapes + run, NULL, sequences + run);
+        else { sz_sequence_from_u64tape(tapes + run, NULL, sequences + run); }
+    }
+
+    if (success) {
+        external_sort_output_t output = {fopen(state->output_path, "wb"), separator, 1};
+        if (!output.file) {
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, state->output_path);
+            success = 0;
+        }
+        else {
+            setvbuf(output.file, NULL, _IOFBF, 1 << 20);
+            if (!sz_merge_runs(sequences, runs_count, external_sort_write, &output, NULL)) {
+                PyErr_NoMemory();
+                success = 0;
+            }
+            if ((fclose(output.file) != 0 || !output.written) && success) {
+                PyErr_SetFromErrnoWithFilename(PyExc_OSError, state->output_path);
+                success = 0;
+            }
+        }
+    }
+
+    // The runs must be unmapped, before they can be removed.
+    if (files)
+        for (size_t run = 0; run != runs_count; ++run) Py_XDECREF(files[run]);
+    Py_XDECREF(hints);
+    free(files);
+    free(tapes);
+    free(sequences);
+    return success;
+}
+
+/**
+ *  @brief  Parses the arguments shared by `File.external_sort` and `Strs.external_sort`:
+ *          the output path, and the keyword-only `run_bytes` and `separator`.
+ */
+static sz_bool_t external_sort_parse_args(PyObject *args, PyObject *kwargs, char const **output_path,
+                                          size_t *run_bytes, char *separator) {
+    Py_ssize_t signed_run_bytes = 1 << 30;
+    int separator_code = '\n';
+    static char *names[] = {"path", "run_bytes", "separator", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|$nC", names, output_path, &signed_run_bytes, &separator_code))
+        return 0;
+    if (signed_run_bytes <= 0) {
+        PyErr_SetString(PyExc_ValueError, "The run_bytes must be positive");
+        return 0;
+    }
+    if (separator_code > 255) {
+        PyErr_SetString(PyExc_ValueError, "The separator must be a single-byte character");
+        return 0;
+    }
+    *run_bytes = (size_t)signed_run_bytes;
+    *separator = (char)separator_code;
+    return 1;
+}
+
+#pragma endregion
+
 #pragma region MemoryMappingFile
 
 static void File_dealloc(File *self) {
@@ -388,17 +768,41 @@ static PyObject *File_new(PyTypeObject *type, PyObject *positional_args, PyObjec
     return (PyObject *)self;
 }
 
+/**
+ *  @brief  Maps the file into memory, mirroring the `sz::mapped_file` C++ class, including the optional
+ *          keyword-only access-pattern hints: `sequential`, `random`, `huge_pages`, and `populate`.
+ *          Those reduce the page-fault overhead of cold scans, and are ignored where unsupported.
+ */
 static int File_init(File *self, PyObject *positional_args, PyObject *named_args) {
     const char *path;
-    if (!PyArg_ParseTuple(positional_args, "s", &path)) return -1;
+    int sequential = 0, random = 0, huge_pages = 0, populate = 0;
+    static char *names[] = {"path", "sequential", "random", "huge_pages", "populate", NULL};
+    if (!PyArg_ParseTupleAndKeywords(positional_args, named_args, "s|$pppp", names, &path, &sequential, &random,
+                                     &huge_pages, &populate))
+        return -1;
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
-    self->file_handle = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    DWORD file_flags = FILE_ATTRIBUTE_NORMAL;
+    if (sequential) file_flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    if (random) file_flags |= FILE_FLAG_RANDOM_ACCESS;
+    sz_unused(huge_pages); // Large pages are only supported for the pagefile-backed mappings.
+    self->file_handle = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, file_flags, 0);
     if (self->file_handle == INVALID_HANDLE_VALUE) {
+        self->file_handle = NULL;
         PyErr_SetString(PyExc_RuntimeError, "Couldn't map the file!");
         return -1;
     }
 
+    // Mapping empty files fails, but they are still valid inputs.
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(self->file_handle, &file_size)) {
+        CloseHandle(self->file_handle);
+        self->file_handle = NULL;
+        PyErr_SetString(PyExc_RuntimeError, "Can't retrieve file size!");
+        return -1;
+    }
+    if (file_size.QuadPart == 0) return 0;
+
     self->mapping_handle = CreateFileMapping(self->file_handle, 0, PAGE_READONLY, 0, 0, 0);
     if (self->mapping_handle == 0) {
         CloseHandle(self->file_handle);
@@ -417,18 +821,38 @@ static int File_init(File *self, PyObject *positional_args, PyObject *named_args
         return -1;
     }
     self->start = file;
-    self->length = GetFileSize(self->file_handle, 0);
+    self->length = (sz_size_t)file_size.QuadPart;
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602 // Windows 8 and newer
+    if (sequential || populate) {
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = file;
+        range.NumberOfBytes = self->length;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#endif
 #else
     struct stat sb;
     self->file_descriptor = open(path, O_RDONLY);
+    if (self->file_descriptor < 0) {
+        self->file_descriptor = 0;
+        PyErr_SetString(PyExc_RuntimeError, "Couldn't open the file!");
+        return -1;
+    }
     if (fstat(self->file_descriptor, &sb) != 0) {
         close(self->file_descriptor);
         self->file_descriptor = 0;
         PyErr_SetString(PyExc_RuntimeError, "Can't retrieve file size!");
         return -1;
     }
+
+    // Mapping empty files fails with `EINVAL`, but they are still valid inputs.
     size_t file_size = sb.st_size;
-    void *map = mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, self->file_descriptor, 0);
+    if (file_size == 0) return 0;
+    int map_flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+    if (populate) map_flags |= MAP_POPULATE;
+#endif
+    void *map = mmap(NULL, file_size, PROT_READ, map_flags, self->file_descriptor, 0);
     if (map == MAP_FAILED) {
         close(self->file_descriptor);
         self->file_descriptor = 0;
@@ -437,17 +861,60 @@ static int File_init(File *self, PyObject *positional_args, PyObject *named_args
     }
     self->start = map;
     self->length = file_size;
+
+    // The hints are advisory, so their failures are ignored.
+    if (sequential) madvise(map, file_size, MADV_SEQUENTIAL);
+    if (random) madvise(map, file_size, MADV_RANDOM);
+#if defined(MADV_HUGEPAGE)
+    if (huge_pages) madvise(map, file_size, MADV_HUGEPAGE);
+#else
+    sz_unused(huge_pages);
+#endif
+#if !defined(MAP_POPULATE)
+    if (populate) madvise(map, file_size, MADV_WILLNEED);
+#endif
 #endif
 
     return 0;
 }
 
+/**
+ *  @brief  Sorts the records of a file, that may be larger than RAM, into another file, splitting them by
+ *          the `separator` and appending it after every record in the output, including the last one.
+ *          Sorts runs of `run_bytes` in memory, and merges them from temporary files next to the output.
+ */
+static PyObject *File_external_sort(File *self, PyObject *args, PyObject *kwargs) {
+    char const *output_path;
+    size_t run_bytes;
+    char separator;
+    if (!external_sort_parse_args(args, kwargs, &output_path, &run_bytes, &separator)) return NULL;
+
+    external_sort_t state;
+    if (!external_sort_init(&state, output_path, run_bytes)) return NULL;
+    sz_cptr_t const text = self->start;
+    sz_size_t const length = self->length;
+    sz_bool_t success = 1;
+    for (sz_size_t offset = 0; success && offset != length;) {
+        sz_cptr_t found = sz_find_byte(text + offset, length - offset, &separator);
+        sz_size_t end = found ? (sz_size_t)(found - text) : length;
+        success = external_sort_push(&state, text + offset, end - offset);
+        offset = found ? end + 1 : length;
+    }
+    success = success && external_sort_merge(&state, separator);
+    external_sort_free(&state);
+    if (!success) return NULL;
+    Py_RETURN_NONE;
+}
+
 static PyMethodDef File_methods[] = { //
+    {"external_sort", File_external_sort, METH_VARARGS | METH_KEYWORDS,
+     "Sort the separator-delimited records of the file into another file, using temporary runs for large inputs."},
     {NULL, NULL, 0, NULL}};
 
 static PyTypeObject FileType = {
     PyObject_HEAD_INIT(NULL).tp_name = "stringzilla.File",
-    .tp_doc = "Memory mapped file class, that exposes the memory range for low-level access",
+    .tp_doc = "Memory mapped file class, that exposes the memory range for low-level access.\n\n"
+              "Accepts the `sequential`, `random`, `huge_pages`, and `populate` keyword-only access-pattern hints.",
     .tp_basicsize = sizeof(File),
     .tp_flags = Py_TPFLAGS_DEFAULT,
     .tp_methods = File_methods,
@@ -592,6 +1059,103 @@ static PyObject *Str_like_hash(PyObject *self, PyObject *args, PyObject *kwargs)
     return PyLong_FromSize_t((size_t)result);
 }
 
+static PyObject *Str_sketch(PyObject *self, PyObject *args, PyObject *kwargs) {
+    int is_member = self != NULL && PyObject_TypeCheck(self, &StrType);
+    Py_ssize_t nargs = PyTuple_Size(args);
+    if (nargs < !is_member || nargs > !is_member + 2) {
+        PyErr_SetString(PyExc_TypeError, "sketch() expects a string, the window lengths, and the permutations count");
+        return NULL;
+    }
+
+    PyObject *text_obj = is_member ? self : PyTuple_GET_ITEM(args, 0);
+    PyObject *windows_obj = nargs > !is_member ? PyTuple_GET_ITEM(args, !is_member) : NULL;
+    PyObject *permutations_obj = nargs > !is_member + 1 ? PyTuple_GET_ITEM(args, !is_member + 1) : NULL;
+
+    if (kwargs) {
+        PyObject *key, *value;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(kwargs, &pos, &key, &value)) {
+            if (PyUnicode_CompareWithASCIIString(key, "windows") == 0) { windows_obj = value; }
+            else if (PyUnicode_CompareWithASCIIString(key, "permutations") == 0) { permutations_obj = value; }
+            else if (PyErr_Format(PyExc_TypeError, "Got an unexpected keyword argument '%U'", key)) { return NULL; }
+        }
+    }
+
+    sz_string_view_t text;
+    if (!export_string_like(text_obj, &text.start, &text.length)) {
+        PyErr_SetString(PyExc_TypeError, "The text argument must be string-like");
+        return NULL;
+    }
+
+    // By default, a single window of 3-byte shingles is hashed with 64 permutations
+    Py_ssize_t permutations = 64;
+    if (permutations_obj && ((permutations = PyLong_AsSsize_t(permutations_obj)) < 0 || PyErr_Occurred())) {
+        if (!PyErr_Occurred()) PyErr_SetString(PyExc_ValueError, "permutations must be a non-negative integer");
+        return NULL;
+    }
+
+    sz_size_t default_window_length = 3;
+    sz_size_t *window_lengths = &default_window_length;
+    Py_ssize_t windows_count = 1;
+    if (windows_obj && windows_obj != Py_None) {
+        PyObject *windows_seq = PySequence_Fast(windows_obj, "windows must be a sequence of integers");
+        if (!windows_seq) return NULL;
+        windows_count = PySequence_Fast_GET_SIZE(windows_seq);
+        window_lengths = (sz_size_t *)malloc((windows_count + 1) * sizeof(sz_size_t));
+        if (!window_lengths) {
+            Py_DECREF(windows_seq);
+            return PyErr_NoMemory();
+        }
+        for (Py_ssize_t i = 0; i != windows_count; ++i) {
+            Py_ssize_t window_length = PyLong_AsSsize_t(PySequence_Fast_GET_ITEM(windows_seq, i));
+            if (window_length <= 0) {
+                if (!PyErr_Occurred()) PyErr_SetString(PyExc_ValueError, "window lengths must be positive integers");
+                free(window_lengths);
+                Py_DECREF(windows_seq);
+                return NULL;
+            }
+            window_lengths[i] = (sz_size_t)window_length;
+        }
+        Py_DECREF(windows_seq);
+    }
+    int const owns_window_lengths = window_lengths != &default_window_length;
+
+    // One allocation for both the MinHash and the SimHash signatures
+    sz_u64_t *signatures = (sz_u64_t *)malloc((windows_count * (permutations + 1) + 1) * sizeof(sz_u64_t));
+    if (!signatures) {
+        if (owns_window_lengths) free(window_lengths);
+        return PyErr_NoMemory();
+    }
+    sz_u64_t *min_hashes = signatures, *sim_hashes = signatures + windows_count * permutations;
+    sz_hashes_sketch(text.start, text.length, window_lengths, (sz_size_t)windows_count, (sz_size_t)permutations,
+                     min_hashes, sim_hashes);
+    if (owns_window_lengths) free(window_lengths);
+
+    // Export as a tuple of per-window MinHash tuples and a tuple of per-window SimHash values
+    PyObject *min_hashes_tuple = PyTuple_New(windows_count);
+    PyObject *sim_hashes_tuple = PyTuple_New(windows_count);
+    int failed = !min_hashes_tuple || !sim_hashes_tuple;
+    for (Py_ssize_t i = 0; i != windows_count && !failed; ++i) {
+        PyObject *window_tuple = PyTuple_New(permutations);
+        PyObject *sim_hash = PyLong_FromUnsignedLongLong(sim_hashes[i]);
+        if (window_tuple) PyTuple_SET_ITEM(min_hashes_tuple, i, window_tuple);
+        if (sim_hash) PyTuple_SET_ITEM(sim_hashes_tuple, i, sim_hash);
+        failed = !window_tuple || !sim_hash;
+        for (Py_ssize_t j = 0; j != permutations && !failed; ++j) {
+            PyObject *min_hash = PyLong_FromUnsignedLongLong(min_hashes[i * permutations + j]);
+            if (min_hash) PyTuple_SET_ITEM(window_tuple, j, min_hash);
+            failed = !min_hash;
+        }
+    }
+    free(signatures);
+    if (failed) {
+        Py_XDECREF(min_hashes_tuple);
+        Py_XDECREF(sim_hashes_tuple);
+        return NULL;
+    }
+    return Py_BuildValue("(NN)", min_hashes_tuple, sim_hashes_tuple);
+}
+
 static Py_ssize_t Str_len(Str *self) { return self->length; }
 
 static PyObject *Str_getitem(Str *self, Py_ssize_t i) {
@@ -748,6 +1312,7 @@ static PyObject *Strs_subscript(Strs *self, PyObject *key) {
     to->count = stop - start;                                                                                 \
     to->separator_length = from->separator_length;                                                            \
     to->parent = from->parent;                                                                                \
+    Py_INCREF(to->parent);                                                                                    \
     size_t first_length;                                                                                      \
     str_at_offset_consecutive_##type(self, start, count, &to->parent, &to->start, &first_length);             \
     index_t first_offset = to->start - from->start;                                                           \
@@ -756,8 +1321,7 @@ static PyObject *Strs_subscript(Strs *self, PyObject *key) {
         Py_XDECREF(self_slice);                                                                               \
         return NULL;                                                                                          \
     }                                                                                                         \
-    for (size_t i = 0; i != to->count; ++i) to->end_offsets[i] = from->end_offsets[i + start] - first_offset; \
-    Py_INCREF(to->parent);
+    for (size_t i = 0; i != to->count; ++i) to->end_offsets[i] = from->end_offsets[i + start] - first_offset;
         case STRS_CONSECUTIVE_32: {
             typedef uint32_t index_32bit_t;
             consecutive_logic(32bit);
@@ -774,6 +1338,7 @@ static PyObject *Strs_subscript(Strs *self, PyObject *key) {
             struct reordered_slices_t *to = &self_slice->data.reordered;
             to->count = stop - start;
             to->parent = from->parent;
+            Py_INCREF(to->parent);
 
             to->parts = malloc(sizeof(sz_string_view_t) * to->count);
             if (to->parts == NULL && PyErr_NoMemory()) {
@@ -781,7 +1346,6 @@ static PyObject *Strs_subscript(Strs *self, PyObject *key) {
                 return NULL;
             }
             memcpy(to->parts, from->parts + start, sizeof(sz_string_view_t) * to->count);
-            Py_INCREF(to->parent);
             break;
         }
         default:
@@ -957,107 +1521,219 @@ static PyObject *Str_rindex(PyObject *self, PyObject *args, PyObject *kwargs) {
     return PyLong_FromSsize_t(signed_offset);
 }
 
-static PyObject *_Str_partition_implementation(PyObject *self, PyObject *args, PyObject *kwargs, sz_find_t finder) {
-    Py_ssize_t separator_index;
-    sz_string_view_t text;
-    sz_string_view_t separator;
-    PyObject *result_tuple;
-
-    // Use _Str_find_implementation_ to get the index of the separator
-    if (!_Str_find_implementation_(self, args, kwargs, finder, &separator_index, &text, &separator)) return NULL;
-
-    // If separator is not found, return a tuple (self, "", "")
-    if (separator_index == -1) {
-        PyObject *empty_str1 = Str_new(&StrType, Py_None, Py_None);
-        PyObject *empty_str2 = Str_new(&StrType, Py_None, Py_None);
-
-        result_tuple = PyTuple_New(3);
-        Py_INCREF(self);
-        PyTuple_SET_ITEM(result_tuple, 0, self);
-        PyTuple_SET_ITEM(result_tuple, 1, empty_str1);
-        PyTuple_SET_ITEM(result_tuple, 2, empty_str2);
-        return result_tuple;
-    }
-
-    // Create the three parts manually
-    Str *before = Str_new(&StrType, NULL, NULL);
-    Str *middle = Str_new(&StrType, NULL, NULL);
-    Str *after = Str_new(&StrType, NULL, NULL);
-
-    before->parent = self, before->start = text.start, before->length = separator_index;
-    middle->parent = self, middle->start = text.start + separator_index, middle->length = separator.length;
-    after->parent = self, after->start = text.start + separator_index + separator.length,
-    after->length = text.length - separator_index - separator.length;
-
-    // All parts reference the same parent
-    Py_INCREF(self);
-    Py_INCREF(self);
-    Py_INCREF(self);
-
-    // Build the result tuple
-    result_tuple = PyTuple_New(3);
-    PyTuple_SET_ITEM(result_tuple, 0, before);
-    PyTuple_SET_ITEM(result_tuple, 1, middle);
-    PyTuple_SET_ITEM(result_tuple, 2, after);
-
-    return result_tuple;
-}
-
-static PyObject *Str_partition(PyObject *self, PyObject *args, PyObject *kwargs) {
-    return _Str_partition_implementation(self, args, kwargs, &sz_find);
-}
-
-static PyObject *Str_rpartition(PyObject *self, PyObject *args, PyObject *kwargs) {
-    return _Str_partition_implementation(self, args, kwargs, &sz_rfind);
-}
-
-static PyObject *Str_count(PyObject *self, PyObject *args, PyObject *kwargs) {
+/**
+ *  @brief  Finds the first occurrence of any needle from a sequence, compiling a multi-pattern matcher per call.
+ *  @return Tuple of the offset and the index of the matched needle, or `(-1, -1)` if none were found.
+ */
+static PyObject *Str_find_any(PyObject *self, PyObject *args, PyObject *kwargs) {
     int is_member = self != NULL && PyObject_TypeCheck(self, &StrType);
     Py_ssize_t nargs = PyTuple_Size(args);
-    if (nargs < !is_member + 1 || nargs > !is_member + 4) {
-        PyErr_Format(PyExc_TypeError, "Invalid number of arguments");
+    if (nargs < !is_member + 1 || nargs > !is_member + 3) {
+        PyErr_SetString(PyExc_TypeError, "Invalid number of arguments");
         return NULL;
     }
 
     PyObject *haystack_obj = is_member ? self : PyTuple_GET_ITEM(args, 0);
-    PyObject *needle_obj = PyTuple_GET_ITEM(args, !is_member + 0);
+    PyObject *needles_obj = PyTuple_GET_ITEM(args, !is_member + 0);
     PyObject *start_obj = nargs > !is_member + 1 ? PyTuple_GET_ITEM(args, !is_member + 1) : NULL;
     PyObject *end_obj = nargs > !is_member + 2 ? PyTuple_GET_ITEM(args, !is_member + 2) : NULL;
-    PyObject *allowoverlap_obj = nargs > !is_member + 3 ? PyTuple_GET_ITEM(args, !is_member + 3) : NULL;
 
     if (kwargs) {
         Py_ssize_t pos = 0;
         PyObject *key, *value;
-        while (PyDict_Next(kwargs, &pos, &key, &value))
+        while (PyDict_Next(kwargs, &pos, &key, &value)) {
             if (PyUnicode_CompareWithASCIIString(key, "start") == 0) { start_obj = value; }
             else if (PyUnicode_CompareWithASCIIString(key, "end") == 0) { end_obj = value; }
-            else if (PyUnicode_CompareWithASCIIString(key, "allowoverlap") == 0) { allowoverlap_obj = value; }
-            else if (PyErr_Format(PyExc_TypeError, "Got an unexpected keyword argument '%U'", key))
+            else {
+                PyErr_Format(PyExc_TypeError, "Got an unexpected keyword argument '%U'", key);
                 return NULL;
+            }
+        }
     }
 
     sz_string_view_t haystack;
-    sz_string_view_t needle;
+    if (!export_string_like(haystack_obj, &haystack.start, &haystack.length)) {
+        PyErr_SetString(PyExc_TypeError, "Haystack must be string-like");
+        return NULL;
+    }
+
     Py_ssize_t start = start_obj ? PyLong_AsSsize_t(start_obj) : 0;
     Py_ssize_t end = end_obj ? PyLong_AsSsize_t(end_obj) : PY_SSIZE_T_MAX;
-    int allowoverlap = allowoverlap_obj ? PyObject_IsTrue(allowoverlap_obj) : 0;
+    if ((start == -1 || end == -1) && PyErr_Occurred()) {
+        PyErr_SetString(PyExc_TypeError, "The start and end arguments must be integers");
+        return NULL;
+    }
+
+    // The sequence keeps the needles alive, until we are done with the search
+    PyObject *needles_sequence = PySequence_Fast(needles_obj, "Needles must be a sequence of string-like objects");
+    if (!needles_sequence) return NULL;
+    Py_ssize_t needles_count = PySequence_Fast_GET_SIZE(needles_sequence);
+    PyObject **needles_items = PySequence_Fast_ITEMS(needles_sequence);
+    sz_string_view_t *needles = (sz_string_view_t *)malloc(sizeof(sz_string_view_t) * (needles_count + 1));
+    if (!needles) {
+        Py_DECREF(needles_sequence);
+        return PyErr_NoMemory();
+    }
+    for (Py_ssize_t i = 0; i != needles_count; ++i) {
+        if (!export_string_like(needles_items[i], &needles[i].start, &needles[i].length)) {
+            free(needles);
+            Py_DECREF(needles_sequence);
+            PyErr_SetString(PyExc_TypeError, "Needles must be string-like");
+            return NULL;
+        }
+    }
+
+    sz_multi_pattern_t pattern;
+    sz_bool_t compiled = sz_multi_pattern_init(&pattern, needles, (sz_size_t)needles_count, NULL);
+    free(needles);
+    if (!compiled) {
+        Py_DECREF(needles_sequence);
+        return PyErr_NoMemory();
+    }
+
+    size_t normalized_offset, normalized_length;
+    sz_ssize_clamp_interval(haystack.length, start, end, &normalized_offset, &normalized_length);
+    haystack.start += normalized_offset;
+    haystack.length = normalized_length;
+
+    sz_size_t needle_id = 0;
+    sz_cptr_t match = sz_find_any(&pattern, haystack.start, haystack.length, &needle_id);
+    sz_multi_pattern_free(&pattern, NULL);
+    Py_DECREF(needles_sequence);
+
+    if (match == NULL) return Py_BuildValue("(nn)", (Py_ssize_t)-1, (Py_ssize_t)-1);
+    return Py_BuildValue("(nn)", (Py_ssize_t)(match - haystack.start + normalized_offset), (Py_ssize_t)needle_id);
+}
+
+static PyObject *Str_find_fuzzy(PyObject *self, PyObject *args, PyObject *kwargs) {
+    int is_member = self != NULL && PyObject_TypeCheck(self, &StrType);
+    Py_ssize_t nargs = PyTuple_Size(args);
+    if (nargs < !is_member + 1 || nargs > !is_member + 4) {
+        PyErr_SetString(PyExc_TypeError, "Invalid number of arguments");
+        return NULL;
+    }
+
+    PyObject *haystack_obj = is_member ? self : PyTuple_GET_ITEM(args, 0);
+    PyObject *needle_obj = PyTuple_GET_ITEM(args, !is_member + 0);
+    PyObject *max_edits_obj = nargs > !is_member + 1 ? PyTuple_GET_ITEM(args, !is_member + 1) : NULL;
+    PyObject *start_obj = nargs > !is_member + 2 ? PyTuple_GET_ITEM(args, !is_member + 2) : NULL;
+    PyObject *end_obj = nargs > !is_member + 3 ? PyTuple_GET_ITEM(args, !is_member + 3) : NULL;
+
+    if (kwargs) {
+        Py_ssize_t pos = 0;
+        PyObject *key, *value;
+        while (PyDict_Next(kwargs, &pos, &key, &value)) {
+            if (PyUnicode_CompareWithASCIIString(key, "max_edits") == 0) { max_edits_obj = value; }
+            else if (PyUnicode_CompareWithASCIIString(key, "start") == 0) { start_obj = value; }
+            else if (PyUnicode_CompareWithASCIIString(key, "end") == 0) { end_obj = value; }
+            else {
+                PyErr_Format(PyExc_TypeError, "Got an unexpected keyword argument '%U'", key);
+                return NULL;
+            }
+        }
+    }
 
+    sz_string_view_t haystack, needle;
     if (!export_string_like(haystack_obj, &haystack.start, &haystack.length) ||
-        !export_string_like(needle_obj, &needle.start, &needle.length))
-        return PyErr_Format(PyExc_TypeError, "Haystack and needle must be string-like"), NULL;
+        !export_string_like(needle_obj, &needle.start, &needle.length)) {
+        PyErr_SetString(PyExc_TypeError, "Haystack and needle must be string-like");
+        return NULL;
+    }
 
-    if ((start == -1 || end == -1 || allowoverlap == -1) && PyErr_Occurred()) return NULL;
+    Py_ssize_t max_edits = 1; // Default value for the number of edits
+    if (max_edits_obj && ((max_edits = PyLong_AsSsize_t(max_edits_obj)) < 0)) {
+        PyErr_SetString(PyExc_ValueError, "The number of edits must be a non-negative integer");
+        return NULL;
+    }
+
+    Py_ssize_t start = start_obj ? PyLong_AsSsize_t(start_obj) : 0;
+    Py_ssize_t end = end_obj ? PyLong_AsSsize_t(end_obj) : PY_SSIZE_T_MAX;
+    if ((start == -1 || end == -1) && PyErr_Occurred()) {
+        PyErr_SetString(PyExc_TypeError, "The start and end arguments must be integers");
+        return NULL;
+    }
 
     size_t normalized_offset, normalized_length;
     sz_ssize_clamp_interval(haystack.length, start, end, &normalized_offset, &normalized_length);
     haystack.start += normalized_offset;
     haystack.length = normalized_length;
 
-    size_t count = 0;
-    if (needle.length == 0 || haystack.length == 0 || haystack.length < needle.length) { count = 0; }
-    else if (allowoverlap) {
+    // Reuse the temporary buffer for the Bitap masks and states
+    sz_memory_allocator_t reusing_allocator;
+    reusing_allocator.allocate = &temporary_memory_allocate;
+    reusing_allocator.free = &temporary_memory_free;
+    reusing_allocator.handle = &temporary_memory;
+
+    sz_size_t match_length;
+    sz_cptr_t match = sz_find_fuzzy(haystack.start, haystack.length, needle.start, needle.length,
+                                    (sz_size_t)max_edits, &reusing_allocator, &match_length);
+    if (match_length == SZ_SIZE_MAX) return PyErr_NoMemory();
+    if (match == NULL) return Py_BuildValue("(nn)", (Py_ssize_t)-1, (Py_ssize_t)0);
+    return Py_BuildValue("(nn)", (Py_ssize_t)(match - haystack.start + normalized_offset), (Py_ssize_t)match_length);
+}
+
+static PyObject *_Str_partition_implementation(PyObject *self, PyObject *args, PyObject *kwargs, sz_find_t finder) {
+    Py_ssize_t separator_index;
+    sz_string_view_t text;
+    sz_string_view_t separator;
+    PyObject *result_tuple;
+
+    // Use _Str_find_implementation_ to get the index of the separator
+    if (!_Str_find_implementation_(self, args, kwargs, finder, &separator_index, &text, &separator)) return NULL;
+
+    // If separator is not found, return a tuple (self, "", "")
+    if (separator_index == -1) {
+        PyObject *empty_str1 = Str_new(&StrType, Py_None, Py_None);
+        PyObject *empty_str2 = Str_new(&StrType, Py_None, Py_None);
+
+        result_tuple = PyTuple_New(3);
+        Py_INCREF(self);
+        PyTuple_SET_ITEM(result_tuple, 0, self);
+        PyTuple_SET_ITEM(result_tuple, 1, empty_str1);
+        PyTuple_SET_ITEM(result_tuple, 2, empty_str2);
+        return result_tuple;
+    }
+
+    // Create the three parts manually
+    Str *before = Str_new(&StrType, NULL, NULL);
+    Str *middle = Str_new(&StrType, NULL, NULL);
+    Str *after = Str_new(&StrType, NULL, NULL);
+
+    before->parent = self, before->start = text.start, before->length = separator_index;
+    middle->parent = self, middle->start = text.start + separator_index, middle->length = separator.length;
+    after->parent = self, after->start = text.start + separator_index + separator.length,
+    after->length = text.length - separator_index - separator.length;
+
+    // All parts reference the same parent
+    Py_INCREF(self);
+    Py_INCREF(self);
+    Py_INCREF(self);
+
+    // Build the result tuple
+    result_tuple = PyTuple_New(3);
+    PyTuple_SET_ITEM(result_tuple, 0, before);
+    PyTuple_SET_ITEM(result_tuple, 1, middle);
+    PyTuple_SET_ITEM(result_tuple, 2, after);
+
+    return result_tuple;
+}
+
+static PyObject *Str_partition(PyObject *self, PyObject *args, PyObject *kwargs) {
+    return _Str_partition_implementation(self, args, kwargs, &sz_find);
+}
+
+static PyObject *Str_rpartition(PyObject *self, PyObject *args, PyObject *kwargs) {
+    return _Str_partition_implementation(self, args, kwargs, &sz_rfind);
+}
+
+/**
+ *  @brief  Counts the occurrences of a @p prepared needle in the @p haystack, shared by `Str.count` and `Strs.count`.
+ */
+static sz_size_t Str_count_prepared_(sz_needle_t const *prepared, sz_string_view_t haystack, int allowoverlap) {
+    sz_size_t count = 0;
+    if (allowoverlap) {
         while (haystack.length) {
-            sz_cptr_t ptr = sz_find(haystack.start, haystack.length, needle.start, needle.length);
+            sz_cptr_t ptr = sz_find_prepared(prepared, haystack.start, haystack.length);
             sz_bool_t found = ptr != NULL;
             sz_size_t offset = found ? ptr - haystack.start : haystack.length;
             count += found;
@@ -1067,14 +1743,79 @@ static PyObject *Str_count(PyObject *self, PyObject *args, PyObject *kwargs) {
     }
     else {
         while (haystack.length) {
-            sz_cptr_t ptr = sz_find(haystack.start, haystack.length, needle.start, needle.length);
+            sz_cptr_t ptr = sz_find_prepared(prepared, haystack.start, haystack.length);
             sz_bool_t found = ptr != NULL;
             sz_size_t offset = found ? ptr - haystack.start : haystack.length;
             count += found;
-            haystack.start += offset + needle.length;
-            haystack.length -= offset + needle.length * found;
+            haystack.start += offset + prepared->length;
+            haystack.length -= offset + prepared->length * found;
         }
     }
+    return count;
+}
+
+static PyObject *Str_count(PyObject *self, PyObject *args, PyObject *kwargs) {
+    int is_member = self != NULL && PyObject_TypeCheck(self, &StrType);
+    Py_ssize_t nargs = PyTuple_Size(args);
+    if (nargs < !is_member + 1 || nargs > !is_member + 4) {
+        PyErr_Format(PyExc_TypeError, "Invalid number of arguments");
+        return NULL;
+    }
+
+    PyObject *haystack_obj = is_member ? self : PyTuple_GET_ITEM(args, 0);
+    PyObject *needle_obj = PyTuple_GET_ITEM(args, !is_member + 0);
+    PyObject *start_obj = nargs > !is_member + 1 ? PyTuple_GET_ITEM(args, !is_member + 1) : NULL;
+    PyObject *end_obj = nargs > !is_member + 2 ? PyTuple_GET_ITEM(args, !is_member + 2) : NULL;
+    PyObject *allowoverlap_obj = nargs > !is_member + 3 ? PyTuple_GET_ITEM(args, !is_member + 3) : NULL;
+    PyObject *threads_obj = NULL; // Default is single-threaded
+
+    if (kwargs) {
+        Py_ssize_t pos = 0;
+        PyObject *key, *value;
+        while (PyDict_Next(kwargs, &pos, &key, &value))
+            if (PyUnicode_CompareWithASCIIString(key, "start") == 0) { start_obj = value; }
+            else if (PyUnicode_CompareWithASCIIString(key, "end") == 0) { end_obj = value; }
+            else if (PyUnicode_CompareWithASCIIString(key, "allowoverlap") == 0) { allowoverlap_obj = value; }
+            else if (PyUnicode_CompareWithASCIIString(key, "threads") == 0) { threads_obj = value; }
+            else if (PyErr_Format(PyExc_TypeError, "Got an unexpected keyword argument '%U'", key))
+                return NULL;
+    }
+
+    sz_string_view_t haystack;
+    sz_string_view_t needle;
+    Py_ssize_t start = start_obj ? PyLong_AsSsize_t(start_obj) : 0;
+    Py_ssize_t end = end_obj ? PyLong_AsSsize_t(end_obj) : PY_SSIZE_T_MAX;
+    int allowoverlap = allowoverlap_obj ? PyObject_IsTrue(allowoverlap_obj) : 0;
+
+    if (!export_string_like(haystack_obj, &haystack.start, &haystack.length) ||
+        !export_string_like(needle_obj, &needle.start, &needle.length))
+        return PyErr_Format(PyExc_TypeError, "Haystack and needle must be string-like"), NULL;
+
+    if ((start == -1 || end == -1 || allowoverlap == -1) && PyErr_Occurred()) return NULL;
+
+    sz_size_t threads = 1;
+    if (threads_obj && !parse_threads_count(threads_obj, &threads)) return NULL;
+
+    size_t normalized_offset, normalized_length;
+    sz_ssize_clamp_interval(haystack.length, start, end, &normalized_offset, &normalized_length);
+    haystack.start += normalized_offset;
+    haystack.length = normalized_length;
+
+    size_t count = 0;
+    if (needle.length == 0 || haystack.length == 0 || haystack.length < needle.length) { count = 0; }
+    else if (threads > 1) {
+        sz_executor_t executor;
+        executor.parallel_for = parallel_for_threads;
+        executor.threads_count = threads;
+        executor.handle = &threads;
+        count = sz_find_count_parallel(haystack.start, haystack.length, needle.start, needle.length,
+                                       allowoverlap ? sz_false_k : sz_true_k, &executor);
+    }
+    else {
+        sz_needle_t prepared;
+        sz_needle_prepare(needle.start, needle.length, &prepared);
+        count = Str_count_prepared_(&prepared, haystack, allowoverlap);
+    }
 
     return PyLong_FromSize_t(count);
 }
@@ -1143,6 +1884,119 @@ static PyObject *Str_edit_distance_unicode(PyObject *self, PyObject *args, PyObj
     return _Str_edit_distance(self, args, kwargs, &sz_edit_distance_utf8);
 }
 
+/**
+ *  @brief  Computes the edit distances between one query and every entry of a `Strs` or any other sequence
+ *          of string-like objects, reusing the same scratch memory and evaluating short candidates in parallel.
+ *  @return List of integer distances, one per candidate.
+ */
+static PyObject *Str_edit_distances(PyObject *self, PyObject *args, PyObject *kwargs) {
+    int is_member = self != NULL && PyObject_TypeCheck(self, &StrType);
+    Py_ssize_t nargs = PyTuple_Size(args);
+    if (nargs < !is_member + 1 || nargs > !is_member + 2) {
+        PyErr_SetString(PyExc_TypeError, "Invalid number of arguments");
+        return NULL;
+    }
+
+    PyObject *query_obj = is_member ? self : PyTuple_GET_ITEM(args, 0);
+    PyObject *candidates_obj = PyTuple_GET_ITEM(args, !is_member + 0);
+    PyObject *bound_obj = nargs > !is_member + 1 ? PyTuple_GET_ITEM(args, !is_member + 1) : NULL;
+
+    if (kwargs) {
+        Py_ssize_t pos = 0;
+        PyObject *key, *value;
+        while (PyDict_Next(kwargs, &pos, &key, &value)) {
+            if (PyUnicode_CompareWithASCIIString(key, "bound") == 0) {
+                if (bound_obj) {
+                    PyErr_SetString(PyExc_TypeError, "Received bound both as positional and keyword argument");
+                    return NULL;
+                }
+                bound_obj = value;
+            }
+            else {
+                PyErr_Format(PyExc_TypeError, "Got an unexpected keyword argument '%U'", key);
+                return NULL;
+            }
+        }
+    }
+
+    Py_ssize_t bound = 0; // Default value for bound
+    if (bound_obj && ((bound = PyLong_AsSsize_t(bound_obj)) < 0)) {
+        PyErr_SetString(PyExc_ValueError, "Bound must be a non-negative integer");
+        return NULL;
+    }
+
+    sz_string_view_t query;
+    if (!export_string_like(query_obj, &query.start, &query.length)) {
+        PyErr_SetString(PyExc_TypeError, "The query must be string-like");
+        return NULL;
+    }
+
+    // Collect the views of all candidates, keeping the generic sequences alive until we are done
+    PyObject *candidates_sequence = NULL;
+    Py_ssize_t count;
+    sz_string_view_t *candidates;
+    if (PyObject_TypeCheck(candidates_obj, &StrsType)) {
+        Strs *strs = (Strs *)candidates_obj;
+        get_string_at_offset_t getter = str_at_offset_getter(strs);
+        if (!getter) return NULL;
+        count = Strs_len(strs);
+        candidates = (sz_string_view_t *)malloc(sizeof(sz_string_view_t) * (count + 1));
+        if (!candidates) return PyErr_NoMemory();
+        for (Py_ssize_t i = 0; i != count; ++i) {
+            PyObject *parent;
+            getter(strs, i, count, &parent, &candidates[i].start, &candidates[i].length);
+        }
+    }
+    else {
+        candidates_sequence = PySequence_Fast(candidates_obj, "Candidates must be a sequence of string-like objects");
+        if (!candidates_sequence) return NULL;
+        count = PySequence_Fast_GET_SIZE(candidates_sequence);
+        PyObject **candidates_items = PySequence_Fast_ITEMS(candidates_sequence);
+        candidates = (sz_string_view_t *)malloc(sizeof(sz_string_view_t) * (count + 1));
+        if (!candidates) {
+            Py_DECREF(candidates_sequence);
+            return PyErr_NoMemory();
+        }
+        for (Py_ssize_t i = 0; i != count; ++i) {
+            if (!export_string_like(candidates_items[i], &candidates[i].start, &candidates[i].length)) {
+                free(candidates);
+                Py_DECREF(candidates_sequence);
+                PyErr_SetString(PyExc_TypeError, "Candidates must be string-like");
+                return NULL;
+            }
+        }
+    }
+
+    sz_sequence_t sequence;
+    sequence.order = NULL;
+    sequence.count = (sz_size_t)count;
+    sequence.handle = candidates;
+    sequence.get_start = parts_get_start;
+    sequence.get_length = parts_get_length;
+
+    // Reuse the same memory for the Levenshtein matrices of all calls
+    sz_memory_allocator_t reusing_allocator;
+    reusing_allocator.allocate = &temporary_memory_allocate;
+    reusing_allocator.free = &temporary_memory_free;
+    reusing_allocator.handle = &temporary_memory;
+
+    PyObject *result = NULL;
+    sz_size_t *distances = (sz_size_t *)malloc(sizeof(sz_size_t) * (count + 1));
+    if (!distances) { PyErr_NoMemory(); }
+    else if (!sz_edit_distances_batch(query.start, query.length, &sequence, (sz_size_t)bound, distances,
+                                      &reusing_allocator)) {
+        PyErr_NoMemory();
+    }
+    else if ((result = PyList_New(count))) {
+        for (Py_ssize_t i = 0; i != count; ++i) PyList_SET_ITEM(result, i, PyLong_FromSize_t(distances[i]));
+    }
+
+    free(distances);
+    free(candidates);
+    Py_XDECREF(candidates_sequence);
+    return result;
+}
+
 static PyObject *_Str_hamming_distance(PyObject *self, PyObject *args, PyObject *kwargs,
                                        sz_hamming_distance_t function) {
     int is_member = self != NULL && PyObject_TypeCheck(self, &StrType);
@@ -1420,7 +2274,7 @@ static PyObject *Str_find_last_not_of(PyObject *self, PyObject *args, PyObject *
 }
 
 static Strs *Str_split_(PyObject *parent, sz_string_view_t text, sz_string_view_t separator, int keepseparator,
-                        Py_ssize_t maxsplit) {
+                        Py_ssize_t maxsplit, sz_size_t threads) {
     // Create Strs object
     Strs *result = (Strs *)PyObject_New(Strs, &StrsType);
     if (!result) return NULL;
@@ -1436,6 +2290,7 @@ static Strs *Str_split_(PyObject *parent, sz_string_view_t text, sz_string_view_
         result->data.consecutive_64bit.start = text.start;
         result->data.consecutive_64bit.parent = parent;
         result->data.consecutive_64bit.separator_length = !keepseparator * separator.length;
+        result->data.consecutive_64bit.end_offsets = NULL;
     }
     else {
         bytes_per_offset = 4;
@@ -1443,39 +2298,111 @@ static Strs *Str_split_(PyObject *parent, sz_string_view_t text, sz_string_view_
         result->data.consecutive_32bit.start = text.start;
         result->data.consecutive_32bit.parent = parent;
         result->data.consecutive_32bit.separator_length = !keepseparator * separator.length;
+        result->data.consecutive_32bit.end_offsets = NULL;
     }
+    Py_INCREF(parent);
 
-    // Iterate through string, keeping track of the
-    sz_size_t last_start = 0;
-    while (last_start <= text.length && offsets_count < maxsplit) {
-        sz_cptr_t match = sz_find(text.start + last_start, text.length - last_start, separator.start, separator.length);
-        sz_size_t offset_in_remaining = match ? match - text.start - last_start : text.length - last_start;
-
-        // Reallocate offsets array if needed
-        if (offsets_count >= offsets_capacity) {
-            offsets_capacity = (offsets_capacity + 1) * 2;
-            void *new_offsets = realloc(offsets_endings, offsets_capacity * bytes_per_offset);
-            if (!new_offsets) {
-                if (offsets_endings) free(offsets_endings);
-            }
-            offsets_endings = new_offsets;
+    // Search for the separators on multiple threads, then convert their offsets into the ends of the parts
+    if (threads > 1 && separator.length && maxsplit > 0) {
+        sz_executor_t executor;
+        executor.parallel_for = parallel_for_threads;
+        executor.threads_count = threads;
+        executor.handle = &threads;
+        sz_memory_allocator_t alloc;
+        sz_memory_allocator_init_default(&alloc);
+        sz_size_t *matches, matches_count;
+        if (!sz_find_all_parallel(text.start, text.length, separator.start, separator.length, sz_true_k, &matches,
+                                  &matches_count, &alloc, &executor)) {
+            Py_XDECREF(result);
+            PyErr_NoMemory();
+            return NULL;
         }
-
-        // If the memory allocation has failed - discard the response
+        offsets_count = sz_min_of_two(matches_count + 1, (sz_size_t)maxsplit);
+        offsets_endings = malloc(offsets_count * bytes_per_offset);
+        for (sz_size_t i = 0; offsets_endings && i != offsets_count; ++i) {
+            sz_size_t next_offset = i < matches_count ? matches[i] + separator.length : text.length;
+            if (text.length >= UINT32_MAX) { ((uint64_t *)offsets_endings)[i] = (uint64_t)next_offset; }
+            else { ((uint32_t *)offsets_endings)[i] = (uint32_t)next_offset; }
+        }
+        if (matches) alloc.free(matches, matches_count * sizeof(sz_size_t), alloc.handle);
         if (!offsets_endings) {
             Py_XDECREF(result);
             PyErr_NoMemory();
             return NULL;
         }
-
-        // Export the offset
-        size_t will_continue = match != NULL;
-        size_t next_offset = last_start + offset_in_remaining + separator.length * will_continue;
-        if (text.length >= UINT32_MAX) { ((uint64_t *)offsets_endings)[offsets_count++] = (uint64_t)next_offset; }
-        else { ((uint32_t *)offsets_endings)[offsets_count++] = (uint32_t)next_offset; }
-
-        // Next time we want to start
-        last_start = last_start + offset_in_remaining + separator.length;
+    }
+    // Single-byte separators, like the newlines, are indexed in bulk, directly into the growing tape of offsets
+    else if (separator.length == 1) {
+        sz_charset_t delimiters;
+        sz_charset_init(&delimiters);
+        sz_charset_add(&delimiters, separator.start[0]);
+        sz_size_t const parts_limit = maxsplit > 0 ? (sz_size_t)maxsplit : 0;
+        sz_size_t progress = 0, consumed;
+        int exported_all = 0;
+        while (offsets_count < parts_limit) {
+            // Reallocate offsets array if needed
+            if (offsets_count >= offsets_capacity) {
+                offsets_capacity = sz_max_of_two(offsets_capacity * 2, 64);
+                void *new_offsets = realloc(offsets_endings, offsets_capacity * bytes_per_offset);
+                if (!new_offsets) {
+                    free(offsets_endings);
+                    Py_XDECREF(result);
+                    PyErr_NoMemory();
+                    return NULL;
+                }
+                offsets_endings = new_offsets;
+            }
+
+            // Once all the separators are exported, the last part ends with the text
+            if (exported_all) {
+                if (text.length >= UINT32_MAX) { ((uint64_t *)offsets_endings)[offsets_count++] = text.length; }
+                else { ((uint32_t *)offsets_endings)[offsets_count++] = (uint32_t)text.length; }
+                break;
+            }
+
+            sz_ptr_t offsets_tail = (sz_ptr_t)offsets_endings + offsets_count * bytes_per_offset;
+            offsets_count += sz_split_offsets(text.start + progress, text.length - progress, &delimiters, progress + 1,
+                                              offsets_tail, bytes_per_offset,
+                                              sz_min_of_two(offsets_capacity, parts_limit) - offsets_count, &consumed);
+            progress += consumed;
+            exported_all = progress == text.length;
+        }
+    }
+    else {
+        // Iterate through string, keeping track of the
+        sz_size_t last_start = 0;
+        sz_needle_t prepared;
+        sz_needle_prepare(separator.start, separator.length, &prepared);
+        while (last_start <= text.length && offsets_count < maxsplit) {
+            sz_cptr_t match = sz_find_prepared(&prepared, text.start + last_start, text.length - last_start);
+            sz_size_t offset_in_remaining = match ? match - text.start - last_start : text.length - last_start;
+
+            // Reallocate offsets array if needed
+            if (offsets_count >= offsets_capacity) {
+                offsets_capacity = (offsets_capacity + 1) * 2;
+                void *new_offsets = realloc(offsets_endings, offsets_capacity * bytes_per_offset);
+                if (!new_offsets) {
+                    if (offsets_endings) free(offsets_endings);
+                }
+                offsets_endings = new_offsets;
+            }
+
+            // If the memory allocation has failed - discard the response
+            if (!offsets_endings) {
+                Py_XDECREF(result);
+                PyErr_NoMemory();
+                return NULL;
+            }
+
+            // Export the offset
+            size_t will_continue = match != NULL;
+            size_t next_offset = last_start + offset_in_remaining + separator.length * will_continue;
+            if (text.length >= UINT32_MAX) { ((uint64_t *)offsets_endings)[offsets_count++] = (uint64_t)next_offset; }
+            else { ((uint32_t *)offsets_endings)[offsets_count++] = (uint32_t)next_offset; }
+
+            // Next time we want to start
+            last_start = last_start + offset_in_remaining + separator.length;
+        }
     }
 
     // Populate the Strs object with the offsets
@@ -1487,8 +2414,6 @@ static Strs *Str_split_(PyObject *parent, sz_string_view_t text, sz_string_view_
         result->data.consecutive_32bit.end_offsets = offsets_endings;
         result->data.consecutive_32bit.count = offsets_count;
     }
-
-    Py_INCREF(parent);
     return result;
 }
 
@@ -1505,6 +2430,7 @@ static PyObject *Str_split(PyObject *self, PyObject *args, PyObject *kwargs) {
     PyObject *separator_obj = nargs > !is_member + 0 ? PyTuple_GET_ITEM(args, !is_member + 0) : NULL;
     PyObject *maxsplit_obj = nargs > !is_member + 1 ? PyTuple_GET_ITEM(args, !is_member + 1) : NULL;
     PyObject *keepseparator_obj = nargs > !is_member + 2 ? PyTuple_GET_ITEM(args, !is_member + 2) : NULL;
+    PyObject *threads_obj = NULL; // Default is single-threaded
 
     if (kwargs) {
         PyObject *key, *value;
@@ -1513,6 +2439,7 @@ static PyObject *Str_split(PyObject *self, PyObject *args, PyObject *kwargs) {
             if (PyUnicode_CompareWithASCIIString(key, "separator") == 0) { separator_obj = value; }
             else if (PyUnicode_CompareWithASCIIString(key, "maxsplit") == 0) { maxsplit_obj = value; }
             else if (PyUnicode_CompareWithASCIIString(key, "keepseparator") == 0) { keepseparator_obj = value; }
+            else if (PyUnicode_CompareWithASCIIString(key, "threads") == 0) { threads_obj = value; }
             else if (PyErr_Format(PyExc_TypeError, "Got an unexpected keyword argument '%U'", key))
                 return NULL;
         }
@@ -1563,7 +2490,10 @@ static PyObject *Str_split(PyObject *self, PyObject *args, PyObject *kwargs) {
     }
     else { maxsplit = PY_SSIZE_T_MAX; }
 
-    return Str_split_(text_obj, text, separator, keepseparator, maxsplit);
+    sz_size_t threads = 1;
+    if (threads_obj && !parse_threads_count(threads_obj, &threads)) return NULL;
+
+    return Str_split_(text_obj, text, separator, keepseparator, maxsplit, threads);
 }
 
 static PyObject *Str_splitlines(PyObject *self, PyObject *args, PyObject *kwargs) {
@@ -1625,7 +2555,107 @@ static PyObject *Str_splitlines(PyObject *self, PyObject *args, PyObject *kwargs
     sz_string_view_t separator;
     separator.start = "\n";
     separator.length = 1;
-    return Str_split_(text_obj, text, separator, keeplinebreaks, maxsplit);
+    return Str_split_(text_obj, text, separator, keeplinebreaks, maxsplit, 1);
+}
+
+static PyObject *Str_isutf8(PyObject *self, PyObject *args, PyObject *kwargs) {
+    int is_member = self != NULL && PyObject_TypeCheck(self, &StrType);
+    Py_ssize_t nargs = PyTuple_Size(args);
+    if (nargs != !is_member || kwargs) {
+        PyErr_SetString(PyExc_TypeError, "isutf8() expects exactly one string-like argument");
+        return NULL;
+    }
+
+    PyObject *text_obj = is_member ? self : PyTuple_GET_ITEM(args, 0);
+    sz_string_view_t text;
+    if (!export_string_like(text_obj, &text.start, &text.length)) {
+        PyErr_SetString(PyExc_TypeError, "The text argument must be string-like");
+        return NULL;
+    }
+
+    if (sz_utf8_valid(text.start, text.length)) { Py_RETURN_TRUE; }
+    else { Py_RETURN_FALSE; }
+}
+
+static PyObject *Str_len_unicode(PyObject *self, PyObject *args, PyObject *kwargs) {
+    int is_member = self != NULL && PyObject_TypeCheck(self, &StrType);
+    Py_ssize_t nargs = PyTuple_Size(args);
+    if (nargs != !is_member || kwargs) {
+        PyErr_SetString(PyExc_TypeError, "len_unicode() expects exactly one string-like argument");
+        return NULL;
+    }
+
+    PyObject *text_obj = is_member ? self : PyTuple_GET_ITEM(args, 0);
+    sz_string_view_t text;
+    if (!export_string_like(text_obj, &text.start, &text.length)) {
+        PyErr_SetString(PyExc_TypeError, "The text argument must be string-like");
+        return NULL;
+    }
+
+    return PyLong_FromSize_t((size_t)sz_utf8_count(text.start, text.length));
+}
+
+static PyObject *Str_slice_unicode(PyObject *self, PyObject *args, PyObject *kwargs) {
+    int is_member = self != NULL && PyObject_TypeCheck(self, &StrType);
+    Py_ssize_t nargs = PyTuple_Size(args);
+    if (nargs < !is_member || nargs > !is_member + 2) {
+        PyErr_SetString(PyExc_TypeError, "slice_unicode() expects a string and up to two indices");
+        return NULL;
+    }
+
+    PyObject *text_obj = is_member ? self : PyTuple_GET_ITEM(args, 0);
+    PyObject *start_obj = nargs > !is_member ? PyTuple_GET_ITEM(args, !is_member) : NULL;
+    PyObject *end_obj = nargs > !is_member + 1 ? PyTuple_GET_ITEM(args, !is_member + 1) : NULL;
+
+    if (kwargs) {
+        PyObject *key, *value;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(kwargs, &pos, &key, &value)) {
+            if (PyUnicode_CompareWithASCIIString(key, "start") == 0) { start_obj = value; }
+            else if (PyUnicode_CompareWithASCIIString(key, "end") == 0) { end_obj = value; }
+            else if (PyErr_Format(PyExc_TypeError, "Got an unexpected keyword argument '%U'", key)) { return NULL; }
+        }
+    }
+
+    sz_string_view_t text;
+    if (!export_string_like(text_obj, &text.start, &text.length)) {
+        PyErr_SetString(PyExc_TypeError, "The text argument must be string-like");
+        return NULL;
+    }
+
+    // Optional start and end arguments, measured in runes
+    Py_ssize_t start = 0, end = PY_SSIZE_T_MAX;
+    if (start_obj && start_obj != Py_None && (start = PyLong_AsSsize_t(start_obj)) == -1 && PyErr_Occurred()) {
+        PyErr_SetString(PyExc_TypeError, "start must be an integer");
+        return NULL;
+    }
+    if (end_obj && end_obj != Py_None && (end = PyLong_AsSsize_t(end_obj)) == -1 && PyErr_Occurred()) {
+        PyErr_SetString(PyExc_TypeError, "end must be an integer");
+        return NULL;
+    }
+
+    // Only negative indices require counting all the runes
+    if (start < 0 || end < 0) {
+        Py_ssize_t const count = (Py_ssize_t)sz_utf8_count(text.start, text.length);
+        if (start < 0) start = start + count < 0 ? 0 : start + count;
+        if (end < 0) end = end + count < 0 ? 0 : end + count;
+    }
+
+    // Translate the rune offsets into byte offsets, reusing the start for the second lookup
+    sz_cptr_t slice_start = sz_utf8_find_nth(text.start, text.length, (sz_size_t)start);
+    if (!slice_start) slice_start = text.start + text.length;
+    sz_size_t const remaining_length = text.length - (sz_size_t)(slice_start - text.start);
+    sz_cptr_t slice_end = end > start ? sz_utf8_find_nth(slice_start, remaining_length, (sz_size_t)(end - start))
+                                      : slice_start;
+    if (!slice_end) slice_end = text.start + text.length;
+
+    Str *result = (Str *)StrType.tp_alloc(&StrType, 0);
+    if (result == NULL && PyErr_NoMemory()) return NULL;
+    result->start = slice_start;
+    result->length = (sz_size_t)(slice_end - slice_start);
+    result->parent = text_obj; // Set parent to keep it alive
+    Py_INCREF(text_obj);
+    return (PyObject *)result;
 }
 
 static PyObject *Str_concat(PyObject *self, PyObject *other) {
@@ -1703,6 +2733,9 @@ static PyMethodDef Str_methods[] = {
     {"rfind", Str_rfind, SZ_METHOD_FLAGS, "Find the last occurrence of a substring."},
     {"rindex", Str_rindex, SZ_METHOD_FLAGS, "Find the last occurrence of a substring or raise error if missing."},
     {"rpartition", Str_rpartition, SZ_METHOD_FLAGS, "Splits string into 3-tuple: before, last match, after."},
+    {"find_any", Str_find_any, SZ_METHOD_FLAGS, "Find the first occurrence of any needle from a sequence."},
+    {"find_fuzzy", Str_find_fuzzy, SZ_METHOD_FLAGS,
+     "Find the offset and length of the first approximate occurrence of a substring, within the given edits."},
 
     // Edit distance extensions
     {"hamming_distance", Str_hamming_distance, SZ_METHOD_FLAGS,
@@ -1713,6 +2746,8 @@ static PyMethodDef Str_methods[] = {
      "Levenshtein distance between two strings, as the number of inserted, deleted, and replaced bytes."},
     {"edit_distance_unicode", Str_edit_distance_unicode, SZ_METHOD_FLAGS,
      "Levenshtein distance between two strings, as the number of inserted, deleted, and replaced unicode characters."},
+    {"edit_distances", Str_edit_distances, SZ_METHOD_FLAGS,
+     "Levenshtein distances from one string to every string in a sequence, with an optional shared bound."},
     {"alignment_score", Str_alignment_score, SZ_METHOD_FLAGS,
      "Needleman-Wunsch alignment score given a substitution cost matrix."},
 
@@ -1726,6 +2761,16 @@ static PyMethodDef Str_methods[] = {
     {"find_last_not_of", Str_find_last_not_of, SZ_METHOD_FLAGS,
      "Finds the last occurrence of a character not present in another string."},
 
+    // Unicode extensions
+    {"isutf8", Str_isutf8, SZ_METHOD_FLAGS, "Check if a string is a valid UTF-8 sequence."},
+    {"len_unicode", Str_len_unicode, SZ_METHOD_FLAGS, "Number of unicode characters in a UTF-8 string."},
+    {"slice_unicode", Str_slice_unicode, SZ_METHOD_FLAGS,
+     "Slice a UTF-8 string by the offsets of unicode characters, rather than bytes."},
+
+    // Similarity sketches
+    {"sketch", Str_sketch, SZ_METHOD_FLAGS,
+     "MinHash and SimHash signatures of a string for several rolling window lengths."},
+
     {NULL, NULL, 0, NULL}};
 
 static PyTypeObject StrType = {
@@ -1816,7 +2861,7 @@ static PyObject *Strs_shuffle(Strs *self, PyObject *args, PyObject *kwargs) {
 }
 
 static sz_bool_t Strs_sort_(Strs *self, sz_string_view_t **parts_output, sz_sorted_idx_t **order_output,
-                            sz_size_t *count_output) {
+                            sz_size_t *count_output, sz_size_t threads_count) {
     // Change the layout
     if (!prepare_strings_for_reordering(self)) {
         PyErr_Format(PyExc_TypeError, "Failed to prepare the sequence for sorting");
@@ -1848,7 +2893,15 @@ static sz_bool_t Strs_sort_(Strs *self, sz_string_view_t **parts_output, sz_sort
     sequence.get_start = parts_get_start;
     sequence.get_length = parts_get_length;
     for (sz_sorted_idx_t i = 0; i != sequence.count; ++i) sequence.order[i] = i;
-    sz_sort(&sequence);
+    if (threads_count == 0) threads_count = hardware_concurrency();
+    if (threads_count > 1) {
+        sz_executor_t executor;
+        executor.parallel_for = parallel_for_threads;
+        executor.threads_count = threads_count;
+        executor.handle = &threads_count;
+        sz_sort_parallel(&sequence, &executor);
+    }
+    else { sz_sort(&sequence); }
 
     // Export results
     *parts_output = parts;
@@ -1859,6 +2912,7 @@ static sz_bool_t Strs_sort_(Strs *self, sz_string_view_t **parts_output, sz_sort
 
 static PyObject *Strs_sort(Strs *self, PyObject *args, PyObject *kwargs) {
     PyObject *reverse_obj = NULL; // Default is not reversed
+    PyObject *threads_obj = NULL; // Default is single-threaded
 
     // Check for positional arguments
     Py_ssize_t nargs = PyTuple_Size(args);
@@ -1880,6 +2934,7 @@ static PyObject *Strs_sort(Strs *self, PyObject *args, PyObject *kwargs) {
                 }
                 reverse_obj = value;
             }
+            else if (PyUnicode_CompareWithASCIIString(key, "threads") == 0) { threads_obj = value; }
             else {
                 PyErr_Format(PyExc_TypeError, "Received an unexpected keyword argument '%U'", key);
                 return NULL;
@@ -1896,10 +2951,20 @@ static PyObject *Strs_sort(Strs *self, PyObject *args, PyObject *kwargs) {
         reverse = PyObject_IsTrue(reverse_obj);
     }
 
+    sz_size_t threads = 1;
+    if (threads_obj) {
+        Py_ssize_t signed_threads = PyLong_AsSsize_t(threads_obj);
+        if (signed_threads < 0) {
+            if (!PyErr_Occurred()) PyErr_SetString(PyExc_ValueError, "The threads count can't be negative");
+            return NULL;
+        }
+        threads = (sz_size_t)signed_threads;
+    }
+
     sz_string_view_t *parts = NULL;
     sz_size_t *order = NULL;
     sz_size_t count = 0;
-    if (!Strs_sort_(self, &parts, &order, &count)) return NULL;
+    if (!Strs_sort_(self, &parts, &order, &count, threads)) return NULL;
 
     // Apply the sorting algorithm here, considering the `reverse` value
     if (reverse) reverse_offsets(order, count);
@@ -1910,8 +2975,39 @@ static PyObject *Strs_sort(Strs *self, PyObject *args, PyObject *kwargs) {
     Py_RETURN_NONE;
 }
 
+/**
+ *  @brief  Sorts the strings into a file, following every one of them with the `separator`, without
+ *          changing the `Strs` itself. Suited for collections, that are too large for `Strs.sort`.
+ *          Sorts runs of `run_bytes` in memory, and merges them from temporary files next to the output.
+ */
+static PyObject *Strs_external_sort(Strs *self, PyObject *args, PyObject *kwargs) {
+    char const *output_path;
+    size_t run_bytes;
+    char separator;
+    if (!external_sort_parse_args(args, kwargs, &output_path, &run_bytes, &separator)) return NULL;
+    get_string_at_offset_t getter = str_at_offset_getter(self);
+    if (!getter) return NULL;
+
+    external_sort_t state;
+    if (!external_sort_init(&state, output_path, run_bytes)) return NULL;
+    Py_ssize_t const count = Strs_len(self);
+    sz_bool_t success = 1;
+    for (Py_ssize_t i = 0; success && i != count; ++i) {
+        PyObject *parent;
+        char const *start;
+        size_t length;
+        getter(self, i, count, &parent, &start, &length);
+        success = external_sort_push(&state, start, length);
+    }
+    success = success && external_sort_merge(&state, separator);
+    external_sort_free(&state);
+    if (!success) return NULL;
+    Py_RETURN_NONE;
+}
+
 static PyObject *Strs_order(Strs *self, PyObject *args, PyObject *kwargs) {
     PyObject *reverse_obj = NULL; // Default is not reversed
+    PyObject *threads_obj = NULL; // Default is single-threaded
 
     // Check for positional arguments
     Py_ssize_t nargs = PyTuple_Size(args);
@@ -1933,6 +3029,7 @@ static PyObject *Strs_order(Strs *self, PyObject *args, PyObject *kwargs) {
                 }
                 reverse_obj = value;
             }
+            else if (PyUnicode_CompareWithASCIIString(key, "threads") == 0) { threads_obj = value; }
             else {
                 PyErr_Format(PyExc_TypeError, "Received an unexpected keyword argument '%U'", key);
                 return NULL;
@@ -1949,10 +3046,20 @@ static PyObject *Strs_order(Strs *self, PyObject *args, PyObject *kwargs) {
         reverse = PyObject_IsTrue(reverse_obj);
     }
 
+    sz_size_t threads = 1;
+    if (threads_obj) {
+        Py_ssize_t signed_threads = PyLong_AsSsize_t(threads_obj);
+        if (signed_threads < 0) {
+            if (!PyErr_Occurred()) PyErr_SetString(PyExc_ValueError, "The threads count can't be negative");
+            return NULL;
+        }
+        threads = (sz_size_t)signed_threads;
+    }
+
     sz_string_view_t *parts = NULL;
     sz_sorted_idx_t *order = NULL;
     sz_size_t count = 0;
-    if (!Strs_sort_(self, &parts, &order, &count)) return NULL;
+    if (!Strs_sort_(self, &parts, &order, &count, threads)) return NULL;
 
     // Apply the sorting algorithm here, considering the `reverse` value
     if (reverse) reverse_offsets(order, count);
@@ -1989,6 +3096,598 @@ static PyObject *Strs_order(Strs *self, PyObject *args, PyObject *kwargs) {
     return tuple;
 }
 
+/**
+ *  @brief  Allocates a contiguous array of @p count elements of the given `struct` module @p format, exported as
+ *          a writable `memoryview`, that NumPy, PyArrow and the `array` module consume without copies.
+ *          The @p data pointer remains valid for as long as the returned view is alive.
+ */
+static PyObject *typed_array_new(sz_size_t count, sz_size_t item_size, char const *format, void **data) {
+    PyObject *bytes = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t)(count * item_size));
+    if (!bytes) return NULL;
+    PyObject *untyped_view = PyMemoryView_FromObject(bytes);
+    *data = PyByteArray_AS_STRING(bytes);
+    Py_DECREF(bytes);
+    if (!untyped_view) return NULL;
+    PyObject *typed_view = PyObject_CallMethod(untyped_view, "cast", "s", format);
+    Py_DECREF(untyped_view);
+    return typed_view;
+}
+
+/**
+ *  @brief  Exposes the parts of @p strs as an array of string views, borrowing the parts of the `STRS_REORDERED`
+ *          layout and gathering them for the consecutive layouts, which must be freed if @p owned is set.
+ */
+static sz_string_view_t *Strs_views_(Strs *strs, sz_size_t *count, int *owned) {
+    *count = (sz_size_t)Strs_len(strs);
+    *owned = strs->type != STRS_REORDERED;
+    if (!*owned) return strs->data.reordered.parts;
+
+    get_string_at_offset_t getter = str_at_offset_getter(strs);
+    if (!getter) return NULL;
+    sz_string_view_t *views = (sz_string_view_t *)malloc(sizeof(sz_string_view_t) * (*count + 1));
+    if (!views) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (sz_size_t i = 0; i != *count; ++i) {
+        PyObject *parent;
+        getter(strs, (Py_ssize_t)i, (Py_ssize_t)*count, &parent, &views[i].start, &views[i].length);
+    }
+    return views;
+}
+
+static PyObject *Strs_parent_(Strs *strs) {
+    switch (strs->type) {
+    case STRS_CONSECUTIVE_32: return strs->data.consecutive_32bit.parent;
+    case STRS_CONSECUTIVE_64: return strs->data.consecutive_64bit.parent;
+    case STRS_REORDERED: return strs->data.reordered.parent;
+    default: return NULL;
+    }
+}
+
+/**
+ *  @brief  Parses the arguments of the batch methods, that take one string-like positional argument,
+ *          and an optional @p option_name keyword argument, like `Strs.count(needle, allowoverlap=False)`.
+ */
+static sz_bool_t Strs_batch_parse_args_(PyObject *args, PyObject *kwargs, char const *method,
+                                        sz_string_view_t *argument, char const *option_name, PyObject **option_obj) {
+    Py_ssize_t nargs = PyTuple_Size(args);
+    if (nargs < 1 || nargs > 1 + (option_name != NULL)) {
+        PyErr_Format(PyExc_TypeError, "%s() received unsupported number of arguments", method);
+        return 0;
+    }
+    PyObject *argument_obj = PyTuple_GET_ITEM(args, 0);
+    *option_obj = nargs > 1 ? PyTuple_GET_ITEM(args, 1) : NULL;
+
+    if (kwargs) {
+        PyObject *key, *value;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(kwargs, &pos, &key, &value)) {
+            if (option_name && PyUnicode_CompareWithASCIIString(key, option_name) == 0) {
+                if (*option_obj) {
+                    PyErr_Format(PyExc_TypeError, "Received %s both as positional and keyword argument", option_name);
+                    return 0;
+                }
+                *option_obj = value;
+            }
+            else {
+                PyErr_Format(PyExc_TypeError, "Received an unexpected keyword argument '%U'", key);
+                return 0;
+            }
+        }
+    }
+
+    if (!export_string_like(argument_obj, &argument->start, &argument->length)) {
+        PyErr_Format(PyExc_TypeError, "The argument of %s() must be string-like", method);
+        return 0;
+    }
+    return 1;
+}
+
+static PyObject *Strs_lengths(Strs *self, PyObject *args, PyObject *kwargs) {
+    if (PyTuple_Size(args) || (kwargs && PyDict_Size(kwargs))) {
+        PyErr_SetString(PyExc_TypeError, "lengths() takes no arguments");
+        return NULL;
+    }
+    sz_size_t count;
+    int owned;
+    sz_string_view_t *views = Strs_views_(self, &count, &owned);
+    if (!views) return NULL;
+
+    sz_u64_t *lengths;
+    PyObject *result = typed_array_new(count, sizeof(sz_u64_t), "Q", (void **)&lengths);
+    for (sz_size_t i = 0; result && i != count; ++i) lengths[i] = views[i].length;
+    if (owned) free(views);
+    return result;
+}
+
+static PyObject *Strs_hash(Strs *self, PyObject *args, PyObject *kwargs) {
+    if (PyTuple_Size(args) || (kwargs && PyDict_Size(kwargs))) {
+        PyErr_SetString(PyExc_TypeError, "hash() takes no arguments");
+        return NULL;
+    }
+    sz_size_t count;
+    int owned;
+    sz_string_view_t *views = Strs_views_(self, &count, &owned);
+    if (!views) return NULL;
+
+    // The batch kernel interleaves the hashing of several short strings, unlike repeated `sz_hash` calls
+    sz_u64_t *hashes;
+    PyObject *result = typed_array_new(count, sizeof(sz_u64_t), "Q", (void **)&hashes);
+    if (result) {
+        sz_sequence_t sequence;
+        memset(&sequence, 0, sizeof(sequence));
+        sequence.count = count;
+        sequence.handle = views;
+        sequence.get_start = parts_get_start;
+        sequence.get_length = parts_get_length;
+        sz_hash_batch(&sequence, hashes);
+    }
+    if (owned) free(views);
+    return result;
+}
+
+static PyObject *Strs_find(Strs *self, PyObject *args, PyObject *kwargs) {
+    sz_string_view_t needle;
+    PyObject *unused_obj;
+    if (!Strs_batch_parse_args_(args, kwargs, "find", &needle, NULL, &unused_obj)) return NULL;
+    sz_size_t count;
+    int owned;
+    sz_string_view_t *views = Strs_views_(self, &count, &owned);
+    if (!views) return NULL;
+
+    // The needle is prepared once for all the strings.
+    sz_needle_t prepared;
+    sz_needle_prepare(needle.start, needle.length, &prepared);
+    sz_i64_t *offsets;
+    PyObject *result = typed_array_new(count, sizeof(sz_i64_t), "q", (void **)&offsets);
+    for (sz_size_t i = 0; result && i != count; ++i) {
+        sz_cptr_t match = sz_find_prepared(&prepared, views[i].start, views[i].length);
+        offsets[i] = match ? (sz_i64_t)(match - views[i].start) : -1;
+    }
+    if (owned) free(views);
+    return result;
+}
+
+static PyObject *Strs_count(Strs *self, PyObject *args, PyObject *kwargs) {
+    sz_string_view_t needle;
+    PyObject *allowoverlap_obj;
+    if (!Strs_batch_parse_args_(args, kwargs, "count", &needle, "allowoverlap", &allowoverlap_obj)) return NULL;
+    int allowoverlap = allowoverlap_obj ? PyObject_IsTrue(allowoverlap_obj) : 0;
+    if (allowoverlap == -1) return NULL;
+    sz_size_t count;
+    int owned;
+    sz_string_view_t *views = Strs_views_(self, &count, &owned);
+    if (!views) return NULL;
+
+    sz_needle_t prepared;
+    sz_needle_prepare(needle.start, needle.length, &prepared);
+    sz_u64_t *counts;
+    PyObject *result = typed_array_new(count, sizeof(sz_u64_t), "Q", (void **)&counts);
+    for (sz_size_t i = 0; result && i != count; ++i)
+        counts[i] = needle.length && views[i].length >= needle.length
+                        ? Str_count_prepared_(&prepared, views[i], allowoverlap)
+                        : 0;
+    if (owned) free(views);
+    return result;
+}
+
+static PyObject *Strs_startswith(Strs *self, PyObject *args, PyObject *kwargs) {
+    sz_string_view_t prefix;
+    PyObject *unused_obj;
+    if (!Strs_batch_parse_args_(args, kwargs, "startswith", &prefix, NULL, &unused_obj)) return NULL;
+    sz_size_t count;
+    int owned;
+    sz_string_view_t *views = Strs_views_(self, &count, &owned);
+    if (!views) return NULL;
+
+    sz_u8_t *matches;
+    PyObject *result = typed_array_new(count, sizeof(sz_u8_t), "?", (void **)&matches);
+    for (sz_size_t i = 0; result && i != count; ++i)
+        matches[i] = views[i].length >= prefix.length && sz_equal(views[i].start, prefix.start, prefix.length);
+    if (owned) free(views);
+    return result;
+}
+
+static PyObject *Strs_edit_distance(Strs *self, PyObject *args, PyObject *kwargs) {
+    sz_string_view_t query;
+    PyObject *bound_obj;
+    if (!Strs_batch_parse_args_(args, kwargs, "edit_distance", &query, "bound", &bound_obj)) return NULL;
+    Py_ssize_t bound = 0; // Default value for bound
+    if (bound_obj && ((bound = PyLong_AsSsize_t(bound_obj)) < 0)) {
+        if (!PyErr_Occurred()) PyErr_SetString(PyExc_ValueError, "Bound must be a non-negative integer");
+        return NULL;
+    }
+    sz_size_t count;
+    int owned;
+    sz_string_view_t *views = Strs_views_(self, &count, &owned);
+    if (!views) return NULL;
+
+    sz_sequence_t sequence;
+    memset(&sequence, 0, sizeof(sequence));
+    sequence.count = count;
+    sequence.handle = views;
+    sequence.get_start = parts_get_start;
+    sequence.get_length = parts_get_length;
+
+    // Reuse the same memory for the Levenshtein matrices of all calls
+    sz_memory_allocator_t reusing_allocator;
+    reusing_allocator.allocate = &temporary_memory_allocate;
+    reusing_allocator.free = &temporary_memory_free;
+    reusing_allocator.handle = &temporary_memory;
+
+    // The distances are exported in place, so their type must match the platform's `size_t`
+    sz_size_t *distances;
+    PyObject *result = typed_array_new(count, sizeof(sz_size_t), sizeof(sz_size_t) == 8 ? "Q" : "I",
+                                       (void **)&distances);
+    if (result && !sz_edit_distances_batch(query.start, query.length, &sequence, (sz_size_t)bound, distances,
+                                           &reusing_allocator)) {
+        Py_DECREF(result);
+        result = PyErr_NoMemory();
+    }
+    if (owned) free(views);
+    return result;
+}
+
+/**
+ *  @brief  Produces a new `Strs` with the distinct strings in lexicographic order, like `sorted(set(strs))`,
+ *          but without materializing any Python objects. The original `Strs` is left unchanged.
+ */
+static PyObject *Strs_unique(Strs *self, PyObject *args, PyObject *kwargs) {
+    if (PyTuple_Size(args) || (kwargs && PyDict_Size(kwargs))) {
+        PyErr_SetString(PyExc_TypeError, "unique() takes no arguments");
+        return NULL;
+    }
+    sz_size_t count;
+    int owned;
+    sz_string_view_t *views = Strs_views_(self, &count, &owned);
+    if (!views) return NULL;
+
+    sz_sorted_idx_t *order = (sz_sorted_idx_t *)malloc(sizeof(sz_sorted_idx_t) * (count + 1));
+    sz_string_view_t *unique_parts = (sz_string_view_t *)malloc(sizeof(sz_string_view_t) * (count + 1));
+    if (!order || !unique_parts) {
+        free(order);
+        free(unique_parts);
+        if (owned) free(views);
+        return PyErr_NoMemory();
+    }
+
+    sz_sequence_t sequence;
+    memset(&sequence, 0, sizeof(sequence));
+    sequence.order = order;
+    sequence.count = count;
+    sequence.handle = views;
+    sequence.get_start = parts_get_start;
+    sequence.get_length = parts_get_length;
+    for (sz_sorted_idx_t i = 0; i != sequence.count; ++i) sequence.order[i] = i;
+    sz_sort(&sequence);
+
+    // Equal strings are adjacent in the sorted order
+    sz_size_t unique_count = 0;
+    for (sz_size_t i = 0; i != count; ++i) {
+        sz_string_view_t const *part = &views[order[i]];
+        sz_string_view_t const *last = unique_count ? &unique_parts[unique_count - 1] : NULL;
+        if (last && last->length == part->length && sz_equal(last->start, part->start, part->length)) continue;
+        unique_parts[unique_count++] = *part;
+    }
+    free(order);
+    if (owned) free(views);
+
+    // The object is only created once nothing else can fail, as `Strs_dealloc` expects its fields to be set
+    Strs *result = (Strs *)PyObject_New(Strs, &StrsType);
+    if (!result) {
+        free(unique_parts);
+        return NULL;
+    }
+    result->type = STRS_REORDERED;
+    result->data.reordered.count = unique_count;
+    result->data.reordered.parts = unique_parts;
+    result->data.reordered.parent = Strs_parent_(self);
+    Py_XINCREF(result->data.reordered.parent);
+    return (PyObject *)result;
+}
+
+/**
+ *  @brief  Producer-side state of an exported Arrow array. It owns the materialized offsets and,
+ *          if the parts weren't already packed back-to-back, a gathered copy of their contents.
+ *          Otherwise, the parent object is referenced to keep the shared contents alive.
+ */
+typedef struct {
+    PyObject *parent;
+    void *offsets;
+    char *gathered;
+    void const *buffers[3];
+} strs_arrow_export_t;
+
+static void Strs_arrow_release_schema(struct ArrowSchema *schema) { schema->release = NULL; }
+
+static void Strs_arrow_release_array(struct ArrowArray *array) {
+    strs_arrow_export_t *state = (strs_arrow_export_t *)array->private_data;
+    if (state) {
+        // Consumers may release the array from any thread, not holding the GIL
+        if (state->parent) {
+            PyGILState_STATE gil = PyGILState_Ensure();
+            Py_DECREF(state->parent);
+            PyGILState_Release(gil);
+        }
+        free(state->offsets);
+        free(state->gathered);
+        free(state);
+    }
+    array->release = NULL;
+}
+
+static void Strs_arrow_schema_capsule_destructor(PyObject *capsule) {
+    struct ArrowSchema *schema = (struct ArrowSchema *)PyCapsule_GetPointer(capsule, "arrow_schema");
+    if (schema && schema->release) schema->release(schema);
+    free(schema);
+}
+
+static void Strs_arrow_array_capsule_destructor(PyObject *capsule) {
+    struct ArrowArray *array = (struct ArrowArray *)PyCapsule_GetPointer(capsule, "arrow_array");
+    if (array && array->release) array->release(array);
+    free(array);
+}
+
+static void Strs_arrow_imported_capsule_destructor(PyObject *capsule) {
+    struct ArrowArray *array = (struct ArrowArray *)PyCapsule_GetPointer(capsule, "stringzilla.arrow_array");
+    if (array && array->release) array->release(array);
+    free(array);
+}
+
+/**
+ *  @brief  Exports the collection over the Arrow PyCapsule interface, as a `string` or `large_string`
+ *          array, depending on the total length of the parts. If the parts are packed back-to-back in
+ *          the parent's memory, only the offsets are materialized, and the contents are shared.
+ */
+static PyObject *Strs_arrow_c_array(Strs *self, PyObject *args, PyObject *kwargs) {
+    // The `requested_schema` is merely a hint, that producers are allowed to ignore
+    Py_ssize_t nargs = PyTuple_Size(args);
+    if (nargs > 1) {
+        PyErr_SetString(PyExc_TypeError, "__arrow_c_array__() takes at most 1 positional argument");
+        return NULL;
+    }
+    if (kwargs) {
+        PyObject *key, *value;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(kwargs, &pos, &key, &value))
+            if (PyUnicode_CompareWithASCIIString(key, "requested_schema") != 0) {
+                PyErr_Format(PyExc_TypeError, "Received an unexpected keyword argument '%U'", key);
+                return NULL;
+            }
+    }
+
+    Py_ssize_t count = Strs_len(self);
+    get_string_at_offset_t getter = str_at_offset_getter(self);
+    if (!getter) return NULL;
+
+    // Check if the parts are packed back-to-back, so that we can avoid copying the contents
+    PyObject *parent = NULL;
+    sz_cptr_t first_start = NULL, expected_start = NULL;
+    sz_size_t total_length = 0;
+    sz_bool_t is_contiguous = 1;
+    for (Py_ssize_t i = 0; i != count; ++i) {
+        sz_cptr_t start;
+        sz_size_t length;
+        getter(self, i, count, &parent, &start, &length);
+        if (i == 0) first_start = start;
+        else if (start != expected_start) is_contiguous = 0;
+        expected_start = start + length;
+        total_length += length;
+    }
+
+    sz_bool_t is_64bit = total_length > INT32_MAX;
+    sz_size_t bytes_per_offset = is_64bit ? 8 : 4;
+    strs_arrow_export_t *state = (strs_arrow_export_t *)calloc(1, sizeof(strs_arrow_export_t));
+    struct ArrowSchema *schema = (struct ArrowSchema *)malloc(sizeof(struct ArrowSchema));
+    struct ArrowArray *array = (struct ArrowArray *)malloc(sizeof(struct ArrowArray));
+    if (state) state->offsets = malloc((count + 1) * bytes_per_offset);
+    if (state && !is_contiguous) state->gathered = (char *)malloc(total_length);
+    if (!state || !schema || !array || !state->offsets || (!is_contiguous && !state->gathered)) {
+        if (state) free(state->offsets), free(state->gathered);
+        free(state), free(schema), free(array);
+        return PyErr_NoMemory();
+    }
+
+    // Export the offsets, gathering the contents if needed
+    sz_size_t offset = 0;
+    for (Py_ssize_t i = 0; i != count; ++i) {
+        sz_cptr_t start;
+        sz_size_t length;
+        getter(self, i, count, &parent, &start, &length);
+        if (is_64bit) ((int64_t *)state->offsets)[i] = (int64_t)offset;
+        else { ((int32_t *)state->offsets)[i] = (int32_t)offset; }
+        if (!is_contiguous) memcpy(state->gathered + offset, start, length);
+        offset += length;
+    }
+    if (is_64bit) ((int64_t *)state->offsets)[count] = (int64_t)offset;
+    else { ((int32_t *)state->offsets)[count] = (int32_t)offset; }
+
+    // Shared contents must outlive the exported array
+    static char const empty_contents[1] = {0};
+    sz_cptr_t contents = empty_contents;
+    if (!is_contiguous) contents = state->gathered;
+    else if (count) {
+        contents = first_start;
+        state->parent = parent;
+        Py_INCREF(parent);
+    }
+    state->buffers[0] = NULL; // No validity bitmap, as there are no nulls
+    state->buffers[1] = state->offsets;
+    state->buffers[2] = contents;
+
+    array->length = count;
+    array->null_count = 0;
+    array->offset = 0;
+    array->n_buffers = 3;
+    array->n_children = 0;
+    array->buffers = state->buffers;
+    array->children = NULL;
+    array->dictionary = NULL;
+    array->release = Strs_arrow_release_array;
+    array->private_data = state;
+
+    schema->format = is_64bit ? "U" : "u";
+    schema->name = "";
+    schema->metadata = NULL;
+    schema->flags = 0;
+    schema->n_children = 0;
+    schema->children = NULL;
+    schema->dictionary = NULL;
+    schema->release = Strs_arrow_release_schema;
+    schema->private_data = NULL;
+
+    // From here on, the capsules are responsible for releasing the structures
+    PyObject *schema_capsule = PyCapsule_New(schema, "arrow_schema", Strs_arrow_schema_capsule_destructor);
+    if (!schema_capsule) {
+        Strs_arrow_release_array(array);
+        free(schema), free(array);
+        return NULL;
+    }
+    PyObject *array_capsule = PyCapsule_New(array, "arrow_array", Strs_arrow_array_capsule_destructor);
+    if (!array_capsule) {
+        Strs_arrow_release_array(array);
+        free(array);
+        Py_DECREF(schema_capsule);
+        return NULL;
+    }
+
+    PyObject *result = PyTuple_Pack(2, schema_capsule, array_capsule);
+    Py_DECREF(schema_capsule);
+    Py_DECREF(array_capsule);
+    return result;
+}
+
+/**
+ *  @brief  Imports an Arrow `string`, `large_string`, `binary`, or `large_binary` array without copying
+ *          its contents. Accepts any object implementing `__arrow_c_array__`, like the PyArrow arrays,
+ *          or the tuple of the schema and array capsules it produces. The imported array is moved into
+ *          a private capsule, that becomes the parent of the resulting `Strs` and its `Str` slices.
+ *          Null entries are represented as empty strings.
+ */
+static PyObject *Strs_from_arrow(PyObject *cls, PyObject *source) {
+    PyObject *capsules = NULL;
+    if (PyTuple_Check(source)) {
+        capsules = source;
+        Py_INCREF(capsules);
+    }
+    else {
+        PyObject *exporter = PyObject_GetAttrString(source, "__arrow_c_array__");
+        if (!exporter) {
+            PyErr_Clear();
+            PyErr_SetString(PyExc_TypeError, "Expected an object implementing the Arrow PyCapsule interface");
+            return NULL;
+        }
+        capsules = PyObject_CallObject(exporter, NULL);
+        Py_DECREF(exporter);
+        if (!capsules) return NULL;
+    }
+
+    if (!PyTuple_Check(capsules) || PyTuple_GET_SIZE(capsules) != 2 ||
+        !PyCapsule_IsValid(PyTuple_GET_ITEM(capsules, 0), "arrow_schema") ||
+        !PyCapsule_IsValid(PyTuple_GET_ITEM(capsules, 1), "arrow_array")) {
+        PyErr_SetString(PyExc_TypeError, "Expected a tuple of 'arrow_schema' and 'arrow_array' capsules");
+        Py_DECREF(capsules);
+        return NULL;
+    }
+    struct ArrowSchema *schema =
+        (struct ArrowSchema *)PyCapsule_GetPointer(PyTuple_GET_ITEM(capsules, 0), "arrow_schema");
+    struct ArrowArray *array = (struct ArrowArray *)PyCapsule_GetPointer(PyTuple_GET_ITEM(capsules, 1), "arrow_array");
+    if (!array->release) {
+        PyErr_SetString(PyExc_ValueError, "The Arrow array has already been released");
+        Py_DECREF(capsules);
+        return NULL;
+    }
+
+    sz_bool_t is_64bit;
+    if (strcmp(schema->format, "u") == 0 || strcmp(schema->format, "z") == 0) is_64bit = 0;
+    else if (strcmp(schema->format, "U") == 0 || strcmp(schema->format, "Z") == 0) is_64bit = 1;
+    else {
+        PyErr_Format(PyExc_TypeError, "Unsupported Arrow format '%s', expected variable-length strings or binary",
+                     schema->format);
+        Py_DECREF(capsules);
+        return NULL;
+    }
+    if (array->n_buffers != 3) {
+        PyErr_SetString(PyExc_ValueError, "Arrow variable-length arrays must have 3 buffers");
+        Py_DECREF(capsules);
+        return NULL;
+    }
+
+    // Move the array into our own capsule, as permitted by the specification
+    struct ArrowArray *owned = (struct ArrowArray *)malloc(sizeof(struct ArrowArray));
+    sz_size_t count = (sz_size_t)array->length;
+    sz_string_view_t *parts = (sz_string_view_t *)malloc((count + 1) * sizeof(sz_string_view_t));
+    if (!owned || !parts) {
+        free(owned), free(parts);
+        Py_DECREF(capsules);
+        return PyErr_NoMemory();
+    }
+    *owned = *array;
+    array->release = NULL;
+    Py_DECREF(capsules);
+    PyObject *owner = PyCapsule_New(owned, "stringzilla.arrow_array", Strs_arrow_imported_capsule_destructor);
+    if (!owner) {
+        owned->release(owned);
+        free(owned), free(parts);
+        return NULL;
+    }
+
+    sz_u8_t const *validity = (sz_u8_t const *)owned->buffers[0];
+    sz_cptr_t contents = owned->buffers[2] ? (sz_cptr_t)owned->buffers[2] : "";
+    sz_size_t first = (sz_size_t)owned->offset;
+    for (sz_size_t i = 0; i != count; ++i) {
+        sz_size_t j = first + i;
+        if (validity && !((validity[j >> 3] >> (j & 7)) & 1)) {
+            parts[i].start = contents;
+            parts[i].length = 0;
+            continue;
+        }
+        sz_size_t start_offset, end_offset;
+        if (is_64bit) {
+            start_offset = (sz_size_t)((int64_t const *)owned->buffers[1])[j];
+            end_offset = (sz_size_t)((int64_t const *)owned->buffers[1])[j + 1];
+        }
+        else {
+            start_offset = (sz_size_t)((int32_t const *)owned->buffers[1])[j];
+            end_offset = (sz_size_t)((int32_t const *)owned->buffers[1])[j + 1];
+        }
+        parts[i].start = contents + start_offset;
+        parts[i].length = end_offset - start_offset;
+    }
+
+    Strs *result = (Strs *)PyObject_New(Strs, &StrsType);
+    if (!result) {
+        Py_DECREF(owner);
+        free(parts);
+        return NULL;
+    }
+    result->type = STRS_REORDERED;
+    result->data.reordered.count = count;
+    result->data.reordered.parent = owner;
+    result->data.reordered.parts = parts;
+    return (PyObject *)result;
+}
+
+static void Strs_dealloc(Strs *self) {
+    switch (self->type) {
+    case STRS_CONSECUTIVE_32:
+        free(self->data.consecutive_32bit.end_offsets);
+        Py_XDECREF(self->data.consecutive_32bit.parent);
+        break;
+    case STRS_CONSECUTIVE_64:
+        free(self->data.consecutive_64bit.end_offsets);
+        Py_XDECREF(self->data.consecutive_64bit.parent);
+        break;
+    case STRS_REORDERED:
+        free(self->data.reordered.parts);
+        Py_XDECREF(self->data.reordered.parent);
+        break;
+    default: break;
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
 static PySequenceMethods Strs_as_sequence = {
     .sq_length = Strs_len,        //
     .sq_item = Strs_getitem,      //
@@ -2004,6 +3703,20 @@ static PyMethodDef Strs_methods[] = {
     {"shuffle", Strs_shuffle, SZ_METHOD_FLAGS, "Shuffle the elements of the Strs object."},  //
     {"sort", Strs_sort, SZ_METHOD_FLAGS, "Sort the elements of the Strs object."},           //
     {"order", Strs_order, SZ_METHOD_FLAGS, "Provides the indexes to achieve sorted order."}, //
+    {"lengths", Strs_lengths, SZ_METHOD_FLAGS, "Lengths of all strings as a contiguous array."},                 //
+    {"hash", Strs_hash, SZ_METHOD_FLAGS, "Hashes of all strings as a contiguous array."},                        //
+    {"find", Strs_find, SZ_METHOD_FLAGS, "Offsets of the needle in every string or -1, as a contiguous array."}, //
+    {"count", Strs_count, SZ_METHOD_FLAGS, "Needle occurrences in every string as a contiguous array."},         //
+    {"startswith", Strs_startswith, SZ_METHOD_FLAGS, "Prefix checks of all strings as a contiguous array."},     //
+    {"edit_distance", Strs_edit_distance, SZ_METHOD_FLAGS,
+     "Levenshtein distances from the query to every string, as a contiguous array."}, //
+    {"unique", Strs_unique, SZ_METHOD_FLAGS, "Distinct strings in sorted order, as a new Strs."}, //
+    {"external_sort", Strs_external_sort, SZ_METHOD_FLAGS,
+     "Sort the strings into a file, using temporary runs for collections larger than RAM."}, //
+    {"__arrow_c_array__", Strs_arrow_c_array, SZ_METHOD_FLAGS,
+     "Export the strings as an Apache Arrow array, following the Arrow PyCapsule interface."}, //
+    {"from_arrow", Strs_from_arrow, METH_O | METH_CLASS,
+     "Zero-copy import of an Apache Arrow array of strings, following the Arrow PyCapsule interface."}, //
     {NULL, NULL, 0, NULL}};
 
 static PyTypeObject StrsType = {
@@ -2013,6 +3726,7 @@ static PyTypeObject StrsType = {
     .tp_itemsize = 0,
     .tp_flags = Py_TPFLAGS_DEFAULT,
     .tp_new = PyType_GenericNew,
+    .tp_dealloc = Strs_dealloc,
     .tp_methods = Strs_methods,
     .tp_as_sequence = &Strs_as_sequence,
     .tp_as_mapping = &Strs_as_mapping,
@@ -2020,6 +3734,270 @@ static PyTypeObject StrsType = {
 
 #pragma endregion
 
+#pragma region SuffixIndex
+
+static void SuffixIndex_dealloc(SuffixIndex *self) {
+    if (self->owned_suffixes) free(self->owned_suffixes);
+    self->owned_suffixes = NULL;
+    self->suffixes = NULL;
+    Py_XDECREF(self->parent);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *SuffixIndex_new(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
+    SuffixIndex *self = (SuffixIndex *)type->tp_alloc(type, 0);
+    if (!self) return NULL;
+    self->parent = NULL;
+    self->text = NULL;
+    self->length = 0;
+    self->suffixes = NULL;
+    self->owned_suffixes = NULL;
+    return (PyObject *)self;
+}
+
+/**
+ *  @brief  Builds the suffix array of a string-like object, like a `str`, `bytes`, `Str`, or a `File`.
+ *          Takes 8 bytes per byte of text, and up to 32 more bytes per byte of text during construction.
+ */
+static int SuffixIndex_init(SuffixIndex *self, PyObject *args, PyObject *kwargs) {
+    PyObject *text_obj;
+    static char *names[] = {"text", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", names, &text_obj)) return -1;
+
+    sz_string_view_t text;
+    if (!export_string_like(text_obj, &text.start, &text.length)) {
+        PyErr_SetString(PyExc_TypeError, "The text argument must be string-like");
+        return -1;
+    }
+
+    sz_sorted_idx_t *suffixes = (sz_sorted_idx_t *)malloc((text.length + 1) * sizeof(sz_sorted_idx_t));
+    if (!suffixes || !sz_suffix_array(text.start, text.length, suffixes, NULL)) {
+        free(suffixes);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    // Release the previous index, if `__init__` is called twice
+    if (self->owned_suffixes) free(self->owned_suffixes);
+    Py_XDECREF(self->parent);
+    Py_INCREF(text_obj);
+    self->parent = text_obj;
+    self->text = text.start;
+    self->length = text.length;
+    self->suffixes = self->owned_suffixes = suffixes;
+    return 0;
+}
+
+/**
+ *  @brief  Opens an index serialized with `save`, pointing into the memory-mapped `File` without copies.
+ */
+static PyObject *SuffixIndex_open(PyObject *cls, PyObject *file_obj) {
+    if (!PyObject_TypeCheck(file_obj, &FileType)) {
+        PyErr_SetString(PyExc_TypeError, "The serialized index must be a File");
+        return NULL;
+    }
+
+    File *file = (File *)file_obj;
+    sz_cptr_t text;
+    sz_size_t length;
+    sz_sorted_idx_t const *suffixes;
+    if (!sz_suffix_index_parse(file->start, file->length, &text, &length, &suffixes)) {
+        PyErr_SetString(PyExc_ValueError, "The file doesn't contain a valid suffix index");
+        return NULL;
+    }
+
+    SuffixIndex *self = (SuffixIndex *)SuffixIndex_new((PyTypeObject *)cls, NULL, NULL);
+    if (!self) return NULL;
+    Py_INCREF(file_obj);
+    self->parent = file_obj;
+    self->text = text;
+    self->length = length;
+    self->suffixes = suffixes;
+    return (PyObject *)self;
+}
+
+static Py_ssize_t SuffixIndex_len(SuffixIndex *self) { return (Py_ssize_t)self->length; }
+
+/**
+ *  @brief  Helper function, that exports the only positional needle argument of the query methods.
+ */
+static int SuffixIndex_export_needle(PyObject *args, PyObject *kwargs, char const *name, sz_string_view_t *needle) {
+    if (PyTuple_Size(args) != 1 || kwargs) {
+        PyErr_Format(PyExc_TypeError, "%s() expects exactly one positional argument", name);
+        return 0;
+    }
+    if (!export_string_like(PyTuple_GET_ITEM(args, 0), &needle->start, &needle->length)) {
+        PyErr_SetString(PyExc_TypeError, "The needle argument must be string-like");
+        return 0;
+    }
+    return 1;
+}
+
+static PyObject *SuffixIndex_count(PyObject *self, PyObject *args, PyObject *kwargs) {
+    SuffixIndex *index = (SuffixIndex *)self;
+    sz_string_view_t needle;
+    if (!SuffixIndex_export_needle(args, kwargs, "count", &needle)) return NULL;
+    sz_size_t first;
+    sz_size_t count = sz_suffix_array_range(index->text, index->length, index->suffixes, needle.start, needle.length,
+                                            &first);
+    return PyLong_FromSize_t(count);
+}
+
+static PyObject *SuffixIndex_find_all(PyObject *self, PyObject *args, PyObject *kwargs) {
+    SuffixIndex *index = (SuffixIndex *)self;
+    sz_string_view_t needle;
+    if (!SuffixIndex_export_needle(args, kwargs, "find_all", &needle)) return NULL;
+    sz_size_t first;
+    sz_size_t count = sz_suffix_array_range(index->text, index->length, index->suffixes, needle.start, needle.length,
+                                            &first);
+
+    PyObject *offsets = PyList_New((Py_ssize_t)count);
+    if (!offsets) return NULL;
+    for (sz_size_t i = 0; i != count; ++i) {
+        PyObject *offset = PyLong_FromSize_t((size_t)index->suffixes[first + i]);
+        if (!offset) {
+            Py_DECREF(offsets);
+            return NULL;
+        }
+        PyList_SET_ITEM(offsets, (Py_ssize_t)i, offset);
+    }
+    return offsets;
+}
+
+static PyObject *SuffixIndex_longest_prefix(PyObject *self, PyObject *args, PyObject *kwargs) {
+    SuffixIndex *index = (SuffixIndex *)self;
+    sz_string_view_t needle;
+    if (!SuffixIndex_export_needle(args, kwargs, "longest_prefix", &needle)) return NULL;
+    sz_size_t offset;
+    sz_size_t length = sz_suffix_array_longest_prefix(index->text, index->length, index->suffixes, needle.start,
+                                                      needle.length, &offset);
+    return Py_BuildValue("(nn)", (Py_ssize_t)offset, (Py_ssize_t)length);
+}
+
+static PyObject *SuffixIndex_save(PyObject *self, PyObject *args, PyObject *kwargs) {
+    SuffixIndex *index = (SuffixIndex *)self;
+    char const *path;
+    static char *names[] = {"path", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s", names, &path)) return NULL;
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+        return NULL;
+    }
+    char header[SZ_SUFFIX_INDEX_HEADER_SIZE];
+    sz_suffix_index_header(index->length, header);
+    int written = fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+                  fwrite(index->suffixes, sizeof(sz_sorted_idx_t), index->length, file) == index->length &&
+                  fwrite(index->text, 1, index->length, file) == index->length;
+    if (fclose(file) != 0 || !written) {
+        PyErr_SetString(PyExc_OSError, "Couldn't write the suffix index");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PySequenceMethods SuffixIndex_as_sequence = {
+    .sq_length = (lenfunc)SuffixIndex_len,
+};
+
+static PyMethodDef SuffixIndex_methods[] = {
+    {"count", SuffixIndex_count, SZ_METHOD_FLAGS, "Count the occurrences of a substring, including overlapping."},
+    {"find_all", SuffixIndex_find_all, SZ_METHOD_FLAGS,
+     "Offsets of all occurrences of a substring, ordered lexicographically by the following text."},
+    {"longest_prefix", SuffixIndex_longest_prefix, SZ_METHOD_FLAGS,
+     "Offset and length of the longest prefix of a string, that occurs in the text."},
+    {"save", SuffixIndex_save, SZ_METHOD_FLAGS, "Serialize the index and the text into a memory-mappable file."},
+    {"open", SuffixIndex_open, METH_O | METH_CLASS, "Zero-copy view of an index, serialized into a File."},
+    {NULL, NULL, 0, NULL}};
+
+static PyTypeObject SuffixIndexType = {
+    PyObject_HEAD_INIT(NULL).tp_name = "stringzilla.SuffixIndex",
+    .tp_doc = "Suffix array over a static text, for repeated substring queries in logarithmic time",
+    .tp_basicsize = sizeof(SuffixIndex),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = SuffixIndex_new,
+    .tp_init = (initproc)SuffixIndex_init,
+    .tp_dealloc = (destructor)SuffixIndex_dealloc,
+    .tp_methods = SuffixIndex_methods,
+    .tp_as_sequence = &SuffixIndex_as_sequence,
+};
+
+#pragma endregion
+
+#pragma region Telemetry
+
+/**
+ *  @brief  Formats the capabilities as a comma-separated list of names, like "serial,avx2,".
+ *          The @p buffer must fit at least 128 characters.
+ */
+static void export_capabilities(sz_capability_t caps, char *buffer) {
+    char const *serial = (caps & sz_cap_serial_k) ? "serial," : "";
+    char const *neon = (caps & sz_cap_arm_neon_k) ? "neon," : "";
+    char const *sve = (caps & sz_cap_arm_sve_k) ? "sve," : "";
+    char const *sve2 = (caps & sz_cap_arm_sve2_k) ? "sve2," : "";
+    char const *avx2 = (caps & sz_cap_x86_avx2_k) ? "avx2," : "";
+    char const *avx512f = (caps & sz_cap_x86_avx512f_k) ? "avx512f," : "";
+    char const *avx512vl = (caps & sz_cap_x86_avx512vl_k) ? "avx512vl," : "";
+    char const *avx512bw = (caps & sz_cap_x86_avx512bw_k) ? "avx512bw," : "";
+    char const *avx512vbmi = (caps & sz_cap_x86_avx512vbmi_k) ? "avx512vbmi," : "";
+    char const *gfni = (caps & sz_cap_x86_gfni_k) ? "gfni," : "";
+    char const *avx512vpopcntdq = (caps & sz_cap_x86_avx512vpopcntdq_k) ? "avx512vpopcntdq," : "";
+    sprintf(buffer, "%s%s%s%s%s%s%s%s%s%s%s", serial, neon, sve, sve2, avx2, avx512f, avx512vl, avx512bw, avx512vbmi,
+            gfni, avx512vpopcntdq);
+}
+
+static PyObject *module_override_capabilities(PyObject *self, PyObject *caps_obj) {
+    sz_string_view_t names;
+    if (!export_string_like(caps_obj, &names.start, &names.length)) {
+        PyErr_SetString(PyExc_TypeError, "The capabilities must be a comma-separated string, like 'serial,avx2'");
+        return NULL;
+    }
+    char caps_str[128];
+    export_capabilities(sz_capabilities_override(sz_capabilities_parse(names.start, names.length)), caps_str);
+    return PyUnicode_FromString(caps_str);
+}
+
+static PyObject *module_enable_stats(PyObject *self, PyObject *args, PyObject *kwargs) {
+    int cycles = 0;
+    static char *names[] = {"cycles", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p", names, &cycles)) return NULL;
+    sz_stats_enable(cycles ? sz_stats_cycles_k : sz_stats_counts_k);
+    Py_RETURN_NONE;
+}
+
+static PyObject *module_disable_stats(PyObject *self, PyObject *unused) {
+    sz_stats_enable(sz_stats_disabled_k);
+    Py_RETURN_NONE;
+}
+
+static PyObject *module_reset_stats(PyObject *self, PyObject *unused) {
+    sz_stats_reset();
+    Py_RETURN_NONE;
+}
+
+static PyObject *module_stats(PyObject *self, PyObject *unused) {
+    sz_kernel_stats_t stats[sz_kernels_count_k];
+    sz_size_t count = sz_stats_get(stats, sz_kernels_count_k);
+    PyObject *result = PyDict_New();
+    if (!result) return NULL;
+    for (sz_size_t i = 0; i != count; ++i) {
+        PyObject *entry = Py_BuildValue("{s:s,s:K,s:K,s:K}", "backend", stats[i].backend, "calls",
+                                        (unsigned long long)stats[i].calls, "bytes",
+                                        (unsigned long long)stats[i].bytes, "cycles",
+                                        (unsigned long long)stats[i].cycles);
+        if (!entry || PyDict_SetItemString(result, stats[i].name, entry) < 0) {
+            Py_XDECREF(entry);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(entry);
+    }
+    return result;
+}
+
+#pragma endregion
+
 static void stringzilla_cleanup(PyObject *m) {
     if (temporary_memory.start) free(temporary_memory.start);
     temporary_memory.start = NULL;
@@ -2042,6 +4020,9 @@ static PyMethodDef stringzilla_methods[] = {
     {"rfind", Str_rfind, SZ_METHOD_FLAGS, "Find the last occurrence of a substring."},
     {"rindex", Str_rindex, SZ_METHOD_FLAGS, "Find the last occurrence of a substring or raise error if missing."},
     {"rpartition", Str_rpartition, SZ_METHOD_FLAGS, "Splits string into 3-tuple: before, last match, after."},
+    {"find_any", Str_find_any, SZ_METHOD_FLAGS, "Find the first occurrence of any needle from a sequence."},
+    {"find_fuzzy", Str_find_fuzzy, SZ_METHOD_FLAGS,
+     "Find the offset and length of the first approximate occurrence of a substring, within the given edits."},
 
     // Edit distance extensions
     {"hamming_distance", Str_hamming_distance, SZ_METHOD_FLAGS,
@@ -2052,6 +4033,8 @@ static PyMethodDef stringzilla_methods[] = {
      "Levenshtein distance between two strings, as the number of inserted, deleted, and replaced bytes."},
     {"edit_distance_unicode", Str_edit_distance_unicode, SZ_METHOD_FLAGS,
      "Levenshtein distance between two strings, as the number of inserted, deleted, and replaced unicode characters."},
+    {"edit_distances", Str_edit_distances, SZ_METHOD_FLAGS,
+     "Levenshtein distances from one string to every string in a sequence, with an optional shared bound."},
     {"alignment_score", Str_alignment_score, SZ_METHOD_FLAGS,
      "Needleman-Wunsch alignment score given a substitution cost matrix."},
 
@@ -2065,9 +4048,28 @@ static PyMethodDef stringzilla_methods[] = {
     {"find_last_not_of", Str_find_last_not_of, SZ_METHOD_FLAGS,
      "Finds the last occurrence of a character not present in another string."},
 
+    // Unicode extensions
+    {"isutf8", Str_isutf8, SZ_METHOD_FLAGS, "Check if a string is a valid UTF-8 sequence."},
+    {"len_unicode", Str_len_unicode, SZ_METHOD_FLAGS, "Number of unicode characters in a UTF-8 string."},
+    {"slice_unicode", Str_slice_unicode, SZ_METHOD_FLAGS,
+     "Slice a UTF-8 string by the offsets of unicode characters, rather than bytes."},
+
+    // Similarity sketches
+    {"sketch", Str_sketch, SZ_METHOD_FLAGS,
+     "MinHash and SimHash signatures of a string for several rolling window lengths."},
+
     // Global unary extensions
     {"hash", Str_like_hash, SZ_METHOD_FLAGS, "Hash a string or a byte-array."},
 
+    // Telemetry and backend selection
+    {"override_capabilities", module_override_capabilities, METH_O,
+     "Limit the backends to the given comma-separated capabilities, returning the ones in use."},
+    {"enable_stats", module_enable_stats, SZ_METHOD_FLAGS,
+     "Count calls and bytes processed by every kernel, and optionally the CPU cycles."},
+    {"disable_stats", module_disable_stats, METH_NOARGS, "Stop collecting the per-kernel statistics."},
+    {"reset_stats", module_reset_stats, METH_NOARGS, "Zero the per-kernel statistics."},
+    {"stats", module_stats, METH_NOARGS, "Per-kernel backends, calls, bytes, and cycles, keyed by C function name."},
+
     {NULL, NULL, 0, NULL}};
 
 static PyModuleDef stringzilla_module = {
@@ -2088,6 +4090,7 @@ PyMODINIT_FUNC PyInit_stringzilla(void) {
     if (PyType_Ready(&StrType) < 0) return NULL;
     if (PyType_Ready(&FileType) < 0) return NULL;
     if (PyType_Ready(&StrsType) < 0) return NULL;
+    if (PyType_Ready(&SuffixIndexType) < 0) return NULL;
 
     m = PyModule_Create(&stringzilla_module);
     if (m == NULL) return NULL;
@@ -2102,18 +4105,8 @@ PyMODINIT_FUNC PyInit_stringzilla(void) {
 
     // Define SIMD capabilities
     {
-        sz_capability_t caps = sz_capabilities();
-        char caps_str[512];
-        char const *serial = (caps & sz_cap_serial_k) ? "serial," : "";
-        char const *neon = (caps & sz_cap_arm_neon_k) ? "neon," : "";
-        char const *sve = (caps & sz_cap_arm_sve_k) ? "sve," : "";
-        char const *avx2 = (caps & sz_cap_x86_avx2_k) ? "avx2," : "";
-        char const *avx512f = (caps & sz_cap_x86_avx512f_k) ? "avx512f," : "";
-        char const *avx512vl = (caps & sz_cap_x86_avx512vl_k) ? "avx512vl," : "";
-        char const *avx512bw = (caps & sz_cap_x86_avx512bw_k) ? "avx512bw," : "";
-        char const *avx512vbmi = (caps & sz_cap_x86_avx512vbmi_k) ? "avx512vbmi," : "";
-        char const *gfni = (caps & sz_cap_x86_gfni_k) ? "gfni," : "";
-        sprintf(caps_str, "%s%s%s%s%s%s%s%s%s", serial, neon, sve, avx2, avx512f, avx512vl, avx512bw, avx512vbmi, gfni);
+        char caps_str[128];
+        export_capabilities(sz_capabilities(), caps_str);
         PyModule_AddStringConstant(m, "__capabilities__", caps_str);
     }
 
@@ -2141,6 +4134,16 @@ PyMODINIT_FUNC PyInit_stringzilla(void) {
         return NULL;
     }
 
+    Py_INCREF(&SuffixIndexType);
+    if (PyModule_AddObject(m, "SuffixIndex", (PyObject *)&SuffixIndexType) < 0) {
+        Py_XDECREF(&SuffixIndexType);
+        Py_XDECREF(&StrsType);
+        Py_XDECREF(&FileType);
+        Py_XDECREF(&StrType);
+        Py_XDECREF(m);
+        return NULL;
+    }
+
     // Initialize temporary_memory, if needed
     temporary_memory.start = malloc(4096);
     temporary_memory.length = 4096 * (temporary_memory.start != NULL);
@@ -5,6 +5,9 @@
 #include <algorithm>
 #include <chrono>     // `std::chrono::high_resolution_clock`
 #include <clocale>    // `std::setlocale`
+#include <cmath>      // `std::sqrt`
+#include <cstdarg>    // `va_list`
+#include <cstdlib>    // `std::strtod`
 #include <cstring>    // `std::memcpy`
 #include <functional> // `std::equal_to`
 #include <limits>     // `std::numeric_limits`
@@ -17,6 +20,14 @@
 #include <stringzilla/stringzilla.h>
 #include <stringzilla/stringzilla.hpp>
 
+#if defined(__linux__)
+#include <linux/perf_event.h> // `perf_event_attr`
+#include <sched.h>            // `sched_setaffinity`
+#include <sys/ioctl.h>        // `ioctl`
+#include <sys/syscall.h>      // `SYS_perf_event_open`
+#include <unistd.h>           // `syscall`, `close`
+#endif
+
 #include "test.hpp" // `read_file`
 
 #if SZ_DEBUG // Make debugging faster
@@ -33,15 +44,248 @@ namespace scripts {
 
 using seconds_t = double;
 
+/**
+ *  @brief  Command-line settings shared by all of the benchmarks.
+ *
+ *  Every benchmark binary is invoked as `<binary> <dataset_path> [options]`, where the options are:
+ *  - `--json <path>` and `--csv <path>` to export the results in machine-readable formats.
+ *  - `--compare <path>` to compare against a JSON baseline exported by a previous run.
+ *  - `--threshold <fraction>` for the relative throughput drop, that is reported as a regression.
+ *  - `--repeat <count>` to split the time budget of every variant into multiple runs and report the variance.
+ *  - `--seconds <count>` to override the time budget of every variant.
+ *  - `--pin <core>` to pin the process to a single core, reducing the noise from migrations.
+ *  - `--perf` to collect the hardware counters with Linux `perf_event_open`.
+ */
+struct bench_config_t {
+    std::string binary;
+    std::string dataset_path;
+    std::string json_path;
+    std::string csv_path;
+    std::string compare_path;
+    double threshold = 0.05;
+    std::size_t repetitions = 1;
+    seconds_t seconds = default_seconds_m;
+    int pin_core = -1;
+    bool perf = false;
+};
+
+inline bench_config_t &bench_config() {
+    static bench_config_t config;
+    return config;
+}
+
+/**
+ *  @brief  Hardware counters, collected around a benchmark loop, if `--perf` was requested and is supported.
+ */
+struct perf_counters_t {
+    bool valid = false;
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t l1d_misses = 0;
+    std::uint64_t llc_misses = 0;
+    std::uint64_t running_ns = 0;
+
+    double ipc() const noexcept { return cycles ? (double)instructions / cycles : 0; }
+    double ghz() const noexcept { return running_ns ? (double)cycles / running_ns : 0; }
+
+    perf_counters_t &operator+=(perf_counters_t const &other) noexcept {
+        valid = valid || other.valid;
+        cycles += other.cycles, instructions += other.instructions;
+        l1d_misses += other.l1d_misses, llc_misses += other.llc_misses;
+        running_ns += other.running_ns;
+        return *this;
+    }
+};
+
+/**
+ *  @brief  RAII group of Linux `perf_event` counters for the current thread, led by the CPU cycles counter.
+ *          On other platforms, or when the kernel restricts access, it silently produces invalid counters.
+ */
+class perf_group_t {
+#if defined(__linux__)
+    static constexpr std::size_t events_count_k = 4;
+    int descriptors_[events_count_k] = {-1, -1, -1, -1};
+
+    static int open_event(std::uint32_t type, std::uint64_t config, int group) noexcept {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = type;
+        attributes.size = sizeof(attributes);
+        attributes.config = config;
+        attributes.disabled = group == -1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, group, 0));
+    }
+
+  public:
+    perf_group_t() noexcept {
+        if (!bench_config().perf) return;
+        std::uint64_t const l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        descriptors_[0] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+        if (descriptors_[0] < 0) {
+            static bool warned = false;
+            if (!warned) std::fprintf(stderr, "Hardware counters are unavailable, check `perf_event_paranoid`.\n");
+            warned = true;
+            return;
+        }
+        descriptors_[1] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, descriptors_[0]);
+        descriptors_[2] = open_event(PERF_TYPE_HW_CACHE, l1d_read_miss, descriptors_[0]);
+        descriptors_[3] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, descriptors_[0]);
+        ioctl(descriptors_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(descriptors_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    ~perf_group_t() noexcept {
+        for (int descriptor : descriptors_)
+            if (descriptor >= 0) close(descriptor);
+    }
+
+    perf_counters_t stop() noexcept {
+        perf_counters_t counters;
+        if (descriptors_[0] < 0) return counters;
+        ioctl(descriptors_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // With `PERF_FORMAT_GROUP`, the layout is: count of events, running time, and values in opening order.
+        // Events that failed to open are missing from the group, so we need to skip them.
+        std::uint64_t buffer[2 + events_count_k] = {0};
+        if (read(descriptors_[0], buffer, sizeof(buffer)) <= 0) return counters;
+        std::uint64_t *values[events_count_k] = {&counters.cycles, &counters.instructions, &counters.l1d_misses,
+                                                 &counters.llc_misses};
+        for (std::size_t event = 0, slot = 0; event != events_count_k && slot != buffer[0]; ++event)
+            if (descriptors_[event] >= 0) *values[event] = buffer[2 + slot++];
+        counters.running_ns = buffer[1];
+        counters.valid = true;
+        return counters;
+    }
+#else
+  public:
+    perf_counters_t stop() noexcept { return {}; }
+#endif
+
+    perf_group_t(perf_group_t const &) = delete;
+    perf_group_t &operator=(perf_group_t const &) = delete;
+};
+
 struct benchmark_result_t {
     std::size_t iterations = 0;
     std::size_t bytes_passed = 0;
     seconds_t seconds = 0;
+    std::size_t repetitions = 0;
+    double gbps_stddev = 0;
+    perf_counters_t counters;
+
+    double gbps() const noexcept { return seconds ? bytes_passed / seconds / 1.e9 : 0; }
+    double ns_per_op() const noexcept { return iterations ? seconds * 1e9 / iterations : 0; }
+};
+
+/**
+ *  @brief  Runs the @p step of a benchmark until the time budget is exhausted, splitting it into
+ *          `bench_config().repetitions` runs to estimate the variance of the throughput.
+ *  @param  step Callback, that receives the `benchmark_result_t` of the current run and must
+ *               increment its `iterations` and `bytes_passed` counters.
+ */
+template <typename step_type>
+benchmark_result_t bench_repeatedly(step_type &&step, seconds_t max_time = bench_config().seconds) {
+    namespace stdc = std::chrono;
+    using stdcc = stdc::high_resolution_clock;
+
+    std::size_t const repetitions = (std::max<std::size_t>)(bench_config().repetitions, 1);
+    seconds_t const time_per_repetition = max_time / repetitions;
+    benchmark_result_t total;
+    std::vector<double> throughputs;
+    for (std::size_t repetition = 0; repetition != repetitions; ++repetition) {
+        benchmark_result_t run;
+        perf_group_t counters;
+        stdcc::time_point t1 = stdcc::now();
+        while (true) {
+            step(run);
+            stdcc::time_point t2 = stdcc::now();
+            run.seconds = stdc::duration_cast<stdc::nanoseconds>(t2 - t1).count() / 1.e9;
+            if (run.seconds > time_per_repetition) break;
+        }
+        total.counters += counters.stop();
+        total.iterations += run.iterations;
+        total.bytes_passed += run.bytes_passed;
+        total.seconds += run.seconds;
+        throughputs.push_back(run.gbps());
+    }
+
+    double mean = 0, variance = 0;
+    for (double throughput : throughputs) mean += throughput;
+    mean /= repetitions;
+    for (double throughput : throughputs) variance += (throughput - mean) * (throughput - mean);
+    total.repetitions = repetitions;
+    total.gbps_stddev = repetitions > 1 ? std::sqrt(variance / (repetitions - 1)) : 0;
+    return total;
+}
+
+/**
+ *  @brief  Single row of the machine-readable report.
+ */
+struct benchmark_record_t {
+    std::string section;
+    std::string name;
+    benchmark_result_t results;
+    std::size_t failures = 0;
+    double baseline_gbps = 0; // Only used when loading baselines.
 };
 
+inline std::vector<benchmark_record_t> &bench_records() {
+    static std::vector<benchmark_record_t> records;
+    return records;
+}
+
+inline std::string &bench_current_section() {
+    static std::string section;
+    return section;
+}
+
+/**
+ *  @brief  Prints the section header, like `printf`, and labels all the following results with it.
+ *          The trailing colon, if present, is excluded from the label.
+ */
+inline void begin_section(char const *format, ...) {
+    char buffer[256];
+    va_list arguments;
+    va_start(arguments, format);
+    std::vsnprintf(buffer, sizeof(buffer), format, arguments);
+    va_end(arguments);
+    std::printf("%s\n", buffer);
+    std::string &section = bench_current_section();
+    section = buffer;
+    if (!section.empty() && section.back() == ':') section.pop_back();
+}
+
+/**
+ *  @brief  Appends the results of a variant into the report, exported by `finalize_benchmarks`.
+ */
+inline void record_result(std::string const &name, benchmark_result_t const &results, std::size_t failures = 0) {
+    benchmark_record_t record;
+    record.section = bench_current_section();
+    record.name = name;
+    record.results = results;
+    record.failures = failures;
+    bench_records().push_back(record);
+}
+
 using unary_function_t = std::function<std::size_t(std::string_view)>;
 using binary_function_t = std::function<std::size_t(std::string_view, std::string_view)>;
 
+/**
+ *  @brief  Prints the variance and the hardware counters, if they were collected, under the main result line.
+ */
+inline void print_details(benchmark_result_t const &results) {
+    if (results.repetitions > 1)
+        std::printf("  %20s ± %13.4f GB/s over %zu repetitions\n", "", results.gbps_stddev, results.repetitions);
+    if (results.counters.valid)
+        std::printf("  %20s %.2f IPC, %.2f GHz, %.3f L1d misses/op, %.3f LLC misses/op\n", "", results.counters.ipc(),
+                    results.counters.ghz(), (double)results.counters.l1d_misses / results.iterations,
+                    (double)results.counters.llc_misses / results.iterations);
+}
+
 /**
  *  @brief  Wrapper for a single execution backend.
  */
@@ -95,10 +339,11 @@ struct tracked_function_gt {
         if (is_binary) { format = "- %-20s %15.4f GB/s %15.1f ns %10zu errors in %10zu iterations %-20s %-20s\n"; }
         else { format = "- %-20s %15.4f GB/s %15.1f ns %10zu errors in %10zu iterations %-20s\n"; }
 
-        std::printf(format, name.c_str(), results.bytes_passed / results.seconds / 1.e9,
-                    results.seconds * 1e9 / results.iterations, failed_count, results.iterations,
+        std::printf(format, name.c_str(), results.gbps(), results.ns_per_op(), failed_count, results.iterations,
                     failed_strings.size() ? failed_strings[0].c_str() : "",
                     failed_strings.size() >= 2 && is_binary ? failed_strings[1].c_str() : "");
+        print_details(results);
+        record_result(name, results, failed_count);
     }
 };
 
@@ -203,12 +448,53 @@ inline dataset_t make_dataset_from_path(std::string path) {
     return data;
 }
 
+/**
+ *  @brief  Parses the CLI arguments into the `bench_config()`, pinning the process to a core, if requested.
+ *  @param  requires_dataset Whether to fail if no dataset path was passed, as some benchmarks can generate inputs.
+ */
+inline void parse_bench_config(int argc, char const *argv[], bool requires_dataset = true) {
+    bench_config_t &config = bench_config();
+    config.binary = argv[0];
+    std::string const usage = "Usage: " + config.binary +
+                              " <path> [--json <path>] [--csv <path>] [--compare <baseline.json>] [--threshold 0.05]"
+                              " [--repeat <count>] [--seconds <count>] [--pin <core>] [--perf]";
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        bool const has_value = i + 1 < argc;
+        if (argument == "--perf") { config.perf = true; }
+        else if (argument == "--json" && has_value) { config.json_path = argv[++i]; }
+        else if (argument == "--csv" && has_value) { config.csv_path = argv[++i]; }
+        else if (argument == "--compare" && has_value) { config.compare_path = argv[++i]; }
+        else if (argument == "--threshold" && has_value) { config.threshold = std::strtod(argv[++i], nullptr); }
+        else if (argument == "--repeat" && has_value) { config.repetitions = std::strtoul(argv[++i], nullptr, 10); }
+        else if (argument == "--seconds" && has_value) { config.seconds = std::strtod(argv[++i], nullptr); }
+        else if (argument == "--pin" && has_value) { config.pin_core = std::atoi(argv[++i]); }
+        else if (argument.size() && argument[0] != '-' && config.dataset_path.empty()) {
+            config.dataset_path = argument;
+        }
+        else { throw std::runtime_error(usage); }
+    }
+    if (requires_dataset && config.dataset_path.empty()) throw std::runtime_error(usage);
+
+    if (config.pin_core >= 0) {
+#if defined(__linux__)
+        cpu_set_t cores;
+        CPU_ZERO(&cores);
+        CPU_SET(config.pin_core, &cores);
+        if (sched_setaffinity(0, sizeof(cores), &cores) != 0)
+            std::fprintf(stderr, "Failed to pin the process to core #%d.\n", config.pin_core);
+#else
+        std::fprintf(stderr, "Pinning to cores is only supported on Linux.\n");
+#endif
+    }
+}
+
 /**
  *  @brief  Loads a dataset, depending on the passed CLI arguments.
  */
 inline dataset_t make_dataset(int argc, char const *argv[]) {
-    if (argc != 2) { throw std::runtime_error("Usage: " + std::string(argv[0]) + " <path>"); }
-    return make_dataset_from_path(argv[1]);
+    parse_bench_config(argc, argv);
+    return make_dataset_from_path(bench_config().dataset_path);
 }
 
 inline sz_string_view_t to_c(std::string_view str) noexcept { return {str.data(), str.size()}; }
@@ -225,30 +511,19 @@ inline sz_string_view_t to_c(sz_string_view_t str) noexcept { return str; }
  */
 template <typename strings_type, typename function_type>
 benchmark_result_t bench_on_tokens(strings_type &&strings, function_type &&function,
-                                   seconds_t max_time = default_seconds_m) {
+                                   seconds_t max_time = bench_config().seconds) {
 
-    namespace stdc = std::chrono;
-    using stdcc = stdc::high_resolution_clock;
-    stdcc::time_point t1 = stdcc::now();
-    benchmark_result_t result;
     std::size_t lookup_mask = bit_floor(strings.size()) - 1;
-
-    while (true) {
-        // Unroll a few iterations, to avoid some for-loops overhead and minimize impact of time-tracking
-        {
+    return bench_repeatedly(
+        [&](benchmark_result_t &result) {
+            // Unroll a few iterations, to avoid some for-loops overhead and minimize impact of time-tracking
             result.bytes_passed += function(strings[(result.iterations + 0) & lookup_mask]) +
                                    function(strings[(result.iterations + 1) & lookup_mask]) +
                                    function(strings[(result.iterations + 2) & lookup_mask]) +
                                    function(strings[(result.iterations + 3) & lookup_mask]);
             result.iterations += 4;
-        }
-
-        stdcc::time_point t2 = stdcc::now();
-        result.seconds = stdc::duration_cast<stdc::nanoseconds>(t2 - t1).count() / 1.e9;
-        if (result.seconds > max_time) break;
-    }
-
-    return result;
+        },
+        max_time);
 }
 
 /**
@@ -260,32 +535,21 @@ benchmark_result_t bench_on_tokens(strings_type &&strings, function_type &&funct
  */
 template <typename strings_type, typename function_type>
 benchmark_result_t bench_on_token_pairs(strings_type &&strings, function_type &&function,
-                                        seconds_t max_time = default_seconds_m) {
+                                        seconds_t max_time = bench_config().seconds) {
 
-    namespace stdc = std::chrono;
-    using stdcc = stdc::high_resolution_clock;
-    stdcc::time_point t1 = stdcc::now();
-    benchmark_result_t result;
     std::size_t lookup_mask = bit_floor(strings.size()) - 1;
     std::size_t largest_prime = static_cast<std::size_t>(18446744073709551557ull);
-
-    while (true) {
-        // Unroll a few iterations, to avoid some for-loops overhead and minimize impact of time-tracking
-        {
+    return bench_repeatedly(
+        [&](benchmark_result_t &result) {
+            // Unroll a few iterations, to avoid some for-loops overhead and minimize impact of time-tracking
             auto second = (result.iterations * largest_prime) & lookup_mask;
             result.bytes_passed += function(strings[(result.iterations + 0) & lookup_mask], strings[second]) +
                                    function(strings[(result.iterations + 1) & lookup_mask], strings[second]) +
                                    function(strings[(result.iterations + 2) & lookup_mask], strings[second]) +
                                    function(strings[(result.iterations + 3) & lookup_mask], strings[second]);
             result.iterations += 4;
-        }
-
-        stdcc::time_point t2 = stdcc::now();
-        result.seconds = stdc::duration_cast<stdc::nanoseconds>(t2 - t1).count() / 1.e9;
-        if (result.seconds > max_time) break;
-    }
-
-    return result;
+        },
+        max_time);
 }
 
 /**
@@ -361,6 +625,183 @@ void bench_binary_functions(strings_type &&strings, functions_type &&variants) {
     }
 }
 
+inline std::string json_escape(std::string const &text) {
+    std::string result;
+    for (char c : text) {
+        if (c == '"' || c == '\\') result.push_back('\\'), result.push_back(c);
+        else if (c == '\n') result += "\\n";
+        else if (c == '\t') result += "\\t";
+        else if ((unsigned char)c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned)c);
+            result += escaped;
+        }
+        else { result.push_back(c); }
+    }
+    return result;
+}
+
+inline std::string csv_escape(std::string const &text) {
+    std::string result = "\"";
+    for (char c : text) result += c == '"' ? std::string("\"\"") : std::string(1, c);
+    return result + "\"";
+}
+
+/**
+ *  @brief  Extracts a string field from a flat JSON object, undoing the escapes of `json_escape`.
+ */
+inline bool json_string_field(std::string_view object, char const *key, std::string &value) {
+    std::string pattern = std::string("\"") + key + "\"";
+    std::size_t position = object.find(pattern);
+    if (position == std::string_view::npos) return false;
+    position = object.find('"', object.find(':', position + pattern.size()));
+    if (position == std::string_view::npos) return false;
+    value.clear();
+    for (++position; position < object.size() && object[position] != '"'; ++position) {
+        char c = object[position];
+        if (c != '\\' || position + 1 == object.size()) {
+            value.push_back(c);
+            continue;
+        }
+        char escaped = object[++position];
+        if (escaped == 'n') value.push_back('\n');
+        else if (escaped == 't') value.push_back('\t');
+        else if (escaped == 'u' && position + 4 < object.size()) {
+            value.push_back((char)std::strtoul(std::string(object.substr(position + 1, 4)).c_str(), nullptr, 16));
+            position += 4;
+        }
+        else { value.push_back(escaped); }
+    }
+    return true;
+}
+
+/**
+ *  @brief  Extracts a numeric field from a flat JSON object.
+ */
+inline bool json_number_field(std::string_view object, char const *key, double &value) {
+    std::string pattern = std::string("\"") + key + "\"";
+    std::size_t position = object.find(pattern);
+    if (position == std::string_view::npos) return false;
+    position = object.find(':', position + pattern.size());
+    if (position == std::string_view::npos) return false;
+    value = std::strtod(std::string(object.substr(position + 1, 32)).c_str(), nullptr);
+    return true;
+}
+
+/**
+ *  @brief  Loads the records from a JSON report, previously exported with `--json`.
+ *          Every result is a flat object, so we only need to scan for the braces inside the `"results"` array.
+ */
+inline std::vector<benchmark_record_t> load_baseline(std::string const &path) {
+    std::string text = read_file(path);
+    std::vector<benchmark_record_t> records;
+    std::size_t position = text.find("\"results\"");
+    if (position == std::string::npos) throw std::runtime_error("Not a benchmark report: " + path);
+    while ((position = text.find('{', position)) != std::string::npos) {
+        std::size_t end = text.find('}', position);
+        if (end == std::string::npos) break;
+        std::string_view object(text.data() + position, end - position + 1);
+        benchmark_record_t record;
+        if (json_string_field(object, "section", record.section) && json_string_field(object, "name", record.name) &&
+            json_number_field(object, "gbps", record.baseline_gbps))
+            records.push_back(record);
+        position = end + 1;
+    }
+    return records;
+}
+
+inline void export_json(std::string const &path) {
+    bench_config_t const &config = bench_config();
+    std::string json = "{\n";
+    json += "  \"binary\": \"" + json_escape(config.binary) + "\",\n";
+    json += "  \"dataset\": \"" + json_escape(config.dataset_path) + "\",\n";
+    json += "  \"seconds\": " + std::to_string(config.seconds) + ",\n";
+    json += "  \"repetitions\": " + std::to_string(config.repetitions) + ",\n";
+    json += "  \"results\": [\n";
+    std::vector<benchmark_record_t> const &records = bench_records();
+    for (std::size_t i = 0; i != records.size(); ++i) {
+        benchmark_record_t const &record = records[i];
+        benchmark_result_t const &results = record.results;
+        char numbers[512];
+        std::snprintf(numbers, sizeof(numbers),
+                      "\"gbps\": %.6f, \"gbps_stddev\": %.6f, \"ns_per_op\": %.3f, \"iterations\": %zu, "
+                      "\"failures\": %zu, \"repetitions\": %zu",
+                      results.gbps(), results.gbps_stddev, results.ns_per_op(), results.iterations, record.failures,
+                      results.repetitions);
+        json += "    {\"section\": \"" + json_escape(record.section) + "\", \"name\": \"" + json_escape(record.name) +
+                "\", " + numbers;
+        perf_counters_t const &counters = results.counters;
+        if (counters.valid) {
+            std::snprintf(numbers, sizeof(numbers),
+                          ", \"cycles\": %llu, \"instructions\": %llu, \"ipc\": %.3f, \"ghz\": %.3f, "
+                          "\"l1d_misses\": %llu, \"llc_misses\": %llu",
+                          (unsigned long long)counters.cycles, (unsigned long long)counters.instructions,
+                          counters.ipc(), counters.ghz(), (unsigned long long)counters.l1d_misses,
+                          (unsigned long long)counters.llc_misses);
+            json += numbers;
+        }
+        json += i + 1 == records.size() ? "}\n" : "},\n";
+    }
+    json += "  ]\n}\n";
+    write_file(path, json);
+}
+
+inline void export_csv(std::string const &path) {
+    std::string csv = "section,name,gbps,gbps_stddev,ns_per_op,iterations,failures,repetitions,"
+                      "cycles,instructions,ipc,ghz,l1d_misses,llc_misses\n";
+    for (benchmark_record_t const &record : bench_records()) {
+        benchmark_result_t const &results = record.results;
+        perf_counters_t const &counters = results.counters;
+        char numbers[512];
+        std::snprintf(numbers, sizeof(numbers), ",%.6f,%.6f,%.3f,%zu,%zu,%zu,%llu,%llu,%.3f,%.3f,%llu,%llu\n",
+                      results.gbps(), results.gbps_stddev, results.ns_per_op(), results.iterations, record.failures,
+                      results.repetitions, (unsigned long long)counters.cycles,
+                      (unsigned long long)counters.instructions, counters.ipc(), counters.ghz(),
+                      (unsigned long long)counters.l1d_misses, (unsigned long long)counters.llc_misses);
+        csv += csv_escape(record.section) + "," + csv_escape(record.name) + numbers;
+    }
+    write_file(path, csv);
+}
+
+/**
+ *  @brief  Compares the current results against the baseline, matching them by section and name.
+ *  @return Number of variants, where the throughput dropped by more than `bench_config().threshold`.
+ */
+inline std::size_t compare_with_baseline(std::string const &path) {
+    std::vector<benchmark_record_t> baseline = load_baseline(path);
+    double const threshold = bench_config().threshold;
+    std::size_t regressions = 0, matched = 0;
+    std::printf("Comparing against %zu baseline results from %s:\n", baseline.size(), path.c_str());
+    for (benchmark_record_t const &record : bench_records()) {
+        auto it = std::find_if(baseline.begin(), baseline.end(), [&](benchmark_record_t const &old) {
+            return old.section == record.section && old.name == record.name;
+        });
+        if (it == baseline.end() || it->baseline_gbps <= 0) continue;
+        ++matched;
+        double const change = record.results.gbps() / it->baseline_gbps - 1;
+        if (change >= -threshold && change <= threshold) continue;
+        bool const is_regression = change < -threshold;
+        regressions += is_regression;
+        std::printf("- %-10s %-20s %10.4f GB/s vs %10.4f GB/s (%+.1f%%) in \"%s\"\n",
+                    is_regression ? "REGRESSION" : "IMPROVED", record.name.c_str(), record.results.gbps(),
+                    it->baseline_gbps, change * 100, record.section.c_str());
+    }
+    std::printf("Matched %zu results, found %zu regressions beyond %.1f%%.\n", matched, regressions, threshold * 100);
+    return regressions;
+}
+
+/**
+ *  @brief  Exports the collected results and compares them against the baseline, if requested.
+ *  @return Process exit code, non-zero if regressions were detected.
+ */
+inline int finalize_benchmarks() {
+    bench_config_t const &config = bench_config();
+    if (!config.json_path.empty()) export_json(config.json_path);
+    if (!config.csv_path.empty()) export_csv(config.csv_path);
+    if (!config.compare_path.empty() && compare_with_baseline(config.compare_path)) return 1;
+    return 0;
+}
+
 } // namespace scripts
 } // namespace stringzilla
 } // namespace ashvardanian
\ No newline at end of file
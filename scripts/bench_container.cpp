@@ -5,7 +5,7 @@
  *  This file is the sibling of `bench_sort.cpp`, `bench_search.cpp` and `bench_token.cpp`.
  *  It accepts a file with a list of words, constructs associative containers with string keys,
  *  using `std::string`, `std::string_view`, `sz::string_view`, and `sz::string`, and then
- *  evaluates the latency of lookups.
+ *  evaluates the latency of lookups, comparing them to the open-addressing `sz::flat_map`.
  */
 #include <map>
 #include <unordered_map>
@@ -45,6 +45,68 @@ void bench(std::string name, std::vector<std::string_view> const &strings) {
     variant.print();
 }
 
+/**
+ *  @brief  Evaluation for hashing all keys at once, as done in hash-joins or when building hash-tables.
+ */
+template <typename function_type>
+void bench_hashing(std::string name, std::vector<std::string_view> const &strings, function_type &&function) {
+
+    std::vector<sz_u64_t> hashes(strings.size());
+    std::size_t bytes_per_pass = 0;
+    for (std::string_view const &str : strings) bytes_per_pass += str.size();
+
+    tracked_function_gt<unary_function_t> variant;
+    variant.name = name;
+    variant.results = bench_repeatedly([&](benchmark_result_t &result) {
+        function(strings, hashes.data());
+        do_not_optimize(hashes.front());
+        result.iterations += strings.size();
+        result.bytes_passed += bytes_per_pass;
+    });
+    variant.print();
+}
+
+void bench_hashing(std::vector<std::string_view> const &strings) {
+    if (strings.size() == 0) return;
+
+    using strings_t = std::vector<std::string_view>;
+    auto for_each = [](sz_hash_t hash) {
+        return [hash](strings_t const &strings, sz_u64_t *hashes) {
+            for (std::size_t i = 0; i != strings.size(); ++i) hashes[i] = hash(strings[i].data(), strings[i].size());
+        };
+    };
+    auto batched = [](sz_hash_batch_t hash_batch) {
+        return [hash_batch](strings_t const &strings, sz_u64_t *hashes) {
+            sz_sequence_t sequence;
+            sequence.order = NULL;
+            sequence.count = strings.size();
+            sequence.handle = &strings;
+            sequence.get_start = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_cptr_t {
+                return (*reinterpret_cast<strings_t const *>(sequence->handle))[i].data();
+            };
+            sequence.get_length = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_size_t {
+                return (*reinterpret_cast<strings_t const *>(sequence->handle))[i].size();
+            };
+            hash_batch(&sequence, hashes);
+        };
+    };
+
+    bench_hashing("std::hash", strings, [](strings_t const &strings, sz_u64_t *hashes) {
+        for (std::size_t i = 0; i != strings.size(); ++i) hashes[i] = std::hash<std::string_view> {}(strings[i]);
+    });
+    bench_hashing("sz_hash", strings, for_each(sz_hash));
+    bench_hashing("sz_hash_batch_serial", strings, batched(sz_hash_batch_serial));
+#if SZ_USE_X86_AVX2
+    bench_hashing("sz_hash_batch_avx2", strings, batched(sz_hash_batch_avx2));
+#endif
+#if SZ_USE_X86_AVX512
+    bench_hashing("sz_hash_batch_avx512", strings, batched(sz_hash_batch_avx512));
+#endif
+#if SZ_USE_ARM_NEON
+    bench_hashing("sz_hash_batch_neon", strings, batched(sz_hash_batch_neon));
+#endif
+}
+
 template <typename strings_type>
 void bench_tokens(strings_type const &strings) {
     if (strings.size() == 0) return;
@@ -55,6 +117,7 @@ void bench_tokens(strings_type const &strings) {
     bench<std::map<sz::string_view, int>>("map<sz::string_view>", s);
     bench<std::unordered_map<sz::string, int>>("unordered_map<sz::string>", s);
     bench<std::unordered_map<sz::string_view, int>>("unordered_map<sz::string_view>", s);
+    bench<sz::flat_map<int>>("sz::flat_map", s);
 
     // Pure STL
     bench<std::map<std::string, int>>("map<std::string>", s);
@@ -75,15 +138,18 @@ int main(int argc, char const **argv) {
     dataset_t dataset = make_dataset(argc, argv);
 
     // Baseline benchmarks for real words, coming in all lengths
-    std::printf("Benchmarking on real words:\n");
+    begin_section("Benchmarking on real words:");
+    bench_hashing(dataset.tokens);
     bench_tokens(dataset.tokens);
 
     // Run benchmarks on tokens of different length
     for (std::size_t token_length : {1, 2, 3, 4, 5, 6, 7, 8, 16, 32}) {
-        std::printf("Benchmarking on real words of length %zu:\n", token_length);
-        bench_tokens(filter_by_length(dataset.tokens, token_length));
+        begin_section("Benchmarking on real words of length %zu:", token_length);
+        std::vector<std::string_view> tokens = filter_by_length(dataset.tokens, token_length);
+        bench_hashing(tokens);
+        bench_tokens(tokens);
     }
 
     std::printf("All benchmarks passed.\n");
-    return 0;
+    return finalize_benchmarks();
 }
\ No newline at end of file
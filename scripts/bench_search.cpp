@@ -290,46 +290,46 @@ int main(int argc, char const **argv) {
     dataset_t dataset = make_dataset(argc, argv);
 
     // Splitting by new lines
-    std::printf("Benchmarking for a newline symbol:\n");
+    begin_section("Benchmarking for a newline symbol:");
     bench_finds(dataset.text, {"\n"}, find_functions());
     bench_rfinds(dataset.text, {"\n"}, rfind_functions());
 
-    std::printf("Benchmarking for an [\\n\\r] RegEx:\n");
+    begin_section("Benchmarking for an [\\n\\r] RegEx:");
     bench_finds(dataset.text, {sz::newlines()}, find_charset_functions());
     bench_rfinds(dataset.text, {sz::newlines()}, rfind_charset_functions());
 
     // Typical ASCII tokenization and validation benchmarks
-    std::printf("Benchmarking for whitespaces:\n");
+    begin_section("Benchmarking for whitespaces:");
     bench_finds(dataset.text, {sz::whitespaces()}, find_charset_functions());
     bench_rfinds(dataset.text, {sz::whitespaces()}, rfind_charset_functions());
 
-    std::printf("Benchmarking for HTML tag start/end:\n");
+    begin_section("Benchmarking for HTML tag start/end:");
     bench_finds(dataset.text, {"<>"}, find_charset_functions());
     bench_rfinds(dataset.text, {"<>"}, rfind_charset_functions());
 
-    std::printf("Benchmarking for punctuation marks:\n");
+    begin_section("Benchmarking for punctuation marks:");
     bench_finds(dataset.text, {sz::punctuation()}, find_charset_functions());
     bench_rfinds(dataset.text, {sz::punctuation()}, rfind_charset_functions());
 
-    std::printf("Benchmarking for non-printable characters:\n");
+    begin_section("Benchmarking for non-printable characters:");
     bench_finds(dataset.text, {sz::ascii_controls()}, find_charset_functions());
     bench_rfinds(dataset.text, {sz::ascii_controls()}, rfind_charset_functions());
 
     // Baseline benchmarks for present tokens, coming in all lengths
-    std::printf("Benchmarking on present lines:\n");
+    begin_section("Benchmarking on present lines:");
     bench_search(dataset.text, {dataset.lines.begin(), dataset.lines.end()});
-    std::printf("Benchmarking on present tokens:\n");
+    begin_section("Benchmarking on present tokens:");
     bench_search(dataset.text, {dataset.tokens.begin(), dataset.tokens.end()});
 
     // Run benchmarks on tokens of different length
     for (std::size_t token_length : {1, 2, 3, 4, 5, 6, 7, 8, 16, 32}) {
-        std::printf("Benchmarking on present tokens of length %zu:\n", token_length);
+        begin_section("Benchmarking on present tokens of length %zu:", token_length);
         bench_search(dataset.text, filter_by_length<std::string>(dataset.tokens, token_length));
     }
 
     // Run bechnmarks on abstract tokens of different length
     for (std::size_t token_length : {1, 2, 3, 4, 5, 6, 7, 8, 16, 32}) {
-        std::printf("Benchmarking for missing tokens of length %zu:\n", token_length);
+        begin_section("Benchmarking for missing tokens of length %zu:", token_length);
         bench_search(dataset.text, std::vector<std::string> {
                                        std::string(token_length, '\1'),
                                        std::string(token_length, '\2'),
@@ -339,5 +339,5 @@ int main(int argc, char const **argv) {
     }
 
     std::printf("All benchmarks passed.\n");
-    return 0;
+    return finalize_benchmarks();
 }
\ No newline at end of file
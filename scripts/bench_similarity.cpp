@@ -5,6 +5,7 @@
  *  This file is the sibling of `bench_sort.cpp`, `bench_search.cpp` and `bench_token.cpp`.
  *  It accepts a file with a list of words, and benchmarks the levenshtein edit-distance computations,
  *  alignment scores, and fingerprinting techniques combined with the Hamming distance.
+ *  It also compares one-to-many edit distances between every query and the whole dataset, batched and not.
  */
 #include <bench.hpp>
 #include <test.hpp> // `levenshtein_baseline`, `unary_substitution_costs`
@@ -54,18 +55,105 @@ tracked_binary_functions_t distance_functions() {
         {"naive", wrap_baseline},
         {"sz_edit_distance", wrap_sz_distance(sz_edit_distance_serial), true},
         {"sz_alignment_score", wrap_sz_scoring(sz_alignment_score_serial), true},
+#if SZ_USE_X86_AVX2
+        {"sz_alignment_score_avx2", wrap_sz_scoring(sz_alignment_score_avx2), true},
+#endif
 #if SZ_USE_X86_AVX512
         {"sz_edit_distance_avx512", wrap_sz_distance(sz_edit_distance_avx512), true},
         {"sz_alignment_score_avx512", wrap_sz_scoring(sz_alignment_score_avx512), true},
+#endif
+#if SZ_USE_ARM_NEON
+        {"sz_alignment_score_neon", wrap_sz_scoring(sz_alignment_score_neon), true},
 #endif
     };
     return result;
 }
 
+/**
+ *  @brief  Evaluation for one-to-many edit distances, as in fuzzy lookups of a query in a dictionary.
+ *          Every pass compares the next string from the dataset against all of them.
+ */
+template <typename function_type>
+void bench_one_to_many(std::string name, std::vector<std::string_view> const &strings, sz_size_t bound,
+                       function_type &&function) {
+
+    std::vector<sz_size_t> distances(strings.size()), expected(strings.size());
+    std::size_t bytes_per_pass = 0;
+    for (std::string_view const &str : strings) bytes_per_pass += str.size();
+
+    // Validate the results against the pairwise computation before timing
+    tracked_function_gt<binary_function_t> variant;
+    variant.name = name;
+    function(strings.front(), strings, bound, distances.data());
+    for (std::size_t i = 0; i != strings.size(); ++i)
+        expected[i] = sz_edit_distance_serial(strings.front().data(), strings.front().size(), strings[i].data(),
+                                              strings[i].size(), bound, NULL);
+    variant.failed_count = distances != expected;
+
+    std::size_t query_index = 0;
+    variant.results = bench_repeatedly([&](benchmark_result_t &result) {
+        function(strings[query_index++ % strings.size()], strings, bound, distances.data());
+        do_not_optimize(distances.front());
+        result.iterations += strings.size();
+        result.bytes_passed += bytes_per_pass;
+    });
+    variant.print();
+}
+
+template <typename strings_at>
+void bench_one_to_many(strings_at const &strings_original) {
+    if (strings_original.size() == 0) return;
+
+    using strings_t = std::vector<std::string_view>;
+    strings_t strings(strings_original.begin(), strings_original.end());
+    sz_memory_allocator_t alloc;
+    alloc.allocate = &allocate_from_vector;
+    alloc.free = &free_from_vector;
+    alloc.handle = &temporary_memory;
+
+    auto pairwise = [alloc](sz_edit_distance_t edit_distance) mutable {
+        return [alloc, edit_distance](std::string_view query, strings_t const &strings, sz_size_t bound,
+                                      sz_size_t *distances) mutable {
+            for (std::size_t i = 0; i != strings.size(); ++i)
+                distances[i] = edit_distance(query.data(), query.size(), strings[i].data(), strings[i].size(), bound,
+                                             &alloc);
+        };
+    };
+    auto batched = [alloc](sz_edit_distances_batch_t edit_distances_batch) mutable {
+        return [alloc, edit_distances_batch](std::string_view query, strings_t const &strings, sz_size_t bound,
+                                             sz_size_t *distances) mutable {
+            sz_sequence_t sequence;
+            sequence.order = NULL;
+            sequence.count = strings.size();
+            sequence.handle = &strings;
+            sequence.get_start = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_cptr_t {
+                return (*reinterpret_cast<strings_t const *>(sequence->handle))[i].data();
+            };
+            sequence.get_length = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_size_t {
+                return (*reinterpret_cast<strings_t const *>(sequence->handle))[i].size();
+            };
+            edit_distances_batch(query.data(), query.size(), &sequence, bound, distances, &alloc);
+        };
+    };
+
+    for (sz_size_t bound : {0, 3}) {
+        std::string suffix = bound ? " bound=" + std::to_string(bound) : "";
+        bench_one_to_many("sz_edit_distance" + suffix, strings, bound, pairwise(sz_edit_distance_serial));
+        bench_one_to_many("sz_edit_distances_batch" + suffix, strings, bound,
+                          batched(sz_edit_distances_batch_serial));
+#if SZ_USE_X86_AVX512
+        bench_one_to_many("sz_edit_distance_avx512" + suffix, strings, bound, pairwise(sz_edit_distance_avx512));
+        bench_one_to_many("sz_edit_distances_batch_avx512" + suffix, strings, bound,
+                          batched(sz_edit_distances_batch_avx512));
+#endif
+    }
+}
+
 template <typename strings_at>
 void bench_similarity(strings_at &&strings) {
     if (strings.size() == 0) return;
     bench_binary_functions(strings, distance_functions());
+    bench_one_to_many(strings);
 }
 
 void bench_similarity_on_bio_data() {
@@ -99,23 +187,23 @@ void bench_similarity_on_bio_data() {
             proteins.push_back(protein);
         }
 
-        std::printf("Benchmarking on protein-like sequences with %s:\n", bio_case.name);
+        begin_section("Benchmarking on protein-like sequences with %s:", bio_case.name);
         bench_similarity(proteins);
         proteins.clear();
     }
 }
 
-void bench_similarity_on_input_data(int argc, char const **argv) {
+void bench_similarity_on_input_data() {
 
-    dataset_t dataset = make_dataset(argc, argv);
+    dataset_t dataset = make_dataset_from_path(bench_config().dataset_path);
 
     // Baseline benchmarks for real words, coming in all lengths
-    std::printf("Benchmarking on real words:\n");
+    begin_section("Benchmarking on real words:");
     bench_similarity(dataset.tokens);
 
     // Run benchmarks on tokens of different length
     for (std::size_t token_length : {20}) {
-        std::printf("Benchmarking on real words of length %zu and longer:\n", token_length);
+        begin_section("Benchmarking on real words of length %zu and longer:", token_length);
         bench_similarity(filter_by_length(dataset.tokens, token_length, std::greater_equal<std::size_t> {}));
     }
 }
@@ -123,9 +211,10 @@ void bench_similarity_on_input_data(int argc, char const **argv) {
 int main(int argc, char const **argv) {
     std::printf("StringZilla. Starting similarity benchmarks.\n");
 
-    if (argc < 2) { bench_similarity_on_bio_data(); }
-    else { bench_similarity_on_input_data(argc, argv); }
+    parse_bench_config(argc, argv, false);
+    if (bench_config().dataset_path.empty()) { bench_similarity_on_bio_data(); }
+    else { bench_similarity_on_input_data(); }
 
     std::printf("All benchmarks passed.\n");
-    return 0;
+    return finalize_benchmarks();
 }
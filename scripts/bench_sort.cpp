@@ -62,7 +62,7 @@ void populate_from_file(std::string path, strings_t &strings,
     while (strings.size() < limit && std::getline(f, s, ' ')) strings.push_back(s);
 }
 
-constexpr size_t offset_in_word = 0;
+constexpr size_t offset_in_word = 4;
 
 static idx_t hybrid_sort_cpp(strings_t const &strings, sz_u64_t *order) {
 
@@ -125,19 +125,34 @@ void bench_permute(char const *name, strings_t &strings, permute_t &permute, alg
     namespace stdc = std::chrono;
     using stdcc = stdc::high_resolution_clock;
     constexpr std::size_t iterations = 3;
-    stdcc::time_point t1 = stdcc::now();
+    std::size_t bytes_per_pass = 0;
+    for (std::string const &str : strings) bytes_per_pass += str.size();
 
-    // Run multiple iterations
+    // Run multiple iterations, timing each of them separately, excluding the permutation reset
+    benchmark_result_t total;
+    std::vector<double> milisecs(iterations);
     for (std::size_t i = 0; i != iterations; ++i) {
         std::iota(permute.begin(), permute.end(), 0);
+        perf_group_t counters;
+        stdcc::time_point t1 = stdcc::now();
         algo(strings, permute);
+        stdcc::time_point t2 = stdcc::now();
+        total.counters += counters.stop();
+        milisecs[i] = stdc::duration_cast<stdc::nanoseconds>(t2 - t1).count() / 1e6;
+        total.seconds += milisecs[i] / 1e3;
+        total.iterations += strings.size();
+        total.bytes_passed += bytes_per_pass;
     }
 
-    // Measure elapsed time
-    stdcc::time_point t2 = stdcc::now();
-    double dif = stdc::duration_cast<stdc::nanoseconds>(t2 - t1).count();
-    double milisecs = dif / (iterations * 1e6);
-    std::printf("Elapsed time is %.2lf miliseconds/iteration for %s.\n", milisecs, name);
+    // Report the mean and the spread of the throughput across iterations
+    double mean = total.seconds * 1e3 / iterations, variance = 0;
+    for (double elapsed : milisecs)
+        variance += (bytes_per_pass / elapsed / 1e6 - total.gbps()) * (bytes_per_pass / elapsed / 1e6 - total.gbps());
+    total.repetitions = iterations;
+    total.gbps_stddev = std::sqrt(variance / (iterations - 1));
+    std::printf("Elapsed time is %.2lf miliseconds/iteration for %s.\n", mean, name);
+    print_details(total);
+    record_result(name, total);
 }
 
 int main(int argc, char const **argv) {
@@ -151,7 +166,7 @@ int main(int argc, char const **argv) {
 
     // Partitioning
     {
-        std::printf("---- Partitioning:\n");
+        begin_section("---- Partitioning:");
         bench_permute("std::partition", strings, permute_base, [](strings_t const &strings, permute_t &permute) {
             std::partition(permute.begin(), permute.end(), [&](size_t i) { return strings[i].size() < 4; });
         });
@@ -175,7 +190,7 @@ int main(int argc, char const **argv) {
 
     // Sorting
     {
-        std::printf("---- Sorting:\n");
+        begin_section("---- Sorting:");
         bench_permute("std::sort", strings, permute_base, [](strings_t const &strings, permute_t &permute) {
             std::sort(permute.begin(), permute.end(), [&](idx_t i, idx_t j) { return strings[i] < strings[j]; });
         });
@@ -211,18 +226,68 @@ int main(int argc, char const **argv) {
                       [](strings_t const &strings, permute_t &permute) { hybrid_sort_cpp(strings, permute.data()); });
         expect_sorted(strings, permute_new);
 
-        std::printf("---- Stable Sorting:\n");
+        begin_section("---- Stable Sorting:");
         bench_permute("std::stable_sort", strings, permute_base, [](strings_t const &strings, permute_t &permute) {
             std::stable_sort(permute.begin(), permute.end(), [&](idx_t i, idx_t j) { return strings[i] < strings[j]; });
         });
         expect_sorted(strings, permute_base);
 
+        bench_permute("sz_sort_stable", strings, permute_new, [](strings_t const &strings, permute_t &permute) {
+            sz_sequence_t array;
+            array.order = permute.data();
+            array.count = strings.size();
+            array.handle = &strings;
+            array.get_start = get_start;
+            array.get_length = get_length;
+            sz_sort_stable(&array, NULL);
+        });
+        expect_sorted(strings, permute_new);
+        expect_same(permute_base, permute_new);
+
         bench_permute(
-            "hybrid_stable_sort_cpp", strings, permute_base,
+            "hybrid_stable_sort_cpp", strings, permute_new,
             [](strings_t const &strings, permute_t &permute) { hybrid_stable_sort_cpp(strings, permute.data()); });
         expect_sorted(strings, permute_new);
         expect_same(permute_base, permute_new);
     }
 
-    return 0;
+    // Sorting strings with long shared prefixes, like URLs, where the first 4 bytes carry no information
+    {
+        begin_section("---- Stable Sorting with Shared Prefixes:");
+        strings_t prefixed_strings(strings.size());
+        for (std::size_t i = 0; i != strings.size(); ++i) prefixed_strings[i] = "https://www." + strings[i];
+
+        bench_permute("std::stable_sort", prefixed_strings, permute_base,
+                      [](strings_t const &strings, permute_t &permute) {
+                          std::stable_sort(permute.begin(), permute.end(),
+                                           [&](idx_t i, idx_t j) { return strings[i] < strings[j]; });
+                      });
+        expect_sorted(prefixed_strings, permute_base);
+
+        bench_permute("sz_sort", prefixed_strings, permute_new, [](strings_t const &strings, permute_t &permute) {
+            sz_sequence_t array;
+            array.order = permute.data();
+            array.count = strings.size();
+            array.handle = &strings;
+            array.get_start = get_start;
+            array.get_length = get_length;
+            sz_sort(&array);
+        });
+        expect_sorted(prefixed_strings, permute_new);
+
+        bench_permute("sz_sort_stable", prefixed_strings, permute_new,
+                      [](strings_t const &strings, permute_t &permute) {
+                          sz_sequence_t array;
+                          array.order = permute.data();
+                          array.count = strings.size();
+                          array.handle = &strings;
+                          array.get_start = get_start;
+                          array.get_length = get_length;
+                          sz_sort_stable(&array, NULL);
+                      });
+        expect_sorted(prefixed_strings, permute_new);
+        expect_same(permute_base, permute_new);
+    }
+
+    return finalize_benchmarks();
 }
\ No newline at end of file
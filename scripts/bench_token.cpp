@@ -4,6 +4,8 @@
  *
  *  This file is the sibling of `bench_sort.cpp`, `bench_search.cpp` and `bench_similarity.cpp`.
  */
+#include <cctype> // `std::tolower`
+
 #include <bench.hpp>
 #include <test.hpp> // `random_string`
 
@@ -90,6 +92,80 @@ tracked_unary_functions_t random_generation_functions(std::size_t token_length)
     return result;
 }
 
+tracked_unary_functions_t case_conversion_functions() {
+    static std::vector<char> buffer;
+    auto wrap_sz = [](auto function) -> unary_function_t {
+        return unary_function_t([function](std::string_view s) {
+            if (buffer.size() < s.size()) buffer.resize(s.size());
+            function(s.data(), s.size(), buffer.data());
+            return s.size();
+        });
+    };
+    tracked_unary_functions_t result = {
+        {"std::tolower",
+         unary_function_t([](std::string_view s) {
+             if (buffer.size() < s.size()) buffer.resize(s.size());
+             std::transform(s.begin(), s.end(), buffer.begin(), [](char c) { return (char)std::tolower(c); });
+             return s.size();
+         })},
+        {"sz_tolower_serial", wrap_sz(sz_tolower_serial)},
+#if SZ_USE_X86_AVX512
+        {"sz_tolower_avx512", wrap_sz(sz_tolower_avx512)},
+#endif
+#if SZ_USE_X86_AVX2
+        {"sz_tolower_avx2", wrap_sz(sz_tolower_avx2)},
+#endif
+#if SZ_USE_ARM_NEON
+        {"sz_tolower_neon", wrap_sz(sz_tolower_neon)},
+#endif
+        {"sz_isascii_serial", [](std::string_view s) { return sz_isascii_serial(s.data(), s.size()); }},
+#if SZ_USE_X86_AVX512
+        {"sz_isascii_avx512", [](std::string_view s) { return sz_isascii_avx512(s.data(), s.size()); }},
+#endif
+#if SZ_USE_X86_AVX2
+        {"sz_isascii_avx2", [](std::string_view s) { return sz_isascii_avx2(s.data(), s.size()); }},
+#endif
+#if SZ_USE_ARM_NEON
+        {"sz_isascii_neon", [](std::string_view s) { return sz_isascii_neon(s.data(), s.size()); }},
+#endif
+    };
+    return result;
+}
+
+tracked_unary_functions_t utf8_functions() {
+    static std::vector<sz_rune_t> runes;
+    auto wrap_sz = [](auto function) -> unary_function_t {
+        return unary_function_t([function](std::string_view s) {
+            if (runes.size() < s.size()) runes.resize(s.size());
+            return function(s.data(), s.size(), runes.data());
+        });
+    };
+    tracked_unary_functions_t result = {
+        {"sz_utf8_valid_serial", [](std::string_view s) { return sz_utf8_valid_serial(s.data(), s.size()); }},
+#if SZ_USE_X86_AVX512
+        {"sz_utf8_valid_avx512", [](std::string_view s) { return sz_utf8_valid_avx512(s.data(), s.size()); }},
+#endif
+#if SZ_USE_ARM_NEON
+        {"sz_utf8_valid_neon", [](std::string_view s) { return sz_utf8_valid_neon(s.data(), s.size()); }},
+#endif
+        {"sz_utf8_count_serial", [](std::string_view s) { return sz_utf8_count_serial(s.data(), s.size()); }},
+#if SZ_USE_X86_AVX512
+        {"sz_utf8_count_avx512", [](std::string_view s) { return sz_utf8_count_avx512(s.data(), s.size()); }},
+#endif
+#if SZ_USE_ARM_NEON
+        {"sz_utf8_count_neon", [](std::string_view s) { return sz_utf8_count_neon(s.data(), s.size()); }},
+#endif
+        {"sz_utf8_to_utf32_serial", wrap_sz(sz_utf8_to_utf32_serial)},
+#if SZ_USE_X86_AVX512
+        {"sz_utf8_to_utf32_avx512", wrap_sz(sz_utf8_to_utf32_avx512)},
+#endif
+#if SZ_USE_ARM_NEON
+        {"sz_utf8_to_utf32_neon", wrap_sz(sz_utf8_to_utf32_neon)},
+#endif
+    };
+    return result;
+}
+
 tracked_binary_functions_t equality_functions() {
     auto wrap_sz = [](auto function) -> binary_function_t {
         return binary_function_t([function](std::string_view a, std::string_view b) {
@@ -147,6 +223,8 @@ void bench(strings_type &&strings) {
 
     // Benchmark logical operations
     bench_unary_functions(strings, hashing_functions());
+    bench_unary_functions(strings, case_conversion_functions());
+    bench_unary_functions(strings, utf8_functions());
     bench_unary_functions(strings, sliding_hashing_functions(8, 1));
     bench_unary_functions(strings, fingerprinting_functions());
     bench_binary_functions(strings, equality_functions());
@@ -160,10 +238,10 @@ void bench(strings_type &&strings) {
     bench_dereferencing<sz::string>("sz::string -> std::string_view", {strings.begin(), strings.end()});
 }
 
-void bench_on_input_data(int argc, char const **argv) {
-    dataset_t dataset = make_dataset(argc, argv);
+void bench_on_input_data() {
+    dataset_t dataset = make_dataset_from_path(bench_config().dataset_path);
 
-    std::printf("Benchmarking on the entire dataset:\n");
+    begin_section("Benchmarking on the entire dataset:");
     bench_unary_functions(dataset.tokens, random_generation_functions(100));
     bench_unary_functions(dataset.tokens, random_generation_functions(20));
     bench_unary_functions(dataset.tokens, random_generation_functions(5));
@@ -180,18 +258,20 @@ void bench_on_input_data(int argc, char const **argv) {
     bench_unary_functions<std::vector<std::string_view>>({dataset.text}, sliding_hashing_functions(127, 16));
 
     bench_unary_functions<std::vector<std::string_view>>({dataset.text}, hashing_functions());
+    bench_unary_functions<std::vector<std::string_view>>({dataset.text}, case_conversion_functions());
+    bench_unary_functions<std::vector<std::string_view>>({dataset.text}, utf8_functions());
 
     bench_unary_functions<std::vector<std::string_view>>({dataset.text}, fingerprinting_functions(128, 4 * 1024));
     bench_unary_functions<std::vector<std::string_view>>({dataset.text}, fingerprinting_functions(128, 64 * 1024));
     bench_unary_functions<std::vector<std::string_view>>({dataset.text}, fingerprinting_functions(128, 1024 * 1024));
 
     // Baseline benchmarks for real words, coming in all lengths
-    std::printf("Benchmarking on real words:\n");
+    begin_section("Benchmarking on real words:");
     bench(dataset.tokens);
 
     // Run benchmarks on tokens of different length
     for (std::size_t token_length : {1, 2, 3, 4, 5, 6, 7, 8, 16, 32}) {
-        std::printf("Benchmarking on real words of length %zu:\n", token_length);
+        begin_section("Benchmarking on real words of length %zu:", token_length);
         bench(filter_by_length(dataset.tokens, token_length));
     }
 }
@@ -203,9 +283,10 @@ void bench_on_synthetic_data() {
 int main(int argc, char const **argv) {
     std::printf("StringZilla. Starting token-level benchmarks.\n");
 
-    if (argc < 2) { bench_on_synthetic_data(); }
-    else { bench_on_input_data(argc, argv); }
+    parse_bench_config(argc, argv, false);
+    if (bench_config().dataset_path.empty()) { bench_on_synthetic_data(); }
+    else { bench_on_input_data(); }
 
     std::printf("All benchmarks passed.\n");
-    return 0;
+    return finalize_benchmarks();
 }
\ No newline at end of file
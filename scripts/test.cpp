@@ -5,14 +5,19 @@
 #include <sanitizer/asan_interface.h> // ASAN
 #endif
 
-#include <algorithm> // `std::transform`
-#include <cstdio>    // `std::printf`
-#include <cstring>   // `std::memcpy`
-#include <iterator>  // `std::distance`
-#include <memory>    // `std::allocator`
-#include <random>    // `std::random_device`
-#include <sstream>   // `std::ostringstream`
-#include <vector>    // `std::vector`
+#include <algorithm>  // `std::transform`
+#include <cstdio>     // `std::printf`
+#include <cstring>    // `std::memcpy`
+#include <functional> // `std::function`
+#include <iterator>   // `std::distance`
+#include <memory>     // `std::allocator`
+#include <numeric>    // `std::iota`
+#include <random>     // `std::random_device`
+#include <sstream>    // `std::ostringstream`
+#include <stdexcept>  // `std::length_error`
+#include <thread>     // `std::thread`
+#include <unordered_map> // `std::unordered_map`
+#include <vector>     // `std::vector`
 
 // Overload the following with caution.
 // Those parameters must never be explicitly set during releases,
@@ -22,6 +27,7 @@
 // #define SZ_USE_X86_AVX512 0
 // #define SZ_USE_ARM_NEON 0
 // #define SZ_USE_ARM_SVE 0
+// #define SZ_USE_ARM_SVE2 0
 #define SZ_DEBUG 1 // Enforce aggressive logging for this unit.
 
 #include <string>                      // Baseline
@@ -312,6 +318,7 @@ static void test_api_readonly() {
     assert(str("hello world").compare(0, 5, "hello Ash", 5) == 0); // Substring "hello" in both strings
     assert(str("hello world").compare(6, 5, "worlds", 5) == 0);    // Substring "world" in both strings
     assert(str("hello world").compare(6, 5, "worlds", 6) < 0);     // Substring "world" is less than "worlds"
+    assert(str("azz").compare(0, 1, str("a\0b", 3)) < 0);           // Substring "a" is a prefix of "a\0b"
 
 #if SZ_DETECT_CPP20 && __cpp_lib_starts_ends_with
     // Prefix and suffix checks against strings.
@@ -630,6 +637,37 @@ void test_api_mutable_extensions() {
     assert_scoped(str s = "hello", s.replace_all(sz::char_set("x"), "xx"), s == "hello");
     assert_scoped(str s = "hello", s.replace_all(sz::char_set("lo"), "lo"), s == "helololo");
 
+    // Multiple patterns in one pass, where at the same offset the first pattern wins.
+    assert_scoped(str s = "hello", s.replace_all({{"l", "L"}, {"o", "0"}}), s == "heLL0");
+    assert_scoped(str s = "hello", s.replace_all({{"x", "y"}}), s == "hello");
+    assert_scoped(str s = "hello", s.replace_all({{"hel", ""}, {"he", "HE"}}), s == "lo");
+    assert_scoped(str s = "hello", s.replace_all({{"he", "HE"}, {"hel", ""}}), s == "HEllo");
+    assert_scoped(str s = "hello", s.replace_all({{"h", "<h>"}, {"llo", ""}}), s == "<h>e");
+    assert_scoped(str s = "a&b<c>", s.replace_all({{"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}}),
+                  s == "a&amp;b&lt;c&gt;");
+    assert_scoped(str s = "hello", s.replace_all(sz::multi_pattern {"ll", "e"}, std::vector<str> {"_", "E"}),
+                  s == "hE_o");
+
+    // Compare against a naive baseline on random strings, with the patterns sharing prefixes and suffixes.
+    {
+        std::vector<std::string> patterns = {"ab", "b", "bca", "cc"}, replacements = {"<>", "", "BCA!", "c"};
+        sz::multi_pattern compiled(patterns);
+        for (std::size_t iteration = 0; iteration != 1000; ++iteration) {
+            std::string text(iteration % 100, 'a');
+            for (auto &c : text) c = "abc"[std::rand() % 3];
+            std::string expected;
+            for (std::size_t i = 0; i < text.size();) {
+                std::size_t id = 0;
+                while (id != patterns.size() && text.compare(i, patterns[id].size(), patterns[id]) != 0) ++id;
+                if (id == patterns.size()) { expected.push_back(text[i++]); }
+                else { expected += replacements[id], i += patterns[id].size(); }
+            }
+            str result = text.c_str();
+            result.replace_all(compiled, replacements);
+            assert(result == expected.c_str());
+        }
+    }
+
     // Concatenation.
     assert(str(str("a") | str("b")) == "ab");
     assert(str(str("a") | str("b") | str("ab")) == "abab");
@@ -778,6 +816,78 @@ static void test_memory_stability_for_length(std::size_t len = 1ull << 10) {
     assert(accounting_allocator::counter_ref() == 0);
 }
 
+/**
+ *  @brief  Tests the arena allocator, that chains growing chunks, and releases them all at once.
+ */
+static void test_memory_arena() {
+    // The chunks are taken from the accounting allocator, to check that none of them leak.
+    accounting_allocator upstream;
+    sz_memory_allocator_t upstream_alloc;
+    upstream_alloc.allocate = &sz::_call_allocate<accounting_allocator>;
+    upstream_alloc.free = &sz::_call_free<accounting_allocator>;
+    upstream_alloc.handle = &upstream;
+
+    sz_memory_arena_t arena;
+    sz_memory_arena_init(&arena, 256, &upstream_alloc);
+    sz_memory_allocator_t alloc;
+    sz_memory_allocator_init_arena(&alloc, &arena);
+    assert(accounting_allocator::counter_ref() == 0 && "Empty arenas don't allocate");
+
+    // Allocations are aligned, don't overlap, and can outgrow the chunk capacity
+    std::vector<char *> blocks;
+    for (std::size_t length = 1; length != 300; ++length) {
+        char *block = (char *)alloc.allocate(length, alloc.handle);
+        assert(block && reinterpret_cast<std::uintptr_t>(block) % sizeof(sz_size_t) == 0);
+        std::memset(block, (int)(length & 0xFF), length);
+        blocks.push_back(block);
+    }
+    for (std::size_t length = 1; length != 300; ++length) {
+        char expected = (char)(length & 0xFF);
+        assert(blocks[length - 1][0] == expected && blocks[length - 1][length - 1] == expected);
+    }
+
+    // Releasing the most recent allocation returns it to the arena
+    char *last = (char *)alloc.allocate(100, alloc.handle);
+    alloc.free(last, 100, alloc.handle);
+    assert(alloc.allocate(100, alloc.handle) == last);
+
+    // Resetting keeps only the largest chunk, that is reused for the following allocations
+    std::size_t chunks_capacity = accounting_allocator::counter_ref();
+    sz_memory_arena_reset(&arena);
+    std::size_t reused_capacity = accounting_allocator::counter_ref();
+    assert(reused_capacity < chunks_capacity && reused_capacity >= 256);
+    char *reused = (char *)alloc.allocate(64, alloc.handle);
+    assert(reused && accounting_allocator::counter_ref() == reused_capacity);
+
+    // The arena can also back the algorithms, that need a temporary buffer
+    assert(sz_edit_distance("kitten", 6, "sitting", 7, 0, &alloc) == 3);
+    sz_memory_arena_free(&arena);
+    assert(accounting_allocator::counter_ref() == 0);
+
+    // The C++ strings return their memory to the thread-local arena
+    {
+        std::vector<sz::arena_string> strings;
+        for (std::size_t i = 0; i != 1000; ++i) {
+            strings.emplace_back(100 + i % 50, (char)('a' + i % 26));
+            strings.back().append("-suffix-that-outgrows-the-small-string-optimization");
+        }
+        for (std::size_t i = 0; i != 1000; ++i) {
+            assert(strings[i].size() == 100 + i % 50 + 51);
+            assert(strings[i].front() == (char)('a' + i % 26) && strings[i].back() == 'n');
+        }
+        sz::arena_string copy = strings[7];
+        assert(copy == strings[7]);
+    }
+    sz::arena_allocator::reset();
+
+    // Stateful arenas can be used with the C allocator interface directly
+    sz::memory_arena scoped(1024);
+    sz_memory_allocator_t scoped_alloc = scoped.c_allocator();
+    assert(sz_edit_distance("kitten", 6, "sitting", 7, 0, &scoped_alloc) == 3);
+    assert(scoped.allocate(5000) != nullptr);
+    scoped.reset();
+}
+
 /**
  *  @brief  Tests the correctness of the string class update methods, such as `append` and `erase`.
  */
@@ -819,6 +929,481 @@ static void test_comparisons() {
     assert("a\0"_sz == "a\0"_sz);
 }
 
+/**
+ *  @brief  Tests the single-string and the batch hashing functions against a naive rolling-hash implementation.
+ */
+static void test_hashing() {
+    auto baseline = [](std::string const &text) -> sz_u64_t {
+        sz_u64_t const prime = 18446744073709551557ull, golden_ratio = 11400714819323198485ull;
+        sz_u64_t hash_low = 0, hash_high = 0;
+        for (char c : text) {
+            sz_u8_t byte = static_cast<sz_u8_t>(c);
+            hash_low = (hash_low * 31ull + byte) % prime;
+            hash_high = (hash_high * 257ull + ((byte + 77ull) & 0xFFull)) % prime;
+        }
+        return (hash_low * golden_ratio) ^ (hash_high * golden_ratio);
+    };
+
+    // Strings of all lengths up to a few words, including the empty one, with an odd count to exercise the tails.
+    std::vector<std::string> strings;
+    for (std::size_t length = 0; length != 77; ++length)
+        for (std::size_t repeat = 0; repeat != 3; ++repeat)
+            strings.push_back(sz::scripts::random_string(length, "abc\xFF\x80\0", 6));
+
+    for (std::string const &text : strings) {
+        assert(sz_hash_serial(text.data(), text.size()) == baseline(text));
+        assert(sz_hash(text.data(), text.size()) == baseline(text));
+        assert(sz::string_view(text.data(), text.size()).hash() == baseline(text));
+    }
+
+    sz_sequence_t sequence;
+    sequence.order = NULL;
+    sequence.count = strings.size();
+    sequence.handle = &strings;
+    sequence.get_start = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_cptr_t {
+        return (*reinterpret_cast<std::vector<std::string> const *>(sequence->handle))[i].data();
+    };
+    sequence.get_length = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_size_t {
+        return (*reinterpret_cast<std::vector<std::string> const *>(sequence->handle))[i].size();
+    };
+    auto check_batch = [&](sz_hash_batch_t hash_batch) {
+        std::vector<sz_u64_t> hashes(strings.size());
+        hash_batch(&sequence, hashes.data());
+        for (std::size_t i = 0; i != strings.size(); ++i) assert(hashes[i] == baseline(strings[i]));
+    };
+    check_batch(sz_hash_batch);
+    check_batch(sz_hash_batch_serial);
+#if SZ_USE_X86_AVX2
+    check_batch(sz_hash_batch_avx2);
+#endif
+#if SZ_USE_X86_AVX512
+    check_batch(sz_hash_batch_avx512);
+#endif
+#if SZ_USE_ARM_NEON
+    check_batch(sz_hash_batch_neon);
+#endif
+
+    // The rolling hashes may slice the text differently and report the overlapping windows twice,
+    // but the set of the distinct hashes must match the serial one.
+    auto rolling_hashes = [](sz_hashes_t hashes, std::string const &text, std::size_t window_length) {
+        std::vector<sz_u64_t> result;
+        hashes(
+            text.data(), text.size(), window_length, 1,
+            [](sz_cptr_t, sz_size_t, sz_u64_t hash, void *handle) {
+                reinterpret_cast<std::vector<sz_u64_t> *>(handle)->push_back(hash);
+            },
+            &result);
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    };
+    auto check_rolling = [&](sz_hashes_t hashes) {
+        for (std::size_t length : {0, 1, 7, 64, 65, 333, 1000})
+            for (std::size_t window_length : {1, 3, 8, 33}) {
+                std::string text = sz::scripts::random_string(length, "abcd\xFF\x80", 6);
+                assert(rolling_hashes(hashes, text, window_length) ==
+                       rolling_hashes(sz_hashes_serial, text, window_length));
+            }
+    };
+    check_rolling(sz_hashes);
+#if SZ_USE_X86_AVX2
+    check_rolling(sz_hashes_avx2);
+#endif
+#if SZ_USE_X86_AVX512
+    check_rolling(sz_hashes_avx512);
+#endif
+#if SZ_USE_ARM_SVE
+    check_rolling(sz_hashes_sve);
+#endif
+}
+
+/**
+ *  @brief  Tests the multi-window MinHash and SimHash sketches of every available backend against a baseline,
+ *          that permutes the hashes reported by the `sz_hashes_serial` callbacks.
+ */
+static void test_hashing_sketches() {
+    struct baseline_t {
+        std::vector<sz_u64_t> multipliers, masks, min_hashes;
+        std::size_t ones[64] = {0};
+        std::size_t total = 0;
+    };
+    auto splitmix64 = [](sz_u64_t x) -> sz_u64_t {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    };
+
+    std::size_t const window_lengths[] = {1, 3, 4, 5, 8, 17, 64};
+    std::size_t const windows_count = sizeof(window_lengths) / sizeof(window_lengths[0]);
+    auto check = [&](std::string const &text, std::size_t permutations_count, sz_hashes_sketch_t sketch) {
+        std::vector<sz_u64_t> min_hashes(windows_count * permutations_count), sim_hashes(windows_count);
+        sketch(text.data(), text.size(), window_lengths, windows_count, permutations_count, min_hashes.data(),
+               sim_hashes.data());
+
+        for (std::size_t w = 0; w != windows_count; ++w) {
+            baseline_t baseline;
+            baseline.min_hashes.resize(permutations_count, SZ_U64_MAX);
+            for (std::size_t p = 0; p != permutations_count; ++p)
+                baseline.multipliers.push_back(splitmix64(2 * p) | 1ull),
+                    baseline.masks.push_back(splitmix64(2 * p + 1));
+            sz_hashes_serial(
+                text.data(), text.size(), window_lengths[w], 1,
+                [](sz_cptr_t, sz_size_t, sz_u64_t hash, void *handle) {
+                    baseline_t &baseline = *reinterpret_cast<baseline_t *>(handle);
+                    for (std::size_t p = 0; p != baseline.min_hashes.size(); ++p) {
+                        sz_u64_t permuted = (hash ^ baseline.masks[p]) * baseline.multipliers[p];
+                        permuted ^= permuted >> 32;
+                        baseline.min_hashes[p] = std::min(baseline.min_hashes[p], permuted);
+                    }
+                    for (std::size_t bit = 0; bit != 64; ++bit) baseline.ones[bit] += (hash >> bit) & 1ull;
+                    baseline.total++;
+                },
+                &baseline);
+
+            sz_u64_t sim_hash = 0;
+            for (std::size_t bit = 0; bit != 64; ++bit)
+                if (baseline.ones[bit] * 2 > baseline.total) sim_hash |= 1ull << bit;
+            assert(sim_hashes[w] == sim_hash);
+            assert(std::equal(baseline.min_hashes.begin(), baseline.min_hashes.end(),
+                              min_hashes.begin() + w * permutations_count));
+        }
+    };
+
+    // Lengths around the 64-window blocks, and shorter than some of the windows.
+    for (std::size_t length : {0, 1, 2, 4, 7, 63, 64, 65, 127, 128, 130, 300, 1000})
+        for (std::size_t permutations_count : {0, 1, 7, 8, 13, 64}) {
+            std::string text = sz::scripts::random_string(length, "abcd\xFF\x80", 6);
+            check(text, permutations_count, sz_hashes_sketch);
+            check(text, permutations_count, sz_hashes_sketch_serial);
+#if SZ_USE_X86_AVX512
+            check(text, permutations_count, sz_hashes_sketch_avx512);
+#endif
+        }
+
+    // Signatures of one window length don't depend on the others, and outputs are optional.
+    std::string text = sz::scripts::random_string(1000, "abcd", 4);
+    std::size_t const lengths[2] = {4, 9};
+    sz_u64_t min_hashes[2][16], sim_hashes[2];
+    sz::hashes_sketch(sz::string_view(text), lengths, min_hashes, sim_hashes);
+    sz_u64_t single_min_hashes[16], single_sim_hash;
+    sz::hashes_sketch(sz::string_view(text), &lengths[1], 1, 16, &single_min_hashes[0], nullptr);
+    sz::hashes_sketch(sz::string_view(text), &lengths[1], 1, 16, nullptr, &single_sim_hash);
+    assert(std::equal(min_hashes[1], min_hashes[1] + 16, single_min_hashes));
+    assert(sim_hashes[1] == single_sim_hash);
+
+    // Texts shorter than the window have no shingles.
+    sz::hashes_sketch(sz::string_view("abc"), lengths, min_hashes, sim_hashes);
+    assert(min_hashes[0][0] == SZ_U64_MAX && min_hashes[1][15] == SZ_U64_MAX);
+    assert(sim_hashes[0] == 0 && sim_hashes[1] == 0);
+}
+
+/**
+ *  @brief  Tests the case conversions, ASCII checks, and case-insensitive search of every available backend,
+ *          against the reference ASCII and Latin-1 mappings, on random strings of all lengths and alignments.
+ */
+static void test_case_folding() {
+
+    auto lower_baseline = [](sz_u8_t c) -> sz_u8_t {
+        return (c >= 'A' && c <= 'Z') || (c >= 192 && c <= 222 && c != 215) ? (sz_u8_t)(c + 32) : c;
+    };
+    auto upper_baseline = [](sz_u8_t c) -> sz_u8_t {
+        return (c >= 'a' && c <= 'z') || (c >= 224 && c <= 254 && c != 247) ? (sz_u8_t)(c - 32) : c;
+    };
+
+    // Check the conversions of every byte value.
+    for (unsigned c = 0; c != 256; ++c) {
+        char input = (char)c, lowered, upped;
+        sz_tolower(&input, 1, &lowered);
+        sz_toupper(&input, 1, &upped);
+        assert((sz_u8_t)lowered == lower_baseline((sz_u8_t)c));
+        assert((sz_u8_t)upped == upper_baseline((sz_u8_t)c));
+    }
+
+    std::mt19937 &generator = global_random_generator();
+    std::uniform_int_distribution<std::size_t> length_distribution(0, 300);
+    auto check_backend = [&](sz_to_converter_t tolower, sz_to_converter_t toupper, sz_to_converter_t toascii,
+                             sz_isascii_t isascii, sz_find_t find_case_insensitive) {
+        for (std::size_t iteration = 0; iteration != 1000; ++iteration) {
+            std::string text(length_distribution(generator), 'a'), expected, result;
+            std::size_t const offset = iteration % 7;
+            // Mix the letters with the rest of the byte range, including the Latin-1 edge cases.
+            char const edge_cases[] = {'@', '[', '`', '{', (char)191, (char)215, (char)223, (char)247, (char)255};
+            for (auto &c : text)
+                c = generator() % 4 ? (char)('A' + generator() % 58)
+                                    : generator() % 2 ? edge_cases[generator() % sizeof(edge_cases)]
+                                                      : (char)(generator() % 256);
+            // If it's long enough, make sure the strings are also ASCII sometimes.
+            if (iteration % 2) text.erase(std::remove_if(text.begin(), text.end(), [](char c) { return c < 0; }),
+                                          text.end());
+            std::string const padded = std::string(offset, ' ') + text;
+            sz_cptr_t const unaligned = padded.data() + offset;
+
+            result.resize(text.size());
+            expected = text;
+            for (auto &c : expected) c = (char)lower_baseline((sz_u8_t)c);
+            tolower(unaligned, text.size(), &result[0]);
+            assert(result == expected);
+            for (auto &c : expected) c = (char)upper_baseline((sz_u8_t)c);
+            toupper(unaligned, text.size(), &result[0]);
+            assert(result == expected);
+            for (std::size_t i = 0; i != text.size(); ++i) expected[i] = (char)(text[i] & 0x7F);
+            toascii(unaligned, text.size(), &result[0]);
+            assert(result == expected);
+            bool const is_ascii = std::all_of(text.begin(), text.end(), [](char c) { return c >= 0; });
+            assert((isascii(unaligned, text.size()) == sz_true_k) == is_ascii);
+
+            // In-place conversions must also work.
+            result = text;
+            tolower(&result[0], result.size(), &result[0]);
+            for (std::size_t i = 0; i != text.size(); ++i) assert((sz_u8_t)result[i] == lower_baseline((sz_u8_t)text[i]));
+
+            // Search for a differently-cased slice of the text, comparing against the search in lowered copies.
+            if (text.empty()) continue;
+            std::size_t const needle_offset = generator() % text.size();
+            std::size_t const needle_length = 1 + generator() % std::min<std::size_t>(text.size() - needle_offset, 70);
+            std::string needle = text.substr(needle_offset, needle_length);
+            for (auto &c : needle)
+                if (generator() % 2) c = (char)upper_baseline((sz_u8_t)c);
+            std::string lowered_text = text, lowered_needle = needle;
+            for (auto &c : lowered_text) c = (char)lower_baseline((sz_u8_t)c);
+            for (auto &c : lowered_needle) c = (char)lower_baseline((sz_u8_t)c);
+            std::size_t const expected_offset = lowered_text.find(lowered_needle);
+            assert(expected_offset <= needle_offset);
+            sz_cptr_t match = find_case_insensitive(unaligned, text.size(), needle.data(), needle.size());
+            assert(match && (std::size_t)(match - unaligned) == expected_offset);
+            // Corrupt the needle, so that it's most likely missing.
+            needle[needle.size() / 2] = '\n';
+            lowered_needle[needle.size() / 2] = '\n';
+            std::size_t const corrupted_offset = lowered_text.find(lowered_needle);
+            match = find_case_insensitive(unaligned, text.size(), needle.data(), needle.size());
+            assert(corrupted_offset == std::string::npos ? match == nullptr
+                                                         : (std::size_t)(match - unaligned) == corrupted_offset);
+        }
+    };
+
+    check_backend(sz_tolower, sz_toupper, sz_toascii, sz_isascii, sz_find_case_insensitive);
+    check_backend(sz_tolower_serial, sz_toupper_serial, sz_toascii_serial, sz_isascii_serial,
+                  sz_find_case_insensitive_serial);
+#if SZ_USE_X86_AVX2
+    check_backend(sz_tolower_avx2, sz_toupper_avx2, sz_toascii_avx2, sz_isascii_avx2, sz_find_case_insensitive_avx2);
+#endif
+#if SZ_USE_X86_AVX512
+    check_backend(sz_tolower_avx512, sz_toupper_avx512, sz_toascii_avx512, sz_isascii_avx512,
+                  sz_find_case_insensitive_avx512);
+#endif
+#if SZ_USE_ARM_NEON
+    check_backend(sz_tolower_neon, sz_toupper_neon, sz_toascii_neon, sz_isascii_neon, sz_find_case_insensitive_neon);
+#endif
+
+    // Both ASCII and Latin-1 letters are folded, but the surrounding symbols are not.
+    sz_cptr_t const greeting = "Hello, World! \xC0\xD7\xDE";
+    assert(sz_find_case_insensitive(greeting, 17, "WORLD", 5) == greeting + 7);
+    assert(sz_find_case_insensitive(greeting, 17, "\xE0\xD7\xFE", 3) == greeting + 14);
+    assert(sz_find_case_insensitive(greeting, 17, "\xE0\xF7\xFE", 3) == nullptr);
+    assert(sz_find_case_insensitive(greeting, 17, "world!", 6) == greeting + 7);
+    assert(sz_find_case_insensitive(greeting, 17, "world?", 6) == nullptr);
+}
+
+/**
+ *  @brief  Tests the byte-level translation with lookup tables, comparing all backends against the serial one.
+ */
+static void test_translate() {
+    // A table, that reverses the order of all byte values, touching all of the 4 quarters of the table.
+    char reversed[256], complement[256];
+    for (unsigned c = 0; c != 256; ++c) reversed[c] = (char)(255 - c), complement[c] = (char)c;
+    complement['A'] = 'T', complement['T'] = 'A', complement['C'] = 'G', complement['G'] = 'C';
+
+    std::mt19937 &generator = global_random_generator();
+    auto check_backend = [&](sz_translate_t translate) {
+        for (std::size_t length = 0; length != 300; ++length) {
+            std::string text(length, '\0'), result(length, '\0');
+            for (auto &c : text) c = (char)(generator() % 256);
+            translate(text.data(), length, reversed, &result[0]);
+            for (std::size_t i = 0; i != length; ++i) assert((sz_u8_t)result[i] == 255 - (sz_u8_t)text[i]);
+            // In-place conversions must also work.
+            translate(&result[0], length, reversed, &result[0]);
+            assert(result == text);
+        }
+    };
+    check_backend(sz_translate);
+    check_backend(sz_translate_serial);
+#if SZ_USE_X86_AVX2
+    check_backend(sz_translate_avx2);
+#endif
+#if SZ_USE_X86_AVX512
+    check_backend(sz_translate_avx512);
+#endif
+#if SZ_USE_ARM_NEON
+    check_backend(sz_translate_neon);
+#endif
+
+    // The C++ wrappers translate in-place or into a separate buffer.
+    sz::string dna = "ACGTTGCA-acgt";
+    dna.translate(complement);
+    assert(dna == "TGCAACGT-acgt");
+    char exported[13];
+    sz::translate(dna.view(), complement, sz::string_span(exported, 13));
+    assert(sz::string_view(exported, 13) == "ACGTTGCA-acgt");
+    sz::translate(sz::string_span(exported, 4), reversed);
+    assert((sz_u8_t)exported[0] == 255 - 'A' && exported[4] == 'T');
+}
+
+/**
+ *  @brief  Tests UTF8 validation, rune counting, navigation and transcoding against simple baselines,
+ *          for every available backend, including the runes crossing the SIMD register boundaries.
+ */
+static void test_utf8() {
+
+    auto encode = [](char32_t rune, std::string &utf8) {
+        if (rune < 0x80) { utf8 += (char)rune; }
+        else if (rune < 0x800) { utf8 += (char)(0xC0 | (rune >> 6)), utf8 += (char)(0x80 | (rune & 0x3F)); }
+        else if (rune < 0x10000) {
+            utf8 += (char)(0xE0 | (rune >> 12)), utf8 += (char)(0x80 | ((rune >> 6) & 0x3F));
+            utf8 += (char)(0x80 | (rune & 0x3F));
+        }
+        else {
+            utf8 += (char)(0xF0 | (rune >> 18)), utf8 += (char)(0x80 | ((rune >> 12) & 0x3F));
+            utf8 += (char)(0x80 | ((rune >> 6) & 0x3F)), utf8 += (char)(0x80 | (rune & 0x3F));
+        }
+    };
+
+    // Decodes a rune and checks, that re-encoding it results in the same bytes.
+    auto valid_baseline = [&](std::string const &text) -> bool {
+        for (std::size_t i = 0; i != text.size();) {
+            sz_u8_t const lead = (sz_u8_t)text[i];
+            std::size_t const length = lead < 0x80   ? 1
+                                       : lead < 0xC0 ? 0
+                                       : lead < 0xE0 ? 2
+                                       : lead < 0xF0 ? 3
+                                       : lead < 0xF8 ? 4
+                                                     : 0;
+            if (!length || i + length > text.size()) return false;
+            char32_t rune = length == 1 ? lead : lead & (0x7F >> length);
+            for (std::size_t j = 1; j != length; ++j) {
+                if (((sz_u8_t)text[i + j] & 0xC0) != 0x80) return false;
+                rune = (rune << 6) | ((sz_u8_t)text[i + j] & 0x3F);
+            }
+            if (rune > 0x10FFFF || (rune >= 0xD800 && rune <= 0xDFFF)) return false;
+            std::string reencoded;
+            encode(rune, reencoded);
+            if (reencoded != text.substr(i, length)) return false;
+            i += length;
+        }
+        return true;
+    };
+
+    std::mt19937 &generator = global_random_generator();
+    auto random_rune = [&]() -> char32_t {
+        switch (generator() % 4) {
+        case 0: return (char32_t)(generator() % 0x80);
+        case 1: return (char32_t)(0x80 + generator() % (0x800 - 0x80));
+        case 2: {
+            char32_t rune = (char32_t)(0x800 + generator() % (0x10000 - 0x800));
+            return rune >= 0xD800 && rune <= 0xDFFF ? rune - 0x800 : rune;
+        }
+        default: return (char32_t)(0x10000 + generator() % (0x110000 - 0x10000));
+        }
+    };
+
+    using valid_t = sz_bool_t (*)(sz_cptr_t, sz_size_t);
+    auto check_backend = [&](valid_t valid, sz_utf8_count_t count, sz_utf8_find_nth_t find_nth,
+                             sz_utf8_to_utf32_t to_utf32) {
+        // Check all the 2-byte sequences and the 3-byte prefixes of every kind, placed across the 16-, 32-,
+        // and 64-byte boundaries, between ASCII and non-ASCII neighbors.
+        for (std::size_t boundary : {15, 31, 63}) {
+            for (unsigned first = 0x80; first != 0x100; ++first) {
+                for (unsigned second = 0; second != 0x100; ++second) {
+                    for (char const *neighbor : {"a", "\xC3\xA9"}) {
+                        std::string text;
+                        while (text.size() < boundary) text += neighbor;
+                        text.resize(boundary, 'a');
+                        text += (char)first, text += (char)second;
+                        if (first >= 0xE0) text += (char)0x80;
+                        if (first >= 0xF0) text += (char)0x80;
+                        text += neighbor;
+                        assert((valid(text.data(), text.size()) == sz_true_k) == valid_baseline(text));
+                        // Truncated variants must always fail.
+                        if (first >= 0xC0) assert(valid(text.data(), boundary + 1) == sz_false_k);
+                    }
+                }
+            }
+        }
+
+        std::uniform_int_distribution<std::size_t> length_distribution(0, 300);
+        for (std::size_t iteration = 0; iteration != 1000; ++iteration) {
+            std::string text;
+            std::u32string runes;
+            std::vector<std::size_t> offsets;
+            std::size_t const runes_count = length_distribution(generator);
+            bool const ascii_only = iteration % 5 == 0;
+            for (std::size_t i = 0; i != runes_count; ++i) {
+                char32_t const rune = ascii_only ? (char32_t)(generator() % 0x80) : random_rune();
+                offsets.push_back(text.size());
+                runes.push_back(rune);
+                encode(rune, text);
+            }
+            assert(valid(text.data(), text.size()) == sz_true_k);
+            assert(count(text.data(), text.size()) == runes_count);
+            std::u32string decoded(text.size(), U'\0');
+            decoded.resize(to_utf32(text.data(), text.size(), (sz_rune_t *)&decoded[0]));
+            assert(decoded == runes);
+            for (std::size_t i = 0; i != runes_count; ++i)
+                assert(find_nth(text.data(), text.size(), i) == text.data() + offsets[i]);
+            assert(find_nth(text.data(), text.size(), runes_count) == nullptr);
+
+            // Corrupting one byte either keeps the string valid, or is detected.
+            if (text.empty()) continue;
+            std::string corrupted = text;
+            corrupted[generator() % corrupted.size()] = (char)(generator() % 256);
+            assert((valid(corrupted.data(), corrupted.size()) == sz_true_k) == valid_baseline(corrupted));
+            // The rune counts and the decoders stay consistent even on corrupted inputs.
+            std::size_t const corrupted_count = count(corrupted.data(), corrupted.size());
+            assert(corrupted_count == sz_utf8_count_serial(corrupted.data(), corrupted.size()));
+            decoded.assign(corrupted.size(), U'\0');
+            assert(to_utf32(corrupted.data(), corrupted.size(), (sz_rune_t *)&decoded[0]) == corrupted_count);
+        }
+    };
+
+    check_backend(sz_utf8_valid, sz_utf8_count, sz_utf8_find_nth, sz_utf8_to_utf32);
+    check_backend(sz_utf8_valid_serial, sz_utf8_count_serial, sz_utf8_find_nth_serial, sz_utf8_to_utf32_serial);
+#if SZ_USE_X86_AVX512
+    check_backend(sz_utf8_valid_avx512, sz_utf8_count_avx512, sz_utf8_find_nth_avx512, sz_utf8_to_utf32_avx512);
+#endif
+#if SZ_USE_ARM_NEON
+    check_backend(sz_utf8_valid_neon, sz_utf8_count_neon, sz_utf8_find_nth_neon, sz_utf8_to_utf32_neon);
+#endif
+
+    // The Hamming distance works over runes, even if the strings have different byte lengths.
+    std::uniform_int_distribution<std::size_t> length_distribution(0, 200);
+    for (std::size_t iteration = 0; iteration != 1000; ++iteration) {
+        std::string first, second;
+        std::size_t expected = 0;
+        std::size_t const first_count = length_distribution(generator), second_count = length_distribution(generator);
+        for (std::size_t i = 0; i != std::max(first_count, second_count); ++i) {
+            char32_t const first_rune = random_rune(), second_rune = generator() % 2 ? first_rune : random_rune();
+            if (i < first_count) encode(first_rune, first);
+            if (i < second_count) encode(second_rune, second);
+            expected += i >= first_count || i >= second_count || first_rune != second_rune;
+        }
+        assert(sz::hamming_distance_utf8(sz::string_view(first), sz::string_view(second)) == expected);
+        assert(sz::hamming_distance_utf8(sz::string_view(second), sz::string_view(first)) == expected);
+        assert(sz::hamming_distance_utf8(sz::string_view(first), sz::string_view(second), expected / 2 + 1) ==
+               std::min(expected, expected / 2 + 1));
+    }
+
+    // Overlong encodings, surrogates, and codepoints beyond U+10FFFF.
+    assert(sz_utf8_valid("\xC0\x80", 2) == sz_false_k);
+    assert(sz_utf8_valid("\xE0\x9F\xBF", 3) == sz_false_k);
+    assert(sz_utf8_valid("\xED\xA0\x80", 3) == sz_false_k);
+    assert(sz_utf8_valid("\xF4\x90\x80\x80", 4) == sz_false_k);
+    assert(sz_utf8_valid("\xF4\x8F\xBF\xBF", 4) == sz_true_k);
+    sz_cptr_t const greek = "αβγδ";
+    assert(sz_utf8_count(greek, 8) == 4);
+    assert(sz_utf8_find_nth(greek, 8, 2) == greek + 4);
+    assert(sz_utf8_find_nth(greek, 8, 4) == nullptr);
+}
+
 /**
  *  @brief  Tests the correctness of the string class search methods, such as `find` and `find_first_of`.
  *          This covers haystacks and needles of different lengths, as well as character-sets.
@@ -859,6 +1444,13 @@ static void test_search() {
     assert("abbccc"_sz.partition("bb").match == "bb");
     assert("abbccc"_sz.partition("bb").after == "ccc");
 
+    // Candidates, whose prefix or suffix matches near the haystack boundary, must not be verified out of bounds.
+    assert(sz_find_serial("abababab", 8, "ababx", 5) == nullptr);
+    {
+        std::string needle = "b" + std::string(299, 'a'), haystack = "b" + std::string(300, 'a');
+        assert(sz_rfind_serial(haystack.data(), haystack.size(), needle.data(), needle.size()) == haystack.data());
+    }
+
     // Check ranges of search matches
     assert("hello"_sz.find_all("l").size() == 2);
     assert("hello"_sz.rfind_all("l").size() == 2);
@@ -1119,6 +1711,513 @@ static void test_search_with_misaligned_repetitions() {
 
 #endif
 
+/**
+ *  @brief  Tests the searches with prepared needles against the one-shot serial search,
+ *          reusing every prepared needle across many haystacks, as the iterators would.
+ */
+static void test_search_prepared() {
+    auto check_backend = [&](sz_find_prepared_t find_prepared) {
+        for (std::size_t n_length : {0, 1, 2, 3, 4, 5, 8, 9, 16, 33, 64, 65, 254, 255, 256, 300}) {
+            for (std::size_t iteration = 0; iteration != 20; ++iteration) {
+                // Small alphabets guarantee plenty of partial and full matches.
+                std::size_t cardinality = 1 + iteration % 3;
+                std::string needle = random_string(n_length, "abcd", cardinality + 1);
+                sz_needle_t prepared;
+                sz_needle_prepare(needle.data(), needle.size(), &prepared);
+
+                for (std::size_t h_length : {0, 1, 7, 31, 63, 64, 65, 127, 300, 1000}) {
+                    std::string haystack = random_string(h_length, "abcd", cardinality + 1);
+                    if (h_length >= n_length && iteration % 2) haystack.replace(h_length - n_length, n_length, needle);
+                    sz_cptr_t h = haystack.data();
+                    for (std::size_t offset = 0; offset <= h_length; ++offset) {
+                        sz_cptr_t expected = sz_find_serial(h + offset, h_length - offset, needle.data(), n_length);
+                        sz_cptr_t result = find_prepared(&prepared, h + offset, h_length - offset);
+                        assert(result == expected);
+                        if (!expected) break;
+                        offset = static_cast<std::size_t>(expected - h);
+                    }
+                }
+            }
+        }
+    };
+    check_backend(sz_find_prepared);
+    check_backend(sz_find_prepared_serial);
+#if SZ_USE_X86_AVX2
+    check_backend(sz_find_prepared_avx2);
+#endif
+#if SZ_USE_X86_AVX512
+    check_backend(sz_find_prepared_avx512);
+#endif
+#if SZ_USE_ARM_NEON
+    check_backend(sz_find_prepared_neon);
+#endif
+
+    // The iterators over the StringZilla views reuse the prepared needles.
+    assert("abcabcab"_sz.find_all("abc").size() == 2);
+    assert("abcabcab"_sz.find_all("ab").size() == 3);
+    assert("aaaa"_sz.find_all("aa").size() == 3);
+    assert("aaaa"_sz.find_all("aa", sz::exclude_overlaps_type {}).size() == 2);
+    assert("a,b,,c"_sz.split(",").size() == 4);
+    assert("abc"_sz.find_all("").size() == 3);
+
+    // The masked tails of the SIMD kernels must not match the NULL characters past the end of the haystack.
+    char const zeros_after[] = {'a', 'b', '\0', '\0', '\0'};
+    sz::string_view truncated(zeros_after, 2);
+    assert(truncated.find(sz::string_view("\0\0", 2)) == sz::string_view::npos);
+    assert(truncated.rfind(sz::string_view("\0\0", 2)) == sz::string_view::npos);
+}
+
+/**
+ *  @brief  Compares the compile-time specialized search for a given needle with the dynamic `sz_find`,
+ *          using haystacks in the needle's alphabet, on both sides of the SWAR and SIMD threshold.
+ */
+template <typename needle_type_>
+static void test_static_needle() {
+    std::string const needle(needle_type_::data(), needle_type_::size());
+    std::string const alphabet = needle + "x";
+
+    // The offsets evaluated at compile time must match the ones picked at runtime.
+    sz_needle_t prepared;
+    sz_needle_prepare(needle.data(), needle.size(), &prepared);
+    assert(needle_type_::prepared_k.offset_first == prepared.offset_first);
+    assert(needle_type_::prepared_k.offset_mid == prepared.offset_mid);
+    assert(needle_type_::prepared_k.offset_last == prepared.offset_last);
+
+    for (std::size_t h_length : {0, 1, 2, 7, 8, 9, 15, 16, 17, 31, 64, 100, 255, 256, 257, 1000}) {
+        for (std::size_t iteration = 0; iteration != 10; ++iteration) {
+            std::string haystack = random_string(h_length, alphabet.data(), alphabet.size());
+            if (h_length >= needle.size() && iteration % 2)
+                haystack.replace(h_length - needle.size(), needle.size(), needle);
+            sz_cptr_t h = haystack.data();
+            for (std::size_t offset = 0; offset <= h_length; ++offset) {
+                sz_cptr_t expected = sz_find_serial(h + offset, h_length - offset, needle.data(), needle.size());
+                std::size_t result = needle_type_::find(h + offset, h_length - offset);
+                assert(result == (expected ? static_cast<std::size_t>(expected - h - offset) : needle_type_::npos));
+                if (!expected) break;
+                offset = static_cast<std::size_t>(expected - h);
+            }
+
+            // The ranges must report the same matches as for the dynamic needles.
+            sz::string_view view(haystack);
+            assert(sz::find_all<needle_type_>(view).size() == view.find_all(needle).size());
+            assert(sz::find_all<needle_type_>(view, sz::exclude_overlaps_type {}).size() ==
+                   view.find_all(needle, sz::exclude_overlaps_type {}).size());
+            assert(sz::split<needle_type_>(view).size() == view.split(needle).size());
+        }
+    }
+}
+
+static void test_search_static() {
+    test_static_needle<sz::basic_static_needle<'\n'>>();
+    test_static_needle<sz::basic_static_needle<'\r', '\n'>>();
+    test_static_needle<sz::basic_static_needle<'a', 'a', 'a'>>();
+    test_static_needle<sz::basic_static_needle<'\r', '\n', '\r', '\n'>>();
+    test_static_needle<sz::basic_static_needle<'a', 'b', 'a', 'b', 'a'>>();
+    test_static_needle<sz::basic_static_needle<'H', 'T', 'T', 'P', '/', '1', '.', '1'>>();
+    test_static_needle<sz::basic_static_needle<'\xFF', '\0', '\xFF', '\0', '\xFF', '\0', '\xFF', '\0', '\xFF'>>();
+    test_static_needle<sz::basic_static_needle<'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c', 'd'>>();
+
+    // Empty needles match at the start, like in `std::string::find`.
+    assert(sz::basic_static_needle<>::find("abc", 3) == 0);
+    using bc_needle_t = sz::basic_static_needle<'b', 'c'>;
+    using cb_needle_t = sz::basic_static_needle<'c', 'b'>;
+    assert(sz::find<bc_needle_t>("abc"_sz) == 1);
+    assert(sz::find<cb_needle_t>("abc"_sz) == sz::string_view::npos);
+    assert(sz::find<bc_needle_t>(std::string("abc")) == 1);
+
+    // Needles longer than a word, missing from a long haystack, must not stall on a zeroed skip table.
+    using long_needle_t = sz::basic_static_needle<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'x'>;
+    std::string digits;
+    for (std::size_t i = 0; i != 1000; ++i) digits += "0123456789";
+    assert(long_needle_t::find(digits.data(), digits.size()) == long_needle_t::npos);
+    assert(sz::find_all<long_needle_t>(sz::string_view(digits)).size() == 0);
+
+#if SZ_DETECT_CPP20
+    static_assert(std::is_same<sz::static_needle<"\r\n">, sz::basic_static_needle<'\r', '\n'>>::value,
+                  "String literals are unpacked into the characters");
+    static_assert(sz::static_needle<"HTTP/1.1">::size() == 8, "The null-terminator is not a part of the needle");
+    assert(sz::find<sz::static_needle<"\r\n\r\n">>("Host: x\r\n\r\nbody"_sz) == 7);
+    assert(sz::split<sz::static_needle<"\r\n">>("a\r\nb\r\n\r\nc"_sz).size() == 4);
+#endif
+}
+
+/**
+ *  @brief  Tests the approximate substring search against the Sellers dynamic-programming baseline, where the first
+ *          row of the Levenshtein matrix is all zeros, so that the match may start at any offset of the haystack.
+ */
+static void test_search_fuzzy() {
+    std::size_t const npos = std::string::npos;
+
+    // Returns the offset of the match, following the same rules for picking the end and the start.
+    auto baseline = [=](std::string const &h, std::string const &n, std::size_t max_edits,
+                        std::size_t &match_length) -> std::size_t {
+        std::vector<std::size_t> column(n.size() + 1);
+        std::iota(column.begin(), column.end(), 0);
+        std::size_t end = npos, edits = npos;
+        if (column[n.size()] <= max_edits) end = 0, edits = column[n.size()];
+        for (std::size_t j = 0; j != h.size() && edits != 0; ++j) {
+            std::size_t diagonal = column[0];
+            for (std::size_t i = 1; i <= n.size(); ++i) {
+                std::size_t const up = column[i];
+                column[i] = std::min({column[i - 1] + 1, up + 1, diagonal + (n[i - 1] != h[j])});
+                diagonal = up;
+            }
+            std::size_t const new_edits = column[n.size()] <= max_edits ? column[n.size()] : npos;
+            if (new_edits < edits) end = j + 1, edits = new_edits;
+            else if (end != npos) break;
+        }
+        if (end == npos) return npos;
+        // The distance is at least the difference of lengths, so only a few starts are worth checking.
+        for (std::size_t length = n.size() > edits ? n.size() - edits : 0; length <= end; ++length)
+            if (levenshtein_baseline(h.data() + end - length, length, n.data(), n.size()) == edits) {
+                match_length = length;
+                return end - length;
+            }
+        assert(false && "The baseline must find the start of the match.");
+        return npos;
+    };
+
+    std::mt19937 &generator = global_random_generator();
+    auto check_backend = [&](sz_find_fuzzy_t find_fuzzy) {
+        for (std::size_t n_length : {1, 2, 5, 16, 63, 64, 65, 100, 128, 200, 511, 512, 513, 700}) {
+            for (std::size_t max_edits : {0, 1, 2, 3, 7}) {
+                for (std::size_t iteration = 0; iteration != 4; ++iteration) {
+                    std::size_t const cardinality = 2 + iteration % 3;
+                    std::string needle = random_string(n_length, "abcd", cardinality);
+
+                    // Plant a mutated copy of the needle somewhere in the middle of the haystack.
+                    std::string mutated = needle;
+                    std::uniform_int_distribution<std::size_t> edits_distribution(0, max_edits + 1);
+                    for (std::size_t edits = edits_distribution(generator); edits && !mutated.empty(); --edits) {
+                        std::size_t const offset = generator() % mutated.size();
+                        switch (generator() % 3) {
+                        case 0: mutated.erase(offset, 1); break;
+                        case 1: mutated.insert(offset, 1, 'x'); break;
+                        default: mutated[offset] = 'y'; break;
+                        }
+                    }
+                    std::string haystack = random_string(generator() % (2 * n_length + 1), "abcd", cardinality) +
+                                           mutated + random_string(generator() % (n_length + 1), "abcd", cardinality);
+
+                    std::size_t expected_length = 0, result_length = 0;
+                    std::size_t expected = baseline(haystack, needle, max_edits, expected_length);
+                    sz_cptr_t result = find_fuzzy(haystack.data(), haystack.size(), needle.data(), needle.size(),
+                                                  max_edits, NULL, &result_length);
+                    assert((result ? static_cast<std::size_t>(result - haystack.data()) : npos) == expected);
+                    assert(!result || result_length == expected_length);
+                }
+            }
+        }
+    };
+    check_backend(sz_find_fuzzy);
+    check_backend(sz_find_fuzzy_serial);
+#if SZ_USE_X86_AVX512
+    check_backend(sz_find_fuzzy_avx512);
+#endif
+
+    // The match is extended, while the following characters reduce the number of edits.
+    sz_cptr_t const text = "xabcdx";
+    sz_size_t length = 0;
+    assert(sz_find_fuzzy(text, 6, "abcd", 4, 1, NULL, &length) == text + 1 && length == 4);
+    assert("xabcdx"_sz.find_all_fuzzy("abcd", 1).size() == 1);
+    assert(*"xabcdx"_sz.find_all_fuzzy("abcd", 1).begin() == "abcd");
+    assert(sz_find_fuzzy("abc", 3, "", 0, 1, NULL, &length) == NULL && length == 0);
+
+    // The OCR-like misspellings are matched one after another, never overlapping.
+    auto words = "Stringzi1la, StringZi1la, StrinqZilla, 5tringZilla"_sz.find_all_fuzzy("StringZilla", 2);
+    std::vector<std::string> matches;
+    for (auto match : words) matches.push_back(match);
+    assert(matches.size() == 4);
+    assert(matches[0] == "Stringzi1la" && matches[2] == "StrinqZilla");
+    assert(matches[3] == "tringZilla"); // Deleting "S" is just as good as substituting it, but shorter.
+    assert("aaaa"_sz.find_all_fuzzy("ab", 1).size() == 4);
+    assert("abc"_sz.find_all_fuzzy("xyz", 1).size() == 0);
+}
+
+/**
+ *  @brief  Tests multi-pattern search, comparing the compiled matcher against
+ *          a brute-force loop over individual needles.
+ */
+static void test_search_multi_pattern() {
+
+    // Basic usage with the smallest needle ID reported for equal offsets.
+    {
+        sz::multi_pattern patterns({"world"_sz, "hello"_sz, "hell"_sz, ""_sz});
+        assert(patterns.size() == 4);
+        auto match = sz::find_any("say hello world"_sz, patterns);
+        assert(match && match.offset == 4 && match.needle == 1 && match.match == "hello");
+        assert(!sz::find_any("say nothing"_sz, patterns));
+        assert(!sz::find_any(""_sz, patterns));
+        assert(sz::find_any("hel"_sz, patterns).offset == sz::multi_pattern_match<sz::string_view>::npos);
+    }
+
+    // Empty sets of needles never match.
+    {
+        std::vector<sz::string_view> nothing;
+        sz::multi_pattern patterns(nothing);
+        assert(patterns.empty());
+        assert(!sz::find_any("anything"_sz, patterns));
+        assert(sz::find_all_any("anything"_sz, patterns).size() == 0);
+    }
+
+    // Overlapping and non-overlapping iteration.
+    {
+        sz::multi_pattern patterns({"aa"_sz, "b"_sz});
+        auto overlapping = sz::find_all_any("aaab"_sz, patterns);
+        auto disjoint = sz::find_all_any("aaab"_sz, patterns, sz::exclude_overlaps_type {});
+        assert(overlapping.size() == 3 && disjoint.size() == 2);
+        auto matches = overlapping.template to<std::vector<sz::multi_pattern_match<sz::string_view>>>();
+        assert(matches[0].offset == 0 && matches[1].offset == 1 && matches[2].offset == 3);
+        assert(matches[2].needle == 1 && matches[2].match == "b");
+    }
+
+    // Every needle matching at the same offset is reported, unless the overlaps are excluded.
+    {
+        sz::multi_pattern patterns({"abc"_sz, "ab"_sz, "b"_sz, "abcd"_sz});
+        auto matches = sz::find_all_any("xabcd"_sz, patterns)
+                           .template to<std::vector<sz::multi_pattern_match<sz::string_view>>>();
+        assert(matches.size() == 4);
+        assert(matches[0].offset == 1 && matches[0].needle == 0 && matches[0].match == "abc");
+        assert(matches[1].offset == 1 && matches[1].needle == 1 && matches[1].match == "ab");
+        assert(matches[2].offset == 1 && matches[2].needle == 3 && matches[2].match == "abcd");
+        assert(matches[3].offset == 2 && matches[3].needle == 2 && matches[3].match == "b");
+        auto disjoint = sz::find_all_any("xabcd"_sz, patterns, sz::exclude_overlaps_type {});
+        assert(disjoint.size() == 1 && (*disjoint.begin()).needle == 0);
+    }
+
+    // Compare against the baseline on random inputs of different lengths, covering the SIMD tails.
+    std::vector<std::string> needles_storage;
+    for (std::size_t needles_count : {1, 3, 8, 9, 50}) {
+        for (std::size_t iteration = 0; iteration != 20; ++iteration) {
+            needles_storage.clear();
+            // Odd iterations skip the single-byte needles, so the prefilter probes the longer prefixes.
+            std::size_t const min_length = iteration % 2 ? 3 : 1;
+            for (std::size_t i = 0; i != needles_count; ++i)
+                needles_storage.push_back(random_string(min_length + i % 6, "abcd", 4));
+            sz::multi_pattern patterns(needles_storage);
+
+            for (std::size_t haystack_length : {0, 1, 2, 15, 31, 33, 63, 64, 65, 200}) {
+                std::string haystack = random_string(haystack_length, "abcd", 4);
+                sz::string_view haystack_view = haystack;
+
+                std::size_t expected_offset = sz::multi_pattern_match<sz::string_view>::npos, expected_needle = 0;
+                for (std::size_t offset = 0; offset != haystack.size(); ++offset) {
+                    for (std::size_t i = 0; i != needles_storage.size() && expected_offset != offset; ++i)
+                        if (haystack_view.substr(offset).starts_with(needles_storage[i]))
+                            expected_offset = offset, expected_needle = i;
+                    if (expected_offset == offset) break;
+                }
+
+                auto match = sz::find_any(haystack_view, patterns);
+                assert(match.offset == expected_offset);
+                if (match) assert(match.needle == expected_needle);
+
+                // The overlapping range must report every (offset, needle) pair, ordered by offset and ID.
+                std::vector<std::pair<std::size_t, std::size_t>> expected_pairs, pairs;
+                for (std::size_t offset = 0; offset != haystack.size(); ++offset)
+                    for (std::size_t i = 0; i != needles_storage.size(); ++i)
+                        if (haystack_view.substr(offset).starts_with(needles_storage[i]))
+                            expected_pairs.emplace_back(offset, i);
+                for (auto any_match : sz::find_all_any(haystack_view, patterns))
+                    pairs.emplace_back(any_match.offset, any_match.needle);
+                assert(pairs == expected_pairs);
+            }
+        }
+    }
+}
+
+/**
+ *  @brief  Tests the streaming search and splitting, feeding random haystacks in random chunks,
+ *          comparing against the `find_all` and `split` ranges over the whole haystack.
+ */
+static void test_search_streaming() {
+
+    std::mt19937 &generator = global_random_generator();
+    std::uniform_int_distribution<std::size_t> chunk_length_distribution(0, 7);
+    std::uniform_int_distribution<std::size_t> needle_length_distribution(1, 5);
+    std::uniform_int_distribution<std::size_t> haystack_length_distribution(0, 64);
+    std::uniform_int_distribution<int> letter_distribution(0, 1);
+
+    for (std::size_t iteration = 0; iteration != 10000; ++iteration) {
+        std::string haystack(haystack_length_distribution(generator), 'a');
+        std::string needle(needle_length_distribution(generator), 'a');
+        for (char &c : haystack) c = static_cast<char>('a' + letter_distribution(generator));
+        for (char &c : needle) c = static_cast<char>('a' + letter_distribution(generator));
+
+        std::vector<std::size_t> expected_with_overlaps, expected_without_overlaps;
+        for (auto match : sz::string_view(haystack).find_all(needle, sz::include_overlaps_type {}))
+            expected_with_overlaps.push_back(static_cast<std::size_t>(match.data() - haystack.data()));
+        for (auto match : sz::string_view(haystack).find_all(needle, sz::exclude_overlaps_type {}))
+            expected_without_overlaps.push_back(static_cast<std::size_t>(match.data() - haystack.data()));
+        std::vector<std::string> expected_pieces;
+        for (auto piece : sz::string_view(haystack).split(needle)) expected_pieces.emplace_back(piece);
+
+        std::vector<std::size_t> found_with_overlaps, found_without_overlaps;
+        std::vector<std::string> found_pieces;
+        std::string piece;
+        sz::find_stream<sz::include_overlaps_type> with_overlaps(needle);
+        sz::find_stream<sz::exclude_overlaps_type> without_overlaps(needle);
+        sz::split_stream splits(needle);
+        auto with_overlaps_callback = [&](std::size_t offset) { found_with_overlaps.push_back(offset); };
+        auto without_overlaps_callback = [&](std::size_t offset) { found_without_overlaps.push_back(offset); };
+        auto splits_callback = [&](sz::string_view fragment, bool complete) {
+            piece.append(fragment.data(), fragment.size());
+            if (complete) found_pieces.push_back(piece), piece.clear();
+        };
+
+        // Feed the haystack in random chunks, copying each into a temporary buffer to catch dangling references.
+        for (std::size_t offset = 0; offset < haystack.size();) {
+            std::size_t chunk_length = std::min(chunk_length_distribution(generator), haystack.size() - offset);
+            std::string chunk = haystack.substr(offset, chunk_length);
+            with_overlaps.feed(chunk, with_overlaps_callback);
+            without_overlaps.feed(chunk, without_overlaps_callback);
+            splits.feed(chunk, splits_callback);
+            std::fill(chunk.begin(), chunk.end(), 'x');
+            offset += chunk_length;
+        }
+        splits.finish(splits_callback);
+
+        assert(with_overlaps.offset() == haystack.size());
+        assert(found_with_overlaps == expected_with_overlaps);
+        assert(found_without_overlaps == expected_without_overlaps);
+        assert(found_pieces == expected_pieces);
+    }
+}
+
+/**
+ *  @brief  Tests the bulk splitting into offset tapes against the serial baseline, with single-byte delimiters
+ *          and larger sets, both offset widths, and tiny capacities, that force the callers to resume.
+ */
+static void test_split_offsets() {
+
+    std::mt19937 &generator = global_random_generator();
+    std::uniform_int_distribution<int> byte_distribution(0, 255);
+
+    std::vector<sz_split_offsets_t> backends = {sz_split_offsets_serial, sz_split_offsets};
+#if SZ_USE_X86_AVX512
+    backends.push_back(sz_split_offsets_avx512);
+#endif
+#if SZ_USE_ARM_NEON
+    backends.push_back(sz_split_offsets_neon);
+#endif
+
+    auto check = [&](std::string const &text, sz_charset_t const &delimiters) {
+        std::vector<sz_u64_t> expected;
+        for (std::size_t i = 0; i != text.size(); ++i)
+            if (sz_charset_contains(&delimiters, text[i])) expected.push_back(i + 1);
+
+        for (sz_split_offsets_t split : backends) {
+            for (std::size_t offset_bytes : {4, 8}) {
+                for (std::size_t capacity : {1, 2, 3, 17, 100, 10000}) {
+                    // Refill the small buffer, until the whole text is consumed.
+                    std::vector<sz_u64_t> exported;
+                    std::vector<sz_u64_t> buffer_u64(capacity + 1, 0xDEADBEEF);
+                    std::vector<sz_u32_t> buffer_u32(capacity + 1, 0xDEADBEEF);
+                    void *buffer = offset_bytes == 4 ? (void *)buffer_u32.data() : (void *)buffer_u64.data();
+                    std::size_t progress = 0;
+                    do {
+                        std::size_t consumed = 0;
+                        std::size_t count = split(text.data() + progress, text.size() - progress, &delimiters,
+                                                  progress + 1, buffer, offset_bytes, capacity, &consumed);
+                        assert(count <= capacity && consumed <= text.size() - progress);
+                        assert(count == capacity || consumed == text.size() - progress);
+                        for (std::size_t i = 0; i != count; ++i)
+                            exported.push_back(offset_bytes == 4 ? buffer_u32[i] : buffer_u64[i]);
+                        // The slot behind the capacity limit must never be touched.
+                        assert(buffer_u32[capacity] == 0xDEADBEEF && buffer_u64[capacity] == 0xDEADBEEF);
+                        // The exported delimiters must be within the consumed part.
+                        assert(count == 0 || exported.back() <= progress + consumed);
+                        progress += consumed;
+                    } while (progress != text.size());
+                    assert(exported == expected);
+                }
+            }
+        }
+    };
+
+    sz_charset_t newlines, whitespaces, everything;
+    sz_charset_init(&newlines), sz_charset_add(&newlines, '\n');
+    sz_charset_init(&whitespaces);
+    for (char c : {' ', '\t', '\n', '\r', '\v', '\f'}) sz_charset_add(&whitespaces, c);
+    sz_charset_init(&everything), sz_charset_invert(&everything);
+
+    for (sz_charset_t const &delimiters : {newlines, whitespaces, everything}) {
+        check("", delimiters);
+        check("\n", delimiters);
+        check("a\nb c\n\n", delimiters);
+        for (std::size_t length : {1, 15, 16, 17, 63, 64, 65, 200, 1000}) {
+            // Dense and sparse delimiters, to exercise both the compress-stores and the capacity limits.
+            for (int period : {1, 2, 7, 80}) {
+                std::string text(length, 'x');
+                for (std::size_t i = 0; i != length; ++i)
+                    if (byte_distribution(generator) % period == 0) text[i] = " \t\n\r\v\f"[i % 6];
+                check(text, delimiters);
+            }
+            std::string random(length, 0);
+            for (char &c : random) c = (char)byte_distribution(generator);
+            check(random, delimiters);
+        }
+    }
+}
+
+/**
+ *  @brief  Tests the multi-threaded search and splitting over a haystack large enough to be sharded,
+ *          comparing against the single-threaded ranges, including periodic needles straddling the shards.
+ */
+static void test_search_parallel() {
+
+    auto spawning_executor = [](std::size_t tasks_count, std::function<void(std::size_t)> const &task) {
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i != tasks_count; ++i) threads.emplace_back(task, i);
+        for (auto &thread : threads) thread.join();
+    };
+
+    std::mt19937 &generator = global_random_generator();
+    std::uniform_int_distribution<std::size_t> haystack_length_distribution(1024 * 1024, 3 * 1024 * 1024 + 7);
+    std::uniform_int_distribution<std::size_t> needle_length_distribution(1, 5);
+    for (std::size_t iteration = 0; iteration != 16; ++iteration) {
+        // Every other haystack is all 'a', so that the disjoint matches of the shards end up misaligned.
+        std::size_t const alphabet_size = iteration % 2 ? 2 : 1;
+        std::uniform_int_distribution<int> letter_distribution(0, static_cast<int>(alphabet_size) - 1);
+        std::string haystack(haystack_length_distribution(generator), 'a');
+        std::string needle(needle_length_distribution(generator), 'a');
+        for (char &c : haystack) c = static_cast<char>('a' + letter_distribution(generator));
+        for (char &c : needle) c = static_cast<char>('a' + letter_distribution(generator));
+        sz::string_view h = haystack, n = needle;
+
+        auto expected_with_overlaps = sz::find_all(h, n).template to<std::vector<sz::string_view>>();
+        auto expected_without_overlaps =
+            sz::find_all(h, n, sz::exclude_overlaps_type {}).template to<std::vector<sz::string_view>>();
+        auto expected_pieces = sz::split(h, n).template to<std::vector<sz::string_view>>();
+
+        for (std::size_t threads_count : {1, 3, 8}) {
+            std::vector<sz::string_view> found_with_overlaps, found_without_overlaps, found_pieces;
+            sz::find_all(h, n, found_with_overlaps, spawning_executor, threads_count);
+            sz::find_all(h, n, found_without_overlaps, spawning_executor, threads_count, sz::exclude_overlaps_type {});
+            sz::split(h, n, found_pieces, spawning_executor, threads_count);
+            assert(found_with_overlaps == expected_with_overlaps);
+            assert(found_without_overlaps == expected_without_overlaps);
+            assert(found_pieces == expected_pieces);
+        }
+    }
+
+    // Exceptions thrown by the container propagate to the caller, releasing the offsets on the way.
+    struct throwing_container_t {
+        std::size_t pushed = 0;
+        void push_back(sz::string_view) {
+            if (++pushed == 3) throw std::length_error("The container is full");
+        }
+    } throwing_container;
+    bool thrown = false;
+    try {
+        sz::find_all("aaaaaaaa"_sz, "a"_sz, throwing_container, spawning_executor, 2);
+    }
+    catch (std::length_error const &) {
+        thrown = true;
+    }
+    assert(thrown && throwing_container.pushed == 3);
+}
+
 /**
  *  @brief  Tests the correctness of the string class Levenshtein distance computation,
  *          as well as the similarity scoring functions for bioinformatics-like workloads.
@@ -1161,6 +2260,13 @@ static void test_levenshtein_distances() {
         received_score = sz::alignment_score(r, l, costs, -1);
         if (received != expected) print_failure("Levenshtein", r, l, expected, received);
         if ((std::size_t)(-received_score) != expected) print_failure("Scoring", r, l, expected, received_score);
+        // The serial bit-parallel kernels and the bounded variants must agree with the dispatched ones.
+        assert(sz_edit_distance_serial(l.data(), l.size(), r.data(), r.size(), 0, NULL) == expected);
+        for (std::size_t bound : {std::size_t(1), expected, expected + 1, expected / 2 + 1}) {
+            std::size_t const bounded = std::min(expected, bound);
+            assert(sz::edit_distance(l, r, bound) == bounded);
+            assert(sz_edit_distance_serial(l.data(), l.size(), r.data(), r.size(), bound, NULL) == bounded);
+        }
     };
 
     for (auto explicit_case : explicit_cases)
@@ -1206,6 +2312,120 @@ static void test_levenshtein_distances() {
             second.clear();
         }
     }
+
+    // Strings of multi-byte codepoints, compared against the baseline over the decoded UTF32 runes.
+    // The lengths cross the 64-rune and 512-rune thresholds of the bit-parallel kernels.
+    struct {
+        char const *utf8;
+        char32_t utf32;
+    } runes[] = {
+        {"a", U'a'},
+        {"\xD0\xB6", U'\u0436'},
+        {"\xE2\x82\xAC", U'\u20AC'},
+        {"\xF0\x9F\x98\x80", U'\U0001F600'},
+    };
+    std::uniform_int_distribution<std::size_t> utf8_length_distribution(0, 600);
+    for (std::size_t i = 0; i != 60; ++i) {
+        std::string first_utf8, second_utf8;
+        std::u32string first_utf32, second_utf32;
+        std::size_t const first_length = utf8_length_distribution(generator) / (i % 3 ? 8 : 1);
+        std::size_t const second_length = utf8_length_distribution(generator) / (i % 3 ? 8 : 1);
+        for (std::size_t j = 0; j != first_length; ++j) {
+            auto const &rune = runes[generator() % 4];
+            first_utf8 += rune.utf8, first_utf32 += rune.utf32;
+        }
+        for (std::size_t j = 0; j != second_length; ++j) {
+            auto const &rune = runes[generator() % 4];
+            second_utf8 += rune.utf8, second_utf32 += rune.utf32;
+        }
+        std::size_t const expected = levenshtein_baseline(first_utf32.data(), first_utf32.size(), second_utf32.data(),
+                                                          second_utf32.size());
+        assert(sz::edit_distance_utf8(sz::string_view(first_utf8), sz::string_view(second_utf8)) == expected);
+        assert(sz::edit_distance_utf8(sz::string_view(second_utf8), sz::string_view(first_utf8)) == expected);
+        assert(sz::edit_distance_utf8(sz::string_view(first_utf8), sz::string_view(second_utf8), expected / 2 + 1) ==
+               std::min(expected, expected / 2 + 1));
+    }
+}
+
+/**
+ *  @brief  Tests the SIMD alignment scores against the serial one on random asymmetric substitution matrices,
+ *          covering the whole byte range, including the last rows and columns of the matrix.
+ */
+static void test_alignment_scores() {
+    std::mt19937 &generator = global_random_generator();
+    std::uniform_int_distribution<int> cost_distribution(-10, 5);
+    std::uniform_int_distribution<std::size_t> length_distribution(0, 300);
+    std::vector<sz_error_cost_t> costs(256 * 256);
+    for (auto &cost : costs) cost = (sz_error_cost_t)cost_distribution(generator);
+
+    for (std::size_t iteration = 0; iteration != 200; ++iteration) {
+        std::string first(length_distribution(generator), '\0'), second(length_distribution(generator), '\0');
+        // Skew the alphabet towards the end of the byte range every other iteration.
+        std::size_t const alphabet_start = iteration % 2 ? 248 : 0;
+        for (auto &c : first) c = (char)(alphabet_start + generator() % (256 - alphabet_start));
+        for (auto &c : second) c = (char)(alphabet_start + generator() % (256 - alphabet_start));
+        sz_error_cost_t const gap = (sz_error_cost_t)(-1 - (sz_error_cost_t)(iteration % 3));
+
+        sz_ssize_t const expected = sz_alignment_score_serial(first.data(), first.size(), second.data(),
+                                                              second.size(), costs.data(), gap, NULL);
+        assert(sz_alignment_score(first.data(), first.size(), second.data(), second.size(), costs.data(), gap,
+                                  NULL) == expected);
+#if SZ_USE_X86_AVX2
+        assert(sz_alignment_score_avx2(first.data(), first.size(), second.data(), second.size(), costs.data(), gap,
+                                       NULL) == expected);
+#endif
+#if SZ_USE_ARM_NEON
+        assert(sz_alignment_score_neon(first.data(), first.size(), second.data(), second.size(), costs.data(), gap,
+                                       NULL) == expected);
+#endif
+    }
+}
+
+/**
+ *  @brief  Tests the batched one-to-many edit distances against the pairwise ones, with and without bounds,
+ *          mixing short candidates, that fit into 8-bit SIMD lanes, with longer ones, that don't.
+ */
+static void test_levenshtein_distances_batch() {
+    std::mt19937 &generator = global_random_generator();
+    std::uniform_int_distribution<std::size_t> length_distribution(0, 300);
+    std::vector<std::string> candidates;
+    for (std::size_t i = 0; i != 150; ++i) {
+        // Two thirds of the candidates are short words, the rest may be too long for 8-bit lanes.
+        std::size_t length = length_distribution(generator) / (i % 3 ? 10 : 1);
+        candidates.push_back(random_string(length, "acgt", 4));
+    }
+
+    sz_sequence_t sequence;
+    sequence.order = NULL;
+    sequence.count = candidates.size();
+    sequence.handle = &candidates;
+    sequence.get_start = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_cptr_t {
+        return (*reinterpret_cast<std::vector<std::string> const *>(sequence->handle))[i].data();
+    };
+    sequence.get_length = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_size_t {
+        return (*reinterpret_cast<std::vector<std::string> const *>(sequence->handle))[i].size();
+    };
+
+    for (std::size_t query_length : {0, 1, 7, 30, 254, 255, 280}) {
+        std::string query = random_string(query_length, "acgt", 4);
+        for (std::size_t bound : {0, 1, 3, 20, 254, 255, 1000}) {
+            std::vector<sz_size_t> expected(candidates.size());
+            for (std::size_t i = 0; i != candidates.size(); ++i)
+                expected[i] = sz_edit_distance_serial(query.data(), query.size(), candidates[i].data(),
+                                                      candidates[i].size(), bound, NULL);
+            auto check_batch = [&](sz_edit_distances_batch_t edit_distances_batch) {
+                std::vector<sz_size_t> distances(candidates.size());
+                bool succeeded = edit_distances_batch(query.data(), query.size(), &sequence, bound, distances.data(),
+                                                      NULL) == sz_true_k;
+                assert(succeeded && distances == expected);
+            };
+            check_batch(sz_edit_distances_batch);
+            check_batch(sz_edit_distances_batch_serial);
+#if SZ_USE_X86_AVX512
+            check_batch(sz_edit_distances_batch_avx512);
+#endif
+        }
+    }
 }
 
 /**
@@ -1233,6 +2453,486 @@ static void test_sequence_algorithms() {
             for (std::size_t i = 1; i != dataset_size; ++i) { assert(dataset[order[i - 1]] <= dataset[order[i]]); }
         }
     }
+
+    // Parallel sorting with a simple thread-spawning executor, that must produce the same order.
+    auto spawning_executor = [](std::size_t tasks_count, std::function<void(std::size_t)> const &task) {
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i != tasks_count; ++i) threads.emplace_back(task, i);
+        for (auto &thread : threads) thread.join();
+    };
+    for (std::size_t dataset_size : {100, 10000, 100000}) {
+        strs_t dataset;
+        for (std::size_t i = 0; i != dataset_size; ++i)
+            dataset.push_back(sz::scripts::random_string(i % 32, "abcdefghijklmnopqrstuvwxyz", i % 26 + 1));
+
+        order_t order(dataset_size);
+        sz::sorted_order(dataset.data(), dataset.data() + dataset_size, order.data(),
+                         [](std::string const &s) -> sz::string_view { return s; }, spawning_executor, 4);
+        for (std::size_t i = 1; i != dataset_size; ++i) { assert(dataset[order[i - 1]] <= dataset[order[i]]); }
+        std::sort(order.begin(), order.end());
+        for (std::size_t i = 0; i != dataset_size; ++i) { assert(order[i] == i); }
+    }
+
+    // Stable sorting must match `std::stable_sort`, even with long shared prefixes, zero bytes, and empty strings.
+    for (std::size_t dataset_size : {10, 100, 1000, 10000}) {
+        strs_t dataset;
+        for (std::size_t i = 0; i != dataset_size; ++i) {
+            std::string suffix = sz::scripts::random_string(i % 24, "ab\0", 3);
+            dataset.push_back(i % 3 == 0 ? suffix : i % 3 == 1 ? "https://www." + suffix : "https://www.example.com/");
+        }
+        dataset.push_back(std::string());
+
+        sz_sequence_t sequence;
+        order_t order(dataset.size()), expected(dataset.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::iota(expected.begin(), expected.end(), 0);
+        sequence.order = order.data();
+        sequence.count = dataset.size();
+        sequence.handle = &dataset;
+        sequence.get_start = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_cptr_t {
+            return (*reinterpret_cast<strs_t const *>(sequence->handle))[i].data();
+        };
+        sequence.get_length = [](sz_sequence_t const *sequence, sz_size_t i) -> sz_size_t {
+            return (*reinterpret_cast<strs_t const *>(sequence->handle))[i].size();
+        };
+        assert(sz_sort_stable(&sequence, NULL));
+        std::stable_sort(expected.begin(), expected.end(),
+                         [&](std::size_t i, std::size_t j) { return dataset[i] < dataset[j]; });
+        assert(order == expected);
+    }
+}
+
+/**
+ *  @brief  Tests the flat hash containers against the STL ones, mixing inline and arena-backed keys,
+ *          interleaving insertions and erasures to exercise the tombstones and rehashing.
+ */
+static void test_flat_containers() {
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i != 3000; ++i)
+        keys.push_back(sz::scripts::random_string(i % 50, "ab\0", 3) + std::to_string(i % 1500));
+
+    sz::flat_map<std::size_t> map;
+    sz::flat_set set;
+    std::unordered_map<std::string, std::size_t> expected;
+    for (std::size_t i = 0; i != keys.size(); ++i) {
+        std::string const &key = keys[i];
+        bool inserted = expected.emplace(key, i).second;
+        auto map_result = map.try_emplace(key, i);
+        auto set_result = set.insert(key);
+        assert(map_result.second == inserted && set_result.second == inserted);
+        assert((*map_result.first).first == key && *set_result.first == key);
+        assert(map_result.first->second == expected[key]);
+
+        // Erase every third key shortly after inserting, to leave tombstones behind.
+        if (i % 3 == 0 && i > 10) {
+            std::string const &victim = keys[i - 10];
+            std::size_t erased = expected.erase(victim);
+            assert(map.erase(victim) == erased && set.erase(victim) == erased);
+            assert(!map.contains(victim) && !set.contains(victim));
+        }
+    }
+
+    assert(map.size() == expected.size() && set.size() == expected.size());
+    for (auto const &entry : expected) {
+        assert(map.at(entry.first) == entry.second && map[entry.first] == entry.second);
+        assert(set.count(entry.first) == 1);
+    }
+    std::size_t visited = 0;
+    for (auto entry : map) assert(expected.at(std::string(entry.first)) == entry.second), ++visited;
+    for (sz::string_view key : set) assert(expected.count(std::string(key)) == 1), ++visited;
+    assert(visited == 2 * expected.size());
+    assert(map.find("missing") == map.end() && set.find("missing") == set.end());
+
+    // Copies must own their keys, as the original arena is released on `clear`.
+    sz::flat_map<std::size_t> map_copy = map;
+    sz::flat_set set_copy = set;
+    map.clear(), set.clear();
+    assert(map.empty() && set.empty() && map.begin() == map.end() && set.begin() == set.end());
+    assert(map_copy.size() == expected.size() && set_copy.size() == expected.size());
+    for (auto const &entry : expected) assert(map_copy.at(entry.first) == entry.second && set_copy.contains(entry.first));
+
+    sz::flat_map<std::size_t> map_moved = std::move(map_copy);
+    map_moved["new"] += 42;
+    map_moved.insert_or_assign("new", 7);
+    assert(map_moved.size() == expected.size() + 1 && map_moved.at("new") == 7);
+    assert((sz::flat_set {"a", "b", "a"}.size() == 2));
+}
+
+/**
+ *  @brief  Tests the suffix arrays and the queries of the suffix index on top of them against naive scans,
+ *          on random and highly repetitive texts, as well as its serialization into memory-mapped files.
+ */
+static void test_suffix_index() {
+    auto check = [](std::string const &text) {
+        std::vector<sz_sorted_idx_t> expected(text.size());
+        std::iota(expected.begin(), expected.end(), 0);
+        std::sort(expected.begin(), expected.end(), [&](sz_sorted_idx_t a, sz_sorted_idx_t b) {
+            return std::string_view(text).substr(a) < std::string_view(text).substr(b);
+        });
+        sz::suffix_index index(sz::string_view(text.data(), text.size()));
+        assert(index.size() == text.size());
+        assert(std::equal(expected.begin(), expected.end(), index.suffixes()));
+
+        // Query every substring of a few lengths, and some strings that may be missing.
+        std::vector<std::string> needles;
+        for (std::size_t length : {1, 2, 3, 8, 20})
+            for (std::size_t offset = 0; offset + length <= text.size(); offset += 1 + text.size() / 16)
+                needles.push_back(text.substr(offset, length));
+        for (std::size_t length = 1; length != 10; ++length) needles.push_back(random_string(length, "abcz", 4));
+
+        for (std::string const &needle : needles) {
+            std::vector<std::size_t> offsets;
+            for (std::size_t offset = text.find(needle); offset != std::string::npos;
+                 offset = text.find(needle, offset + 1))
+                offsets.push_back(offset);
+            assert(index.count(sz::string_view(needle)) == offsets.size());
+            auto matches = index.find_all(sz::string_view(needle));
+            std::vector<std::size_t> found(matches.begin(), matches.end());
+            std::sort(found.begin(), found.end());
+            assert(found == offsets);
+
+            std::size_t longest = 0;
+            while (longest != needle.size() && text.find(needle.substr(0, longest + 1)) != std::string::npos)
+                ++longest;
+            sz::string_view prefix = index.longest_prefix(sz::string_view(needle));
+            assert(prefix.size() == longest);
+            assert(prefix == sz::string_view(needle).sub(0, longest));
+            assert(prefix.data() >= index.text().data() && prefix.end() <= index.text().end());
+        }
+    };
+
+    check("");
+    check("a");
+    check("banana");
+    check("mississippi");
+    check(std::string("a\0b\0a\0", 6));
+    check(std::string(300, 'a'));
+    std::string periodic;
+    for (std::size_t i = 0; i != 100; ++i) periodic += "abcab";
+    check(periodic);
+    for (std::size_t length = 1; length < 200; length += 7) check(random_string(length, "ab", 2));
+    for (std::size_t length = 1; length < 2000; length += 333) check(random_string(length, "abc\0\xFF", 5));
+
+    // Save, memory-map, and query the index without rebuilding it.
+    char const *path = "stringzilla_test_suffix_index.sfx";
+    std::string text = random_string(5000, "acgt", 4);
+    sz::suffix_index built(sz::string_view(text.data(), text.size()));
+    built.save(path);
+    {
+        sz::mapped_file file(path);
+        assert(file.size() == built.serialized_size());
+        sz::suffix_index opened = sz::suffix_index::open(file.view());
+        assert(opened.text() == built.text() && opened.text().data() != built.text().data());
+        assert(std::equal(built.suffixes(), built.suffixes() + text.size(), opened.suffixes()));
+        sz::string_view needle = built.text().sub(100, 104);
+        assert(opened.count(needle) == built.count(needle) && opened.count(needle) > 0);
+
+        sz::suffix_index moved(std::move(opened));
+        assert(opened.empty() && moved.size() == text.size());
+
+        // Truncated and unrelated buffers are rejected.
+        assert(!opened.try_open(file.view().sub(0, file.size() - 1)));
+        bool thrown = false;
+        try {
+            sz::suffix_index::open(sz::string_view(text.data(), text.size()));
+        }
+        catch (std::invalid_argument const &) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::remove(path);
+}
+
+/**
+ *  @brief  Tests the fused top-k fingerprint scans of every available backend against a brute-force baseline,
+ *          as well as the fingerprint index, its LSH buckets, and its serialization into memory-mapped files.
+ */
+static void test_fingerprint_index() {
+    auto popcount = [](sz_u8_t byte) {
+        std::size_t bits = 0;
+        for (; byte; byte &= byte - 1) ++bits;
+        return bits;
+    };
+    auto baseline = [&](std::vector<sz_u8_t> const &query, std::vector<sz_u8_t> const &column, std::size_t bytes,
+                        std::vector<sz_sorted_idx_t> const &ids, std::size_t k, sz_fingerprint_metric_t metric) {
+        std::vector<sz_fingerprint_match_t> matches;
+        for (sz_sorted_idx_t id : ids) {
+            sz_fingerprint_match_t match = {id, 0, 0};
+            for (std::size_t i = 0; i != bytes; ++i)
+                match.intersection += popcount(query[i] & column[id * bytes + i]),
+                    match.union_size += popcount(query[i] | column[id * bytes + i]);
+            matches.push_back(match);
+        }
+        auto is_better = [&](sz_fingerprint_match_t const &a, sz_fingerprint_match_t const &b) {
+            std::size_t a_inter = a.union_size ? a.intersection : 1, a_union = a.union_size ? a.union_size : 1;
+            std::size_t b_inter = b.union_size ? b.intersection : 1, b_union = b.union_size ? b.union_size : 1;
+            if (metric == sz_fingerprint_hamming_k && a_union - a_inter != b_union - b_inter)
+                return a.union_size - a.intersection < b.union_size - b.intersection;
+            if (metric == sz_fingerprint_jaccard_k && a_inter * b_union != b_inter * a_union)
+                return a_inter * b_union > b_inter * a_union;
+            return a.id < b.id;
+        };
+        std::sort(matches.begin(), matches.end(), is_better);
+        if (matches.size() > k) matches.resize(k);
+        return matches;
+    };
+
+    auto check = [&](sz_fingerprints_top_k_t top_k, std::size_t bytes, std::size_t count, std::size_t k,
+                     bool subset) {
+        // Sparse random fingerprints with a few duplicates and empty ones, to exercise the ties.
+        std::uniform_int_distribution<int> bit_distribution(0, 7);
+        auto random_fingerprint = [&](std::size_t bits_set) {
+            std::vector<sz_u8_t> fingerprint(bytes, 0);
+            for (std::size_t i = 0; i != bits_set && bytes; ++i)
+                fingerprint[sz::scripts::global_random_generator()() % bytes] |=
+                    (sz_u8_t)(1u << bit_distribution(sz::scripts::global_random_generator()));
+            return fingerprint;
+        };
+        std::vector<sz_u8_t> column, query = random_fingerprint(bytes * 2);
+        for (std::size_t i = 0; i != count; ++i) {
+            std::vector<sz_u8_t> fingerprint = i % 7 == 3 ? query : random_fingerprint(i % 5 == 0 ? 0 : bytes * 2);
+            column.insert(column.end(), fingerprint.begin(), fingerprint.end());
+        }
+        std::vector<sz_sorted_idx_t> ids;
+        for (std::size_t i = 0; i != count; ++i)
+            if (!subset || i % 3 != 1) ids.push_back(i);
+
+        for (sz_fingerprint_metric_t metric : {sz_fingerprint_jaccard_k, sz_fingerprint_hamming_k}) {
+            std::vector<sz_fingerprint_match_t> expected = baseline(query, column, bytes, ids, k, metric);
+            std::vector<sz_fingerprint_match_t> matches(k + 1);
+            std::size_t reported = top_k((sz_cptr_t)query.data(), (sz_cptr_t)column.data(), bytes,
+                                         subset ? ids.data() : nullptr, ids.size(), k, metric, matches.data());
+            assert(reported == expected.size());
+            for (std::size_t i = 0; i != reported; ++i)
+                assert(matches[i].id == expected[i].id && matches[i].intersection == expected[i].intersection &&
+                       matches[i].union_size == expected[i].union_size);
+        }
+    };
+
+    std::vector<sz_fingerprints_top_k_t> backends = {sz_fingerprints_top_k_serial, sz_fingerprints_top_k};
+#if SZ_USE_X86_AVX512
+    backends.push_back(sz_fingerprints_top_k_avx512);
+#endif
+#if SZ_USE_ARM_NEON
+    backends.push_back(sz_fingerprints_top_k_neon);
+#endif
+    for (sz_fingerprints_top_k_t top_k : backends)
+        for (std::size_t bytes : {1, 7, 8, 16, 63, 64, 65, 128, 200})
+            for (std::size_t count : {0, 1, 5, 100})
+                for (std::size_t k : {0, 1, 3, 10, 200})
+                    check(top_k, bytes, count, k, false), check(top_k, bytes, count, k, true);
+
+    // The index pads the fingerprints to cache lines, which doesn't affect the scores.
+    using index_t = sz::fingerprint_index<1024>;
+    static_assert(index_t::stride_k == 128, "1024-bit fingerprints take two cache lines");
+    std::vector<std::string> documents;
+    for (std::size_t i = 0; i != 300; ++i) documents.push_back(sz::scripts::random_string(200, "abcdefgh", 8));
+    index_t index;
+    for (std::string const &document : documents)
+        index.push_back(sz::hashes_fingerprint<1024>(sz::string_view(document), 4));
+    assert(index.size() == documents.size() && reinterpret_cast<std::uintptr_t>(index.data()) % 64 == 0);
+    assert(index[17] == sz::hashes_fingerprint<1024>(sz::string_view(documents[17]), 4));
+
+    // A slightly edited document must be found as the nearest neighbor, with and without the buckets.
+    std::string edited = documents[42];
+    edited[100] = 'z';
+    std::bitset<1024> query = sz::hashes_fingerprint<1024>(sz::string_view(edited), 4);
+    std::vector<sz_fingerprint_match_t> exhaustive = index.search(query, 5);
+    assert(exhaustive.size() == 5 && exhaustive[0].id == 42);
+    assert(index.search(query, 5, sz_fingerprint_hamming_k)[0].id == 42);
+    assert(index.search_buckets(query, 5).size() == 5); // No buckets yet, so it's exhaustive.
+
+    assert(!index.try_build_buckets(129) && index.bands() == 0);
+    index.build_buckets(16);
+    assert(index.bands() == 16);
+    std::vector<sz_fingerprint_match_t> bucketed = index.search_buckets(query, 5);
+    assert(!bucketed.empty() && bucketed.size() <= 5 && bucketed[0].id == 42);
+    for (std::size_t i = 1; i < bucketed.size(); ++i) assert(bucketed[i].id != 42);
+
+    // Save, memory-map, and query the index without rebuilding it.
+    char const *path = "stringzilla_test_fingerprint_index.fpi";
+    index.save(path);
+    {
+        sz::mapped_file file(path);
+        assert(file.size() == index.serialized_size());
+        index_t opened = index_t::open(file.view());
+        assert(opened.size() == index.size() && opened.bands() == 16 && opened.data() != index.data());
+        std::vector<sz_fingerprint_match_t> reopened = opened.search_buckets(query, 5);
+        assert(reopened.size() == bucketed.size());
+        for (std::size_t i = 0; i != reopened.size(); ++i) assert(reopened[i].id == bucketed[i].id);
+
+        // Appending to an opened index copies it, dropping the buckets.
+        opened.push_back(query);
+        assert(opened.size() == index.size() + 1 && opened.bands() == 0 && opened.search(query, 1)[0].id == 300);
+
+        // Truncated buffers and fingerprints of a different width are rejected.
+        assert(!opened.try_open(file.view().sub(0, file.size() - 1)));
+        assert(!sz::fingerprint_index<512>().try_open(file.view()));
+        bool thrown = false;
+        try {
+            index_t::open(sz::string_view(edited.data(), edited.size()));
+        }
+        catch (std::invalid_argument const &) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    std::remove(path);
+}
+
+/**
+ *  @brief  Tests the tapes, the loser-tree `sz_merge_runs`, and the `sz::external_sort` of files split into
+ *          many memory-mapped runs, comparing against `std::sort`.
+ */
+static void test_external_sort() {
+    // Merging in-memory runs of different lengths, including empty ones, must be stable across runs.
+    auto check_merge = [](std::vector<std::vector<std::string>> runs) {
+        std::vector<std::pair<std::string, std::size_t>> expected;
+        std::vector<std::string> tapes_data(runs.size());
+        std::vector<std::vector<sz_u64_t>> tapes_offsets(runs.size());
+        std::vector<sz_tape_t> tapes(runs.size());
+        std::vector<sz_sequence_t> sequences(runs.size());
+        for (std::size_t run = 0; run != runs.size(); ++run) {
+            std::sort(runs[run].begin(), runs[run].end());
+            tapes_offsets[run].push_back(0);
+            for (std::string const &member : runs[run])
+                expected.emplace_back(member, run), tapes_data[run] += member,
+                    tapes_offsets[run].push_back(tapes_data[run].size());
+            tapes[run] = {tapes_data[run].data(), tapes_offsets[run].data(), runs[run].size()};
+            sz_sequence_from_u64tape(&tapes[run], nullptr, &sequences[run]);
+        }
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](auto const &a, auto const &b) { return a.first < b.first; });
+
+        std::vector<std::pair<std::string, std::size_t>> merged;
+        bool succeeded = sz_merge_runs(
+            sequences.data(), sequences.size(),
+            [](sz_cptr_t start, sz_size_t length, sz_size_t run, void *handle) {
+                auto &merged = *reinterpret_cast<std::vector<std::pair<std::string, std::size_t>> *>(handle);
+                merged.emplace_back(std::string(start, length), run);
+            },
+            &merged, nullptr);
+        assert(succeeded && merged == expected);
+    };
+    check_merge({});
+    check_merge({{}});
+    check_merge({{"b", "a"}});
+    check_merge({{"abc", "ab"}, {}, {"ab", std::string("ab\0", 3)}, {"abcdefghij", "abcdefghi", "abcdefgh"}});
+    check_merge({{"same", "same"}, {"same"}, {"same", "other"}});
+    for (std::size_t runs_count : {2, 3, 7, 16, 33}) {
+        std::vector<std::vector<std::string>> runs(runs_count);
+        for (std::size_t i = 0; i != runs_count * 20; ++i)
+            runs[i % runs_count].push_back(random_string(i % 13, "ab\0", 3));
+        check_merge(runs);
+    }
+
+    // Serialized tapes must be validated, including the 32-bit offsets.
+    {
+        sz_u64_t buffer[16] = {0};
+        sz_tape_header(2, 4, (sz_ptr_t)buffer);
+        sz_u32_t offsets[3] = {0, 3, 5};
+        std::memcpy((char *)buffer + SZ_TAPE_HEADER_SIZE, offsets, sizeof(offsets));
+        std::memcpy((char *)buffer + SZ_TAPE_HEADER_SIZE + sizeof(offsets), "abcde", 5);
+        sz_size_t const size = SZ_TAPE_HEADER_SIZE + sizeof(offsets) + 5;
+        sz_tape_t tape;
+        sz_size_t offset_bytes = 0;
+        assert(sz_tape_parse((sz_cptr_t)buffer, size, &tape, &offset_bytes) && offset_bytes == 4 && tape.count == 2);
+        sz_sorted_idx_t order[2] = {7, 7};
+        sz_sequence_t sequence;
+        sz_sequence_from_u32tape(&tape, order, &sequence);
+        assert(order[0] == 0 && order[1] == 1 && sequence.count == 2);
+        assert(sz::string_view(sequence.get_start(&sequence, 1), sequence.get_length(&sequence, 1)) == "de");
+        assert(!sz_tape_parse((sz_cptr_t)buffer, size - 1, &tape, &offset_bytes));
+        assert(!sz_tape_parse((sz_cptr_t)buffer, SZ_TAPE_HEADER_SIZE, &tape, &offset_bytes));
+    }
+
+    // Sort files through the temporary runs, with the records larger and smaller than the runs.
+    char const *input_path = "stringzilla_test_external_sort.txt";
+    char const *output_path = "stringzilla_test_external_sort.sorted.txt";
+    auto check_file = [&](std::string const &text, std::size_t run_bytes, char separator) {
+        std::vector<std::string> records;
+        for (std::size_t offset = 0; offset < text.size();) {
+            std::size_t end = text.find(separator, offset);
+            if (end == std::string::npos) end = text.size();
+            records.push_back(text.substr(offset, end - offset));
+            offset = end + 1;
+        }
+        std::sort(records.begin(), records.end());
+        std::string expected;
+        for (std::string const &record : records) expected += record, expected += separator;
+
+        std::FILE *file = std::fopen(input_path, "wb");
+        assert(file);
+        std::fwrite(text.data(), 1, text.size(), file);
+        std::fclose(file);
+        {
+            sz::mapped_file input(input_path, sz::mapped_file::sequential);
+            sz::external_sort(input.view(), output_path, run_bytes, separator);
+            sz::mapped_file output(output_path);
+            assert(output.view() == sz::string_view(expected.data(), expected.size()));
+        }
+        // The runs are removed, once they are merged.
+        assert(!sz::mapped_file().try_open((std::string(output_path) + ".0.run").c_str()));
+        std::remove(input_path);
+        std::remove(output_path);
+    };
+    check_file("", 10, '\n');
+    check_file("\n", 10, '\n');
+    check_file("b\na\n\nc", 1, '\n');
+    check_file("delta,alpha,charlie,bravo,", 8, ',');
+    for (std::size_t run_bytes : {1, 17, 100, 1000, 100000}) {
+        std::string text;
+        for (std::size_t i = 0; i != 2000; ++i) text += random_string(i % 23, "abcd\0\xFF", 6), text += '\n';
+        check_file(text, run_bytes, '\n');
+    }
+}
+
+/**
+ *  @brief  Tests memory-mapping files with different access-pattern hints, including empty and missing files.
+ */
+static void test_mapped_file() {
+    char const *path = "stringzilla_test_mapped_file.txt";
+    std::string content;
+    for (std::size_t i = 0; i != 100000; ++i) content += "line " + std::to_string(i) + "\n";
+
+    std::FILE *file = std::fopen(path, "wb");
+    assert(file);
+    std::fwrite(content.data(), 1, content.size(), file);
+    std::fclose(file);
+
+    unsigned const hints[] = {
+        sz::mapped_file::none,
+        sz::mapped_file::sequential,
+        sz::mapped_file::random,
+        sz::mapped_file::sequential | sz::mapped_file::huge_pages | sz::mapped_file::populate,
+    };
+    for (unsigned file_hints : hints) {
+        sz::mapped_file mapped(path, file_hints);
+        assert(mapped.size() == content.size());
+        assert(mapped.view() == sz::string_view(content));
+        assert(mapped.view().find_all("\n").size() == 100000);
+
+        sz::mapped_file moved(std::move(mapped));
+        assert(mapped.empty() && moved.size() == content.size());
+    }
+
+    // Empty files are valid inputs, but missing ones aren't.
+    file = std::fopen(path, "wb");
+    assert(file);
+    std::fclose(file);
+    sz::mapped_file empty;
+    assert(empty.try_open(path) && empty.empty() && empty.view() == "");
+    std::remove(path);
+    assert(!empty.try_open(path));
+    bool thrown = false;
+    try {
+        sz::mapped_file missing(path);
+    }
+    catch (std::runtime_error const &) {
+        thrown = true;
+    }
+    assert(thrown);
 }
 
 int main(int argc, char const **argv) {
@@ -1244,6 +2944,7 @@ int main(int argc, char const **argv) {
     std::printf("- Uses AVX512: %s \n", SZ_USE_X86_AVX512 ? "yes" : "no");
     std::printf("- Uses NEON: %s \n", SZ_USE_ARM_NEON ? "yes" : "no");
     std::printf("- Uses SVE: %s \n", SZ_USE_ARM_SVE ? "yes" : "no");
+    std::printf("- Uses SVE2: %s \n", SZ_USE_ARM_SVE2 ? "yes" : "no");
 
     // Basic utilities
     test_arithmetical_utilities();
@@ -1269,22 +2970,46 @@ int main(int argc, char const **argv) {
     test_constructors();
     test_memory_stability_for_length(1024);
     test_memory_stability_for_length(14);
+    test_memory_arena();
     test_updates();
 
     // Advanced search operations
     test_stl_conversion_api();
     test_comparisons();
+    test_hashing();
+    test_hashing_sketches();
+    test_case_folding();
+    test_translate();
+    test_utf8();
     test_search();
 #if SZ_DETECT_CPP_17 && __cpp_lib_string_view
     test_search_with_misaligned_repetitions();
 #endif
+    test_search_prepared();
+    test_search_static();
+    test_search_fuzzy();
+    test_search_multi_pattern();
+    test_search_streaming();
+    test_split_offsets();
+    test_search_parallel();
 
     // Similarity measures and fuzzy search
     test_levenshtein_distances();
+    test_levenshtein_distances_batch();
+    test_alignment_scores();
 
     // Sequences of strings
     test_sequence_algorithms();
 
+    // Associative containers
+    test_flat_containers();
+
+    // Operating system integrations
+    test_mapped_file();
+    test_suffix_index();
+    test_fingerprint_index();
+    test_external_sort();
+
     std::printf("All tests passed... Unbelievable!\n");
     return 0;
 }
@@ -64,7 +64,9 @@ inline std::string random_string(std::size_t length, char const *alphabet, std::
  *  @brief  Inefficient baseline Levenshtein distance computation, as implemented in most codebases.
  *          Allocates a new matrix on every call, with rows potentially scattered around memory.
  */
-inline std::size_t levenshtein_baseline(char const *s1, std::size_t len1, char const *s2, std::size_t len2) {
+template <typename char_type_>
+inline std::size_t levenshtein_baseline(char_type_ const *s1, std::size_t len1, char_type_ const *s2,
+                                        std::size_t len2) {
     std::vector<std::vector<std::size_t>> dp(len1 + 1, std::vector<std::size_t>(len2 + 1));
 
     // Initialize the borders of the matrix.
@@ -68,3 +68,66 @@ test('Count Words - Empty String Inputs', () => {
     const result_3 = stringzilla.count('', '');
     assert.strictEqual(result_3, 0n);
 });
+
+test('Buffers and Typed Arrays - Zero-Copy Inputs', () => {
+    const haystack = Buffer.from('hello world, hello john');
+    assert.strictEqual(stringzilla.indexOf(haystack, Buffer.from('john')), 19n);
+    assert.strictEqual(stringzilla.indexOf(haystack, 'world'), 6n);
+    assert.strictEqual(stringzilla.count(new Uint8Array([1, 2, 1, 2, 1]), new Uint8Array([1, 2, 1]), true), 2n);
+    assert.strictEqual(stringzilla.indexOf(haystack.subarray(7), 'hello'), 6n);
+    assert.throws(() => stringzilla.indexOf(42, 'a'), TypeError);
+});
+
+test('Find All - Offsets as BigUint64Array', () => {
+    const result_1 = stringzilla.findAll('abababab', 'aba');
+    assert.ok(result_1 instanceof BigUint64Array);
+    assert.deepStrictEqual(Array.from(result_1), [0n, 4n]);
+
+    const result_2 = stringzilla.findAll(Buffer.from('abababab'), 'aba', true);
+    assert.deepStrictEqual(Array.from(result_2), [0n, 2n, 4n]);
+
+    assert.strictEqual(stringzilla.findAll('hello', '').length, 0);
+    assert.strictEqual(stringzilla.findAll('hello', 'xyz').length, 0);
+});
+
+test('Split - Strings and Buffer Views', () => {
+    assert.deepStrictEqual(stringzilla.split('a,b,,c', ','), ['a', 'b', '', 'c']);
+    assert.deepStrictEqual(stringzilla.split('abc', ','), ['abc']);
+
+    const buffer = Buffer.from('key=value');
+    const parts = stringzilla.split(buffer, '=');
+    assert.strictEqual(parts.length, 2);
+    assert.strictEqual(parts[1].buffer, buffer.buffer);
+    assert.strictEqual(Buffer.from(parts[1]).toString(), 'value');
+    assert.throws(() => stringzilla.split('abc', ''), RangeError);
+});
+
+test('Hash - Strings and Buffers Match', () => {
+    assert.strictEqual(stringzilla.hash('hello'), stringzilla.hash(Buffer.from('hello')));
+    assert.notStrictEqual(stringzilla.hash('hello'), stringzilla.hash('world'));
+});
+
+test('Edit Distance', () => {
+    assert.strictEqual(stringzilla.editDistance('kitten', 'sitting'), 3n);
+    assert.strictEqual(stringzilla.editDistance(Buffer.from('abc'), 'abc'), 0n);
+    assert.strictEqual(stringzilla.editDistance('', 'abc'), 3n);
+    assert.strictEqual(stringzilla.editDistance('kitten', 'sitting', 2), 2n);
+});
+
+test('Sort - Stable Lexicographic Order', () => {
+    assert.deepStrictEqual(stringzilla.sort(['b', 'a', 'ab', '']), ['', 'a', 'ab', 'b']);
+
+    const first = Buffer.from('x'), second = Buffer.from('x');
+    const sorted = stringzilla.sort([second, Buffer.from('a'), first]);
+    assert.strictEqual(sorted[1], second);
+    assert.strictEqual(sorted[2], first);
+});
+
+test('Async Kernels', async () => {
+    assert.strictEqual(await stringzilla.indexOfAsync('hello world', 'world'), 6n);
+    assert.strictEqual(await stringzilla.indexOfAsync(Buffer.from('hello'), 'z'), -1n);
+    assert.strictEqual(await stringzilla.countAsync('abababab', 'aba', true), 3n);
+    assert.deepStrictEqual(Array.from(await stringzilla.findAllAsync('abababab', 'aba')), [0n, 4n]);
+    assert.strictEqual(await stringzilla.hashAsync('hello'), stringzilla.hash('hello'));
+    assert.strictEqual(await stringzilla.editDistanceAsync('kitten', 'sitting'), 3n);
+});
@@ -13,6 +13,63 @@ def test_library_properties():
     assert "serial" in sz.__capabilities__.split(","), "Serial backend must be present"
 
 
+def test_library_stats_and_overrides():
+    sz.reset_stats()
+    sz.enable_stats()
+    try:
+        haystack = "abc" * 1000
+        assert sz.find(haystack, "cab") == 2
+        assert sz.count(haystack, "abc") == 1000
+        stats = sz.stats()
+        assert stats["sz_find"]["calls"] > 0 and stats["sz_find"]["bytes"] >= len(haystack)
+        assert stats["sz_find"]["cycles"] == 0, "Cycles are only counted on request"
+        assert stats["sz_edit_distance"]["calls"] == 0
+
+        # Forcing the serial backend changes the implementation, but not the results
+        default_caps = sz.__capabilities__
+        try:
+            assert sz.override_capabilities("serial") == "serial,"
+            assert all(kernel["backend"] == "serial" for kernel in sz.stats().values())
+            assert sz.find(haystack, "cab") == 2
+        finally:
+            assert sz.override_capabilities(default_caps) == default_caps
+    finally:
+        sz.disable_stats()
+        sz.reset_stats()
+
+    assert sz.find("abc", "c") == 2
+    assert sz.stats()["sz_find"]["calls"] == 0, "Disabled statistics must not be collected"
+
+
+def test_library_capabilities_gating():
+    default_caps = sz.__capabilities__
+    detected = set(default_caps.split(","))
+
+    # On Linux the kernel reports the same CPUID bits, so the detection can be cross-checked
+    try:
+        with open("/proc/cpuinfo") as cpuinfo:
+            flags = next((line.split(":")[1].split() for line in cpuinfo if line.startswith("flags")), [])
+    except OSError:
+        flags = []
+    if "avx512bw" in flags:
+        assert ("avx512vbmi" in detected) == ("avx512vbmi" in flags)
+        assert ("gfni" in detected) == ("gfni" in flags)
+
+    # The VBMI byte permutations must never be picked without VBMI, even if the rest of AVX-512 is there
+    try:
+        sz.override_capabilities("avx2,avx512f,avx512vl,avx512bw,avx512vpopcntdq")
+        assert sz.stats()["sz_translate"]["backend"] != "avx512"
+        assert sz.stats()["sz_split_offsets"]["backend"] != "avx512"
+        assert list(Str("a\nbc\n\nd" * 40).split("\n")) == ("a\nbc\n\nd" * 40).split("\n")
+        if "avx512vbmi" in detected:
+            sz.override_capabilities("avx512f,avx512vl,avx512bw,avx512vbmi")
+            assert sz.stats()["sz_translate"]["backend"] == "avx512"
+            assert sz.stats()["sz_split_offsets"]["backend"] == "avx512"
+            assert list(Str("a\nbc\n\nd" * 40).split("\n")) == ("a\nbc\n\nd" * 40).split("\n")
+    finally:
+        assert sz.override_capabilities(default_caps) == default_caps
+
+
 def test_unit_construct():
     native = "aaaaa"
     big = Str(native)
@@ -34,6 +91,17 @@ def test_unit_count():
     assert big.count("aa", allowoverlap=True) == 4
 
 
+def test_unit_count_parallel():
+    # Large enough to be split into several shards, with matches straddling their boundaries
+    native = "ab" * 3_000_001 + "a" * 1_000_003
+    big = Str(native)
+    for threads in (0, 2, 7):
+        assert big.count("ab", threads=threads) == native.count("ab")
+        assert big.count("aaa", threads=threads) == native.count("aaa")
+        assert big.count("aa", allowoverlap=True, threads=threads) == 1_000_002
+        assert big.count("ba", start=5, end=-5, threads=threads) == native[5:-5].count("ba")
+
+
 def test_unit_contains():
     big = Str("abcdef")
     assert "a" in big
@@ -41,6 +109,87 @@ def test_unit_contains():
     assert "xxx" not in big
 
 
+def test_unit_find_any():
+    big = Str("say hello world")
+    assert big.find_any(["world", "hello", "hell"]) == (4, 1)
+    assert big.find_any(["world", "hell", "hello"]) == (4, 1)
+    assert big.find_any(["o"], start=5) == (8, 0)
+    assert big.find_any(["xyz", ""]) == (-1, -1)
+    assert big.find_any([]) == (-1, -1)
+    assert sz.find_any("abcdef", ["ef", "cd"]) == (2, 1)
+
+
+def test_unit_find_fuzzy():
+    big = Str("scanned Stringzi1la page")
+    assert big.find_fuzzy("StringZilla", 2) == (8, 11)
+    assert big.find_fuzzy("StringZilla", max_edits=0) == (-1, 0)
+    assert big.find_fuzzy("page", 0, start=10) == (20, 4)
+    assert sz.find_fuzzy("xabcdx", "abcd") == (1, 4)
+    assert sz.find_fuzzy("abc", "") == (-1, 0)
+
+
+def test_unit_file(tmp_path):
+    path = tmp_path / "file.txt"
+    path.write_text("hello\nworld\n")
+    assert Str(sz.File(str(path))).count("\n") == 2
+    hinted = sz.File(str(path), sequential=True, huge_pages=True, populate=True)
+    assert Str(hinted) == "hello\nworld\n"
+    assert Str(sz.File(str(path), random=True)).split("\n")[1] == "world"
+
+    path.write_text("")
+    assert len(Str(sz.File(str(path)))) == 0
+    with pytest.raises(RuntimeError):
+        sz.File(str(tmp_path / "missing.txt"))
+
+
+def test_unit_suffix_index(tmp_path):
+    text = "mississippi"
+    index = sz.SuffixIndex(text)
+    assert len(index) == len(text)
+    assert index.count("ssi") == 2 and index.count("x") == 0
+    assert sorted(index.find_all("i")) == [1, 4, 7, 10]
+    assert sorted(index.find_all("issi")) == [1, 4]
+    assert index.longest_prefix("sippy") == (6, 4)
+    assert index.longest_prefix("xyz")[1] == 0
+
+    # Serialized indexes are memory-mapped and queried without rebuilding
+    path = tmp_path / "index.sfx"
+    index.save(str(path))
+    opened = sz.SuffixIndex.open(sz.File(str(path)))
+    assert len(opened) == len(text)
+    assert sorted(opened.find_all("ss")) == [2, 5]
+    plain = tmp_path / "plain.txt"
+    plain.write_text(text)
+    with pytest.raises(ValueError):
+        sz.SuffixIndex.open(sz.File(str(plain)))
+    assert sz.SuffixIndex(sz.File(str(plain))).count("ss") == 2
+
+
+def test_unit_external_sort(tmp_path):
+    lines = ["".join(choice("abc\xff") for _ in range(i % 17)) for i in range(500)]
+    source = tmp_path / "lines.txt"
+    source.write_bytes("\n".join(lines).encode("latin-1"))
+    expected = b"".join(line.encode("latin-1") + b"\n" for line in sorted(lines, key=lambda x: x.encode("latin-1")))
+
+    # Small runs force many temporary files, that are removed after the merge
+    for run_bytes in [1, 100, 1 << 20]:
+        output = tmp_path / "sorted.txt"
+        sz.File(str(source)).external_sort(str(output), run_bytes=run_bytes)
+        assert output.read_bytes() == expected
+        assert sorted(p.name for p in tmp_path.iterdir()) == ["lines.txt", "sorted.txt"]
+
+    # Strs are sorted into a file, without being reordered themselves
+    strs = Str("delta,alpha,charlie,bravo").split(",")
+    strs.external_sort(str(tmp_path / "strs.txt"), run_bytes=8, separator=";")
+    assert (tmp_path / "strs.txt").read_text() == "alpha;bravo;charlie;delta;"
+    assert list(strs) == ["delta", "alpha", "charlie", "bravo"]
+
+    with pytest.raises(ValueError):
+        strs.external_sort(str(tmp_path / "strs.txt"), run_bytes=0)
+    with pytest.raises(OSError):
+        strs.external_sort(str(tmp_path / "missing" / "strs.txt"))
+
+
 def test_unit_rich_comparisons():
     assert Str("aa") == "aa"
     assert Str("aa") < "b"
@@ -82,6 +231,34 @@ def test_unit_split():
     assert str(parts[2]) == "token3"
 
 
+def test_unit_split_parallel():
+    native = "token1\ntoken22\n\ntoken333\n" * 300_000
+    big = Str(native)
+    for threads in (0, 2, 7):
+        assert list(big.split("\n", threads=threads)) == native.split("\n")
+        assert list(big.split("\n", maxsplit=3, threads=threads)) == list(big.split("\n", maxsplit=3))
+        assert list(big.split("\n", keepseparator=True, threads=threads)) == list(big.split("\n", keepseparator=True))
+
+
+@pytest.mark.parametrize("length", [0, 1, 15, 63, 64, 65, 1000, 100_000])
+@pytest.mark.parametrize("separator", ["\n", " ", "\x00"])
+def test_unit_split_bulk(length: int, separator: str):
+    # Single-byte separators are indexed in bulk, refilling the tape in chunks, so the results
+    # must match the plain and the multi-threaded splits, that locate the separators one by one.
+    native = "".join(choice(["a", "bc", separator, separator * 2]) for _ in range(length))
+    big = Str(native)
+    assert list(big.split(separator)) == native.split(separator)
+    assert list(sz.split(native, separator, keepseparator=True)) == list(
+        big.split(separator, keepseparator=True, threads=2)
+    )
+    for maxsplit in (0, 1, 2, 100):
+        assert list(big.split(separator, maxsplit=maxsplit)) == list(
+            big.split(separator, maxsplit=maxsplit, threads=2)
+        )
+    if separator == "\n":
+        assert list(big.splitlines(keeplinebreaks=True)) == list(big.split("\n", keepseparator=True))
+
+
 def test_unit_sequence():
     native = "p3\np2\np1"
     big = Str(native)
@@ -99,6 +276,34 @@ def test_unit_sequence():
     assert ["p3", "p2", "p1"] == list(lines)
 
 
+def test_unit_strs_batch():
+    native = ["abc", "", "cabcab", "abc", "xyz", "aaaa"]
+    consecutive = Str(",".join(native)).split(",")
+    reordered = Str(",".join(native)).split(",")
+    reordered.shuffle(seed=42)
+    for strs in (consecutive, reordered):
+        items = [str(s) for s in strs]
+        lengths = strs.lengths()
+        assert lengths.format == "Q" and list(lengths) == [len(s) for s in items]
+        assert list(strs.hash()) == [sz.hash(s) for s in items]
+        assert list(strs.find("ab")) == [s.find("ab") for s in items]
+        assert list(strs.count("ab")) == [s.count("ab") for s in items]
+        assert list(strs.count("aa", allowoverlap=True)) == [sz.count(s, "aa", allowoverlap=True) for s in items]
+        assert list(strs.startswith("ab")) == [s.startswith("ab") for s in items]
+        assert list(strs.startswith("")) == [True] * len(items)
+        assert list(strs.edit_distance("abc")) == sz.edit_distances("abc", items)
+        assert list(strs.edit_distance("abc", bound=2)) == sz.edit_distances("abc", items, bound=2)
+        assert list(strs.unique()) == sorted(set(items))
+        assert [str(s) for s in strs] == items, "Batch operations must not reorder the strings"
+
+    empty = Str("").split(",")[1:]
+    assert list(empty.lengths()) == [] and list(empty.unique()) == []
+    with pytest.raises(TypeError):
+        consecutive.find(42)
+    with pytest.raises(TypeError):
+        consecutive.count("a", unexpected=True)
+
+
 def test_unit_globals():
     """Validates that the previously unit-tested member methods are also visible as global functions."""
 
@@ -121,6 +326,8 @@ def test_unit_globals():
     assert sz.edit_distance("abababab", "aaaaaaaa") == 4
     assert sz.edit_distance("abababab", "aaaaaaaa", 2) == 2
     assert sz.edit_distance("abababab", "aaaaaaaa", bound=2) == 2
+    assert sz.edit_distances("aaa", ["aaa", "bbb", ""]) == [0, 3, 3]
+    assert sz.edit_distances("abababab", ["aaaaaaaa", "abab"], bound=2) == [2, 2]
 
 
 def test_unit_len():
@@ -128,6 +335,76 @@ def test_unit_len():
     assert 4 == len(w)
 
 
+def test_unit_unicode():
+    native = "Hello, мир! 世界 😊"
+    w = sz.Str(native)
+    assert w.isutf8()
+    assert w.len_unicode() == len(native)
+    assert str(w.slice_unicode(7, 10)) == native[7:10]
+    assert str(w.slice_unicode(-5)) == native[-5:]
+    assert str(w.slice_unicode(end=-2)) == native[:-2]
+    assert str(w.slice_unicode(3, 100)) == native[3:100]
+    assert str(w.slice_unicode(10, 3)) == ""
+    assert sz.len_unicode("αβγδ") == 4
+    assert str(sz.slice_unicode("αβγδ", 1, 3)) == "βγ"
+    assert not sz.isutf8(b"\xc0\x80")
+    assert not sz.isutf8(b"\xed\xa0\x80")
+    assert not sz.isutf8(b"abc\xe2\x82")
+
+
+def test_unit_sketch():
+    text = "The quick brown fox jumps over the lazy dog, " * 20
+    min_hashes, sim_hashes = sz.sketch(text, windows=(3, 5, 8), permutations=16)
+    assert len(min_hashes) == 3 and len(sim_hashes) == 3
+    assert all(len(signature) == 16 for signature in min_hashes)
+
+    # Every window length is sketched independently, and the member method matches the global one
+    assert sz.sketch(text, (5,), 16) == ((min_hashes[1],), (sim_hashes[1],))
+    assert sz.Str(text).sketch(windows=(3, 5, 8), permutations=16) == (min_hashes, sim_hashes)
+
+    # Similar documents share most of the values, and texts shorter than the window have no shingles
+    edited = text.replace("lazy", "busy", 1)
+    edited_min_hashes, edited_sim_hashes = sz.sketch(edited, windows=(3, 5, 8), permutations=16)
+    assert sum(a == b for a, b in zip(min_hashes[0], edited_min_hashes[0])) > 8
+    assert bin(sim_hashes[0] ^ edited_sim_hashes[0]).count("1") < 16
+    assert sz.sketch("ab", permutations=2) == (((2**64 - 1, 2**64 - 1),), (0,))
+
+
+def test_unit_arrow_capsules():
+    native = "The quick brown fox jumps over the lazy dog – привет 😊"
+    words = Str(native).split()
+    assert [str(s) for s in Strs.from_arrow(words)] == native.split()
+
+    # Sorted collections are no longer packed back-to-back and are gathered on export
+    words.sort()
+    restored = Strs.from_arrow(words.__arrow_c_array__())
+    assert [str(s) for s in restored] == sorted(native.split(), key=lambda s: s.encode())
+
+    # Slices of imported arrays must outlive both the source and the imported collection
+    first = Strs.from_arrow(Str("a,bb,,ccc").split(","))[1]
+    assert str(first) == "bb"
+    assert len(Strs.from_arrow(Str("").split(",")[0:0])) == 0
+
+    with pytest.raises(TypeError):
+        Strs.from_arrow(native)
+
+
+def test_unit_arrow_pyarrow():
+    try:
+        import pyarrow as pa
+    except ImportError:
+        pytest.skip("PyArrow is not installed")
+
+    column = pa.array(["alpha", None, "γάμμα", "", "delta"]).slice(1)
+    imported = Strs.from_arrow(column)
+    assert [str(s) for s in imported] == ["", "γάμμα", "", "delta"]
+    imported.sort()
+    assert [str(s) for s in imported] == ["", "", "delta", "γάμμα"]
+
+    exported = pa.array(Str("a b c").split())
+    assert exported.to_pylist() == ["a", "b", "c"]
+
+
 def test_slice_of_split():
     def impl(native_str: str):
         native_split = native_str.split()
@@ -342,6 +619,33 @@ def test_edit_distance_random(first_length: int, second_length: int):
     assert sz.edit_distance(a, b) == baseline_edit_distance(a, b)
 
 
+@pytest.mark.repeat(10)
+@pytest.mark.parametrize("query_length", [0, 5, 300])
+@pytest.mark.parametrize("bound", [0, 3])
+def test_edit_distances_batch_random(query_length: int, bound: int):
+    query = get_random_string(length=query_length)
+    candidates = [get_random_string(length=randint(0, 300 if i % 3 else 20)) for i in range(100)]
+    expected = [sz.edit_distance(query, c, bound=bound) for c in candidates]
+    assert sz.edit_distances(query, candidates, bound=bound) == expected
+    assert Str(query).edit_distances(candidates, bound) == expected
+    assert Str(query).edit_distances(Str(" ".join(candidates)).split(" "), bound=bound) == expected
+
+
+@pytest.mark.repeat(10)
+@pytest.mark.parametrize("needle_length", [5, 70, 600])
+@pytest.mark.parametrize("max_edits", [0, 2])
+def test_find_fuzzy_random(needle_length: int, max_edits: int):
+    needle = get_random_string(length=needle_length, variability=4)
+    typo = randint(0, needle_length - 1)
+    haystack = get_random_string(variability=4) + needle[:typo] + "_" + needle[typo + 1 :]
+    offset, length = sz.find_fuzzy(haystack, needle, max_edits)
+    if max_edits == 0:
+        assert (offset, length) == (haystack.find(needle), len(needle) if needle in haystack else 0)
+    else:
+        assert offset != -1
+        assert sz.edit_distance(haystack[offset : offset + length], needle) <= max_edits
+
+
 @pytest.mark.repeat(30)
 @pytest.mark.parametrize("first_length", [20, 100])
 @pytest.mark.parametrize("second_length", [20, 100])
@@ -366,6 +670,22 @@ def test_alignment_score_random(first_length: int, second_length: int):
     ) == -baseline_edit_distance(a, b)
 
 
+@pytest.mark.parametrize("list_length", [100, 100_000])
+@pytest.mark.parametrize("threads", [0, 2, 7])
+def test_fuzzy_sorting_parallel(list_length: int, threads: int):
+    native_list = [
+        get_random_string(variability=4, length=randint(0, 8)) for _ in range(list_length)
+    ]
+    big_list = Str(".".join(native_list)).split(".")
+
+    native_ordered = sorted(native_list)
+    native_order = big_list.order(threads=threads)
+    assert [native_list[i] for i in native_order] == native_ordered
+
+    big_list.sort(threads=threads)
+    assert [str(s) for s in big_list] == native_ordered
+
+
 @pytest.mark.parametrize("list_length", [10, 20, 30, 40, 50])
 @pytest.mark.parametrize("part_length", [5, 10])
 @pytest.mark.parametrize("variability", [2, 3])
@@ -0,0 +1,17 @@
+/**
+ *  @brief  Makes sure that the C++ header is self-contained, compiling it without any other includes.
+ *          Every standard library dependency must be included by the header itself.
+ */
+#include <stringzilla/stringzilla.hpp>
+
+namespace sz = ashvardanian::stringzilla;
+
+int main(int, char const **) {
+    // Instantiate a few templates relying on the STL containers, to check the dependent names as well.
+    sz::string text("c,b,a");
+    auto parts = text.view().split(",").template to<std::vector<sz::string_view>>();
+    auto order = sz::sorted_order(parts);
+    sz::string joined;
+    for (auto index : order) joined += parts[index];
+    return joined == "abc" ? 0 : 1;
+}
@@ -39,9 +39,11 @@ def linux_settings() -> Tuple[List[str], List[str], List[Tuple[str]]]:
         "-Wno-incompatible-pointer-types",  # like: passing argument 4 of ‘sz_export_prefix_u32’ from incompatible pointer type
         "-Wno-discarded-qualifiers",  # like: passing argument 1 of ‘free’ discards ‘const’ qualifier from pointer target type
         "-fPIC",  # to enable dynamic dispatch
+        "-pthread",  # for parallel algorithms, like `Strs.sort(threads=...)`
     ]
     link_args = [
         "-fPIC",  # to enable dynamic dispatch
+        "-pthread",  # for parallel algorithms, like `Strs.sort(threads=...)`
     ]
 
     # GCC is our primary compiler, so when packaging the library, even if the current machine
@@ -50,6 +52,7 @@ def linux_settings() -> Tuple[List[str], List[str], List[Tuple[str]]]:
         ("SZ_USE_X86_AVX512", "1" if is_64bit_x86() else "0"),
         ("SZ_USE_X86_AVX2", "1" if is_64bit_x86() else "0"),
         ("SZ_USE_ARM_SVE", "1" if is_64bit_arm() else "0"),
+        ("SZ_USE_ARM_SVE2", "1" if is_64bit_arm() else "0"),
         ("SZ_USE_ARM_NEON", "1" if is_64bit_arm() else "0"),
         ("SZ_DETECT_BIG_ENDIAN", "1" if is_big_endian() else "0"),
     ]
@@ -85,6 +88,7 @@ def darwin_settings() -> Tuple[List[str], List[str], List[Tuple[str]]]:
         ("SZ_USE_X86_AVX512", "0"),
         ("SZ_USE_X86_AVX2", "1" if can_use_avx2 else "0"),
         ("SZ_USE_ARM_SVE", "0"),
+        ("SZ_USE_ARM_SVE2", "0"),
         ("SZ_USE_ARM_NEON", "1" if is_64bit_arm() else "0"),
     ]
 